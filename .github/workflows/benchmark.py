@@ -46,6 +46,18 @@ def run_benchmark(bin_path, original_engine_config, ray_tracing_enabled):
 
 	print(' Success')
 
+def check_validation_results():
+	# The CPU tests of the benchmark state write their error counts to the validation group
+	with open(BENCHMARK_RESULTS_PATH, 'r') as results_file:
+		results = json.load(results_file)
+
+	failed_validations = {name: count for name, count in results.get('Validation', {}).items() if count != 0}
+	if failed_validations:
+		print('Validation failed:')
+		for name, count in failed_validations.items():
+			print(f'\t{name}: {count}')
+		sys.exit(1)
+
 def main(argv):
 	help_str = '''usage: --bin <binpath>\n
 		bin: path to application binary'''
@@ -83,6 +95,7 @@ def main(argv):
 
 
 	run_benchmark(bin_path, original_engine_config, ray_tracing_enabled=True)
+	check_validation_results()
 	os.rename(BENCHMARK_RESULTS_PATH, BENCHMARK_RESULTS_PATH_RT_ON)
 
 	# Restore original engine config
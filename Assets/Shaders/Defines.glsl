@@ -176,7 +176,7 @@ struct SParticle
 	float EndRadius;
 	float FrictionFactor;
 	float ShouldStop;
-	float Padding1;
+	uint Generation;
 };
 
 struct SEmitter
@@ -5,7 +5,6 @@
 #include "ECS/Component.h"
 
 #include "Containers/TArray.h"
-#include "Containers/TQueue.h"
 
 #include "Math/Math.h"
 
@@ -13,9 +12,117 @@
 #include "Networking/API/NetworkSegment.h"
 
 
+/*
+* PacketInbox - Read-only view of the packets a PacketComponent received this tick. It points into the component's
+* storage, which keeps its memory from tick to tick, so reading it neither copies nor allocates. The view is valid
+* until PacketTranscoderSystem clears the received packets for the next tick.
+*/
+
+template<class T>
+class PacketInbox
+{
+public:
+	PacketInbox(const T* pPackets, uint32 packetCount) :
+		m_pPackets(pPackets),
+		m_PacketCount(packetCount)
+	{
+	}
+
+	FORCEINLINE const T* begin() const
+	{
+		return m_pPackets;
+	}
+
+	FORCEINLINE const T* end() const
+	{
+		return m_pPackets + m_PacketCount;
+	}
+
+	FORCEINLINE const T& operator[](uint32 index) const
+	{
+		VALIDATE(index < m_PacketCount);
+		return m_pPackets[index];
+	}
+
+	FORCEINLINE const T& GetBack() const
+	{
+		VALIDATE(m_PacketCount > 0);
+		return m_pPackets[m_PacketCount - 1];
+	}
+
+	FORCEINLINE uint32 GetSize() const
+	{
+		return m_PacketCount;
+	}
+
+	FORCEINLINE bool IsEmpty() const
+	{
+		return m_PacketCount == 0;
+	}
+
+private:
+	const T* m_pPackets;
+	uint32 m_PacketCount;
+};
+
+/*
+* PacketOutbox - Queues and edits the packets a PacketComponent sends this tick, in place in the component's storage.
+* Only the packets that have not been sent yet are visible. Pushing only allocates when more packets are queued in a
+* tick than in any tick before.
+*/
+
+template<class T>
+class PacketOutbox
+{
+public:
+	PacketOutbox(LambdaEngine::TArray<T>& packets, uint32 firstPacket) :
+		m_Packets(packets),
+		m_FirstPacket(firstPacket)
+	{
+	}
+
+	FORCEINLINE T& Push(const T& packet)
+	{
+		return m_Packets.PushBack(packet);
+	}
+
+	FORCEINLINE T& operator[](uint32 index)
+	{
+		VALIDATE(index < GetSize());
+		return m_Packets[m_FirstPacket + index];
+	}
+
+	FORCEINLINE T& GetBack()
+	{
+		VALIDATE(!IsEmpty());
+		return m_Packets.GetBack();
+	}
+
+	FORCEINLINE uint32 GetSize() const
+	{
+		return m_Packets.GetSize() - m_FirstPacket;
+	}
+
+	FORCEINLINE bool IsEmpty() const
+	{
+		return GetSize() == 0;
+	}
+
+private:
+	LambdaEngine::TArray<T>& m_Packets;
+	uint32 m_FirstPacket;
+};
+
+struct PacketStorageStats
+{
+	uint32 ReceivedCapacity	= 0;
+	uint32 ToSendCapacity	= 0;
+};
+
 struct IPacketComponent
 {
 	friend class PacketTranscoderSystem;
+	friend class PacketComponentAccess;
 
 public:
 	virtual ~IPacketComponent() = default;
@@ -27,6 +134,52 @@ private:
 	virtual bool WriteSegment(LambdaEngine::NetworkSegment* pSegment, int32 networkUID) = 0;
 	virtual uint16 GetPacketsToSendCount() = 0;
 	virtual uint16 GetPacketType() = 0;
+	virtual PacketStorageStats GetStorageStats() const = 0;
+};
+
+/*
+* PacketComponentAccess - Receives and sends the packets of a component the way PacketTranscoderSystem does, without a
+* network, and reports how much storage the component holds. Meant for benchmarks that replay traffic, systems use the
+* public interface of PacketComponent.
+*/
+
+class PacketComponentAccess
+{
+public:
+	DECL_STATIC_CLASS(PacketComponentAccess);
+
+	FORCEINLINE static void* AddPacketReceivedBegin(IPacketComponent* pPacketComponent)
+	{
+		return pPacketComponent->AddPacketReceivedBegin();
+	}
+
+	FORCEINLINE static void AddPacketReceivedEnd(IPacketComponent* pPacketComponent)
+	{
+		pPacketComponent->AddPacketReceivedEnd();
+	}
+
+	FORCEINLINE static void ClearPacketsReceived(IPacketComponent* pPacketComponent)
+	{
+		pPacketComponent->ClearPacketsReceived();
+	}
+
+	FORCEINLINE static bool WriteSegment(IPacketComponent* pPacketComponent, LambdaEngine::NetworkSegment* pSegment, int32 networkUID)
+	{
+		return pPacketComponent->WriteSegment(pSegment, networkUID);
+	}
+
+	FORCEINLINE static uint16 GetPacketsToSendCount(IPacketComponent* pPacketComponent)
+	{
+		return pPacketComponent->GetPacketsToSendCount();
+	}
+
+	/*
+	* Capacity of the received and to send storage, in packets. It only changes when the storage reallocates.
+	*/
+	FORCEINLINE static PacketStorageStats GetStorageStats(const IPacketComponent* pPacketComponent)
+	{
+		return pPacketComponent->GetStorageStats();
+	}
 };
 
 template<class T>
@@ -47,27 +200,27 @@ public:
 	}
 
 	/*
-	* Returns the packets to be sent.
+	* Returns a view of the packets received, in the same order as GetPacketsReceived
 	*/
-	const LambdaEngine::TQueue<T>& GetPacketsToSend() const
+	PacketInbox<T> GetInbox() const
 	{
-		return m_PacketsToSend;
+		return PacketInbox<T>(m_PacketsReceived.GetData(), m_PacketsReceived.GetSize());
 	}
 
 	/*
-	* Returns the last successfully received packet
+	* Returns a view of the packets to be sent, which can be appended to and edited
 	*/
-	const T& GetLastReceivedPacket() const
+	PacketOutbox<T> GetOutbox()
 	{
-		return m_LastReceivedPacket;
+		return PacketOutbox<T>(m_PacketsToSend, m_FirstPacketToSend);
 	}
 
 	/*
-	* Returns the packets to be sent.
+	* Returns the last successfully received packet
 	*/
-	LambdaEngine::TQueue<T>& GetPacketsToSend()
+	const T& GetLastReceivedPacket() const
 	{
-		return m_PacketsToSend;
+		return m_LastReceivedPacket;
 	}
 
 	/*
@@ -75,7 +228,7 @@ public:
 	*/
 	void SendPacket(const T& packet)
 	{
-		m_PacketsToSend.push(packet);
+		m_PacketsToSend.PushBack(packet);
 	}
 
 private:
@@ -96,16 +249,23 @@ private:
 
 	virtual bool WriteSegment(LambdaEngine::NetworkSegment* pSegment, int32 networkUID) override final
 	{
-		T& packet = m_PacketsToSend.front();
+		T& packet = m_PacketsToSend[m_FirstPacketToSend++];
 		packet.NetworkUID = networkUID;
 		bool result = pSegment->Write<T>(&packet);
-		m_PacketsToSend.pop();
+
+		// Every packet is sent, the memory is kept for the next tick
+		if (m_FirstPacketToSend == m_PacketsToSend.GetSize())
+		{
+			m_PacketsToSend.Clear();
+			m_FirstPacketToSend = 0;
+		}
+
 		return result;
 	}
 
 	virtual uint16 GetPacketsToSendCount() override final
 	{
-		return (uint16)m_PacketsToSend.size();
+		return (uint16)(m_PacketsToSend.GetSize() - m_FirstPacketToSend);
 	}
 
 	virtual uint16 GetPacketType() override final
@@ -113,9 +273,15 @@ private:
 		return s_PacketType;
 	}
 
+	virtual PacketStorageStats GetStorageStats() const override final
+	{
+		return { .ReceivedCapacity = m_PacketsReceived.GetCapacity(), .ToSendCapacity = m_PacketsToSend.GetCapacity() };
+	}
+
 private:
 	LambdaEngine::TArray<T> m_PacketsReceived;
-	LambdaEngine::TQueue<T> m_PacketsToSend;
+	LambdaEngine::TArray<T> m_PacketsToSend;
+	uint32 m_FirstPacketToSend = 0;
 	T m_LastReceivedPacket;
 	inline static uint16 s_PacketType = 0;
 };
\ No newline at end of file
@@ -69,10 +69,7 @@ private:
 
 	LambdaEngine::SpinLock m_DeferredEventsLock;
 	LambdaEngine::TArray<std::pair<ProjectileHitEvent, uint8>> m_DeferredDamageTakenHitEvents;
-	LambdaEngine::TArray<std::pair<ProjectileHitEvent, uint8>> m_DamageTakenEventsToProcess;
-
 	LambdaEngine::TArray<bool> m_DeferredEnemyHitEvents;
-	LambdaEngine::TArray<bool> m_EnemyHitEventsToProcess;
 
 	uint8 m_LocalTeamIndex = UINT8_MAX;
 };
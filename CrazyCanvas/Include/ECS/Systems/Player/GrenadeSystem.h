@@ -9,6 +9,7 @@
 namespace LambdaEngine
 {
 	struct KeyPressedEvent;
+	class SceneQueryBatch;
 }
 
 namespace physx
@@ -20,6 +21,7 @@ namespace physx
 class GrenadeSystem : LambdaEngine::System
 {
 	static constexpr const uint32 NUM_ENVIRONMENT_SPHERE_POINTS = 32;
+	static constexpr const uint32 RAYS_PER_PLAYER = 3;
 
 public:
 	GrenadeSystem() = default;
@@ -45,16 +47,24 @@ private:
 	void FindPlayersWithinBlast(LambdaEngine::Entity& localPlayer, LambdaEngine::TArray<LambdaEngine::Entity>& opponents, const glm::vec3& grenadePosition, uint8 grenadeTeam);
 
 	/**
-	 * Sends raycasts from the grenade to different places on players' bodies to figure out if they were hit.
+	 * Adds raycasts from the grenade to different places on players' bodies to figure out if they were hit.
 	 * Should be called after finding the players within the blast radius of the grenade using the function above.
 	 * @param players Players assumed to be within the blast radius of the grenade.
+	 * @return Index of the first raycast, each player is given RAYS_PER_PLAYER consecutive raycasts
 	*/
-	void RaycastToPlayers(const LambdaEngine::TArray<LambdaEngine::Entity>& players, LambdaEngine::Entity grenadeEntity, const glm::vec3& grenadePosition, uint8 grenadeTeam);
+	uint32 AddRaycastsToPlayers(LambdaEngine::SceneQueryBatch& queryBatch, const LambdaEngine::TArray<LambdaEngine::Entity>& players, const glm::vec3& grenadePosition);
 
 	/**
-	 * Sends raycasts from the grenade to the environment and spawns hit points on the environment.
+	 * Paints the players hit by the raycasts added by AddRaycastsToPlayers, once the batch has been executed.
 	*/
-	void RaycastToEnvironment(LambdaEngine::Entity grenadeEntity, const glm::vec3& grenadePosition, uint8 grenadeTeam);
+	void PaintPlayersHit(const LambdaEngine::SceneQueryBatch& queryBatch, uint32 firstRaycast, const LambdaEngine::TArray<LambdaEngine::Entity>& players, LambdaEngine::Entity grenadeEntity, uint8 grenadeTeam);
+
+	/**
+	 * Adds raycasts from the grenade to the environment, hit points are spawned by PaintEnvironmentHit.
+	 * @return Index of the first raycast
+	*/
+	uint32 AddRaycastsToEnvironment(LambdaEngine::SceneQueryBatch& queryBatch, const glm::vec3& grenadePosition);
+	void PaintEnvironmentHit(const LambdaEngine::SceneQueryBatch& queryBatch, uint32 firstRaycast, LambdaEngine::Entity grenadeEntity, uint8 grenadeTeam);
 
 private:
 	bool OnPacketGrenadeThrownReceived(const PacketReceivedEvent<PacketGrenadeThrown>& grenadeThrownEvent);
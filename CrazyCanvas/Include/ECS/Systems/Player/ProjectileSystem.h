@@ -0,0 +1,63 @@
+#pragma once
+#include "ECS/System.h"
+
+#include "Physics/ProjectileSimulator.h"
+
+#include "Containers/TUniquePtr.h"
+
+/*
+* ProjectileSystem - Moves the paint and water projectiles created by LevelObjectCreator::CreateProjectile. The
+* projectiles have no PhysX actors, they are simulated by a ProjectileSimulator and their hits are passed to the same
+* collision callbacks that PhysX contacts used to call.
+*/
+
+class ProjectileSystem : public LambdaEngine::System
+{
+public:
+	ProjectileSystem()	= default;
+	~ProjectileSystem()	= default;
+
+	// Empty tick, projectiles are moved in FixedTick
+	virtual void Tick(LambdaEngine::Timestamp deltaTime) override final
+	{
+		UNREFERENCED_VARIABLE(deltaTime);
+	}
+
+	void FixedTick(LambdaEngine::Timestamp deltaTime);
+
+	/**
+	* @param projectileEntity	Has a position and a velocity component, which are updated as the projectile moves
+	* @param owner				Entity that fired the projectile, the projectile does not hit it
+	* @param callback			Called when the projectile hits a player or the level, the projectile is the first entity
+	*/
+	void AddProjectile(
+		LambdaEngine::Entity projectileEntity,
+		LambdaEngine::Entity owner,
+		const glm::vec3& position,
+		const glm::vec3& velocity,
+		const LambdaEngine::CollisionCallback& callback);
+
+public:
+	static bool Init();
+	static void Release();
+
+	FORCEINLINE static ProjectileSystem& GetInstance()
+	{
+		VALIDATE(s_Instance != nullptr);
+		return *s_Instance;
+	}
+
+private:
+	bool InitInternal();
+
+	void OnProjectileRemoval(LambdaEngine::Entity entity);
+
+private:
+	LambdaEngine::IDVector m_ProjectileEntities;
+
+	ProjectileSimulator m_Simulator;
+	LambdaEngine::THashTable<LambdaEngine::Entity, LambdaEngine::CollisionCallback> m_Callbacks;
+
+private:
+	static LambdaEngine::TUniquePtr<ProjectileSystem> s_Instance;
+};
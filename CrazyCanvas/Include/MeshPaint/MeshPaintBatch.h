@@ -0,0 +1,89 @@
+#pragma once
+#include "MeshPaintTypes.h"
+
+#include "ECS/Entity.h"
+
+/*
+* PaintHit - A splat of paint, or of water removing paint, at a point on a mesh
+*/
+
+struct PaintHit
+{
+	glm::vec3	Position;
+	glm::vec3	Direction;
+	float32		Angle		= 0.0f; // Rotation of the brush in radians
+	EPaintMode	PaintMode	= EPaintMode::NONE;
+	ERemoteMode	RemoteMode	= ERemoteMode::UNDEFINED;
+	ETeam		Team		= ETeam::NONE;
+};
+
+/*
+* MeshPaintBatch - Collects the paint hits of a frame in the order they were added. A hit that lands on top of an earlier
+* hit on the same target, with the same paint, replaces it instead of becoming another paint operation. The paint pass
+* applies every hit to every mesh, so hits are only merged past hits that cannot overlap them, whatever their target,
+* and they are flushed in the order they were added.
+*/
+
+class MeshPaintBatch
+{
+	struct BatchedHit
+	{
+		LambdaEngine::Entity	Target;
+		PaintHit				Hit;
+	};
+
+public:
+	DECL_UNIQUE_CLASS(MeshPaintBatch);
+
+	MeshPaintBatch() = default;
+	~MeshPaintBatch() = default;
+
+	/**
+	* @param target	Entity that was hit, UNKNOWN_TARGET if it is not known, eg. for hits sent by the server
+	*/
+	void AddHit(LambdaEngine::Entity target, const PaintHit& hit);
+
+	/*
+	* Moves up to maxHitCount hits to the back of hits, in the order they were added. Hits that do not fit are kept and
+	* are the first to be flushed the next time.
+	* Returns the number of hits that were moved
+	*/
+	uint32 Flush(LambdaEngine::TArray<PaintHit>& hits, uint32 maxHitCount);
+
+	void Clear();
+
+	FORCEINLINE bool IsEmpty() const
+	{
+		return m_Hits.IsEmpty();
+	}
+
+	FORCEINLINE uint32 GetHitCount() const
+	{
+		return m_Hits.GetSize();
+	}
+
+public:
+	/*
+	* True if laterHit paints the same splat as earlierHit, close enough that painting only laterHit looks the same
+	*/
+	static bool CanMerge(const PaintHit& earlierHit, const PaintHit& laterHit);
+
+	/*
+	* False if the splats of the two hits are too far apart to paint any vertex in common
+	*/
+	static bool CanOverlap(const PaintHit& hit0, const PaintHit& hit1);
+
+public:
+	static constexpr const LambdaEngine::Entity UNKNOWN_TARGET = UINT32_MAX;
+
+	static constexpr const float32 MERGE_DISTANCE			= 0.05f;
+	static constexpr const float32 MERGE_MIN_COS_ANGLE		= 0.996f;	// About five degrees between the directions
+	static constexpr const float32 MERGE_MAX_BRUSH_ANGLE	= 0.1f;	// Radians
+
+	// PAINT_DEPTH in MeshPaintUpdater.comp, a splat reaches further along its direction than to the sides
+	static constexpr const float32 SPLAT_EXTENT = 2.0f;
+
+private:
+	// Pending hits in the order they were added, cleared hits keep their memory between frames
+	LambdaEngine::TArray<BatchedHit> m_Hits;
+};
@@ -9,6 +9,7 @@
 #include "Events/GameplayEvents.h"
 
 #include "MeshPaintTypes.h"
+#include "MeshPaintBatch.h"
 
 #include <queue>
 
@@ -52,6 +53,7 @@ public:
 	*	position	- vec3 of the hit point position
 	*	direction	- vec3 of the direction the hit position had during collision
 	*	paintMode	- painting mode to be used for the target
+	*	target		- entity that was hit, hits on the same entity are merged when they overlap
 	*/
 	static void AddHitPoint(
 		const glm::vec3& position,
@@ -59,7 +61,8 @@ public:
 		EPaintMode paintMode,
 		ERemoteMode remoteMode,
 		ETeam mode,
-		uint32 angle);
+		uint32 angle,
+		LambdaEngine::Entity target = MeshPaintBatch::UNKNOWN_TARGET);
 
 	/* Reset client data from the texture and only use the verifed server data */
 	static void ResetClient();
@@ -90,8 +93,14 @@ private:
 	bool	m_ResetPointBuffer		= false;
 	uint32	m_PreviousPointsSize	= 0;
 
+	LambdaEngine::TArray<PaintHit> m_HitsToPaint;
+
+public:
+	// Size of HitPointsBuffer in MeshPaintUpdater.comp
+	static constexpr const uint32 MAX_HIT_POINTS = 10;
+
 private:
-	static LambdaEngine::TArray<PaintData> s_Collisions;
+	static MeshPaintBatch s_HitBatch;
 	static LambdaEngine::SpinLock s_SpinLock;
 	inline static bool	s_ShouldReset = false;
 };
@@ -0,0 +1,57 @@
+#pragma once
+#include "MeshPaint/MeshPaintBatch.h"
+
+/*
+* PaintVertex - The parts of a vertex that MeshPaintUpdater.comp reads and writes, with the instance transform applied
+*/
+
+struct PaintVertex
+{
+	glm::vec3	Position;
+	glm::vec3	Normal;
+	uint32		PaintInfo		= 0;	// Bits of SVertex::Position.w, client team in bits 4-7 and server team in bits 0-3
+	float32		PaintDistance	= 1.0f;	// SVertex::Normal.w
+};
+
+/*
+* MeshPaintReference - Applies paint hits to vertices on the CPU the same way MeshPaintUpdater.comp does on the GPU, so
+* that batching of hits can be validated and measured without a device. The brush mask texture is approximated by a
+* filled circle.
+*/
+
+class MeshPaintReference
+{
+public:
+	DECL_STATIC_CLASS(MeshPaintReference);
+
+	/**
+	* @param instanceTeam	Team of the painted mesh, ETeam::NONE for the level
+	* @param clearClient	Removes the client side paint after the hits are painted, like PaintData::ClearClient
+	*/
+	static void ApplyHits(
+		LambdaEngine::TArray<PaintVertex>& vertices,
+		ETeam instanceTeam,
+		const PaintHit* pHits,
+		uint32 hitCount,
+		bool clearClient);
+
+	/*
+	* Applies the hits to a single vertex, used by callers that only paint the vertices within PAINT_REACH of the hits
+	*/
+	static void ApplyHits(
+		PaintVertex& vertex,
+		ETeam instanceTeam,
+		const PaintHit* pHits,
+		uint32 hitCount,
+		bool clearClient);
+
+	static float32 SampleBrushMask(const glm::vec2& uv);
+
+public:
+	// BRUSH_SIZE in MeshPaintUpdater.comp
+	static constexpr const float32 BRUSH_SIZE	= 1.0f;
+	static constexpr const float32 PAINT_DEPTH	= BRUSH_SIZE * 2.0f;
+
+	// No vertex further away from the hit position than this is painted, the brush extends less than BRUSH_SIZE from the hit direction
+	static constexpr const float32 PAINT_REACH	= PAINT_DEPTH + BRUSH_SIZE;
+};
@@ -0,0 +1,89 @@
+#pragma once
+#include "MeshPaintTypes.h"
+
+/*
+* PaintMaskRun - A number of consecutive vertices with the same mask, see IS_MASK_PAINTED in MeshPaintHandler.h
+*/
+
+#pragma pack(push, 1)
+struct PaintMaskRun
+{
+	uint16	Length	= 0;
+	uint8	Mask	= 0;
+};
+#pragma pack(pop)
+
+/*
+* PaintMask - The server side paint of every vertex of a mesh, kept as bit planes so that a mesh costs three bits per
+* vertex. The vertices are split into chunks that are encoded as runs of equal masks, which is how the paint is sent to
+* players that join after it was painted. Every chunk has a version that is incremented each time one of its masks
+* changes, a chunk with version zero has not been painted since the mask was created.
+*/
+
+class PaintMask
+{
+public:
+	PaintMask() = default;
+	~PaintMask() = default;
+
+	void Init(uint32 vertexCount);
+
+	/*
+	* Sets the mask of a vertex, in the format of IS_MASK_PAINTED and GET_TEAM_INDEX_FROM_MASK.
+	* Returns true if the mask changed
+	*/
+	bool SetMask(uint32 vertexIndex, uint8 mask);
+	uint8 GetMask(uint32 vertexIndex) const;
+
+	/*
+	* Appends the runs of a chunk to runs. The lengths of the runs add up to the number of vertices in the chunk
+	*/
+	void EncodeChunk(uint32 chunkIndex, LambdaEngine::TArray<PaintMaskRun>& runs) const;
+
+	/*
+	* Sets the masks of a chunk from runs made by EncodeChunk. Returns false, without changing the chunk, if the runs do
+	* not cover exactly the vertices of the chunk
+	*/
+	bool DecodeChunk(uint32 chunkIndex, const PaintMaskRun* pRuns, uint32 runCount);
+
+	FORCEINLINE uint32 GetVertexCount() const
+	{
+		return m_VertexCount;
+	}
+
+	FORCEINLINE uint32 GetChunkCount() const
+	{
+		return m_ChunkVersions.GetSize();
+	}
+
+	FORCEINLINE uint32 GetChunkVersion(uint32 chunkIndex) const
+	{
+		return m_ChunkVersions[chunkIndex];
+	}
+
+	FORCEINLINE uint32 GetChunkFirstVertex(uint32 chunkIndex) const
+	{
+		return chunkIndex * CHUNK_VERTEX_COUNT;
+	}
+
+	FORCEINLINE uint32 GetChunkVertexCount(uint32 chunkIndex) const
+	{
+		return glm::min(CHUNK_VERTEX_COUNT, m_VertexCount - GetChunkFirstVertex(chunkIndex));
+	}
+
+public:
+	// A multiple of 64 so that chunks start at the beginning of a word in the bit planes
+	static constexpr const uint32 CHUNK_VERTEX_COUNT = 256;
+
+	// The masks of a chunk encode into at most one run per vertex
+	static constexpr const uint32 MAX_RUNS_PER_CHUNK = CHUNK_VERTEX_COUNT;
+
+private:
+	static constexpr const uint32 MASK_BIT_COUNT = 3;
+
+	uint32 m_VertexCount = 0;
+
+	// Bit b of a mask for vertex v is bit (v % 64) of m_MaskBits[b][v / 64]
+	LambdaEngine::TArray<uint64> m_MaskBits[MASK_BIT_COUNT];
+	LambdaEngine::TArray<uint32> m_ChunkVersions;
+};
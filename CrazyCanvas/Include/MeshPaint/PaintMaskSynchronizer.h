@@ -0,0 +1,115 @@
+#pragma once
+#include "MeshPaint/PaintMask.h"
+#include "MeshPaint/MeshPaintReference.h"
+
+#include "Events/PlayerEvents.h"
+
+#include "Application/API/Events/NetworkEvents.h"
+
+#include "Networking/API/NetworkSegment.h"
+
+#include "ECS/Entity.h"
+#include "Resources/Mesh.h"
+
+/*
+* PaintMaskSynchronizer - Sends the paint of the level to players that load it after it was painted. The server keeps
+* a PaintMask for every static mesh of the level, painted on the CPU by MeshPaintReference with the same hits that the
+* clients paint on the GPU. When a player has loaded the level every chunk that has been painted is queued for them,
+* and a bounded number of chunks is sent each tick. Hits painted after the chunks are queued reach the player as usual
+* through PacketProjectileHit, so the cost of catching up depends on the size of the level, not the length of the match.
+*/
+
+class PaintMaskSynchronizer
+{
+	friend class CrazyCanvas;
+
+	struct PaintMesh
+	{
+		LambdaEngine::Entity				Entity;
+		PaintMask							Mask;
+		LambdaEngine::TArray<PaintVertex>	Vertices;	// Only kept on the server, in world space
+		glm::vec3							BoundsMin;
+		glm::vec3							BoundsMax;
+
+		// Uniform grid over the vertices with cells of PAINT_REACH, built once on the server so a hit only visits nearby vertices
+		LambdaEngine::THashTable<uint64, glm::uvec2>	CellRanges;		// First index in CellVertices and vertex count of each cell
+		LambdaEngine::TArray<uint32>					CellVertices;	// Vertex indices sorted by cell
+	};
+
+public:
+	DECL_STATIC_CLASS(PaintMaskSynchronizer);
+
+	/*
+	* Registers a static mesh of the level. Meshes are identified by the order they are registered in, which is the
+	* same on the server and the clients since they load the same level
+	*/
+	static void RegisterMesh(LambdaEngine::Entity entity, const LambdaEngine::Mesh* pMesh, const glm::mat4& transform);
+
+	/*
+	* Forgets the meshes of the level, called when the level is unloaded
+	*/
+	static void Clear();
+
+	/*
+	* Paints a server hit on the masks of the meshes it can reach, only used on the server
+	*/
+	static void PaintServerHit(const PaintHit& hit);
+
+	static void FixedTick();
+
+	FORCEINLINE static uint32 GetMeshCount()
+	{
+		return s_Meshes.GetSize();
+	}
+
+	FORCEINLINE static const PaintMask& GetMask(uint32 meshIndex)
+	{
+		return s_Meshes[meshIndex].Mask;
+	}
+
+public:
+	// Chunks sent to each player per tick, a chunk is encoded in less than 800 bytes
+	static constexpr const uint32 MAX_CHUNKS_PER_TICK = 32;
+
+private:
+	static void Init();
+	static void Release();
+
+	static void QueueAllPaintedChunks(uint64 playerUID);
+
+	static bool OnPlayerStateUpdated(const PlayerStateUpdatedEvent& event);
+	static bool OnPlayerLeft(const PlayerLeftEvent& event);
+	static bool OnPacketReceived(const LambdaEngine::NetworkSegmentReceivedEvent& event);
+
+	static void BuildVertexGrid(PaintMesh& paintMesh);
+
+	// Cell of a position in the vertex grid of a mesh, relative to the minimum of its bounds
+	FORCEINLINE static glm::uvec3 GetCell(const PaintMesh& paintMesh, const glm::vec3& position)
+	{
+		return glm::uvec3(glm::max((position - paintMesh.BoundsMin) / GRID_CELL_SIZE, glm::vec3(0.0f)));
+	}
+
+	// The coordinates of a cell are packed into 21 bits each
+	FORCEINLINE static uint64 PackCellKey(const glm::uvec3& cell)
+	{
+		return (uint64(cell.x & 0x1FFFFF) << 42) | (uint64(cell.y & 0x1FFFFF) << 21) | uint64(cell.z & 0x1FFFFF);
+	}
+
+	// A chunk is identified by its mesh in the upper 16 bits and its index in the mesh in the lower 16 bits
+	FORCEINLINE static uint32 PackChunkID(uint32 meshIndex, uint32 chunkIndex)
+	{
+		return (meshIndex << 16) | (chunkIndex & 0xFFFF);
+	}
+
+private:
+	static constexpr const float32 GRID_CELL_SIZE = MeshPaintReference::PAINT_REACH;
+
+	// Mesh index, chunk index and run count followed by the runs
+	static constexpr const uint32 CHUNK_HEADER_SIZE = 3 * sizeof(uint16);
+	static_assert(CHUNK_HEADER_SIZE + PaintMask::MAX_RUNS_PER_CHUNK * sizeof(PaintMaskRun) <= MAXIMUM_SEGMENT_SIZE, "A paint mask chunk does not fit in a packet");
+
+private:
+	static LambdaEngine::TArray<PaintMesh> s_Meshes;
+	static LambdaEngine::THashTable<uint64, LambdaEngine::TArray<uint32>> s_ChunksToSend;
+	static LambdaEngine::TArray<PaintMaskRun> s_Runs;
+};
@@ -46,6 +46,7 @@ public:
 	inline static uint16 RESET_PLAYER_TEXTURE		= 0;
 	inline static uint16 SESSION_SETTING_CHANGED	= 0; // When a session setting is changed that affects all players of the server
 	inline static uint16 GRENADE_THROWN				= 0;
+	inline static uint16 PAINT_MASK_CHUNK			= 0;
 
 public:
 	static IPacketReceivedEvent* GetPacketReceivedEventPointer(uint16 packetType);
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "Game/ECS/Systems/Physics/PhysicsSystem.h"
+#include "Game/ECS/Systems/Physics/SceneQueryBatch.h"
+
+/*
+* ProjectileHit - A projectile that hit a player or the level during the last step. The collision infos are filled in
+* the same way as the ones PhysX contacts pass to a CollisionCallback, the projectile being the first entity.
+*/
+
+struct ProjectileHit
+{
+	LambdaEngine::EntityCollisionInfo ProjectileInfo;
+	LambdaEngine::EntityCollisionInfo OtherInfo;
+};
+
+/*
+* ProjectileSimulator - Moves projectiles along ballistic paths without creating PhysX actors for them. The state of
+* the projectiles is kept as packed arrays of floats so the integration runs over contiguous memory, and the path of
+* every projectile during a step is tested against the scene as a sphere sweep. All sweeps of a step are executed as
+* one SceneQueryBatch. Projectiles that hit something or run out of lifetime are removed at the end of the step.
+*/
+
+class ProjectileSimulator
+{
+public:
+	DECL_UNIQUE_CLASS(ProjectileSimulator);
+
+	ProjectileSimulator() = default;
+	~ProjectileSimulator() = default;
+
+	/**
+	* @param entity	Entity of the projectile, identifies it in hits and when removing it
+	* @param owner	Entity that fired the projectile, the sweeps ignore its shapes
+	*/
+	void AddProjectile(LambdaEngine::Entity entity, LambdaEngine::Entity owner, const glm::vec3& position, const glm::vec3& velocity);
+
+	/*
+	* Removes a projectile before it hits anything, does nothing if the entity is not a simulated projectile
+	*/
+	void RemoveProjectile(LambdaEngine::Entity entity);
+
+	/*
+	* Integrates every projectile by deltaTime and resolves their hits. Hits and expired projectiles of the step
+	* can be read until the next call.
+	*/
+	void Step(float32 deltaTime);
+
+	void Clear();
+
+	FORCEINLINE uint32 GetProjectileCount() const
+	{
+		return m_Entities.GetSize();
+	}
+
+	FORCEINLINE LambdaEngine::Entity GetEntity(uint32 projectileIndex) const
+	{
+		return m_Entities[projectileIndex];
+	}
+
+	FORCEINLINE glm::vec3 GetPosition(uint32 projectileIndex) const
+	{
+		return glm::vec3(m_PositionsX[projectileIndex], m_PositionsY[projectileIndex], m_PositionsZ[projectileIndex]);
+	}
+
+	FORCEINLINE glm::vec3 GetVelocity(uint32 projectileIndex) const
+	{
+		return glm::vec3(m_VelocitiesX[projectileIndex], m_VelocitiesY[projectileIndex], m_VelocitiesZ[projectileIndex]);
+	}
+
+	FORCEINLINE const LambdaEngine::TArray<ProjectileHit>& GetHits() const
+	{
+		return m_Hits;
+	}
+
+	FORCEINLINE const LambdaEngine::TArray<LambdaEngine::Entity>& GetExpiredProjectiles() const
+	{
+		return m_ExpiredProjectiles;
+	}
+
+public:
+	// The radius of 0.3 scaled by the projectile's scale of 0.7, like the sphere shape PhysX used to simulate
+	static constexpr const float32 PROJECTILE_RADIUS	= 0.21f;
+	static constexpr const float32 MAX_LIFETIME			= 10.0f;
+
+private:
+	void RemoveProjectileAt(uint32 projectileIndex);
+
+private:
+	// Hot data, read and written by every step
+	LambdaEngine::TArray<float32> m_PositionsX;
+	LambdaEngine::TArray<float32> m_PositionsY;
+	LambdaEngine::TArray<float32> m_PositionsZ;
+	LambdaEngine::TArray<float32> m_VelocitiesX;
+	LambdaEngine::TArray<float32> m_VelocitiesY;
+	LambdaEngine::TArray<float32> m_VelocitiesZ;
+	LambdaEngine::TArray<float32> m_Lifetimes;
+
+	// Positions at the end of the current step, kept between steps to avoid reallocating them
+	LambdaEngine::TArray<float32> m_NextPositionsX;
+	LambdaEngine::TArray<float32> m_NextPositionsY;
+	LambdaEngine::TArray<float32> m_NextPositionsZ;
+
+	// Cold data, only read when adding queries and on hits
+	LambdaEngine::TArray<LambdaEngine::Entity> m_Entities;
+	LambdaEngine::TArray<LambdaEngine::Entity> m_Owners;
+	LambdaEngine::THashTable<LambdaEngine::Entity, uint32> m_EntityToIndex;
+
+	LambdaEngine::SceneQueryBatch m_QueryBatch;
+	LambdaEngine::TArray<ProjectileHit> m_Hits;
+	LambdaEngine::TArray<LambdaEngine::Entity> m_ExpiredProjectiles;
+	LambdaEngine::TArray<uint32> m_ProjectilesToRemove;
+};
@@ -19,6 +19,8 @@ namespace LambdaEngine
 			uint32 VertexCount;
 			uint32 ShouldResetServer;
 			uint32 HitPointBufferValid;
+			uint32 ApplyServerMask;
+			uint32 ServerMaskOffset;
 		};
 
 	public:
@@ -54,11 +56,19 @@ namespace LambdaEngine
 		static void ClearServer(Entity entity);
 		static void SetHitPointBufferValid(bool valid);
 
+		/*
+		* Replaces the server side paint of a range of an entity's vertices, the masks are in the format of IS_MASK_PAINTED.
+		* All pending masks are applied in the next frame before its hit points, so hits that arrive after the masks are painted on top of them.
+		* Vertices outside of ranges that have been set keep their paint
+		*/
+		static void SetServerMasks(Entity entity, uint32 vertexCount, uint32 firstVertex, const uint8* pMasks, uint32 maskCount);
+
 	private:
 		bool CreatePipelineLayout();
 		bool CreateDescriptorSets();
 		bool CreateShaders();
 		bool CreateCommandLists();
+		bool WriteServerMasks(uint32 modFrameIndex, const TArray<uint32>& masks);
 
 	private:
 		bool								m_Initilized = false;
@@ -76,8 +86,18 @@ namespace LambdaEngine
 		CommandAllocator** m_ppComputeCommandAllocators = nullptr;
 		CommandList** m_ppComputeCommandLists = nullptr;
 
+		TSharedRef<Buffer>					m_ServerMaskBuffers[BACK_BUFFER_COUNT];
+		TArray<uint32>						m_ServerMasks;
+		TArray<uint32>						m_ServerMaskOffsets;
+
 		static std::unordered_set<Entity> s_EntitiesToClear;
 		static uint32 s_HitPointBufferValid;
+		static THashTable<Entity, TArray<uint32>> s_ServerMasksToApply;
+
+		// Vertices with this value in the server mask buffer keep their paint
+		static constexpr const uint32 SERVER_MASK_KEEP = UINT32_MAX;
+		// Offset of draw args that have no server masks to apply this frame
+		static constexpr const uint32 SERVER_MASK_NONE = UINT32_MAX;
 	};
 }
 
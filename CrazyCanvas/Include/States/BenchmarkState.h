@@ -6,6 +6,7 @@
 #include "ECS/Entity.h"
 #include "ECS/Systems/Player/BenchmarkSystem.h"
 #include "ECS/Systems/Player/WeaponSystem.h"
+#include "ECS/Systems/Player/ProjectileSystem.h"
 #include "EventHandlers/AudioEffectHandler.h"
 #include "World/Level.h"
 
@@ -16,6 +17,29 @@ struct WeaponFiredEvent;
 
 class BenchmarkState : public LambdaEngine::State
 {
+	struct EventQueueBenchmarkResult
+	{
+		float64 EventsPerSecond		= 0.0;
+		float64 PushP99Nanoseconds	= 0.0;
+		float64 PushP999Nanoseconds	= 0.0;
+		float64 PushMaxNanoseconds	= 0.0;
+	};
+
+	struct OffsetAllocatorBenchmarkResult
+	{
+		float64 AverageFragmentation	= 0.0;
+		float64 FailedAllocations		= 0.0;
+		float64 OperationNanoseconds	= 0.0;
+	};
+
+	struct LoggingBenchmarkResult
+	{
+		float64 CallP50Nanoseconds	= 0.0;
+		float64 CallP99Nanoseconds	= 0.0;
+		float64 CallMaxNanoseconds	= 0.0;
+		float64 DroppedMessages		= 0.0;
+	};
+
 public:
 	BenchmarkState();
 	~BenchmarkState();
@@ -30,6 +54,24 @@ public:
 
 private:
 	static void PrintBenchmarkResults();
+	static float64 BenchmarkParticleChurn();
+	static float64 FuzzOffsetAllocator();
+	static float64 FuzzRingAllocator();
+	static OffsetAllocatorBenchmarkResult BenchmarkOffsetAllocatorFragmentation();
+	static float64 BenchmarkPhysicsStep();
+	static float64 BenchmarkPhysicsTick(bool sleeping);
+	static float64 BenchmarkSceneQueries(bool batched);
+	static float64 BenchmarkProjectiles();
+	static float64 BenchmarkPacketInbox(bool useViews);
+	static float64 BenchmarkMeshPaint(bool batched);
+	static float64 ValidateMeshPaintBatching();
+	static float64 ValidateLineBatch();
+	static float64 ValidateTLASUpdateTracker();
+	static float64 ValidateRenderGraphAliasing();
+	static float64 ValidateParticleSimulation();
+	static float64 BenchmarkFrameAllocator(bool useFrameAllocator);
+	static EventQueueBenchmarkResult BenchmarkEventQueue(bool lockFree);
+	static LoggingBenchmarkResult BenchmarkLogging(bool async);
 
 private:
 	bool OnPacketCreateLevelObjectReceived(const PacketReceivedEvent<PacketCreateLevelObject>& event);
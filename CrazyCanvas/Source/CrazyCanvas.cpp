@@ -46,6 +46,8 @@
 
 #include "Chat/ChatManager.h"
 
+#include "MeshPaint/PaintMaskSynchronizer.h"
+
 #include "GUI/CountdownGUI.h"
 #include "GUI/DamageIndicatorGUI.h"
 #include "GUI/EnemyHitIndicatorGUI.h"
@@ -192,6 +194,7 @@ CrazyCanvas::CrazyCanvas(const argh::parser& flagParser)
 	}
 
 	ChatManager::Init();
+	PaintMaskSynchronizer::Init();
 }
 
 CrazyCanvas::~CrazyCanvas()
@@ -202,6 +205,7 @@ CrazyCanvas::~CrazyCanvas()
 	}
 
 	m_MeshPaintHandler.Release();
+	PaintMaskSynchronizer::Release();
 	ChatManager::Release();
 	PlayerManagerBase::Release();
 	SessionSettings::Release();
@@ -222,6 +226,7 @@ void CrazyCanvas::FixedTick(LambdaEngine::Timestamp delta)
 	if (LambdaEngine::MultiplayerUtils::IsServer())
 	{
 		PROFILE_FUNCTION("PlayerManagerServer::FixedTick", PlayerManagerServer::FixedTick(delta));
+		PROFILE_FUNCTION("PaintMaskSynchronizer::FixedTick", PaintMaskSynchronizer::FixedTick());
 	}
 	else
 	{
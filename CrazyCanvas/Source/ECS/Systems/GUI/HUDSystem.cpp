@@ -163,24 +163,24 @@ void HUDSystem::FixedTick(Timestamp delta)
 		m_HUDGUI->UpdateHealth(healthComponent.CurrentHealth);
 	}
 
+	// The events are copied to frame memory so that the lock is not held while the GUI is updated
+	TFrameArray<std::pair<ProjectileHitEvent, uint8>> damageTakenEventsToProcess;
+	uint32 enemyHitEventCount = 0;
 	{
 		std::scoped_lock<SpinLock> lock(m_DeferredEventsLock);
 		if (!m_DeferredDamageTakenHitEvents.IsEmpty())
 		{
-			m_DamageTakenEventsToProcess = m_DeferredDamageTakenHitEvents;
+			damageTakenEventsToProcess.Assign(m_DeferredDamageTakenHitEvents.Begin(), m_DeferredDamageTakenHitEvents.End());
 			m_DeferredDamageTakenHitEvents.Clear();
 		}
 
-		if (!m_DeferredEnemyHitEvents.IsEmpty())
-		{
-			m_EnemyHitEventsToProcess = m_DeferredEnemyHitEvents;
-			m_DeferredEnemyHitEvents.Clear();
-		}
+		enemyHitEventCount = m_DeferredEnemyHitEvents.GetSize();
+		m_DeferredEnemyHitEvents.Clear();
 	}
 
-	if (!m_DamageTakenEventsToProcess.IsEmpty())
+	if (!damageTakenEventsToProcess.IsEmpty())
 	{
-		for (auto& pair : m_DamageTakenEventsToProcess)
+		for (auto& pair : damageTakenEventsToProcess)
 		{
 			const ComponentArray<RotationComponent>* pPlayerRotationComp = pECS->GetComponentArray<RotationComponent>();
 			const RotationComponent& playerRotationComp = pPlayerRotationComp->GetConstData(pair.first.CollisionInfo1.Entity);
@@ -192,18 +192,11 @@ void HUDSystem::FixedTick(Timestamp delta)
 
 			m_HUDGUI->DisplayDamageTakenIndicator(GetForward(glm::normalize(playerRotationComp.Quaternion)), pair.first.CollisionInfo1.Normal, isFriendly);
 		}
-
-		m_DamageTakenEventsToProcess.Clear();
 	}
 
-	if (!m_EnemyHitEventsToProcess.IsEmpty())
+	for (uint32 i = 0; i < enemyHitEventCount; i++)
 	{
-		for (uint32 i = 0; i < m_EnemyHitEventsToProcess.GetSize(); i++)
-		{
-			m_HUDGUI->DisplayHitIndicator();
-		}
-
-		m_EnemyHitEventsToProcess.Clear();
+		m_HUDGUI->DisplayHitIndicator();
 	}
 
 	const ComponentArray<ProjectedGUIComponent>* pProjectedGUIComponents = pECS->GetComponentArray<ProjectedGUIComponent>();
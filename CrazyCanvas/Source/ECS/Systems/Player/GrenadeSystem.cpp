@@ -8,6 +8,7 @@
 #include "Game/ECS/Components/Rendering/MeshComponent.h"
 #include "Game/ECS/Components/Team/TeamComponent.h"
 #include "Game/ECS/Systems/Physics/PhysicsSystem.h"
+#include "Game/ECS/Systems/Physics/SceneQueryBatch.h"
 #include "Game/Multiplayer/MultiplayerUtils.h"
 #include "Input/API/InputActionSystem.h"
 #include "Lobby/PlayerManagerClient.h"
@@ -300,12 +301,14 @@ void GrenadeSystem::Explode(LambdaEngine::Entity grenade)
 
 			if (MultiplayerUtils::IsServer() || MultiplayerUtils::IsSingleplayer())
 			{
-				if (!opponents.IsEmpty())
-				{
-					RaycastToPlayers(opponents, grenade, grenadePos, grenadeTeam);
-				}
-
-				RaycastToEnvironment(grenade, grenadePos, grenadeTeam);
+				// The rays to the players and to the environment are cast in one batch
+				SceneQueryBatch queryBatch;
+				const uint32 firstPlayerRaycast = AddRaycastsToPlayers(queryBatch, opponents, grenadePos);
+				const uint32 firstEnvironmentRaycast = AddRaycastsToEnvironment(queryBatch, grenadePos);
+				PhysicsSystem::GetInstance()->ExecuteQueryBatch(queryBatch);
+
+				PaintPlayersHit(queryBatch, firstPlayerRaycast, opponents, grenade, grenadeTeam);
+				PaintEnvironmentHit(queryBatch, firstEnvironmentRaycast, grenade, grenadeTeam);
 			}
 
 			if (!MultiplayerUtils::IsServer())
@@ -439,7 +442,7 @@ void GrenadeSystem::FindPlayersWithinBlast(LambdaEngine::Entity& localPlayer, La
 	}
 }
 
-void GrenadeSystem::RaycastToPlayers(const LambdaEngine::TArray<LambdaEngine::Entity>& players, LambdaEngine::Entity grenadeEntity, const glm::vec3& grenadePosition, uint8 grenadeTeam)
+uint32 GrenadeSystem::AddRaycastsToPlayers(LambdaEngine::SceneQueryBatch& queryBatch, const LambdaEngine::TArray<LambdaEngine::Entity>& players, const glm::vec3& grenadePosition)
 {
 	using namespace LambdaEngine;
 
@@ -447,7 +450,7 @@ void GrenadeSystem::RaycastToPlayers(const LambdaEngine::TArray<LambdaEngine::En
 		Use the epsilon to nudge the rays away from the collision body's edges, to make sure rays don't miss because of
 		precision errors. */
 	constexpr const float32 heightEpsilon = 0.1f;
-	constexpr const std::array<float32, 3> rayHeightOffsets =
+	constexpr const std::array<float32, RAYS_PER_PLAYER> rayHeightOffsets =
 	{
 		heightEpsilon,
 		PLAYER_CAPSULE_HEIGHT * 0.5f,
@@ -469,7 +472,9 @@ void GrenadeSystem::RaycastToPlayers(const LambdaEngine::TArray<LambdaEngine::En
 		.pFilterData = &queryFilterData
 	};
 
-	PhysicsSystem* pPhysicsSystem = PhysicsSystem::GetInstance();
+	constexpr const uint32 maxOverlaps = 10;
+	const uint32 firstRaycast = queryBatch.GetQueryCount();
+
 	for (Entity player : players)
 	{
 		const glm::vec3& playerPos = pPositionComponents->GetConstData(player).Position;
@@ -477,46 +482,58 @@ void GrenadeSystem::RaycastToPlayers(const LambdaEngine::TArray<LambdaEngine::En
 		for (float32 rayHeightOffset : rayHeightOffsets)
 		{
 			raycastInfo.Direction = glm::normalize(glm::vec3(playerPos.x, playerPos.y + rayHeightOffset, playerPos.z) - grenadePosition);
+			queryBatch.AddRaycast(raycastInfo, true, maxOverlaps);
+		}
+	}
 
-			constexpr const uint32 maxOverlaps = 10;
-			std::array<PxRaycastHit, maxOverlaps> rayHitsUserBuffer;
-			PxRaycastBuffer rayHits(rayHitsUserBuffer.data(), (PxU32)rayHitsUserBuffer.size());
-			if (pPhysicsSystem->Raycast(raycastInfo, rayHits))
-			{
-				const uint32 hitCount = rayHits.getNbTouches();
-				const PxRaycastHit* pHits = rayHits.getTouches();
+	return firstRaycast;
+}
 
-				for (uint32 hitNr = 0; hitNr < hitCount; hitNr++)
+void GrenadeSystem::PaintPlayersHit(const LambdaEngine::SceneQueryBatch& queryBatch, uint32 firstRaycast, const LambdaEngine::TArray<LambdaEngine::Entity>& players, LambdaEngine::Entity grenadeEntity, uint8 grenadeTeam)
+{
+	using namespace LambdaEngine;
+
+	for (uint32 playerNr = 0; playerNr < players.GetSize(); playerNr++)
+	{
+		const Entity player = players[playerNr];
+
+		for (uint32 rayNr = 0; rayNr < RAYS_PER_PLAYER; rayNr++)
+		{
+			const uint32 raycast = firstRaycast + playerNr * RAYS_PER_PLAYER + rayNr;
+			const uint32 hitCount = queryBatch.GetHitCount(raycast);
+
+			for (uint32 hitNr = 0; hitNr < hitCount; hitNr++)
+			{
+				const PxRaycastHit& hit = queryBatch.GetRaycastHit(raycast, hitNr);
+				if (reinterpret_cast<const ActorUserData*>(hit.actor->userData)->Entity == player)
 				{
-					const PxRaycastHit& hit = pHits[hitNr];
-					if (reinterpret_cast<const ActorUserData*>(hit.actor->userData)->Entity == player)
+					// The player was hit by the ray, paint him in the hit position
+					const glm::vec3& rayDirection = queryBatch.GetDirection(raycast);
+
+					const LambdaEngine::EntityCollisionInfo collisionInfo0 =
 					{
-						// The player was hit by the ray, paint him in the hit position
-						const LambdaEngine::EntityCollisionInfo collisionInfo0 =
-						{
-							.Entity		= grenadeEntity,
-							.Position	= glm::vec3(hit.position.x, hit.position.y, hit.position.z),
-							.Direction	= raycastInfo.Direction,
-							.Normal		= glm::vec3(hit.normal.x, hit.normal.y, hit.normal.z)
-						};
+						.Entity		= grenadeEntity,
+						.Position	= glm::vec3(hit.position.x, hit.position.y, hit.position.z),
+						.Direction	= rayDirection,
+						.Normal		= glm::vec3(hit.normal.x, hit.normal.y, hit.normal.z)
+					};
 
-						const LambdaEngine::EntityCollisionInfo collisionInfo1 =
-						{
-							.Entity		= player,
-							.Position	= glm::vec3(hit.position.x, hit.position.y, hit.position.z),
-							.Direction	= raycastInfo.Direction,
-							.Normal		= glm::vec3(hit.normal.x, hit.normal.y, hit.normal.z)
-						};
+					const LambdaEngine::EntityCollisionInfo collisionInfo1 =
+					{
+						.Entity		= player,
+						.Position	= glm::vec3(hit.position.x, hit.position.y, hit.position.z),
+						.Direction	= rayDirection,
+						.Normal		= glm::vec3(hit.normal.x, hit.normal.y, hit.normal.z)
+					};
 
-						const EAmmoType ammoType	= EAmmoType::AMMO_TYPE_PAINT;
-						const ETeam team			= (ETeam)grenadeTeam;
-						const uint32 angle			= 0;
+					const EAmmoType ammoType	= EAmmoType::AMMO_TYPE_PAINT;
+					const ETeam team			= (ETeam)grenadeTeam;
+					const uint32 angle			= 0;
 
-						ProjectileHitEvent hitEvent(collisionInfo0, collisionInfo1, ammoType, team, angle);
-						EventQueue::SendEventImmediate(hitEvent);
+					ProjectileHitEvent hitEvent(collisionInfo0, collisionInfo1, ammoType, team, angle);
+					EventQueue::SendEventImmediate(hitEvent);
 
-						goto nextPlayer;
-					}
+					goto nextPlayer;
 				}
 			}
 		}
@@ -524,7 +541,7 @@ void GrenadeSystem::RaycastToPlayers(const LambdaEngine::TArray<LambdaEngine::En
 	}
 }
 
-void GrenadeSystem::RaycastToEnvironment(LambdaEngine::Entity grenadeEntity, const glm::vec3& grenadePosition, uint8 grenadeTeam)
+uint32 GrenadeSystem::AddRaycastsToEnvironment(LambdaEngine::SceneQueryBatch& queryBatch, const glm::vec3& grenadePosition)
 {
 	using namespace LambdaEngine;
 
@@ -540,42 +557,56 @@ void GrenadeSystem::RaycastToEnvironment(LambdaEngine::Entity grenadeEntity, con
 		.pFilterData = &queryFilterData
 	};
 
-	PhysicsSystem* pPhysicsSystem = PhysicsSystem::GetInstance();
+	const uint32 firstRaycast = queryBatch.GetQueryCount();
 
 	for (uint32 i = 0; i < NUM_ENVIRONMENT_SPHERE_POINTS; i++)
 	{
 		raycastInfo.Direction = m_FibonacciSphere[i];
+		queryBatch.AddRaycast(raycastInfo);
+	}
 
-		PxRaycastHit hit;
-		if (pPhysicsSystem->Raycast(raycastInfo, hit))
-		{
-			if (hit.actor->userData != nullptr)
-			{
-				const ActorUserData* pUserData = reinterpret_cast<const ActorUserData*>(hit.actor->userData);
+	return firstRaycast;
+}
 
-				const LambdaEngine::EntityCollisionInfo collisionInfo0 =
-				{
-					.Entity		= grenadeEntity,
-					.Position	= glm::vec3(hit.position.x, hit.position.y, hit.position.z),
-					.Direction	= raycastInfo.Direction,
-					.Normal		= glm::vec3(hit.normal.x, hit.normal.y, hit.normal.z)
-				};
+void GrenadeSystem::PaintEnvironmentHit(const LambdaEngine::SceneQueryBatch& queryBatch, uint32 firstRaycast, LambdaEngine::Entity grenadeEntity, uint8 grenadeTeam)
+{
+	using namespace LambdaEngine;
 
-				const LambdaEngine::EntityCollisionInfo collisionInfo1 =
-				{
-					.Entity		= pUserData->Entity,
-					.Position	= glm::vec3(hit.position.x, hit.position.y, hit.position.z),
-					.Direction	= raycastInfo.Direction,
-					.Normal		= glm::vec3(hit.normal.x, hit.normal.y, hit.normal.z)
-				};
+	for (uint32 i = 0; i < NUM_ENVIRONMENT_SPHERE_POINTS; i++)
+	{
+		const uint32 raycast = firstRaycast + i;
+		if (queryBatch.GetHitCount(raycast) == 0)
+		{
+			continue;
+		}
 
-				const EAmmoType ammoType	= EAmmoType::AMMO_TYPE_PAINT;
-				const ETeam team			= (ETeam)grenadeTeam;
-				const uint32 angle			= 0;
+		const PxRaycastHit& hit = queryBatch.GetRaycastHit(raycast, 0);
+		if (hit.actor->userData != nullptr)
+		{
+			const ActorUserData* pUserData = reinterpret_cast<const ActorUserData*>(hit.actor->userData);
 
-				ProjectileHitEvent hitEvent(collisionInfo0, collisionInfo1, ammoType, team, angle);
-				EventQueue::SendEventImmediate(hitEvent);
-			}
+			const LambdaEngine::EntityCollisionInfo collisionInfo0 =
+			{
+				.Entity		= grenadeEntity,
+				.Position	= glm::vec3(hit.position.x, hit.position.y, hit.position.z),
+				.Direction	= queryBatch.GetDirection(raycast),
+				.Normal		= glm::vec3(hit.normal.x, hit.normal.y, hit.normal.z)
+			};
+
+			const LambdaEngine::EntityCollisionInfo collisionInfo1 =
+			{
+				.Entity		= pUserData->Entity,
+				.Position	= glm::vec3(hit.position.x, hit.position.y, hit.position.z),
+				.Direction	= queryBatch.GetDirection(raycast),
+				.Normal		= glm::vec3(hit.normal.x, hit.normal.y, hit.normal.z)
+			};
+
+			const EAmmoType ammoType	= EAmmoType::AMMO_TYPE_PAINT;
+			const ETeam team			= (ETeam)grenadeTeam;
+			const uint32 angle			= 0;
+
+			ProjectileHitEvent hitEvent(collisionInfo0, collisionInfo1, ammoType, team, angle);
+			EventQueue::SendEventImmediate(hitEvent);
 		}
 	}
 }
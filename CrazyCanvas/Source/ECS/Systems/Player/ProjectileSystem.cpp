@@ -0,0 +1,132 @@
+#include "ECS/Systems/Player/ProjectileSystem.h"
+#include "ECS/Components/Player/ProjectileComponent.h"
+#include "ECS/Components/Player/GrenadeComponent.h"
+
+#include "ECS/ECSCore.h"
+
+#include "Game/ECS/Components/Physics/Transform.h"
+
+/*
+* ProjectileSystem
+*/
+
+LambdaEngine::TUniquePtr<ProjectileSystem> ProjectileSystem::s_Instance = nullptr;
+
+bool ProjectileSystem::Init()
+{
+	s_Instance = DBG_NEW ProjectileSystem();
+	return s_Instance->InitInternal();
+}
+
+void ProjectileSystem::Release()
+{
+	s_Instance.Reset();
+}
+
+void ProjectileSystem::FixedTick(LambdaEngine::Timestamp deltaTime)
+{
+	using namespace LambdaEngine;
+
+	const float32 dt = (float32)deltaTime.AsSeconds();
+	m_Simulator.Step(dt);
+
+	ECSCore* pECS = ECSCore::GetInstance();
+	ComponentArray<PositionComponent>* pPositionComponents = pECS->GetComponentArray<PositionComponent>();
+	ComponentArray<VelocityComponent>* pVelocityComponents = pECS->GetComponentArray<VelocityComponent>();
+
+	// Projectiles that hit something or expired have already been removed from the simulator
+	const uint32 projectileCount = m_Simulator.GetProjectileCount();
+	for (uint32 p = 0; p < projectileCount; p++)
+	{
+		const Entity entity = m_Simulator.GetEntity(p);
+		if (pPositionComponents->HasComponent(entity))
+		{
+			pPositionComponents->GetData(entity).Position = m_Simulator.GetPosition(p);
+		}
+
+		if (pVelocityComponents->HasComponent(entity))
+		{
+			pVelocityComponents->GetData(entity).Velocity = m_Simulator.GetVelocity(p);
+		}
+	}
+
+	for (const ProjectileHit& hit : m_Simulator.GetHits())
+	{
+		const Entity entity = hit.ProjectileInfo.Entity;
+
+		auto callbackItr = m_Callbacks.find(entity);
+		if (callbackItr == m_Callbacks.end())
+		{
+			continue;
+		}
+
+		const CollisionCallback callback = std::move(callbackItr->second);
+		m_Callbacks.erase(callbackItr);
+
+		// The callback is responsible for removing the projectile, like it was when PhysX reported the contact
+		if (callback)
+		{
+			callback(hit.ProjectileInfo, hit.OtherInfo);
+		}
+		else
+		{
+			pECS->RemoveEntity(entity);
+		}
+	}
+
+	for (Entity entity : m_Simulator.GetExpiredProjectiles())
+	{
+		m_Callbacks.erase(entity);
+		pECS->RemoveEntity(entity);
+	}
+}
+
+void ProjectileSystem::AddProjectile(
+	LambdaEngine::Entity projectileEntity,
+	LambdaEngine::Entity owner,
+	const glm::vec3& position,
+	const glm::vec3& velocity,
+	const LambdaEngine::CollisionCallback& callback)
+{
+	m_Simulator.AddProjectile(projectileEntity, owner, position, velocity);
+	m_Callbacks[projectileEntity] = callback;
+}
+
+bool ProjectileSystem::InitInternal()
+{
+	using namespace LambdaEngine;
+
+	// Register system
+	{
+		SystemRegistration systemReg = {};
+		systemReg.SubscriberRegistration.EntitySubscriptionRegistrations =
+		{
+			{
+				.pSubscriber = &m_ProjectileEntities,
+				.ComponentAccesses =
+				{
+					{ R,	ProjectileComponent::Type() },
+					{ RW,	PositionComponent::Type() },
+					{ RW,	VelocityComponent::Type() }
+				},
+				.ExcludedComponentTypes =
+				{
+					GrenadeComponent::Type()
+				},
+				.OnEntityRemoval = std::bind_front(&ProjectileSystem::OnProjectileRemoval, this)
+			}
+		};
+		systemReg.Phase = 2;
+
+		RegisterSystem(TYPE_NAME(ProjectileSystem), systemReg);
+	}
+
+	return true;
+}
+
+void ProjectileSystem::OnProjectileRemoval(LambdaEngine::Entity entity)
+{
+	// Projectiles removed by something else than a hit, eg. when the level is unloaded
+	m_Simulator.RemoveProjectile(entity);
+	m_Callbacks.erase(entity);
+}
@@ -274,10 +274,10 @@ void WeaponSystem::StartReload(WeaponComponent& weaponComponent, PacketComponent
 	using namespace LambdaEngine;
 
 	// Send action to server
-	TQueue<PacketPlayerAction>& actions = packets.GetPacketsToSend();
-	if (!actions.empty())
+	PacketOutbox<PacketPlayerAction> actions = packets.GetOutbox();
+	if (!actions.IsEmpty())
 	{
-		actions.back().StartedReload = true;
+		actions.GetBack().StartedReload = true;
 	}
 
 	weaponComponent.ReloadClock = weaponComponent.ReloadTime;
@@ -284,11 +284,11 @@ bool WeaponSystemClient::TryFire(EAmmoType ammoType, LambdaEngine::Entity weapon
 
 		// Send action to server
 		PacketComponent<PacketPlayerAction>& packets = pECS->GetComponent<PacketComponent<PacketPlayerAction>>(weaponComponent.WeaponOwner);
-		TQueue<PacketPlayerAction>& actions = packets.GetPacketsToSend();
-		if (!actions.empty())
+		PacketOutbox<PacketPlayerAction> actions = packets.GetOutbox();
+		if (!actions.IsEmpty())
 		{
-			actions.back().FiredAmmo = ammoType;
-			actions.back().Angle = angle;
+			actions.GetBack().FiredAmmo = ammoType;
+			actions.GetBack().Angle = angle;
 		}
 
 		return true;
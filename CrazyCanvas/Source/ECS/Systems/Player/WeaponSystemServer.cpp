@@ -28,15 +28,14 @@ void WeaponSystemServer::FixedTick(LambdaEngine::Timestamp deltaTime)
 		// Update reload and cooldown timers
 		UpdateWeapon(weaponComp, dt);
 
-		PacketComponent<PacketPlayerAction> actionsRecived;
-		if (!pPlayerActionPackets->GetIf(remotePlayerEntity, actionsRecived))
+		// Read the packets in place, copying the component would copy both of its packet arrays
+		if (!pPlayerActionPackets->HasComponent(remotePlayerEntity))
 		{
 			continue;
 		}
 
-		PacketComponent<PacketPlayerActionResponse>&	responsesToSend	= pPlayerResponsePackets->GetData(remotePlayerEntity);
-		TQueue<PacketPlayerActionResponse>&				packetsToSend	= responsesToSend.GetPacketsToSend();
-		const TArray<PacketPlayerAction>&				packetsRecived	= actionsRecived.GetPacketsReceived();
+		const PacketInbox<PacketPlayerAction>		packetsRecived	= pPlayerActionPackets->GetConstData(remotePlayerEntity).GetInbox();
+		PacketOutbox<PacketPlayerActionResponse>	packetsToSend	= pPlayerResponsePackets->GetData(remotePlayerEntity).GetOutbox();
 
 		// Handle packets
 		const uint32 packetCount = packetsRecived.GetSize();
@@ -65,10 +64,11 @@ void WeaponSystemServer::FixedTick(LambdaEngine::Timestamp deltaTime)
 					CalculateWeaponFireProperties(weaponEntity, firePosition, fireVelocity, playerTeam);
 
 					// Update position and orientation of weapon component
-					packetsToSend.back().FiredAmmo		= ammoType;
-					packetsToSend.back().WeaponPosition	= firePosition;
-					packetsToSend.back().WeaponVelocity	= fireVelocity;
-					packetsToSend.back().Angle			= packetsRecived[i].Angle;
+					PacketPlayerActionResponse& response = packetsToSend.GetBack();
+					response.FiredAmmo		= ammoType;
+					response.WeaponPosition	= firePosition;
+					response.WeaponVelocity	= fireVelocity;
+					response.Angle			= packetsRecived[i].Angle;
 
 					// Handle fire
 					weaponComp.CurrentCooldown = 1.0f / weaponComp.FireRate;
@@ -0,0 +1,59 @@
+#include "MeshPaint/MeshPaintBatch.h"
+
+/*
+* MeshPaintBatch
+*/
+
+void MeshPaintBatch::AddHit(LambdaEngine::Entity target, const PaintHit& hit)
+{
+	// Search back to the first hit that the new hit could be painted on top of, hits on every target are in the way
+	for (int32 h = int32(m_Hits.GetSize()) - 1; h >= 0; h--)
+	{
+		BatchedHit& batchedHit = m_Hits[h];
+		if (batchedHit.Target == target && CanMerge(batchedHit.Hit, hit))
+		{
+			// No hit after h overlaps the new one, so it can be painted in h's place
+			batchedHit.Hit = hit;
+			return;
+		}
+		else if (CanOverlap(batchedHit.Hit, hit))
+		{
+			break;
+		}
+	}
+
+	m_Hits.PushBack({ .Target = target, .Hit = hit });
+}
+
+uint32 MeshPaintBatch::Flush(LambdaEngine::TArray<PaintHit>& hits, uint32 maxHitCount)
+{
+	const uint32 flushedHitCount = std::min(m_Hits.GetSize(), maxHitCount);
+	for (uint32 h = 0; h < flushedHitCount; h++)
+	{
+		hits.PushBack(m_Hits[h].Hit);
+	}
+
+	m_Hits.Erase(m_Hits.Begin(), m_Hits.Begin() + flushedHitCount);
+	return flushedHitCount;
+}
+
+void MeshPaintBatch::Clear()
+{
+	m_Hits.Clear();
+}
+
+bool MeshPaintBatch::CanMerge(const PaintHit& earlierHit, const PaintHit& laterHit)
+{
+	return
+		earlierHit.PaintMode	== laterHit.PaintMode	&&
+		earlierHit.RemoteMode	== laterHit.RemoteMode	&&
+		earlierHit.Team			== laterHit.Team		&&
+		glm::abs(earlierHit.Angle - laterHit.Angle) < MERGE_MAX_BRUSH_ANGLE &&
+		glm::distance(earlierHit.Position, laterHit.Position) < MERGE_DISTANCE &&
+		glm::dot(glm::normalize(earlierHit.Direction), glm::normalize(laterHit.Direction)) > MERGE_MIN_COS_ANGLE;
+}
+
+bool MeshPaintBatch::CanOverlap(const PaintHit& hit0, const PaintHit& hit1)
+{
+	return glm::distance(hit0.Position, hit1.Position) < 2.0f * SPLAT_EXTENT;
+}
@@ -10,6 +10,7 @@
 #include "Multiplayer/ClientHelper.h"
 #include "Multiplayer/ServerHelper.h"
 #include "RenderStages/MeshPaintUpdater.h"
+#include "MeshPaint/PaintMaskSynchronizer.h"
 
 #include "Utilities/StringUtilities.h"
 
@@ -19,7 +20,7 @@
 * MeshPaintHandler
 */
 
-LambdaEngine::TArray<MeshPaintHandler::PaintData> MeshPaintHandler::s_Collisions;
+MeshPaintBatch MeshPaintHandler::s_HitBatch;
 LambdaEngine::SpinLock MeshPaintHandler::s_SpinLock;
 
 MeshPaintHandler::~MeshPaintHandler()
@@ -42,7 +43,7 @@ void MeshPaintHandler::Init()
 	// Create buffer
 	BufferDesc bufferDesc	= {};
 	bufferDesc.DebugName	= "Mesh Paint Handler Points Buffer";
-	bufferDesc.SizeInBytes	= sizeof(PaintData) * 10;
+	bufferDesc.SizeInBytes	= sizeof(PaintData) * MAX_HIT_POINTS;
 	bufferDesc.Flags		= FBufferFlag::BUFFER_FLAG_CONSTANT_BUFFER;
 	bufferDesc.MemoryType	= EMemoryType::MEMORY_TYPE_CPU_VISIBLE;
 	m_pPointsBuffer			= RenderAPI::GetDevice()->CreateBuffer(&bufferDesc);
@@ -51,7 +52,7 @@ void MeshPaintHandler::Init()
 		byte* pBufferMapping = reinterpret_cast<byte*>(m_pPointsBuffer->Map());
 		PaintData dummyData = {};
 		dummyData.TargetPosition.w = 0.f;
-		for (uint32 i = 0; i < 10; i++)
+		for (uint32 i = 0; i < MAX_HIT_POINTS; i++)
 		{
 			uint64 step = uint64(i) * sizeof(PaintData);
 			memcpy(pBufferMapping + step, &dummyData, sizeof(PaintData));
@@ -78,27 +79,45 @@ void MeshPaintHandler::Tick(LambdaEngine::Timestamp delta)
 
 	bool transferMemory = false;
 
+	// Hits that do not fit in the buffer are kept in the batch and painted next frame
+	m_HitsToPaint.Clear();
+	bool flushedAllHits = false;
+	{
+		std::scoped_lock<SpinLock> lock(s_SpinLock);
+		s_HitBatch.Flush(m_HitsToPaint, MAX_HIT_POINTS);
+		flushedAllHits = s_HitBatch.IsEmpty();
+	}
+
 	// Load buffer with new data
-	if (!s_Collisions.IsEmpty())
+	if (!m_HitsToPaint.IsEmpty())
 	{
-		PaintData& dataFirst = s_Collisions.GetFront();
-		dataFirst.TargetPosition.w = (float)s_Collisions.GetSize();
+		PaintData* pBufferMapping = reinterpret_cast<PaintData*>(m_pPointsBuffer->Map());
+		for (uint32 h = 0; h < m_HitsToPaint.GetSize(); h++)
+		{
+			const PaintHit& hit = m_HitsToPaint[h];
+
+			PaintData data = {};
+			data.TargetPosition				= { hit.Position.x, hit.Position.y, hit.Position.z, 1.0f };
+			data.TargetDirectionXYZAngleW	= { hit.Direction.x, hit.Direction.y, hit.Direction.z, hit.Angle };
+			data.PaintMode					= hit.PaintMode;
+			data.RemoteMode					= hit.RemoteMode;
+			data.Team						= hit.Team;
+			data.ClearClient				= 0;
+			pBufferMapping[h] = data;
+		}
+
+		pBufferMapping[0].TargetPosition.w = (float)m_HitsToPaint.GetSize();
 
-		if (s_ShouldReset)
+		// The client paint is cleared after the last pending hit, deferred hits are painted before it
+		if (s_ShouldReset && flushedAllHits)
 		{
-			PaintData& dataLast = s_Collisions.GetBack();
-			dataLast.ClearClient = 1;
+			pBufferMapping[m_HitsToPaint.GetSize() - 1].ClearClient = 1;
 			s_ShouldReset = false;
 		}
 
-		byte* pBufferMapping = reinterpret_cast<byte*>(m_pPointsBuffer->Map());
-		memcpy(pBufferMapping, s_Collisions.GetData(), s_Collisions.GetSize() * sizeof(PaintData));
 		m_pPointsBuffer->Unmap();
 
-		// TODO: Current implementation limits to 10 points and
-		// discards the rest, not ideal but works for first implementation.
-		m_PreviousPointsSize = s_Collisions.GetSize();
-		s_Collisions.Clear();
+		m_PreviousPointsSize = m_HitsToPaint.GetSize();
 
 		// When no new point is added to the list afterwards, make sure to zero the memory
 		// to disable any further drawings
@@ -130,18 +149,19 @@ void MeshPaintHandler::AddHitPoint(
 	EPaintMode paintMode,
 	ERemoteMode remoteMode,
 	ETeam team,
-	uint32 angle)
+	uint32 angle,
+	LambdaEngine::Entity target)
 {
 	std::scoped_lock<LambdaEngine::SpinLock> lock(s_SpinLock);
 
-	PaintData data = {};
-	data.TargetPosition				= { position.x, position.y, position.z, 1.0f };
-	data.TargetDirectionXYZAngleW	= { direction.x, direction.y, direction.z, glm::radians<float>((float)angle)};
-	data.PaintMode			= paintMode;
-	data.RemoteMode			= remoteMode;
-	data.Team				= team;
-	data.ClearClient		= 0;
-	s_Collisions.PushBack(data);
+	PaintHit hit = {};
+	hit.Position	= position;
+	hit.Direction	= direction;
+	hit.Angle		= glm::radians<float>((float)angle);
+	hit.PaintMode	= paintMode;
+	hit.RemoteMode	= remoteMode;
+	hit.Team		= team;
+	s_HitBatch.AddHit(target, hit);
 }
 
 void MeshPaintHandler::ResetClient()
@@ -185,7 +205,18 @@ bool MeshPaintHandler::OnProjectileHit(const ProjectileHitEvent& projectileHitEv
 				paintMode,
 				remoteMode,
 				team,
-				projectileHitEvent.Angle);
+				projectileHitEvent.Angle,
+				projectileHitEvent.CollisionInfo1.Entity);
+
+			// Keep the server's copy of the level's paint, which is sent to players that load the level later
+			PaintHit serverHit = {};
+			serverHit.Position		= collisionInfo.Position;
+			serverHit.Direction		= collisionInfo.Direction;
+			serverHit.Angle			= glm::radians<float>((float)projectileHitEvent.Angle);
+			serverHit.PaintMode		= paintMode;
+			serverHit.RemoteMode	= remoteMode;
+			serverHit.Team			= team;
+			PaintMaskSynchronizer::PaintServerHit(serverHit);
 
 			// LOG_WARNING("[SERVER] Hit Pos: (%f, %f, %f), Dir: (%f, %f, %f), PaintMode: %s, RemoteMode: %s, Team: %d, Angle: %d",
 			//  	VEC_TO_ARG(collisionInfo.Position),
@@ -207,7 +238,7 @@ bool MeshPaintHandler::OnProjectileHit(const ProjectileHitEvent& projectileHitEv
 		{
 			// If it is a client, paint it on the temporary mask and save the point.
 			remoteMode = ERemoteMode::CLIENT;
-			AddHitPoint(collisionInfo.Position, collisionInfo.Direction, paintMode, remoteMode, team, projectileHitEvent.Angle);
+			AddHitPoint(collisionInfo.Position, collisionInfo.Direction, paintMode, remoteMode, team, projectileHitEvent.Angle, projectileHitEvent.CollisionInfo1.Entity);
 			// LOG_WARNING("[CLIENT] Hit Pos: (%f, %f, %f), Dir: (%f, %f, %f), PaintMode: %s, RemoteMode: %s, Team: %d, Angle: %d",
 			//  	VEC_TO_ARG(collisionInfo.Position),
 			//  	VEC_TO_ARG(collisionInfo.Direction),
@@ -0,0 +1,110 @@
+#include "MeshPaint/MeshPaintReference.h"
+
+/*
+* MeshPaintReference
+*/
+
+void MeshPaintReference::ApplyHits(
+	LambdaEngine::TArray<PaintVertex>& vertices,
+	ETeam instanceTeam,
+	const PaintHit* pHits,
+	uint32 hitCount,
+	bool clearClient)
+{
+	for (PaintVertex& vertex : vertices)
+	{
+		ApplyHits(vertex, instanceTeam, pHits, hitCount, clearClient);
+	}
+}
+
+void MeshPaintReference::ApplyHits(
+	PaintVertex& vertex,
+	ETeam instanceTeam,
+	const PaintHit* pHits,
+	uint32 hitCount,
+	bool clearClient)
+{
+	constexpr const float32 EPSILON = 0.001f;
+	const glm::vec3 GLOBAL_UP = glm::vec3(0.0f, 1.0f, 0.0f);
+
+	const glm::vec3 normal = glm::normalize(vertex.Normal);
+
+	for (uint32 h = 0; h < hitCount; h++)
+	{
+		const PaintHit& hit = pHits[h];
+
+		const glm::vec3 direction			= glm::normalize(hit.Direction);
+		const glm::vec3 targetPosToWorldPos	= vertex.Position - hit.Position;
+
+		// Only paint surfaces facing the hit, not further along the direction than the paint reaches
+		if (glm::dot(normal, -direction) < 0.0f || glm::abs(glm::dot(targetPosToWorldPos, direction)) >= PAINT_DEPTH)
+		{
+			continue;
+		}
+
+		// Players are not painted by their own team but their team can remove paint from them, the level can always be painted
+		const bool isRemove			= hit.PaintMode == EPaintMode::REMOVE;
+		const bool isSameTeam		= instanceTeam == hit.Team;
+		const bool isEnvironment	= instanceTeam == ETeam::NONE;
+		if (isRemove ? !(isEnvironment || isSameTeam) : isSameTeam)
+		{
+			continue;
+		}
+
+		glm::vec3 up = GLOBAL_UP;
+		if (glm::abs(glm::abs(glm::dot(direction, up)) - 1.0f) < EPSILON)
+		{
+			up = glm::vec3(0.0f, 0.0f, 1.0f);
+		}
+
+		const glm::vec3 right = glm::normalize(glm::cross(direction, up));
+		up = glm::normalize(glm::cross(right, direction));
+
+		const glm::vec2 uv = glm::vec2(
+			glm::dot(-targetPosToWorldPos, right) / BRUSH_SIZE * 1.5f,
+			glm::dot(-targetPosToWorldPos, up) / BRUSH_SIZE * 1.5f) * 0.5f;
+
+		const float32 c = glm::cos(hit.Angle);
+		const float32 s = glm::sin(hit.Angle);
+		const glm::vec2 maskUV = glm::vec2(c * uv.x - s * uv.y, s * uv.x + c * uv.y) + 0.5f;
+
+		float32 dist = 1.0f;
+		if (maskUV.x > 0.0f && maskUV.x < 1.0f && maskUV.y > 0.0f && maskUV.y < 1.0f && SampleBrushMask(maskUV) > 0.001f)
+		{
+			dist = 0.0f;
+
+			uint32 client = (vertex.PaintInfo >> 4) & 0x0F;
+			uint32 server = vertex.PaintInfo & 0x0F;
+			if (hit.RemoteMode == ERemoteMode::CLIENT)
+			{
+				client = ((uint32)hit.Team * (uint32)hit.PaintMode) & 0x0F;
+			}
+			else if (hit.RemoteMode == ERemoteMode::SERVER)
+			{
+				server = ((uint32)hit.Team * (uint32)hit.PaintMode) & 0x0F;
+			}
+
+			vertex.PaintInfo = (vertex.PaintInfo & 0x100) | (client << 4) | server;
+
+			if (isRemove)
+			{
+				dist = 1.0f;
+				vertex.PaintDistance = dist;
+			}
+		}
+
+		vertex.PaintDistance = glm::min(vertex.PaintDistance, dist);
+	}
+
+	if (clearClient)
+	{
+		const uint32 server = vertex.PaintInfo & 0x0F;
+		vertex.PaintInfo		= server | (vertex.PaintInfo & 0x100);
+		vertex.PaintDistance	= server >= 1 ? 0.0f : 1.0f;
+	}
+}
+
+float32 MeshPaintReference::SampleBrushMask(const glm::vec2& uv)
+{
+	return glm::length(uv - 0.5f) < 0.5f ? 1.0f : 0.0f;
+}
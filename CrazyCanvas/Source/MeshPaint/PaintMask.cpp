@@ -0,0 +1,113 @@
+#include "MeshPaint/PaintMask.h"
+
+/*
+* PaintMask
+*/
+
+void PaintMask::Init(uint32 vertexCount)
+{
+	m_VertexCount = vertexCount;
+
+	const uint32 wordCount = (vertexCount + 63) / 64;
+	for (LambdaEngine::TArray<uint64>& maskBits : m_MaskBits)
+	{
+		maskBits.Assign(wordCount, 0);
+	}
+
+	m_ChunkVersions.Assign((vertexCount + CHUNK_VERTEX_COUNT - 1) / CHUNK_VERTEX_COUNT, 0);
+}
+
+bool PaintMask::SetMask(uint32 vertexIndex, uint8 mask)
+{
+	VALIDATE(vertexIndex < m_VertexCount);
+
+	const uint32 word	= vertexIndex / 64;
+	const uint64 bit	= 1ULL << (vertexIndex % 64);
+
+	bool changed = false;
+	for (uint32 b = 0; b < MASK_BIT_COUNT; b++)
+	{
+		uint64& maskWord = m_MaskBits[b][word];
+		const uint64 newWord = (mask & (1 << b)) ? (maskWord | bit) : (maskWord & ~bit);
+		changed |= newWord != maskWord;
+		maskWord = newWord;
+	}
+
+	if (changed)
+	{
+		m_ChunkVersions[vertexIndex / CHUNK_VERTEX_COUNT]++;
+	}
+
+	return changed;
+}
+
+uint8 PaintMask::GetMask(uint32 vertexIndex) const
+{
+	VALIDATE(vertexIndex < m_VertexCount);
+
+	const uint32 word	= vertexIndex / 64;
+	const uint32 shift	= vertexIndex % 64;
+
+	uint8 mask = 0;
+	for (uint32 b = 0; b < MASK_BIT_COUNT; b++)
+	{
+		mask |= uint8(((m_MaskBits[b][word] >> shift) & 1) << b);
+	}
+
+	return mask;
+}
+
+void PaintMask::EncodeChunk(uint32 chunkIndex, LambdaEngine::TArray<PaintMaskRun>& runs) const
+{
+	const uint32 firstVertex	= GetChunkFirstVertex(chunkIndex);
+	const uint32 vertexCount	= GetChunkVertexCount(chunkIndex);
+
+	PaintMaskRun run = { .Length = 0, .Mask = GetMask(firstVertex) };
+	for (uint32 v = firstVertex; v < firstVertex + vertexCount; v++)
+	{
+		const uint8 mask = GetMask(v);
+		if (mask != run.Mask)
+		{
+			runs.PushBack(run);
+			run.Length	= 0;
+			run.Mask	= mask;
+		}
+
+		run.Length++;
+	}
+
+	runs.PushBack(run);
+}
+
+bool PaintMask::DecodeChunk(uint32 chunkIndex, const PaintMaskRun* pRuns, uint32 runCount)
+{
+	if (chunkIndex >= GetChunkCount())
+	{
+		return false;
+	}
+
+	const uint32 firstVertex	= GetChunkFirstVertex(chunkIndex);
+	const uint32 vertexCount	= GetChunkVertexCount(chunkIndex);
+
+	uint32 runVertexCount = 0;
+	for (uint32 r = 0; r < runCount; r++)
+	{
+		runVertexCount += pRuns[r].Length;
+	}
+
+	if (runVertexCount != vertexCount)
+	{
+		return false;
+	}
+
+	uint32 vertexIndex = firstVertex;
+	for (uint32 r = 0; r < runCount; r++)
+	{
+		for (uint32 v = 0; v < pRuns[r].Length; v++)
+		{
+			SetMask(vertexIndex++, pRuns[r].Mask);
+		}
+	}
+
+	return true;
+}
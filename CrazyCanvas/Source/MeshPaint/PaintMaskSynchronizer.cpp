@@ -0,0 +1,293 @@
+#include "MeshPaint/PaintMaskSynchronizer.h"
+
+#include "Application/API/Events/EventQueue.h"
+
+#include "Game/Multiplayer/MultiplayerUtils.h"
+#include "Game/Multiplayer/Server/ServerSystem.h"
+
+#include "Networking/API/BinaryDecoder.h"
+#include "Networking/API/BinaryEncoder.h"
+
+#include "Multiplayer/Packet/PacketType.h"
+
+#include "RenderStages/MeshPaintUpdater.h"
+
+#include "Lobby/Player.h"
+
+using namespace LambdaEngine;
+
+TArray<PaintMaskSynchronizer::PaintMesh> PaintMaskSynchronizer::s_Meshes;
+THashTable<uint64, TArray<uint32>> PaintMaskSynchronizer::s_ChunksToSend;
+TArray<PaintMaskRun> PaintMaskSynchronizer::s_Runs;
+
+void PaintMaskSynchronizer::Init()
+{
+	EventQueue::RegisterEventHandler<PlayerStateUpdatedEvent>(&PaintMaskSynchronizer::OnPlayerStateUpdated);
+	EventQueue::RegisterEventHandler<PlayerLeftEvent>(&PaintMaskSynchronizer::OnPlayerLeft);
+	EventQueue::RegisterEventHandler<NetworkSegmentReceivedEvent>(&PaintMaskSynchronizer::OnPacketReceived);
+}
+
+void PaintMaskSynchronizer::Release()
+{
+	EventQueue::UnregisterEventHandler<PlayerStateUpdatedEvent>(&PaintMaskSynchronizer::OnPlayerStateUpdated);
+	EventQueue::UnregisterEventHandler<PlayerLeftEvent>(&PaintMaskSynchronizer::OnPlayerLeft);
+	EventQueue::UnregisterEventHandler<NetworkSegmentReceivedEvent>(&PaintMaskSynchronizer::OnPacketReceived);
+
+	Clear();
+}
+
+void PaintMaskSynchronizer::RegisterMesh(Entity entity, const Mesh* pMesh, const glm::mat4& transform)
+{
+	PaintMesh& paintMesh = s_Meshes.PushBack({});
+	paintMesh.Entity = entity;
+	paintMesh.Mask.Init(pMesh->Vertices.GetSize());
+
+	// The clients paint their meshes on the GPU, only the server needs the vertices
+	if (MultiplayerUtils::IsServer())
+	{
+		const glm::mat4 normalTransform = glm::transpose(glm::inverse(transform));
+
+		paintMesh.BoundsMin = glm::vec3(FLT_MAX);
+		paintMesh.BoundsMax = glm::vec3(-FLT_MAX);
+
+		paintMesh.Vertices.Resize(pMesh->Vertices.GetSize());
+		for (uint32 v = 0; v < pMesh->Vertices.GetSize(); v++)
+		{
+			PaintVertex& paintVertex = paintMesh.Vertices[v];
+			paintVertex.Position	= glm::vec3(transform * glm::vec4(pMesh->Vertices[v].ExtractPosition(), 1.0f));
+			paintVertex.Normal		= glm::normalize(glm::vec3(normalTransform * glm::vec4(pMesh->Vertices[v].ExtractNormal(), 0.0f)));
+
+			paintMesh.BoundsMin = glm::min(paintMesh.BoundsMin, paintVertex.Position);
+			paintMesh.BoundsMax = glm::max(paintMesh.BoundsMax, paintVertex.Position);
+		}
+
+		BuildVertexGrid(paintMesh);
+	}
+}
+
+void PaintMaskSynchronizer::BuildVertexGrid(PaintMesh& paintMesh)
+{
+	const uint32 vertexCount = paintMesh.Vertices.GetSize();
+
+	// Count the vertices of each cell
+	TArray<uint64> vertexCellKeys(vertexCount);
+	for (uint32 v = 0; v < vertexCount; v++)
+	{
+		vertexCellKeys[v] = PackCellKey(GetCell(paintMesh, paintMesh.Vertices[v].Position));
+		paintMesh.CellRanges[vertexCellKeys[v]].y++;
+	}
+
+	// Give each cell its range in CellVertices, then fill the ranges
+	uint32 firstIndex = 0;
+	for (auto& cellRange : paintMesh.CellRanges)
+	{
+		cellRange.second.x = firstIndex;
+		firstIndex += cellRange.second.y;
+		cellRange.second.y = 0;
+	}
+
+	paintMesh.CellVertices.Resize(vertexCount);
+	for (uint32 v = 0; v < vertexCount; v++)
+	{
+		glm::uvec2& cellRange = paintMesh.CellRanges[vertexCellKeys[v]];
+		paintMesh.CellVertices[cellRange.x + cellRange.y] = v;
+		cellRange.y++;
+	}
+}
+
+void PaintMaskSynchronizer::Clear()
+{
+	s_Meshes.Clear();
+	s_ChunksToSend.clear();
+}
+
+void PaintMaskSynchronizer::PaintServerHit(const PaintHit& hit)
+{
+	VALIDATE(hit.RemoteMode == ERemoteMode::SERVER);
+
+	const glm::vec3 reach = glm::vec3(MeshPaintReference::PAINT_REACH);
+	for (PaintMesh& paintMesh : s_Meshes)
+	{
+		// The GPU paints every mesh with every hit, skip the meshes that are too far away to be painted
+		if (glm::any(glm::lessThan(hit.Position + reach, paintMesh.BoundsMin)) || glm::any(glm::greaterThan(hit.Position - reach, paintMesh.BoundsMax)))
+		{
+			continue;
+		}
+
+		// Only the vertices in the cells that the reach of the hit overlaps can be painted
+		const glm::uvec3 minCell = GetCell(paintMesh, hit.Position - reach);
+		const glm::uvec3 maxCell = GetCell(paintMesh, glm::min(hit.Position + reach, paintMesh.BoundsMax));
+		for (uint32 x = minCell.x; x <= maxCell.x; x++)
+		{
+			for (uint32 y = minCell.y; y <= maxCell.y; y++)
+			{
+				for (uint32 z = minCell.z; z <= maxCell.z; z++)
+				{
+					auto cellRangeIt = paintMesh.CellRanges.find(PackCellKey(glm::uvec3(x, y, z)));
+					if (cellRangeIt == paintMesh.CellRanges.end())
+					{
+						continue;
+					}
+
+					const glm::uvec2& cellRange = cellRangeIt->second;
+					for (uint32 i = cellRange.x; i < cellRange.x + cellRange.y; i++)
+					{
+						const uint32 v = paintMesh.CellVertices[i];
+						PaintVertex& paintVertex = paintMesh.Vertices[v];
+						MeshPaintReference::ApplyHits(paintVertex, ETeam::NONE, &hit, 1, false);
+
+						// The server team of the vertex is the lower four bits, zero if it has no server paint
+						const uint32 server = paintVertex.PaintInfo & 0x0F;
+						paintMesh.Mask.SetMask(v, server != 0 ? uint8(0x01 | ((server & 0x03) << 1)) : 0);
+					}
+				}
+			}
+		}
+	}
+}
+
+void PaintMaskSynchronizer::FixedTick()
+{
+	if (s_ChunksToSend.empty())
+	{
+		return;
+	}
+
+	ServerBase* pServer = ServerSystem::GetInstance().GetServer();
+	for (auto chunksToSendIt = s_ChunksToSend.begin(); chunksToSendIt != s_ChunksToSend.end();)
+	{
+		ClientRemoteBase* pClient = pServer->GetClient(chunksToSendIt->first);
+		TArray<uint32>& chunksToSend = chunksToSendIt->second;
+
+		for (uint32 c = 0; c < MAX_CHUNKS_PER_TICK && pClient && !chunksToSend.IsEmpty(); c++)
+		{
+			NetworkSegment* pPacket = pClient->GetFreePacket(PacketType::PAINT_MASK_CHUNK);
+			if (!pPacket)
+			{
+				break;
+			}
+
+			// Chunks are encoded when they are sent so that paint added since they were queued is included
+			const uint32 chunkID	= chunksToSend.GetBack();
+			const uint32 meshIndex	= chunkID >> 16;
+			const uint32 chunkIndex	= chunkID & 0xFFFF;
+			chunksToSend.PopBack();
+
+			s_Runs.Clear();
+			s_Meshes[meshIndex].Mask.EncodeChunk(chunkIndex, s_Runs);
+
+			BinaryEncoder encoder(pPacket);
+			encoder.WriteUInt16(uint16(meshIndex));
+			encoder.WriteUInt16(uint16(chunkIndex));
+			encoder.WriteUInt16(uint16(s_Runs.GetSize()));
+			encoder.WriteBuffer(reinterpret_cast<const uint8*>(s_Runs.GetData()), uint16(s_Runs.GetSize() * sizeof(PaintMaskRun)));
+			pClient->SendReliable(pPacket);
+		}
+
+		if (!pClient || chunksToSend.IsEmpty())
+		{
+			chunksToSendIt = s_ChunksToSend.erase(chunksToSendIt);
+		}
+		else
+		{
+			chunksToSendIt++;
+		}
+	}
+}
+
+void PaintMaskSynchronizer::QueueAllPaintedChunks(uint64 playerUID)
+{
+	TArray<uint32>& chunksToSend = s_ChunksToSend[playerUID];
+	chunksToSend.Clear();
+
+	// Send the chunks from the back, so queue them in reverse to send the first mesh first
+	for (int32 m = int32(s_Meshes.GetSize()) - 1; m >= 0; m--)
+	{
+		const PaintMask& mask = s_Meshes[m].Mask;
+		for (int32 c = int32(mask.GetChunkCount()) - 1; c >= 0; c--)
+		{
+			if (mask.GetChunkVersion(c) != 0)
+			{
+				chunksToSend.PushBack(PackChunkID(m, c));
+			}
+		}
+	}
+
+	if (chunksToSend.IsEmpty())
+	{
+		s_ChunksToSend.erase(playerUID);
+	}
+}
+
+bool PaintMaskSynchronizer::OnPlayerStateUpdated(const PlayerStateUpdatedEvent& event)
+{
+	// The player has created the meshes of the level and receives new hits from now on
+	if (MultiplayerUtils::IsServer() && event.pPlayer->GetState() == GAME_STATE_LOADED)
+	{
+		QueueAllPaintedChunks(event.pPlayer->GetUID());
+	}
+
+	return false;
+}
+
+bool PaintMaskSynchronizer::OnPlayerLeft(const PlayerLeftEvent& event)
+{
+	s_ChunksToSend.erase(event.pPlayer->GetUID());
+	return false;
+}
+
+bool PaintMaskSynchronizer::OnPacketReceived(const NetworkSegmentReceivedEvent& event)
+{
+	if (event.Type != PacketType::PAINT_MASK_CHUNK)
+	{
+		return false;
+	}
+
+	if (!MultiplayerUtils::IsServer())
+	{
+		uint16 meshIndex	= 0;
+		uint16 chunkIndex	= 0;
+		uint16 runCount		= 0;
+
+		BinaryDecoder decoder(event.pPacket);
+		if (!decoder.ReadUInt16(meshIndex) || !decoder.ReadUInt16(chunkIndex) || !decoder.ReadUInt16(runCount))
+		{
+			LOG_WARNING("[PaintMaskSynchronizer]: Received a truncated paint mask chunk");
+			return true;
+		}
+
+		// Validate the run count before it is used to size the runs, so that a corrupt count cannot allocate or read past the packet
+		if (runCount > PaintMask::MAX_RUNS_PER_CHUNK || CHUNK_HEADER_SIZE + runCount * sizeof(PaintMaskRun) > event.pPacket->GetBufferSize())
+		{
+			LOG_WARNING("[PaintMaskSynchronizer]: Received a paint mask chunk with an invalid run count %u", runCount);
+			return true;
+		}
+
+		s_Runs.Resize(runCount);
+		if (!decoder.ReadBuffer(reinterpret_cast<uint8*>(s_Runs.GetData()), uint16(runCount * sizeof(PaintMaskRun))))
+		{
+			LOG_WARNING("[PaintMaskSynchronizer]: Received a truncated paint mask chunk");
+			return true;
+		}
+
+		if (meshIndex >= s_Meshes.GetSize() || !s_Meshes[meshIndex].Mask.DecodeChunk(chunkIndex, s_Runs.GetData(), runCount))
+		{
+			LOG_WARNING("[PaintMaskSynchronizer]: Received paint mask chunk %u of mesh %u which does not match the level", chunkIndex, meshIndex);
+			return true;
+		}
+
+		const PaintMesh& paintMesh = s_Meshes[meshIndex];
+		const uint32 firstVertex = paintMesh.Mask.GetChunkFirstVertex(chunkIndex);
+		const uint32 vertexCount = paintMesh.Mask.GetChunkVertexCount(chunkIndex);
+
+		TArray<uint8> masks(vertexCount);
+		for (uint32 v = 0; v < vertexCount; v++)
+		{
+			masks[v] = paintMesh.Mask.GetMask(firstVertex + v);
+		}
+
+		MeshPaintUpdater::SetServerMasks(paintMesh.Entity, paintMesh.Mask.GetVertexCount(), firstVertex, masks.GetData(), vertexCount);
+	}
+
+	return true;
+}
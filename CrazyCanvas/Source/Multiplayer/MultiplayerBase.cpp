@@ -3,6 +3,7 @@
 #include "Match/Match.h"
 
 #include "ECS/Systems/Player/WeaponSystem.h"
+#include "ECS/Systems/Player/ProjectileSystem.h"
 #include "ECS/Systems/Player/HealthSystem.h"
 
 #include "Debug/Profiler.h"
@@ -20,6 +21,7 @@ MultiplayerBase::~MultiplayerBase()
 	}
 
 	WeaponSystem::Release();
+	ProjectileSystem::Release();
 	HealthSystem::Release();
 }
 
@@ -29,6 +31,7 @@ void MultiplayerBase::InitInternal()
 	m_GrenadeSystem.Init();
 
 	WeaponSystem::Init();
+	ProjectileSystem::Init();
 	HealthSystem::Init();
 
 	Init();
@@ -46,5 +49,6 @@ void MultiplayerBase::FixedTickMainThreadInternal(LambdaEngine::Timestamp deltaT
 	PROFILE_FUNCTION("Match::FixedTick", Match::FixedTick(deltaTime));
 	PROFILE_FUNCTION("FixedTickMainThread", FixedTickMainThread(deltaTime));
 	PROFILE_FUNCTION("WeaponSystem::FixedTick", WeaponSystem::GetInstance().FixedTick(deltaTime));
+	PROFILE_FUNCTION("ProjectileSystem::FixedTick", ProjectileSystem::GetInstance().FixedTick(deltaTime));
 	PROFILE_FUNCTION("PostFixedTickMainThread", PostFixedTickMainThread(deltaTime));
 }
@@ -61,6 +61,7 @@ void PacketType::Init()
 	RESET_PLAYER_TEXTURE	= RegisterPacketTypeWithComponent<PacketResetPlayerTexture>();
 	SESSION_SETTING_CHANGED	= RegisterPacketType<PacketSessionSettingChanged>();
 	GRENADE_THROWN			= RegisterPacketType<PacketGrenadeThrown>();
+	PAINT_MASK_CHUNK		= RegisterPacketTypeRaw("PAINT_MASK_CHUNK");
 }
 
 uint16 PacketType::RegisterPacketTypeRaw(const char* pName)
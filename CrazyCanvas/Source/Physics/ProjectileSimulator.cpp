@@ -0,0 +1,217 @@
+#include "Physics/ProjectileSimulator.h"
+#include "Physics/CollisionGroups.h"
+
+#include "Game/ECS/Components/Physics/Transform.h"
+
+// Direction of an actor the way PhysicsSystem fills it in for contacts: its velocity if it moves, otherwise its forward
+static glm::vec3 GetActorDirection(const physx::PxRigidActor* pActor)
+{
+	using namespace physx;
+
+	const PxTransform transformPX = pActor->getGlobalPose();
+	glm::vec3 direction = LambdaEngine::GetForward(glm::quat(transformPX.q.w, transformPX.q.x, transformPX.q.y, transformPX.q.z));
+	if (pActor->is<PxRigidDynamic>())
+	{
+		const PxVec3 velocityPX = static_cast<const PxRigidDynamic*>(pActor)->getLinearVelocity();
+		if (!velocityPX.isZero())
+		{
+			direction = glm::normalize(glm::vec3(velocityPX.x, velocityPX.y, velocityPX.z));
+		}
+	}
+
+	return direction;
+}
+
+template<typename T>
+static void RemoveSwap(LambdaEngine::TArray<T>& array, uint32 index)
+{
+	array[index] = array.GetBack();
+	array.PopBack();
+}
+
+void ProjectileSimulator::AddProjectile(LambdaEngine::Entity entity, LambdaEngine::Entity owner, const glm::vec3& position, const glm::vec3& velocity)
+{
+	VALIDATE(m_EntityToIndex.find(entity) == m_EntityToIndex.end());
+
+	m_EntityToIndex[entity] = m_Entities.GetSize();
+	m_Entities.PushBack(entity);
+	m_Owners.PushBack(owner);
+
+	m_PositionsX.PushBack(position.x);
+	m_PositionsY.PushBack(position.y);
+	m_PositionsZ.PushBack(position.z);
+	m_VelocitiesX.PushBack(velocity.x);
+	m_VelocitiesY.PushBack(velocity.y);
+	m_VelocitiesZ.PushBack(velocity.z);
+	m_Lifetimes.PushBack(0.0f);
+}
+
+void ProjectileSimulator::RemoveProjectile(LambdaEngine::Entity entity)
+{
+	auto indexItr = m_EntityToIndex.find(entity);
+	if (indexItr != m_EntityToIndex.end())
+	{
+		RemoveProjectileAt(indexItr->second);
+	}
+}
+
+void ProjectileSimulator::Step(float32 deltaTime)
+{
+	using namespace LambdaEngine;
+
+	m_Hits.Clear();
+	m_ExpiredProjectiles.Clear();
+	m_ProjectilesToRemove.Clear();
+	m_QueryBatch.Reset();
+
+	const uint32 projectileCount = m_Entities.GetSize();
+	if (projectileCount == 0 || deltaTime <= 0.0f)
+	{
+		return;
+	}
+
+	// Integrate, gravity pulls along -g_DefaultUp which is the negative y-axis
+	const float32 gravityDisplacement	= -0.5f * GRAVITATIONAL_ACCELERATION * deltaTime * deltaTime;
+	const float32 gravityVelocity		= -GRAVITATIONAL_ACCELERATION * deltaTime;
+
+	m_NextPositionsX.Resize(projectileCount);
+	m_NextPositionsY.Resize(projectileCount);
+	m_NextPositionsZ.Resize(projectileCount);
+
+	for (uint32 p = 0; p < projectileCount; p++)
+	{
+		m_NextPositionsX[p] = m_PositionsX[p] + m_VelocitiesX[p] * deltaTime;
+		m_NextPositionsY[p] = m_PositionsY[p] + m_VelocitiesY[p] * deltaTime + gravityDisplacement;
+		m_NextPositionsZ[p] = m_PositionsZ[p] + m_VelocitiesZ[p] * deltaTime;
+		m_VelocitiesY[p] += gravityVelocity;
+		m_Lifetimes[p] += deltaTime;
+	}
+
+	// Sweep the path of every projectile, query p belongs to projectile p. The kill plane is a static trigger and must not stop projectiles
+	QueryFilterData filterData =
+	{
+		.IncludedGroup	= (uint32)FCrazyCanvasCollisionGroup::COLLISION_GROUP_PLAYER | (uint32)FCollisionGroup::COLLISION_GROUP_STATIC,
+		.ExcludedGroup	= 0,
+		.IgnoreTriggers	= true
+	};
+
+	for (uint32 p = 0; p < projectileCount; p++)
+	{
+		const glm::vec3 position		= GetPosition(p);
+		const glm::vec3 displacement	= glm::vec3(m_NextPositionsX[p], m_NextPositionsY[p], m_NextPositionsZ[p]) - position;
+		const float32 distance			= glm::length(displacement);
+
+		filterData.ExcludedEntity = m_Owners[p];
+
+		const SweepQueryInfo sweepInfo =
+		{
+			.GeometryType	= EGeometryType::SPHERE,
+			.GeometryParams	= { .Radius = PROJECTILE_RADIUS },
+			.Position		= position,
+			.Rotation		= glm::identity<glm::quat>(),
+			.Direction		= displacement / distance,
+			.MaxDistance	= distance,
+			.pFilterData	= &filterData
+		};
+
+		m_QueryBatch.AddSweep(sweepInfo);
+	}
+
+	PhysicsSystem::GetInstance()->ExecuteQueryBatch(m_QueryBatch);
+
+	for (uint32 p = 0; p < projectileCount; p++)
+	{
+		if (m_QueryBatch.GetHitCount(p) > 0)
+		{
+			const PxSweepHit& hit = m_QueryBatch.GetSweepHit(p);
+			const ActorUserData* pActorUserData = reinterpret_cast<const ActorUserData*>(hit.actor->userData);
+
+			// The position of a sweep that starts inside a shape is not set, the projectile hits where it is
+			const glm::vec3 hitPosition = hit.hadInitialOverlap() ? GetPosition(p) : glm::vec3(hit.position.x, hit.position.y, hit.position.z);
+			const glm::vec3 hitNormal = glm::vec3(hit.normal.x, hit.normal.y, hit.normal.z);
+
+			ProjectileHit projectileHit =
+			{
+				.ProjectileInfo =
+				{
+					.Entity		= m_Entities[p],
+					.Position	= hitPosition,
+					.Direction	= m_QueryBatch.GetDirection(p),
+					.Normal		= hitNormal
+				},
+				.OtherInfo =
+				{
+					.Entity		= pActorUserData ? pActorUserData->Entity : UINT32_MAX,
+					.Position	= hitPosition,
+					.Direction	= GetActorDirection(hit.actor),
+					.Normal		= -hitNormal
+				}
+			};
+
+			m_PositionsX[p] = hitPosition.x;
+			m_PositionsY[p] = hitPosition.y;
+			m_PositionsZ[p] = hitPosition.z;
+
+			m_Hits.PushBack(projectileHit);
+			m_ProjectilesToRemove.PushBack(p);
+		}
+		else
+		{
+			m_PositionsX[p] = m_NextPositionsX[p];
+			m_PositionsY[p] = m_NextPositionsY[p];
+			m_PositionsZ[p] = m_NextPositionsZ[p];
+
+			if (m_Lifetimes[p] >= MAX_LIFETIME)
+			{
+				m_ExpiredProjectiles.PushBack(m_Entities[p]);
+				m_ProjectilesToRemove.PushBack(p);
+			}
+		}
+	}
+
+	// Removing from the back keeps the indices of the remaining projectiles to remove valid
+	for (int32 r = int32(m_ProjectilesToRemove.GetSize()) - 1; r >= 0; r--)
+	{
+		RemoveProjectileAt(m_ProjectilesToRemove[r]);
+	}
+}
+
+void ProjectileSimulator::Clear()
+{
+	m_PositionsX.Clear();
+	m_PositionsY.Clear();
+	m_PositionsZ.Clear();
+	m_VelocitiesX.Clear();
+	m_VelocitiesY.Clear();
+	m_VelocitiesZ.Clear();
+	m_Lifetimes.Clear();
+	m_Entities.Clear();
+	m_Owners.Clear();
+	m_EntityToIndex.clear();
+
+	m_Hits.Clear();
+	m_ExpiredProjectiles.Clear();
+	m_ProjectilesToRemove.Clear();
+	m_QueryBatch.Reset();
+}
+
+void ProjectileSimulator::RemoveProjectileAt(uint32 projectileIndex)
+{
+	m_EntityToIndex.erase(m_Entities[projectileIndex]);
+
+	RemoveSwap(m_PositionsX, projectileIndex);
+	RemoveSwap(m_PositionsY, projectileIndex);
+	RemoveSwap(m_PositionsZ, projectileIndex);
+	RemoveSwap(m_VelocitiesX, projectileIndex);
+	RemoveSwap(m_VelocitiesY, projectileIndex);
+	RemoveSwap(m_VelocitiesZ, projectileIndex);
+	RemoveSwap(m_Lifetimes, projectileIndex);
+	RemoveSwap(m_Owners, projectileIndex);
+	RemoveSwap(m_Entities, projectileIndex);
+
+	// The last projectile was moved into the removed one's slot
+	if (projectileIndex < m_Entities.GetSize())
+	{
+		m_EntityToIndex[m_Entities[projectileIndex]] = projectileIndex;
+	}
+}
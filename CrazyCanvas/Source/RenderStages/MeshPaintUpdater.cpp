@@ -1,5 +1,6 @@
 #include "RenderStages/MeshPaintUpdater.h"
 
+#include "Rendering/Core/API/Buffer.h"
 #include "Rendering/Core/API/CommandAllocator.h"
 #include "Rendering/Core/API/CommandList.h"
 #include "Rendering/Core/API/DescriptorHeap.h"
@@ -15,6 +16,7 @@ namespace LambdaEngine
 {
 	std::unordered_set<Entity> MeshPaintUpdater::s_EntitiesToClear;
 	uint32 MeshPaintUpdater::s_HitPointBufferValid = 0;
+	THashTable<Entity, TArray<uint32>> MeshPaintUpdater::s_ServerMasksToApply;
 
 	MeshPaintUpdater::MeshPaintUpdater()
 	{
@@ -48,6 +50,22 @@ namespace LambdaEngine
 		s_HitPointBufferValid = (uint32)valid;
 	}
 
+	void MeshPaintUpdater::SetServerMasks(Entity entity, uint32 vertexCount, uint32 firstVertex, const uint8* pMasks, uint32 maskCount)
+	{
+		VALIDATE(firstVertex + maskCount <= vertexCount);
+
+		TArray<uint32>& masks = s_ServerMasksToApply[entity];
+		if (masks.GetSize() != vertexCount)
+		{
+			masks.Assign(vertexCount, SERVER_MASK_KEEP);
+		}
+
+		for (uint32 m = 0; m < maskCount; m++)
+		{
+			masks[firstVertex + m] = pMasks[m];
+		}
+	}
+
 	bool LambdaEngine::MeshPaintUpdater::CreatePipelineLayout()
 	{
 		// Set 0
@@ -123,6 +141,21 @@ namespace LambdaEngine
 			m_UpdatePipeline.CreateDescriptorSetLayout(descriptorBindings);
 		}
 
+		// Set 3
+		{
+			DescriptorBindingDesc serverMasksBindingDesc = {};
+			serverMasksBindingDesc.DescriptorType = EDescriptorType::DESCRIPTOR_TYPE_UNORDERED_ACCESS_BUFFER;
+			serverMasksBindingDesc.DescriptorCount = 1;
+			serverMasksBindingDesc.Binding = 0;
+			serverMasksBindingDesc.ShaderStageMask = FShaderStageFlag::SHADER_STAGE_FLAG_COMPUTE_SHADER;
+
+			TArray<DescriptorBindingDesc> descriptorBindings = {
+				serverMasksBindingDesc
+			};
+
+			m_UpdatePipeline.CreateDescriptorSetLayout(descriptorBindings);
+		}
+
 		ConstantRangeDesc constantRange = {};
 		constantRange.ShaderStageFlags = FShaderStageFlag::SHADER_STAGE_FLAG_COMPUTE_SHADER;
 		constantRange.SizeInBytes = sizeof(SPushConstantData);
@@ -140,7 +173,7 @@ namespace LambdaEngine
 		descriptorCountDesc.TextureDescriptorCount = 0;
 		descriptorCountDesc.TextureCombinedSamplerDescriptorCount = 1;
 		descriptorCountDesc.ConstantBufferDescriptorCount = 1;
-		descriptorCountDesc.UnorderedAccessBufferDescriptorCount = 2;
+		descriptorCountDesc.UnorderedAccessBufferDescriptorCount = 3;
 		descriptorCountDesc.UnorderedAccessTextureDescriptorCount = 0;
 		descriptorCountDesc.AccelerationStructureDescriptorCount = 0;
 
@@ -201,6 +234,53 @@ namespace LambdaEngine
 		return true;
 	}
 
+	bool LambdaEngine::MeshPaintUpdater::WriteServerMasks(uint32 modFrameIndex, const TArray<uint32>& masks)
+	{
+		const uint64 sizeInBytes = masks.GetSize() * sizeof(uint32);
+
+		// The buffer of this frame is no longer read by the GPU, grow it if the masks do not fit
+		TSharedRef<Buffer>& serverMaskBuffer = m_ServerMaskBuffers[modFrameIndex];
+		if (!serverMaskBuffer || serverMaskBuffer->GetDesc().SizeInBytes < sizeInBytes)
+		{
+			BufferDesc serverMaskBufferDesc		= {};
+			serverMaskBufferDesc.DebugName		= "Mesh Paint Updater Server Mask Buffer " + std::to_string(modFrameIndex);
+			serverMaskBufferDesc.MemoryType		= EMemoryType::MEMORY_TYPE_CPU_VISIBLE;
+			serverMaskBufferDesc.SizeInBytes	= glm::max<uint64>(sizeInBytes, sizeof(uint32));
+			serverMaskBufferDesc.Flags			= FBufferFlag::BUFFER_FLAG_UNORDERED_ACCESS_BUFFER;
+
+			serverMaskBuffer = RenderAPI::GetDevice()->CreateBuffer(&serverMaskBufferDesc);
+			if (!serverMaskBuffer)
+			{
+				return false;
+			}
+		}
+
+		if (!masks.IsEmpty())
+		{
+			void* pMapped = serverMaskBuffer->Map();
+			memcpy(pMapped, masks.GetData(), sizeInBytes);
+			serverMaskBuffer->Unmap();
+		}
+
+		constexpr uint32 setIndex = 3U;
+		constexpr uint32 setBinding = 0U;
+
+		const Buffer* pBuffer = serverMaskBuffer.Get();
+		uint64 offset = 0;
+		uint64 size = serverMaskBuffer->GetDesc().SizeInBytes;
+
+		SDescriptorBufferUpdateDesc descriptorUpdateDesc = {};
+		descriptorUpdateDesc.ppBuffers = &pBuffer;
+		descriptorUpdateDesc.pOffsets = &offset;
+		descriptorUpdateDesc.pSizes = &size;
+		descriptorUpdateDesc.FirstBinding = setBinding;
+		descriptorUpdateDesc.DescriptorCount = 1;
+		descriptorUpdateDesc.DescriptorType = EDescriptorType::DESCRIPTOR_TYPE_UNORDERED_ACCESS_BUFFER;
+
+		m_UpdatePipeline.UpdateDescriptorSet("[MeshPaintUpdater] Server masks Buffer Descriptor Set 3 Binding 0 " + std::to_string(modFrameIndex), setIndex, m_DescriptorHeap.Get(), descriptorUpdateDesc, false);
+		return true;
+	}
+
 	bool LambdaEngine::MeshPaintUpdater::Init()
 	{
 		m_BackBufferCount = BACK_BUFFER_COUNT;
@@ -244,6 +324,13 @@ namespace LambdaEngine
 				return false;
 			}
 
+			// Set 3 has to be bound even when no masks are applied
+			if (!WriteServerMasks(0, TArray<uint32>()))
+			{
+				LOG_ERROR("[MeshPaintUpdater]: Failed to create server mask buffer");
+				return false;
+			}
+
 			m_Initilized = true;
 		}
 
@@ -350,6 +437,44 @@ namespace LambdaEngine
 		m_ppComputeCommandAllocators[modFrameIndex]->Reset();
 		pCommandList->Begin(nullptr);
 
+		// Apply the server masks of all pending entities this frame. The shader applies them before the hit points of the same dispatch,
+		// hits that arrived after the masks are therefore painted on top of them instead of being overwritten by the older snapshot
+		m_ServerMasks.Clear();
+		m_ServerMaskOffsets.Resize(m_DrawArgsDescriptorSets.GetSize());
+		for (uint32 d = 0; d < m_DrawArgsDescriptorSets.GetSize(); d++)
+		{
+			m_ServerMaskOffsets[d] = SERVER_MASK_NONE;
+
+			if (s_ServerMasksToApply.empty())
+				continue;
+
+			auto serverMasksIt = s_ServerMasksToApply.find(m_DrawArgsDescriptorSets[d].first);
+			if (serverMasksIt != s_ServerMasksToApply.end())
+			{
+				const TArray<uint32>& masks = serverMasksIt->second;
+				if (masks.GetSize() == m_VertexCountList[d])
+				{
+					m_ServerMaskOffsets[d] = m_ServerMasks.GetSize();
+					m_ServerMasks.Insert(m_ServerMasks.End(), masks.Begin(), masks.End());
+				}
+				else
+				{
+					LOG_WARNING("[MeshPaintUpdater]: Failed to apply server masks to entity %u", serverMasksIt->first);
+				}
+
+				s_ServerMasksToApply.erase(serverMasksIt);
+			}
+		}
+
+		if (!m_ServerMasks.IsEmpty() && !WriteServerMasks(modFrameIndex, m_ServerMasks))
+		{
+			LOG_WARNING("[MeshPaintUpdater]: Failed to write server masks");
+			for (uint32& serverMaskOffset : m_ServerMaskOffsets)
+			{
+				serverMaskOffset = SERVER_MASK_NONE;
+			}
+		}
+
 		m_UpdatePipeline.Bind(pCommandList);
 
 		for (uint32 d = 0; d < m_VertexCountList.GetSize(); d++)
@@ -359,6 +484,14 @@ namespace LambdaEngine
 			// Check if this entity should clear its server side vertex paint.
 			pushConstantData.ShouldResetServer		= (uint32)s_EntitiesToClear.contains(m_DrawArgsDescriptorSets[d].first);
 			pushConstantData.HitPointBufferValid	= s_HitPointBufferValid | pushConstantData.ShouldResetServer;
+			pushConstantData.ApplyServerMask		= (uint32)(m_ServerMaskOffsets[d] != SERVER_MASK_NONE);
+			pushConstantData.ServerMaskOffset		= pushConstantData.ApplyServerMask ? m_ServerMaskOffsets[d] : 0;
+
+			// The shader does not touch the vertices without hit points, a reset or server masks, skip the dispatch
+			if (pushConstantData.HitPointBufferValid == 0 && pushConstantData.ApplyServerMask == 0)
+			{
+				continue;
+			}
 
 			pCommandList->BindDescriptorSetCompute(m_DrawArgsDescriptorSets[d].second, m_UpdatePipeline.GetPipelineLayout().Get(), 1);
 			m_UpdatePipeline.BindConstantRange(pCommandList, (void*)&pushConstantData, sizeof(pushConstantData), 0U);
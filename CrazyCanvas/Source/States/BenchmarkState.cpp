@@ -1,6 +1,7 @@
 #include "States/BenchmarkState.h"
 
 #include "Application/API/CommonApplication.h"
+#include "Application/API/Events/EventBuffer.h"
 #include "Application/API/Events/EventQueue.h"
 
 #include "Debug/GPUProfiler.h"
@@ -18,6 +19,7 @@
 #include "Game/ECS/Components/Rendering/PointLightComponent.h"
 #include "Game/ECS/Components/Misc/Components.h"
 #include "Game/ECS/Systems/Physics/PhysicsSystem.h"
+#include "Game/ECS/Systems/Physics/SceneQueryBatch.h"
 #include "Game/ECS/Systems/Rendering/RenderSystem.h"
 #include "Game/ECS/Systems/TrackSystem.h"
 
@@ -48,6 +50,26 @@
 
 #include "Resources/ResourceCatalog.h"
 
+#include "Memory/API/OffsetAllocator.h"
+#include "Memory/API/RingAllocator.h"
+
+#include "Rendering/LineBatch.h"
+#include "Rendering/ParticleAliveList.h"
+#include "Rendering/RenderGraphAliasingPlanner.h"
+#include "Rendering/StagingBufferCache.h"
+#include "Rendering/RT/TLASUpdateTracker.h"
+
+#include "Physics/ProjectileSimulator.h"
+
+#include "Networking/API/SegmentPool.h"
+
+#include "MeshPaint/MeshPaintHandler.h"
+#include "MeshPaint/MeshPaintReference.h"
+
+#include <chrono>
+#include <random>
+#include <thread>
+
 BenchmarkState::BenchmarkState()
 {
 	using namespace LambdaEngine;
@@ -64,6 +86,7 @@ BenchmarkState::~BenchmarkState()
 
 	SingleplayerInitializer::Release();
 	WeaponSystem::Release();
+	ProjectileSystem::Release();
 }
 
 void BenchmarkState::Init()
@@ -84,6 +107,7 @@ void BenchmarkState::Init()
 
 	// Initialize Systems
 	WeaponSystem::Init();
+	ProjectileSystem::Init();
 	m_BenchmarkSystem.Init();
 	TrackSystem::GetInstance().Init();
 
@@ -284,6 +308,13 @@ void BenchmarkState::Tick(LambdaEngine::Timestamp delta)
 {
 	LambdaEngine::GPUProfiler::Get()->Tick(delta);
 
+	// Compares one frame of the particle update pass against ParticleSimulatorCPU once the level has spawned particles
+	LambdaEngine::ParticleManager& particleManager = LambdaEngine::RenderSystem::GetInstance().GetParticleManager();
+	if (particleManager.IsInitilized() && !particleManager.HasCPUComparisonResult())
+	{
+		particleManager.RequestCPUComparison();
+	}
+
 	if (LambdaEngine::TrackSystem::GetInstance().HasReachedEnd(m_Camera))
 	{
 		PrintBenchmarkResults();
@@ -294,6 +325,7 @@ void BenchmarkState::Tick(LambdaEngine::Timestamp delta)
 void BenchmarkState::FixedTick(LambdaEngine::Timestamp delta)
 {
 	WeaponSystem::GetInstance().FixedTick(delta);
+	ProjectileSystem::GetInstance().FixedTick(delta);
 }
 
 bool BenchmarkState::OnPacketCreateLevelObjectReceived(const PacketReceivedEvent<PacketCreateLevelObject>& event)
@@ -369,6 +401,7 @@ bool BenchmarkState::OnWeaponFired(const WeaponFiredEvent& event)
 	createProjectileDesc.InitalVelocity = event.InitialVelocity;
 	createProjectileDesc.TeamIndex		= event.TeamIndex;
 	createProjectileDesc.Callback		= event.Callback;
+	createProjectileDesc.WeaponOwner	= event.WeaponOwnerEntity;
 
 	TArray<Entity> createdFlagEntities;
 	if (!m_pLevel->CreateObject(ELevelObjectType::LEVEL_OBJECT_TYPE_PROJECTILE, &createProjectileDesc, createdFlagEntities))
@@ -408,6 +441,116 @@ void BenchmarkState::PrintBenchmarkResults()
 	writer.String("AverageVRAM");
 	writer.Double(pGPUProfiler->GetAverageDeviceMemory() / MB);
 
+	writer.String("ParticleChurnMicroseconds");
+	writer.Double(BenchmarkParticleChurn());
+
+	const OffsetAllocatorBenchmarkResult offsetAllocatorResult = BenchmarkOffsetAllocatorFragmentation();
+	writer.String("OffsetAllocatorAverageFragmentation");
+	writer.Double(offsetAllocatorResult.AverageFragmentation);
+	writer.String("OffsetAllocatorFailedAllocations");
+	writer.Double(offsetAllocatorResult.FailedAllocations);
+	writer.String("OffsetAllocatorOperationNanoseconds");
+	writer.Double(offsetAllocatorResult.OperationNanoseconds);
+
+	writer.String("PhysicsStepMicroseconds");
+	writer.Double(BenchmarkPhysicsStep());
+
+	writer.String("PhysicsTickAwakeMicroseconds");
+	writer.Double(BenchmarkPhysicsTick(false));
+
+	writer.String("PhysicsTickSleepingMicroseconds");
+	writer.Double(BenchmarkPhysicsTick(true));
+
+	writer.String("SceneQueriesSingleMicroseconds");
+	writer.Double(BenchmarkSceneQueries(false));
+
+	writer.String("SceneQueriesBatchedMicroseconds");
+	writer.Double(BenchmarkSceneQueries(true));
+
+	writer.String("ProjectilesPerMillisecond");
+	writer.Double(BenchmarkProjectiles());
+
+	writer.String("PacketCopyAllocationsPerTick");
+	writer.Double(BenchmarkPacketInbox(false));
+
+	writer.String("PacketViewAllocationsPerTick");
+	writer.Double(BenchmarkPacketInbox(true));
+
+	writer.String("MeshPaintUnbatchedMicroseconds");
+	writer.Double(BenchmarkMeshPaint(false));
+
+	writer.String("MeshPaintBatchedMicroseconds");
+	writer.Double(BenchmarkMeshPaint(true));
+
+	writer.String("FrameTemporariesHeapAllocationsPerFrame");
+	writer.Double(BenchmarkFrameAllocator(false));
+
+	writer.String("FrameTemporariesFrameAllocatorHeapAllocationsPerFrame");
+	writer.Double(BenchmarkFrameAllocator(true));
+
+	const EventQueueBenchmarkResult lockedEventQueueResult = BenchmarkEventQueue(false);
+	writer.String("EventQueueLockedEventsPerSecond");
+	writer.Double(lockedEventQueueResult.EventsPerSecond);
+	writer.String("EventQueueLockedPushP99Nanoseconds");
+	writer.Double(lockedEventQueueResult.PushP99Nanoseconds);
+	writer.String("EventQueueLockedPushP999Nanoseconds");
+	writer.Double(lockedEventQueueResult.PushP999Nanoseconds);
+	writer.String("EventQueueLockedPushMaxNanoseconds");
+	writer.Double(lockedEventQueueResult.PushMaxNanoseconds);
+
+	const EventQueueBenchmarkResult lockFreeEventQueueResult = BenchmarkEventQueue(true);
+	writer.String("EventQueueLockFreeEventsPerSecond");
+	writer.Double(lockFreeEventQueueResult.EventsPerSecond);
+	writer.String("EventQueueLockFreePushP99Nanoseconds");
+	writer.Double(lockFreeEventQueueResult.PushP99Nanoseconds);
+	writer.String("EventQueueLockFreePushP999Nanoseconds");
+	writer.Double(lockFreeEventQueueResult.PushP999Nanoseconds);
+	writer.String("EventQueueLockFreePushMaxNanoseconds");
+	writer.Double(lockFreeEventQueueResult.PushMaxNanoseconds);
+
+	const LoggingBenchmarkResult synchronousLoggingResult = BenchmarkLogging(false);
+	writer.String("LogSynchronousCallP50Nanoseconds");
+	writer.Double(synchronousLoggingResult.CallP50Nanoseconds);
+	writer.String("LogSynchronousCallP99Nanoseconds");
+	writer.Double(synchronousLoggingResult.CallP99Nanoseconds);
+	writer.String("LogSynchronousCallMaxNanoseconds");
+	writer.Double(synchronousLoggingResult.CallMaxNanoseconds);
+
+	const LoggingBenchmarkResult asyncLoggingResult = BenchmarkLogging(true);
+	writer.String("LogAsyncCallP50Nanoseconds");
+	writer.Double(asyncLoggingResult.CallP50Nanoseconds);
+	writer.String("LogAsyncCallP99Nanoseconds");
+	writer.Double(asyncLoggingResult.CallP99Nanoseconds);
+	writer.String("LogAsyncCallMaxNanoseconds");
+	writer.Double(asyncLoggingResult.CallMaxNanoseconds);
+	writer.String("LogAsyncDroppedMessages");
+	writer.Double(asyncLoggingResult.DroppedMessages);
+
+	/*
+	* Error counts of the CPU tests, the benchmark workflow fails if any of them is not zero
+	*/
+	auto writeValidation = [&writer](const char* pName, float64 errorCount)
+	{
+		if (errorCount != 0.0)
+		{
+			LOG_ERROR("Benchmark validation %s failed with %.0f errors", pName, errorCount);
+		}
+
+		writer.String(pName);
+		writer.Double(errorCount);
+	};
+
+	writer.String("Validation");
+	writer.StartObject();
+	writeValidation("OffsetAllocatorFuzzErrors", FuzzOffsetAllocator());
+	writeValidation("RingAllocatorFuzzErrors", FuzzRingAllocator());
+	writeValidation("MeshPaintBatchedMismatchedVertices", ValidateMeshPaintBatching());
+	writeValidation("LineBatchMismatchedFrames", ValidateLineBatch());
+	writeValidation("TLASUpdateTrackerMismatchedFrames", ValidateTLASUpdateTracker());
+	writeValidation("RenderGraphAliasingMismatchedGraphs", ValidateRenderGraphAliasing());
+	writeValidation("ParticleCPUGPUMismatchedParticles", ValidateParticleSimulation());
+	writer.EndObject();
+
 	writer.EndObject();
 
 	FILE* pFile = fopen("benchmark_results.json", "w");
@@ -417,3 +560,1973 @@ void BenchmarkState::PrintBenchmarkResults()
 		fclose(pFile);
 	}
 }
+
+float64 BenchmarkState::BenchmarkParticleChurn()
+{
+	using namespace LambdaEngine;
+
+	/*
+	* Replays the emitter churn of a match against the particle chunk allocator and the alive list, without the GPU.
+	* Every hit starts a paint splash, deaths and grenades start larger bursts. Returns microseconds per frame.
+	*/
+	constexpr const uint32 MAX_PARTICLE_COUNT	= 30000;
+	constexpr const uint32 FRAME_COUNT			= 60 * 60 * 5;
+	constexpr const float32 FRAME_TIME			= 1.0f / 60.0f;
+
+	struct ChurnEmitter
+	{
+		OffsetAllocation	Allocation;
+		float32				TimeLeft;
+	};
+
+	struct ChurnEmitterType
+	{
+		uint32	ParticleCount;
+		float32	LifeTime;
+		float32	SpawnsPerSecond;
+	};
+
+	const ChurnEmitterType emitterTypes[] =
+	{
+		{ .ParticleCount = 64,		.LifeTime = 3.0f, .SpawnsPerSecond = 40.0f },	// Paint splashes
+		{ .ParticleCount = 512,		.LifeTime = 1.2f, .SpawnsPerSecond = 0.5f },	// Player deaths
+		{ .ParticleCount = 2048,	.LifeTime = 1.2f, .SpawnsPerSecond = 0.1f },	// Grenades
+	};
+
+	OffsetAllocator chunkAllocator;
+	chunkAllocator.Init(MAX_PARTICLE_COUNT);
+
+	ParticleAliveList aliveParticles;
+	aliveParticles.Init(MAX_PARTICLE_COUNT);
+
+	TArray<ChurnEmitter> emitters;
+	std::mt19937 generator(1337);
+
+	const auto startTime = std::chrono::high_resolution_clock::now();
+
+	for (uint32 frame = 0; frame < FRAME_COUNT; frame++)
+	{
+		for (uint32 e = 0; e < emitters.GetSize();)
+		{
+			ChurnEmitter& emitter = emitters[e];
+			emitter.TimeLeft -= FRAME_TIME;
+			if (emitter.TimeLeft <= 0.0f)
+			{
+				aliveParticles.RemoveRange(uint32(emitter.Allocation.Offset), uint32(emitter.Allocation.SizeInBytes));
+				chunkAllocator.Free(emitter.Allocation);
+
+				emitter = emitters.GetBack();
+				emitters.PopBack();
+				continue;
+			}
+
+			e++;
+		}
+
+		for (const ChurnEmitterType& emitterType : emitterTypes)
+		{
+			// Several emitters of the same type may start during the same frame
+			std::poisson_distribution<uint32> spawnDistribution(emitterType.SpawnsPerSecond * FRAME_TIME);
+			const uint32 spawnCount = spawnDistribution(generator);
+			for (uint32 s = 0; s < spawnCount; s++)
+			{
+				ChurnEmitter emitter = {};
+				emitter.TimeLeft = emitterType.LifeTime;
+				if (chunkAllocator.Allocate(emitterType.ParticleCount, 1, emitter.Allocation))
+				{
+					aliveParticles.AddRange(uint32(emitter.Allocation.Offset), emitterType.ParticleCount);
+					emitters.PushBack(emitter);
+				}
+			}
+		}
+
+		// The dirty range is consumed once per frame when the alive buffer is uploaded
+		aliveParticles.ClearDirtyRange();
+	}
+
+	const auto endTime = std::chrono::high_resolution_clock::now();
+	return std::chrono::duration<float64, std::micro>(endTime - startTime).count() / float64(FRAME_COUNT);
+}
+
+// The allocations live in the fuzz model, sorted by offset when they are checked
+struct OffsetAllocatorFuzzAllocation
+{
+	LambdaEngine::OffsetAllocation	Allocation;
+	uint64							Alignment;
+	uint32							GranularityClass;
+};
+
+/*
+* Counts the ways the allocator state disagrees with the model: overlapping or misaligned allocations, allocations that
+* share a granularity page with a different class, wrong free bytes, a failed Validate or, when only one class is in
+* use, an alignment-free allocation that failed even though a gap in the model fits it
+*/
+static uint32 CheckOffsetAllocatorFuzzModel(
+	const LambdaEngine::OffsetAllocator& allocator,
+	LambdaEngine::TArray<OffsetAllocatorFuzzAllocation>& liveAllocations,
+	uint64 granularity,
+	uint64 failedSize)
+{
+	using namespace LambdaEngine;
+
+	std::sort(liveAllocations.Begin(), liveAllocations.End(), [](const OffsetAllocatorFuzzAllocation& lhs, const OffsetAllocatorFuzzAllocation& rhs)
+		{
+			return lhs.Allocation.Offset < rhs.Allocation.Offset;
+		});
+
+	uint32 errorCount		= allocator.Validate() ? 0 : 1;
+	uint64 usedBytes		= 0;
+	uint64 largestGap		= 0;
+	uint64 previousEnd		= 0;
+	for (uint32 a = 0; a < liveAllocations.GetSize(); a++)
+	{
+		const OffsetAllocatorFuzzAllocation& liveAllocation = liveAllocations[a];
+		const OffsetAllocation& allocation = liveAllocation.Allocation;
+		if (allocation.Offset < previousEnd || allocation.Offset + allocation.SizeInBytes > allocator.GetSizeInBytes() || allocation.Offset % liveAllocation.Alignment != 0)
+		{
+			errorCount++;
+		}
+
+		if (a > 0)
+		{
+			const OffsetAllocatorFuzzAllocation& previousAllocation = liveAllocations[a - 1];
+			if (previousAllocation.GranularityClass != liveAllocation.GranularityClass && AlignDown(previousEnd - 1, granularity) == AlignDown(allocation.Offset, granularity))
+			{
+				errorCount++;
+			}
+		}
+
+		largestGap	= glm::max(largestGap, allocation.Offset > previousEnd ? allocation.Offset - previousEnd : 0);
+		usedBytes	+= allocation.SizeInBytes;
+		previousEnd	= allocation.Offset + allocation.SizeInBytes;
+	}
+
+	largestGap = glm::max(largestGap, allocator.GetSizeInBytes() > previousEnd ? allocator.GetSizeInBytes() - previousEnd : 0);
+
+	if (allocator.GetFreeBytes() != allocator.GetSizeInBytes() - usedBytes)
+	{
+		errorCount++;
+	}
+
+	if (failedSize > 0 && failedSize <= largestGap)
+	{
+		errorCount++;
+	}
+
+	return errorCount;
+}
+
+float64 BenchmarkState::FuzzOffsetAllocator()
+{
+	using namespace LambdaEngine;
+
+	/*
+	* Random allocations and frees checked against a model after every operation. The first pass uses a single
+	* granularity class and no alignment, so every failed allocation must be one that no gap can hold. The second pass
+	* mixes alignments and two granularity classes like DeviceAllocatorVK does with buffers and images.
+	*/
+	constexpr const uint64 ALLOCATOR_SIZE		= 256 * 1024;
+	constexpr const uint64 GRANULARITY			= 1024;
+	constexpr const uint32 OPERATION_COUNT		= 20000;
+
+	uint32 errorCount = 0;
+
+	// Allocations that fit but not together with the worst case padding must succeed
+	{
+		OffsetAllocator allocator;
+		allocator.Init(256);
+
+		OffsetAllocation allocation;
+		if (!allocator.Allocate(256, 64, allocation) || allocation.Offset != 0)
+		{
+			errorCount++;
+		}
+	}
+
+	std::mt19937 generator(1337);
+	for (uint32 pass = 0; pass < 2; pass++)
+	{
+		const bool mixedClasses = pass == 1;
+
+		OffsetAllocator allocator;
+		allocator.Init(ALLOCATOR_SIZE, mixedClasses ? GRANULARITY : 1);
+
+		TArray<OffsetAllocatorFuzzAllocation> liveAllocations;
+		for (uint32 operation = 0; operation < OPERATION_COUNT; operation++)
+		{
+			uint64 failedSize = 0;
+
+			// Lean towards allocating while the allocator is empty and towards freeing while it is full
+			const float32 usedFraction = 1.0f - float32(allocator.GetFreeBytes()) / float32(ALLOCATOR_SIZE);
+			if (liveAllocations.IsEmpty() || std::uniform_real_distribution<float32>(0.0f, 1.0f)(generator) > usedFraction)
+			{
+				// Mostly small allocations with the occasional large one
+				const uint32 sizeShift = std::uniform_int_distribution<uint32>(0, 14)(generator);
+				OffsetAllocatorFuzzAllocation liveAllocation = {};
+				liveAllocation.Alignment		= mixedClasses ? (1ull << std::uniform_int_distribution<uint32>(0, 8)(generator)) : 1;
+				liveAllocation.GranularityClass	= mixedClasses ? std::uniform_int_distribution<uint32>(0, 1)(generator) : 0;
+
+				const uint64 sizeInBytes = std::uniform_int_distribution<uint64>(1ull << sizeShift, 2ull << sizeShift)(generator);
+				if (allocator.Allocate(sizeInBytes, liveAllocation.Alignment, liveAllocation.Allocation, liveAllocation.GranularityClass))
+				{
+					if (liveAllocation.Allocation.SizeInBytes != sizeInBytes)
+					{
+						errorCount++;
+					}
+
+					liveAllocations.PushBack(liveAllocation);
+				}
+				else if (!mixedClasses)
+				{
+					failedSize = sizeInBytes;
+				}
+			}
+			else
+			{
+				const uint32 index = std::uniform_int_distribution<uint32>(0, liveAllocations.GetSize() - 1)(generator);
+				allocator.Free(liveAllocations[index].Allocation);
+				liveAllocations[index] = liveAllocations.GetBack();
+				liveAllocations.PopBack();
+			}
+
+			errorCount += CheckOffsetAllocatorFuzzModel(allocator, liveAllocations, mixedClasses ? GRANULARITY : 1, failedSize);
+		}
+
+		// Everything merges back into one block
+		for (OffsetAllocatorFuzzAllocation& liveAllocation : liveAllocations)
+		{
+			allocator.Free(liveAllocation.Allocation);
+		}
+
+		OffsetAllocation allocation;
+		if (!allocator.IsEmpty() || allocator.GetStatistics().FreeBlockCount != 1 || !allocator.Allocate(ALLOCATOR_SIZE, 1, allocation))
+		{
+			errorCount++;
+		}
+	}
+
+	return float64(errorCount);
+}
+
+// An allocation of the ring fuzz model, alive until the fence value of its frame has completed
+struct RingAllocatorFuzzAllocation
+{
+	uint64 Offset;
+	uint64 SizeInBytes;
+	uint64 FenceValue;
+};
+
+float64 BenchmarkState::FuzzRingAllocator()
+{
+	using namespace LambdaEngine;
+
+	/*
+	* Frames of random allocations like the ones StagingBufferCache makes, with the GPU completing frames a random number
+	* of frames later. Every allocation is checked against the allocations of the frames that are still in flight, so an
+	* allocation that wraps into memory the GPU may still read is an error. The ring is small compared to the allocations
+	* to make it wrap often, a run that never wraps or never fills up is an error as well.
+	*/
+	constexpr const uint64 RING_SIZE			= 256 * 1024;
+	constexpr const uint32 FRAME_COUNT			= 4000;
+	constexpr const uint32 MAX_FRAMES_IN_FLIGHT	= 3;
+
+	uint32 errorCount = 0;
+
+	// A full ring fails until the frame that holds the memory has completed
+	{
+		RingAllocator ring;
+		ring.Init(256);
+
+		uint64 offset = 0;
+		if (!ring.Allocate(192, 1, offset) || offset != 0)
+		{
+			errorCount++;
+		}
+
+		ring.EndFrame(1);
+		if (ring.Allocate(128, 1, offset))
+		{
+			errorCount++;
+		}
+
+		ring.Reclaim(1);
+		if (!ring.Allocate(128, 1, offset) || ring.GetInFlightFrameCount() != 0)
+		{
+			errorCount++;
+		}
+	}
+
+	RingAllocator ring;
+	ring.Init(RING_SIZE);
+
+	std::mt19937 generator(1337);
+	TArray<RingAllocatorFuzzAllocation> liveAllocations;
+	uint64 completedFenceValue	= 0;
+	uint64 previousEnd			= 0;
+	uint32 wrapCount			= 0;
+	uint32 failedCount			= 0;
+	for (uint32 frame = 1; frame <= FRAME_COUNT; frame++)
+	{
+		const uint64 fenceValue = uint64(frame);
+
+		const uint32 allocationCount = std::uniform_int_distribution<uint32>(0, 24)(generator);
+		for (uint32 a = 0; a < allocationCount; a++)
+		{
+			const uint32 sizeShift		= std::uniform_int_distribution<uint32>(4, 15)(generator);
+			const uint64 sizeInBytes	= std::uniform_int_distribution<uint64>(1ull << sizeShift, 2ull << sizeShift)(generator);
+			const uint64 alignment		= 1ull << std::uniform_int_distribution<uint32>(0, 8)(generator);
+
+			uint64 offset = 0;
+			if (!ring.Allocate(sizeInBytes, alignment, offset))
+			{
+				failedCount++;
+				continue;
+			}
+
+			if (offset % alignment != 0 || offset + sizeInBytes > RING_SIZE)
+			{
+				errorCount++;
+			}
+
+			for (const RingAllocatorFuzzAllocation& liveAllocation : liveAllocations)
+			{
+				if (offset < liveAllocation.Offset + liveAllocation.SizeInBytes && liveAllocation.Offset < offset + sizeInBytes)
+				{
+					errorCount++;
+				}
+			}
+
+			if (offset < previousEnd)
+			{
+				wrapCount++;
+			}
+
+			previousEnd = offset + sizeInBytes;
+			liveAllocations.PushBack({ offset, sizeInBytes, fenceValue });
+		}
+
+		ring.EndFrame(fenceValue);
+
+		// The GPU lags up to MAX_FRAMES_IN_FLIGHT frames behind and sometimes catches up several frames at once
+		const uint64 oldestFenceValue = fenceValue > MAX_FRAMES_IN_FLIGHT ? fenceValue - MAX_FRAMES_IN_FLIGHT : 0;
+		completedFenceValue = glm::max(completedFenceValue, glm::max(oldestFenceValue, std::uniform_int_distribution<uint64>(completedFenceValue, fenceValue)(generator)));
+		ring.Reclaim(completedFenceValue);
+
+		uint64 liveBytes = 0;
+		for (uint32 a = 0; a < liveAllocations.GetSize();)
+		{
+			if (liveAllocations[a].FenceValue <= completedFenceValue)
+			{
+				liveAllocations[a] = liveAllocations.GetBack();
+				liveAllocations.PopBack();
+			}
+			else
+			{
+				liveBytes += liveAllocations[a].SizeInBytes;
+				a++;
+			}
+		}
+
+		if (ring.GetUsedBytes() < liveBytes || ring.GetUsedBytes() > RING_SIZE || ring.GetInFlightFrameCount() > MAX_FRAMES_IN_FLIGHT)
+		{
+			errorCount++;
+		}
+	}
+
+	ring.Reclaim(FRAME_COUNT);
+	if (ring.GetUsedBytes() != 0 || ring.GetInFlightFrameCount() != 0 || wrapCount == 0 || failedCount == 0)
+	{
+		errorCount++;
+	}
+
+	return float64(errorCount);
+}
+
+BenchmarkState::OffsetAllocatorBenchmarkResult BenchmarkState::BenchmarkOffsetAllocatorFragmentation()
+{
+	using namespace LambdaEngine;
+
+	/*
+	* Uploads like the ones that overflow StagingBufferCache: sizes from 64 KB to 8 MB that live for one to three frames,
+	* placed in an allocator of the same size as the overflow buffer. Fragmentation is sampled at the end of every frame.
+	*/
+	constexpr const uint64 ALLOCATOR_SIZE			= MEGA_BYTE(64);
+	constexpr const uint32 FRAME_COUNT				= 5000;
+	constexpr const uint32 MAX_UPLOADS_PER_FRAME	= 8;
+	constexpr const uint32 MAX_FRAMES_IN_FLIGHT		= 3;
+
+	struct FragmentationUpload
+	{
+		OffsetAllocation	Allocation;
+		uint32				FramesLeft;
+	};
+
+	OffsetAllocator allocator;
+	allocator.Init(ALLOCATOR_SIZE);
+
+	TArray<FragmentationUpload> uploads;
+	std::mt19937 generator(1337);
+
+	uint64 operationCount			= 0;
+	uint64 failedAllocationCount	= 0;
+	float64 fragmentationSum		= 0.0;
+	float64 operationNanoseconds	= 0.0;
+	for (uint32 frame = 0; frame < FRAME_COUNT; frame++)
+	{
+		TArray<uint64> sizes;
+		const uint32 uploadCount = std::uniform_int_distribution<uint32>(0, MAX_UPLOADS_PER_FRAME)(generator);
+		for (uint32 u = 0; u < uploadCount; u++)
+		{
+			const uint32 sizeShift = std::uniform_int_distribution<uint32>(16, 22)(generator);
+			sizes.PushBack(std::uniform_int_distribution<uint64>(1ull << sizeShift, 2ull << sizeShift)(generator));
+		}
+
+		const auto startTime = std::chrono::high_resolution_clock::now();
+
+		for (uint32 u = 0; u < uploads.GetSize();)
+		{
+			if (--uploads[u].FramesLeft == 0)
+			{
+				allocator.Free(uploads[u].Allocation);
+				uploads[u] = uploads.GetBack();
+				uploads.PopBack();
+				operationCount++;
+				continue;
+			}
+
+			u++;
+		}
+
+		for (uint64 sizeInBytes : sizes)
+		{
+			FragmentationUpload upload = {};
+			upload.FramesLeft = 1 + (uint32(sizeInBytes) % MAX_FRAMES_IN_FLIGHT);
+			if (allocator.Allocate(sizeInBytes, StagingBufferCache::DEFAULT_ALIGNMENT, upload.Allocation))
+			{
+				uploads.PushBack(upload);
+			}
+			else
+			{
+				failedAllocationCount++;
+			}
+
+			operationCount++;
+		}
+
+		operationNanoseconds += std::chrono::duration<float64, std::nano>(std::chrono::high_resolution_clock::now() - startTime).count();
+		fragmentationSum += allocator.GetStatistics().Fragmentation;
+	}
+
+	OffsetAllocatorBenchmarkResult result = {};
+	result.AverageFragmentation		= fragmentationSum / float64(FRAME_COUNT);
+	result.FailedAllocations		= float64(failedAllocationCount);
+	result.OperationNanoseconds		= operationNanoseconds / float64(glm::max(operationCount, uint64(1)));
+	return result;
+}
+
+/*
+* Creates a grid of spheres far away from the level with random velocities. The bodies belong to no entity, so they are
+* simulated but never written back to components.
+*/
+static LambdaEngine::TArray<LambdaEngine::DynamicCollisionComponent> CreatePhysicsBenchmarkBodies(uint32 bodyCountPerAxis, float32 bodySpacing)
+{
+	using namespace LambdaEngine;
+
+	constexpr const float32 BODY_RADIUS	= 0.5f;
+	const glm::vec3 benchmarkOrigin		= glm::vec3(0.0f, 10000.0f, 0.0f);
+
+	PhysicsSystem* pPhysicsSystem = PhysicsSystem::GetInstance();
+
+	std::mt19937 generator(1337);
+	std::uniform_real_distribution<float32> velocityDistribution(-5.0f, 5.0f);
+
+	TArray<DynamicCollisionComponent> bodies;
+	bodies.Reserve(bodyCountPerAxis * bodyCountPerAxis * bodyCountPerAxis);
+
+	for (uint32 x = 0; x < bodyCountPerAxis; x++)
+	{
+		for (uint32 y = 0; y < bodyCountPerAxis; y++)
+		{
+			for (uint32 z = 0; z < bodyCountPerAxis; z++)
+			{
+				const PositionComponent positionComponent = { .Position = benchmarkOrigin + glm::vec3(float32(x), float32(y), float32(z)) * bodySpacing };
+				const ScaleComponent scaleComponent = { .Scale = glm::vec3(1.0f) };
+				const RotationComponent rotationComponent = { .Quaternion = glm::identity<glm::quat>() };
+				const VelocityComponent velocityComponent = { .Velocity = glm::vec3(velocityDistribution(generator), velocityDistribution(generator), velocityDistribution(generator)) };
+
+				// Unique IDs, the filter shader ignores pairs with the same ID
+				const uint32 bodyIndex = bodies.GetSize();
+				const DynamicCollisionCreateInfo collisionInfo =
+				{
+					/* Entity */	 		UINT32_MAX,
+					/* Detection Method */	ECollisionDetection::DISCRETE,
+					/* Position */	 		positionComponent,
+					/* Scale */				scaleComponent,
+					/* Rotation */			rotationComponent,
+					{
+						{
+							.ShapeType =		EShapeType::SIMULATION,
+							.GeometryType =		EGeometryType::SPHERE,
+							.GeometryParams =	{ .Radius = BODY_RADIUS },
+							.CollisionGroup =	(uint32)FCollisionGroup::COLLISION_GROUP_DYNAMIC,
+							.CollisionMask =	(uint32)FCollisionGroup::COLLISION_GROUP_STATIC |
+												(uint32)FCollisionGroup::COLLISION_GROUP_DYNAMIC,
+							.EntityID =			bodyIndex,
+						},
+					},
+					/* Velocity */			velocityComponent
+				};
+
+				DynamicCollisionComponent body = pPhysicsSystem->CreateDynamicActor(collisionInfo);
+				pPhysicsSystem->GetScene()->addActor(*body.pActor);
+				bodies.PushBack(body);
+			}
+		}
+	}
+
+	return bodies;
+}
+
+// Returns microseconds per physics tick
+static float64 TickPhysicsBenchmark(uint32 tickCount)
+{
+	using namespace LambdaEngine;
+
+	PhysicsSystem* pPhysicsSystem = PhysicsSystem::GetInstance();
+	const Timestamp tickTime = Timestamp::Seconds(1.0 / 60.0);
+
+	const auto startTime = std::chrono::high_resolution_clock::now();
+
+	for (uint32 tick = 0; tick < tickCount; tick++)
+	{
+		pPhysicsSystem->Tick(tickTime);
+	}
+
+	const auto endTime = std::chrono::high_resolution_clock::now();
+	return std::chrono::duration<float64, std::micro>(endTime - startTime).count() / float64(tickCount);
+}
+
+float64 BenchmarkState::BenchmarkPhysicsStep()
+{
+	using namespace LambdaEngine;
+
+	/*
+	* Steps the PhysX scene with a pile of colliding spheres, so the measured time is dominated by the simulation tasks
+	* run by the CPU dispatcher. Returns microseconds per step.
+	*/
+	constexpr const uint32 BODY_COUNT_PER_AXIS	= 16;
+	constexpr const uint32 STEP_COUNT			= 300;
+	constexpr const float32 BODY_SPACING		= 1.5f;
+
+	TArray<DynamicCollisionComponent> bodies = CreatePhysicsBenchmarkBodies(BODY_COUNT_PER_AXIS, BODY_SPACING);
+	const float64 stepMicroseconds = TickPhysicsBenchmark(STEP_COUNT);
+
+	for (DynamicCollisionComponent& body : bodies)
+	{
+		PhysicsSystem::GetInstance()->ReleaseDynamicActor(body);
+	}
+
+	return stepMicroseconds;
+}
+
+float64 BenchmarkState::BenchmarkPhysicsTick(bool sleeping)
+{
+	using namespace LambdaEngine;
+
+	/*
+	* Ticks the physics system with 1000 spheres that are either falling or asleep. Bodies are spaced so they do not
+	* collide, which leaves the cost of moving actors compared to the cost of resting ones. Returns microseconds per tick.
+	*/
+	constexpr const uint32 BODY_COUNT_PER_AXIS	= 10;
+	constexpr const uint32 TICK_COUNT			= 300;
+	constexpr const float32 BODY_SPACING		= 4.0f;
+
+	TArray<DynamicCollisionComponent> bodies = CreatePhysicsBenchmarkBodies(BODY_COUNT_PER_AXIS, BODY_SPACING);
+	if (sleeping)
+	{
+		for (DynamicCollisionComponent& body : bodies)
+		{
+			body.pActor->putToSleep();
+		}
+	}
+
+	const float64 tickMicroseconds = TickPhysicsBenchmark(TICK_COUNT);
+
+	for (DynamicCollisionComponent& body : bodies)
+	{
+		PhysicsSystem::GetInstance()->ReleaseDynamicActor(body);
+	}
+
+	return tickMicroseconds;
+}
+
+// Union of the world bounds of the level's static actors
+static physx::PxBounds3 GetStaticLevelBounds()
+{
+	using namespace LambdaEngine;
+
+	PxScene* pScene = PhysicsSystem::GetInstance()->GetScene();
+
+	const PxActorTypeFlags staticActorType = PxActorTypeFlag::eRIGID_STATIC;
+	TArray<PxActor*> staticActors(pScene->getNbActors(staticActorType));
+	pScene->getActors(staticActorType, staticActors.GetData(), staticActors.GetSize());
+
+	PxBounds3 levelBounds = PxBounds3::empty();
+	for (PxActor* pActor : staticActors)
+	{
+		levelBounds.include(pActor->getWorldBounds());
+	}
+
+	return levelBounds;
+}
+
+float64 BenchmarkState::BenchmarkSceneQueries(bool batched)
+{
+	using namespace LambdaEngine;
+
+	/*
+	* Issues the same raycasts and overlaps against the loaded level either one at a time, the way gameplay systems
+	* used to, or as one SceneQueryBatch. Queries start at random points within the bounds of the level's static actors.
+	* Returns microseconds for all queries.
+	*/
+	constexpr const uint32 QUERY_COUNT			= 4096;
+	constexpr const uint32 OVERLAP_FREQUENCY	= 4;	// Every fourth query is an overlap
+	constexpr const float32 RAY_LENGTH			= 50.0f;
+	constexpr const float32 OVERLAP_RADIUS		= 2.0f;
+
+	PhysicsSystem* pPhysicsSystem = PhysicsSystem::GetInstance();
+
+	const PxBounds3 levelBounds = GetStaticLevelBounds();
+	if (levelBounds.isEmpty())
+	{
+		return 0.0;
+	}
+
+	const QueryFilterData queryFilterData =
+	{
+		.IncludedGroup = FCollisionGroup::COLLISION_GROUP_STATIC | FCollisionGroup::COLLISION_GROUP_DYNAMIC,
+	};
+
+	// Generate the queries up front so both ways run the same ones
+	std::mt19937 generator(1337);
+	std::uniform_real_distribution<float32> xDistribution(levelBounds.minimum.x, levelBounds.maximum.x);
+	std::uniform_real_distribution<float32> yDistribution(levelBounds.minimum.y, levelBounds.maximum.y);
+	std::uniform_real_distribution<float32> zDistribution(levelBounds.minimum.z, levelBounds.maximum.z);
+	std::uniform_real_distribution<float32> directionDistribution(-1.0f, 1.0f);
+
+	TArray<RaycastInfo> raycasts;
+	TArray<OverlapQueryInfo> overlaps;
+
+	for (uint32 q = 0; q < QUERY_COUNT; q++)
+	{
+		const glm::vec3 position = glm::vec3(xDistribution(generator), yDistribution(generator), zDistribution(generator));
+		if (q % OVERLAP_FREQUENCY == 0)
+		{
+			overlaps.PushBack(
+				{
+					.GeometryType = EGeometryType::SPHERE,
+					.GeometryParams = { .Radius = OVERLAP_RADIUS },
+					.Position = position,
+					.Rotation = glm::identity<glm::quat>()
+				});
+		}
+		else
+		{
+			const glm::vec3 direction = glm::vec3(directionDistribution(generator), directionDistribution(generator), directionDistribution(generator));
+			raycasts.PushBack(
+				{
+					.Origin = position,
+					.Direction = glm::normalize(direction),
+					.MaxDistance = RAY_LENGTH,
+					.pFilterData = &queryFilterData
+				});
+		}
+	}
+
+	const auto startTime = std::chrono::high_resolution_clock::now();
+
+	if (batched)
+	{
+		SceneQueryBatch queryBatch;
+		for (const RaycastInfo& raycastInfo : raycasts)
+		{
+			queryBatch.AddRaycast(raycastInfo);
+		}
+
+		for (const OverlapQueryInfo& overlapInfo : overlaps)
+		{
+			queryBatch.AddOverlap(overlapInfo, &queryFilterData);
+		}
+
+		pPhysicsSystem->ExecuteQueryBatch(queryBatch);
+	}
+	else
+	{
+		for (const RaycastInfo& raycastInfo : raycasts)
+		{
+			PxRaycastHit hit;
+			pPhysicsSystem->Raycast(raycastInfo, hit);
+		}
+
+		std::array<PxOverlapHit, SceneQueryBatch::DEFAULT_MAX_HIT_COUNT> overlapHits;
+		for (const OverlapQueryInfo& overlapInfo : overlaps)
+		{
+			PxOverlapBuffer overlapBuffer(overlapHits.data(), (PxU32)overlapHits.size());
+			pPhysicsSystem->QueryOverlap(overlapInfo, overlapBuffer, &queryFilterData);
+		}
+	}
+
+	const auto endTime = std::chrono::high_resolution_clock::now();
+	return std::chrono::duration<float64, std::micro>(endTime - startTime).count();
+}
+
+float64 BenchmarkState::BenchmarkProjectiles()
+{
+	using namespace LambdaEngine;
+
+	/*
+	* Fires paint balls from random points within the level in random directions and steps them with the projectile
+	* simulator until they hit something, without creating entities. Returns projectiles simulated per millisecond,
+	* where one projectile moved by one fixed tick counts as one.
+	*/
+	constexpr const uint32 PROJECTILE_COUNT		= 8192;
+	constexpr const uint32 STEP_COUNT			= 300;
+	constexpr const float32 STEP_TIME			= 1.0f / 60.0f;
+	constexpr const float32 PROJECTILE_SPEED	= 30.0f;
+
+	const PxBounds3 levelBounds = GetStaticLevelBounds();
+	if (levelBounds.isEmpty())
+	{
+		return 0.0;
+	}
+
+	std::mt19937 generator(1337);
+	std::uniform_real_distribution<float32> xDistribution(levelBounds.minimum.x, levelBounds.maximum.x);
+	std::uniform_real_distribution<float32> yDistribution(levelBounds.minimum.y, levelBounds.maximum.y);
+	std::uniform_real_distribution<float32> zDistribution(levelBounds.minimum.z, levelBounds.maximum.z);
+	std::uniform_real_distribution<float32> directionDistribution(-1.0f, 1.0f);
+
+	// Entities are only used as keys by the simulator, the owner matches no shape
+	ProjectileSimulator simulator;
+	for (uint32 p = 0; p < PROJECTILE_COUNT; p++)
+	{
+		const glm::vec3 position = glm::vec3(xDistribution(generator), yDistribution(generator), zDistribution(generator));
+		const glm::vec3 direction = glm::vec3(directionDistribution(generator), directionDistribution(generator), directionDistribution(generator));
+		simulator.AddProjectile(p, UINT32_MAX, position, glm::normalize(direction) * PROJECTILE_SPEED);
+	}
+
+	uint64 simulatedProjectileCount = 0;
+	const auto startTime = std::chrono::high_resolution_clock::now();
+
+	for (uint32 step = 0; step < STEP_COUNT && simulator.GetProjectileCount() > 0; step++)
+	{
+		simulatedProjectileCount += simulator.GetProjectileCount();
+		simulator.Step(STEP_TIME);
+	}
+
+	const auto endTime = std::chrono::high_resolution_clock::now();
+	const float64 milliseconds = std::chrono::duration<float64, std::milli>(endTime - startTime).count();
+	return milliseconds > 0.0 ? float64(simulatedProjectileCount) / milliseconds : 0.0;
+}
+
+float64 BenchmarkState::BenchmarkPacketInbox(bool useViews)
+{
+	using namespace LambdaEngine;
+
+	/*
+	* Replays how the server handles the actions of 32 players without the network. Every tick each player receives
+	* two actions, a response is queued for each of them and the responses are sent. The actions are either read from
+	* a copy of the packet component, the way ComponentArray::GetIf returns it, or through its inbox and outbox views.
+	* Returns heap allocations per tick once the packet storage has grown to its steady size. The components are filled
+	* and drained through PacketComponentAccess, which also reports if their storage still grows after the warmup.
+	*/
+	constexpr const uint32 PLAYER_COUNT			= 32;
+	constexpr const uint32 ACTIONS_PER_TICK		= 2;
+	constexpr const uint32 WARMUP_TICK_COUNT	= 10;
+	constexpr const uint32 TICK_COUNT			= 600;
+
+	TArray<PacketComponent<PacketPlayerAction>> actionComponents(PLAYER_COUNT);
+	TArray<PacketComponent<PacketPlayerActionResponse>> responseComponents(PLAYER_COUNT);
+	SegmentPool segmentPool(1);
+
+	auto getStorageCapacity = [&actionComponents, &responseComponents]()
+	{
+		uint64 capacity = 0;
+		for (uint32 p = 0; p < PLAYER_COUNT; p++)
+		{
+			const PacketStorageStats actionStats	= PacketComponentAccess::GetStorageStats(&actionComponents[p]);
+			const PacketStorageStats responseStats	= PacketComponentAccess::GetStorageStats(&responseComponents[p]);
+			capacity += actionStats.ReceivedCapacity + actionStats.ToSendCapacity + responseStats.ReceivedCapacity + responseStats.ToSendCapacity;
+		}
+
+		return capacity;
+	};
+
+	uint64 allocationCount = 0;
+	uint64 steadyStorageCapacity = 0;
+	for (uint32 tick = 0; tick < WARMUP_TICK_COUNT + TICK_COUNT; tick++)
+	{
+		if (tick == WARMUP_TICK_COUNT)
+		{
+			steadyStorageCapacity = getStorageCapacity();
+		}
+
+		const uint64 allocationCountBefore = Malloc::GetThreadAllocationCount();
+
+		// Receive, the way PacketTranscoderSystem fills the components
+		for (PacketComponent<PacketPlayerAction>& actionComponent : actionComponents)
+		{
+			PacketComponentAccess::ClearPacketsReceived(&actionComponent);
+
+			for (uint32 a = 0; a < ACTIONS_PER_TICK; a++)
+			{
+				PacketPlayerAction* pAction = reinterpret_cast<PacketPlayerAction*>(PacketComponentAccess::AddPacketReceivedBegin(&actionComponent));
+				pAction->SimulationTick	= int32(tick * ACTIONS_PER_TICK + a);
+				pAction->FiredAmmo		= EAmmoType::AMMO_TYPE_PAINT;
+				PacketComponentAccess::AddPacketReceivedEnd(&actionComponent);
+			}
+		}
+
+		// Respond, the way PlayerRemoteSystem and WeaponSystemServer do
+		for (uint32 p = 0; p < PLAYER_COUNT; p++)
+		{
+			if (useViews)
+			{
+				const PacketInbox<PacketPlayerAction> actions = actionComponents[p].GetInbox();
+				PacketOutbox<PacketPlayerActionResponse> responses = responseComponents[p].GetOutbox();
+				for (const PacketPlayerAction& action : actions)
+				{
+					PacketPlayerActionResponse& response = responses.Push({});
+					response.SimulationTick	= action.SimulationTick;
+					response.FiredAmmo		= action.FiredAmmo;
+				}
+			}
+			else
+			{
+				const PacketComponent<PacketPlayerAction> actionComponent = actionComponents[p];
+				for (const PacketPlayerAction& action : actionComponent.GetPacketsReceived())
+				{
+					PacketPlayerActionResponse response = {};
+					response.SimulationTick	= action.SimulationTick;
+					response.FiredAmmo		= action.FiredAmmo;
+					responseComponents[p].SendPacket(response);
+				}
+			}
+		}
+
+		// Send
+		for (uint32 p = 0; p < PLAYER_COUNT; p++)
+		{
+			IPacketComponent* pPacketComponent = &responseComponents[p];
+			while (PacketComponentAccess::GetPacketsToSendCount(pPacketComponent) > 0)
+			{
+				NetworkSegment* pSegment = segmentPool.RequestFreeSegment();
+				PacketComponentAccess::WriteSegment(pPacketComponent, pSegment, int32(p));
+#ifdef LAMBDA_CONFIG_DEBUG
+				segmentPool.FreeSegment(pSegment, "BenchmarkPacketInbox");
+#else
+				segmentPool.FreeSegment(pSegment);
+#endif
+			}
+		}
+
+		if (tick >= WARMUP_TICK_COUNT)
+		{
+			allocationCount += Malloc::GetThreadAllocationCount() - allocationCountBefore;
+		}
+	}
+
+	if (getStorageCapacity() != steadyStorageCapacity)
+	{
+		LOG_WARNING("[BenchmarkState]: Packet component storage grew after %u warmup ticks", WARMUP_TICK_COUNT);
+	}
+
+	return float64(allocationCount) / float64(TICK_COUNT);
+}
+
+// A flat level mesh and a burst of paint balls, most of them sprayed at a few spots and some washed off with water
+static void CreateMeshPaintBenchmarkData(LambdaEngine::TArray<PaintVertex>& vertices, LambdaEngine::TArray<std::pair<LambdaEngine::Entity, PaintHit>>& hits)
+{
+	using namespace LambdaEngine;
+
+	constexpr const uint32 GRID_SIZE		= 64;
+	constexpr const float32 GRID_SPACING	= 0.125f;
+	constexpr const uint32 CLUSTER_COUNT	= 8;
+	constexpr const uint32 HIT_COUNT		= 128;
+	constexpr const uint32 TARGET_COUNT		= 4;
+
+	vertices.Clear();
+	for (uint32 z = 0; z < GRID_SIZE; z++)
+	{
+		for (uint32 x = 0; x < GRID_SIZE; x++)
+		{
+			PaintVertex vertex = {};
+			vertex.Position	= glm::vec3(float32(x) - float32(GRID_SIZE) * 0.5f, 0.0f, float32(z) - float32(GRID_SIZE) * 0.5f) * GRID_SPACING;
+			vertex.Normal	= glm::vec3(0.0f, 1.0f, 0.0f);
+			vertices.PushBack(vertex);
+		}
+	}
+
+	std::mt19937 generator(1337);
+	std::uniform_real_distribution<float32> clusterDistribution(-3.5f, 3.5f);
+	std::uniform_real_distribution<float32> jitterDistribution(-0.02f, 0.02f);
+	std::uniform_real_distribution<float32> angleDistribution(0.0f, glm::two_pi<float32>());
+	std::uniform_int_distribution<uint32> clusterIndexDistribution(0, CLUSTER_COUNT - 1);
+
+	PaintHit clusters[CLUSTER_COUNT];
+	for (PaintHit& cluster : clusters)
+	{
+		cluster.Position	= glm::vec3(clusterDistribution(generator), 0.0f, clusterDistribution(generator));
+		cluster.Direction	= glm::normalize(glm::vec3(0.2f, -1.0f, 0.1f));
+		cluster.Angle		= angleDistribution(generator);
+		cluster.PaintMode	= EPaintMode::PAINT;
+		cluster.RemoteMode	= ERemoteMode::SERVER;
+		cluster.Team		= ETeam::TEAM_1;
+	}
+
+	hits.Clear();
+	for (uint32 h = 0; h < HIT_COUNT; h++)
+	{
+		const uint32 clusterIndex = clusterIndexDistribution(generator);
+
+		PaintHit hit = clusters[clusterIndex];
+		hit.Position	+= glm::vec3(jitterDistribution(generator), 0.0f, jitterDistribution(generator));
+		hit.Direction	= glm::normalize(hit.Direction + glm::vec3(jitterDistribution(generator), 0.0f, jitterDistribution(generator)));
+		hit.Angle		+= jitterDistribution(generator);
+		hit.PaintMode	= h % 8 == 7 ? EPaintMode::REMOVE : EPaintMode::PAINT;
+		hits.PushBack(std::make_pair(Entity(clusterIndex % TARGET_COUNT), hit));
+	}
+}
+
+// Paints the hits either one operation per hit or batched and merged, one operation per MeshPaintHandler buffer
+static void PaintMeshPaintBenchmarkHits(
+	LambdaEngine::TArray<PaintVertex>& vertices,
+	const LambdaEngine::TArray<std::pair<LambdaEngine::Entity, PaintHit>>& hits,
+	bool batched,
+	MeshPaintBatch& batch,
+	LambdaEngine::TArray<PaintHit>& flushedHits)
+{
+	if (batched)
+	{
+		for (const std::pair<LambdaEngine::Entity, PaintHit>& hit : hits)
+		{
+			batch.AddHit(hit.first, hit.second);
+		}
+
+		while (!batch.IsEmpty())
+		{
+			flushedHits.Clear();
+			batch.Flush(flushedHits, MeshPaintHandler::MAX_HIT_POINTS);
+			MeshPaintReference::ApplyHits(vertices, ETeam::NONE, flushedHits.GetData(), flushedHits.GetSize(), false);
+		}
+	}
+	else
+	{
+		for (const std::pair<LambdaEngine::Entity, PaintHit>& hit : hits)
+		{
+			MeshPaintReference::ApplyHits(vertices, ETeam::NONE, &hit.second, 1, false);
+		}
+	}
+}
+
+float64 BenchmarkState::BenchmarkMeshPaint(bool batched)
+{
+	using namespace LambdaEngine;
+
+	constexpr const uint32 FRAME_COUNT = 100;
+
+	TArray<PaintVertex> initialVertices;
+	TArray<std::pair<Entity, PaintHit>> hits;
+	CreateMeshPaintBenchmarkData(initialVertices, hits);
+
+	TArray<PaintVertex> vertices;
+	MeshPaintBatch batch;
+	TArray<PaintHit> flushedHits;
+
+	float64 totalMicroseconds = 0.0;
+	for (uint32 frame = 0; frame < FRAME_COUNT; frame++)
+	{
+		vertices = initialVertices;
+
+		const auto startTime = std::chrono::high_resolution_clock::now();
+		PaintMeshPaintBenchmarkHits(vertices, hits, batched, batch, flushedHits);
+		const auto endTime = std::chrono::high_resolution_clock::now();
+
+		totalMicroseconds += std::chrono::duration<float64, std::micro>(endTime - startTime).count();
+	}
+
+	return totalMicroseconds / float64(FRAME_COUNT);
+}
+
+float64 BenchmarkState::ValidateMeshPaintBatching()
+{
+	using namespace LambdaEngine;
+
+	TArray<PaintVertex> unbatchedVertices;
+	TArray<std::pair<Entity, PaintHit>> hits;
+	CreateMeshPaintBenchmarkData(unbatchedVertices, hits);
+
+	TArray<PaintVertex> batchedVertices = unbatchedVertices;
+	MeshPaintBatch batch;
+	TArray<PaintHit> flushedHits;
+	PaintMeshPaintBenchmarkHits(unbatchedVertices, hits, false, batch, flushedHits);
+	PaintMeshPaintBenchmarkHits(batchedVertices, hits, true, batch, flushedHits);
+
+	// Merged hits are a few centimeters apart, only vertices at the very edge of a splat may differ
+	uint32 mismatchedVertexCount = 0;
+	for (uint32 v = 0; v < unbatchedVertices.GetSize(); v++)
+	{
+		const PaintVertex& unbatchedVertex	= unbatchedVertices[v];
+		const PaintVertex& batchedVertex	= batchedVertices[v];
+		if (unbatchedVertex.PaintInfo != batchedVertex.PaintInfo || unbatchedVertex.PaintDistance != batchedVertex.PaintDistance)
+		{
+			mismatchedVertexCount++;
+		}
+	}
+
+	return float64(mismatchedVertexCount);
+}
+
+// The containers a frame builds its temporaries in, either from the heap or from the FrameAllocator
+struct HeapFrameTemporaries
+{
+	template<typename T>
+	using Array = LambdaEngine::TArray<T>;
+
+	template<typename Key, typename Type>
+	using HashTable = LambdaEngine::THashTable<Key, Type>;
+
+	using StringType = LambdaEngine::String;
+};
+
+struct FrameAllocatorFrameTemporaries
+{
+	template<typename T>
+	using Array = LambdaEngine::TFrameArray<T>;
+
+	template<typename Key, typename Type>
+	using HashTable = LambdaEngine::TFrameHashTable<Key, Type>;
+
+	using StringType = LambdaEngine::FrameString;
+};
+
+// A line group of the line batch model, the tag is written to the red channel of the group's color
+struct LineBatchValidationGroup
+{
+	uint32 ID;
+	uint32 VertexCount;
+	uint32 Tag;
+};
+
+struct LineBatchValidationLines
+{
+	uint32	VertexCount;
+	float64	ExpireTime;
+};
+
+float64 BenchmarkState::ValidateLineBatch()
+{
+	using namespace LambdaEngine;
+
+	/*
+	* Random group and timed line changes like the ones the LineRenderer gets. Every frame only the dirty range is copied
+	* to a mirror of the vertex buffer, which has to match the stream afterwards, and the visible vertices of every group
+	* and of the timed lines are counted against a model. Returns the number of frames that disagree.
+	*/
+	constexpr const uint32	FRAME_COUNT		= 2000;
+	constexpr const float64	FRAME_TIME		= 1.0 / 60.0;
+	constexpr const uint32	MAX_GROUP_COUNT	= 64;
+
+	const VertexData UNUPLOADED_VERTEX = { glm::vec4(-1.0f), glm::vec4(-1.0f) };
+
+	std::mt19937 generator(1337);
+	std::uniform_real_distribution<float32> positionDistribution(-10.0f, 10.0f);
+
+	LineBatch lineBatch;
+	TArray<VertexData> uploadedVertices;
+	TArray<LineBatchValidationGroup> groups;
+	TArray<LineBatchValidationLines> timedLines;
+	TArray<glm::vec3> points;
+	TArray<VertexData> lineVertices;
+	THashTable<uint32, uint32> visibleGroupVertexCounts;
+
+	uint32	errorCount	= 0;
+	uint32	nextTag		= 1;
+	float64	time		= 0.0;
+	for (uint32 frame = 0; frame < FRAME_COUNT; frame++)
+	{
+		time += FRAME_TIME;
+		lineBatch.Tick(time);
+
+		for (uint32 l = 0; l < timedLines.GetSize();)
+		{
+			if (timedLines[l].ExpireTime <= time)
+			{
+				timedLines[l] = timedLines.GetBack();
+				timedLines.PopBack();
+				continue;
+			}
+
+			l++;
+		}
+
+		const uint32 changeCount = std::uniform_int_distribution<uint32>(0, 8)(generator);
+		for (uint32 c = 0; c < changeCount; c++)
+		{
+			const uint32 change = std::uniform_int_distribution<uint32>(0, 3)(generator);
+			if ((change == 0 && groups.GetSize() < MAX_GROUP_COUNT) || (groups.IsEmpty() && change < 3))
+			{
+				points.Resize(2 * std::uniform_int_distribution<uint32>(1, 64)(generator));
+				for (glm::vec3& point : points)
+				{
+					point = glm::vec3(positionDistribution(generator), positionDistribution(generator), positionDistribution(generator));
+				}
+
+				LineBatchValidationGroup group = {};
+				group.Tag			= nextTag++;
+				group.VertexCount	= points.GetSize();
+				group.ID			= lineBatch.AddGroup(points.GetData(), points.GetSize(), glm::vec3(float32(group.Tag), 1.0f, 0.0f));
+				groups.PushBack(group);
+			}
+			else if (change == 1 || change == 0)
+			{
+				// Half of the updates keep the number of points and are rewritten in place
+				LineBatchValidationGroup& group = groups[std::uniform_int_distribution<uint32>(0, groups.GetSize() - 1)(generator)];
+				if (std::uniform_int_distribution<uint32>(0, 1)(generator) == 0)
+				{
+					group.VertexCount = 2 * std::uniform_int_distribution<uint32>(1, 64)(generator);
+				}
+
+				points.Resize(group.VertexCount);
+				for (glm::vec3& point : points)
+				{
+					point = glm::vec3(positionDistribution(generator), positionDistribution(generator), positionDistribution(generator));
+				}
+
+				lineBatch.UpdateGroup(group.ID, points.GetData(), points.GetSize(), glm::vec3(float32(group.Tag), 1.0f, 0.0f));
+			}
+			else if (change == 2)
+			{
+				const uint32 index = std::uniform_int_distribution<uint32>(0, groups.GetSize() - 1)(generator);
+				lineBatch.RemoveGroup(groups[index].ID);
+				groups[index] = groups.GetBack();
+				groups.PopBack();
+			}
+			else
+			{
+				// Lines drawn for a single frame are the most common, the rest live up to half a second
+				const float32 lifetime = std::uniform_int_distribution<uint32>(0, 1)(generator) == 0 ? 0.0f : std::uniform_real_distribution<float32>(0.0f, 0.5f)(generator);
+
+				lineVertices.Resize(2 * std::uniform_int_distribution<uint32>(1, 16)(generator));
+				for (VertexData& vertex : lineVertices)
+				{
+					vertex.Position	= glm::vec4(positionDistribution(generator), positionDistribution(generator), positionDistribution(generator), 1.0f);
+					vertex.Color	= glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
+				}
+
+				lineBatch.AddLines(lineVertices.GetData(), lineVertices.GetSize(), lifetime);
+				timedLines.PushBack({ lineVertices.GetSize(), time + float64(lifetime) });
+			}
+		}
+
+		// Upload like the LineRenderer does, vertices outside of the dirty range keep what was uploaded before
+		uploadedVertices.Resize(lineBatch.GetVertexCount(), UNUPLOADED_VERTEX);
+
+		uint32 dirtyOffset	= 0;
+		uint32 dirtyCount	= 0;
+		if (lineBatch.GetDirtyRange(dirtyOffset, dirtyCount))
+		{
+			memcpy(&uploadedVertices[dirtyOffset], &lineBatch.GetVertices()[dirtyOffset], dirtyCount * sizeof(VertexData));
+			lineBatch.ClearDirtyRange();
+		}
+
+		bool frameFailed = !uploadedVertices.IsEmpty() && memcmp(uploadedVertices.GetData(), lineBatch.GetVertices().GetData(), uploadedVertices.GetSize() * sizeof(VertexData)) != 0;
+
+		uint32 visibleTimedVertexCount = 0;
+		visibleGroupVertexCounts.clear();
+		for (const VertexData& vertex : lineBatch.GetVertices())
+		{
+			if (vertex.Color.a == 0.0f)
+			{
+				continue;
+			}
+
+			if (vertex.Color.b == 1.0f)
+			{
+				visibleTimedVertexCount++;
+			}
+			else
+			{
+				visibleGroupVertexCounts[uint32(vertex.Color.r)]++;
+			}
+		}
+
+		uint32 timedVertexCount = 0;
+		for (const LineBatchValidationLines& lines : timedLines)
+		{
+			timedVertexCount += lines.VertexCount;
+		}
+
+		frameFailed = frameFailed || visibleTimedVertexCount != timedVertexCount || visibleGroupVertexCounts.size() != groups.GetSize();
+		for (const LineBatchValidationGroup& group : groups)
+		{
+			auto visibleIt = visibleGroupVertexCounts.find(group.Tag);
+			frameFailed = frameFailed || visibleIt == visibleGroupVertexCounts.end() || visibleIt->second != group.VertexCount;
+		}
+
+		if (lineBatch.GetGroupCount() != groups.GetSize())
+		{
+			frameFailed = true;
+		}
+
+		errorCount += frameFailed ? 1 : 0;
+	}
+
+	return float64(errorCount);
+}
+
+float64 BenchmarkState::ValidateTLASUpdateTracker()
+{
+	using namespace LambdaEngine;
+
+	/*
+	* Random frames of moved instances, added and removed instances and GPU written instances like the ASBuilder gets.
+	* The dirty ranges must cover every dirty instance, start and end on one and be further apart than MAX_RANGE_GAP, and
+	* the build mode must follow the policy: rebuild when the instances change or too many moved, never more than
+	* MAX_UPDATES_BEFORE_REBUILD refits in a row and no build when nothing changed. Returns the number of frames that disagree.
+	*/
+	constexpr const uint32 FRAME_COUNT			= 5000;
+	constexpr const uint32 MAX_INSTANCE_COUNT	= 2048;
+
+	std::mt19937 generator(1337);
+
+	TLASUpdateTracker tracker;
+	TArray<TLASInstanceRange> ranges;
+	TArray<bool> dirtyFlags(MAX_INSTANCE_COUNT, false);
+
+	uint32	errorCount			= 0;
+	uint32	instanceCount		= 1024;
+	uint32	builtInstanceCount	= 0;
+	uint32	updatesInARow		= 0;
+	for (uint32 frame = 0; frame < FRAME_COUNT; frame++)
+	{
+		std::fill(dirtyFlags.Begin(), dirtyFlags.End(), false);
+
+		// Instances are added or removed now and then, removed instances may still have been marked dirty
+		const uint32 frameKind = std::uniform_int_distribution<uint32>(0, 99)(generator);
+		if (frameKind < 5)
+		{
+			instanceCount = std::uniform_int_distribution<uint32>(1, MAX_INSTANCE_COUNT)(generator);
+		}
+
+		bool allDirty = false;
+		if (frameKind == 5)
+		{
+			tracker.MarkAllDirty();
+			allDirty = true;
+		}
+
+		bool gpuWritten = false;
+		if (frameKind >= 6 && frameKind < 10)
+		{
+			tracker.MarkGPUWritten();
+			gpuWritten = true;
+		}
+
+		// Mostly a few moving players and projectiles, sometimes most of the level moves at once
+		const uint32 maxDirtyCount = frameKind >= 95 ? MAX_INSTANCE_COUNT : 32;
+		const uint32 dirtyCount = std::uniform_int_distribution<uint32>(0, maxDirtyCount)(generator);
+		for (uint32 d = 0; d < dirtyCount; d++)
+		{
+			const uint32 instanceIndex = std::uniform_int_distribution<uint32>(0, MAX_INSTANCE_COUNT - 1)(generator);
+			tracker.MarkDirty(instanceIndex);
+			dirtyFlags[instanceIndex] = true;
+		}
+
+		const bool blasesChanged = std::uniform_int_distribution<uint32>(0, 49)(generator) == 0;
+
+		uint32 liveDirtyCount = 0;
+		for (uint32 i = 0; i < instanceCount; i++)
+		{
+			liveDirtyCount += dirtyFlags[i] ? 1 : 0;
+		}
+
+		bool frameFailed = false;
+
+		tracker.GetDirtyRanges(instanceCount, ranges);
+		if (allDirty)
+		{
+			frameFailed = ranges.GetSize() != 1 || ranges[0].FirstInstance != 0 || ranges[0].InstanceCount != instanceCount;
+		}
+		else
+		{
+			uint32 coveredDirtyCount = 0;
+			uint32 previousEnd = 0;
+			for (uint32 r = 0; r < ranges.GetSize(); r++)
+			{
+				const TLASInstanceRange& range = ranges[r];
+				const uint32 rangeEnd = range.FirstInstance + range.InstanceCount;
+				if (range.InstanceCount == 0 || rangeEnd > instanceCount || !dirtyFlags[range.FirstInstance] || !dirtyFlags[rangeEnd - 1])
+				{
+					frameFailed = true;
+					continue;
+				}
+
+				if (r > 0 && range.FirstInstance <= previousEnd + TLASUpdateTracker::MAX_RANGE_GAP)
+				{
+					frameFailed = true;
+				}
+
+				for (uint32 i = range.FirstInstance; i < rangeEnd; i++)
+				{
+					coveredDirtyCount += dirtyFlags[i] ? 1 : 0;
+				}
+
+				previousEnd = rangeEnd;
+			}
+
+			frameFailed = frameFailed || coveredDirtyCount != liveDirtyCount;
+		}
+
+		ETLASBuildMode expectedBuildMode = ETLASBuildMode::UPDATE;
+		if (allDirty || instanceCount != builtInstanceCount)
+		{
+			expectedBuildMode = ETLASBuildMode::REBUILD;
+		}
+		else if (liveDirtyCount == 0 && !blasesChanged && !gpuWritten)
+		{
+			expectedBuildMode = ETLASBuildMode::NONE;
+		}
+		else if (updatesInARow >= TLASUpdateTracker::MAX_UPDATES_BEFORE_REBUILD || float32(liveDirtyCount) > float32(instanceCount) * TLASUpdateTracker::REBUILD_DIRTY_FRACTION)
+		{
+			expectedBuildMode = ETLASBuildMode::REBUILD;
+		}
+
+		const ETLASBuildMode buildMode = tracker.SelectBuildMode(instanceCount, builtInstanceCount, blasesChanged);
+		if (buildMode != expectedBuildMode)
+		{
+			frameFailed = true;
+		}
+
+		tracker.Reset(buildMode);
+		if (buildMode == ETLASBuildMode::REBUILD)
+		{
+			builtInstanceCount	= instanceCount;
+			updatesInARow		= 0;
+		}
+		else if (buildMode == ETLASBuildMode::UPDATE)
+		{
+			updatesInARow++;
+		}
+
+		if (updatesInARow > TLASUpdateTracker::MAX_UPDATES_BEFORE_REBUILD || tracker.GetUpdatesSinceRebuild() != updatesInARow || tracker.GetDirtyInstanceCount() != 0)
+		{
+			frameFailed = true;
+		}
+
+		errorCount += frameFailed ? 1 : 0;
+	}
+
+	return float64(errorCount);
+}
+
+float64 BenchmarkState::ValidateRenderGraphAliasing()
+{
+	using namespace LambdaEngine;
+
+	/*
+	* Random render graphs like RenderGraphParser produces them, textures are written by one render stage and read by
+	* later ones with synchronization stages in between. The lifetimes and the transient textures the aliasing planner
+	* finds must match the graph, textures that are read first, external or used by custom renderers or stages that
+	* do not execute every frame keep their own allocation. After placement no two textures with overlapping lifetimes
+	* may share memory, every placement is aligned and inside the heap and a texture that shares memory with another
+	* one has an aliasing barrier at its first pipeline stage, after the other one is done. Returns the number of graphs
+	* that disagree.
+	*/
+	constexpr const uint32 GRAPH_COUNT				= 1000;
+	constexpr const uint32 MAX_TEXTURE_COUNT		= 24;
+	constexpr const uint32 MAX_RENDER_STAGE_COUNT	= 16;
+	constexpr const uint64 PAGE_SIZE				= 4096;
+
+	struct TextureUse
+	{
+		uint32							RenderStage;
+		ERenderGraphResourceBindingType	BindingType;
+	};
+
+	struct TextureModel
+	{
+		TArray<TextureUse>				Uses;
+		bool							Transient;
+		uint32							FirstPipelineStage;
+		uint32							LastPipelineStage;
+		ERenderGraphResourceBindingType	FrameStartBindingType;
+		ECommandQueueType				FrameStartQueue;
+	};
+
+	std::mt19937 generator(1337);
+	auto randomRange = [&generator](uint32 min, uint32 max)
+	{
+		return std::uniform_int_distribution<uint32>(min, max)(generator);
+	};
+
+	uint32 errorCount		= 0;
+	uint32 aliasedPairCount	= 0;
+	for (uint32 graph = 0; graph < GRAPH_COUNT; graph++)
+	{
+		RenderGraphStructureDesc structure = {};
+
+		// Mostly plain stages, some with custom renderers and some that do not execute every frame
+		const uint32 renderStageCount = randomRange(2, MAX_RENDER_STAGE_COUNT);
+		TArray<bool> plainStages(renderStageCount, true);
+		for (uint32 s = 0; s < renderStageCount; s++)
+		{
+			RenderStageDesc renderStageDesc = {};
+			renderStageDesc.Name		= "Render Stage " + std::to_string(s);
+			renderStageDesc.Type		= randomRange(0, 3) == 0 ? EPipelineStateType::PIPELINE_STATE_TYPE_COMPUTE : EPipelineStateType::PIPELINE_STATE_TYPE_GRAPHICS;
+			renderStageDesc.TriggerType	= ERenderStageExecutionTrigger::EVERY;
+
+			const uint32 stageKind = randomRange(0, 19);
+			if (stageKind == 0)
+			{
+				renderStageDesc.CustomRenderer = true;
+			}
+			else if (stageKind == 1)
+			{
+				renderStageDesc.TriggerType = ERenderStageExecutionTrigger::TRIGGERED;
+			}
+			else if (stageKind == 2)
+			{
+				renderStageDesc.FrameDelay = 1;
+			}
+
+			plainStages[s] = stageKind > 2;
+			structure.RenderStageDescriptions.PushBack(renderStageDesc);
+		}
+
+		// Each texture is written once and read by a few of the following stages, some are read before they are written
+		const uint32 textureCount = randomRange(1, MAX_TEXTURE_COUNT);
+		TArray<TextureModel> textures(textureCount);
+		for (uint32 t = 0; t < textureCount; t++)
+		{
+			RenderGraphResourceDesc resourceDesc = {};
+			resourceDesc.Name						= "Texture " + std::to_string(t);
+			resourceDesc.Type						= ERenderGraphResourceType::TEXTURE;
+			resourceDesc.External					= randomRange(0, 19) == 0;
+			resourceDesc.TextureParams.TextureFormat	= EFormat::FORMAT_R8G8B8A8_UNORM;
+			structure.ResourceDescriptions.PushBack(resourceDesc);
+
+			TextureModel& texture = textures[t];
+			const uint32 firstStage	= randomRange(0, renderStageCount - 1);
+			const uint32 lastStage	= glm::min(firstStage + randomRange(0, 4), renderStageCount - 1);
+			const bool readFirst	= randomRange(0, 9) == 0;
+
+			ERenderGraphResourceBindingType firstBindingType = ERenderGraphResourceBindingType::COMBINED_SAMPLER;
+			if (!readFirst)
+			{
+				firstBindingType = structure.RenderStageDescriptions[firstStage].Type == EPipelineStateType::PIPELINE_STATE_TYPE_GRAPHICS ?
+					ERenderGraphResourceBindingType::ATTACHMENT : ERenderGraphResourceBindingType::UNORDERED_ACCESS_WRITE;
+			}
+
+			texture.Uses.PushBack({ firstStage, firstBindingType });
+			for (uint32 s = firstStage + 1; s <= lastStage; s++)
+			{
+				if (s == lastStage || randomRange(0, 1) == 0)
+				{
+					texture.Uses.PushBack({ s, randomRange(0, 1) == 0 ? ERenderGraphResourceBindingType::COMBINED_SAMPLER : ERenderGraphResourceBindingType::UNORDERED_ACCESS_READ });
+				}
+			}
+
+			texture.Transient = !resourceDesc.External && !readFirst;
+			for (const TextureUse& use : texture.Uses)
+			{
+				texture.Transient = texture.Transient && plainStages[use.RenderStage];
+			}
+		}
+
+		// Synchronizations in front of every use except for the first attachment use that the render pass transitions
+		TArray<SynchronizationStageDesc> synchronizationStageDescs(renderStageCount);
+		for (uint32 t = 0; t < textureCount; t++)
+		{
+			const TextureModel& texture = textures[t];
+			for (uint32 u = 0; u < texture.Uses.GetSize(); u++)
+			{
+				const TextureUse& use = texture.Uses[u];
+				RenderStageDesc& renderStageDesc = structure.RenderStageDescriptions[use.RenderStage];
+
+				// The first use of each frame comes after the last use of the previous frame
+				const TextureUse& prevUse = texture.Uses[u > 0 ? u - 1 : texture.Uses.GetSize() - 1];
+				const RenderStageDesc& prevRenderStageDesc = structure.RenderStageDescriptions[prevUse.RenderStage];
+
+				RenderGraphResourceState resourceState = {};
+				resourceState.ResourceName	= structure.ResourceDescriptions[t].Name;
+				resourceState.BindingType	= use.BindingType;
+				if (use.BindingType == ERenderGraphResourceBindingType::ATTACHMENT)
+				{
+					resourceState.AttachmentSynchronizations.PrevSameFrame		= false;
+					resourceState.AttachmentSynchronizations.PrevBindingType	= prevUse.BindingType;
+					resourceState.AttachmentSynchronizations.NextBindingType	= texture.Uses.GetSize() > 1 ? texture.Uses[1].BindingType : use.BindingType;
+				}
+				else
+				{
+					RenderGraphResourceSynchronizationDesc synchronizationDesc = {};
+					synchronizationDesc.PrevRenderStage	= prevRenderStageDesc.Name;
+					synchronizationDesc.NextRenderStage	= renderStageDesc.Name;
+					synchronizationDesc.ResourceName	= resourceState.ResourceName;
+					synchronizationDesc.PrevQueue		= ConvertPipelineStateTypeToQueue(prevRenderStageDesc.Type);
+					synchronizationDesc.NextQueue		= ConvertPipelineStateTypeToQueue(renderStageDesc.Type);
+					synchronizationDesc.PrevBindingType	= prevUse.BindingType;
+					synchronizationDesc.NextBindingType	= use.BindingType;
+					synchronizationDesc.ResourceType	= ERenderGraphResourceType::TEXTURE;
+					synchronizationStageDescs[use.RenderStage].Synchronizations.PushBack(synchronizationDesc);
+				}
+
+				renderStageDesc.ResourceStates.PushBack(resourceState);
+			}
+		}
+
+		// Pipeline stages in execution order, synchronization stages only where there is something to synchronize
+		TArray<uint32> renderPipelineStages(renderStageCount);
+		TArray<uint32> synchronizationPipelineStages(renderStageCount, UINT32_MAX);
+		for (uint32 s = 0; s < renderStageCount; s++)
+		{
+			if (!synchronizationStageDescs[s].Synchronizations.IsEmpty())
+			{
+				synchronizationPipelineStages[s] = structure.PipelineStageDescriptions.GetSize();
+				structure.PipelineStageDescriptions.PushBack({ ERenderGraphPipelineStageType::SYNCHRONIZATION, structure.SynchronizationStageDescriptions.GetSize() });
+				structure.SynchronizationStageDescriptions.PushBack(synchronizationStageDescs[s]);
+			}
+
+			renderPipelineStages[s] = structure.PipelineStageDescriptions.GetSize();
+			structure.PipelineStageDescriptions.PushBack({ ERenderGraphPipelineStageType::RENDER, s });
+		}
+
+		for (TextureModel& texture : textures)
+		{
+			const TextureUse& firstUse	= texture.Uses.GetFront();
+			const TextureUse& lastUse	= texture.Uses.GetBack();
+			const bool renderPassTransition = firstUse.BindingType == ERenderGraphResourceBindingType::ATTACHMENT;
+
+			texture.FirstPipelineStage		= renderPassTransition ? renderPipelineStages[firstUse.RenderStage] : synchronizationPipelineStages[firstUse.RenderStage];
+			texture.LastPipelineStage		= renderPipelineStages[lastUse.RenderStage];
+			texture.FrameStartBindingType	= lastUse.BindingType;
+			texture.FrameStartQueue			= ConvertPipelineStateTypeToQueue(structure.RenderStageDescriptions[renderPassTransition ? firstUse.RenderStage : lastUse.RenderStage].Type);
+		}
+
+		RenderGraphAliasingPlan plan;
+		RenderGraphAliasingPlanner::AnalyzeLifetimes(structure, plan);
+
+		bool graphFailed = plan.Placements.GetSize() != textureCount;
+		for (uint32 t = 0; t < textureCount && !graphFailed; t++)
+		{
+			const RenderGraphResourcePlacement& placement = plan.Placements[t];
+			const TextureModel& texture = textures[t];
+			graphFailed =
+				placement.Transient != texture.Transient ||
+				placement.FirstPipelineStage != texture.FirstPipelineStage ||
+				placement.LastPipelineStage != texture.LastPipelineStage ||
+				placement.FrameStartBindingType != texture.FrameStartBindingType ||
+				placement.FrameStartQueue != texture.FrameStartQueue;
+		}
+
+		if (graphFailed)
+		{
+			errorCount++;
+			continue;
+		}
+
+		// Sizes and alignments like the device reports them, now and then a texture that needs another memory type
+		for (RenderGraphResourcePlacement& placement : plan.Placements)
+		{
+			placement.SizeInBytes		= uint64(randomRange(1, 1024)) * PAGE_SIZE;
+			placement.Alignment			= PAGE_SIZE << randomRange(0, 4);
+			placement.MemoryTypeBits	= randomRange(0, 19) == 0 ? 0x4 : 0x3;
+		}
+
+		TArray<bool> transientBeforePlacement(textureCount);
+		for (uint32 t = 0; t < textureCount; t++)
+		{
+			transientBeforePlacement[t] = plan.Placements[t].Transient;
+		}
+
+		RenderGraphAliasingPlanner::PlaceResources(plan);
+
+		uint32 aliasedCount = 0;
+		for (uint32 t = 0; t < textureCount; t++)
+		{
+			const RenderGraphResourcePlacement& placement = plan.Placements[t];
+			if (!placement.Transient)
+			{
+				// Only textures without a memory type in common with the heap are left out
+				graphFailed = graphFailed || (transientBeforePlacement[t] && (placement.MemoryTypeBits & plan.HeapMemoryTypeBits) != 0);
+				continue;
+			}
+
+			graphFailed =
+				graphFailed ||
+				placement.Offset % placement.Alignment != 0 ||
+				placement.Offset + placement.SizeInBytes > plan.HeapSizeInBytes ||
+				(placement.MemoryTypeBits & plan.HeapMemoryTypeBits) != plan.HeapMemoryTypeBits;
+
+			aliasedCount += placement.Aliased ? 1 : 0;
+		}
+
+		auto hasAliasingBarrier = [&plan](uint32 placementIndex, uint32 pipelineStage)
+		{
+			for (const RenderGraphAliasingBarrier& aliasingBarrier : plan.AliasingBarriers)
+			{
+				if (aliasingBarrier.PlacementIndex == placementIndex && aliasingBarrier.PipelineStage == pipelineStage)
+				{
+					return true;
+				}
+			}
+
+			return false;
+		};
+
+		for (uint32 lhs = 0; lhs < textureCount; lhs++)
+		{
+			const RenderGraphResourcePlacement& lhsPlacement = plan.Placements[lhs];
+			for (uint32 rhs = lhs + 1; rhs < textureCount && lhsPlacement.Transient; rhs++)
+			{
+				const RenderGraphResourcePlacement& rhsPlacement = plan.Placements[rhs];
+				if (!rhsPlacement.Transient || !RenderGraphAliasingPlanner::MemoryOverlaps(lhsPlacement, rhsPlacement))
+				{
+					continue;
+				}
+
+				aliasedPairCount++;
+
+				// The texture that is used later discards the content of the earlier one after it is done
+				const TextureModel& earlier	= textures[lhs].FirstPipelineStage < textures[rhs].FirstPipelineStage ? textures[lhs] : textures[rhs];
+				const TextureModel& later	= &earlier == &textures[lhs] ? textures[rhs] : textures[lhs];
+				graphFailed =
+					graphFailed ||
+					later.FirstPipelineStage <= earlier.LastPipelineStage ||
+					!lhsPlacement.Aliased || !rhsPlacement.Aliased ||
+					!hasAliasingBarrier(lhs, lhsPlacement.FirstPipelineStage) ||
+					!hasAliasingBarrier(rhs, rhsPlacement.FirstPipelineStage);
+			}
+		}
+
+		// One barrier for each aliased texture, in the order the pipeline stages execute
+		graphFailed = graphFailed || plan.AliasingBarriers.GetSize() != aliasedCount;
+		for (uint32 b = 1; b < plan.AliasingBarriers.GetSize(); b++)
+		{
+			graphFailed = graphFailed || plan.AliasingBarriers[b - 1].PipelineStage > plan.AliasingBarriers[b].PipelineStage;
+		}
+
+		errorCount += graphFailed ? 1 : 0;
+	}
+
+	// The graphs have to alias at least some textures or the barriers are never checked
+	errorCount += aliasedPairCount == 0 ? 1 : 0;
+
+	return float64(errorCount);
+}
+
+// The temporaries of one frame: copied hit events like HUDSystem, gathered draw args like RenderSystem and a few names
+template<typename TTemporaries>
+static uint64 BuildFrameTemporaries(uint32 frame)
+{
+	using namespace LambdaEngine;
+
+	constexpr const uint32 HIT_EVENT_COUNT	= 16;
+	constexpr const uint32 DRAW_ARG_COUNT	= 256;
+	constexpr const uint32 NAME_COUNT		= 8;
+
+	struct BenchmarkDrawArg
+	{
+		uint64	Mask;
+		void*	pBuffers[6];
+		uint32	InstanceCount;
+	};
+
+	typename TTemporaries::template Array<std::pair<glm::vec3, uint8>> hitEvents;
+	for (uint32 h = 0; h < HIT_EVENT_COUNT; h++)
+	{
+		hitEvents.EmplaceBack(glm::vec3(float32(h), 0.0f, float32(frame)), uint8(h % 2));
+	}
+
+	typename TTemporaries::template Array<BenchmarkDrawArg> drawArgs;
+	typename TTemporaries::template HashTable<uint64, uint32> drawArgIndices;
+	for (uint32 d = 0; d < DRAW_ARG_COUNT; d++)
+	{
+		BenchmarkDrawArg& drawArg = drawArgs.PushBack({});
+		drawArg.Mask			= uint64(d % 7);
+		drawArg.InstanceCount	= d + frame;
+		drawArgIndices[uint64(d) * 2654435761ULL] = d;
+	}
+
+	uint64 checksum = 0;
+	for (uint32 n = 0; n < NAME_COUNT; n++)
+	{
+		typename TTemporaries::StringType name = "Benchmark frame temporary name ";
+		name += std::to_string(frame * NAME_COUNT + n).c_str();
+		checksum += name.size();
+	}
+
+	return checksum + hitEvents.GetSize() + drawArgs.GetSize() + drawArgIndices.size();
+}
+
+float64 BenchmarkState::ValidateParticleSimulation()
+{
+	using namespace LambdaEngine;
+
+	/*
+	* Mismatching particles of the frame that ParticleManager simulated on both the GPU and ParticleSimulatorCPU, requested
+	* from Tick. A run where the comparison never finished, because no particles were spawned or they are simulated on the
+	* CPU, is not counted as an error.
+	*/
+	const ParticleManager& particleManager = RenderSystem::GetInstance().GetParticleManager();
+	if (!particleManager.HasCPUComparisonResult())
+	{
+		LOG_WARNING("[BenchmarkState]: Particle simulation was not compared against the CPU");
+		return 0.0;
+	}
+
+	return float64(particleManager.GetCPUComparisonMismatchCount());
+}
+
+float64 BenchmarkState::BenchmarkFrameAllocator(bool useFrameAllocator)
+{
+	using namespace LambdaEngine;
+
+	/*
+	* Builds the temporary containers of a frame either on the heap or in the FrameAllocator and ends the frame.
+	* Returns heap allocations per frame once the frame allocator has grown to its steady size.
+	*/
+	constexpr const uint32 WARMUP_FRAME_COUNT	= 10;
+	constexpr const uint32 FRAME_COUNT			= 600;
+
+	uint64 allocationCount	= 0;
+	uint64 checksum			= 0;
+	for (uint32 frame = 0; frame < WARMUP_FRAME_COUNT + FRAME_COUNT; frame++)
+	{
+		const uint64 allocationCountBefore = Malloc::GetThreadAllocationCount();
+
+		if (useFrameAllocator)
+		{
+			checksum += BuildFrameTemporaries<FrameAllocatorFrameTemporaries>(frame);
+		}
+		else
+		{
+			checksum += BuildFrameTemporaries<HeapFrameTemporaries>(frame);
+		}
+
+		FrameAllocator::EndFrame();
+
+		if (frame >= WARMUP_FRAME_COUNT)
+		{
+			allocationCount += Malloc::GetThreadAllocationCount() - allocationCountBefore;
+		}
+	}
+
+	const FrameAllocatorStats stats = FrameAllocator::GetThreadStats();
+	LOG_INFO("[BenchmarkState]: Frame allocator holds %llu blocks (%llu bytes), checksum %llu", stats.BlockCount, stats.BlockBytes, checksum);
+
+	return float64(allocationCount) / float64(FRAME_COUNT);
+}
+
+// About the size of the gameplay events that are sent from worker threads, like ProjectileHitEvent
+struct EventQueueBenchmarkEvent : public LambdaEngine::Event
+{
+public:
+	inline EventQueueBenchmarkEvent(uint32 producer, uint32 sequence)
+		: Event()
+		, Producer(producer)
+		, Sequence(sequence)
+	{
+	}
+
+	DECLARE_EVENT_TYPE(EventQueueBenchmarkEvent);
+
+	virtual LambdaEngine::String ToString() const
+	{
+		return "EventQueueBenchmarkEvent Producer=" + std::to_string(Producer) + " Sequence=" + std::to_string(Sequence);
+	}
+
+	uint32		Producer;
+	uint32		Sequence;
+	glm::vec3	Payload[4];
+};
+
+BenchmarkState::EventQueueBenchmarkResult BenchmarkState::BenchmarkEventQueue(bool lockFree)
+{
+	using namespace LambdaEngine;
+
+	/*
+	* Eight threads send events as fast as they can while the calling thread dispatches them, either through the
+	* EventBuffer or through the SpinLock and double buffered EventContainers that EventQueue used before. The time of
+	* every send is measured to find the tail latency of posting, throughput is events dispatched per second.
+	*/
+	constexpr const uint32 PRODUCER_COUNT		= 8;
+	constexpr const uint32 EVENTS_PER_PRODUCER	= 100000;
+
+	EventBuffer eventBuffer;
+	EventContainer eventContainers[2];
+	SpinLock writeLock;
+	uint32 writeIndex = 0;
+
+	TArray<uint32> pushNanoseconds[PRODUCER_COUNT];
+	std::atomic_uint32_t finishedProducerCount = 0;
+	TArray<uint32> nextSequences(PRODUCER_COUNT, 0);
+	uint64 dispatchedEventCount	= 0;
+	uint64 outOfOrderEventCount	= 0;
+
+	auto onEvent = [&](const Event& event)
+	{
+		const EventQueueBenchmarkEvent& benchmarkEvent = static_cast<const EventQueueBenchmarkEvent&>(event);
+		outOfOrderEventCount += benchmarkEvent.Sequence != nextSequences[benchmarkEvent.Producer];
+		nextSequences[benchmarkEvent.Producer] = benchmarkEvent.Sequence + 1;
+		dispatchedEventCount++;
+	};
+
+	auto dispatch = [&]()
+	{
+		if (lockFree)
+		{
+			eventBuffer.Dispatch(onEvent);
+			eventBuffer.Seal();
+		}
+		else
+		{
+			EventContainer* pReadContainer = nullptr;
+			{
+				std::scoped_lock<SpinLock> lock(writeLock);
+				pReadContainer = &eventContainers[writeIndex];
+				writeIndex = 1 - writeIndex;
+			}
+
+			for (uint32 e = 0; e < pReadContainer->Size(); e++)
+			{
+				onEvent(pReadContainer->At(e));
+			}
+
+			pReadContainer->Clear();
+		}
+	};
+
+	const auto startTime = std::chrono::high_resolution_clock::now();
+
+	TArray<std::thread> producers;
+	producers.Reserve(PRODUCER_COUNT);
+	for (uint32 p = 0; p < PRODUCER_COUNT; p++)
+	{
+		pushNanoseconds[p].Reserve(EVENTS_PER_PRODUCER);
+		producers.EmplaceBack([&, p]()
+			{
+				for (uint32 e = 0; e < EVENTS_PER_PRODUCER; e++)
+				{
+					const auto pushStartTime = std::chrono::high_resolution_clock::now();
+					if (lockFree)
+					{
+						eventBuffer.Push(EventQueueBenchmarkEvent(p, e));
+					}
+					else
+					{
+						std::scoped_lock<SpinLock> lock(writeLock);
+						eventContainers[writeIndex].Push(EventQueueBenchmarkEvent(p, e));
+					}
+
+					pushNanoseconds[p].PushBack(uint32(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - pushStartTime).count()));
+				}
+
+				finishedProducerCount++;
+			});
+	}
+
+	while (finishedProducerCount.load() < PRODUCER_COUNT)
+	{
+		dispatch();
+	}
+
+	for (std::thread& producer : producers)
+	{
+		producer.join();
+	}
+
+	// Every event has been sent, the lock free buffer needs one more dispatch to deliver the events of the last seal
+	dispatch();
+	dispatch();
+
+	const float64 seconds = std::chrono::duration<float64>(std::chrono::high_resolution_clock::now() - startTime).count();
+
+	TArray<uint32> allPushNanoseconds;
+	for (const TArray<uint32>& producerPushNanoseconds : pushNanoseconds)
+	{
+		allPushNanoseconds.Insert(allPushNanoseconds.End(), producerPushNanoseconds.Begin(), producerPushNanoseconds.End());
+	}
+
+	std::sort(allPushNanoseconds.Begin(), allPushNanoseconds.End());
+
+	if (dispatchedEventCount != uint64(PRODUCER_COUNT) * EVENTS_PER_PRODUCER || outOfOrderEventCount > 0)
+	{
+		LOG_ERROR("[BenchmarkState]: Event queue benchmark dispatched %llu events, %llu out of order", dispatchedEventCount, outOfOrderEventCount);
+	}
+
+	EventQueueBenchmarkResult result = {};
+	result.EventsPerSecond		= float64(dispatchedEventCount) / seconds;
+	result.PushP99Nanoseconds	= float64(allPushNanoseconds[allPushNanoseconds.GetSize() * 99 / 100]);
+	result.PushP999Nanoseconds	= float64(allPushNanoseconds[allPushNanoseconds.GetSize() * 999 / 1000]);
+	result.PushMaxNanoseconds	= float64(allPushNanoseconds.GetBack());
+	return result;
+}
+
+BenchmarkState::LoggingBenchmarkResult BenchmarkState::BenchmarkLogging(bool async)
+{
+	using namespace LambdaEngine;
+
+	/*
+	* Four threads log messages like the verbose networking logs, either printed by the calling thread or recorded
+	* for the log thread. Only the time spent in the calling thread is measured, messages dropped because a ring was
+	* full are counted separately
+	*/
+	constexpr const uint32 THREAD_COUNT			= 4;
+	constexpr const uint32 MESSAGES_PER_THREAD	= 2500;
+
+	Log::SetAsyncOutputEnabled(async);
+
+	const uint64 droppedCountBefore = Log::GetAsyncStats().DroppedMessageCount;
+
+	TArray<uint32> callNanoseconds[THREAD_COUNT];
+	TArray<std::thread> threads;
+	threads.Reserve(THREAD_COUNT);
+	for (uint32 t = 0; t < THREAD_COUNT; t++)
+	{
+		callNanoseconds[t].Reserve(MESSAGES_PER_THREAD);
+		threads.EmplaceBack([&, t]()
+			{
+				const char* pEndPoint = "192.168.0.1:4444";
+				for (uint32 m = 0; m < MESSAGES_PER_THREAD; m++)
+				{
+					const auto callStartTime = std::chrono::high_resolution_clock::now();
+					LOG_INFO("[BenchmarkState]: Thread %u received packet %u from %s, %d bytes, RTT %.2f ms", t, m, pEndPoint, int32(m % 1400), float64(m % 100) * 0.37);
+					callNanoseconds[t].PushBack(uint32(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - callStartTime).count()));
+				}
+			});
+	}
+
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	Log::Flush();
+	Log::SetAsyncOutputEnabled(true);
+
+	TArray<uint32> allCallNanoseconds;
+	for (const TArray<uint32>& threadCallNanoseconds : callNanoseconds)
+	{
+		allCallNanoseconds.Insert(allCallNanoseconds.End(), threadCallNanoseconds.Begin(), threadCallNanoseconds.End());
+	}
+
+	std::sort(allCallNanoseconds.Begin(), allCallNanoseconds.End());
+
+	LoggingBenchmarkResult result = {};
+	result.CallP50Nanoseconds	= float64(allCallNanoseconds[allCallNanoseconds.GetSize() / 2]);
+	result.CallP99Nanoseconds	= float64(allCallNanoseconds[allCallNanoseconds.GetSize() * 99 / 100]);
+	result.CallMaxNanoseconds	= float64(allCallNanoseconds.GetBack());
+	result.DroppedMessages		= float64(Log::GetAsyncStats().DroppedMessageCount - droppedCountBefore);
+	return result;
+}
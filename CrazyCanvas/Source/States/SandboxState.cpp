@@ -577,7 +577,7 @@ bool SandboxState::OnKeyPressed(const LambdaEngine::KeyPressedEvent& event)
 
 			std::string info = "Removed entity[" + std::to_string(entity) + "] with index [" + std::to_string(index) + "/" + std::to_string(numEntities) + "]!";
 			GameConsole::Get().PushInfo(info);
-			LOG_INFO(info.c_str());
+			LOG_INFO("%s", info.c_str());
 		}
 	}
 
@@ -4,6 +4,10 @@
 
 #include "Game/ECS/Components/Rendering/GlobalLightProbeComponent.h"
 
+#include "MeshPaint/PaintMaskSynchronizer.h"
+
+#include "Resources/ResourceManager.h"
+
 Level::Level()
 {
 	SetComponentOwner<LevelRegisteredComponent>({ .Destructor = std::bind_front(&Level::LevelRegisteredDestructor, this) });
@@ -28,6 +32,8 @@ Level::~Level()
 	}
 
 	m_LevelEntities.Clear();
+
+	PaintMaskSynchronizer::Clear();
 }
 
 bool Level::Init(const LevelCreateDesc* pDesc)
@@ -82,6 +88,15 @@ bool Level::Init(const LevelCreateDesc* pDesc)
 				{
 					levelEntities.PushBack(entity);
 					m_EntityToLevelObjectTypeMap[entity] = ELevelObjectType::LEVEL_OBJECT_TYPE_STATIC_GEOMETRY;
+
+					// Same transform as CreateStaticGeometry gives the entity
+					const Mesh* pMesh = ResourceManager::GetMesh(meshComponent.MeshGUID);
+					const glm::mat4 transform =
+						glm::translate(glm::identity<glm::mat4>(), pMesh->DefaultPosition + translation) *
+						glm::toMat4(pMesh->DefaultRotation) *
+						glm::scale(glm::identity<glm::mat4>(), pMesh->DefaultScale);
+
+					PaintMaskSynchronizer::RegisterMesh(entity, pMesh, transform);
 				}
 			}
 
@@ -32,6 +32,7 @@
 #include "ECS/Components/Player/GrenadeComponent.h"
 #include "ECS/Systems/Player/HealthSystemServer.h"
 #include "ECS/Systems/Player/WeaponSystem.h"
+#include "ECS/Systems/Player/ProjectileSystem.h"
 #include "ECS/Components/Match/FlagComponent.h"
 #include "ECS/Components/Match/ShowerComponent.h"
 #include "ECS/Components/Multiplayer/PacketComponent.h"
@@ -1635,35 +1636,17 @@ bool LevelObjectCreator::CreateProjectile(
 
 	const glm::vec3 normVelocity = glm::normalize(desc.InitalVelocity);
 	const glm::vec3 projectileOffset = normVelocity * 0.5f;
-	PositionComponent& positionComponent = pECS->AddComponent<PositionComponent>(projectileEntity, { true, desc.FirePosition + projectileOffset });
-	ScaleComponent& scaleComponent = pECS->AddComponent<ScaleComponent>(projectileEntity, { true, glm::vec3(0.7f) });
-	RotationComponent& rotationComponent = pECS->AddComponent<RotationComponent>(projectileEntity, { true, glm::quatLookAt(normVelocity, g_DefaultUp) });
-
-	const DynamicCollisionCreateInfo collisionInfo =
-	{
-		/* Entity */	 		projectileEntity,
-		/* Detection Method */	ECollisionDetection::CONTINUOUS,
-		/* Position */	 		positionComponent,
-		/* Scale */				scaleComponent,
-		/* Rotation */			rotationComponent,
-		{
-			{
-				.ShapeType =		EShapeType::SIMULATION,
-				.GeometryType =		EGeometryType::SPHERE,
-				.GeometryParams =	{ .Radius = 0.3f },
-				.CollisionGroup =	(uint32)FCollisionGroup::COLLISION_GROUP_DYNAMIC |
-									(uint32)FCrazyCanvasCollisionGroup::COLLISION_GROUP_PROJECTILE,
-				.CollisionMask =	(uint32)FCrazyCanvasCollisionGroup::COLLISION_GROUP_PLAYER |
-									(uint32)FCollisionGroup::COLLISION_GROUP_STATIC,
-				.EntityID =			desc.WeaponOwner,
-				.CallbackFunction =	desc.Callback,
-			},
-		},
-		/* Velocity */			velocityComponent
-	};
-
-	const DynamicCollisionComponent projectileCollisionComp = PhysicsSystem::GetInstance()->CreateDynamicActor(collisionInfo);
-	pECS->AddComponent<DynamicCollisionComponent>(projectileEntity, projectileCollisionComp);
+	const PositionComponent& positionComponent = pECS->AddComponent<PositionComponent>(projectileEntity, { true, desc.FirePosition + projectileOffset });
+	pECS->AddComponent<ScaleComponent>(projectileEntity, { true, glm::vec3(0.7f) });
+	pECS->AddComponent<RotationComponent>(projectileEntity, { true, glm::quatLookAt(normVelocity, g_DefaultUp) });
+
+	// Projectiles have no PhysX actor, the ProjectileSystem moves them and reports their hits to the callback
+	ProjectileSystem::GetInstance().AddProjectile(
+		projectileEntity,
+		desc.WeaponOwner,
+		positionComponent.Position,
+		velocityComponent.Velocity,
+		desc.Callback);
 
 	if (!MultiplayerUtils::IsServer())
 	{
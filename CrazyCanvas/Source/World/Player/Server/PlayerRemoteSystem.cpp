@@ -73,7 +73,7 @@ void PlayerRemoteSystem::FixedTickMainThread(LambdaEngine::Timestamp deltaTime)
 		const RotationComponent& constRotationComponent = pRotationComponents->GetConstData(entityPlayer);
 		CharacterColliderComponent& characterColliderComponent = pCharacterColliderComponents->GetData(entityPlayer);
 
-		const TArray<PacketPlayerAction>& gameStates = playerActionComponent.GetPacketsReceived();
+		const PacketInbox<PacketPlayerAction> gameStates = playerActionComponent.GetInbox();
 
 		if (!gameStates.IsEmpty())
 		{
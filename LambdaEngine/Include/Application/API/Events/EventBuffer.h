@@ -0,0 +1,108 @@
+#pragma once
+#include "Event.h"
+
+#include <atomic>
+
+namespace LambdaEngine
+{
+	struct EventBlock;
+	struct EventProducer;
+
+	/*
+	* EventBuffer - Deferred events posted by any number of threads and dispatched by one thread. Every thread that
+	* pushes events gets its own producer, a chain of blocks that only that thread writes to, so pushing never takes a
+	* lock or waits for another thread. Seal marks the events that have been pushed so far and Dispatch delivers the
+	* events that were sealed by the previous call to Seal, walking the chain of every producer. The order of the events
+	* pushed by one thread is preserved, events pushed by different threads are delivered producer by producer.
+	*
+	* Seal, Dispatch and Clear must be called by the same thread. A thread that pushes to a buffer has to stop pushing
+	* before the buffer is destroyed, the producers of threads that have exited are reused by new threads.
+	*/
+
+	class LAMBDA_API EventBuffer
+	{
+	public:
+		DECL_REMOVE_COPY(EventBuffer);
+		DECL_REMOVE_MOVE(EventBuffer);
+
+		EventBuffer();
+		~EventBuffer();
+
+		template<typename TEvent>
+		FORCEINLINE void Push(const TEvent& event)
+		{
+			static_assert(std::is_base_of<Event, TEvent>());
+			static_assert(alignof(TEvent) <= EVENT_ALIGNMENT);
+			static_assert(sizeof(TEvent) <= MAX_EVENT_SIZE, "Event does not fit in an event block");
+
+			EventProducer* pProducer = GetThreadProducer();
+			void* pMemory = BeginPush(pProducer, sizeof(TEvent));
+			if (pMemory)
+			{
+				new(pMemory) TEvent(event);
+				EndPush(pProducer);
+			}
+		}
+
+		/*
+		* Marks every event that has been pushed so far to be dispatched by the next call to Dispatch
+		*/
+		void Seal();
+
+		/*
+		* Calls func with every event sealed by the previous call to Seal and destroys the events afterwards. Events
+		* pushed by func are dispatched after the next call to Seal
+		*/
+		template<typename TFunc>
+		FORCEINLINE void Dispatch(TFunc func)
+		{
+			for (EventProducer* pProducer = m_pProducers.load(std::memory_order_acquire); pProducer; pProducer = GetNextProducer(pProducer))
+			{
+				Event* pEvent = nullptr;
+				while ((pEvent = ReadEvent(pProducer)) != nullptr)
+				{
+					func(*pEvent);
+					pEvent->~Event();
+				}
+			}
+		}
+
+		/*
+		* Destroys every event without dispatching it
+		*/
+		void Clear();
+
+		FORCEINLINE uint32 GetProducerCount() const
+		{
+			return m_ProducerCount.load(std::memory_order_relaxed);
+		}
+
+	public:
+		static constexpr const uint32 EVENT_ALIGNMENT		= 16;
+		static constexpr const uint32 EVENT_BLOCK_SIZE		= 16 * 1024;
+		static constexpr const uint32 EVENT_HEADER_SIZE		= EVENT_ALIGNMENT;	// Every event is preceded by its size, padded so that the event is aligned
+		static constexpr const uint32 MAX_EVENT_SIZE		= EVENT_BLOCK_SIZE - EVENT_HEADER_SIZE;
+
+	private:
+		EventProducer* GetThreadProducer();
+		EventProducer* CreateProducer();
+
+		/*
+		* Returns the memory to construct the event in, or nullptr if it is larger than MAX_EVENT_SIZE and is rejected
+		*/
+		void* BeginPush(EventProducer* pProducer, uint32 sizeInBytes);
+		void EndPush(EventProducer* pProducer);
+
+		/*
+		* Returns the next sealed event of a producer, or nullptr once every sealed event has been read
+		*/
+		Event* ReadEvent(EventProducer* pProducer);
+
+		static EventProducer* GetNextProducer(EventProducer* pProducer);
+
+	private:
+		const uint64					m_BufferID;
+		std::atomic<EventProducer*>		m_pProducers;
+		std::atomic_uint32_t			m_ProducerCount;
+	};
+}
@@ -1,5 +1,6 @@
 #pragma once
 #include "EventHandler.h"
+#include "EventBuffer.h"
 #include "KeyEvents.h"
 
 #include "Containers/TUniquePtr.h"
@@ -138,13 +139,15 @@ namespace LambdaEngine
 
 		static void UnregisterAll();
 
+		/*
+		* Defers an event to the next call to Tick after the one that follows, can be called from any thread without
+		* blocking
+		*/
 		template<typename TEvent>
 		inline static void SendEvent(const TEvent& event)
 		{
-			std::scoped_lock<SpinLock> lock(s_WriteLock);
-
 			VALIDATE(event.GetType() == TEvent::GetStaticType());
-			s_DeferredEvents[s_WriteIndex].Push(event);
+			s_DeferredEvents.Push(event);
 		}
 
 		static bool SendEventImmediate(Event& event);
@@ -157,9 +160,6 @@ namespace LambdaEngine
 		static void InternalSendEventToHandlers(Event& event, const TArray<EventHandler>& handlers);
 
 	private:
-		static EventContainer	s_DeferredEvents[2];
-		static SpinLock			s_WriteLock;
-		static uint32			s_WriteIndex;
-		static uint32			s_ReadIndex;
+		static EventBuffer s_DeferredEvents;
 	};
 }
\ No newline at end of file
@@ -1,6 +1,8 @@
 #pragma once
 #include <string>
 
+#include "Memory/API/FrameAllocator.h"
+
 // Disable the DLL- linkage warning for now
 #ifdef LAMBDA_VISUAL_STUDIO
 	#pragma warning(disable : 4251)
@@ -10,4 +12,7 @@ namespace LambdaEngine
 {
 	using String	= std::string;
 	using WString	= std::wstring;
+
+	// String for temporary data that is freed at the end of the next frame, see FrameAllocator
+	using FrameString = std::basic_string<char, std::char_traits<char>, TFrameStdAllocator<char>>;
 }
\ No newline at end of file
@@ -1,6 +1,9 @@
 #pragma once
 #include "TUtilities.h"
 
+#include "Memory/API/Malloc.h"
+#include "Memory/API/FrameAllocator.h"
+
 #include <iterator>
 #include <algorithm>
 
@@ -12,9 +15,9 @@
 namespace LambdaEngine
 {
 	/*
-	* Dynamic Array similar to std::vector
+	* Dynamic Array similar to std::vector. TAllocator is a class with static Allocate(sizeInBytes) and Free(pPtr)
 	*/
-	template<typename T>
+	template<typename T, typename TAllocator = Malloc>
 	class TArray
 	{
 	public:
@@ -1026,14 +1029,14 @@ namespace LambdaEngine
 		{
 			constexpr SizeType elementByteSize	= sizeof(T);
 			const SizeType sizeInBytes			= elementByteSize * inCapacity;
-			return reinterpret_cast<T*>(malloc(static_cast<size_t>(sizeInBytes)));
+			return reinterpret_cast<T*>(TAllocator::Allocate(sizeInBytes));
 		}
 
 		FORCEINLINE void InternalReleaseData()
 		{
 			if (m_pData)
 			{
-				free(m_pData);
+				TAllocator::Free(m_pData);
 				m_pData = nullptr;
 			}
 		}
@@ -1289,4 +1292,10 @@ namespace LambdaEngine
 		SizeType	m_Size;
 		SizeType	m_Capacity;
 	};
+
+	/*
+	* Array for temporary data that is freed at the end of the next frame, see FrameAllocator
+	*/
+	template<typename T>
+	using TFrameArray = TArray<T, FrameAllocator>;
 }
\ No newline at end of file
@@ -1,6 +1,8 @@
 #pragma once
 #include <unordered_map>
 
+#include "Memory/API/FrameAllocator.h"
+
 // Disable the DLL- linkage warning for now
 #ifdef LAMBDA_VISUAL_STUDIO
 	#pragma warning(disable : 4251)
@@ -10,4 +12,10 @@ namespace LambdaEngine
 {
 	template <typename Key, typename Type, typename Hasher = std::hash<Key>>
 	using THashTable = std::unordered_map<Key, Type, Hasher>;
+
+	/*
+	* Hash table for temporary data that is freed at the end of the next frame, see FrameAllocator
+	*/
+	template <typename Key, typename Type, typename Hasher = std::hash<Key>>
+	using TFrameHashTable = std::unordered_map<Key, Type, Hasher, std::equal_to<Key>, TFrameStdAllocator<std::pair<const Key, Type>>>;
 }
\ No newline at end of file
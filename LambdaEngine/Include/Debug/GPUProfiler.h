@@ -4,6 +4,7 @@
 #include "Containers/String.h"
 #include "Time/API/Timestamp.h"
 #include "Rendering/Core/API/GraphicsDevice.h"
+#include "Threading/API/SpinLock.h"
 
 namespace LambdaEngine
 {
@@ -52,7 +53,8 @@ namespace LambdaEngine
 
 		// Create timestamps per command list
 		void CreateTimestamps(uint32_t listCount);
-		void CreateGraphicsPipelineStats();
+		// Create one pipeline statistics query per command list, a list uses the query at the index of its timestamp pair
+		void CreateGraphicsPipelineStats(uint32_t listCount);
 		// CreateComputePipelineStats();
 
 		// Timestamps are buffer bound
@@ -65,7 +67,7 @@ namespace LambdaEngine
 
 		void StartGraphicsPipelineStat(CommandList* pCommandList);
 		void EndGraphicsPipelineStat(CommandList* pCommandList);
-		void GetGraphicsPipelineStat();
+		void GetGraphicsPipelineStat(CommandList* pCommandList);
 		void ResetGraphicsPipelineStat(CommandList* pCommandList);
 
 		uint64 GetAverageDeviceMemory() const;
@@ -77,6 +79,10 @@ namespace LambdaEngine
 	private:
 		std::string GetTimeUnitName() const;
 
+		// Command lists must be added with AddTimestamp before recording starts, unknown lists return false.
+		// The end timestamp is always at startIndex + 1
+		bool FindTimestampIndex(CommandList* pCommandList, uint32& startIndex);
+
 	private:
 		// Timestamps
 		QueryHeap* m_pTimestampHeap = nullptr;
@@ -97,6 +103,7 @@ namespace LambdaEngine
 		bool m_EnableGraph				= true;
 
 		THashTable<CommandList*, bool> m_ShouldGetTimestamps;
+		SpinLock m_TimestampSpinlock; // The render graph may record pipeline stages on several threads
 
 		// Memory usage
 		TArray<GraphicsDeviceMemoryStatistics> m_MemoryStats;
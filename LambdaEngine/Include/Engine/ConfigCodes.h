@@ -37,6 +37,11 @@ namespace LambdaEngine
 		CONFIG_OPTION_RAY_TRACED_SHADOWS		= 23,
 		CONFIG_OPTION_VOLUME_MUSIC				= 24,
 		CONFIG_OPTION_AA						= 25,
+		CONFIG_OPTION_CPU_PARTICLES				= 26,
+		CONFIG_OPTION_PHYSICS_WORKER_COUNT		= 27,
+		CONFIG_OPTION_PHYSICS_TICK_RATE			= 28,
+		CONFIG_OPTION_PHYSICS_INTERPOLATION		= 29,
+		CONFIG_OPTION_PARALLEL_RECORDING		= 30,
 	};
 
 	/*
@@ -67,6 +72,11 @@ namespace LambdaEngine
 			case CONFIG_OPTION_NETWORK_PING_SYSTEM:			return "CONFIG_OPTION_NETWORK_PING_SYSTEM";
 			case CONFIG_OPTION_INLINE_RAY_TRACING:			return "CONFIG_OPTION_INLINE_RAY_TRACING";
 			case CONFIG_OPTION_AA:							return "CONFIG_OPTION_AA";
+			case CONFIG_OPTION_CPU_PARTICLES:				return "CONFIG_OPTION_CPU_PARTICLES";
+			case CONFIG_OPTION_PHYSICS_WORKER_COUNT:		return "CONFIG_OPTION_PHYSICS_WORKER_COUNT";
+			case CONFIG_OPTION_PHYSICS_TICK_RATE:			return "CONFIG_OPTION_PHYSICS_TICK_RATE";
+			case CONFIG_OPTION_PHYSICS_INTERPOLATION:		return "CONFIG_OPTION_PHYSICS_INTERPOLATION";
+			case CONFIG_OPTION_PARALLEL_RECORDING:			return "CONFIG_OPTION_PARALLEL_RECORDING";
 			case CONFIG_OPTION_GLOSSY_REFLECTIONS:			return "CONFIG_OPTION_GLOSSY_REFLECTIONS";
 			case CONFIG_OPTION_RAY_TRACED_SHADOWS:			return "CONFIG_OPTION_RAY_TRACED_SHADOWS";
 			case CONFIG_OPTION_REFLECTIONS_SPP:				return "CONFIG_OPTION_REFLECTIONS_SPP";
@@ -103,6 +113,11 @@ namespace LambdaEngine
 			{"CONFIG_OPTION_RAY_TRACED_SHADOWS",		EConfigOption::CONFIG_OPTION_RAY_TRACED_SHADOWS},
 			{"CONFIG_OPTION_REFLECTIONS_SPP",			EConfigOption::CONFIG_OPTION_REFLECTIONS_SPP},
 			{"CONFIG_OPTION_VOLUME_MUSIC",				EConfigOption::CONFIG_OPTION_VOLUME_MUSIC},
+			{"CONFIG_OPTION_CPU_PARTICLES",				EConfigOption::CONFIG_OPTION_CPU_PARTICLES},
+			{"CONFIG_OPTION_PHYSICS_WORKER_COUNT",		EConfigOption::CONFIG_OPTION_PHYSICS_WORKER_COUNT},
+			{"CONFIG_OPTION_PHYSICS_TICK_RATE",			EConfigOption::CONFIG_OPTION_PHYSICS_TICK_RATE},
+			{"CONFIG_OPTION_PHYSICS_INTERPOLATION",		EConfigOption::CONFIG_OPTION_PHYSICS_INTERPOLATION},
+			{"CONFIG_OPTION_PARALLEL_RECORDING",		EConfigOption::CONFIG_OPTION_PARALLEL_RECORDING},
 		};
 
 		auto itr = configMap.find(str);
@@ -1,6 +1,7 @@
 #pragma once
 #include "Rendering/CustomRenderer.h"
 #include "Rendering/RenderGraphTypes.h"
+#include "Rendering/StagingBufferCache.h"
 
 #include "Rendering/Core/API/CommandList.h"
 
@@ -162,8 +163,8 @@ namespace LambdaEngine
 		GUIRenderTarget* m_pCurrentRenderTarget = nullptr;
 		Sampler* m_pGUISampler = nullptr;
 
-		Buffer* m_pVertexStagingBuffer		= nullptr;
-		Buffer* m_pIndexStagingBuffer		= nullptr;
+		StagingBufferAllocation m_VertexStagingAllocation;
+		StagingBufferAllocation m_IndexStagingAllocation;
 		uint64	m_RequiredVertexBufferSize	= 0;
 		uint64	m_RequiredIndexBufferSize	= 0;
 
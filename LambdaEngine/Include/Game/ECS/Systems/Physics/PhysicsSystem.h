@@ -5,6 +5,7 @@
 #include "Game/ECS/Components/Physics/Collision.h"
 #include "Game/ECS/Components/Physics/Transform.h"
 #include "Math/Math.h"
+#include "Physics/PhysX/CpuDispatcher.h"
 #include "Physics/PhysX/ErrorCallback.h"
 #include "Physics/PhysX/PhysX.h"
 #include "Physics/PhysX/RaycastQueryFilterCallback.h"
@@ -150,6 +151,7 @@ namespace LambdaEngine
 		CollisionGroup IncludedGroup;
 		CollisionGroup ExcludedGroup;
 		Entity ExcludedEntity = UINT32_MAX;
+		bool IgnoreTriggers = false;		// Trigger shapes, like kill planes, are never hit
 	};
 
 	struct OverlapQueryInfo
@@ -168,8 +170,30 @@ namespace LambdaEngine
 		const QueryFilterData* pFilterData;
 	};
 
+	struct SweepQueryInfo
+	{
+		EGeometryType GeometryType;
+		GeometryParameters GeometryParams;
+		glm::vec3 Position;
+		glm::quat Rotation;
+		glm::vec3 Direction;
+		float32 MaxDistance;
+		const QueryFilterData* pFilterData;
+	};
+
+	class SceneQueryBatch;
+
 	class PhysicsSystem : public System, public ComponentOwner, public PxSimulationEventCallback
 	{
+		// InterpolatedActor holds the poses of an actor after the two latest fixed steps
+		struct InterpolatedActor
+		{
+			glm::vec3 PreviousPosition;
+			glm::quat PreviousRotation;
+			glm::vec3 CurrentPosition;
+			glm::quat CurrentRotation;
+		};
+
 	public:
 		PhysicsSystem();
 		~PhysicsSystem();
@@ -185,6 +209,8 @@ namespace LambdaEngine
 
 		/* Dynamic collision actors */
 		DynamicCollisionComponent CreateDynamicActor(const DynamicCollisionCreateInfo& collisionInfo);
+		// ReleaseDynamicActor removes and releases an actor that was added to the scene without an entity
+		void ReleaseDynamicActor(DynamicCollisionComponent& collisionComponent);
 
 		/* Character controllers */
 		// CreateCharacterCapsule creates a character collider capsule. Total height is height + radius * 2 (+ contactOffset * 2)
@@ -218,6 +244,13 @@ namespace LambdaEngine
 		*/
 		bool QueryOverlap(const OverlapQueryInfo& overlapInfo, PxOverlapBuffer& overlaps, const QueryFilterData* pFilterData = nullptr);
 
+		/**
+		 * Runs every query in the batch in one pass, split into jobs on the thread pool when the batch is large.
+		 * Like the single queries, this must not overlap with the simulation.
+		 * @param queryBatch Queries to run, their hits are written to the batch
+		*/
+		void ExecuteQueryBatch(SceneQueryBatch& queryBatch);
+
 		/* Implement PxSimulationEventCallback */
 		void onContact(const PxContactPairHeader& pairHeader, const PxContactPair* pPairs, PxU32 nbPairs) override final;
 		void onTrigger(PxTriggerPair* pTriggerPairs, PxU32 nbPairs) override final;
@@ -247,6 +280,22 @@ namespace LambdaEngine
 
 		bool RaycastInternal(const RaycastInfo& raycastInfo, PxRaycastBuffer& raycastBuffer, PxQueryFlags queryFlags);
 
+		// CreateQueryGeometry creates the geometry and transform of an overlap or sweep
+		PxGeometryHolder CreateQueryGeometry(
+			EGeometryType geometryType,
+			const GeometryParameters& geometryParams,
+			const glm::vec3& position,
+			const glm::quat& rotation,
+			PxTransform& transform) const;
+
+		void ExecuteQuery(SceneQueryBatch& queryBatch, uint32 queryIndex);
+
+		void Simulate(float32 deltaTime);
+
+		// WriteBackActiveActors copies the results of the latest step to the components of the actors that moved during it
+		void WriteBackActiveActors();
+		void WriteInterpolatedActors(float32 alpha);
+
 		static void StaticCollisionDestructor(StaticCollisionComponent& collisionComponent, Entity entity);
 		static void DynamicCollisionDestructor(DynamicCollisionComponent& collisionComponent, Entity entity);
 		static void CharacterColliderDestructor(CharacterColliderComponent& characterColliderComponent, Entity entity);
@@ -282,6 +331,12 @@ namespace LambdaEngine
 			const TArray<PxContactPairPoint>& contactPoints) const;
 
 	private:
+		// More steps than this in one tick drops the remaining time, so a slow frame does not cause even slower frames
+		static constexpr const uint32 MAX_FIXED_STEPS_PER_TICK = 4;
+
+		// Batches with more queries than this are split into jobs
+		static constexpr const uint32 QUERIES_PER_JOB = 64;
+
 		static PhysicsSystem s_Instance;
 
 	private:
@@ -298,9 +353,15 @@ namespace LambdaEngine
 		PxControllerManager*	m_pControllerManager;
 		PxPvd*					m_pVisDbg; // Visual debugger
 
-		PxDefaultCpuDispatcher*	m_pDispatcher;
+		PhysXCpuDispatcher		m_Dispatcher;
 		PxScene*				m_pScene;
 
+		// Fixed step mode, a timestep of zero steps the scene once per tick with the frame's delta time
+		float64	m_FixedTimestep			= 0.0;
+		float64	m_Accumulator			= 0.0;
+		bool	m_InterpolateFixedSteps	= false;
+		THashTable<Entity, InterpolatedActor> m_InterpolatedActors;
+
 		PxMaterial* m_pDefaultMaterial;
 
 		QueryFilterCallback m_QueryFilterCallback;
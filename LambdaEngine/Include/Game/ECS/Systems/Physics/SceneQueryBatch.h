@@ -0,0 +1,101 @@
+#pragma once
+
+#include "Game/ECS/Systems/Physics/PhysicsSystem.h"
+
+namespace LambdaEngine
+{
+	enum class ESceneQueryType : uint8
+	{
+		RAYCAST				= 0,	// Closest hit
+		RAYCAST_MULTIPLE	= 1,	// Every hit, up to the query's max hit count
+		SWEEP				= 2,	// Closest hit
+		OVERLAP				= 3		// Every overlap, up to the query's max hit count
+	};
+
+	/*
+	* SceneQueryBatch - Collects raycasts, sweeps and overlaps issued during a tick so that PhysicsSystem::ExecuteQueryBatch
+	* runs all of them in one pass, split into jobs on the thread pool. Each query is given a fixed range of hits when it
+	* is added, so the jobs write their results without synchronizing. Filter data is copied when a query is added.
+	*/
+	class LAMBDA_API SceneQueryBatch
+	{
+		friend class PhysicsSystem;
+
+		struct SceneQuery
+		{
+			ESceneQueryType		Type;
+			QueryFilterData		FilterData;
+			EGeometryType		GeometryType;
+			GeometryParameters	GeometryParams;
+			glm::vec3			Position;
+			glm::quat			Rotation;
+			glm::vec3			Direction;
+			float32				MaxDistance;
+			uint32				FirstHit;
+			uint32				MaxHitCount;
+			uint32				HitCount;
+		};
+
+	public:
+		SceneQueryBatch() = default;
+		~SceneQueryBatch() = default;
+
+		/*
+		* Removes every query, the memory is kept for the next batch
+		*/
+		void Reset();
+
+		/**
+		* @param multipleHits	If true, up to maxHitCount hits along the ray are returned instead of the closest one
+		* @return Index of the query, used to read its hits after the batch is executed
+		*/
+		uint32 AddRaycast(const RaycastInfo& raycastInfo, bool multipleHits = false, uint32 maxHitCount = DEFAULT_MAX_HIT_COUNT);
+		uint32 AddSweep(const SweepQueryInfo& sweepInfo);
+		uint32 AddOverlap(const OverlapQueryInfo& overlapInfo, const QueryFilterData* pFilterData = nullptr, uint32 maxHitCount = DEFAULT_MAX_HIT_COUNT);
+
+		FORCEINLINE uint32 GetQueryCount() const
+		{
+			return m_Queries.GetSize();
+		}
+
+		FORCEINLINE const glm::vec3& GetDirection(uint32 queryIndex) const
+		{
+			return m_Queries[queryIndex].Direction;
+		}
+
+		FORCEINLINE uint32 GetHitCount(uint32 queryIndex) const
+		{
+			return m_Queries[queryIndex].HitCount;
+		}
+
+		FORCEINLINE const PxRaycastHit& GetRaycastHit(uint32 queryIndex, uint32 hitIndex) const
+		{
+			VALIDATE(hitIndex < m_Queries[queryIndex].HitCount);
+			return m_RaycastHits[m_Queries[queryIndex].FirstHit + hitIndex];
+		}
+
+		FORCEINLINE const PxSweepHit& GetSweepHit(uint32 queryIndex) const
+		{
+			VALIDATE(m_Queries[queryIndex].HitCount > 0);
+			return m_SweepHits[m_Queries[queryIndex].FirstHit];
+		}
+
+		FORCEINLINE const PxOverlapHit& GetOverlapHit(uint32 queryIndex, uint32 hitIndex) const
+		{
+			VALIDATE(hitIndex < m_Queries[queryIndex].HitCount);
+			return m_OverlapHits[m_Queries[queryIndex].FirstHit + hitIndex];
+		}
+
+	public:
+		static constexpr const uint32 DEFAULT_MAX_HIT_COUNT = 16;
+
+	private:
+		static QueryFilterData GetFilterData(const QueryFilterData* pFilterData);
+
+	private:
+		TArray<SceneQuery>		m_Queries;
+		TArray<PxRaycastHit>	m_RaycastHits;
+		TArray<PxSweepHit>		m_SweepHits;
+		TArray<PxOverlapHit>	m_OverlapHits;
+	};
+}
@@ -182,8 +182,9 @@ namespace LambdaEngine
 			uint32	DrawArgsMask			= 0x0;
 
 			Buffer* pRasterInstanceBuffer				= nullptr;
-			Buffer* ppRasterInstanceStagingBuffers[BACK_BUFFER_COUNT];
 			TArray<Instance> RasterInstances;
+			// One bit per raster instance, set when the instance has changed since the last upload
+			TArray<uint64> DirtyInstanceMask;
 
 			TArray<Entity> EntityIDs;
 
@@ -197,6 +198,12 @@ namespace LambdaEngine
 			uint32	InstanceIndex = 0;
 		};
 
+		struct InstanceLocation
+		{
+			MeshEntry*	pMeshEntry		= nullptr;
+			uint32		InstanceIndex	= UINT32_MAX;
+		};
+
 		struct PendingBufferUpdate
 		{
 			Buffer* pSrcBuffer	= nullptr;
@@ -356,10 +363,12 @@ namespace LambdaEngine
 		void SetPaintMaskColor(uint32 index, const glm::vec3& color);
 
 		RenderGraph*	GetRenderGraph()					{ return m_pRenderGraph;			}
+		ParticleManager& GetParticleManager()				{ return m_ParticleManager;			}
 		uint64			GetFrameIndex() const	 			{ return m_FrameIndex;				}
 		uint64			GetModFrameIndex() const			{ return m_ModFrameIndex;			}
 		uint32			GetBufferIndex() const	 			{ return m_BackBufferIndex;			}
 		bool			IsInlineRayTracingEnabled() const	{ return m_InlineRayTracingEnabled; }
+		uint64			GetInstanceUploadBytes() const		{ return m_InstanceUploadBytesLastFrame; }
 
 	public:
 		static RenderSystem& GetInstance() { return s_Instance; }
@@ -426,7 +435,7 @@ namespace LambdaEngine
 
 		void DeleteDeviceResource(DeviceChild* pDeviceResource);
 		void CleanBuffers();
-		void CreateDrawArgs(TArray<DrawArg>& drawArgs, const DrawArgMaskDesc& requestedMaskDesc) const;
+		void CreateDrawArgs(TFrameArray<DrawArg>& drawArgs, const DrawArgMaskDesc& requestedMaskDesc) const;
 		void WriteDrawArgExtensionData(MeshEntry& meshEntry);
 
 		void UpdateBuffers();
@@ -435,6 +444,9 @@ namespace LambdaEngine
 		void ExecutePendingBufferUpdates(CommandList* pCommandList);
 		void UpdatePerFrameBuffer(CommandList* pCommandList);
 		void UpdateRasterInstanceBuffers(CommandList* pCommandList);
+		void MarkRasterInstanceDirty(MeshEntry& meshEntry, uint32 instanceIndex);
+		void SetInstanceLocation(Entity entity, MeshEntry* pMeshEntry, uint32 instanceIndex);
+		void* AllocateInstanceUpload(uint64 sizeInBytes, uint64& offset);
 		void UpdateMaterialPropertiesBuffer(CommandList* pCommandList);
 		void UpdateLightsBuffer(CommandList* pCommandList);
 		void UpdatePointLightTextureResource(CommandList* pCommandList);
@@ -498,6 +510,8 @@ namespace LambdaEngine
 		MeshAndInstancesMap				m_MeshAndInstancesMap;
 		MaterialMap						m_MaterialMap;
 		THashTable<Entity, InstanceKey> m_EntityIDsToInstanceKey;
+		// Flat Entity -> (MeshEntry, InstanceIndex) lookup used by hot paths such as UpdateTransformData
+		TArray<InstanceLocation>		m_EntityInstanceLocations;
 
 		// PAINT_MASK_TEXTURES
 		TArray<Texture*>					m_PaintMaskTextures;
@@ -527,6 +541,12 @@ namespace LambdaEngine
 		Buffer* m_ppPaintMaskColorStagingBuffers[BACK_BUFFER_COUNT];
 		Buffer*	m_pPaintMaskColorBuffer 					= nullptr;
 
+		// Persistently mapped per-frame upload buffers for raster instances, linearly allocated each frame
+		Buffer*	m_ppInstanceUploadBuffers[BACK_BUFFER_COUNT]	= { nullptr };
+		byte*	m_ppInstanceUploadMemory[BACK_BUFFER_COUNT]		= { nullptr };
+		uint64	m_InstanceUploadOffset							= 0;
+		uint64	m_InstanceUploadBytesLastFrame					= 0;
+
 		// Draw Args
 		TSet<DrawArgMaskDesc> m_RequiredDrawArgs;
 
@@ -43,6 +43,16 @@ namespace LambdaEngine
 		LOG_ERROR   = 3  //Red
 	};
 
+	/*
+	* LogStats - Counters of the asynchronous output, see Log::StartAsync
+	*/
+	struct LogStats
+	{
+		uint64	WrittenMessageCount	= 0;	// Messages that the log thread has written
+		uint64	DroppedMessageCount	= 0;	// Messages that were dropped because the ring of their thread was full
+		uint32	RingCount			= 0;	// Rings that have been created, one per thread that has logged
+	};
+
 	/*
 	* Log
 	*/
@@ -83,6 +93,47 @@ namespace LambdaEngine
 			s_DebuggerOutputEnabled = enable;
 		}
 
+		/**
+		* Starts the log thread. Until StopAsync is called Print only copies the file name, the format and the arguments
+		* of a message into a ring owned by the calling thread, the log thread formats the messages and writes them to
+		* the console and the log file. Messages are dropped and counted when the ring of a thread is full. Critical errors
+		* and messages too large for a ring are still printed on the calling thread, after the rings have been flushed
+		*
+		* @param pLogFilePath	File that every message is written to as well, no file is written if nullptr
+		* @return True if the log thread was started
+		*/
+		static bool StartAsync(const char* pLogFilePath);
+
+		/*
+		* Stops the log thread and writes the messages left in the rings on the calling thread. The threads that log
+		* must have stopped, the rings are freed
+		*/
+		static void StopAsync();
+
+		/*
+		* Blocks until the log thread has written every message that was logged before the call
+		*/
+		static void Flush();
+
+		/**
+		* Lets the log thread be bypassed without stopping it, messages are printed on the calling thread while disabled
+		*
+		* @param enable True if messages should be written by the log thread, has no effect if it is not running
+		*/
+		static void SetAsyncOutputEnabled(bool enable);
+
+		/*
+		* Prints a line to the console under the output lock, so it is not interleaved with the messages of the log
+		* thread. Used by the assert handlers, the lock is not taken again if the calling thread already holds it
+		*/
+		static void PrintAssertLine(const char* pFormat, ...);
+
+		static LogStats GetAsyncStats();
+
+	private:
+		static bool PrintAsync(const char* pFileName, uint32 lineNr, ELogSeverity severity, const char* pFormat, va_list vaArgs);
+		static void RunLogThread();
+
 	private:
 		static bool s_DebuggerOutputEnabled;
 	};
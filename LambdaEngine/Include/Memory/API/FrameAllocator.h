@@ -0,0 +1,98 @@
+#pragma once
+#include "Types.h"
+#include "Defines.h"
+
+namespace LambdaEngine
+{
+	/*
+	* FrameAllocatorStats - Counters of the calling thread's frame allocator
+	*/
+
+	struct FrameAllocatorStats
+	{
+		uint64	AllocationCount		= 0;	// Allocations made since the thread started
+		uint64	FrameBytesAllocated	= 0;	// Bytes handed out in the current frame, including alignment padding
+		uint64	BlockCount			= 0;	// Blocks owned by the thread, every block is one call to Malloc
+		uint64	BlockBytes			= 0;
+	};
+
+	/*
+	* FrameAllocator - Per thread linear allocator for temporary memory. Allocating bumps an offset in a block owned by
+	* the calling thread and Free does nothing. Each thread keeps the blocks of two frames, the first time a thread
+	* allocates in a new frame it reuses the blocks of the frame before the last one. Memory allocated during a frame
+	* is therefore valid until the end of the next frame, which covers jobs that finish a frame after they were started.
+	* Blocks are kept between frames, so a thread stops calling Malloc once it has reached its peak usage.
+	* Has the same interface as Malloc so that it can be used as the allocator of TArray, see TFrameArray.
+	*/
+
+	class LAMBDA_API FrameAllocator
+	{
+	public:
+		DECL_STATIC_CLASS(FrameAllocator);
+
+		static void* Allocate(uint64 sizeInBytes);
+		static void* Allocate(uint64 sizeInBytes, uint64 alignment);
+
+		FORCEINLINE static void Free(void* pPtr)
+		{
+			UNREFERENCED_VARIABLE(pPtr);
+		}
+
+		/*
+		* Ends the frame of every thread, called by the EngineLoop once per frame
+		*/
+		static void EndFrame();
+
+		/*
+		* Frees the blocks of the calling thread, none of its frame memory may be in use
+		*/
+		static void ReleaseThreadBlocks();
+
+		static FrameAllocatorStats GetThreadStats();
+		static uint64 GetFrameIndex();
+
+	public:
+		static constexpr const uint64 BLOCK_SIZE = 64 * 1024;
+	};
+
+	/*
+	* TFrameStdAllocator - Lets standard containers allocate from the FrameAllocator, see TFrameHashTable and FrameString
+	*/
+
+	template<typename T>
+	class TFrameStdAllocator
+	{
+	public:
+		using value_type = T;
+
+		TFrameStdAllocator() noexcept = default;
+
+		template<typename U>
+		FORCEINLINE TFrameStdAllocator(const TFrameStdAllocator<U>&) noexcept
+		{
+		}
+
+		FORCEINLINE T* allocate(size_t count)
+		{
+			return reinterpret_cast<T*>(FrameAllocator::Allocate(count * sizeof(T), alignof(T)));
+		}
+
+		FORCEINLINE void deallocate(T* pPtr, size_t count) noexcept
+		{
+			UNREFERENCED_VARIABLE(count);
+			FrameAllocator::Free(pPtr);
+		}
+
+		template<typename U>
+		FORCEINLINE bool operator==(const TFrameStdAllocator<U>&) const noexcept
+		{
+			return true;
+		}
+
+		template<typename U>
+		FORCEINLINE bool operator!=(const TFrameStdAllocator<U>&) const noexcept
+		{
+			return false;
+		}
+	};
+}
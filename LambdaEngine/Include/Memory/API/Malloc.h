@@ -58,6 +58,11 @@ namespace LambdaEngine
 
 		static void SetDebugFlags(uint16 debugFlags);
 
+		/*
+		* Number of allocations made by the calling thread since it started, used to check that code does not allocate
+		*/
+		static uint64 GetThreadAllocationCount();
+
 	private:
 		static void* AllocateProtected(uint64 sizeInBytes);
 		static void* AlignAddress(void* pAddress, uint64 alignment);
@@ -0,0 +1,148 @@
+#pragma once
+#include "LambdaEngine.h"
+
+#include "Containers/TArray.h"
+
+/*
+* Validates the whole block list after every change made by the users of OffsetAllocator, which is O(n) per call
+*/
+#define OFFSET_ALLOCATOR_VALIDATION_ENABLED 0
+
+#if OFFSET_ALLOCATOR_VALIDATION_ENABLED
+	#define VALIDATE_OFFSET_ALLOCATOR(allocator) VALIDATE((allocator).Validate())
+#else
+	#define VALIDATE_OFFSET_ALLOCATOR(allocator)
+#endif
+
+namespace LambdaEngine
+{
+	struct OffsetAllocation
+	{
+		uint64	Offset		= 0;
+		uint64	SizeInBytes	= 0;
+		uint32	NodeIndex	= UINT32_MAX;
+
+		FORCEINLINE bool IsValid() const
+		{
+			return NodeIndex != UINT32_MAX;
+		}
+	};
+
+	struct OffsetAllocatorStatistics
+	{
+		uint64	SizeInBytes			= 0;
+		uint64	UsedBytes			= 0;
+		uint64	FreeBytes			= 0;
+		uint64	LargestFreeBlock	= 0;
+		uint32	AllocationCount		= 0;
+		uint32	FreeBlockCount		= 0;
+		float32	Fragmentation		= 0.0f;	// Zero when all free memory is one block, approaches one as it is split into small blocks
+	};
+
+	/*
+	* OffsetAllocator - Two-level segregated fit (TLSF) allocator over an abstract range of offsets. It never touches
+	* the memory it manages, so it can sub-allocate device memory, buffers or CPU memory alike. Allocate and Free are
+	* O(1) and free blocks are merged with their neighbours immediately.
+	*
+	* Allocations can carry a granularity class. Two neighbouring allocations with different classes never share a
+	* granularity page, which is what Vulkan requires for linear and optimal resources (bufferImageGranularity).
+	*/
+	class LAMBDA_API OffsetAllocator
+	{
+		struct Node
+		{
+			uint64	Offset				= 0;
+			uint64	SizeInBytes			= 0;
+			uint32	PrevPhysical		= INVALID_NODE;
+			uint32	NextPhysical		= INVALID_NODE;
+			uint32	PrevFree			= INVALID_NODE;
+			uint32	NextFree			= INVALID_NODE;
+			uint32	GranularityClass	= 0;
+			bool	IsFree				= false;
+		};
+
+	public:
+		DECL_REMOVE_COPY(OffsetAllocator);
+		DECL_REMOVE_MOVE(OffsetAllocator);
+
+		OffsetAllocator() = default;
+		~OffsetAllocator() = default;
+
+		/**
+		* Initializes the allocator with a single free block, all previous allocations are discarded
+		* @param sizeInBytes	Size of the range
+		* @param granularity	Page size that allocations with different granularity classes may not share, must be a power of two
+		*/
+		void Init(uint64 sizeInBytes, uint64 granularity = 1);
+		void Reset();
+
+		/**
+		* Allocates a range
+		* @param sizeInBytes		Size of the allocation, must be larger than zero
+		* @param alignment			Alignment of the offset, must be a power of two
+		* @param allocation			Receives the allocation, invalid if the allocation failed
+		* @param granularityClass	Class of the allocation, must be less than 32
+		* @return True if the allocation succeeded
+		*/
+		bool Allocate(uint64 sizeInBytes, uint64 alignment, OffsetAllocation& allocation, uint32 granularityClass = 0);
+		void Free(OffsetAllocation& allocation);
+
+		OffsetAllocatorStatistics GetStatistics() const;
+
+		/*
+		* Walks all blocks and checks that the block list and the free lists are consistent, only meant for debugging.
+		* Use VALIDATE_OFFSET_ALLOCATOR to keep it out of builds without OFFSET_ALLOCATOR_VALIDATION_ENABLED
+		*/
+		bool Validate() const;
+
+		FORCEINLINE bool IsEmpty() const
+		{
+			return m_AllocationCount == 0;
+		}
+
+		FORCEINLINE uint64 GetSizeInBytes() const
+		{
+			return m_SizeInBytes;
+		}
+
+		FORCEINLINE uint64 GetFreeBytes() const
+		{
+			return m_FreeBytes;
+		}
+
+	public:
+		static constexpr const uint32 INVALID_NODE			= UINT32_MAX;
+		static constexpr const uint32 SECOND_LEVEL_BITS		= 5;
+		static constexpr const uint32 SECOND_LEVEL_COUNT	= 1 << SECOND_LEVEL_BITS;
+		static constexpr const uint32 FIRST_LEVEL_COUNT		= 64 - SECOND_LEVEL_BITS + 1;
+
+	private:
+		static void MapSize(uint64 sizeInBytes, uint32& firstLevel, uint32& secondLevel);
+		static bool MapSizeRoundUp(uint64 sizeInBytes, uint32& firstLevel, uint32& secondLevel);
+
+		uint32 FindFreeNode(uint64 sizeInBytes) const;
+		bool CalculatePlacement(uint32 nodeIndex, uint64 sizeInBytes, uint64 alignment, uint32 granularityClass, bool checkGranularity, uint64& offset) const;
+		void InsertFreeNode(uint32 nodeIndex);
+		void RemoveFreeNode(uint32 nodeIndex);
+
+		uint32 AcquireNode();
+		void ReleaseNode(uint32 nodeIndex);
+
+		bool SharesGranularityPage(uint64 endOffset, uint64 startOffset) const;
+
+	private:
+		TArray<Node>	m_Nodes;
+		TArray<uint32>	m_UnusedNodes;
+
+		uint32	m_FreeHeads[FIRST_LEVEL_COUNT][SECOND_LEVEL_COUNT];
+		uint32	m_SecondLevelBitmaps[FIRST_LEVEL_COUNT];
+		uint64	m_FirstLevelBitmap		= 0;
+
+		uint64	m_SizeInBytes			= 0;
+		uint64	m_FreeBytes				= 0;
+		uint64	m_Granularity			= 1;
+		uint32	m_AllocationCount		= 0;
+		uint32	m_FreeBlockCount		= 0;
+		uint32	m_GranularityClassMask	= 0;
+	};
+}
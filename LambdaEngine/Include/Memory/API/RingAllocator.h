@@ -0,0 +1,77 @@
+#pragma once
+#include "LambdaEngine.h"
+
+#include "Containers/TArray.h"
+
+namespace LambdaEngine
+{
+	/*
+	* RingAllocator - Linear allocator over an abstract range of offsets that wraps around. Allocations are never
+	* freed one by one, instead all allocations made between two calls to EndFrame are tagged with a fence value
+	* and reclaimed together once that fence value has completed. Like OffsetAllocator it never touches the memory
+	* it manages, so it can be used for mapped buffers as well as CPU memory.
+	*/
+	class LAMBDA_API RingAllocator
+	{
+		struct FrameMarker
+		{
+			uint64	FenceValue	= 0;
+			uint64	EndOffset	= 0;
+			uint64	UsedBytes	= 0;	// Includes alignment padding and the space skipped when wrapping
+		};
+
+	public:
+		DECL_REMOVE_COPY(RingAllocator);
+		DECL_REMOVE_MOVE(RingAllocator);
+
+		RingAllocator() = default;
+		~RingAllocator() = default;
+
+		void Init(uint64 sizeInBytes);
+		void Reset();
+
+		/**
+		* Allocates a contiguous range, an allocation never straddles the end of the ring
+		* @param sizeInBytes	Size of the allocation, must be larger than zero
+		* @param alignment		Alignment of the offset, must be a power of two
+		* @param offset			Receives the offset of the allocation
+		* @return False if the ring has no room left before the oldest in-flight frame
+		*/
+		bool Allocate(uint64 sizeInBytes, uint64 alignment, uint64& offset);
+
+		/*
+		* Tags all allocations made since the last call with fenceValue, fence values must be increasing
+		*/
+		void EndFrame(uint64 fenceValue);
+
+		/*
+		* Reclaims the memory of every frame with a fence value less than or equal to completedFenceValue
+		*/
+		void Reclaim(uint64 completedFenceValue);
+
+		FORCEINLINE uint64 GetSizeInBytes() const
+		{
+			return m_SizeInBytes;
+		}
+
+		FORCEINLINE uint64 GetUsedBytes() const
+		{
+			return m_UsedBytes;
+		}
+
+		FORCEINLINE uint32 GetInFlightFrameCount() const
+		{
+			return m_Frames.GetSize() - m_FirstFrame;
+		}
+
+	private:
+		TArray<FrameMarker>	m_Frames;
+		uint32				m_FirstFrame		= 0;
+
+		uint64	m_SizeInBytes		= 0;
+		uint64	m_Head				= 0;
+		uint64	m_Tail				= 0;
+		uint64	m_UsedBytes			= 0;
+		uint64	m_FrameUsedBytes	= 0;
+	};
+}
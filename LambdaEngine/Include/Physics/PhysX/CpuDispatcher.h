@@ -0,0 +1,134 @@
+#pragma once
+#include "Physics/PhysX/PhysX.h"
+
+#include "Threading/API/SpinLock.h"
+#include "Threading/API/ThreadPool.h"
+
+#include <atomic>
+#include <queue>
+
+namespace LambdaEngine
+{
+	/*
+	* PhysXCpuDispatcher - Runs the tasks of the PhysX simulation as jobs on the engine's ThreadPool instead of on threads
+	* owned by PhysX. Tasks are queued and at most workerCount pool jobs drain the queue at the same time, so physics
+	* shares the cores with the rest of the engine instead of oversubscribing them. The thread waiting for the simulation
+	* should call RunQueuedTasks, which also keeps the simulation going when every pool thread is busy.
+	*/
+	class PhysXCpuDispatcher : public physx::PxCpuDispatcher
+	{
+	public:
+		DECL_UNIQUE_CLASS(PhysXCpuDispatcher);
+
+		PhysXCpuDispatcher() = default;
+
+		~PhysXCpuDispatcher()
+		{
+			// Pool jobs reference the dispatcher until they leave the worker loop
+			while (m_ActiveWorkerCount.load(std::memory_order_acquire) > 0)
+			{
+				std::this_thread::yield();
+			}
+		}
+
+		/**
+		* @param workerCount	Maximum number of pool jobs running tasks at the same time, 0 runs tasks on the submitting thread
+		*/
+		FORCEINLINE void Init(uint32 workerCount)
+		{
+			m_WorkerCount = workerCount;
+		}
+
+		virtual void submitTask(physx::PxBaseTask& task) override final
+		{
+			if (m_WorkerCount == 0)
+			{
+				task.run();
+				task.release();
+				return;
+			}
+
+			bool startWorker = false;
+			{
+				std::scoped_lock<SpinLock> lock(m_TaskLock);
+				m_Tasks.push(&task);
+
+				if (m_ActiveWorkerCount.load(std::memory_order_relaxed) < m_WorkerCount)
+				{
+					m_ActiveWorkerCount.fetch_add(1, std::memory_order_relaxed);
+					startWorker = true;
+				}
+			}
+
+			if (startWorker)
+			{
+				ThreadPool::ExecuteDetached([this]() { WorkerLoop(); });
+			}
+		}
+
+		virtual uint32_t getWorkerCount() const override final
+		{
+			return m_WorkerCount;
+		}
+
+		/*
+		* Runs queued tasks on the calling thread until the queue is empty
+		* @return True if any task was run
+		*/
+		bool RunQueuedTasks()
+		{
+			bool ranTask = false;
+			while (physx::PxBaseTask* pTask = PopTask())
+			{
+				pTask->run();
+				pTask->release();
+				ranTask = true;
+			}
+
+			return ranTask;
+		}
+
+	private:
+		physx::PxBaseTask* PopTask()
+		{
+			std::scoped_lock<SpinLock> lock(m_TaskLock);
+			if (m_Tasks.empty())
+			{
+				return nullptr;
+			}
+
+			physx::PxBaseTask* pTask = m_Tasks.front();
+			m_Tasks.pop();
+			return pTask;
+		}
+
+		void WorkerLoop()
+		{
+			while (true)
+			{
+				physx::PxBaseTask* pTask = nullptr;
+				{
+					// The worker retires under the lock so that submitTask starts a new one if a task is queued after this
+					std::scoped_lock<SpinLock> lock(m_TaskLock);
+					if (m_Tasks.empty())
+					{
+						m_ActiveWorkerCount.fetch_sub(1, std::memory_order_release);
+						return;
+					}
+
+					pTask = m_Tasks.front();
+					m_Tasks.pop();
+				}
+
+				pTask->run();
+				pTask->release();
+			}
+		}
+
+	private:
+		SpinLock						m_TaskLock;
+		std::queue<physx::PxBaseTask*>	m_Tasks;
+		std::atomic_uint32_t			m_ActiveWorkerCount	= 0;
+		uint32							m_WorkerCount		= 0;
+	};
+}
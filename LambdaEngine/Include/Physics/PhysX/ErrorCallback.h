@@ -29,7 +29,7 @@ namespace LambdaEngine
 					break;
 			}
 
-			LOG(pFile, lineNr, severity, pMessage);
+			LOG(pFile, lineNr, severity, "%s", pMessage);
 		}
 	};
 };
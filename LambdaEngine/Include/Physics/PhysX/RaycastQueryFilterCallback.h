@@ -19,6 +19,12 @@ namespace LambdaEngine
 
 			using namespace physx;
 
+			// word3 of the query rejects trigger shapes
+			if (filterData.word3 != 0 && pShape->getFlags().isSet(PxShapeFlag::eTRIGGER_SHAPE))
+			{
+				return PxQueryHitType::eNONE;
+			}
+
 			const PxFilterData shapeFilterData = pShape->getQueryFilterData();
 			if (((filterData.word0 & shapeFilterData.word0) != 0) && ((filterData.word1 & shapeFilterData.word0) == 0) && filterData.word2 != shapeFilterData.word2)
 			{
@@ -299,6 +299,17 @@ namespace LambdaEngine
 			const PipelineMemoryBarrierDesc* pMemoryBarriers, 
 			uint32 bufferMemoryCount) = 0;
 
+		/*
+		* Records texture and buffer barriers that share source and destination stages as one pipeline barrier
+		*/
+		virtual void PipelineBarriers(
+			FPipelineStageFlags srcStage, 
+			FPipelineStageFlags dstStage, 
+			const PipelineTextureBarrierDesc* pTextureBarriers, 
+			uint32 textureBarrierCount,
+			const PipelineBufferBarrierDesc* pBufferBarriers, 
+			uint32 bufferBarrierCount) = 0;
+
 		virtual void GenerateMips(
 			Texture* pTexture, 
 			ETextureState stateBefore, 
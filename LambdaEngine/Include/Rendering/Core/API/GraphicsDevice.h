@@ -18,6 +18,7 @@ namespace LambdaEngine
 	struct SwapChainDesc;
 	struct QueryHeapDesc;
 	struct RenderPassDesc;
+	struct MemoryHeapDesc;
 	struct CommandListDesc;
 	struct TextureViewDesc;
 	struct PipelineLayoutDesc;
@@ -27,6 +28,7 @@ namespace LambdaEngine
 	struct GraphicsPipelineStateDesc;
 	struct AccelerationStructureDesc;
 	struct RayTracingPipelineStateDesc;
+	struct ResourceMemoryRequirements;
 
 	class SBT;
 	class Fence;
@@ -37,6 +39,7 @@ namespace LambdaEngine
 	class SwapChain;
 	class QueryHeap;
 	class RenderPass;
+	class MemoryHeap;
 	class TextureView;
 	class CommandList;
 	class CommandQueue;
@@ -137,6 +140,8 @@ namespace LambdaEngine
 		virtual Texture*	CreateTexture(const TextureDesc* pDesc)	const = 0;
 		virtual Sampler*	CreateSampler(const SamplerDesc* pDesc)	const = 0;
 
+		virtual MemoryHeap* CreateMemoryHeap(const MemoryHeapDesc* pDesc) const = 0;
+
 		virtual SwapChain*	CreateSwapChain(const SwapChainDesc* pDesc)	const = 0;
 
 		virtual PipelineState*	CreateGraphicsPipelineState(const GraphicsPipelineStateDesc* pDesc)		const = 0;
@@ -158,6 +163,12 @@ namespace LambdaEngine
 		virtual void QueryDeviceFeatures(GraphicsDeviceFeatureDesc* pFeatures) const = 0;
 		virtual void QueryDeviceMemoryStatistics(uint32* statCount, TArray<GraphicsDeviceMemoryStatistics>& pMemoryStat) const = 0;
 
+		/*
+		* Returns the memory a texture created from pDesc needs when it is placed in a MemoryHeap
+		*	return - Returns false if the texture can not be created
+		*/
+		virtual bool QueryTextureMemoryRequirements(const TextureDesc* pDesc, ResourceMemoryRequirements* pRequirements) const = 0;
+
 		/*
 		* Releases the graphicsdevice. Unlike all other graphics interfaces, the graphicsdevice
 		* is not referencecounted. This means that a call to release will delete the graphicsdevice. This 
@@ -0,0 +1,46 @@
+#pragma once
+#include "DeviceChild.h"
+#include "GraphicsTypes.h"
+
+namespace LambdaEngine
+{
+	struct ResourceMemoryRequirements
+	{
+		uint64 SizeInBytes		= 0;
+		uint64 Alignment		= 0;
+		uint32 MemoryTypeBits	= 0;	// API specific memory types that the resource can be placed in
+	};
+
+	struct MemoryHeapDesc
+	{
+		String		DebugName		= "";
+		EMemoryType	MemoryType		= EMemoryType::MEMORY_TYPE_NONE;
+		uint64		SizeInBytes		= 0;
+		uint32		MemoryTypeBits	= UINT32_MAX;	// Intersection of the MemoryTypeBits of the resources that are placed in the heap
+	};
+
+	/*
+	* MemoryHeap - A single device allocation that resources can be placed in at a fixed offset. Placed resources
+	* hold a reference to the heap, several of them may share the same memory as long as they are never used at the
+	* same time. The user is responsible for the barriers between resources that share memory.
+	*/
+	class MemoryHeap : public DeviceChild
+	{
+	public:
+		DECL_DEVICE_INTERFACE(MemoryHeap);
+
+		/*
+		* Returns the API-specific handle to the underlaying memory
+		*	return - Returns a valid handle on success otherwise zero
+		*/
+		virtual uint64 GetHandle() const = 0;
+
+		FORCEINLINE const MemoryHeapDesc& GetDesc() const
+		{
+			return m_Desc;
+		}
+
+	protected:
+		MemoryHeapDesc m_Desc;
+	};
+}
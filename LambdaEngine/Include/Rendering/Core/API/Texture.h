@@ -4,6 +4,8 @@
 
 namespace LambdaEngine
 {
+	class MemoryHeap;
+
 	enum class ETextureType : uint8
 	{
 		TEXTURE_TYPE_NONE	= 0,
@@ -14,17 +16,19 @@ namespace LambdaEngine
 
 	struct TextureDesc
 	{
-		String			DebugName	= "";
-		EMemoryType		MemoryType	= EMemoryType::MEMORY_TYPE_NONE;
-		EFormat			Format		= EFormat::FORMAT_NONE;
-		ETextureType	Type		= ETextureType::TEXTURE_TYPE_NONE;
-		FTextureFlags	Flags		= FTextureFlag::TEXTURE_FLAG_NONE;
-		uint32			Width		= 0;
-		uint32			Height		= 0;
-		uint32			Depth		= 0;
-		uint32			ArrayCount	= 0;
-		uint32			Miplevels	= 0;
-		uint32			SampleCount	= 0;
+		String			DebugName			= "";
+		EMemoryType		MemoryType			= EMemoryType::MEMORY_TYPE_NONE;
+		EFormat			Format				= EFormat::FORMAT_NONE;
+		ETextureType	Type				= ETextureType::TEXTURE_TYPE_NONE;
+		FTextureFlags	Flags				= FTextureFlag::TEXTURE_FLAG_NONE;
+		uint32			Width				= 0;
+		uint32			Height				= 0;
+		uint32			Depth				= 0;
+		uint32			ArrayCount			= 0;
+		uint32			Miplevels			= 0;
+		uint32			SampleCount			= 0;
+		MemoryHeap*		pMemoryHeap			= nullptr;	// If set the texture is placed in the heap instead of getting its own allocation
+		uint64			MemoryHeapOffset	= 0;
 	};
 
 	class Texture : public DeviceChild
@@ -140,6 +140,14 @@ namespace LambdaEngine
 			const PipelineMemoryBarrierDesc* pMemoryBarriers,
 			uint32 bufferMemoryCount) override final;
 
+		virtual void PipelineBarriers(
+			FPipelineStageFlags srcStage,
+			FPipelineStageFlags dstStage,
+			const PipelineTextureBarrierDesc* pTextureBarriers,
+			uint32 textureBarrierCount,
+			const PipelineBufferBarrierDesc* pBufferBarriers,
+			uint32 bufferBarrierCount) override final;
+
 		virtual void GenerateMips(Texture* pTexture, ETextureState stateBefore, ETextureState stateAfter, bool linearFiltering) override final;
 
 		virtual void SetViewports(const Viewport* pViewports, uint32 firstViewport, uint32 viewportCount) override final;
@@ -237,6 +245,10 @@ namespace LambdaEngine
 
 	private:
 		void BindDescriptorSet(const DescriptorSet* pDescriptorSet, const PipelineLayout* pPipelineLayout, uint32 setIndex, VkPipelineBindPoint bindPoint);
+
+		// Fills m_ImageBarriers and m_BufferBarriers from the API descriptions
+		void ConvertTextureBarriers(const PipelineTextureBarrierDesc* pTextureBarriers, uint32 textureBarrierCount);
+		void ConvertBufferBarriers(const PipelineBufferBarrierDesc* pBufferBarriers, uint32 bufferBarrierCount);
 		
 		FORCEINLINE void AddDeferredBarrier(DeferredImageBarrier& deferredBarrier, const VkImageMemoryBarrier& imageBarrier)
 		{
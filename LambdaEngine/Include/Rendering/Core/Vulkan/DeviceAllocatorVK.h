@@ -3,6 +3,8 @@
 
 #include "Containers/TArray.h"
 
+#include "Memory/API/OffsetAllocator.h"
+
 #include "Rendering/Core/API/TDeviceChildBase.h"
 
 #include "Vulkan.h"
@@ -12,11 +14,10 @@ namespace LambdaEngine
 	class GraphicsDeviceVK;
 	class DeviceMemoryPageVK;
 
-	struct DeviceMemoryBlockVK;
-
 	struct AllocationVK
 	{
-		DeviceMemoryBlockVK* pBlock = nullptr;
+		DeviceMemoryPageVK* pPage = nullptr;
+		OffsetAllocation SubAllocation;
 		VkDeviceMemory Memory = VK_NULL_HANDLE;
 		uint64 Offset = 0;
 		class DeviceAllocatorVK* pAllocator = nullptr;
@@ -32,12 +33,21 @@ namespace LambdaEngine
 		
 		bool Init(const String& debugName, VkDeviceSize pageSize);
 		
-		bool Allocate(AllocationVK* pAllocation, uint64 sizeInBytes, uint64 alignment, uint32 memoryIndex);
+		/**
+		* Sub-allocates memory from a page with the given memory type, a new page is created if no page has room
+		* @param optimalTiling	True for images with optimal tiling, keeps them off the bufferImageGranularity pages of linear resources
+		*/
+		bool Allocate(AllocationVK* pAllocation, uint64 sizeInBytes, uint64 alignment, uint32 memoryIndex, bool optimalTiling = false);
 		bool Free(AllocationVK* pAllocation);
 		
 		void* Map(const AllocationVK* pAllocation);
 		void Unmap(const AllocationVK* pAllocation);
 
+		/*
+		* Retrieves the usage and fragmentation of each page, in page order
+		*/
+		void GetPageStatistics(TArray<OffsetAllocatorStatistics>& statistics);
+
 	public:
 		// DeviceChild Interface
 		virtual void SetName(const String& name) override final;
@@ -111,6 +111,8 @@ namespace LambdaEngine
 		virtual Texture* CreateTexture(const TextureDesc* pDesc) const override final;
 		virtual Sampler* CreateSampler(const SamplerDesc* pDesc) const override final;
 
+		virtual MemoryHeap* CreateMemoryHeap(const MemoryHeapDesc* pDesc) const override final;
+
 		virtual SwapChain* CreateSwapChain(const SwapChainDesc* pDesc)	const override final;
 
 		virtual PipelineState* CreateGraphicsPipelineState(const GraphicsPipelineStateDesc* pDesc) const override final;
@@ -132,6 +134,8 @@ namespace LambdaEngine
 		virtual void QueryDeviceFeatures(GraphicsDeviceFeatureDesc* pFeatures) const override final;
 		virtual void QueryDeviceMemoryStatistics(uint32* statCount, TArray<GraphicsDeviceMemoryStatistics>& pMemoryStat) const override final;
 
+		virtual bool QueryTextureMemoryRequirements(const TextureDesc* pDesc, ResourceMemoryRequirements* pRequirements) const override final;
+
 		virtual void Release() override final;
 
 	private:
@@ -140,6 +144,8 @@ namespace LambdaEngine
 		bool InitPhysicalDevice();
 		bool InitLogicalDevice(const GraphicsDeviceDesc* pDesc);
 		bool InitAllocators();
+		bool InitPipelineCache();
+		void SavePipelineCache();
 
 		bool SetEnabledValidationLayers();
 		bool SetEnabledInstanceExtensions();
@@ -172,6 +178,7 @@ namespace LambdaEngine
 		VkInstance			Instance		= VK_NULL_HANDLE;
 		VkPhysicalDevice	PhysicalDevice	= VK_NULL_HANDLE;
 		VkDevice			Device			= VK_NULL_HANDLE;
+		VkPipelineCache		PipelineCache	= VK_NULL_HANDLE;
 
 	public:
 		/*
@@ -0,0 +1,45 @@
+#pragma once
+#include "Rendering/Core/API/MemoryHeap.h"
+#include "Rendering/Core/API/TDeviceChildBase.h"
+
+#include "Vulkan.h"
+
+namespace LambdaEngine
+{
+	class GraphicsDeviceVK;
+
+	class MemoryHeapVK : public TDeviceChildBase<GraphicsDeviceVK, MemoryHeap>
+	{
+		using TDeviceChild = TDeviceChildBase<GraphicsDeviceVK, MemoryHeap>;
+
+	public:
+		MemoryHeapVK(const GraphicsDeviceVK* pDevice);
+		~MemoryHeapVK();
+
+		bool Init(const MemoryHeapDesc* pDesc);
+
+		FORCEINLINE VkDeviceMemory GetDeviceMemory() const
+		{
+			return m_Memory;
+		}
+
+		FORCEINLINE uint32 GetMemoryTypeIndex() const
+		{
+			return m_MemoryTypeIndex;
+		}
+
+	public:
+		// DeviceChild interface
+		virtual void SetName(const String& name) override final;
+
+		// MemoryHeap interface
+		FORCEINLINE virtual uint64 GetHandle() const override final
+		{
+			return reinterpret_cast<uint64>(m_Memory);
+		}
+
+	private:
+		VkDeviceMemory	m_Memory			= VK_NULL_HANDLE;
+		uint32			m_MemoryTypeIndex	= UINT32_MAX;
+	};
+}
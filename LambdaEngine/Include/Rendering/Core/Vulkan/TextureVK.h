@@ -5,6 +5,7 @@
 #include "Rendering/Core/API/TDeviceChildBase.h"
 
 #include "Rendering/Core/Vulkan/DeviceAllocatorVK.h"
+#include "Rendering/Core/Vulkan/MemoryHeapVK.h"
 
 namespace LambdaEngine
 {
@@ -22,6 +23,11 @@ namespace LambdaEngine
 		bool Init(const TextureDesc* pDesc);
 		void InitWithImage(VkImage image, const TextureDesc* pDesc);
 
+		/*
+		* Returns the create info that Init uses for a description, also used to query memory requirements
+		*/
+		static VkImageCreateInfo CreateImageInfo(const TextureDesc* pDesc);
+
 		FORCEINLINE VkImage GetImage() const
 		{
 			return m_Image;
@@ -45,8 +51,12 @@ namespace LambdaEngine
 		}
 
 	private:
-		VkImage				m_Image = VK_NULL_HANDLE;
-		VkImageAspectFlags	m_AspectFlags;
-		AllocationVK		m_Allocation;
+		bool BindToMemoryHeap(const VkMemoryRequirements& memoryRequirements, MemoryHeap* pMemoryHeap, uint64 offset);
+
+	private:
+		VkImage						m_Image = VK_NULL_HANDLE;
+		VkImageAspectFlags			m_AspectFlags;
+		AllocationVK				m_Allocation;
+		TSharedRef<MemoryHeapVK>	m_MemoryHeap = nullptr;
 	};
 }
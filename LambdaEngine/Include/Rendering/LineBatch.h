@@ -0,0 +1,114 @@
+#pragma once
+#include "LambdaEngine.h"
+
+#include "Containers/TArray.h"
+#include "Containers/THashTable.h"
+
+#include "Math/Math.h"
+
+namespace LambdaEngine
+{
+	struct VertexData
+	{
+		glm::vec4 Position;
+		glm::vec4 Color;
+	};
+
+	/*
+	* LineBatch - Keeps every line drawn by the LineRenderer in one contiguous vertex stream so that all of them are
+	* drawn with a single draw call. Groups and timed lines own ranges of the stream, a range is only rewritten when its
+	* lines change and the part of the stream that changed is tracked so that only it has to be uploaded. Removed ranges
+	* are cleared to invisible lines and the stream is compacted once more than half of it is unused.
+	*
+	* The batch does not touch the GPU, the owner uploads GetDirtyRange of GetVertices and calls ClearDirtyRange.
+	*/
+	class LAMBDA_API LineBatch
+	{
+		struct LineRange
+		{
+			uint32 Offset		= 0;
+			uint32 VertexCount	= 0;
+		};
+
+		struct TimedRange
+		{
+			LineRange	Range;
+			float64		ExpireTime;
+		};
+
+	public:
+		LineBatch() = default;
+		~LineBatch() = default;
+
+		void Clear();
+
+		/**
+		* Removes the timed lines that have expired, lines are drawn at least once before they expire
+		* @param time	Current time in seconds
+		*/
+		void Tick(float64 time);
+
+		/**
+		* Adds a line group, the number of lines is equal to pointCount / 2
+		* @return ID used to update or remove the group
+		*/
+		uint32 AddGroup(const glm::vec3* pPoints, uint32 pointCount, const glm::vec3& color);
+
+		/**
+		* Rewrites a group in place if the number of points is unchanged, otherwise the group is moved to the end
+		* @return ID of the group, a new group is added if ID does not exist
+		*/
+		uint32 UpdateGroup(uint32 ID, const glm::vec3* pPoints, uint32 pointCount, const glm::vec3& color);
+		void RemoveGroup(uint32 ID);
+
+		/**
+		* Adds lines that are removed after a lifetime, lines added in the same frame with the same lifetime share one range
+		* @param pVertices		Two vertices per line
+		* @param lifetime		Seconds the lines are kept, 0 draws them once and LINE_LIFETIME_INFINITE keeps them
+		*/
+		void AddLines(const VertexData* pVertices, uint32 vertexCount, float32 lifetime);
+
+		/**
+		* Returns the range of vertices that changed since the last call to ClearDirtyRange
+		* @return False if nothing in the current stream changed
+		*/
+		bool GetDirtyRange(uint32& offset, uint32& count) const;
+		void ClearDirtyRange();
+
+		FORCEINLINE const TArray<VertexData>& GetVertices() const
+		{
+			return m_Vertices;
+		}
+
+		FORCEINLINE uint32 GetVertexCount() const
+		{
+			return m_Vertices.GetSize();
+		}
+
+		FORCEINLINE uint32 GetGroupCount() const
+		{
+			return uint32(m_Groups.size());
+		}
+
+	private:
+		LineRange AllocateRange(uint32 vertexCount);
+		void FreeRange(const LineRange& range);
+		void WriteGroup(const LineRange& range, const glm::vec3* pPoints, const glm::vec3& color);
+		void Compact();
+		void MarkDirty(uint32 offset, uint32 count);
+
+	public:
+		static constexpr const float32 LINE_LIFETIME_INFINITE = FLT_MAX;
+
+	private:
+		TArray<VertexData>				m_Vertices;
+		THashTable<uint32, LineRange>	m_Groups;
+		TArray<TimedRange>				m_TimedRanges;
+
+		float64	m_Time				= 0.0;
+		uint32	m_NextGroupID		= 0;
+		uint32	m_UnusedVertexCount	= 0;
+		uint32	m_DirtyBegin		= UINT32_MAX;
+		uint32	m_DirtyEnd			= 0;
+	};
+}
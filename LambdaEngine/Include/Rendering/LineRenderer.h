@@ -2,6 +2,7 @@
 
 #include "RenderGraphTypes.h"
 #include "CustomRenderer.h"
+#include "LineBatch.h"
 
 namespace LambdaEngine
 {
@@ -22,12 +23,6 @@ namespace LambdaEngine
 	class Buffer;
 	class Window;
 
-	struct VertexData
-	{
-		glm::vec4 Position;
-		glm::vec4 Color;
-	};
-
 	class LineRenderer : public CustomRenderer
 	{
 	public:
@@ -93,12 +88,13 @@ namespace LambdaEngine
 		static void RemoveLineGroup(uint32 ID);
 
 		/*
-		* Draw a line that will be static in the scene and cannot be removed (legacy Bullet implementation)
+		* Draw a line that is removed after a lifetime, by default it is static in the scene and cannot be removed (legacy Bullet implementation)
 		* from - glm::vec3 of point to draw from
 		* to - glm::vec3 of point to draw to
 		* color - color the line between from and to should be
+		* lifetime - seconds the line is drawn, 0 draws it for a single frame
 		*/
-		static void DrawLine(const glm::vec3& from, const glm::vec3& to, const glm::vec3& color);
+		static void DrawLine(const glm::vec3& from, const glm::vec3& to, const glm::vec3& color, float32 lifetime = LineBatch::LINE_LIFETIME_INFINITE);
 
 		/*
 		* Draw a line that will be static in the scene and cannot be removed (legacy Bullet implementation)
@@ -106,8 +102,17 @@ namespace LambdaEngine
 		* to - glm::vec3 of point to draw to
 		* fromColor - start color the line should be - will be interpolated to the toColor
 		* toColor -  end color the line should be - will be interpolated from fromColor
+		* lifetime - seconds the line is drawn, 0 draws it for a single frame
+		*/
+		static void DrawLine(const glm::vec3& from, const glm::vec3& to, const glm::vec3& fromColor, const glm::vec3& toColor, float32 lifetime = LineBatch::LINE_LIFETIME_INFINITE);
+
+		/*
+		* Draw a batch of lines that are removed after a lifetime, cheaper than calling DrawLine for every line
+		* pVertices - two vertices per line
+		* vertexCount - number of vertices in pVertices
+		* lifetime - seconds the lines are drawn, 0 draws them for a single frame
 		*/
-		static void DrawLine(const glm::vec3& from, const glm::vec3& to, const glm::vec3& fromColor, const glm::vec3& toColor);
+		static void DrawLines(const VertexData* pVertices, uint32 vertexCount, float32 lifetime = 0.0f);
 
 		/*
 		* Sets the line width to be used for all lines
@@ -134,6 +139,7 @@ namespace LambdaEngine
 		const GraphicsDevice*	m_pGraphicsDevice = nullptr;
 
 		uint32 m_verticiesBufferSize;
+		bool m_ExceededBufferSize = false;
 
 		uint32 m_BackBufferCount = 0;
 		TArray<TSharedRef<const TextureView>>	m_BackBuffers;
@@ -162,10 +168,9 @@ namespace LambdaEngine
 		THashTable<GUID_Lambda, THashTable<GUID_Lambda, uint64>>	m_ShadersIDToPipelineStateIDMap;
 
 	private:
-		static LineRenderer*							s_pInstance;
-		static TArray<VertexData>						s_Verticies;
-		static THashTable<uint32, TArray<VertexData>>	s_LineGroups;
-		static float32									s_LineWidth;
+		static LineRenderer*	s_pInstance;
+		static LineBatch		s_LineBatch;
+		static float32			s_LineWidth;
 	};
 
 }
\ No newline at end of file
@@ -0,0 +1,64 @@
+#pragma once
+#include "LambdaEngine.h"
+
+#include "Containers/TArray.h"
+
+namespace LambdaEngine
+{
+	/*
+	* ParticleAliveList - Dense list of the particle indices that belong to active emitters. Ranges of particles are
+	* appended when an emitter activates and swap-removed when it deactivates, so a change costs time proportional to
+	* the emitter instead of to every alive particle. The part of the list that changed is tracked so that only it has
+	* to be uploaded.
+	*/
+	class LAMBDA_API ParticleAliveList
+	{
+	public:
+		ParticleAliveList() = default;
+		~ParticleAliveList() = default;
+
+		void Init(uint32 maxParticleCount);
+		void Clear();
+
+		/**
+		* Adds the particles [firstParticle, firstParticle + particleCount) to the end of the list
+		*/
+		void AddRange(uint32 firstParticle, uint32 particleCount);
+
+		/**
+		* Removes the particles [firstParticle, firstParticle + particleCount), the holes are filled with the last entries
+		*/
+		void RemoveRange(uint32 firstParticle, uint32 particleCount);
+
+		/**
+		* Returns the range of the list that changed since the last call to ClearDirtyRange
+		* @param offset	Receives the first changed entry
+		* @param count	Receives the number of entries from offset
+		* @return False if nothing in the current list changed
+		*/
+		bool GetDirtyRange(uint32& offset, uint32& count) const;
+		void ClearDirtyRange();
+
+		FORCEINLINE const TArray<uint32>& GetIndices() const
+		{
+			return m_Indices;
+		}
+
+		FORCEINLINE uint32 GetSize() const
+		{
+			return m_Indices.GetSize();
+		}
+
+	private:
+		void MarkDirty(uint32 position);
+
+	private:
+		TArray<uint32>	m_Indices;
+		TArray<uint32>	m_Positions;	// Position of each particle in m_Indices, INVALID_POSITION if it is not alive
+		uint32			m_DirtyBegin	= UINT32_MAX;
+		uint32			m_DirtyEnd		= 0;
+
+	public:
+		static constexpr const uint32 INVALID_POSITION = UINT32_MAX;
+	};
+}
@@ -5,6 +5,10 @@
 #include "Game/ECS/Components/Rendering/ParticleEmitter.h"
 
 #include "Rendering/Core/API/GraphicsTypes.h"
+#include "Rendering/ParticleAliveList.h"
+#include "Rendering/ParticleSimulatorCPU.h"
+
+#include "Memory/API/OffsetAllocator.h"
 
 #include "Rendering/RT/ASBuilder.h"
 
@@ -51,6 +55,7 @@ namespace LambdaEngine
 		float			EndRadius;
 		glm::vec4		Color;
 		ParticleChunk	ParticleChunk;
+		OffsetAllocation	ParticleAllocation;
 		GUID_Lambda		AtlasGUID = 0;
 		bool			RandomStartIndex = false;
 		uint32			AnimationCount = 0;
@@ -74,7 +79,7 @@ namespace LambdaEngine
 		float EndRadius;
 		float FrictionFactor;
 		float ShouldStop;
-		float Padding1;
+		uint32 Generation;	// Only written by ParticleSimulatorCPU, matches read back particles with their current life
 	};
 
 	struct SEmitter
@@ -120,17 +125,41 @@ namespace LambdaEngine
 
 	class ParticleManager
 	{
+		enum class ECPUComparisonState : uint8
+		{
+			IDLE,
+			REQUESTED,
+			CAPTURE_OUTPUT,
+			WAITING,
+			DONE
+		};
+
+		struct CPUComparison
+		{
+			ECPUComparisonState		State			= ECPUComparisonState::IDLE;
+			uint64					InputSlot		= 0;
+			uint64					OutputSlot		= 0;
+			float32					DeltaTime		= 0.0f;
+			uint32					MismatchCount	= 0;
+			TArray<IndirectData>	Chunks;
+			TArray<SEmitter>		Emitters;
+			TArray<glm::mat4>		Transforms;
+		};
+
 	public:
 		ParticleManager() = default;
 		~ParticleManager() = default;
 
 		/*
 		*	Destruction of ASBuilder is not ParticleManagers responsibility, but access is needed to update raytraced particles
+		*	simulateOnCPU - Particles are updated by ParticleSimulatorCPU in Tick instead of by the update compute pass, the collision pass still runs on the uploaded particles
+		*	and its result is read back and applied to the simulator BACK_BUFFER_COUNT frames later
 		*/
-		void Init(uint32 maxParticleCapacity, ASBuilder* pASBuilder);
+		void Init(uint32 maxParticleCapacity, ASBuilder* pASBuilder, bool simulateOnCPU = false);
 		void Release();
 
 		bool IsInitilized() const { return m_Initialized; };
+		bool IsSimulatedOnCPU() const { return m_SimulateOnCPU; };
 
 		void Tick(Timestamp deltaTime, uint64 modFrameIndex);
 
@@ -138,18 +167,24 @@ namespace LambdaEngine
 
 		void OnEmitterEntityRemoved(Entity entity);
 
-		uint32 GetParticleCount() const { return m_AliveIndices.GetSize();  }
+		uint32 GetParticleCount() const { return m_AliveParticles.GetSize();  }
 		uint32 GetActiveEmitterCount() const { return m_IndirectData.GetSize();  }
 		uint32 GetMaxParticleCount() const { return m_MaxParticleCount; }
 
 		bool UpdateBuffers(CommandList* pCommandList);
 		bool UpdateResources(RenderGraph* pRendergraph);
 
+		/*
+		*	Reads back the particles before and after one frame of the update compute pass and simulates the same frame with ParticleSimulatorCPU.
+		*	The result is ready some frames later, the next frame without newly uploaded particles is used. Does nothing when simulating on the CPU.
+		*/
+		void RequestCPUComparison();
+		bool HasCPUComparisonResult() const { return m_CPUComparison.State == ECPUComparisonState::DONE; }
+		uint32 GetCPUComparisonMismatchCount() const { return m_CPUComparison.MismatchCount; }
+
 	private:
 		bool CreateAtlasTextureInstance(GUID_Lambda atlasGUID, uint32 tileSize);
 
-		void UpdateAliveParticles();
-
 		void UpdateEmitterInstanceData(ParticleEmitterInstance& emitterInstance, const PositionComponent& positionComp, const RotationComponent& rotationComp, const ParticleEmitterComponent& emitterComp);
 
 		void ReplaceRemovedEmitterWithLast(uint32 removeIndex);
@@ -163,18 +198,27 @@ namespace LambdaEngine
 		bool ActivateEmitterInstance(EmitterID emitterID, const PositionComponent& positionComp, const RotationComponent& rotationComp, const ParticleEmitterComponent& emitterComp);
 		bool DeactivateEmitterInstance(EmitterID emitterID);
 
-		bool AllocateParticleChunk(ParticleChunk& chunk);
-		bool FreeParticleChunk(ParticleChunk chunk);
-		bool MergeParticleChunk(const ParticleChunk& chunk);
+		bool AllocateParticleChunk(ParticleEmitterInstance& emitterInstance);
+		void FreeParticleChunk(ParticleEmitterInstance& emitterInstance);
+
+		void SimulateOnCPU(float32 deltaTime);
+
+		void ReadBackParticleBuffer(CommandList* pCommandList, uint32 particleCount);
+		void ApplyCollisionReadBack();
+		void CaptureCPUComparison(CommandList* pCommandList);
+		void CompareCPUSimulation();
 
 		void CleanBuffers();
 
 	private:
 		uint32								m_MaxParticleCount;
 		uint64								m_ModFrameIndex;
+		float32								m_DeltaTime					= 0.0f;
 
 		bool								m_Initialized				= false;
 		bool								m_CreatedDummyBuffer		= false;
+		bool								m_SimulateOnCPU				= false;
+		bool								m_ReadBackCollisions		= false;
 
 		bool								m_DirtyAliveBuffer			= false;
 		bool								m_DirtyEmitterIndexBuffer	= false;
@@ -218,9 +262,14 @@ namespace LambdaEngine
 		Buffer*								m_ppAtlasDataStagingBuffer[BACK_BUFFER_COUNT] = { nullptr };
 		Buffer*								m_pAtlasDataBuffer = nullptr;
 
+		// Particle buffer copies for the CPU, a slot is mapped when it is used again BACK_BUFFER_COUNT frames later
+		Buffer*								m_ppParticleReadBackBuffers[BACK_BUFFER_COUNT] = { nullptr };
+		uint32								m_ReadBackParticleCounts[BACK_BUFFER_COUNT] = { 0 };
+		CPUComparison						m_CPUComparison;
+
 		TArray<DeviceChild*>				m_ResourcesToRemove[BACK_BUFFER_COUNT];
 
-		TArray<uint32>						m_AliveIndices;
+		ParticleAliveList					m_AliveParticles;
 		TArray<SParticleIndexData>			m_ParticleIndexData;
 		TArray<SParticle>					m_Particles;
 		// Emitter specfic data
@@ -229,7 +278,8 @@ namespace LambdaEngine
 		TArray<glm::mat4>					m_EmitterTransformData;
 
 		TArray<ParticleChunk>				m_DirtyParticleChunks;
-		TArray<ParticleChunk>				m_FreeParticleChunks;
+		OffsetAllocator						m_ParticleChunkAllocator;
+		ParticleSimulatorCPU				m_CPUSimulator;
 		TArray<SAtlasInfo>					m_AtlasInfoData;
 
 		TSharedRef<Sampler>					m_Sampler = nullptr;
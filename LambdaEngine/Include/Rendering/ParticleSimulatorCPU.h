@@ -0,0 +1,133 @@
+#pragma once
+#include "LambdaEngine.h"
+
+#include "Containers/TArray.h"
+
+#include "Math/Math.h"
+
+namespace LambdaEngine
+{
+	struct SParticle;
+	struct SEmitter;
+	struct IndirectData;
+
+	/*
+	* ParticleSimulatorCPU - CPU version of the ParticleUpdate compute shader. Particles are stored as one stream per
+	* component (SoA) indexed by particle index, so each emitter chunk is simulated with SSE, or AVX when the engine is
+	* compiled with it, and split into jobs on the ThreadPool. The result matches the GPU update, which makes it usable
+	* on machines without compute and as a reference when validating the shader.
+	*
+	* Collisions are not simulated, they depend on ray queries against the TLAS which only exists on the GPU. The collided
+	* particles are read back instead and applied with ApplyCollisions. Every particle carries a generation that changes
+	* when it is loaded or respawned, so a collision that was read back for a previous life is ignored.
+	*/
+	class LAMBDA_API ParticleSimulatorCPU
+	{
+		struct Job
+		{
+			uint32	EmitterIndex;
+			uint32	FirstParticle;
+			uint32	ParticleCount;
+		};
+
+	public:
+		enum EStream : uint32
+		{
+			STREAM_POSITION_X,
+			STREAM_POSITION_Y,
+			STREAM_POSITION_Z,
+			STREAM_VELOCITY_X,
+			STREAM_VELOCITY_Y,
+			STREAM_VELOCITY_Z,
+			STREAM_ACCELERATION_X,
+			STREAM_ACCELERATION_Y,
+			STREAM_ACCELERATION_Z,
+			STREAM_START_POSITION_X,
+			STREAM_START_POSITION_Y,
+			STREAM_START_POSITION_Z,
+			STREAM_START_VELOCITY_X,
+			STREAM_START_VELOCITY_Y,
+			STREAM_START_VELOCITY_Z,
+			STREAM_START_ACCELERATION_X,
+			STREAM_START_ACCELERATION_Y,
+			STREAM_START_ACCELERATION_Z,
+			STREAM_CURRENT_LIFE,
+			STREAM_SHOULD_STOP,
+			STREAM_WAS_CREATED,
+			STREAM_COUNT
+		};
+
+		struct EmitterConstants
+		{
+			glm::mat4	Transform;
+			float32		LifeTime;
+			float32		Gravity;
+			uint32		FirstAnimationIndex;
+			bool		OneTime;
+		};
+
+	public:
+		ParticleSimulatorCPU() = default;
+		~ParticleSimulatorCPU() = default;
+
+		void Init(uint32 maxParticleCount);
+
+		/**
+		* Copies newly created particles into the streams
+		* @param pParticles		Array of particleCount particles, the first one is stored at firstParticle
+		*/
+		void LoadParticles(const SParticle* pParticles, uint32 firstParticle, uint32 particleCount);
+
+		/**
+		* Copies the simulated state back into particles, only the members the simulation changes are written
+		* @param pParticles		Array of particleCount particles, the first one is read from firstParticle
+		*/
+		void StoreParticles(SParticle* pParticles, uint32 firstParticle, uint32 particleCount) const;
+
+		/**
+		* Stops the particles that the collision pass stopped, the collided particles may be several frames old
+		* @param pParticles		Array of particleCount collided particles read back from the GPU, the first one is particle firstParticle
+		* @return The number of particles that were stopped
+		*/
+		uint32 ApplyCollisions(const SParticle* pParticles, uint32 firstParticle, uint32 particleCount);
+
+		/**
+		* Simulates one step for every emitter, emitter e owns the particles in pChunks[e]
+		* @param deltaTime		Step in seconds
+		* @param pChunks		Draw data of each emitter, FirstInstance and InstanceCount describe its particles
+		* @param pEmitters		Emitter data, same order as pChunks
+		* @param pTransforms	Emitter transforms, same order as pChunks
+		* @param emitterCount	Number of emitters
+		*/
+		void Simulate(float32 deltaTime, const IndirectData* pChunks, const SEmitter* pEmitters, const glm::mat4* pTransforms, uint32 emitterCount);
+
+		FORCEINLINE float32 GetStreamValue(EStream stream, uint32 particleIndex) const
+		{
+			return m_Streams[stream][particleIndex];
+		}
+
+		FORCEINLINE uint32 GetTileIndex(uint32 particleIndex) const
+		{
+			return m_TileIndices[particleIndex];
+		}
+
+		FORCEINLINE bool IsInitialized() const
+		{
+			return !m_TileIndices.IsEmpty();
+		}
+
+	private:
+		void SimulateRange(const EmitterConstants& emitter, float32 deltaTime, uint32 firstParticle, uint32 particleCount);
+
+	public:
+		static constexpr const uint32 PARTICLES_PER_JOB	= 4096;
+		static constexpr const float32 OUT_OF_REACH		= 10000.0f;
+
+	private:
+		TArray<float32>				m_Streams[STREAM_COUNT];
+		TArray<uint32>				m_TileIndices;
+		TArray<uint32>				m_Generations;
+		TArray<Job>					m_Jobs;
+		TArray<EmitterConstants>	m_EmitterConstants;
+	};
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include "LambdaEngine.h"
+
+#include "Containers/TArray.h"
+#include "Containers/String.h"
+
+namespace LambdaEngine
+{
+	/*
+	* Identifies the device and driver that produced a pipeline cache blob, a blob is only
+	* handed back to the driver if every field matches
+	*/
+	struct PipelineCacheIdentity
+	{
+		uint32	VendorID		= 0;
+		uint32	DeviceID		= 0;
+		uint32	DriverVersion	= 0;
+		byte	CacheUUID[16]	= { };
+	};
+
+	/*
+	* PipelineCacheFile - Versioned file format for driver pipeline cache blobs. The blob itself is opaque,
+	* the header adds the identity of the device and a hash of the payload so stale or truncated files are discarded.
+	*/
+	class LAMBDA_API PipelineCacheFile
+	{
+	public:
+		DECL_STATIC_CLASS(PipelineCacheFile);
+
+		/**
+		* Reads a pipeline cache blob
+		* @param filepath	Path to the cache file
+		* @param identity	Identity of the current device
+		* @param data		Receives the blob, empty if the file is missing or does not match
+		* @return True if a valid blob was read
+		*/
+		static bool Read(const String& filepath, const PipelineCacheIdentity& identity, TArray<byte>& data);
+
+		/**
+		* Writes a pipeline cache blob, the file is replaced atomically
+		* @param filepath	Path to the cache file
+		* @param identity	Identity of the device that produced the blob
+		* @param data		The blob to write
+		* @return True if the file was written
+		*/
+		static bool Write(const String& filepath, const PipelineCacheIdentity& identity, const TArray<byte>& data);
+	};
+}
@@ -100,8 +100,19 @@ namespace LambdaEngine
 		TArray<HitGroupShaderModules> HitGroupShaders;
 	};
 
+	/*
+	* PipelineStateManager - Owns every managed pipeline state. Descriptions are hashed on creation and identical
+	* descriptions share one pipeline state, the debug name is not part of the hash. Pipeline creation goes through
+	* the driver pipeline cache, which GraphicsDeviceVK keeps on disk between runs.
+	*/
 	class LAMBDA_API PipelineStateManager
 	{
+		struct SharedPipelineState
+		{
+			TSharedRef<PipelineState>	PipelineState;
+			uint32						RefCount	= 0;
+		};
+
 	public:
 		DECL_STATIC_CLASS(PipelineStateManager);
 		
@@ -118,7 +129,20 @@ namespace LambdaEngine
 
 		static PipelineState* GetPipelineState(uint64 id);
 
+		/*
+		* Content hashes of managed descriptions, shaders are identified by their GUID and the render pass and
+		* pipeline layout by their address, so a hash is only meaningful within one run
+		*/
+		static uint64 HashGraphicsPipelineStateDesc(const ManagedGraphicsPipelineStateDesc& desc);
+		static uint64 HashComputePipelineStateDesc(const ManagedComputePipelineStateDesc& desc);
+		static uint64 HashRayTracingPipelineStateDesc(const ManagedRayTracingPipelineStateDesc& desc);
+
+		FORCEINLINE static uint32 GetSharedPipelineStateCount() { return uint32(s_SharedPipelineStates.size()); }
+
 	private:
+		static uint64 RegisterPipelineState(uint64 hash, PipelineState* pPipelineState);
+		static uint64 FindSharedPipelineState(uint64 hash);
+
 		static bool OnPipelineStateRecompileEvent(const PipelineStateRecompileEvent& event);
 
 	private:
@@ -127,5 +151,7 @@ namespace LambdaEngine
 		static THashTable<uint64, ManagedGraphicsPipelineStateDesc>		s_GraphicsPipelineStateDescriptions;
 		static THashTable<uint64, ManagedComputePipelineStateDesc>		s_ComputePipelineStateDescriptions;
 		static THashTable<uint64, ManagedRayTracingPipelineStateDesc>	s_RayTracingPipelineStateDescriptions;
+		static THashTable<uint64, uint64>								s_PipelineStateHashes;
+		static THashTable<uint64, SharedPipelineState>					s_SharedPipelineStates;
 	};
 }
\ No newline at end of file
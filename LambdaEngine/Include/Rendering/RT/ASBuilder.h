@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Rendering/CustomRenderer.h"
+#include "Rendering/RT/TLASUpdateTracker.h"
 
 #include "Rendering/Core/API/AccelerationStructure.h"
 #include "Rendering/Core/API/CommandList.h"
@@ -88,6 +89,12 @@ namespace LambdaEngine
 		*/
 		void UpdateInstances(std::function<void(AccelerationStructureInstance&)> updateFunc);
 
+		/*
+		* Must be called every frame in which instances are written directly in the instance buffer on the GPU, otherwise the TLAS
+		* is only updated when instances change through the ASBuilder.
+		*/
+		void MarkInstancesWrittenOnGPU();
+
 		virtual void Update(Timestamp delta, uint32 modFrameIndex, uint32 backBufferIndex) override final;
 
 		virtual void Render(
@@ -146,6 +153,8 @@ namespace LambdaEngine
 		uint32 m_MaxSupportedTLASInstances = 0;
 		uint32 m_BuiltTLASInstanceCount = 0;
 		AccelerationStructure* m_pTLAS = nullptr;
+		TLASUpdateTracker m_TLASUpdateTracker;				//Instances changed since the last frame, decides between TLAS update and rebuild
+		TArray<TLASInstanceRange> m_DirtyInstanceRanges;
 
 		//Utility
 		TArray<DeviceChild*>* m_pResourcesToRemove = nullptr;
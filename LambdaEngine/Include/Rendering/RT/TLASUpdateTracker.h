@@ -0,0 +1,86 @@
+#pragma once
+#include "LambdaEngine.h"
+
+#include "Containers/TArray.h"
+
+namespace LambdaEngine
+{
+	enum class ETLASBuildMode : uint8
+	{
+		NONE	= 0,	// Nothing that the TLAS depends on changed
+		UPDATE	= 1,	// Refit the existing TLAS
+		REBUILD	= 2,	// Build the TLAS from scratch
+	};
+
+	struct TLASInstanceRange
+	{
+		uint32 FirstInstance	= 0;
+		uint32 InstanceCount	= 0;
+	};
+
+	/*
+	* TLASUpdateTracker - Tracks which instances of the ASBuilder changed since the last frame. The changes are merged into
+	* a few contiguous ranges of the instance buffer to upload, and they decide if the TLAS can be refitted or has to be
+	* rebuilt. A refit is cheap but the quality of the TLAS drops with every refit and with how much moved, so the TLAS is
+	* rebuilt when a large part of the instances changed or after too many refits in a row.
+	*/
+	class LAMBDA_API TLASUpdateTracker
+	{
+	public:
+		TLASUpdateTracker() = default;
+		~TLASUpdateTracker() = default;
+
+		void MarkDirty(uint32 instanceIndex);
+
+		/*
+		* Every instance has to be uploaded, for example when the instance buffer is recreated
+		*/
+		void MarkAllDirty();
+
+		/*
+		* Instances were written on the GPU, the TLAS has to be updated even if nothing changed on the CPU
+		*/
+		void MarkGPUWritten();
+
+		/**
+		* Merges the dirty instances into ranges sorted by instance, clean gaps of at most MAX_RANGE_GAP instances are included
+		* @param instanceCount	Current number of instances, dirty instances past it are ignored
+		* @param ranges			Receives the ranges to upload
+		*/
+		void GetDirtyRanges(uint32 instanceCount, TArray<TLASInstanceRange>& ranges);
+
+		/**
+		* @param instanceCount		Current number of instances
+		* @param builtInstanceCount	Number of instances the TLAS was last built with
+		* @param blasesChanged		True if any BLAS is built this frame
+		*/
+		ETLASBuildMode SelectBuildMode(uint32 instanceCount, uint32 builtInstanceCount, bool blasesChanged) const;
+
+		/*
+		* Clears the changes once they have been uploaded and the TLAS built with buildMode
+		*/
+		void Reset(ETLASBuildMode buildMode);
+
+		FORCEINLINE uint32 GetDirtyInstanceCount() const
+		{
+			return m_AllDirty ? UINT32_MAX : m_DirtyInstances.GetSize();
+		}
+
+		FORCEINLINE uint32 GetUpdatesSinceRebuild() const
+		{
+			return m_UpdatesSinceRebuild;
+		}
+
+	public:
+		static constexpr const uint32	MAX_RANGE_GAP				= 16;
+		static constexpr const uint32	MAX_UPDATES_BEFORE_REBUILD	= 60;
+		static constexpr const float32	REBUILD_DIRTY_FRACTION		= 0.5f;
+
+	private:
+		TArray<uint32>	m_DirtyInstances;
+		TArray<bool>	m_DirtyFlags;
+		bool			m_AllDirty				= false;
+		bool			m_GPUWritten			= false;
+		uint32			m_UpdatesSinceRebuild	= 0;
+	};
+}
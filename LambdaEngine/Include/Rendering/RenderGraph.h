@@ -15,6 +15,8 @@
 #include "Containers/String.h"
 
 #include "RenderGraphTypes.h"
+#include "RenderGraphBarrierPlanner.h"
+#include "RenderGraphAliasingPlanner.h"
 #include "RenderGraphEditor.h"
 
 #include "Utilities/StringHash.h"
@@ -37,6 +39,7 @@ namespace LambdaEngine
 	class PipelineLayout;
 	class PipelineState;
 	class DescriptorSet;
+	class MemoryHeap;
 	class DescriptorHeap;
 	class CustomRenderer;
 	class CommandList;
@@ -304,17 +307,28 @@ namespace LambdaEngine
 			TArray<PipelineBufferBarrierDesc>			BufferBarriers[2];
 			TArray<PipelineTextureBarrierDesc>			TextureBarriers[4];
 			TArray<TArray<PipelineTextureBarrierDesc>>	UnboundedTextureBarriers[2]; //Unbounded Arrays of textures do not have a known count at init time -> we cant store them densely
+
+			// Scratch arrays used when recording, all barriers with the same destination are merged into one pipeline barrier
+			TArray<PipelineTextureBarrierDesc>			MergedTextureBarriers[2];
+			TArray<PipelineBufferBarrierDesc>			MergedBufferBarriers[2];
 		};
 
 		struct PipelineStage
 		{
 			ERenderGraphPipelineStageType	Type							= ERenderGraphPipelineStageType::NONE;
 			uint32							StageIndex						= 0;
+			uint32							ExecutionStageIndex				= 0;	// First slot in m_ppExecutionStages, fixed so recording order does not affect submission order
+			uint32							AliasingExecutionStageIndex		= UINT32_MAX;	// Graphics and compute slot in front of ExecutionStageIndex if the stage starts the lifetime of transient textures
+			bool							UsesCustomRenderer				= false;
 
 			CommandAllocator** ppGraphicsCommandAllocators	= nullptr;
 			CommandAllocator** ppComputeCommandAllocators	= nullptr;
 			CommandList** ppGraphicsCommandLists			= nullptr;
 			CommandList** ppComputeCommandLists				= nullptr;
+
+			TArray<PipelineTextureBarrierDesc>	AliasingTextureBarriers[2];				// Graphics and compute queue
+			CommandAllocator**					ppAliasingCommandAllocators	= nullptr;	// Graphics then compute, one per back buffer each
+			CommandList**						ppAliasingCommandLists		= nullptr;
 		};
 
 	public:
@@ -373,6 +387,20 @@ namespace LambdaEngine
 		*/
 		void SetRenderStageSleeping(const String& renderStageName, bool sleeping);
 
+		/*
+		* Enables recording of pipeline stages on the thread pool, custom renderers are always recorded on the calling thread.
+		* Command lists are submitted in graph order regardless of the recording mode. Off by default, RenderSystem turns
+		* it on with CONFIG_OPTION_PARALLEL_RECORDING
+		*/
+		void SetParallelRecording(bool parallelRecording) { m_ParallelRecording = parallelRecording; }
+		bool IsParallelRecording() const { return m_ParallelRecording; }
+
+		/*
+		* Every submit of the graph signals the fence, GetSubmittedFenceValue is the value signaled by the last submit
+		*/
+		const Fence* GetFence() const { return s_pMaterialFence; }
+		uint64 GetSubmittedFenceValue() const { return m_SignalValue - 1; }
+
 		/*
 		* Updates the RenderGraph, applying the updates made to resources with UpdateResource by writing them to the appropriate Descriptor Sets
 		*/
@@ -415,6 +443,16 @@ namespace LambdaEngine
 		bool GetResourceBuffers(const char* pResourceName, Buffer* const ** pppBuffers, uint32* pBufferCount)									const;
 		bool GetResourceAccelerationStructure(const char* pResourceName, const AccelerationStructure** ppAccelerationStructure)					const;
 
+		/*
+		* Returns the transitions that were recorded or dropped and the number of pipeline barrier calls saved by merging
+		*/
+		const RenderGraphBarrierPlan& GetBarrierPlan() const { return m_BarrierPlan; }
+
+		/*
+		* Returns the lifetimes of the resources and where the transient textures are placed in the shared heap
+		*/
+		const RenderGraphAliasingPlan& GetAliasingPlan() const { return m_AliasingPlan; }
+
 	private:
 		bool OnPreSwapChainRecreated(const PreSwapChainRecreatedEvent& swapChainEvent);
 		bool OnPostSwapChainRecreated(const PostSwapChainRecreatedEvent& swapChainEvent);
@@ -427,7 +465,10 @@ namespace LambdaEngine
 		bool CreateCopyCommandLists();
 		bool CreateProfiler(uint32 pipelineStageCount);
 		bool CreateResources(const TArray<RenderGraphResourceDesc>& resourceDescriptions);
+		void PlanBarriers(const RenderGraphDesc* pDesc);
+		void PlanResourceAliasing(const RenderGraphDesc* pDesc);
 		
+		void LoadRenderStageShaders(const TArray<RenderStageDesc>& renderStages);
 		bool CreateRenderStages(
 			const TArray<RenderStageDesc>& renderStages, 
 			const THashTable<String, RenderGraphShaderConstants>& shaderConstants, 
@@ -437,12 +478,15 @@ namespace LambdaEngine
 		bool CreateSynchronizationStages(
 			const TArray<SynchronizationStageDesc>& synchronizationStageDescriptions, 
 			TSet<DrawArgMaskDesc>& requiredDrawArgMasks);
+		bool CoverReadAfterRead(Resource* pResource, ECommandQueueType queue, uint32 dstMemoryAccessFlags, FPipelineStageFlags firstPipelineStage);
 		bool CreatePipelineStages(const TArray<PipelineStageDesc>& pipelineStageDescriptions);
 		bool CreateDrawArgConfiguration();
 		bool CustomRenderStagesPostInit();
 
 		void UpdateRelativeParameters();
 		void UpdateInternalResource(InternalResourceUpdateDesc& desc);
+		bool PlaceTransientResources();
+		void UpdateAliasingBarriers();
 
 		void UpdateResourceTexture(Resource* pResource, const ResourceUpdateDesc* pDesc);
 		void UpdateResourceDrawArgs(Resource* pResource, const ResourceUpdateDesc* pDesc);
@@ -451,6 +495,10 @@ namespace LambdaEngine
 		void UpdateRelativeRenderStageDimensions(RenderStage* pRenderStage);
 		void UpdateRelativeResourceDimensions(InternalResourceUpdateDesc* pResourceUpdateDesc);
 
+		void RecordPipelineStage(uint32 pipelineStageIndex, bool profileCPU);
+		void RecordAliasingBarriers(PipelineStage* pPipelineStage);
+		void RecordPipelineStagesParallel();
+
 		void ExecuteSynchronizationStage(
 			SynchronizationStage* pSynchronizationStage,
 			CommandAllocator* pGraphicsCommandAllocator,
@@ -491,12 +539,23 @@ namespace LambdaEngine
 			FPipelineStageFlags srcPipelineStage, 
 			FPipelineStageFlags dstPipelineStage);
 
+		void PipelineBarriers(
+			CommandList* pCommandList, 
+			const TArray<PipelineTextureBarrierDesc>& textureBarriers, 
+			const TArray<PipelineBufferBarrierDesc>& bufferBarriers, 
+			FPipelineStageFlags srcPipelineStage, 
+			FPipelineStageFlags dstPipelineStage);
+
 	private:
 		const GraphicsDevice*							m_pGraphicsDevice;
 		GraphicsDeviceFeatureDesc						m_Features;
 
 		DescriptorHeap*									m_pDescriptorHeap					= nullptr;
 
+		RenderGraphBarrierPlan							m_BarrierPlan;
+		RenderGraphAliasingPlan							m_AliasingPlan;
+		MemoryHeap*										m_pTransientHeap					= nullptr;
+
 		float32											m_WindowWidth						= 0.0f;
 		float32											m_WindowHeight						= 0.0f;
 
@@ -522,6 +581,8 @@ namespace LambdaEngine
 
 		PipelineStage*									m_pPipelineStages					= nullptr;
 		uint32											m_PipelineStageCount				= 0;
+		TArray<uint32>									m_CustomRendererPipelineStages;
+		bool											m_ParallelRecording					= false;
 
 		THashTable<String, uint32>						m_RenderStageMap;
 		RenderStage*									m_pRenderStages						= nullptr;
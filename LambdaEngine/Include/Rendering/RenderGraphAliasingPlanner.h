@@ -0,0 +1,83 @@
+#pragma once
+
+#include "Rendering/RenderGraphTypes.h"
+
+#include "Containers/TArray.h"
+#include "Containers/String.h"
+
+namespace LambdaEngine
+{
+	struct RenderGraphResourcePlacement
+	{
+		String							ResourceName			= "";
+		bool							Transient				= false;	// Only transient resources are placed in the shared heap
+		bool							Aliased					= false;	// Shares memory with another placement and needs an aliasing barrier each frame
+		uint64							Offset					= 0;
+		uint64							SizeInBytes				= 0;
+		uint64							Alignment				= 1;
+		uint32							MemoryTypeBits			= UINT32_MAX;
+		uint32							FirstPipelineStage		= UINT32_MAX;
+		uint32							LastPipelineStage		= 0;
+		ERenderGraphResourceBindingType	FrameStartBindingType	= ERenderGraphResourceBindingType::NONE;	// State the first reference of each frame expects
+		ECommandQueueType				FrameStartQueue			= ECommandQueueType::COMMAND_QUEUE_TYPE_NONE;	// Queue of the first reference of each frame
+	};
+
+	struct RenderGraphAliasingBarrier
+	{
+		uint32 PlacementIndex	= 0;
+		uint32 PipelineStage	= 0;	// Recorded before this pipeline stage executes
+	};
+
+	struct RenderGraphAliasingPlan
+	{
+		TArray<RenderGraphResourcePlacement>	Placements;						// Same order as the resource descriptions
+		TArray<RenderGraphAliasingBarrier>		AliasingBarriers;				// Sorted by pipeline stage
+		uint64									HeapSizeInBytes					= 0;
+		uint32									HeapMemoryTypeBits				= UINT32_MAX;
+		uint64									TransientSizeWithoutAliasing	= 0;	// Transient resources with one allocation each
+	};
+
+	/*
+	* RenderGraphAliasingPlanner - Runs a lifetime analysis over the pipeline stages of a parsed render graph and places
+	* textures whose lifetimes do not overlap at shared offsets in one heap. The lifetime analysis only works on the
+	* structure from RenderGraphParser, sizes come from the device when RenderGraph creates the textures.
+	*
+	* A texture is transient if it is internal, GPU-local, backed by a single texture, not bound to the back buffer,
+	* synchronized by the render graph, only used by every frame stages without custom renderers and written before it
+	* is read each frame. Everything else may carry data between frames and keeps its own allocation. Stages that are
+	* put to sleep at runtime leave the content of their transient outputs undefined.
+	*
+	* A transient texture that shares memory with another one starts each frame with an aliasing barrier from an
+	* undefined layout to the state its first reference expects, recorded on the queue of that reference.
+	*/
+	class LAMBDA_API RenderGraphAliasingPlanner
+	{
+	public:
+		DECL_STATIC_CLASS(RenderGraphAliasingPlanner);
+
+		/**
+		* Finds the lifetime of every resource and marks the transient ones, sizes are left at zero
+		* @param structure	The parsed render graph
+		* @param plan		Receives one placement per resource description
+		*/
+		static void AnalyzeLifetimes(const RenderGraphStructureDesc& structure, RenderGraphAliasingPlan& plan);
+
+		/**
+		* Places the transient resources largest first at the lowest offset that is free during their whole lifetime
+		* and creates the aliasing barriers. SizeInBytes, Alignment and MemoryTypeBits of the transient placements have
+		* to be set, placements that do not share a memory type with the larger ones keep their own allocation.
+		* @param plan	A plan from AnalyzeLifetimes
+		*/
+		static void PlaceResources(RenderGraphAliasingPlan& plan);
+
+		FORCEINLINE static bool LifetimesOverlap(const RenderGraphResourcePlacement& lhs, const RenderGraphResourcePlacement& rhs)
+		{
+			return lhs.FirstPipelineStage <= rhs.LastPipelineStage && rhs.FirstPipelineStage <= lhs.LastPipelineStage;
+		}
+
+		FORCEINLINE static bool MemoryOverlaps(const RenderGraphResourcePlacement& lhs, const RenderGraphResourcePlacement& rhs)
+		{
+			return lhs.Offset < rhs.Offset + rhs.SizeInBytes && rhs.Offset < lhs.Offset + lhs.SizeInBytes;
+		}
+	};
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "Rendering/RenderGraphTypes.h"
+
+#include "Containers/TArray.h"
+#include "Containers/String.h"
+
+namespace LambdaEngine
+{
+	enum class ERenderGraphBarrierDropReason : uint8
+	{
+		NONE				= 0,
+		NOT_SYNCHRONIZED	= 1,	// The resource is never synchronized by the render graph
+		READ_AFTER_READ		= 2,	// Both sides only read on the same queue and the layout does not change, folded into the previous barrier of the resource
+		DUPLICATE			= 3,	// An identical transition of the same resource already exists in the stage
+	};
+
+	struct RenderGraphPlannedBarrier
+	{
+		String							ResourceName			= "";
+		ERenderGraphResourceType		Type					= ERenderGraphResourceType::NONE;
+		ECommandQueueType				PrevQueue				= ECommandQueueType::COMMAND_QUEUE_TYPE_NONE;
+		ECommandQueueType				NextQueue				= ECommandQueueType::COMMAND_QUEUE_TYPE_NONE;
+		ETextureState					StateBefore				= ETextureState::TEXTURE_STATE_UNKNOWN;
+		ETextureState					StateAfter				= ETextureState::TEXTURE_STATE_UNKNOWN;
+		uint32							SrcMemoryAccessFlags	= 0;
+		uint32							DstMemoryAccessFlags	= 0;
+		uint32							BarrierCount			= 0;	// Texture and buffer barriers recorded each frame for this synchronization
+		ERenderGraphBarrierDropReason	DropReason				= ERenderGraphBarrierDropReason::NONE;
+
+		FORCEINLINE bool IsDropped() const
+		{
+			return DropReason != ERenderGraphBarrierDropReason::NONE;
+		}
+	};
+
+	struct RenderGraphSynchronizationStagePlan
+	{
+		TArray<RenderGraphPlannedBarrier>	Barriers;						// Same order as the synchronizations in the stage description
+		uint32								BarrierCallsUnmerged	= 0;	// Pipeline barrier calls when every barrier group is recorded on its own
+		uint32								BarrierCallsMerged		= 0;	// Pipeline barrier calls with one call per queue and destination stage
+	};
+
+	struct RenderGraphBarrierPlan
+	{
+		TArray<RenderGraphSynchronizationStagePlan>	Stages;
+		uint32										DroppedTransitions		= 0;
+		uint32										BarrierCallsUnmerged	= 0;
+		uint32										BarrierCallsMerged		= 0;
+
+		FORCEINLINE uint32 GetSavedBarrierCalls() const
+		{
+			return BarrierCallsUnmerged - BarrierCallsMerged;
+		}
+	};
+
+	/*
+	* RenderGraphBarrierPlanner - Runs over the synchronization stages of a parsed render graph and decides which
+	* transitions have to be recorded. The parser already removes synchronizations between identical states, the
+	* planner also drops transitions that only order two reads without changing the layout and transitions that are
+	* listed twice. Like RenderGraphAliasingPlanner it never touches the device.
+	*
+	* Pipeline stages of custom renderers are not known here, so RenderGraph decides how a read after a read is covered.
+	* It widens the destination stage and access of the previous barrier of the resource to include the new reader, and
+	* keeps the transition when the resource has no previous barrier on the same queue.
+	*
+	* Barrier call counts assume that same queue and other queue barriers have different destination stages, which
+	* is the worst case for merging.
+	*/
+	class LAMBDA_API RenderGraphBarrierPlanner
+	{
+	public:
+		DECL_STATIC_CLASS(RenderGraphBarrierPlanner);
+
+		/**
+		* Creates a barrier plan for all synchronization stages in a parsed render graph
+		* @param structure	The parsed render graph
+		* @param plan		Receives one stage plan per synchronization stage
+		*/
+		static void Plan(const RenderGraphStructureDesc& structure, RenderGraphBarrierPlan& plan);
+
+		static bool IsReadOnlyBinding(ERenderGraphResourceBindingType bindingType);
+
+	private:
+		static uint32 CalculateBarrierCount(const RenderGraphResourceDesc& resourceDesc);
+		static uint32 CalculateBarrierCalls(uint32 textureBarrierCount, uint32 bufferBarrierCount);
+	};
+}
@@ -2,42 +2,111 @@
 
 #include "Rendering/Core/API/GraphicsTypes.h"
 
-#include "Time/API/Timestamp.h"
+#include "Memory/API/RingAllocator.h"
+#include "Memory/API/OffsetAllocator.h"
 
-#include "Containers/TArray.h"
+#include "Threading/API/SpinLock.h"
 
-#include <map>
+#include "Containers/TArray.h"
 
 namespace LambdaEngine
 {
 	class Buffer;
+	class Fence;
+
+	struct StagingBufferAllocation
+	{
+		Buffer*	pBuffer		= nullptr;
+		uint64	Offset		= 0;
+		uint64	SizeInBytes	= 0;
+		void*	pHostMemory	= nullptr;	// Already offset, stays mapped until the allocation is reclaimed
+	};
 
+	/*
+	* StagingBufferCache - Hands out upload memory that is valid for the current frame. Allocations are sub-ranges of a
+	* persistently mapped ring buffer and are reclaimed once the fence value of the submits that consumed them has
+	* completed. Allocations that are too large for the ring are sub-allocated from a persistently mapped overflow
+	* buffer instead, and only get a dedicated buffer when the overflow buffer is full. Both are released the same way.
+	* The overflow buffer only exists while it is needed, it is created by the first allocation the ring cannot take
+	* and released once it has been empty for OVERFLOW_RELEASE_FRAME_COUNT frames.
+	*/
 	class StagingBufferCache
 	{
-		struct SizeCompare
+		struct DedicatedBuffer
+		{
+			Buffer*	pBuffer		= nullptr;
+			uint64	FrameIndex	= 0;
+		};
+
+		struct OverflowAllocation
+		{
+			OffsetAllocation	Allocation;
+			uint64				FrameIndex	= 0;
+		};
+
+		// The fence value that covers every submit that may have used the allocations of a frame
+		struct FrameFence
 		{
-			bool operator()(uint64 requiredSize, uint64 bufferSize) const
-			{
-				return requiredSize < bufferSize;
-			}
+			uint64	FrameIndex	= 0;
+			uint64	FenceValue	= 0;
 		};
 
 	public:
 		DECL_STATIC_CLASS(StagingBufferCache);
 
+		static bool Init();
 		static bool Release();
-		static void Tick();
 
-		/*
-		*	Returns a Staging Buffer which should be used this frame.
-		*	The size of the buffer is guaranteed to be larger than or equal to the requested size.
+		/**
+		* Starts a new frame, called before the frame records any commands
+		* @param pFence					Fence signaled by the submits that consume the allocations
+		* @param submittedFenceValue	Value signaled by the last submit so far
 		*/
-		static Buffer* RequestBuffer(uint64 size);
+		static void Tick(const Fence* pFence, uint64 submittedFenceValue);
+
+		/**
+		* Allocates upload memory which should be used this frame
+		* @param sizeInBytes	Size of the allocation
+		* @param alignment		Alignment of the offset into the buffer, must be a power of two
+		* @return An allocation with pBuffer and pHostMemory set to nullptr if the allocation failed, asserts in development builds
+		*/
+		static StagingBufferAllocation Allocate(uint64 sizeInBytes, uint64 alignment = DEFAULT_ALIGNMENT);
+
+		FORCEINLINE static uint64 GetRingUsedBytes()
+		{
+			return s_Ring.GetUsedBytes();
+		}
+
+		FORCEINLINE static uint64 GetOverflowUsedBytes()
+		{
+			return s_pOverflowBuffer != nullptr ? s_OverflowAllocator.GetSizeInBytes() - s_OverflowAllocator.GetFreeBytes() : 0;
+		}
+
+	public:
+		static constexpr const uint64 RING_SIZE_IN_BYTES			= MEGA_BYTE(32);
+		static constexpr const uint64 OVERFLOW_SIZE_IN_BYTES		= MEGA_BYTE(64);
+		static constexpr const uint64 DEFAULT_ALIGNMENT				= 16;
+		static constexpr const uint64 OVERFLOW_RELEASE_FRAME_COUNT	= 120;
+
+	private:
+		static bool CreateOverflowBuffer();
+		static void ReleaseOverflowBuffer();
+		static bool AllocateOverflow(uint64 sizeInBytes, uint64 alignment, StagingBufferAllocation& allocation);
+		static StagingBufferAllocation AllocateDedicated(uint64 sizeInBytes);
 
 	private:
-		static std::multimap<uint64, Buffer*, SizeCompare> s_AvailableBuffers[BACK_BUFFER_COUNT];
-		static TArray<Buffer*>	s_StagedBuffers[BACK_BUFFER_COUNT];
-		static uint32 s_ModFrameIndex;
-		static uint32 s_BufferIndex;
+		static Buffer*						s_pRingBuffer;
+		static byte*						s_pRingHostMemory;
+		static RingAllocator				s_Ring;
+		static Buffer*						s_pOverflowBuffer;
+		static byte*						s_pOverflowHostMemory;
+		static OffsetAllocator				s_OverflowAllocator;
+		static TArray<OverflowAllocation>	s_OverflowAllocations;
+		static uint64						s_OverflowLastUsedFrameIndex;
+		static TArray<DedicatedBuffer>		s_DedicatedBuffers;
+		static TArray<FrameFence>			s_FrameFences;
+		static uint64						s_FrameIndex;
+		static uint32						s_BufferIndex;
+		static SpinLock						s_Lock;
 	};
-}
\ No newline at end of file
+}
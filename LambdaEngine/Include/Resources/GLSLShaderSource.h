@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Containers/String.h"
+#include "Containers/TArray.h"
 
 #include "Rendering/Core/API/GraphicsTypes.h"
 
@@ -25,6 +26,9 @@ namespace LambdaEngine
 
 		Shader* Compile(const String& name, const String& defines);
 
+	private:
+		bool CompileToSPIRV(const String& preprocessedGLSL, const String& defines, TArray<uint32>& sourceSPIRV);
+
 	private:
 		GLSLShaderSourceDesc m_Desc;
 	};	
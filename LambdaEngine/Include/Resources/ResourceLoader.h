@@ -16,6 +16,7 @@
 
 #include "Material.h"
 #include "Mesh.h"
+#include "TextureDecoder.h"
 
 namespace glslang
 {
@@ -31,6 +32,14 @@ namespace LambdaEngine
 {
 	class GLSLShaderSource;
 
+	struct ShaderFileLoadDesc
+	{
+		String				Filepath	= "";
+		FShaderStageFlag	Stage		= FShaderStageFlag::SHADER_STAGE_FLAG_NONE;
+		EShaderLang			Lang		= EShaderLang::SHADER_LANG_NONE;
+		String				EntryPoint	= "main";
+	};
+
 	struct LevelObjectOnLoadDesc
 	{
 		String	Prefix		= "";
@@ -97,6 +106,8 @@ namespace LambdaEngine
 		TArray<LoadedMaterial*>*				pMaterials;
 		TArray<LoadedTexture*>*					pTextures;
 		THashTable<String, LoadedTexture*>		LoadedTextures;
+		THashTable<String, const DecodedImage*>	PrefetchedImages;
+		DecodedImageBatch						PrefetchedImageBatch;
 		THashTable<uint32, uint32>				MaterialIndices;
 		bool									ShouldTessellate;
 	};
@@ -245,6 +256,25 @@ namespace LambdaEngine
 			bool generateMips,
 			bool linearFilteringMips);
 
+		/**
+		* Create a Texture Array from complete mip chains, with every array layer stored as miplevel 0 followed by the smaller levels
+		* @param ppMipChains		Array of arrayCount mip chains
+		* @param miplevels			Number of miplevels in the texture
+		* @param generateMipsOnGPU	If true, only miplevel 0 is read from ppMipChains and the rest are generated with blits
+		* @return A Texture* if the texture was loaded, otherwise nullptr will be returned
+		*/
+		static Texture* UploadTextureArray(
+			const String& name,
+			const void* const * ppMipChains,
+			uint32 arrayCount,
+			uint32 width,
+			uint32 height,
+			EFormat format,
+			uint32 usageFlags,
+			uint32 miplevels,
+			bool generateMipsOnGPU,
+			bool linearFilteringMips);
+
 		/**
 		* Load sound from file
 		* @param filepath	Path to the shader file
@@ -259,6 +289,21 @@ namespace LambdaEngine
 			EShaderLang lang,
 			const String& entryPoint = "main");
 
+		/**
+		* Load several shaders from file, the shaders are compiled in parallel on the thread pool
+		* @param pLoadDescs	Array of shaderCount descriptions of the shaders to load
+		* @param shaderCount	Number of shaders to load
+		* @param ppShaders		Array of shaderCount pointers that are set to the loaded shaders, nullptr for shaders that failed
+		*/
+		static void LoadShadersFromFile(const ShaderFileLoadDesc* pLoadDescs, uint32 shaderCount, Shader** ppShaders);
+
+		/**
+		* Compiles every GLSL shader found in a directory and its subdirectories to SPIR-V, without creating any shaders
+		* @param directory	The root directory to search, usually SHADER_DIR
+		* @return The number of shaders that compiled successfully
+		*/
+		static uint32 CompileShaderDirectory(const String& directory);
+
 		static bool CreateShaderReflection(
 			const String& filepath,
 			FShaderStageFlag stage,
@@ -309,6 +354,27 @@ namespace LambdaEngine
 
 		static bool ReadDataFromFile(const String& filepath, const char* pMode, byte** ppData, uint32* pDataSize);
 
+		/**
+		* Generates and writes meshlet cache entries for every mesh file found in a directory and its subdirectories.
+		* Cache entries are keyed on the loaded vertices, so the files must be loaded the same way they are at runtime
+		* @param directory			The root directory to search, usually MESH_DIR or SCENE_DIR
+		* @param assimpFlags		The flags the files are loaded with at runtime, see GetSceneAssimpFlags and GetMeshAssimpFlags
+		* @param shouldTessellate	If the files are tessellated when they are loaded at runtime
+		* @return The number of meshes that the cache now contains entries for
+		*/
+		static uint32 BakeMeshletCache(const String& directory, int32 assimpFlags, bool shouldTessellate);
+
+		/*
+		* Assimp post processing flags of scenes loaded with LoadSceneFromFile
+		*/
+		static int32 GetSceneAssimpFlags();
+
+		/*
+		* Assimp post processing flags of single meshes loaded through ResourceManager
+		* @param fixInfacingNormals	Set when the mesh is loaded together with its material
+		*/
+		static int32 GetMeshAssimpFlags(bool fixInfacingNormals);
+
 	private:
 		static bool InitCubemapGen();
 		static void ReleaseCubemapGen();
@@ -327,10 +393,33 @@ namespace LambdaEngine
 			const aiScene* pScene,
 			const void* pParentTransform);
 
+		static void PrefetchSceneTextures(SceneLoadingContext& context, const aiScene* pScene);
+
+		static bool CompileShaderFileToSPIRV(
+			const String& filepath,
+			FShaderStageFlag stage,
+			EShaderLang lang,
+			const String& entryPoint,
+			TArray<uint32>& sourceSPIRV);
+
+		static void CompileShaderFilesParallel(
+			const ShaderFileLoadDesc* pLoadDescs,
+			uint32 shaderCount,
+			TArray<uint32>* pSourcesSPIRV);
+
+		static Shader* CreateShaderFromSPIRV(
+			const String& name,
+			const TArray<uint32>& sourceSPIRV,
+			FShaderStageFlag stage,
+			EShaderLang lang,
+			const String& entryPoint);
+
 		static bool CompileGLSLToSPIRV(
 			const String& filepath,
 			const char* pSource,
 			FShaderStageFlags stage,
+			const String& entryPoint,
+			const String& defines,
 			TArray<uint32>* pSourceSPIRV,
 			ShaderReflection* pReflection);
 
@@ -340,8 +429,12 @@ namespace LambdaEngine
 			ShaderReflection* pReflection);
 
 		/*	LoadMeshletsFromCache attempts to load meshlet data from file.
-			If it does not exist, meshlets will be generated and written to file. */
-		static void LoadMeshletsFromCache(const String& name, Mesh* pMesh);
+			The cache is keyed on the vertex and index data together with MAX_VERTS and MAX_PRIMS.
+			If no valid entry exists, meshlets will be generated and written to file. */
+		static void LoadMeshletsFromCache(Mesh* pMesh);
+
+		/*	Runs LoadMeshletsFromCache for all meshes in parallel on the ThreadPool */
+		static void LoadMeshletsFromCacheParallel(Mesh* const* ppMeshes, uint32 meshCount);
 
 	private:
 		// Cubemap gen
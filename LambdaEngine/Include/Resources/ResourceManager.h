@@ -44,7 +44,7 @@ namespace LambdaEngine
 			String				Filepath	= "";
 			FShaderStageFlag	Stage		= FShaderStageFlag::SHADER_STAGE_FLAG_NONE;
 			EShaderLang			Lang		= EShaderLang::SHADER_LANG_NONE;
-			const char*			pEntryPoint	= nullptr;
+			String				EntryPoint	= "main";
 		};
 
 	public:
@@ -311,6 +311,14 @@ namespace LambdaEngine
 		*/
 		static GUID_Lambda LoadShaderFromFile(const String& filename, FShaderStageFlag stage, EShaderLang lang, const char* pEntryPoint = "main");
 
+		/**
+		* Load several shaders from file, shaders that are not already loaded are compiled in parallel on the thread pool
+		* @param pLoadDescs		Array of shaderCount descriptions, Filepath is the name of the shader file as in LoadShaderFromFile
+		* @param shaderCount	Number of shaders to load
+		* @param pGUIDs			Array of shaderCount GUIDs that are set to the GUIDs of the shaders
+		*/
+		static void LoadShadersFromFile(const ShaderFileLoadDesc* pLoadDescs, uint32 shaderCount, GUID_Lambda* pGUIDs);
+
 		static GUID_Lambda RegisterShader(const String& name, Shader* pShader);
 
 		/**
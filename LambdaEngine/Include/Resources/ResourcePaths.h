@@ -8,5 +8,7 @@ namespace LambdaEngine
 	constexpr const char* ANIMATIONS_DIR	= MESH_DIR; // Equal to mesh dir for now
 	constexpr const char* TEXTURE_DIR		= "../Assets/Textures/";
 	constexpr const char* SHADER_DIR		= "../Assets/Shaders/";
+	constexpr const char* SHADER_CACHE_DIR	= "../Assets/ShaderCache/";
+	constexpr const char* PIPELINE_CACHE_FILE	= "../Assets/ShaderCache/PipelineCache.bin";
 	constexpr const char* SOUND_DIR			= "../Assets/Sounds/";
 }
\ No newline at end of file
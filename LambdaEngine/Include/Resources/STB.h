@@ -1,4 +1,10 @@
 #pragma once
+#include "Resources/TextureDecoder.h"
+
+// Allocations are routed through the TextureDecoder so that images decoded on the thread pool end up in an arena
+#define STBI_MALLOC(size)								LambdaEngine::TextureDecoder::Allocate(size)
+#define STBI_REALLOC_SIZED(pMemory, oldSize, newSize)	LambdaEngine::TextureDecoder::Reallocate(pMemory, oldSize, newSize)
+#define STBI_FREE(pMemory)								LambdaEngine::TextureDecoder::Free(pMemory)
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
\ No newline at end of file
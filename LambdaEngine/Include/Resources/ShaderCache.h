@@ -0,0 +1,74 @@
+#pragma once
+#include "LambdaEngine.h"
+
+#include "Containers/TArray.h"
+#include "Containers/String.h"
+
+#include "Rendering/Core/API/GraphicsTypes.h"
+
+#include <atomic>
+
+namespace LambdaEngine
+{
+	/*
+	* ShaderCache - Persistent on-disk cache of compiled SPIR-V. Entries are keyed on the preprocessed
+	* source, so edits to included files invalidate the entry as well. Every entry is stored in its own
+	* file which makes it safe to read and write entries from several threads at once.
+	*/
+	class LAMBDA_API ShaderCache
+	{
+	public:
+		DECL_STATIC_CLASS(ShaderCache);
+
+		/**
+		* Calculates the key of a cache entry
+		* @param preprocessedSource	The GLSL source after preprocessing, includes are resolved
+		* @param stage				Which stage the shader belongs to
+		* @param defines			Defines that were set as the preamble when the source was preprocessed
+		* @param entryPoint			The name of the shader entrypoint
+		* @return A key that also covers the glslang version, its target environment and the cache version
+		*/
+		static uint64 CalculateKey(const String& preprocessedSource, FShaderStageFlags stage, const String& defines, const String& entryPoint);
+
+		/**
+		* Loads an entry from the cache, the entry is validated before it is returned
+		* @param key			Key returned from CalculateKey
+		* @param sourceSPIRV	Filled with the cached SPIR-V if the entry was found
+		* @return True if a valid entry was found
+		*/
+		static bool Load(uint64 key, TArray<uint32>& sourceSPIRV);
+
+		/**
+		* Writes an entry to the cache, failing to write is not considered an error
+		* @param key			Key returned from CalculateKey
+		* @param sourceSPIRV	The compiled SPIR-V
+		*/
+		static void Store(uint64 key, const TArray<uint32>& sourceSPIRV);
+
+		/*
+		* Removes all entries from the cache directory
+		*/
+		static void Clear();
+
+		static void ResetStatistics();
+
+		FORCEINLINE static void SetEnabled(bool enabled)	{ s_Enabled = enabled; }
+		FORCEINLINE static bool IsEnabled()					{ return s_Enabled; }
+
+		FORCEINLINE static uint32 GetHitCount()		{ return s_HitCount; }
+		FORCEINLINE static uint32 GetMissCount()	{ return s_MissCount; }
+
+	private:
+		static String GetEntryPath(uint64 key);
+
+		/*
+		* Version of glslang and its SPIR-V generator that the engine is linked against
+		*/
+		static const String& GetCompilerVersion();
+
+	private:
+		static std::atomic_bool		s_Enabled;
+		static std::atomic_uint32_t	s_HitCount;
+		static std::atomic_uint32_t	s_MissCount;
+	};
+}
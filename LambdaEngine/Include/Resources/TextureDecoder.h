@@ -0,0 +1,133 @@
+#pragma once
+#include "LambdaEngine.h"
+
+#include "Containers/TArray.h"
+#include "Containers/String.h"
+
+#include "Rendering/Core/API/GraphicsTypes.h"
+
+#include <mutex>
+
+namespace LambdaEngine
+{
+	/*
+	* ImageArena - Linear allocator used for decoded images. Blocks are sized from the allocations that are made,
+	* and kept when the arena is reset, so a warm arena decodes new images without touching the system allocator.
+	*/
+	class ImageArena
+	{
+		struct Block
+		{
+			byte*	pMemory	= nullptr;
+			uint64	Size	= 0;
+		};
+
+	public:
+		ImageArena() = default;
+		~ImageArena();
+
+		void* Allocate(uint64 size);
+
+		/*
+		* Makes sure that the following allocations of up to size bytes in total are placed in the same block
+		*/
+		void Reserve(uint64 size);
+		void* Reallocate(void* pMemory, uint64 oldSize, uint64 newSize);
+		bool Owns(const void* pMemory) const;
+		void Reset();
+
+		/*
+		* Resets the arena and frees every block except the first, which is only kept if it is small enough to be pooled
+		*/
+		void Trim();
+
+		FORCEINLINE uint64 GetReservedSize() const { return m_ReservedSize; }
+
+	private:
+		TArray<Block>	m_Blocks;
+		uint32			m_CurrentBlock		= 0;
+		uint64			m_BlockOffset		= 0;
+		uint64			m_ReservedSize		= 0;
+		void*			m_pLastAllocation	= nullptr;
+	};
+
+	struct DecodedImage
+	{
+		String	Filepath	= "";
+		void*	pPixels		= nullptr;	// Full mip chain, level 0 first
+		uint32	Width		= 0;
+		uint32	Height		= 0;
+		uint32	Miplevels	= 0;
+		bool	Succeeded	= false;
+	};
+
+	struct DecodedImageBatch
+	{
+		TArray<DecodedImage>	Images;
+		TArray<ImageArena*>		Arenas;
+	};
+
+	/*
+	* TextureDecoder - Decodes image files in parallel on the thread pool and generates mip chains on the CPU,
+	* which lets a texture with all of its miplevels be uploaded with a single staging copy.
+	*/
+	class LAMBDA_API TextureDecoder
+	{
+	public:
+		DECL_STATIC_CLASS(TextureDecoder);
+
+		/**
+		* Decodes a set of image files in parallel
+		* @param pFilepaths			Array of count paths to decode
+		* @param count				Number of files
+		* @param format				Format to decode into, FORMAT_R8G8B8A8_UNORM or FORMAT_R16G16B16A16_UNORM
+		* @param generateMips		If a full mip chain should be generated for each image
+		* @param linearFilteringMips	Box filter if true, otherwise point sampling
+		* @param batch				Receives the images, must be released with ReleaseBatch
+		* @return True if every file was decoded
+		*/
+		static bool DecodeFiles(
+			const String* pFilepaths,
+			uint32 count,
+			EFormat format,
+			bool generateMips,
+			bool linearFilteringMips,
+			DecodedImageBatch& batch);
+
+		/*
+		* Returns the arenas of a batch to the pool, the pixels of the batch are invalid afterwards.
+		* Returned arenas are trimmed and at most MAX_POOLED_IMAGE_ARENAS are kept, the rest are freed.
+		*/
+		static void ReleaseBatch(DecodedImageBatch& batch);
+
+		static ImageArena* AcquireArena();
+		static void ReleaseArena(ImageArena* pArena);
+
+		/*
+		* Frees the memory of all arenas that are not in use
+		*/
+		static void ReleaseArenaPool();
+
+		static bool SupportsCPUMips(EFormat format);
+		static uint32 CalculateMiplevels(uint32 width, uint32 height);
+		static uint64 CalculateMipChainSize(uint32 width, uint32 height, uint32 miplevels, EFormat format);
+
+		/**
+		* Generates miplevel 1 and onwards from miplevel 0, which must already be stored at the start of pMipChain
+		* @param pMipChain				Memory of at least CalculateMipChainSize bytes
+		* @param linearFilteringMips	Box filter if true, otherwise point sampling
+		*/
+		static void GenerateMipChain(void* pMipChain, uint32 width, uint32 height, uint32 miplevels, EFormat format, bool linearFilteringMips);
+
+		/*
+		* Allocation hooks used by stb_image, allocations go to the arena bound to the calling thread if there is one
+		*/
+		static void* Allocate(size_t size);
+		static void* Reallocate(void* pMemory, size_t oldSize, size_t newSize);
+		static void Free(void* pMemory);
+
+	private:
+		static TArray<ImageArena*>	s_FreeArenas;
+		static std::mutex			s_ArenaLock;
+	};
+}
@@ -40,6 +40,14 @@ namespace LambdaEngine
 		static void Join(uint32 joinResourcesIndex);
 		static void JoinAll();
 
+		/*
+		* Calls func once for every index in [0, count). Indices are claimed from a shared counter by detached pool jobs
+		* and by the calling thread, which keeps claiming until none are left instead of blocking in Join(). This makes
+		* it safe to call from a pool thread. Returns once every call has finished.
+		* callerFunc, if set, runs on the calling thread after the pool jobs are scheduled and before it starts claiming indices.
+		*/
+		static void ParallelFor(uint32 count, const std::function<void(uint32)>& func, const std::function<void()>& callerFunc = nullptr);
+
 		static uint32 GetThreadCount() { return s_Threads.GetSize(); }
 
 	private:
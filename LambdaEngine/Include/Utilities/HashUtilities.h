@@ -5,6 +5,9 @@
 
 namespace LambdaEngine
 {
+	constexpr const uint64 FNV1A_64_OFFSET_BASIS	= 14695981039346656037ull;
+	constexpr const uint64 FNV1A_64_PRIME			= 1099511628211ull;
+
 	template<typename T>
 	inline size_t HashCombine(size_t& hash, const T& value)
 	{
@@ -12,4 +15,26 @@ namespace LambdaEngine
 		hash ^= hasher(value) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
 		return hash;
 	}
-}
\ No newline at end of file
+
+	/*
+	* 64-bit FNV-1a hash of a block of memory. Unlike std::hash the result is stable between runs,
+	* which makes it usable as a key for data that is written to disk.
+	*/
+	inline uint64 HashMemory(const void* pData, size_t sizeInBytes, uint64 hash = FNV1A_64_OFFSET_BASIS)
+	{
+		const byte* pBytes = reinterpret_cast<const byte*>(pData);
+		for (size_t i = 0; i < sizeInBytes; i++)
+		{
+			hash ^= uint64(pBytes[i]);
+			hash *= FNV1A_64_PRIME;
+		}
+
+		return hash;
+	}
+
+	template<typename T>
+	inline uint64 HashValue(const T& value, uint64 hash = FNV1A_64_OFFSET_BASIS)
+	{
+		return HashMemory(&value, sizeof(T), hash);
+	}
+}
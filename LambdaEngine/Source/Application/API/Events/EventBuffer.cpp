@@ -0,0 +1,353 @@
+#include "Application/API/Events/EventBuffer.h"
+
+#include "Containers/TArray.h"
+
+#include "Math/MathUtilities.h"
+
+#include "Log/Log.h"
+
+namespace LambdaEngine
+{
+	/*
+	* EventBlock - Events of one producer. The producer sets pNext when the block is full and never writes to it again,
+	* so a block that has a next block can be read to its end
+	*/
+
+	struct EventBlock
+	{
+		std::atomic<EventBlock*>	pNext;
+		std::atomic_uint32_t		EventCount;
+		uint32						UsedBytes;
+		EventBlock*					pNextFree;
+		alignas(EventBuffer::EVENT_ALIGNMENT) byte Data[EventBuffer::EVENT_BLOCK_SIZE];
+
+		FORCEINLINE void Reset()
+		{
+			pNext.store(nullptr, std::memory_order_relaxed);
+			EventCount.store(0, std::memory_order_relaxed);
+			UsedBytes	= 0;
+			pNextFree	= nullptr;
+		}
+	};
+
+	/*
+	* EventProducer - The blocks of one thread. The write state is only touched by the thread that owns the producer
+	* and the read state only by the thread that dispatches, they are padded onto separate cache lines
+	*/
+
+	static constexpr const uint32 CACHE_LINE_SIZE = 64;
+
+	enum EEventProducerState : uint32
+	{
+		EVENT_PRODUCER_STATE_OWNED		= 0,	// Used by a thread
+		EVENT_PRODUCER_STATE_RETIRED	= 1,	// The thread has exited, the next thread to push may take it
+		EVENT_PRODUCER_STATE_ORPHANED	= 2,	// The buffer has been destroyed while the thread was alive
+	};
+
+	struct EventProducer
+	{
+		// Write state
+		EventBlock*					pWriteBlock		= nullptr;
+		EventBlock*					pFreeBlocks		= nullptr;
+		byte						WritePadding[CACHE_LINE_SIZE];
+
+		// Blocks that have been read, returned by the dispatching thread
+		std::atomic<EventBlock*>	pReturnedBlocks	= nullptr;
+		byte						ReturnPadding[CACHE_LINE_SIZE];
+
+		// Read state
+		EventBlock*					pReadBlock		= nullptr;
+		uint32						ReadIndex		= 0;
+		uint32						ReadOffset		= 0;
+		EventBlock*					pSealedBlock	= nullptr;
+		uint32						SealedCount		= 0;
+
+		std::atomic_uint32_t		State			= EVENT_PRODUCER_STATE_OWNED;
+		EventProducer*				pNext			= nullptr;
+	};
+
+	/*
+	* ThreadEventProducers - The producers of the calling thread, looked up by the ID of their buffer. Buffer IDs are
+	* never reused, so the entry of a destroyed buffer never matches a new buffer. A thread keeps its producer for as
+	* long as the buffer lives, giving it up would let the thread take another producer of the same buffer and events
+	* that are still in the first one would be dispatched after newer events. Entries of destroyed buffers are removed
+	* when the thread needs a new producer
+	*/
+
+	struct ThreadEventProducers
+	{
+		struct Entry
+		{
+			uint64			BufferID	= 0;
+			EventProducer*	pProducer	= nullptr;
+		};
+
+		TArray<Entry>	Entries;
+		uint32			LastEntry = 0;
+
+		~ThreadEventProducers()
+		{
+			for (Entry& entry : Entries)
+			{
+				Retire(entry.pProducer);
+			}
+		}
+
+		// Deletes the producers of buffers that have been destroyed
+		void RemoveOrphanedEntries()
+		{
+			for (uint32 e = 0; e < Entries.GetSize();)
+			{
+				EventProducer* pProducer = Entries[e].pProducer;
+				if (pProducer->State.load(std::memory_order_acquire) == EVENT_PRODUCER_STATE_ORPHANED)
+				{
+					delete pProducer;
+					Entries[e] = Entries.GetBack();
+					Entries.PopBack();
+				}
+				else
+				{
+					e++;
+				}
+			}
+
+			LastEntry = 0;
+		}
+
+		static void Retire(EventProducer* pProducer)
+		{
+			// The buffer has already been destroyed, the producer is left for the thread to delete
+			if (pProducer && pProducer->State.exchange(EVENT_PRODUCER_STATE_RETIRED, std::memory_order_acq_rel) == EVENT_PRODUCER_STATE_ORPHANED)
+			{
+				delete pProducer;
+			}
+		}
+	};
+
+	static std::atomic_uint64_t g_NextEventBufferID = 1;
+	static thread_local ThreadEventProducers g_ThreadEventProducers;
+
+	/*
+	* EventBuffer
+	*/
+
+	EventBuffer::EventBuffer()
+		: m_BufferID(g_NextEventBufferID.fetch_add(1, std::memory_order_relaxed))
+		, m_pProducers(nullptr)
+		, m_ProducerCount(0)
+	{
+	}
+
+	EventBuffer::~EventBuffer()
+	{
+		Clear();
+
+		EventProducer* pProducer = m_pProducers.load(std::memory_order_acquire);
+		while (pProducer)
+		{
+			EventProducer* pNextProducer = pProducer->pNext;
+
+			EventBlock* pFreeBlocks[] = { pProducer->pReadBlock, pProducer->pFreeBlocks, pProducer->pReturnedBlocks.load(std::memory_order_acquire) };
+			for (uint32 b = 0; b < ARR_SIZE(pFreeBlocks); b++)
+			{
+				EventBlock* pBlock = pFreeBlocks[b];
+				while (pBlock)
+				{
+					// The blocks that have been read are linked through pNextFree, the ones that have not through pNext
+					EventBlock* pNextBlock = b == 0 ? pBlock->pNext.load(std::memory_order_acquire) : pBlock->pNextFree;
+					delete pBlock;
+					pBlock = pNextBlock;
+				}
+			}
+
+			// A thread that is still alive deletes the producer when it exits
+			if (pProducer->State.exchange(EVENT_PRODUCER_STATE_ORPHANED, std::memory_order_acq_rel) == EVENT_PRODUCER_STATE_RETIRED)
+			{
+				delete pProducer;
+			}
+
+			pProducer = pNextProducer;
+		}
+	}
+
+	void EventBuffer::Seal()
+	{
+		for (EventProducer* pProducer = m_pProducers.load(std::memory_order_acquire); pProducer; pProducer = pProducer->pNext)
+		{
+			EventBlock* pBlock = pProducer->pSealedBlock;
+
+			EventBlock* pNextBlock = nullptr;
+			while ((pNextBlock = pBlock->pNext.load(std::memory_order_acquire)) != nullptr)
+			{
+				pBlock = pNextBlock;
+			}
+
+			pProducer->pSealedBlock	= pBlock;
+			pProducer->SealedCount	= pBlock->EventCount.load(std::memory_order_acquire);
+		}
+	}
+
+	void EventBuffer::Clear()
+	{
+		Seal();
+		Dispatch([](Event& event)
+			{
+				UNREFERENCED_VARIABLE(event);
+			});
+	}
+
+	EventProducer* EventBuffer::GetThreadProducer()
+	{
+		ThreadEventProducers& threadProducers = g_ThreadEventProducers;
+
+		// Threads mostly push to one buffer, the entry that was used last is checked first
+		TArray<ThreadEventProducers::Entry>& entries = threadProducers.Entries;
+		if (threadProducers.LastEntry < entries.GetSize() && entries[threadProducers.LastEntry].BufferID == m_BufferID)
+		{
+			return entries[threadProducers.LastEntry].pProducer;
+		}
+
+		for (uint32 e = 0; e < entries.GetSize(); e++)
+		{
+			if (entries[e].BufferID == m_BufferID)
+			{
+				threadProducers.LastEntry = e;
+				return entries[e].pProducer;
+			}
+		}
+
+		threadProducers.RemoveOrphanedEntries();
+
+		// Take the producer of a thread that has exited before creating a new one
+		EventProducer* pProducer = nullptr;
+		for (EventProducer* pRetired = m_pProducers.load(std::memory_order_acquire); pRetired && !pProducer; pRetired = pRetired->pNext)
+		{
+			uint32 expected = EVENT_PRODUCER_STATE_RETIRED;
+			if (pRetired->State.compare_exchange_strong(expected, EVENT_PRODUCER_STATE_OWNED, std::memory_order_acq_rel))
+			{
+				pProducer = pRetired;
+			}
+		}
+
+		if (!pProducer)
+		{
+			pProducer = CreateProducer();
+		}
+
+		threadProducers.LastEntry = entries.GetSize();
+		entries.PushBack({ m_BufferID, pProducer });
+		return pProducer;
+	}
+
+	EventProducer* EventBuffer::CreateProducer()
+	{
+		EventBlock* pBlock = DBG_NEW EventBlock();
+		pBlock->Reset();
+
+		EventProducer* pProducer = DBG_NEW EventProducer();
+		pProducer->pWriteBlock	= pBlock;
+		pProducer->pReadBlock	= pBlock;
+		pProducer->pSealedBlock	= pBlock;
+
+		// Producers are only ever added to the front, so the list can be walked while threads add producers
+		EventProducer* pHead = m_pProducers.load(std::memory_order_relaxed);
+		do
+		{
+			pProducer->pNext = pHead;
+		} while (!m_pProducers.compare_exchange_weak(pHead, pProducer, std::memory_order_release, std::memory_order_relaxed));
+
+		m_ProducerCount.fetch_add(1, std::memory_order_relaxed);
+		return pProducer;
+	}
+
+	void* EventBuffer::BeginPush(EventProducer* pProducer, uint32 sizeInBytes)
+	{
+		// Checked in every configuration, a record that does not fit in a block would be written past its end
+		if (sizeInBytes > MAX_EVENT_SIZE)
+		{
+			LOG_ERROR("[EventBuffer]: Rejected an event of %u bytes, events can be at most %u bytes", sizeInBytes, MAX_EVENT_SIZE);
+			return nullptr;
+		}
+
+		const uint32 recordSize = uint32(AlignUp(EVENT_HEADER_SIZE + sizeInBytes, EVENT_ALIGNMENT));
+
+		EventBlock* pBlock = pProducer->pWriteBlock;
+		if (pBlock->UsedBytes + recordSize > EVENT_BLOCK_SIZE)
+		{
+			// Reuse the blocks the dispatching thread has returned before allocating a new one
+			if (!pProducer->pFreeBlocks)
+			{
+				pProducer->pFreeBlocks = pProducer->pReturnedBlocks.exchange(nullptr, std::memory_order_acquire);
+			}
+
+			EventBlock* pNewBlock = pProducer->pFreeBlocks;
+			if (pNewBlock)
+			{
+				pProducer->pFreeBlocks = pNewBlock->pNextFree;
+			}
+			else
+			{
+				pNewBlock = DBG_NEW EventBlock();
+			}
+
+			pNewBlock->Reset();
+			pBlock->pNext.store(pNewBlock, std::memory_order_release);
+
+			pProducer->pWriteBlock = pNewBlock;
+			pBlock = pNewBlock;
+		}
+
+		byte* pRecord = pBlock->Data + pBlock->UsedBytes;
+		*reinterpret_cast<uint32*>(pRecord) = recordSize;
+		pBlock->UsedBytes += recordSize;
+
+		return pRecord + EVENT_HEADER_SIZE;
+	}
+
+	void EventBuffer::EndPush(EventProducer* pProducer)
+	{
+		// Only the producer writes the count, the release makes the event visible to the dispatching thread
+		std::atomic_uint32_t& eventCount = pProducer->pWriteBlock->EventCount;
+		eventCount.store(eventCount.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+	}
+
+	Event* EventBuffer::ReadEvent(EventProducer* pProducer)
+	{
+		for (;;)
+		{
+			EventBlock* pBlock = pProducer->pReadBlock;
+
+			// Blocks before the sealed block are full and are read to their end
+			const bool isSealedBlock	= pBlock == pProducer->pSealedBlock;
+			const uint32 eventCount		= isSealedBlock ? pProducer->SealedCount : pBlock->EventCount.load(std::memory_order_acquire);
+			if (pProducer->ReadIndex < eventCount)
+			{
+				byte* pRecord = pBlock->Data + pProducer->ReadOffset;
+				pProducer->ReadOffset += *reinterpret_cast<const uint32*>(pRecord);
+				pProducer->ReadIndex++;
+				return reinterpret_cast<Event*>(pRecord + EVENT_HEADER_SIZE);
+			}
+
+			if (isSealedBlock)
+			{
+				return nullptr;
+			}
+
+			pProducer->pReadBlock	= pBlock->pNext.load(std::memory_order_acquire);
+			pProducer->ReadIndex	= 0;
+			pProducer->ReadOffset	= 0;
+
+			// Give the block back to the producer, which is the only thread that takes blocks from the list
+			EventBlock* pHead = pProducer->pReturnedBlocks.load(std::memory_order_relaxed);
+			do
+			{
+				pBlock->pNextFree = pHead;
+			} while (!pProducer->pReturnedBlocks.compare_exchange_weak(pHead, pBlock, std::memory_order_release, std::memory_order_relaxed));
+		}
+	}
+
+	EventProducer* EventBuffer::GetNextProducer(EventProducer* pProducer)
+	{
+		return pProducer->pNext;
+	}
+}
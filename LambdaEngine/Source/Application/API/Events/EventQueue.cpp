@@ -32,10 +32,7 @@ namespace LambdaEngine
 	* EventQueue
 	*/
 
-	SpinLock		EventQueue::s_WriteLock;
-	EventContainer	EventQueue::s_DeferredEvents[2];
-	uint32			EventQueue::s_ReadIndex		= 0;
-	uint32			EventQueue::s_WriteIndex	= 1;
+	EventBuffer EventQueue::s_DeferredEvents;
 
 	bool EventQueue::RegisterEventHandler(EventType eventType, const EventHandler& eventHandler)
 	{
@@ -120,28 +117,19 @@ namespace LambdaEngine
 
 	void EventQueue::Tick()
 	{
-		// Process events
-		EventContainer& container = s_DeferredEvents[s_ReadIndex];
-		for (uint32 i = 0; i < container.Size(); i++)
-		{
-			Event& event = container[i];
-
-			TArray<EventHandler> handlers = GetEventHandlerOfType(event.GetType());
-			InternalSendEventToHandlers(event, handlers);
-		}
-
-		container.Clear();
+		// Process the events sealed by the previous tick, then seal the ones sent since then for the next tick
+		s_DeferredEvents.Dispatch([](Event& event)
+			{
+				TArray<EventHandler> handlers = GetEventHandlerOfType(event.GetType());
+				InternalSendEventToHandlers(event, handlers);
+			});
 
-		{
-			std::scoped_lock<SpinLock> lock(s_WriteLock);
-			std::swap(s_WriteIndex, s_ReadIndex);
-		}
+		s_DeferredEvents.Seal();
 	}
 
 	void EventQueue::Release()
 	{
-		s_DeferredEvents[0].Clear();
-		s_DeferredEvents[1].Clear();
+		s_DeferredEvents.Clear();
 	}
 
 	void EventQueue::InternalSendEventToHandlers(Event& event, const TArray<EventHandler>& handlers)
@@ -1,7 +1,8 @@
 #include "Assert/Assert.h"
 
 #include "Application/API/PlatformMisc.h"
-#include "Application/API/PlatformConsole.h"
+
+#include "Log/Log.h"
 
 #include <stdio.h>
 
@@ -9,7 +10,10 @@ void HandleAssert(const char* pFile, int line)
 {
 	using namespace LambdaEngine;
 	
-	PlatformConsole::PrintLine("ERROR: Assertion Failed in 'File %s' on line %d", pFile, line);
+	// Write the messages that were logged before the assert
+	Log::Flush();
+
+	Log::PrintAssertLine("ERROR: Assertion Failed in 'File %s' on line %d", pFile, line);
 
 	constexpr uint32 BUFFER_SIZE = 2048;
 	static char buffer[BUFFER_SIZE];
@@ -48,8 +52,9 @@ void HandleAssertWithMessage(const char* pFile, int line, const char* pMessageFo
 
 	va_end(args);
 
-	// Print to console
-	PlatformConsole::PrintLine("ERROR: Assertion Failed in File '%s' on line '%d' with message '%s'", pFile, line, messagebuffer);
+	// Print to console, after the messages that were logged before the assert
+	Log::Flush();
+	Log::PrintAssertLine("ERROR: Assertion Failed in File '%s' on line '%d' with message '%s'", pFile, line, messagebuffer);
 
 	// Print to messagebox
 	written = snprintf(buffer, BUFFER_SIZE - 2, "Assertion Failed\nFile: '%s'\nLine: %d\nMessage: %s", pFile, line, messagebuffer);
@@ -209,7 +209,7 @@ namespace LambdaEngine
 #endif
 	}
 
-	void GPUProfiler::CreateGraphicsPipelineStats()
+	void GPUProfiler::CreateGraphicsPipelineStats(uint32 listCount)
 	{
 #ifdef LAMBDA_DEBUG
 		QueryHeapDesc createInfo = {};
@@ -221,18 +221,21 @@ namespace LambdaEngine
 			FQueryPipelineStatisticsFlag::QUERY_PIPELINE_STATISTICS_FLAG_CLIPPING_INVOCATIONS |
 			FQueryPipelineStatisticsFlag::QUERY_PIPELINE_STATISTICS_FLAG_CLIPPING_PRIMITIVES |
 			FQueryPipelineStatisticsFlag::QUERY_PIPELINE_STATISTICS_FLAG_FRAGMENT_SHADER_INVOCATIONS;
-		createInfo.QueryCount = 6;
+		createInfo.QueryCount = listCount;
 		createInfo.Type = EQueryType::QUERY_TYPE_PIPELINE_STATISTICS;
 
 		m_pPipelineStatHeap = RenderAPI::GetDevice()->CreateQueryHeap(&createInfo);
 
-		m_GraphicsStats.Resize(createInfo.QueryCount);
+		// One value per enabled statistic
+		m_GraphicsStats.Resize(6);
 #endif
 	}
 
 	void GPUProfiler::AddTimestamp(CommandList* pCommandList, const String& name)
 	{
 #ifdef LAMBDA_DEBUG
+		std::scoped_lock<SpinLock> lock(m_TimestampSpinlock);
+
 		if (m_Timestamps.find(pCommandList) == m_Timestamps.end())
 		{
 			m_Timestamps[pCommandList].pCommandList = pCommandList;
@@ -258,21 +261,37 @@ namespace LambdaEngine
 	void GPUProfiler::StartTimestamp(CommandList* pCommandList)
 	{
 #ifdef LAMBDA_DEBUG
-		// Assume VK_PIPELINE_STAGE_TOP_OF_PIPE or VK_PIPELINE_STAGE_BOTTOM_OF_PIPE;
-		pCommandList->Timestamp(m_pTimestampHeap, (uint32)m_Timestamps[pCommandList].Start, FPipelineStageFlag::PIPELINE_STAGE_FLAG_BOTTOM);
+		uint32 startIndex = 0;
+		if (FindTimestampIndex(pCommandList, startIndex))
+		{
+			// Assume VK_PIPELINE_STAGE_TOP_OF_PIPE or VK_PIPELINE_STAGE_BOTTOM_OF_PIPE;
+			pCommandList->Timestamp(m_pTimestampHeap, startIndex, FPipelineStageFlag::PIPELINE_STAGE_FLAG_BOTTOM);
+		}
 #endif
 	}
 
 	void GPUProfiler::EndTimestamp(CommandList* pCommandList)
 	{
 #ifdef LAMBDA_DEBUG
-		pCommandList->Timestamp(m_pTimestampHeap, (uint32)m_Timestamps[pCommandList].End, FPipelineStageFlag::PIPELINE_STAGE_FLAG_BOTTOM);
+		uint32 startIndex = 0;
+		if (FindTimestampIndex(pCommandList, startIndex))
+		{
+			pCommandList->Timestamp(m_pTimestampHeap, startIndex + 1, FPipelineStageFlag::PIPELINE_STAGE_FLAG_BOTTOM);
+		}
 #endif
 	}
 
 	void GPUProfiler::GetTimestamp(CommandList* pCommandList)
 	{
 #ifdef LAMBDA_DEBUG
+		std::scoped_lock<SpinLock> lock(m_TimestampSpinlock);
+
+		auto timestampIt = m_Timestamps.find(pCommandList);
+		if (timestampIt == m_Timestamps.end())
+		{
+			return;
+		}
+
 		// Don't get the first time to make sure the timestamps are on the GPU and are ready
 		if (m_ShouldGetTimestamps.find(pCommandList) == m_ShouldGetTimestamps.end())
 		{
@@ -287,7 +306,7 @@ namespace LambdaEngine
 
 		uint32 timestampCount = 2;
 		TArray<QueryHeapAvailabilityResult> results(timestampCount);
-		bool res = m_pTimestampHeap->GetResultsAvailable((uint32)m_Timestamps[pCommandList].Start, timestampCount, timestampCount * sizeof(QueryHeapAvailabilityResult), results.GetData());
+		bool res = m_pTimestampHeap->GetResultsAvailable((uint32)timestampIt->second.Start, timestampCount, timestampCount * sizeof(QueryHeapAvailabilityResult), results.GetData());
 
 		if (res)
 		{
@@ -304,7 +323,7 @@ namespace LambdaEngine
 			uint64 start = glm::bitfieldExtract<uint64>(results[0].Result, 0, m_TimestampValidBits);
 			uint64 end = glm::bitfieldExtract<uint64>(results[1].Result, 0, m_TimestampValidBits);
 
-			const String& name = m_Timestamps[pCommandList].Name;
+			const String& name = timestampIt->second.Name;
 			m_Results[name].Start = start;
 			m_Results[name].End = end;
 			float duration = ((end - start) * m_TimestampPeriod) / (uint64)m_TimeUnit;
@@ -333,7 +352,11 @@ namespace LambdaEngine
 	void GPUProfiler::ResetTimestamp(CommandList* pCommandList)
 	{
 #ifdef LAMBDA_DEBUG
-		pCommandList->ResetQuery(m_pTimestampHeap, (uint32)m_Timestamps[pCommandList].Start, 2);
+		uint32 startIndex = 0;
+		if (FindTimestampIndex(pCommandList, startIndex))
+		{
+			pCommandList->ResetQuery(m_pTimestampHeap, startIndex, 2);
+		}
 #endif
 	}
 
@@ -347,28 +370,45 @@ namespace LambdaEngine
 	void GPUProfiler::StartGraphicsPipelineStat(CommandList* pCommandList)
 	{
 #ifdef LAMBDA_DEBUG
-		pCommandList->BeginQuery(m_pPipelineStatHeap, 0);
+		uint32 startIndex = 0;
+		if (FindTimestampIndex(pCommandList, startIndex))
+		{
+			pCommandList->BeginQuery(m_pPipelineStatHeap, startIndex / 2);
+		}
 #endif
 	}
 
 	void GPUProfiler::EndGraphicsPipelineStat(CommandList* pCommandList)
 	{
 #ifdef LAMBDA_DEBUG
-		pCommandList->EndQuery(m_pPipelineStatHeap, 0);
+		uint32 startIndex = 0;
+		if (FindTimestampIndex(pCommandList, startIndex))
+		{
+			pCommandList->EndQuery(m_pPipelineStatHeap, startIndex / 2);
+		}
 #endif
 	}
 
-	void GPUProfiler::GetGraphicsPipelineStat()
+	void GPUProfiler::GetGraphicsPipelineStat(CommandList* pCommandList)
 	{
 #ifdef LAMBDA_DEBUG
-			m_pPipelineStatHeap->GetResults(0, 1, m_GraphicsStats.GetSize() * sizeof(uint64), m_GraphicsStats.GetData());
+		uint32 startIndex = 0;
+		if (FindTimestampIndex(pCommandList, startIndex))
+		{
+			std::scoped_lock<SpinLock> lock(m_TimestampSpinlock);
+			m_pPipelineStatHeap->GetResults(startIndex / 2, 1, m_GraphicsStats.GetSize() * sizeof(uint64), m_GraphicsStats.GetData());
+		}
 #endif
 	}
 
 	void GPUProfiler::ResetGraphicsPipelineStat(CommandList* pCommandList)
 	{
 #ifdef LAMBDA_DEBUG
-		pCommandList->ResetQuery(m_pPipelineStatHeap, 0, 6);
+		uint32 startIndex = 0;
+		if (FindTimestampIndex(pCommandList, startIndex))
+		{
+			pCommandList->ResetQuery(m_pPipelineStatHeap, startIndex / 2, 1);
+		}
 #endif
 	}
 
@@ -388,6 +428,20 @@ namespace LambdaEngine
 		return &instance;
 	}
 
+	bool GPUProfiler::FindTimestampIndex(CommandList* pCommandList, uint32& startIndex)
+	{
+		std::scoped_lock<SpinLock> lock(m_TimestampSpinlock);
+
+		auto timestampIt = m_Timestamps.find(pCommandList);
+		if (timestampIt != m_Timestamps.end())
+		{
+			startIndex = (uint32)timestampIt->second.Start;
+			return true;
+		}
+
+		return false;
+	}
+
 	std::string GPUProfiler::GetTimeUnitName() const
 	{
 		std::string buf;
@@ -12,6 +12,7 @@
 #include "Application/API/Events/EventQueue.h"
 
 #include "Math/Random.h"
+#include "Memory/API/FrameAllocator.h"
 
 #include "ECS/ECSCore.h"
 
@@ -118,6 +119,9 @@ namespace LambdaEngine
 				}
 			}
 
+			// Frame memory allocated from now on reuses the memory of the frame before this one
+			FrameAllocator::EndFrame();
+
 			END_PROFILING_SEGMENT("Full Frame");
 		}
 	}
@@ -277,6 +281,14 @@ namespace LambdaEngine
 		Malloc::SetDebugFlags(MEMORY_DEBUG_FLAGS_OVERFLOW_PROTECT | MEMORY_DEBUG_FLAGS_LEAK_CHECK);
 #endif
 
+		// Messages are formatted and printed by the log thread from here on
+		String logFilePath;
+		flagParser({ "--log-file" }, "") >> logFilePath;
+		if (!Log::StartAsync(logFilePath.empty() ? nullptr : logFilePath.c_str()))
+		{
+			return false;
+		}
+
 		PlatformTime::PreInit();
 		Random::PreInit();
 
@@ -334,6 +346,11 @@ namespace LambdaEngine
 			return false;
 		}
 
+		if (!StagingBufferCache::Init())
+		{
+			return false;
+		}
+
 		if (!AudioAPI::Init())
 		{
 			return false;
@@ -469,6 +486,8 @@ namespace LambdaEngine
 			return false;
 		}
 
+		Log::StopAsync();
+
 #ifdef LAMBDA_DEVELOPMENT
 		PlatformConsole::Close();
 #endif
@@ -340,8 +340,8 @@ namespace LambdaEngine
 		LOG_INFO("MapVertices");
 #endif
 		m_RequiredVertexBufferSize = uint64(bytes);
-		m_pVertexStagingBuffer = StagingBufferCache::RequestBuffer(m_RequiredVertexBufferSize);
-		return m_pVertexStagingBuffer->Map();
+		m_VertexStagingAllocation = StagingBufferCache::Allocate(m_RequiredVertexBufferSize);
+		return m_VertexStagingAllocation.pHostMemory;
 	}
 
 	void GUIRenderer::UnmapVertices()
@@ -349,7 +349,6 @@ namespace LambdaEngine
 #ifdef PRINT_FUNC
 		LOG_INFO("UnmapVertices");
 #endif
-		m_pVertexStagingBuffer->Unmap();
 
 		CommandList* pCommandList = BeginOrGetRenderCommandList();
 		EndCurrentRenderPass();
@@ -369,7 +368,11 @@ namespace LambdaEngine
 				m_pVertexBuffer = RenderAPI::GetDevice()->CreateBuffer(&bufferDesc);
 			}
 
-			pCommandList->CopyBuffer(m_pVertexStagingBuffer, 0, m_pVertexBuffer, 0, m_RequiredVertexBufferSize);
+			// The allocation has already failed loudly in MapVertices, Noesis was handed no memory to write to
+			if (m_VertexStagingAllocation.pBuffer != nullptr)
+			{
+				pCommandList->CopyBuffer(m_VertexStagingAllocation.pBuffer, m_VertexStagingAllocation.Offset, m_pVertexBuffer, 0, m_RequiredVertexBufferSize);
+			}
 		}
 
 		ResumeRenderPass();
@@ -382,8 +385,8 @@ namespace LambdaEngine
 #endif
 
 		m_RequiredIndexBufferSize = uint64(bytes);
-		m_pIndexStagingBuffer = StagingBufferCache::RequestBuffer(m_RequiredIndexBufferSize);
-		return m_pIndexStagingBuffer->Map();
+		m_IndexStagingAllocation = StagingBufferCache::Allocate(m_RequiredIndexBufferSize);
+		return m_IndexStagingAllocation.pHostMemory;
 	}
 
 	void GUIRenderer::UnmapIndices()
@@ -391,7 +394,6 @@ namespace LambdaEngine
 #ifdef PRINT_FUNC
 		LOG_INFO("UnmapIndices");
 #endif
-		m_pIndexStagingBuffer->Unmap();
 
 		CommandList* pCommandList = BeginOrGetRenderCommandList();
 		EndCurrentRenderPass();
@@ -411,7 +413,11 @@ namespace LambdaEngine
 				m_pIndexBuffer = RenderAPI::GetDevice()->CreateBuffer(&bufferDesc);
 			}
 
-			pCommandList->CopyBuffer(m_pIndexStagingBuffer, 0, m_pIndexBuffer, 0, m_RequiredIndexBufferSize);
+			// The allocation has already failed loudly in MapIndices, Noesis was handed no memory to write to
+			if (m_IndexStagingAllocation.pBuffer != nullptr)
+			{
+				pCommandList->CopyBuffer(m_IndexStagingAllocation.pBuffer, m_IndexStagingAllocation.Offset, m_pIndexBuffer, 0, m_RequiredIndexBufferSize);
+			}
 			pCommandList->BindIndexBuffer(m_pIndexBuffer, 0, EIndexType::INDEX_TYPE_UINT16);
 		}
 
@@ -487,14 +493,16 @@ namespace LambdaEngine
 				memcpy(paramsData.pEffectParams, batch.effectParams, sizeof(paramsData.pEffectParams));
 			}
 
-			Buffer* pParamsStagingBuffer = StagingBufferCache::RequestBuffer(sizeof(GUIParamsData));
-			void* pMapped = pParamsStagingBuffer->Map();
-			memcpy(pMapped, &paramsData, sizeof(GUIParamsData));
-			pParamsStagingBuffer->Unmap();
-
 			pParamsBuffer = CreateOrGetParamsBuffer();
-			CommandList* pUtilityCommandList = BeginOrGetUtilityCommandList();
-			pUtilityCommandList->CopyBuffer(pParamsStagingBuffer, 0, pParamsBuffer, 0, sizeof(GUIParamsData));
+
+			const StagingBufferAllocation paramsStagingAllocation = StagingBufferCache::Allocate(sizeof(GUIParamsData));
+			if (paramsStagingAllocation.pHostMemory != nullptr)
+			{
+				memcpy(paramsStagingAllocation.pHostMemory, &paramsData, sizeof(GUIParamsData));
+
+				CommandList* pUtilityCommandList = BeginOrGetUtilityCommandList();
+				pUtilityCommandList->CopyBuffer(paramsStagingAllocation.pBuffer, paramsStagingAllocation.Offset, pParamsBuffer, 0, sizeof(GUIParamsData));
+			}
 		}
 
 		//Write to Descriptor Set
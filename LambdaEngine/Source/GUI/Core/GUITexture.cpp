@@ -139,11 +139,14 @@ namespace LambdaEngine
 		uint32 stride = TextureFormatStride(m_pTexture->GetDesc().Format);
 		uint64 sizeInBytes = uint64(width * height * stride);
 
-		Buffer* pStagingBuffer = StagingBufferCache::RequestBuffer(sizeInBytes);
+		const StagingBufferAllocation stagingAllocation = StagingBufferCache::Allocate(sizeInBytes);
+		if (stagingAllocation.pHostMemory == nullptr)
+		{
+			LOG_ERROR("[GUITexture]: Failed to allocate %llu bytes of staging memory, texture update is skipped", sizeInBytes);
+			return;
+		}
 
-		void* pMapped = pStagingBuffer->Map();
-		memcpy(pMapped, pData, sizeInBytes);
-		pStagingBuffer->Unmap();
+		memcpy(stagingAllocation.pHostMemory, pData, sizeInBytes);
 
 		if (prevTextureState != ETextureState::TEXTURE_STATE_COPY_DST)
 		{
@@ -164,7 +167,7 @@ namespace LambdaEngine
 		}
 
 		CopyTextureBufferDesc copyDesc = {};
-		copyDesc.BufferOffset	= 0;
+		copyDesc.BufferOffset	= stagingAllocation.Offset;
 		copyDesc.BufferRowPitch	= 0;
 		copyDesc.BufferHeight	= 0;
 		copyDesc.OffsetX		= x;
@@ -176,7 +179,7 @@ namespace LambdaEngine
 		copyDesc.MiplevelCount  = 1;
 		copyDesc.ArrayIndex		= 0;
 		copyDesc.ArrayCount		= m_pTexture->GetDesc().ArrayCount;
-		pCommandList->CopyTextureFromBuffer(pStagingBuffer, m_pTexture, copyDesc);
+		pCommandList->CopyTextureFromBuffer(stagingAllocation.pBuffer, m_pTexture, copyDesc);
 
 		{
 			PipelineTextureBarrierDesc textureBarrier = { };
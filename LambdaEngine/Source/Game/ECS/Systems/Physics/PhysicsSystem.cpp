@@ -5,6 +5,7 @@
 #include "Game/ECS/Components/Physics/Transform.h"
 #include "Game/ECS/Components/Rendering/CameraComponent.h"
 #include "Game/ECS/Components/Rendering/MeshComponent.h"
+#include "Game/ECS/Systems/Physics/SceneQueryBatch.h"
 #include "Input/API/InputActionSystem.h"
 #include "Physics/PhysX/FilterShader.h"
 #include "Resources/ResourceManager.h"
@@ -21,7 +22,6 @@ namespace LambdaEngine
 		m_pCooking(nullptr),
 		m_pControllerManager(nullptr),
 		m_pVisDbg(nullptr),
-		m_pDispatcher(nullptr),
 		m_pScene(nullptr),
 		m_pDefaultMaterial(nullptr)
 	{}
@@ -31,7 +31,6 @@ namespace LambdaEngine
 		PX_RELEASE(m_pDefaultMaterial);
 		PX_RELEASE(m_pCooking);
 		PX_RELEASE(m_pControllerManager);
-		PX_RELEASE(m_pDispatcher);
 		PX_RELEASE(m_pScene);
 		PX_RELEASE(m_pPhysics);
 
@@ -143,20 +142,21 @@ namespace LambdaEngine
 		cookingParams.meshWeldTolerance					= 0.1f;
 		m_pCooking->setParams(cookingParams);
 
-		m_pDispatcher = PxDefaultCpuDispatcherCreate(2);
-		if (!m_pDispatcher)
-		{
-			LOG_ERROR("PhysX CPU dispatcher creation failed");
-			return false;
-		}
+		// A negative worker count lets physics use half of the thread pool
+		const int32 workerCount = EngineConfig::GetIntProperty(EConfigOption::CONFIG_OPTION_PHYSICS_WORKER_COUNT);
+		m_Dispatcher.Init(workerCount >= 0 ? uint32(workerCount) : glm::max(1u, ThreadPool::GetThreadCount() / 2));
+
+		const float64 tickRate = EngineConfig::GetDoubleProperty(EConfigOption::CONFIG_OPTION_PHYSICS_TICK_RATE);
+		m_FixedTimestep			= tickRate > 0.0 ? 1.0 / tickRate : 0.0;
+		m_InterpolateFixedSteps	= EngineConfig::GetBoolProperty(EConfigOption::CONFIG_OPTION_PHYSICS_INTERPOLATION);
 
 		const glm::vec3 gravity = GRAVITATIONAL_ACCELERATION * -g_DefaultUp;
 		const PxVec3 gravityPX = { gravity.x, gravity.y, gravity.z };
 
 		PxSceneDesc sceneDesc(m_pPhysics->getTolerancesScale());
-		sceneDesc.flags						= PxSceneFlag::eENABLE_CCD;
+		sceneDesc.flags						= PxSceneFlag::eENABLE_CCD | PxSceneFlag::eENABLE_ACTIVE_ACTORS;
 		sceneDesc.gravity					= gravityPX;
-		sceneDesc.cpuDispatcher				= m_pDispatcher;
+		sceneDesc.cpuDispatcher				= &m_Dispatcher;
 		sceneDesc.filterShader				= FilterShader;
 		sceneDesc.simulationEventCallback	= this;
 		m_pScene = m_pPhysics->createScene(sceneDesc);
@@ -179,37 +179,42 @@ namespace LambdaEngine
 
 	void PhysicsSystem::Tick(Timestamp deltaTime)
 	{
-		const float32 dt = (float32)deltaTime.AsSeconds();
+		if (m_FixedTimestep <= 0.0)
+		{
+			Simulate((float32)deltaTime.AsSeconds());
+			WriteBackActiveActors();
+			return;
+		}
 
-		m_pScene->simulate(dt);
-		m_pScene->fetchResults(true);
+		m_Accumulator += deltaTime.AsSeconds();
 
-		ECSCore* pECS = ECSCore::GetInstance();
-		const ComponentArray<DynamicCollisionComponent>* pDynamicCollisionComponents = pECS->GetComponentArray<DynamicCollisionComponent>();
-		ComponentArray<PositionComponent>* pPositionComponents = pECS->GetComponentArray<PositionComponent>();
-		ComponentArray<RotationComponent>* pRotationComponents = pECS->GetComponentArray<RotationComponent>();
-		ComponentArray<VelocityComponent>* pVelocityComponents = pECS->GetComponentArray<VelocityComponent>();
-
-		for (Entity entity : m_DynamicCollisionEntities)
+		uint32 stepCount = 0;
+		while (m_Accumulator >= m_FixedTimestep)
 		{
-			const DynamicCollisionComponent& collisionComp = pDynamicCollisionComponents->GetConstData(entity);
-			PxRigidDynamic* pActor = collisionComp.pActor;
-			if (!pActor->isSleeping())
+			if (stepCount == MAX_FIXED_STEPS_PER_TICK)
+			{
+				m_Accumulator = 0.0;
+				break;
+			}
+
+			// Actors that do not move during the step end up with equal poses and stop being interpolated
+			for (auto& interpolatedActor : m_InterpolatedActors)
 			{
-				PositionComponent& positionComp = pPositionComponents->GetData(entity);
-				RotationComponent& rotationComp = pRotationComponents->GetData(entity);
-				VelocityComponent& velocityComp = pVelocityComponents->GetData(entity);
+				InterpolatedActor& actor = interpolatedActor.second;
+				actor.PreviousPosition = actor.CurrentPosition;
+				actor.PreviousRotation = actor.CurrentRotation;
+			}
 
-				const PxTransform transformPX = pActor->getGlobalPose();
-				const PxVec3& positionPX = transformPX.p;
-				positionComp.Position = { positionPX.x, positionPX.y, positionPX.z };
+			Simulate((float32)m_FixedTimestep);
+			WriteBackActiveActors();
 
-				const PxQuat& quatPX = transformPX.q;
-				rotationComp.Quaternion = { quatPX.w, quatPX.x, quatPX.y, quatPX.z };
+			m_Accumulator -= m_FixedTimestep;
+			stepCount++;
+		}
 
-				const PxVec3 velocityPX = pActor->getLinearVelocity();
-				velocityComp.Velocity = { velocityPX.x, velocityPX.y, velocityPX.z };
-			}
+		if (m_InterpolateFixedSteps)
+		{
+			WriteInterpolatedActors(float32(m_Accumulator / m_FixedTimestep));
 		}
 	}
 
@@ -266,6 +271,16 @@ namespace LambdaEngine
 		return collisionComponent;
 	}
 
+	void PhysicsSystem::ReleaseDynamicActor(DynamicCollisionComponent& collisionComponent)
+	{
+		if (collisionComponent.pActor)
+		{
+			m_pScene->removeActor(*collisionComponent.pActor);
+			ReleaseActor(collisionComponent.pActor);
+			collisionComponent.pActor = nullptr;
+		}
+	}
+
 	CharacterColliderComponent PhysicsSystem::CreateCharacterCapsule(
 		const CharacterColliderCreateInfo& characterColliderInfo,
 		float32 height,
@@ -361,39 +376,71 @@ namespace LambdaEngine
 		filterDataPX.data.word0 = filterData.IncludedGroup;
 		filterDataPX.data.word1 = filterData.ExcludedGroup;
 		filterDataPX.data.word2 = filterData.ExcludedEntity;
+		filterDataPX.data.word3 = filterData.IgnoreTriggers ? 1 : 0;
 
-		// There's no default constructor for PxGeometry, so a sphere is used as a default
+		PxTransform transform;
+		const PxGeometryHolder queryGeometry = CreateQueryGeometry(overlapInfo.GeometryType, geometryParams, position, rotation, transform);
+		return m_pScene->overlap(queryGeometry.any(), transform, overlaps, filterDataPX, &m_RaycastQueryFilterCallback);
+	}
+
+	void PhysicsSystem::ExecuteQueryBatch(SceneQueryBatch& queryBatch)
+	{
+		// Jobs are claimed from a shared counter by pool threads and by the calling thread, which may be a pool thread
+		// itself. Pool jobs that start after every query job was claimed only touch the shared state, which they own.
+		struct QueryBatchExecution
+		{
+			std::function<void(uint32)>	ExecuteJob;
+			std::atomic_uint32_t		NextJob				= 0;
+			std::atomic_uint32_t		FinishedJobCount	= 0;
+			uint32						JobCount			= 0;
+		};
 
-		PxTransform transform = PxTransform(position.x, position.y, position.z, PxQuat(rotation.x, rotation.y, rotation.z, rotation.w));
+		const uint32 queryCount = queryBatch.GetQueryCount();
+		const uint32 jobCount = (queryCount + QUERIES_PER_JOB - 1) / QUERIES_PER_JOB;
 
-		switch (overlapInfo.GeometryType)
+		auto executeJob = [this, &queryBatch, queryCount](uint32 jobIndex)
 		{
-			case EGeometryType::BOX:
-			{
-				PxBoxGeometry queryGeometry(PxVec3(geometryParams.HalfExtents.x, geometryParams.HalfExtents.y, geometryParams.HalfExtents.z));
-				return m_pScene->overlap(queryGeometry, transform, overlaps, filterDataPX, &m_RaycastQueryFilterCallback);
-			}
-			case EGeometryType::CAPSULE:
-			{
-				PxCapsuleGeometry queryGeometry(geometryParams.Radius, geometryParams.HalfHeight);
-				return m_pScene->overlap(queryGeometry, transform, overlaps, filterDataPX, &m_RaycastQueryFilterCallback);
-			}
-			case EGeometryType::PLANE:
+			const uint32 endQuery = glm::min((jobIndex + 1) * QUERIES_PER_JOB, queryCount);
+			for (uint32 queryIndex = jobIndex * QUERIES_PER_JOB; queryIndex < endQuery; queryIndex++)
 			{
-				transform = CreatePlaneTransform(position, rotation);
-				PxPlaneGeometry queryGeometry;
-				return m_pScene->overlap(queryGeometry, transform, overlaps, filterDataPX, &m_RaycastQueryFilterCallback);
+				ExecuteQuery(queryBatch, queryIndex);
 			}
-			case EGeometryType::MESH:
+		};
+
+		if (jobCount <= 1)
+		{
+			if (jobCount == 1)
 			{
-				PxTriangleMeshGeometry queryGeometry = CreateTriangleMeshGeometry(geometryParams.pMesh, glm::vec3(1.0f));
-				return m_pScene->overlap(queryGeometry, transform, overlaps, filterDataPX, &m_RaycastQueryFilterCallback);
+				executeJob(0);
 			}
-			default:
+
+			return;
+		}
+
+		std::shared_ptr<QueryBatchExecution> execution = std::make_shared<QueryBatchExecution>();
+		execution->ExecuteJob	= executeJob;
+		execution->JobCount		= jobCount;
+
+		auto runJobs = [](QueryBatchExecution& execution)
+		{
+			for (uint32 jobIndex = execution.NextJob.fetch_add(1); jobIndex < execution.JobCount; jobIndex = execution.NextJob.fetch_add(1))
 			{
-				PxSphereGeometry queryGeometry(geometryParams.Radius);
-				return m_pScene->overlap(queryGeometry, transform, overlaps, filterDataPX, &m_RaycastQueryFilterCallback);
+				execution.ExecuteJob(jobIndex);
+				execution.FinishedJobCount.fetch_add(1, std::memory_order_release);
 			}
+		};
+
+		const uint32 helperCount = glm::min(jobCount - 1, ThreadPool::GetThreadCount());
+		for (uint32 helper = 0; helper < helperCount; helper++)
+		{
+			ThreadPool::ExecuteDetached([execution, runJobs]() { runJobs(*execution); });
+		}
+
+		runJobs(*execution);
+
+		while (execution->FinishedJobCount.load(std::memory_order_acquire) < jobCount)
+		{
+			std::this_thread::yield();
 		}
 	}
 
@@ -605,10 +652,215 @@ namespace LambdaEngine
 		filterDataPX.data.word0 = filterData.IncludedGroup;
 		filterDataPX.data.word1 = filterData.ExcludedGroup;
 		filterDataPX.data.word2 = filterData.ExcludedEntity;
+		filterDataPX.data.word3 = filterData.IgnoreTriggers ? 1 : 0;
 
 		return m_pScene->raycast(originPX, directionPX, raycastInfo.MaxDistance, raycastBuffer, hitFlags, filterDataPX, &m_RaycastQueryFilterCallback);
 	}
 
+	PxGeometryHolder PhysicsSystem::CreateQueryGeometry(
+		EGeometryType geometryType,
+		const GeometryParameters& geometryParams,
+		const glm::vec3& position,
+		const glm::quat& rotation,
+		PxTransform& transform) const
+	{
+		transform = PxTransform(position.x, position.y, position.z, PxQuat(rotation.x, rotation.y, rotation.z, rotation.w));
+
+		// There's no default constructor for PxGeometry, so a sphere is used as a default
+		switch (geometryType)
+		{
+			case EGeometryType::BOX:
+			{
+				return PxBoxGeometry(PxVec3(geometryParams.HalfExtents.x, geometryParams.HalfExtents.y, geometryParams.HalfExtents.z));
+			}
+			case EGeometryType::CAPSULE:
+			{
+				return PxCapsuleGeometry(geometryParams.Radius, geometryParams.HalfHeight);
+			}
+			case EGeometryType::PLANE:
+			{
+				transform = CreatePlaneTransform(position, rotation);
+				return PxPlaneGeometry();
+			}
+			case EGeometryType::MESH:
+			{
+				return CreateTriangleMeshGeometry(geometryParams.pMesh, glm::vec3(1.0f));
+			}
+			default:
+			{
+				return PxSphereGeometry(geometryParams.Radius);
+			}
+		}
+	}
+
+	void PhysicsSystem::ExecuteQuery(SceneQueryBatch& queryBatch, uint32 queryIndex)
+	{
+		SceneQueryBatch::SceneQuery& query = queryBatch.m_Queries[queryIndex];
+
+		PxQueryFilterData filterDataPX;
+		filterDataPX.flags = PxQueryFlag::eSTATIC | PxQueryFlag::eDYNAMIC | PxQueryFlag::ePREFILTER;
+		filterDataPX.data.word0 = query.FilterData.IncludedGroup;
+		filterDataPX.data.word1 = query.FilterData.ExcludedGroup;
+		filterDataPX.data.word2 = query.FilterData.ExcludedEntity;
+		filterDataPX.data.word3 = query.FilterData.IgnoreTriggers ? 1 : 0;
+
+		const PxVec3 positionPX = { query.Position.x, query.Position.y, query.Position.z };
+		const PxVec3 directionPX = { query.Direction.x, query.Direction.y, query.Direction.z };
+		const PxHitFlags hitFlags = PxHitFlag::ePOSITION | PxHitFlag::eNORMAL;
+
+		query.HitCount = 0;
+
+		switch (query.Type)
+		{
+			case ESceneQueryType::RAYCAST:
+			{
+				PxRaycastBuffer raycastBuffer;
+				if (m_pScene->raycast(positionPX, directionPX, query.MaxDistance, raycastBuffer, hitFlags, filterDataPX, &m_RaycastQueryFilterCallback) && raycastBuffer.hasBlock)
+				{
+					queryBatch.m_RaycastHits[query.FirstHit] = raycastBuffer.block;
+					query.HitCount = 1;
+				}
+
+				break;
+			}
+			case ESceneQueryType::RAYCAST_MULTIPLE:
+			{
+				filterDataPX.flags |= PxQueryFlag::eNO_BLOCK;
+
+				PxRaycastBuffer raycastBuffer(&queryBatch.m_RaycastHits[query.FirstHit], query.MaxHitCount);
+				m_pScene->raycast(positionPX, directionPX, query.MaxDistance, raycastBuffer, hitFlags, filterDataPX, &m_RaycastQueryFilterCallback);
+				query.HitCount = raycastBuffer.getNbTouches();
+				break;
+			}
+			case ESceneQueryType::SWEEP:
+			{
+				PxTransform transform;
+				const PxGeometryHolder sweepGeometry = CreateQueryGeometry(query.GeometryType, query.GeometryParams, query.Position, query.Rotation, transform);
+
+				PxSweepBuffer sweepBuffer;
+				if (m_pScene->sweep(sweepGeometry.any(), transform, directionPX, query.MaxDistance, sweepBuffer, hitFlags, filterDataPX, &m_RaycastQueryFilterCallback) && sweepBuffer.hasBlock)
+				{
+					queryBatch.m_SweepHits[query.FirstHit] = sweepBuffer.block;
+					query.HitCount = 1;
+				}
+
+				break;
+			}
+			case ESceneQueryType::OVERLAP:
+			{
+				filterDataPX.flags |= PxQueryFlag::eNO_BLOCK;
+
+				PxTransform transform;
+				const PxGeometryHolder overlapGeometry = CreateQueryGeometry(query.GeometryType, query.GeometryParams, query.Position, query.Rotation, transform);
+
+				PxOverlapBuffer overlapBuffer(&queryBatch.m_OverlapHits[query.FirstHit], query.MaxHitCount);
+				m_pScene->overlap(overlapGeometry.any(), transform, overlapBuffer, filterDataPX, &m_RaycastQueryFilterCallback);
+				query.HitCount = overlapBuffer.getNbTouches();
+				break;
+			}
+		}
+	}
+
+	void PhysicsSystem::Simulate(float32 deltaTime)
+	{
+		m_pScene->simulate(deltaTime);
+
+		// Help with the simulation tasks while waiting, Tick may itself run on a thread pool thread
+		while (!m_pScene->checkResults(false))
+		{
+			if (!m_Dispatcher.RunQueuedTasks())
+			{
+				std::this_thread::yield();
+			}
+		}
+
+		m_pScene->fetchResults(true);
+	}
+
+	void PhysicsSystem::WriteBackActiveActors()
+	{
+		ECSCore* pECS = ECSCore::GetInstance();
+		ComponentArray<PositionComponent>* pPositionComponents = pECS->GetComponentArray<PositionComponent>();
+		ComponentArray<RotationComponent>* pRotationComponents = pECS->GetComponentArray<RotationComponent>();
+		ComponentArray<VelocityComponent>* pVelocityComponents = pECS->GetComponentArray<VelocityComponent>();
+
+		// Sleeping actors are not in the list, so the cost follows the number of moving actors rather than all of them
+		PxU32 activeActorCount = 0;
+		PxActor** ppActiveActors = m_pScene->getActiveActors(activeActorCount);
+
+		for (PxU32 actorIdx = 0; actorIdx < activeActorCount; actorIdx++)
+		{
+			PxActor* pActor = ppActiveActors[actorIdx];
+			const ActorUserData* pUserData = reinterpret_cast<const ActorUserData*>(pActor->userData);
+
+			// Character controllers and actors without an entity are also reported
+			if (!pUserData || !pActor->is<PxRigidDynamic>() || !m_DynamicCollisionEntities.HasElement(pUserData->Entity))
+			{
+				continue;
+			}
+
+			const Entity entity = pUserData->Entity;
+			PxRigidDynamic* pRigidDynamic = static_cast<PxRigidDynamic*>(pActor);
+
+			const PxTransform transformPX = pRigidDynamic->getGlobalPose();
+			const glm::vec3 position = { transformPX.p.x, transformPX.p.y, transformPX.p.z };
+			const glm::quat rotation = { transformPX.q.w, transformPX.q.x, transformPX.q.y, transformPX.q.z };
+
+			if (m_FixedTimestep > 0.0 && m_InterpolateFixedSteps)
+			{
+				auto interpolatedActorItr = m_InterpolatedActors.find(entity);
+				if (interpolatedActorItr == m_InterpolatedActors.end())
+				{
+					// The components still hold the pose the actor had when it started moving
+					InterpolatedActor interpolatedActor = {};
+					interpolatedActor.PreviousPosition	= pPositionComponents->GetConstData(entity).Position;
+					interpolatedActor.PreviousRotation	= pRotationComponents->GetConstData(entity).Quaternion;
+					interpolatedActorItr = m_InterpolatedActors.insert({ entity, interpolatedActor }).first;
+				}
+
+				interpolatedActorItr->second.CurrentPosition = position;
+				interpolatedActorItr->second.CurrentRotation = rotation;
+			}
+			else
+			{
+				pPositionComponents->GetData(entity).Position = position;
+				pRotationComponents->GetData(entity).Quaternion = rotation;
+			}
+
+			const PxVec3 velocityPX = pRigidDynamic->getLinearVelocity();
+			pVelocityComponents->GetData(entity).Velocity = { velocityPX.x, velocityPX.y, velocityPX.z };
+		}
+	}
+
+	void PhysicsSystem::WriteInterpolatedActors(float32 alpha)
+	{
+		ECSCore* pECS = ECSCore::GetInstance();
+		ComponentArray<PositionComponent>* pPositionComponents = pECS->GetComponentArray<PositionComponent>();
+		ComponentArray<RotationComponent>* pRotationComponents = pECS->GetComponentArray<RotationComponent>();
+
+		for (auto interpolatedActorItr = m_InterpolatedActors.begin(); interpolatedActorItr != m_InterpolatedActors.end();)
+		{
+			const Entity entity = interpolatedActorItr->first;
+			const InterpolatedActor& actor = interpolatedActorItr->second;
+
+			PositionComponent& positionComp = pPositionComponents->GetData(entity);
+			RotationComponent& rotationComp = pRotationComponents->GetData(entity);
+
+			if (actor.PreviousPosition == actor.CurrentPosition && actor.PreviousRotation == actor.CurrentRotation)
+			{
+				// The actor did not move during the latest step, leave it at its final pose
+				positionComp.Position = actor.CurrentPosition;
+				rotationComp.Quaternion = actor.CurrentRotation;
+				interpolatedActorItr = m_InterpolatedActors.erase(interpolatedActorItr);
+				continue;
+			}
+
+			positionComp.Position = glm::mix(actor.PreviousPosition, actor.CurrentPosition, alpha);
+			rotationComp.Quaternion = glm::slerp(actor.PreviousRotation, actor.CurrentRotation, alpha);
+			interpolatedActorItr++;
+		}
+	}
+
 	void PhysicsSystem::StaticCollisionDestructor(StaticCollisionComponent& collisionComponent, Entity entity)
 	{
 		UNREFERENCED_VARIABLE(entity);
@@ -710,6 +962,8 @@ namespace LambdaEngine
 		{
 			m_pScene->removeActor(*pActor);
 		}
+
+		m_InterpolatedActors.erase(entity);
 	}
 
 	void PhysicsSystem::OnCharacterColliderRemoval(Entity entity)
@@ -0,0 +1,75 @@
+#include "Game/ECS/Systems/Physics/SceneQueryBatch.h"
+
+namespace LambdaEngine
+{
+	void SceneQueryBatch::Reset()
+	{
+		m_Queries.Clear();
+		m_RaycastHits.Clear();
+		m_SweepHits.Clear();
+		m_OverlapHits.Clear();
+	}
+
+	uint32 SceneQueryBatch::AddRaycast(const RaycastInfo& raycastInfo, bool multipleHits, uint32 maxHitCount)
+	{
+		SceneQuery query = {};
+		query.Type			= multipleHits ? ESceneQueryType::RAYCAST_MULTIPLE : ESceneQueryType::RAYCAST;
+		query.FilterData	= GetFilterData(raycastInfo.pFilterData);
+		query.Position		= raycastInfo.Origin;
+		query.Direction		= raycastInfo.Direction;
+		query.MaxDistance	= raycastInfo.MaxDistance;
+		query.FirstHit		= m_RaycastHits.GetSize();
+		query.MaxHitCount	= multipleHits ? maxHitCount : 1;
+
+		m_RaycastHits.Resize(query.FirstHit + query.MaxHitCount);
+		m_Queries.PushBack(query);
+		return m_Queries.GetSize() - 1;
+	}
+
+	uint32 SceneQueryBatch::AddSweep(const SweepQueryInfo& sweepInfo)
+	{
+		SceneQuery query = {};
+		query.Type				= ESceneQueryType::SWEEP;
+		query.FilterData		= GetFilterData(sweepInfo.pFilterData);
+		query.GeometryType		= sweepInfo.GeometryType;
+		query.GeometryParams	= sweepInfo.GeometryParams;
+		query.Position			= sweepInfo.Position;
+		query.Rotation			= sweepInfo.Rotation;
+		query.Direction			= sweepInfo.Direction;
+		query.MaxDistance		= sweepInfo.MaxDistance;
+		query.FirstHit			= m_SweepHits.GetSize();
+		query.MaxHitCount		= 1;
+
+		m_SweepHits.Resize(query.FirstHit + query.MaxHitCount);
+		m_Queries.PushBack(query);
+		return m_Queries.GetSize() - 1;
+	}
+
+	uint32 SceneQueryBatch::AddOverlap(const OverlapQueryInfo& overlapInfo, const QueryFilterData* pFilterData, uint32 maxHitCount)
+	{
+		SceneQuery query = {};
+		query.Type				= ESceneQueryType::OVERLAP;
+		query.FilterData		= GetFilterData(pFilterData);
+		query.GeometryType		= overlapInfo.GeometryType;
+		query.GeometryParams	= overlapInfo.GeometryParams;
+		query.Position			= overlapInfo.Position;
+		query.Rotation			= overlapInfo.Rotation;
+		query.FirstHit			= m_OverlapHits.GetSize();
+		query.MaxHitCount		= maxHitCount;
+
+		m_OverlapHits.Resize(query.FirstHit + query.MaxHitCount);
+		m_Queries.PushBack(query);
+		return m_Queries.GetSize() - 1;
+	}
+
+	QueryFilterData SceneQueryBatch::GetFilterData(const QueryFilterData* pFilterData)
+	{
+		QueryFilterData filterData = {};
+		if (pFilterData)
+		{
+			filterData = *pFilterData;
+		}
+
+		return filterData;
+	}
+}
@@ -395,7 +395,7 @@ namespace LambdaEngine
 
 				// Particle Renderer & Manager
 				constexpr uint32 MAX_PARTICLE_COUNT = 30000U;
-				m_ParticleManager.Init(MAX_PARTICLE_COUNT, m_pASBuilder);
+				m_ParticleManager.Init(MAX_PARTICLE_COUNT, m_pASBuilder, EngineConfig::GetBoolProperty(EConfigOption::CONFIG_OPTION_CPU_PARTICLES));
 
 				m_pParticleRenderer = DBG_NEW ParticleRenderer();
 				m_pParticleRenderer->Init();
@@ -458,6 +458,8 @@ namespace LambdaEngine
 				LOG_ERROR("Failed to initialize RenderGraph");
 				return false;
 			}
+
+			m_pRenderGraph->SetParallelRecording(EngineConfig::GetBoolProperty(EConfigOption::CONFIG_OPTION_PARALLEL_RECORDING));
 		}
 
 		//Update RenderGraph with Back Buffer
@@ -576,11 +578,6 @@ namespace LambdaEngine
 			SAFERELEASE(meshAndInstancesIt.second.pStagingMatrixBuffer);
 			SAFERELEASE(meshAndInstancesIt.second.pIndexBuffer);
 			SAFERELEASE(meshAndInstancesIt.second.pRasterInstanceBuffer);
-
-			for (uint32 b = 0; b < BACK_BUFFER_COUNT; b++)
-			{
-				SAFERELEASE(meshAndInstancesIt.second.ppRasterInstanceStagingBuffers[b]);
-			}
 		}
 
 		SAFEDELETE(m_pReflectionsDenoisePass);
@@ -633,6 +630,8 @@ namespace LambdaEngine
 			SAFERELEASE(m_ppPerFrameStagingBuffers[b]);
 			SAFERELEASE(m_ppLightsStagingBuffer[b]);
 			SAFERELEASE(m_ppPaintMaskColorStagingBuffers[b]);
+			SAFERELEASE(m_ppInstanceUploadBuffers[b]);
+			m_ppInstanceUploadMemory[b] = nullptr;
 		}
 
 		SAFERELEASE(m_pMaterialParametersBuffer);
@@ -816,7 +815,10 @@ namespace LambdaEngine
 			uint32 particleCount = m_ParticleManager.GetParticleCount();
 			uint32 activeEmitterCount = m_ParticleManager.GetActiveEmitterCount();
 			m_pParticleRenderer->SetCurrentParticleCount(particleCount, activeEmitterCount);
-			m_pParticleUpdater->SetCurrentParticleCount(particleCount, activeEmitterCount);
+
+			// The update pass is skipped when the particles are simulated on the CPU, collisions are resolved on the GPU and read back by the manager
+			const uint32 updateParticleCount = m_ParticleManager.IsSimulatedOnCPU() ? 0 : particleCount;
+			m_pParticleUpdater->SetCurrentParticleCount(updateParticleCount, activeEmitterCount);
 			m_pParticleCollider->SetCurrentParticleCount(particleCount, activeEmitterCount);
 		}
 	}
@@ -828,7 +830,7 @@ namespace LambdaEngine
 		m_FrameIndex++;
 		m_ModFrameIndex = m_FrameIndex % uint64(BACK_BUFFER_COUNT);
 
-		PROFILE_FUNCTION("StagingBufferCache::Tick", StagingBufferCache::Tick());
+		PROFILE_FUNCTION("StagingBufferCache::Tick", StagingBufferCache::Tick(m_pRenderGraph->GetFence(), m_pRenderGraph->GetSubmittedFenceValue()));
 		PROFILE_FUNCTION("RenderSystem::CleanBuffers", CleanBuffers());
 
 		PROFILE_FUNCTION("RenderSystem::UpdateBuffers", UpdateBuffers());
@@ -1627,7 +1629,8 @@ bool RenderSystem::InitIntegrationLUT()
 		instance.TeamIndex					= teamIndex;
 		meshAndInstancesIt->second.RasterInstances.PushBack(instance);
 
-		m_DirtyRasterInstanceBuffers.insert(&meshAndInstancesIt->second);
+		SetInstanceLocation(entity, &meshAndInstancesIt->second, instanceKey.InstanceIndex);
+		MarkRasterInstanceDirty(meshAndInstancesIt->second, instanceKey.InstanceIndex);
 
 		//Update Dirty Draw Args
 		for (const DrawArgMaskDesc& requiredDrawArgMask : m_RequiredDrawArgs)
@@ -1762,7 +1765,16 @@ bool RenderSystem::InitIntegrationLUT()
 
 		rasterInstances[instanceIndex] = rasterInstances.GetBack();
 		rasterInstances.PopBack();
-		m_DirtyRasterInstanceBuffers.insert(&meshAndInstancesIt->second);
+
+		// Only the slot that received the swapped instance has to be uploaded again, the buffer tail is never read
+		if (instanceIndex < rasterInstances.GetSize())
+		{
+			MarkRasterInstanceDirty(meshAndInstancesIt->second, instanceIndex);
+		}
+		else
+		{
+			m_DirtyRasterInstanceBuffers.insert(&meshAndInstancesIt->second);
+		}
 
 		Entity swappedEntityID = meshAndInstancesIt->second.EntityIDs.GetBack();
 		meshAndInstancesIt->second.EntityIDs[instanceIndex] = swappedEntityID;
@@ -1772,6 +1784,9 @@ bool RenderSystem::InitIntegrationLUT()
 		swappedInstanceKeyIt->second.InstanceIndex = instanceKeyIt->second.InstanceIndex;
 		m_EntityIDsToInstanceKey.erase(instanceKeyIt);
 
+		SetInstanceLocation(swappedEntityID, &meshAndInstancesIt->second, instanceIndex);
+		SetInstanceLocation(entity, nullptr, UINT32_MAX);
+
 		//Update Dirty Draw Args
 		for (const DrawArgMaskDesc& requiredDrawArgMask : m_RequiredDrawArgs)
 		{
@@ -1811,23 +1826,18 @@ bool RenderSystem::InitIntegrationLUT()
 
 	void RenderSystem::UpdateTransformData(Entity entity, const glm::mat4& transform)
 	{
-		THashTable<GUID_Lambda, InstanceKey>::iterator instanceKeyIt = m_EntityIDsToInstanceKey.find(entity);
-		if (instanceKeyIt == m_EntityIDsToInstanceKey.end())
+		if (entity >= m_EntityInstanceLocations.GetSize() || m_EntityInstanceLocations[entity].pMeshEntry == nullptr)
 		{
 			LOG_ERROR("Tried to update transform of an entity which is not registered");
 			return;
 		}
 
-		MeshAndInstancesMap::iterator meshAndInstancesIt = m_MeshAndInstancesMap.find(instanceKeyIt->second.MeshKey);
-		if (meshAndInstancesIt == m_MeshAndInstancesMap.end())
-		{
-			LOG_ERROR("Tried to update transform of an entity which has no MeshAndInstancesMap entry");
-			return;
-		}
+		const InstanceLocation& instanceLocation = m_EntityInstanceLocations[entity];
+		MeshEntry& meshEntry = *instanceLocation.pMeshEntry;
 
 		if (m_RayTracingEnabled)
 		{
-			uint32 asInstanceIndex = meshAndInstancesIt->second.ASInstanceIndices[instanceKeyIt->second.InstanceIndex];
+			uint32 asInstanceIndex = meshEntry.ASInstanceIndices[instanceLocation.InstanceIndex];
 
 			if (asInstanceIndex != UINT32_MAX)
 			{
@@ -1835,10 +1845,10 @@ bool RenderSystem::InitIntegrationLUT()
 			}
 		}
 
-		Instance* pRasterInstanceToUpdate = &meshAndInstancesIt->second.RasterInstances[instanceKeyIt->second.InstanceIndex];
+		Instance* pRasterInstanceToUpdate = &meshEntry.RasterInstances[instanceLocation.InstanceIndex];
 		pRasterInstanceToUpdate->PrevTransform	= pRasterInstanceToUpdate->Transform;
 		pRasterInstanceToUpdate->Transform		= transform;
-		m_DirtyRasterInstanceBuffers.insert(&meshAndInstancesIt->second);
+		MarkRasterInstanceDirty(meshEntry, instanceLocation.InstanceIndex);
 	}
 
 	void RenderSystem::RebuildBLAS(Entity entity, GUID_Lambda meshGUID, bool isAnimated, bool forceUniqueResources, bool manualResourceDeletion)
@@ -1877,6 +1887,11 @@ bool RenderSystem::InitIntegrationLUT()
 		DeleteDeviceResource(meshAndInstancesIt->second.pMeshlets);
 		DeleteDeviceResource(meshAndInstancesIt->second.pRasterInstanceBuffer);
 
+		for (Entity entity : meshAndInstancesIt->second.EntityIDs)
+		{
+			SetInstanceLocation(entity, nullptr, UINT32_MAX);
+		}
+
 		if (meshAndInstancesIt->second.pAnimatedVertexBuffer)
 		{
 			VALIDATE(meshAndInstancesIt->second.pAnimatedVertexBuffer);
@@ -1901,11 +1916,6 @@ bool RenderSystem::InitIntegrationLUT()
 			}
 		}
 
-		for (uint32 b = 0; b < BACK_BUFFER_COUNT; b++)
-		{
-			DeleteDeviceResource(meshAndInstancesIt->second.ppRasterInstanceStagingBuffers[b]);
-		}
-
 		auto dirtyRasterInstanceToRemove = std::find_if(m_DirtyRasterInstanceBuffers.begin(), m_DirtyRasterInstanceBuffers.end(), [meshAndInstancesIt](const MeshEntry* pMeshEntry)
 			{
 				return pMeshEntry == &meshAndInstancesIt->second;
@@ -2454,7 +2464,7 @@ bool RenderSystem::InitIntegrationLUT()
 		resourcesToRemove.Clear();
 	}
 
-	void RenderSystem::CreateDrawArgs(TArray<DrawArg>& drawArgs, const DrawArgMaskDesc& requestedMaskDesc) const
+	void RenderSystem::CreateDrawArgs(TFrameArray<DrawArg>& drawArgs, const DrawArgMaskDesc& requestedMaskDesc) const
 	{
 		for (auto& meshEntryPair : m_MeshAndInstancesMap)
 		{
@@ -2699,34 +2709,26 @@ bool RenderSystem::InitIntegrationLUT()
 
 	void RenderSystem::UpdateRasterInstanceBuffers(CommandList* pCommandList)
 	{
+		m_InstanceUploadOffset			= 0;
+		m_InstanceUploadBytesLastFrame	= 0;
+
 		for (MeshEntry* pDirtyInstanceBufferEntry : m_DirtyRasterInstanceBuffers)
 		{
-			//Raster Instances
-			{
-				uint32 requiredBufferSize = glm::max<uint32>(pDirtyInstanceBufferEntry->RasterInstances.GetSize() * sizeof(Instance), 1);
-
-				Buffer* pStagingBuffer = pDirtyInstanceBufferEntry->ppRasterInstanceStagingBuffers[m_ModFrameIndex];
-
-				if (pStagingBuffer == nullptr || pStagingBuffer->GetDesc().SizeInBytes < requiredBufferSize)
-				{
-					if (pStagingBuffer != nullptr)
-						DeleteDeviceResource(pStagingBuffer);
+			const uint32 instanceCount = pDirtyInstanceBufferEntry->RasterInstances.GetSize();
+			TArray<uint64>& dirtyInstanceMask = pDirtyInstanceBufferEntry->DirtyInstanceMask;
 
-					BufferDesc bufferDesc = {};
-					bufferDesc.DebugName	= "Raster Instance Staging Buffer";
-					bufferDesc.MemoryType	= EMemoryType::MEMORY_TYPE_CPU_VISIBLE;
-					bufferDesc.Flags		= FBufferFlag::BUFFER_FLAG_COPY_SRC;
-					bufferDesc.SizeInBytes	= requiredBufferSize;
-
-					pStagingBuffer = RenderAPI::GetDevice()->CreateBuffer(&bufferDesc);
-					pDirtyInstanceBufferEntry->ppRasterInstanceStagingBuffers[m_ModFrameIndex] = pStagingBuffer;
-				}
+			//Raster Instance Buffer
+			{
+				uint32 requiredBufferSize = glm::max<uint32>(instanceCount * sizeof(Instance), 1);
 
 				if (pDirtyInstanceBufferEntry->pRasterInstanceBuffer == nullptr || pDirtyInstanceBufferEntry->pRasterInstanceBuffer->GetDesc().SizeInBytes < requiredBufferSize)
 				{
 					if (pDirtyInstanceBufferEntry->pRasterInstanceBuffer != nullptr)
 						DeleteDeviceResource(pDirtyInstanceBufferEntry->pRasterInstanceBuffer);
 
+					// Grow with some slack so that spawning entities does not recreate the buffer every time
+					requiredBufferSize = glm::max<uint32>(instanceCount + instanceCount / 2, 1) * sizeof(Instance);
+
 					BufferDesc bufferDesc = {};
 					bufferDesc.DebugName		= "Raster Instance Buffer";
 					bufferDesc.MemoryType		= EMemoryType::MEMORY_TYPE_GPU;
@@ -2746,15 +2748,62 @@ bool RenderSystem::InitIntegrationLUT()
 						DRAW_ARG_INSTANCE_BUFFER_BINDING,
 						1,
 						EDescriptorType::DESCRIPTOR_TYPE_UNORDERED_ACCESS_BUFFER);
+
+					// A new buffer has no contents, so every instance has to be uploaded
+					dirtyInstanceMask.Resize((instanceCount + 63) / 64);
+					for (uint64& dirtyBits : dirtyInstanceMask)
+					{
+						dirtyBits = UINT64_MAX;
+					}
 				}
+			}
 
-				if (!pDirtyInstanceBufferEntry->RasterInstances.IsEmpty())
+			//Coalesce consecutive dirty instances into copy regions
+			{
+				Buffer* pRasterInstanceBuffer = pDirtyInstanceBufferEntry->pRasterInstanceBuffer;
+				const uint32 trackedInstanceCount = glm::min<uint32>(instanceCount, dirtyInstanceMask.GetSize() * 64);
+
+				uint32 i = 0;
+				while (i < trackedInstanceCount)
 				{
-					void* pMapped = pStagingBuffer->Map();
-					memcpy(pMapped, pDirtyInstanceBufferEntry->RasterInstances.GetData(), requiredBufferSize);
-					pStagingBuffer->Unmap();
+					const uint32 word = i / 64;
+					if (dirtyInstanceMask[word] == 0)
+					{
+						i = (word + 1) * 64;
+						continue;
+					}
+
+					if ((dirtyInstanceMask[word] & (1ull << (i % 64))) == 0)
+					{
+						i++;
+						continue;
+					}
+
+					const uint32 firstInstance = i;
+					while (i < trackedInstanceCount && (dirtyInstanceMask[i / 64] & (1ull << (i % 64))) != 0)
+					{
+						i++;
+					}
+
+					const uint64 regionSize = uint64(i - firstInstance) * sizeof(Instance);
 
-					pCommandList->CopyBuffer(pStagingBuffer, 0, pDirtyInstanceBufferEntry->pRasterInstanceBuffer, 0, requiredBufferSize);
+					uint64 srcOffset = 0;
+					void* pUploadMemory = AllocateInstanceUpload(regionSize, srcOffset);
+					memcpy(pUploadMemory, &pDirtyInstanceBufferEntry->RasterInstances[firstInstance], regionSize);
+
+					pCommandList->CopyBuffer(
+						m_ppInstanceUploadBuffers[m_ModFrameIndex],
+						srcOffset,
+						pRasterInstanceBuffer,
+						uint64(firstInstance) * sizeof(Instance),
+						regionSize);
+
+					m_InstanceUploadBytesLastFrame += regionSize;
+				}
+
+				for (uint64& dirtyBits : dirtyInstanceMask)
+				{
+					dirtyBits = 0;
 				}
 			}
 		}
@@ -2762,6 +2811,64 @@ bool RenderSystem::InitIntegrationLUT()
 		m_DirtyRasterInstanceBuffers.clear();
 	}
 
+	void RenderSystem::MarkRasterInstanceDirty(MeshEntry& meshEntry, uint32 instanceIndex)
+	{
+		const uint32 word = instanceIndex / 64;
+		if (word >= meshEntry.DirtyInstanceMask.GetSize())
+		{
+			meshEntry.DirtyInstanceMask.Resize(word + 1, 0);
+		}
+
+		meshEntry.DirtyInstanceMask[word] |= (1ull << (instanceIndex % 64));
+		m_DirtyRasterInstanceBuffers.insert(&meshEntry);
+	}
+
+	void RenderSystem::SetInstanceLocation(Entity entity, MeshEntry* pMeshEntry, uint32 instanceIndex)
+	{
+		if (entity >= m_EntityInstanceLocations.GetSize())
+		{
+			if (pMeshEntry == nullptr)
+				return;
+
+			m_EntityInstanceLocations.Resize(entity + 1);
+		}
+
+		InstanceLocation& instanceLocation = m_EntityInstanceLocations[entity];
+		instanceLocation.pMeshEntry		= pMeshEntry;
+		instanceLocation.InstanceIndex	= instanceIndex;
+	}
+
+	void* RenderSystem::AllocateInstanceUpload(uint64 sizeInBytes, uint64& offset)
+	{
+		Buffer*& pUploadBuffer = m_ppInstanceUploadBuffers[m_ModFrameIndex];
+		byte*& pUploadMemory = m_ppInstanceUploadMemory[m_ModFrameIndex];
+
+		const uint64 requiredSize = m_InstanceUploadOffset + sizeInBytes;
+		if (pUploadBuffer == nullptr || pUploadBuffer->GetDesc().SizeInBytes < requiredSize)
+		{
+			// Regions already recorded this frame keep referencing the old buffer, it is released once the frame has finished
+			if (pUploadBuffer != nullptr)
+			{
+				DeleteDeviceResource(pUploadBuffer);
+			}
+
+			m_InstanceUploadOffset = 0;
+
+			BufferDesc bufferDesc = {};
+			bufferDesc.DebugName	= "Raster Instance Upload Buffer";
+			bufferDesc.MemoryType	= EMemoryType::MEMORY_TYPE_CPU_VISIBLE;
+			bufferDesc.Flags		= FBufferFlag::BUFFER_FLAG_COPY_SRC;
+			bufferDesc.SizeInBytes	= glm::max<uint64>(requiredSize * 2, 64 * sizeof(Instance));
+
+			pUploadBuffer = RenderAPI::GetDevice()->CreateBuffer(&bufferDesc);
+			pUploadMemory = reinterpret_cast<byte*>(pUploadBuffer->Map());
+		}
+
+		offset = m_InstanceUploadOffset;
+		m_InstanceUploadOffset += sizeInBytes;
+		return pUploadMemory + offset;
+	}
+
 	void RenderSystem::UpdatePerFrameBuffer(CommandList* pCommandList)
 	{
 		Buffer* pPerFrameStagingBuffer = m_ppPerFrameStagingBuffers[m_ModFrameIndex];
@@ -3081,7 +3188,8 @@ bool RenderSystem::InitIntegrationLUT()
 		{
 			for (const DrawArgMaskDesc& maskDesc : m_DirtyDrawArgs)
 			{
-				TArray<DrawArg> drawArgs;
+				// The render graph copies the draw args, so they only need to live for this frame
+				TFrameArray<DrawArg> drawArgs;
 				CreateDrawArgs(drawArgs, maskDesc);
 
 				//Create Resource Update for RenderGraph
@@ -5,16 +5,770 @@
 #include "Application/API/PlatformConsole.h"
 #include "Application/API/PlatformMisc.h"
 
+#include "Containers/String.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <mutex>
 #include <stdio.h>
+#include <thread>
 
 namespace LambdaEngine
 {
-	bool Log::s_DebuggerOutputEnabled = false;
+	/*
+	* LogConversion - One conversion specification of a format string. The caller and the log thread parse the format
+	* the same way, the caller to know which arguments to read from the va_list and the log thread to know which
+	* arguments were recorded
+	*/
+
+	enum ELogArgumentType : uint32
+	{
+		LOG_ARGUMENT_TYPE_NONE			= 0,	// "%%", no argument
+		LOG_ARGUMENT_TYPE_SIGNED		= 1,	// Recorded as int64 and printed with the length modifier "ll"
+		LOG_ARGUMENT_TYPE_UNSIGNED		= 2,	// Recorded as uint64 and printed with the length modifier "ll"
+		LOG_ARGUMENT_TYPE_CHAR			= 3,
+		LOG_ARGUMENT_TYPE_FLOAT			= 4,	// Recorded as float64, long doubles are narrowed
+		LOG_ARGUMENT_TYPE_POINTER		= 5,
+		LOG_ARGUMENT_TYPE_STRING		= 6,	// Copied into the record
+		LOG_ARGUMENT_TYPE_UNSUPPORTED	= 7,	// Wide characters, "%n" and positional arguments, the caller formats the message
+	};
+
+	enum ELogArgumentLength : uint32
+	{
+		LOG_ARGUMENT_LENGTH_DEFAULT		= 0,
+		LOG_ARGUMENT_LENGTH_HH			= 1,
+		LOG_ARGUMENT_LENGTH_H			= 2,
+		LOG_ARGUMENT_LENGTH_L			= 3,
+		LOG_ARGUMENT_LENGTH_LL			= 4,
+		LOG_ARGUMENT_LENGTH_J			= 5,
+		LOG_ARGUMENT_LENGTH_Z			= 6,
+		LOG_ARGUMENT_LENGTH_T			= 7,
+		LOG_ARGUMENT_LENGTH_LONG_DOUBLE	= 8,
+	};
+
+	struct LogConversion
+	{
+		const char*			pBegin				= nullptr;	// The '%'
+		const char*			pLength				= nullptr;	// The length modifier, removed when the conversion is printed
+		const char*			pEnd				= nullptr;	// One past the conversion character
+		ELogArgumentType	Type				= LOG_ARGUMENT_TYPE_NONE;
+		ELogArgumentLength	Length				= LOG_ARGUMENT_LENGTH_DEFAULT;
+		int32				Precision			= -1;
+		bool				HasStarWidth		= false;
+		bool				HasStarPrecision	= false;
+	};
+
+	// Longest conversion specification that is printed from a record, longer ones are formatted by the caller
+	static constexpr const uint32 MAX_CONVERSION_LENGTH = 24;
+
+	/*
+	* Finds the next conversion of pFormat, returns false if there is none. pFormat points past the conversion afterwards
+	*/
+	static bool FindConversion(const char*& pFormat, LogConversion& conversion)
+	{
+		const char* pCurrent = strchr(pFormat, '%');
+		if (!pCurrent)
+		{
+			pFormat += strlen(pFormat);
+			return false;
+		}
+
+		conversion = {};
+		conversion.pBegin = pCurrent++;
+
+		if (*pCurrent == '%')
+		{
+			conversion.pLength	= pCurrent;
+			conversion.pEnd		= pCurrent + 1;
+			pFormat				= conversion.pEnd;
+			return true;
+		}
+
+		while (*pCurrent == '-' || *pCurrent == '+' || *pCurrent == ' ' || *pCurrent == '#' || *pCurrent == '0')
+		{
+			pCurrent++;
+		}
+
+		if (*pCurrent == '*')
+		{
+			conversion.HasStarWidth = true;
+			pCurrent++;
+		}
+		else
+		{
+			while (*pCurrent >= '0' && *pCurrent <= '9')
+			{
+				pCurrent++;
+			}
+
+			// Positional arguments, "%1$d"
+			if (*pCurrent == '$')
+			{
+				conversion.Type = LOG_ARGUMENT_TYPE_UNSUPPORTED;
+			}
+		}
+
+		if (*pCurrent == '.')
+		{
+			pCurrent++;
+			if (*pCurrent == '*')
+			{
+				conversion.HasStarPrecision = true;
+				pCurrent++;
+			}
+			else
+			{
+				conversion.Precision = 0;
+				while (*pCurrent >= '0' && *pCurrent <= '9')
+				{
+					conversion.Precision = conversion.Precision * 10 + (*pCurrent - '0');
+					pCurrent++;
+				}
+			}
+		}
+
+		conversion.pLength = pCurrent;
+		switch (*pCurrent)
+		{
+			case 'h':	conversion.Length = pCurrent[1] == 'h' ? LOG_ARGUMENT_LENGTH_HH : LOG_ARGUMENT_LENGTH_H;	break;
+			case 'l':	conversion.Length = pCurrent[1] == 'l' ? LOG_ARGUMENT_LENGTH_LL : LOG_ARGUMENT_LENGTH_L;	break;
+			case 'j':	conversion.Length = LOG_ARGUMENT_LENGTH_J;													break;
+			case 'z':	conversion.Length = LOG_ARGUMENT_LENGTH_Z;													break;
+			case 't':	conversion.Length = LOG_ARGUMENT_LENGTH_T;													break;
+			case 'L':	conversion.Length = LOG_ARGUMENT_LENGTH_LONG_DOUBLE;										break;
+			default:	break;
+		}
+
+		if (conversion.Length == LOG_ARGUMENT_LENGTH_HH || conversion.Length == LOG_ARGUMENT_LENGTH_LL)
+		{
+			pCurrent += 2;
+		}
+		else if (conversion.Length != LOG_ARGUMENT_LENGTH_DEFAULT)
+		{
+			pCurrent++;
+		}
+
+		const char type = *pCurrent;
+		if (type == '\0')
+		{
+			// A '%' at the end of the format prints nothing, let vsnprintf handle it
+			conversion.Type	= LOG_ARGUMENT_TYPE_UNSUPPORTED;
+			conversion.pEnd	= pCurrent;
+			pFormat			= pCurrent;
+			return true;
+		}
+
+		conversion.pEnd	= pCurrent + 1;
+		pFormat			= conversion.pEnd;
+
+		if (conversion.Type == LOG_ARGUMENT_TYPE_UNSUPPORTED || conversion.pEnd - conversion.pBegin > MAX_CONVERSION_LENGTH)
+		{
+			conversion.Type = LOG_ARGUMENT_TYPE_UNSUPPORTED;
+			return true;
+		}
+
+		const bool isWide = conversion.Length == LOG_ARGUMENT_LENGTH_L;
+		switch (type)
+		{
+			case 'd': case 'i':
+				conversion.Type = LOG_ARGUMENT_TYPE_SIGNED;
+				break;
+			case 'u': case 'o': case 'x': case 'X':
+				conversion.Type = LOG_ARGUMENT_TYPE_UNSIGNED;
+				break;
+			case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+				conversion.Type = LOG_ARGUMENT_TYPE_FLOAT;
+				break;
+			case 'c':
+				conversion.Type = isWide ? LOG_ARGUMENT_TYPE_UNSUPPORTED : LOG_ARGUMENT_TYPE_CHAR;
+				break;
+			case 's':
+				conversion.Type = isWide ? LOG_ARGUMENT_TYPE_UNSUPPORTED : LOG_ARGUMENT_TYPE_STRING;
+				break;
+			case 'p':
+				conversion.Type = LOG_ARGUMENT_TYPE_POINTER;
+				break;
+			default:
+				conversion.Type = LOG_ARGUMENT_TYPE_UNSUPPORTED;
+				break;
+		}
+
+		return true;
+	}
+
+	/*
+	* LogRecord - A message in a ring. The header is followed by the file name, the format and the arguments in the
+	* order of the format. Every argument takes 8 bytes and strings are stored as their length followed by the
+	* characters and a null terminator. The format is copied as well, callers may pass formats that do not outlive the
+	* call. Records never wrap around the end of a ring, the space left at the end is skipped with a padding record
+	*/
+
+	enum ELogRecordType : uint32
+	{
+		LOG_RECORD_TYPE_PADDING			= 0,
+		LOG_RECORD_TYPE_ARGUMENTS		= 1,
+		LOG_RECORD_TYPE_PREFORMATTED	= 2,	// The file name is followed by the formatted message instead of the format
+	};
+
+	struct LogRecordHeader
+	{
+		uint32			SizeInBytes;
+		ELogRecordType	Type;
+		uint32			LineNr;
+		ELogSeverity	Severity;
+	};
+
+	static constexpr const uint32 LOG_RECORD_ALIGNMENT	= 8;
+	static constexpr const uint32 MAX_RECORD_SIZE		= 4 * 1024;
+
+	class LogRecordWriter
+	{
+	public:
+		LogRecordWriter(byte* pBegin, uint64 sizeInBytes)
+			: m_pBegin(pBegin)
+			, m_Offset(0)
+			, m_SizeInBytes(sizeInBytes)
+		{
+		}
+
+		template<typename T>
+		FORCEINLINE void Write(T value)
+		{
+			static_assert(sizeof(T) <= LOG_RECORD_ALIGNMENT);
+
+			if (m_Offset + LOG_RECORD_ALIGNMENT <= m_SizeInBytes)
+			{
+				memcpy(m_pBegin + m_Offset, &value, sizeof(T));
+			}
+
+			m_Offset += LOG_RECORD_ALIGNMENT;
+		}
+
+		FORCEINLINE void WriteString(const char* pString, int32 precision)
+		{
+			const uint64 length = precision >= 0 ? strnlen(pString, uint64(precision)) : strlen(pString);
+			Write<uint64>(length);
+
+			if (m_Offset + length + 1 <= m_SizeInBytes)
+			{
+				memcpy(m_pBegin + m_Offset, pString, length);
+				m_pBegin[m_Offset + length] = '\0';
+			}
+
+			m_Offset += AlignUp(length + 1);
+		}
+
+		// Formats the message into the record the same way WriteString stores a string, returns false if it does not fit
+		FORCEINLINE bool WriteFormatted(const char* pFormat, va_list vaArgs)
+		{
+			const uint64 lengthOffset = m_Offset;
+			Write<uint64>(0);
+
+			if (m_Offset >= m_SizeInBytes)
+			{
+				return false;
+			}
+
+			const uint64 maxLength = m_SizeInBytes - m_Offset;
+			const int32 length = vsnprintf(reinterpret_cast<char*>(m_pBegin + m_Offset), maxLength, pFormat, vaArgs);
+			if (length < 0 || uint64(length) >= maxLength)
+			{
+				return false;
+			}
+
+			const uint64 stringLength = uint64(length);
+			memcpy(m_pBegin + lengthOffset, &stringLength, sizeof(uint64));
+			m_Offset += AlignUp(stringLength + 1);
+			return true;
+		}
+
+		FORCEINLINE void Rewind(uint64 offset)
+		{
+			m_Offset = offset;
+		}
+
+		// Nothing past the end has been written, the record has to be dropped or formatted another way
+		FORCEINLINE bool HasOverflowed() const
+		{
+			return m_Offset > m_SizeInBytes;
+		}
+
+		FORCEINLINE uint64 GetOffset() const
+		{
+			return m_Offset;
+		}
+
+		FORCEINLINE static uint64 AlignUp(uint64 sizeInBytes)
+		{
+			return (sizeInBytes + LOG_RECORD_ALIGNMENT - 1) & ~uint64(LOG_RECORD_ALIGNMENT - 1);
+		}
+
+	private:
+		byte*	m_pBegin;
+		uint64	m_Offset;
+		uint64	m_SizeInBytes;
+	};
+
+	class LogRecordReader
+	{
+	public:
+		LogRecordReader(const byte* pArguments)
+			: m_pCurrent(pArguments)
+		{
+		}
+
+		template<typename T>
+		FORCEINLINE T Read()
+		{
+			T value;
+			memcpy(&value, m_pCurrent, sizeof(T));
+			m_pCurrent += LOG_RECORD_ALIGNMENT;
+			return value;
+		}
+
+		FORCEINLINE const char* ReadString()
+		{
+			const uint64 length = Read<uint64>();
+			const char* pString = reinterpret_cast<const char*>(m_pCurrent);
+			m_pCurrent += LogRecordWriter::AlignUp(length + 1);
+			return pString;
+		}
+
+	private:
+		const byte* m_pCurrent;
+	};
+
+	/*
+	* LogRing - The records of one thread. Only the thread that owns the ring writes records and only the log thread
+	* reads them, the positions grow forever and are masked into the ring. The write state and the read state are
+	* padded onto separate cache lines
+	*/
+
+	static constexpr const uint32 CACHE_LINE_SIZE	= 64;
+	static constexpr const uint64 LOG_RING_SIZE		= 128 * 1024;
+
+	enum ELogRingState : uint32
+	{
+		LOG_RING_STATE_OWNED	= 0,	// Used by a thread
+		LOG_RING_STATE_RETIRED	= 1,	// The thread has exited, the next thread to log may take it
+		LOG_RING_STATE_ORPHANED	= 2,	// The log thread has been stopped while the thread was alive
+	};
+
+	struct LogRing
+	{
+		// Write state
+		std::atomic_uint64_t	WritePosition		= 0;
+		std::atomic_uint64_t	DroppedCount		= 0;
+		byte					WritePadding[CACHE_LINE_SIZE];
+
+		// Read state
+		std::atomic_uint64_t	ReadPosition		= 0;
+		uint64					ReportedDropCount	= 0;
+		byte					ReadPadding[CACHE_LINE_SIZE];
+
+		std::atomic_uint32_t	State				= LOG_RING_STATE_OWNED;
+		LogRing*				pNext				= nullptr;
+
+		alignas(LOG_RECORD_ALIGNMENT) byte Data[LOG_RING_SIZE];
+	};
+
+	/*
+	* ThreadLogRing - The ring of the calling thread, it belongs to the log thread that was running when it was created.
+	* Log thread IDs are never reused, so the ring of a stopped log thread is never written to again
+	*/
+
+	struct ThreadLogRing
+	{
+		uint64		LogThreadID	= 0;
+		LogRing*	pRing		= nullptr;
+
+		~ThreadLogRing()
+		{
+			Retire(pRing);
+		}
+
+		static void Retire(LogRing* pRing)
+		{
+			// The log thread has already been stopped, the ring is left for the thread to delete
+			if (pRing && pRing->State.exchange(LOG_RING_STATE_RETIRED, std::memory_order_acq_rel) == LOG_RING_STATE_ORPHANED)
+			{
+				delete pRing;
+			}
+		}
+	};
+
+	static thread_local ThreadLogRing g_ThreadLogRing;
+	static thread_local bool g_IsLogThread = false;
+
+	static std::atomic<LogRing*>	g_pLogRings				= nullptr;
+	static std::atomic_uint32_t		g_LogRingCount			= 0;
+	static std::atomic_uint64_t		g_LogThreadID			= 0;
+	static std::atomic_bool			g_AsyncOutputEnabled	= false;
+	static std::atomic_uint64_t		g_WrittenMessageCount	= 0;
+
+	static std::thread				g_LogThread;
+	static std::atomic_bool			g_LogThreadRunning		= false;
+	static std::mutex				g_LogThreadMutex;
+	static std::condition_variable	g_LogThreadCondition;
+
+	// Held while a thread other than the log thread walks the rings, StopAsync takes it before the rings are freed
+	static std::mutex				g_LogRingListMutex;
+
+	/*
+	* Output - Shared by the log thread and the threads that print synchronously
+	*/
+
+	static SpinLock			g_OutputLock;
+	static FILE*			g_pLogFile			= nullptr;
+	static String			g_LastMessage;
+	static ELogSeverity		g_LastSeverity		= ELogSeverity::LOG_MESSAGE;
+	static uint32			g_MessageCount		= 1;
+	static EConsoleColor	g_ConsoleColor		= EConsoleColor::COLOR_WHITE;
+
+	// Set while the calling thread holds g_OutputLock, an assert inside the lock prints without taking it again
+	static thread_local bool g_HoldsOutputLock = false;
+
+	struct OutputLock
+	{
+		OutputLock()
+		{
+			g_OutputLock.lock();
+			g_HoldsOutputLock = true;
+		}
+
+		~OutputLock()
+		{
+			g_HoldsOutputLock = false;
+			g_OutputLock.unlock();
+		}
+	};
+
+	// Stops the log thread if StopAsync was never called, before the state above is destroyed
+	struct LogThreadGuard
+	{
+		~LogThreadGuard()
+		{
+			Log::StopAsync();
+		}
+	};
+
+	static LogThreadGuard g_LogThreadGuard;
+
+	static void SetConsoleColor(EConsoleColor color)
+	{
+		if (g_ConsoleColor != color)
+		{
+			PlatformConsole::SetColor(color);
+			g_ConsoleColor = color;
+		}
+	}
+
+	/*
+	* Prints a formatted message, g_OutputLock must be held. The console color is only changed when the severity
+	* changes, resetColor sets it back to white afterwards
+	*/
+	static void WriteMessage(ELogSeverity severity, String& message, bool debuggerOutput, bool resetColor)
+	{
+		if (severity == ELogSeverity::LOG_INFO)
+		{
+			SetConsoleColor(EConsoleColor::COLOR_GREEN);
+		}
+		else if (severity == ELogSeverity::LOG_WARNING)
+		{
+			SetConsoleColor(EConsoleColor::COLOR_YELLOW);
+		}
+		else if (severity == ELogSeverity::LOG_ERROR)
+		{
+			SetConsoleColor(EConsoleColor::COLOR_RED);
+		}
+		else
+		{
+			SetConsoleColor(EConsoleColor::COLOR_WHITE);
+		}
+
+		// Print message
+		if (debuggerOutput)
+		{
+			PlatformMisc::OutputDebugString(message.c_str());
+		}
+
+		if (g_pLogFile)
+		{
+			fputs(message.c_str(), g_pLogFile);
+			fputc('\n', g_pLogFile);
+		}
+
+		// Check if last message is the same
+		if (g_LastMessage != message || g_LastSeverity != severity)
+		{
+			g_LastMessage	= message;
+			g_LastSeverity	= severity;
+			g_MessageCount	= 1;
+		}
+		else
+		{
+			g_MessageCount++;
+			message += " (x" + std::to_string(g_MessageCount) + " Times)";
+
+			PlatformConsole::ClearLastLine();
+		}
+
+		PlatformConsole::PrintLine("%s", message.c_str());
+
+		if (resetColor)
+		{
+			SetConsoleColor(EConsoleColor::COLOR_WHITE);
+		}
+	}
+
+	// Appends "file (line): " with the path removed from the file name
+	static void AppendPrefix(String& message, const char* pFileName, uint32 lineNr)
+	{
+		const char* pSeparator = strrchr(pFileName, '\\');
+		message += pSeparator ? pSeparator + 1 : pFileName;
+		message += " (";
+		message += std::to_string(lineNr);
+		message += "): ";
+	}
+
+	template<typename... TArgs>
+	static void AppendFormatted(String& message, const char* pFormat, TArgs... args)
+	{
+		const int32 length = snprintf(nullptr, 0, pFormat, args...);
+		if (length > 0)
+		{
+			const uint64 offset = message.size();
+			message.resize(offset + uint64(length));
+
+			// The string reserves one more char than its size, the terminator is written there
+			snprintf(message.data() + offset, uint64(length) + 1, pFormat, args...);
+		}
+	}
+
+	template<typename T>
+	static void AppendConversion(String& message, const char* pSpecification, const LogConversion& conversion, int32 width, int32 precision, T value)
+	{
+		if (conversion.HasStarWidth && conversion.HasStarPrecision)
+		{
+			AppendFormatted(message, pSpecification, width, precision, value);
+		}
+		else if (conversion.HasStarWidth)
+		{
+			AppendFormatted(message, pSpecification, width, value);
+		}
+		else if (conversion.HasStarPrecision)
+		{
+			AppendFormatted(message, pSpecification, precision, value);
+		}
+		else
+		{
+			AppendFormatted(message, pSpecification, value);
+		}
+	}
+
+	/*
+	* Formats a record the same way vsnprintf would have formatted the arguments it was recorded from
+	*/
+	static void FormatRecord(String& message, const LogRecordHeader& header)
+	{
+		LogRecordReader reader(reinterpret_cast<const byte*>(&header + 1));
+		AppendPrefix(message, reader.ReadString(), header.LineNr);
+
+		if (header.Type == LOG_RECORD_TYPE_PREFORMATTED)
+		{
+			message += reader.ReadString();
+			return;
+		}
+
+		const char* pFormat = reader.ReadString();
+		const char* pLiteral = pFormat;
+
+		LogConversion conversion;
+		while (FindConversion(pFormat, conversion))
+		{
+			message.append(pLiteral, conversion.pBegin);
+			pLiteral = pFormat;
+
+			if (conversion.Type == LOG_ARGUMENT_TYPE_NONE)
+			{
+				message += '%';
+				continue;
+			}
+
+			// The conversion without its length modifier, integers are printed as long long
+			char specification[MAX_CONVERSION_LENGTH + 3];
+			const uint64 lengthOffset = uint64(conversion.pLength - conversion.pBegin);
+			memcpy(specification, conversion.pBegin, lengthOffset);
+
+			char* pSpecificationEnd = specification + lengthOffset;
+			if (conversion.Type == LOG_ARGUMENT_TYPE_SIGNED || conversion.Type == LOG_ARGUMENT_TYPE_UNSIGNED)
+			{
+				*(pSpecificationEnd++) = 'l';
+				*(pSpecificationEnd++) = 'l';
+			}
+
+			*(pSpecificationEnd++) = conversion.pEnd[-1];
+			*pSpecificationEnd = '\0';
+
+			const int32 width		= conversion.HasStarWidth ? reader.Read<int32>() : 0;
+			const int32 precision	= conversion.HasStarPrecision ? reader.Read<int32>() : 0;
+
+			switch (conversion.Type)
+			{
+				case LOG_ARGUMENT_TYPE_SIGNED:		AppendConversion(message, specification, conversion, width, precision, reader.Read<long long>());			break;
+				case LOG_ARGUMENT_TYPE_UNSIGNED:	AppendConversion(message, specification, conversion, width, precision, reader.Read<unsigned long long>());	break;
+				case LOG_ARGUMENT_TYPE_CHAR:		AppendConversion(message, specification, conversion, width, precision, reader.Read<int32>());				break;
+				case LOG_ARGUMENT_TYPE_FLOAT:		AppendConversion(message, specification, conversion, width, precision, reader.Read<float64>());				break;
+				case LOG_ARGUMENT_TYPE_POINTER:		AppendConversion(message, specification, conversion, width, precision, reader.Read<void*>());				break;
+				case LOG_ARGUMENT_TYPE_STRING:		AppendConversion(message, specification, conversion, width, precision, reader.ReadString());				break;
+				default: break;
+			}
+		}
+
+		message.append(pLiteral, pFormat);
+	}
+
+	/*
+	* Records the arguments of a message, returns false if the format has a conversion that cannot be recorded
+	*/
+	static bool WriteArguments(LogRecordWriter& writer, const char* pFormat, va_list vaArgs)
+	{
+		LogConversion conversion;
+		while (FindConversion(pFormat, conversion))
+		{
+			int32 precision = conversion.Precision;
+			if (conversion.HasStarWidth)
+			{
+				writer.Write<int32>(va_arg(vaArgs, int));
+			}
+
+			if (conversion.HasStarPrecision)
+			{
+				precision = va_arg(vaArgs, int);
+				writer.Write<int32>(precision);
+			}
+
+			switch (conversion.Type)
+			{
+				case LOG_ARGUMENT_TYPE_NONE:
+				{
+					break;
+				}
+				case LOG_ARGUMENT_TYPE_SIGNED:
+				{
+					int64 value = 0;
+					switch (conversion.Length)
+					{
+						case LOG_ARGUMENT_LENGTH_HH:	value = int64(static_cast<signed char>(va_arg(vaArgs, int)));	break;
+						case LOG_ARGUMENT_LENGTH_H:		value = int64(static_cast<short>(va_arg(vaArgs, int)));			break;
+						case LOG_ARGUMENT_LENGTH_L:		value = int64(va_arg(vaArgs, long));							break;
+						case LOG_ARGUMENT_LENGTH_LL:	value = int64(va_arg(vaArgs, long long));						break;
+						case LOG_ARGUMENT_LENGTH_J:		value = int64(va_arg(vaArgs, intmax_t));						break;
+						case LOG_ARGUMENT_LENGTH_Z:		value = int64(va_arg(vaArgs, size_t));							break;
+						case LOG_ARGUMENT_LENGTH_T:		value = int64(va_arg(vaArgs, ptrdiff_t));						break;
+						default:						value = int64(va_arg(vaArgs, int));								break;
+					}
+
+					writer.Write<long long>(value);
+					break;
+				}
+				case LOG_ARGUMENT_TYPE_UNSIGNED:
+				{
+					uint64 value = 0;
+					switch (conversion.Length)
+					{
+						case LOG_ARGUMENT_LENGTH_HH:	value = uint64(static_cast<unsigned char>(va_arg(vaArgs, int)));	break;
+						case LOG_ARGUMENT_LENGTH_H:		value = uint64(static_cast<unsigned short>(va_arg(vaArgs, int)));	break;
+						case LOG_ARGUMENT_LENGTH_L:		value = uint64(va_arg(vaArgs, unsigned long));						break;
+						case LOG_ARGUMENT_LENGTH_LL:	value = uint64(va_arg(vaArgs, unsigned long long));					break;
+						case LOG_ARGUMENT_LENGTH_J:		value = uint64(va_arg(vaArgs, uintmax_t));							break;
+						case LOG_ARGUMENT_LENGTH_Z:		value = uint64(va_arg(vaArgs, size_t));								break;
+						case LOG_ARGUMENT_LENGTH_T:		value = uint64(va_arg(vaArgs, ptrdiff_t));							break;
+						default:						value = uint64(va_arg(vaArgs, unsigned int));						break;
+					}
+
+					writer.Write<unsigned long long>(value);
+					break;
+				}
+				case LOG_ARGUMENT_TYPE_CHAR:
+				{
+					writer.Write<int32>(va_arg(vaArgs, int));
+					break;
+				}
+				case LOG_ARGUMENT_TYPE_FLOAT:
+				{
+					if (conversion.Length == LOG_ARGUMENT_LENGTH_LONG_DOUBLE)
+					{
+						writer.Write<float64>(float64(va_arg(vaArgs, long double)));
+					}
+					else
+					{
+						writer.Write<float64>(va_arg(vaArgs, double));
+					}
+
+					break;
+				}
+				case LOG_ARGUMENT_TYPE_POINTER:
+				{
+					writer.Write<void*>(va_arg(vaArgs, void*));
+					break;
+				}
+				case LOG_ARGUMENT_TYPE_STRING:
+				{
+					const char* pString = va_arg(vaArgs, const char*);
+					writer.WriteString(pString ? pString : "(null)", precision);
+					break;
+				}
+				default:
+				{
+					return false;
+				}
+			}
+
+			if (writer.HasOverflowed())
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	/*
+	* Formats and prints a message on the calling thread
+	*/
+	static void PrintSynchronous(const char* pFileName, uint32 lineNr, ELogSeverity severity, const char* pFormat, va_list vaArgs, bool debuggerOutput)
+	{
+		static thread_local String message;
+		message.clear();
+
+		AppendPrefix(message, pFileName, lineNr);
+
+		// Check length of formated string and resize buffer
+		va_list vaCopy;
+		va_copy(vaCopy, vaArgs);
+		const int32 length = vsnprintf(nullptr, 0, pFormat, vaCopy);
+		va_end(vaCopy);
+
+		if (length > 0)
+		{
+			const uint64 prefixLength = message.size();
+			message.resize(prefixLength + uint64(length));
+
+			// Since we reserve 1 more char than length this should be safe to do
+			vsnprintf(message.data() + prefixLength, uint64(length) + 1, pFormat, vaArgs);
+		}
+
+		OutputLock lock;
+		WriteMessage(severity, message, debuggerOutput, true);
+	}
 
 	/*
 	* Log
 	*/
+	bool Log::s_DebuggerOutputEnabled = false;
+
 	void Log::Print(const char* pFileName, uint32 lineNr, ELogSeverity severity, const char* pFormat, ...)
 	{
 		va_list args;
@@ -27,92 +781,418 @@ namespace LambdaEngine
 
 	void Log::PrintV(const char* pFileName, uint32 lineNr, ELogSeverity severity, const char* pFormat, va_list vaArgs)
 	{
-		if (severity == ELogSeverity::LOG_INFO)
+		if (g_AsyncOutputEnabled.load(std::memory_order_acquire) && !g_IsLogThread)
 		{
-			PlatformConsole::SetColor(EConsoleColor::COLOR_GREEN);
+			if (PrintAsync(pFileName, lineNr, severity, pFormat, vaArgs))
+			{
+				return;
+			}
+
+			// The message is printed here, the ones that were logged before it are written first
+			Flush();
 		}
-		else if (severity == ELogSeverity::LOG_WARNING)
+
+		PrintSynchronous(pFileName, lineNr, severity, pFormat, vaArgs, s_DebuggerOutputEnabled);
+	}
+
+	void Log::PrintTraceError(const char* pFunction, const char* pFileName, uint32 lineNr, const char* pFormat, ...)
+	{
+		va_list args;
+		va_start(args, pFormat);
+
+		PrintTraceErrorV(pFunction, pFileName, lineNr, pFormat, args);
+
+		va_end(args);
+	}
+
+	void Log::PrintTraceErrorV(const char* pFunction, const char* pFileName, uint32 lineNr, const char* pFormat, va_list vaArgs)
+	{
+		// Critical errors are printed on the calling thread, the messages logged before them are written first
+		Flush();
+
 		{
-			PlatformConsole::SetColor(EConsoleColor::COLOR_YELLOW);
+			OutputLock lock;
+			SetConsoleColor(EConsoleColor::COLOR_RED);
+			PlatformConsole::Print("CRITICAL ERROR IN '%s': ", pFunction);
+			SetConsoleColor(EConsoleColor::COLOR_WHITE);
 		}
-		else if (severity == ELogSeverity::LOG_ERROR)
+
+		PrintSynchronous(pFileName, lineNr, ELogSeverity::LOG_ERROR, pFormat, vaArgs, s_DebuggerOutputEnabled);
+	}
+
+	bool Log::PrintAsync(const char* pFileName, uint32 lineNr, ELogSeverity severity, const char* pFormat, va_list vaArgs)
+	{
+		// Get the ring of the calling thread
+		ThreadLogRing& threadRing = g_ThreadLogRing;
+
+		const uint64 logThreadID = g_LogThreadID.load(std::memory_order_acquire);
+		if (threadRing.LogThreadID != logThreadID)
 		{
-			PlatformConsole::SetColor(EConsoleColor::COLOR_RED);
+			ThreadLogRing::Retire(threadRing.pRing);
+			threadRing.pRing = nullptr;
+
+			// Take the ring of a thread that has exited before creating a new one
+			for (LogRing* pRetired = g_pLogRings.load(std::memory_order_acquire); pRetired && !threadRing.pRing; pRetired = pRetired->pNext)
+			{
+				uint32 expected = LOG_RING_STATE_RETIRED;
+				if (pRetired->State.compare_exchange_strong(expected, LOG_RING_STATE_OWNED, std::memory_order_acq_rel))
+				{
+					threadRing.pRing = pRetired;
+				}
+			}
+
+			if (!threadRing.pRing)
+			{
+				LogRing* pRing = DBG_NEW LogRing();
+
+				// Rings are only ever added to the front, so the log thread can walk the list while threads add rings
+				LogRing* pHead = g_pLogRings.load(std::memory_order_relaxed);
+				do
+				{
+					pRing->pNext = pHead;
+				} while (!g_pLogRings.compare_exchange_weak(pHead, pRing, std::memory_order_release, std::memory_order_relaxed));
+
+				g_LogRingCount.fetch_add(1, std::memory_order_relaxed);
+				threadRing.pRing = pRing;
+			}
+
+			threadRing.LogThreadID = logThreadID;
 		}
 
-		{
-			static SpinLock bufferLock;
-			std::scoped_lock<SpinLock> lock(bufferLock);
+		LogRing* pRing = threadRing.pRing;
+
+		// Build the record on the stack, messages that do not fit are printed synchronously
+		alignas(LOG_RECORD_ALIGNMENT) byte record[MAX_RECORD_SIZE];
+
+		LogRecordHeader* pHeader = reinterpret_cast<LogRecordHeader*>(record);
+		pHeader->Type		= LOG_RECORD_TYPE_ARGUMENTS;
+		pHeader->LineNr		= lineNr;
+		pHeader->Severity	= severity;
+
+		// The path is removed from the file name before it is copied
+		const char* pSeparator = strrchr(pFileName, '\\');
+
+		LogRecordWriter writer(record + sizeof(LogRecordHeader), MAX_RECORD_SIZE - sizeof(LogRecordHeader));
+		writer.WriteString(pSeparator ? pSeparator + 1 : pFileName, -1);
+
+		const uint64 formatOffset = writer.GetOffset();
+		writer.WriteString(pFormat, -1);
 
-			// Remove the path from the file string
-			String fileName(pFileName);
-			fileName = String(&pFileName[fileName.find_last_of('\\') + 1]);
+		// The va_list is left untouched, it is needed again if the message ends up being printed synchronously
+		va_list vaCopy;
+		va_copy(vaCopy, vaArgs);
+		const bool recorded = !writer.HasOverflowed() && WriteArguments(writer, pFormat, vaCopy);
+		va_end(vaCopy);
 
-			const String prefix = fileName + " (" + std::to_string(lineNr) + "): ";
+		if (!recorded)
+		{
+			if (writer.HasOverflowed())
+			{
+				return false;
+			}
 
-			static String buffer;
-			static String lastMessage;
+			// Conversions that cannot be recorded are formatted here, the record holds the message instead of the format
+			writer.Rewind(formatOffset);
 
-			// Check length of formated string and resize buffer
-			va_list vaCopy;
 			va_copy(vaCopy, vaArgs);
-			const int32 length = vsnprintf(nullptr, 0, pFormat, vaCopy);
+			const bool formatted = writer.WriteFormatted(pFormat, vaCopy);
 			va_end(vaCopy);
 
-			buffer.resize(prefix.size() + uint64(length));
-			memcpy(buffer.data(), prefix.data(), prefix.size());
+			if (!formatted)
+			{
+				return false;
+			}
 
-			// Since we reserve 1 more char than length this should be safe to do
-			vsnprintf(buffer.data() + prefix.size(), length + 1, pFormat, vaArgs);
+			pHeader->Type = LOG_RECORD_TYPE_PREFORMATTED;
+		}
+
+		const uint64 recordSize = sizeof(LogRecordHeader) + writer.GetOffset();
+		pHeader->SizeInBytes = uint32(recordSize);
+
+		// Records do not wrap around, the space left at the end of the ring is skipped if the record does not fit
+		const uint64 writePosition	= pRing->WritePosition.load(std::memory_order_relaxed);
+		const uint64 readPosition	= pRing->ReadPosition.load(std::memory_order_acquire);
+		const uint64 ringOffset		= writePosition & (LOG_RING_SIZE - 1);
+		const uint64 spaceAtEnd		= LOG_RING_SIZE - ringOffset;
+		const uint64 paddingSize	= recordSize > spaceAtEnd ? spaceAtEnd : 0;
+
+		const uint64 usedSize = writePosition - readPosition;
+		if (usedSize + paddingSize + recordSize > LOG_RING_SIZE)
+		{
+			// Only the owner writes the counter, the log thread reports it
+			pRing->DroppedCount.store(pRing->DroppedCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+			return true;
+		}
+
+		if (paddingSize > 0)
+		{
+			LogRecordHeader* pPadding = reinterpret_cast<LogRecordHeader*>(pRing->Data + ringOffset);
+			pPadding->SizeInBytes	= uint32(paddingSize);
+			pPadding->Type			= LOG_RECORD_TYPE_PADDING;
+		}
+
+		memcpy(pRing->Data + ((writePosition + paddingSize) & (LOG_RING_SIZE - 1)), record, recordSize);
+		pRing->WritePosition.store(writePosition + paddingSize + recordSize, std::memory_order_release);
+
+		// The log thread polls, it is only woken when a ring is filling up
+		constexpr const uint64 WAKE_THRESHOLD = LOG_RING_SIZE / 2;
+		if (usedSize < WAKE_THRESHOLD && usedSize + paddingSize + recordSize >= WAKE_THRESHOLD)
+		{
+			g_LogThreadCondition.notify_one();
+		}
+
+		return true;
+	}
 
-			// Print message
-			if (s_DebuggerOutputEnabled)
+	/*
+	* Writes the records in every ring and reports the dropped messages, returns the number of messages written. Only
+	* called by the log thread, or by StopAsync after it has been joined
+	*/
+	static uint64 WriteRingMessages(String& message, bool debuggerOutput)
+	{
+		uint64 writtenCount = 0;
+		for (LogRing* pRing = g_pLogRings.load(std::memory_order_acquire); pRing; pRing = pRing->pNext)
+		{
+			uint64 readPosition			= pRing->ReadPosition.load(std::memory_order_relaxed);
+			const uint64 writePosition	= pRing->WritePosition.load(std::memory_order_acquire);
+			if (readPosition == writePosition)
 			{
-				PlatformMisc::OutputDebugString(buffer.c_str());
+				continue;
 			}
 
-			// Check if last message is the same
-			static ELogSeverity lastSeverity;
-			static uint32 messageCount = 1;
-			if (lastMessage != buffer || lastSeverity != severity)
+			OutputLock lock;
+			while (readPosition != writePosition)
 			{
-				lastMessage = buffer;
-				lastSeverity = severity;
-				messageCount = 1;
+				const LogRecordHeader* pHeader = reinterpret_cast<const LogRecordHeader*>(pRing->Data + (readPosition & (LOG_RING_SIZE - 1)));
+				readPosition += pHeader->SizeInBytes;
+
+				if (pHeader->Type != LOG_RECORD_TYPE_PADDING)
+				{
+					message.clear();
+					FormatRecord(message, *pHeader);
+
+					WriteMessage(pHeader->Severity, message, debuggerOutput, false);
+					writtenCount++;
+				}
 			}
-			else
+
+			pRing->ReadPosition.store(readPosition, std::memory_order_release);
+		}
+
+		// Report the messages that have been dropped since the last pass
+		for (LogRing* pRing = g_pLogRings.load(std::memory_order_acquire); pRing; pRing = pRing->pNext)
+		{
+			const uint64 droppedCount = pRing->DroppedCount.load(std::memory_order_relaxed);
+			if (droppedCount != pRing->ReportedDropCount)
 			{
-				messageCount++;
-				buffer += " (x" + std::to_string(messageCount) + " Times)";
+				message = "[Log]: " + std::to_string(droppedCount - pRing->ReportedDropCount) + " messages were dropped, the log ring of a thread was full";
+				pRing->ReportedDropCount = droppedCount;
 
-				PlatformConsole::ClearLastLine();
+				OutputLock lock;
+				WriteMessage(ELogSeverity::LOG_WARNING, message, debuggerOutput, false);
 			}
+		}
+
+		g_WrittenMessageCount.fetch_add(writtenCount, std::memory_order_relaxed);
+		return writtenCount;
+	}
+
+	void Log::RunLogThread()
+	{
+		g_IsLogThread = true;
+
+		String message;
+		bool running = true;
+		while (running)
+		{
+			// Read the flag before the rings, the messages logged before StopAsync are written by the last pass
+			running = g_LogThreadRunning.load(std::memory_order_acquire);
+
+			const uint64 writtenCount = WriteRingMessages(message, s_DebuggerOutputEnabled);
+
+			if (writtenCount == 0 && running)
+			{
+				{
+					OutputLock lock;
+					SetConsoleColor(EConsoleColor::COLOR_WHITE);
 
-			PlatformConsole::PrintLine(buffer.c_str());
+					if (g_pLogFile)
+					{
+						fflush(g_pLogFile);
+					}
+				}
+
+				std::unique_lock<std::mutex> lock(g_LogThreadMutex);
+				g_LogThreadCondition.wait_for(lock, std::chrono::milliseconds(1));
+			}
 		}
 
-		if (severity != ELogSeverity::LOG_MESSAGE)
+		OutputLock lock;
+		SetConsoleColor(EConsoleColor::COLOR_WHITE);
+	}
+
+	bool Log::StartAsync(const char* pLogFilePath)
+	{
+		if (g_LogThreadRunning.load(std::memory_order_acquire))
 		{
-			PlatformConsole::SetColor(EConsoleColor::COLOR_WHITE);
+			LOG_WARNING("[Log]: The log thread is already running");
+			return false;
 		}
+
+		if (pLogFilePath)
+		{
+			g_pLogFile = fopen(pLogFilePath, "w");
+			if (!g_pLogFile)
+			{
+				LOG_ERROR("[Log]: Failed to open log file '%s'", pLogFilePath);
+				return false;
+			}
+		}
+
+		// Rings of an earlier log thread have been freed, the threads create new ones
+		g_LogThreadID.fetch_add(1, std::memory_order_release);
+		g_LogThreadRunning.store(true, std::memory_order_release);
+		g_LogThread = std::thread(&Log::RunLogThread);
+
+		g_AsyncOutputEnabled.store(true, std::memory_order_release);
+		return true;
 	}
 
-	void Log::PrintTraceError(const char* pFunction, const char* pFileName, uint32 lineNr, const char* pFormat, ...)
+	void Log::StopAsync()
 	{
+		if (!g_LogThreadRunning.load(std::memory_order_acquire))
+		{
+			return;
+		}
+
+		g_AsyncOutputEnabled.store(false, std::memory_order_release);
+		g_LogThreadRunning.store(false, std::memory_order_release);
+		g_LogThreadCondition.notify_one();
+		g_LogThread.join();
+
+		// Messages that were pushed after the last pass of the log thread, before the threads saw async output disabled
+		String message;
+		WriteRingMessages(message, s_DebuggerOutputEnabled);
+
+		// The ring of the calling thread is freed now instead of when the thread exits
+		ThreadLogRing::Retire(g_ThreadLogRing.pRing);
+		g_ThreadLogRing.pRing		= nullptr;
+		g_ThreadLogRing.LogThreadID	= 0;
+
+		{
+			std::scoped_lock<std::mutex> ringListLock(g_LogRingListMutex);
+
+			LogRing* pRing = g_pLogRings.exchange(nullptr, std::memory_order_acq_rel);
+			while (pRing)
+			{
+				LogRing* pNextRing = pRing->pNext;
+
+				// A thread that is still alive deletes the ring when it exits
+				if (pRing->State.exchange(LOG_RING_STATE_ORPHANED, std::memory_order_acq_rel) == LOG_RING_STATE_RETIRED)
+				{
+					delete pRing;
+				}
+
+				pRing = pNextRing;
+			}
+
+			g_LogRingCount.store(0, std::memory_order_relaxed);
+		}
+
+		OutputLock lock;
+		SetConsoleColor(EConsoleColor::COLOR_WHITE);
+
+		if (g_pLogFile)
+		{
+			fclose(g_pLogFile);
+			g_pLogFile = nullptr;
+		}
+	}
+
+	void Log::Flush()
+	{
+		if (g_IsLogThread || !g_LogThreadRunning.load(std::memory_order_acquire))
+		{
+			return;
+		}
+
+		g_LogThreadCondition.notify_one();
+
+		// Gives up after a while, an assert on a thread that holds the output lock would otherwise never return
+		constexpr const std::chrono::seconds MAX_FLUSH_TIME(1);
+		const auto startTime = std::chrono::steady_clock::now();
+
+		// StopAsync may free the rings while this thread waits on them
+		std::scoped_lock<std::mutex> ringListLock(g_LogRingListMutex);
+		for (LogRing* pRing = g_pLogRings.load(std::memory_order_acquire); pRing; pRing = pRing->pNext)
+		{
+			const uint64 writePosition = pRing->WritePosition.load(std::memory_order_acquire);
+			while (pRing->ReadPosition.load(std::memory_order_acquire) < writePosition)
+			{
+				if (std::chrono::steady_clock::now() - startTime > MAX_FLUSH_TIME)
+				{
+					return;
+				}
+
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	void Log::SetAsyncOutputEnabled(bool enable)
+	{
+		if (enable && !g_LogThreadRunning.load(std::memory_order_acquire))
+		{
+			return;
+		}
+
+		// Messages logged while enabled are written before the ones printed synchronously
+		if (!enable)
+		{
+			g_AsyncOutputEnabled.store(false, std::memory_order_release);
+			Flush();
+		}
+		else
+		{
+			g_AsyncOutputEnabled.store(true, std::memory_order_release);
+		}
+	}
+
+	void Log::PrintAssertLine(const char* pFormat, ...)
+	{
+		constexpr uint32 BUFFER_SIZE = 2048;
+		char buffer[BUFFER_SIZE];
+
 		va_list args;
 		va_start(args, pFormat);
+		vsnprintf(buffer, BUFFER_SIZE, pFormat, args);
+		va_end(args);
 
-		PrintTraceErrorV(pFunction, pFileName, lineNr, pFormat, args);
+		// The assert may have fired on this thread while it holds the output lock, locking it again would never return
+		if (g_HoldsOutputLock)
+		{
+			PlatformConsole::PrintLine("%s", buffer);
+			return;
+		}
 
-		va_end(args);
+		OutputLock lock;
+		SetConsoleColor(EConsoleColor::COLOR_RED);
+		PlatformConsole::PrintLine("%s", buffer);
+		SetConsoleColor(EConsoleColor::COLOR_WHITE);
 	}
 
-	void Log::PrintTraceErrorV(const char* pFunction, const char* pFileName, uint32 lineNr, const char* pFormat, va_list vaArgs)
+	LogStats Log::GetAsyncStats()
 	{
-		PlatformConsole::SetColor(EConsoleColor::COLOR_RED);
-		PlatformConsole::Print("CRITICAL ERROR IN '%s': ", pFunction);
-		PlatformConsole::SetColor(EConsoleColor::COLOR_WHITE);
+		LogStats stats = {};
+		stats.WrittenMessageCount	= g_WrittenMessageCount.load(std::memory_order_relaxed);
+		stats.RingCount				= g_LogRingCount.load(std::memory_order_relaxed);
+
+		std::scoped_lock<std::mutex> ringListLock(g_LogRingListMutex);
+		for (LogRing* pRing = g_pLogRings.load(std::memory_order_acquire); pRing; pRing = pRing->pNext)
+		{
+			stats.DroppedMessageCount += pRing->DroppedCount.load(std::memory_order_relaxed);
+		}
 
-		PrintV(pFileName, lineNr, ELogSeverity::LOG_ERROR, pFormat, vaArgs);
+		return stats;
 	}
 }
@@ -0,0 +1,157 @@
+#include "Memory/API/FrameAllocator.h"
+#include "Memory/API/Malloc.h"
+
+#include "Containers/TArray.h"
+
+#include "Math/MathUtilities.h"
+
+#include <atomic>
+
+namespace LambdaEngine
+{
+	/*
+	* FrameArena - The blocks that one thread allocates from during one frame
+	*/
+
+	struct FrameBlock
+	{
+		byte*	pMemory		= nullptr;
+		uint64	SizeInBytes	= 0;
+	};
+
+	struct FrameArena
+	{
+		TArray<FrameBlock>	Blocks;
+		uint32				CurrentBlock	= 0;
+		uint64				Offset			= 0;
+
+		FORCEINLINE void Reset()
+		{
+			CurrentBlock	= 0;
+			Offset			= 0;
+		}
+	};
+
+	/*
+	* ThreadFrameMemory - The two arenas of a thread, frames with even indices use the first arena and frames with odd
+	* indices the second
+	*/
+
+	struct ThreadFrameMemory
+	{
+		FrameArena	Arenas[2];
+		uint64		FrameIndex	= 0;
+		FrameAllocatorStats Stats;
+
+		~ThreadFrameMemory()
+		{
+			Release();
+		}
+
+		void Release()
+		{
+			for (FrameArena& arena : Arenas)
+			{
+				for (FrameBlock& block : arena.Blocks)
+				{
+					Malloc::Free(block.pMemory);
+				}
+
+				arena.Blocks.Clear();
+				arena.Reset();
+			}
+
+			Stats.BlockCount	= 0;
+			Stats.BlockBytes	= 0;
+		}
+	};
+
+	static std::atomic_uint64_t g_FrameIndex = 0;
+	static thread_local ThreadFrameMemory g_ThreadFrameMemory;
+
+	/*
+	* FrameAllocator
+	*/
+
+	void* FrameAllocator::Allocate(uint64 sizeInBytes)
+	{
+		return Allocate(sizeInBytes, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+	}
+
+	void* FrameAllocator::Allocate(uint64 sizeInBytes, uint64 alignment)
+	{
+		VALIDATE((alignment & (alignment - 1)) == 0);
+
+		ThreadFrameMemory& memory = g_ThreadFrameMemory;
+
+		// The first allocation of a frame reuses the arena of the frame before the last one
+		const uint64 frameIndex = g_FrameIndex.load(std::memory_order_relaxed);
+		if (frameIndex != memory.FrameIndex)
+		{
+			memory.Arenas[frameIndex & 1].Reset();
+
+			// The other arena was last used more than one frame ago
+			if (frameIndex - memory.FrameIndex > 1)
+			{
+				memory.Arenas[(frameIndex + 1) & 1].Reset();
+			}
+
+			memory.FrameIndex					= frameIndex;
+			memory.Stats.FrameBytesAllocated	= 0;
+		}
+
+		FrameArena& arena = memory.Arenas[frameIndex & 1];
+		memory.Stats.AllocationCount++;
+
+		while (arena.CurrentBlock < arena.Blocks.GetSize())
+		{
+			const FrameBlock& block = arena.Blocks[arena.CurrentBlock];
+
+			const uint64 blockAddress	= reinterpret_cast<uint64>(block.pMemory);
+			const uint64 offset			= AlignUp(blockAddress + arena.Offset, alignment) - blockAddress;
+			if (offset + sizeInBytes <= block.SizeInBytes)
+			{
+				memory.Stats.FrameBytesAllocated += offset + sizeInBytes - arena.Offset;
+				arena.Offset = offset + sizeInBytes;
+				return block.pMemory + offset;
+			}
+
+			arena.CurrentBlock++;
+			arena.Offset = 0;
+		}
+
+		// Allocations larger than a block get a block of their own, which is kept like any other block
+		FrameBlock& block	= arena.Blocks.PushBack({});
+		block.SizeInBytes	= std::max<uint64>(BLOCK_SIZE, sizeInBytes + alignment);
+		block.pMemory		= Malloc::AllocateType<byte>(block.SizeInBytes);
+
+		memory.Stats.BlockCount++;
+		memory.Stats.BlockBytes += block.SizeInBytes;
+
+		const uint64 blockAddress	= reinterpret_cast<uint64>(block.pMemory);
+		const uint64 offset			= AlignUp(blockAddress, alignment) - blockAddress;
+		memory.Stats.FrameBytesAllocated += offset + sizeInBytes;
+		arena.Offset = offset + sizeInBytes;
+		return block.pMemory + offset;
+	}
+
+	void FrameAllocator::EndFrame()
+	{
+		g_FrameIndex.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void FrameAllocator::ReleaseThreadBlocks()
+	{
+		g_ThreadFrameMemory.Release();
+	}
+
+	FrameAllocatorStats FrameAllocator::GetThreadStats()
+	{
+		return g_ThreadFrameMemory.Stats;
+	}
+
+	uint64 FrameAllocator::GetFrameIndex()
+	{
+		return g_FrameIndex.load(std::memory_order_relaxed);
+	}
+}
@@ -41,17 +41,23 @@ namespace LambdaEngine
 {
 	uint16 Malloc::s_DebugFlags = 0;
 
+	// Per thread so that counting does not make threads contend on every allocation
+	static thread_local uint64 g_ThreadAllocationCount = 0;
+
 	void* Malloc::Allocate(uint64 sizeInBytes)
 	{
 #if MEM_DEBUG_ENABLED
 		return Allocate(sizeInBytes, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
 #else
+		g_ThreadAllocationCount++;
 		return malloc(sizeInBytes);
 #endif
 	}
 
 	void* Malloc::Allocate(uint64 sizeInBytes, uint64 alignment)
 	{
+		g_ThreadAllocationCount++;
+
 #if MEM_DEBUG_ENABLED
 		if (sizeInBytes == 0)
 		{
@@ -105,12 +111,15 @@ namespace LambdaEngine
 #if MEM_DEBUG_ENABLED
 		return AllocateDbg(sizeInBytes, __STDCPP_DEFAULT_NEW_ALIGNMENT__, pFileName, lineNumber);
 #else
+		g_ThreadAllocationCount++;
 		return debug_malloc(sizeInBytes, pFileName, lineNumber);
 #endif
 	}
 
 	void* Malloc::AllocateDbg(uint64 sizeInBytes, uint64 alignment, const char* pFileName, int32 lineNumber)
 	{
+		g_ThreadAllocationCount++;
+
 #if MEM_DEBUG_ENABLED
 		if (sizeInBytes == 0)
 		{
@@ -178,6 +187,11 @@ namespace LambdaEngine
 #endif
 	}
 	
+	uint64 Malloc::GetThreadAllocationCount()
+	{
+		return g_ThreadAllocationCount;
+	}
+
 	void Malloc::SetDebugFlags(uint16 debugFlags)
 	{
 #ifdef LAMBDA_PLATFORM_WINDOWS
@@ -0,0 +1,508 @@
+#include "Memory/API/OffsetAllocator.h"
+
+#include "Math/MathUtilities.h"
+
+#include <bit>
+
+namespace LambdaEngine
+{
+	/*
+	* OffsetAllocator
+	*/
+
+	void OffsetAllocator::Init(uint64 sizeInBytes, uint64 granularity)
+	{
+		VALIDATE(sizeInBytes > 0);
+		VALIDATE(granularity > 0 && (granularity & (granularity - 1)) == 0);
+
+		m_Nodes.Clear();
+		m_UnusedNodes.Clear();
+
+		memset(m_FreeHeads, 0xff, sizeof(m_FreeHeads));
+		ZERO_MEMORY(m_SecondLevelBitmaps, sizeof(m_SecondLevelBitmaps));
+		m_FirstLevelBitmap		= 0;
+
+		m_SizeInBytes			= sizeInBytes;
+		m_FreeBytes				= 0;
+		m_Granularity			= granularity;
+		m_AllocationCount		= 0;
+		m_FreeBlockCount		= 0;
+		m_GranularityClassMask	= 0;
+
+		const uint32 nodeIndex = AcquireNode();
+		Node& node = m_Nodes[nodeIndex];
+		node.Offset			= 0;
+		node.SizeInBytes	= sizeInBytes;
+		InsertFreeNode(nodeIndex);
+	}
+
+	void OffsetAllocator::Reset()
+	{
+		Init(m_SizeInBytes, m_Granularity);
+	}
+
+	bool OffsetAllocator::Allocate(uint64 sizeInBytes, uint64 alignment, OffsetAllocation& allocation, uint32 granularityClass)
+	{
+		VALIDATE(sizeInBytes > 0);
+		VALIDATE(granularityClass < 32);
+
+		allocation = { };
+
+		alignment = alignment > 0 ? alignment : 1;
+		VALIDATE((alignment & (alignment - 1)) == 0);
+
+		// Granularity only matters once the allocator holds more than one class
+		const uint32 classBit = 1u << granularityClass;
+		const bool checkGranularity = m_Granularity > 1 && (m_GranularityClassMask & ~classBit) != 0;
+
+		// Search for a block that fits the worst case padding, every block in the list found is then large enough
+		uint64 searchSize = sizeInBytes + (alignment - 1);
+		if (checkGranularity)
+		{
+			searchSize = sizeInBytes + (glm::max(alignment, m_Granularity) - 1) + (m_Granularity - 1);
+		}
+
+		// The worst case padding is rarely needed, so only the size itself rules out an allocation up front
+		if (sizeInBytes > m_FreeBytes)
+		{
+			return false;
+		}
+
+		uint64 offset = 0;
+		uint32 nodeIndex = FindFreeNode(searchSize);
+		if (nodeIndex == INVALID_NODE || !CalculatePlacement(nodeIndex, sizeInBytes, alignment, granularityClass, checkGranularity, offset))
+		{
+			// The good-fit search rounds up to the next size class, as a last resort the blocks in the list
+			// of the requested size are checked one by one
+			uint32 firstLevel	= 0;
+			uint32 secondLevel	= 0;
+			MapSize(sizeInBytes, firstLevel, secondLevel);
+
+			nodeIndex = m_FreeHeads[firstLevel][secondLevel];
+			while (nodeIndex != INVALID_NODE && !CalculatePlacement(nodeIndex, sizeInBytes, alignment, granularityClass, checkGranularity, offset))
+			{
+				nodeIndex = m_Nodes[nodeIndex].NextFree;
+			}
+
+			if (nodeIndex == INVALID_NODE)
+			{
+				return false;
+			}
+		}
+
+		RemoveFreeNode(nodeIndex);
+
+		// Return the padding in front of the allocation to the free lists
+		if (offset > m_Nodes[nodeIndex].Offset)
+		{
+			const uint32 paddingIndex = AcquireNode();
+			Node& node		= m_Nodes[nodeIndex];
+			Node& padding	= m_Nodes[paddingIndex];
+
+			padding.Offset			= node.Offset;
+			padding.SizeInBytes		= offset - node.Offset;
+			padding.PrevPhysical	= node.PrevPhysical;
+			padding.NextPhysical	= nodeIndex;
+
+			if (node.PrevPhysical != INVALID_NODE)
+			{
+				m_Nodes[node.PrevPhysical].NextPhysical = paddingIndex;
+			}
+
+			node.PrevPhysical	= paddingIndex;
+			node.Offset			= offset;
+			node.SizeInBytes	-= padding.SizeInBytes;
+
+			InsertFreeNode(paddingIndex);
+		}
+
+		// Return the remainder after the allocation to the free lists
+		if (m_Nodes[nodeIndex].SizeInBytes > sizeInBytes)
+		{
+			const uint32 remainderIndex = AcquireNode();
+			Node& node		= m_Nodes[nodeIndex];
+			Node& remainder	= m_Nodes[remainderIndex];
+
+			remainder.Offset		= node.Offset + sizeInBytes;
+			remainder.SizeInBytes	= node.SizeInBytes - sizeInBytes;
+			remainder.PrevPhysical	= nodeIndex;
+			remainder.NextPhysical	= node.NextPhysical;
+
+			if (node.NextPhysical != INVALID_NODE)
+			{
+				m_Nodes[node.NextPhysical].PrevPhysical = remainderIndex;
+			}
+
+			node.NextPhysical	= remainderIndex;
+			node.SizeInBytes	= sizeInBytes;
+
+			InsertFreeNode(remainderIndex);
+		}
+
+		Node& node = m_Nodes[nodeIndex];
+		node.GranularityClass = granularityClass;
+
+		m_GranularityClassMask |= classBit;
+		m_AllocationCount++;
+
+		allocation.Offset		= node.Offset;
+		allocation.SizeInBytes	= node.SizeInBytes;
+		allocation.NodeIndex	= nodeIndex;
+		return true;
+	}
+
+	void OffsetAllocator::Free(OffsetAllocation& allocation)
+	{
+		VALIDATE(allocation.IsValid());
+		VALIDATE(allocation.NodeIndex < m_Nodes.GetSize());
+
+		uint32 nodeIndex = allocation.NodeIndex;
+		VALIDATE(!m_Nodes[nodeIndex].IsFree && m_Nodes[nodeIndex].Offset == allocation.Offset);
+
+		// Merge with the previous block
+		const uint32 prevIndex = m_Nodes[nodeIndex].PrevPhysical;
+		if (prevIndex != INVALID_NODE && m_Nodes[prevIndex].IsFree)
+		{
+			RemoveFreeNode(prevIndex);
+
+			Node& node = m_Nodes[nodeIndex];
+			Node& prev = m_Nodes[prevIndex];
+			prev.SizeInBytes	+= node.SizeInBytes;
+			prev.NextPhysical	= node.NextPhysical;
+
+			if (node.NextPhysical != INVALID_NODE)
+			{
+				m_Nodes[node.NextPhysical].PrevPhysical = prevIndex;
+			}
+
+			ReleaseNode(nodeIndex);
+			nodeIndex = prevIndex;
+		}
+
+		// Merge with the next block
+		const uint32 nextIndex = m_Nodes[nodeIndex].NextPhysical;
+		if (nextIndex != INVALID_NODE && m_Nodes[nextIndex].IsFree)
+		{
+			RemoveFreeNode(nextIndex);
+
+			Node& node = m_Nodes[nodeIndex];
+			Node& next = m_Nodes[nextIndex];
+			node.SizeInBytes	+= next.SizeInBytes;
+			node.NextPhysical	= next.NextPhysical;
+
+			if (next.NextPhysical != INVALID_NODE)
+			{
+				m_Nodes[next.NextPhysical].PrevPhysical = nodeIndex;
+			}
+
+			ReleaseNode(nextIndex);
+		}
+
+		InsertFreeNode(nodeIndex);
+
+		m_AllocationCount--;
+		if (m_AllocationCount == 0)
+		{
+			m_GranularityClassMask = 0;
+		}
+
+		allocation = { };
+	}
+
+	OffsetAllocatorStatistics OffsetAllocator::GetStatistics() const
+	{
+		OffsetAllocatorStatistics statistics = { };
+		statistics.SizeInBytes		= m_SizeInBytes;
+		statistics.UsedBytes		= m_SizeInBytes - m_FreeBytes;
+		statistics.FreeBytes		= m_FreeBytes;
+		statistics.AllocationCount	= m_AllocationCount;
+		statistics.FreeBlockCount	= m_FreeBlockCount;
+
+		// The largest block is in the highest non-empty list
+		if (m_FirstLevelBitmap != 0)
+		{
+			const uint32 firstLevel		= 63 - uint32(std::countl_zero(m_FirstLevelBitmap));
+			const uint32 secondLevel	= 31 - uint32(std::countl_zero(m_SecondLevelBitmaps[firstLevel]));
+			for (uint32 nodeIndex = m_FreeHeads[firstLevel][secondLevel]; nodeIndex != INVALID_NODE; nodeIndex = m_Nodes[nodeIndex].NextFree)
+			{
+				statistics.LargestFreeBlock = glm::max(statistics.LargestFreeBlock, m_Nodes[nodeIndex].SizeInBytes);
+			}
+		}
+
+		if (m_FreeBytes > 0)
+		{
+			statistics.Fragmentation = 1.0f - float32(float64(statistics.LargestFreeBlock) / float64(m_FreeBytes));
+		}
+
+		return statistics;
+	}
+
+	bool OffsetAllocator::Validate() const
+	{
+		// Find the first block
+		uint32 firstIndex		= INVALID_NODE;
+		uint32 liveNodeCount	= 0;
+		for (uint32 n = 0; n < m_Nodes.GetSize(); n++)
+		{
+			if (m_Nodes[n].SizeInBytes > 0)
+			{
+				liveNodeCount++;
+				if (m_Nodes[n].PrevPhysical == INVALID_NODE)
+				{
+					if (firstIndex != INVALID_NODE)
+					{
+						return false;
+					}
+
+					firstIndex = n;
+				}
+			}
+		}
+
+		// Walk the blocks in order
+		uint64 offset			= 0;
+		uint64 freeBytes		= 0;
+		uint32 freeBlockCount	= 0;
+		uint32 allocationCount	= 0;
+		uint32 walkedNodeCount	= 0;
+		uint32 prevIndex		= INVALID_NODE;
+		for (uint32 nodeIndex = firstIndex; nodeIndex != INVALID_NODE; nodeIndex = m_Nodes[nodeIndex].NextPhysical)
+		{
+			const Node& node = m_Nodes[nodeIndex];
+			if (node.Offset != offset || node.PrevPhysical != prevIndex || node.SizeInBytes == 0)
+			{
+				return false;
+			}
+
+			if (node.IsFree)
+			{
+				// Free neighbours are always merged
+				if (prevIndex != INVALID_NODE && m_Nodes[prevIndex].IsFree)
+				{
+					return false;
+				}
+
+				uint32 firstLevel	= 0;
+				uint32 secondLevel	= 0;
+				MapSize(node.SizeInBytes, firstLevel, secondLevel);
+
+				bool foundInList = false;
+				for (uint32 freeIndex = m_FreeHeads[firstLevel][secondLevel]; freeIndex != INVALID_NODE && !foundInList; freeIndex = m_Nodes[freeIndex].NextFree)
+				{
+					foundInList = freeIndex == nodeIndex;
+				}
+
+				if (!foundInList)
+				{
+					return false;
+				}
+
+				freeBytes += node.SizeInBytes;
+				freeBlockCount++;
+			}
+			else
+			{
+				allocationCount++;
+			}
+
+			offset += node.SizeInBytes;
+			prevIndex = nodeIndex;
+			walkedNodeCount++;
+		}
+
+		return
+			offset			== m_SizeInBytes &&
+			freeBytes		== m_FreeBytes &&
+			freeBlockCount	== m_FreeBlockCount &&
+			allocationCount	== m_AllocationCount &&
+			walkedNodeCount	== liveNodeCount;
+	}
+
+	void OffsetAllocator::MapSize(uint64 sizeInBytes, uint32& firstLevel, uint32& secondLevel)
+	{
+		// Sizes below SECOND_LEVEL_COUNT are stored linearly in the first list
+		if (sizeInBytes < SECOND_LEVEL_COUNT)
+		{
+			firstLevel	= 0;
+			secondLevel	= uint32(sizeInBytes);
+		}
+		else
+		{
+			const uint32 mostSignificantBit = 63 - uint32(std::countl_zero(sizeInBytes));
+			firstLevel	= mostSignificantBit - SECOND_LEVEL_BITS + 1;
+			secondLevel	= uint32(sizeInBytes >> (mostSignificantBit - SECOND_LEVEL_BITS)) - SECOND_LEVEL_COUNT;
+		}
+	}
+
+	bool OffsetAllocator::MapSizeRoundUp(uint64 sizeInBytes, uint32& firstLevel, uint32& secondLevel)
+	{
+		if (sizeInBytes >= SECOND_LEVEL_COUNT)
+		{
+			const uint32 mostSignificantBit = 63 - uint32(std::countl_zero(sizeInBytes));
+			const uint64 roundUp = (1ull << (mostSignificantBit - SECOND_LEVEL_BITS)) - 1;
+			if (sizeInBytes > UINT64_MAX - roundUp)
+			{
+				return false;
+			}
+
+			sizeInBytes += roundUp;
+		}
+
+		MapSize(sizeInBytes, firstLevel, secondLevel);
+		return true;
+	}
+
+	uint32 OffsetAllocator::FindFreeNode(uint64 sizeInBytes) const
+	{
+		uint32 firstLevel	= 0;
+		uint32 secondLevel	= 0;
+		if (!MapSizeRoundUp(sizeInBytes, firstLevel, secondLevel))
+		{
+			return INVALID_NODE;
+		}
+
+		uint32 secondLevelBitmap = m_SecondLevelBitmaps[firstLevel] & (~0u << secondLevel);
+		if (secondLevelBitmap == 0)
+		{
+			if (firstLevel + 1 >= FIRST_LEVEL_COUNT)
+			{
+				return INVALID_NODE;
+			}
+
+			const uint64 firstLevelBitmap = m_FirstLevelBitmap & (~0ull << (firstLevel + 1));
+			if (firstLevelBitmap == 0)
+			{
+				return INVALID_NODE;
+			}
+
+			firstLevel			= uint32(std::countr_zero(firstLevelBitmap));
+			secondLevelBitmap	= m_SecondLevelBitmaps[firstLevel];
+		}
+
+		secondLevel = uint32(std::countr_zero(secondLevelBitmap));
+		return m_FreeHeads[firstLevel][secondLevel];
+	}
+
+	bool OffsetAllocator::CalculatePlacement(uint32 nodeIndex, uint64 sizeInBytes, uint64 alignment, uint32 granularityClass, bool checkGranularity, uint64& offset) const
+	{
+		const Node& node = m_Nodes[nodeIndex];
+
+		offset = AlignUp(node.Offset, alignment);
+		uint64 endOffset = node.Offset + node.SizeInBytes;
+
+		if (checkGranularity)
+		{
+			if (node.PrevPhysical != INVALID_NODE)
+			{
+				const Node& prev = m_Nodes[node.PrevPhysical];
+				if (!prev.IsFree && prev.GranularityClass != granularityClass && SharesGranularityPage(prev.Offset + prev.SizeInBytes, offset))
+				{
+					offset = AlignUp(offset, m_Granularity);
+				}
+			}
+
+			if (node.NextPhysical != INVALID_NODE)
+			{
+				const Node& next = m_Nodes[node.NextPhysical];
+				if (!next.IsFree && next.GranularityClass != granularityClass)
+				{
+					endOffset = AlignDown(endOffset, m_Granularity);
+				}
+			}
+		}
+
+		return offset + sizeInBytes <= endOffset;
+	}
+
+	void OffsetAllocator::InsertFreeNode(uint32 nodeIndex)
+	{
+		Node& node = m_Nodes[nodeIndex];
+
+		uint32 firstLevel	= 0;
+		uint32 secondLevel	= 0;
+		MapSize(node.SizeInBytes, firstLevel, secondLevel);
+
+		uint32& head = m_FreeHeads[firstLevel][secondLevel];
+		node.IsFree		= true;
+		node.PrevFree	= INVALID_NODE;
+		node.NextFree	= head;
+
+		if (head != INVALID_NODE)
+		{
+			m_Nodes[head].PrevFree = nodeIndex;
+		}
+
+		head = nodeIndex;
+		m_SecondLevelBitmaps[firstLevel]	|= (1u << secondLevel);
+		m_FirstLevelBitmap					|= (1ull << firstLevel);
+
+		m_FreeBytes += node.SizeInBytes;
+		m_FreeBlockCount++;
+	}
+
+	void OffsetAllocator::RemoveFreeNode(uint32 nodeIndex)
+	{
+		Node& node = m_Nodes[nodeIndex];
+		VALIDATE(node.IsFree);
+
+		uint32 firstLevel	= 0;
+		uint32 secondLevel	= 0;
+		MapSize(node.SizeInBytes, firstLevel, secondLevel);
+
+		if (node.PrevFree != INVALID_NODE)
+		{
+			m_Nodes[node.PrevFree].NextFree = node.NextFree;
+		}
+
+		if (node.NextFree != INVALID_NODE)
+		{
+			m_Nodes[node.NextFree].PrevFree = node.PrevFree;
+		}
+
+		uint32& head = m_FreeHeads[firstLevel][secondLevel];
+		if (head == nodeIndex)
+		{
+			head = node.NextFree;
+			if (head == INVALID_NODE)
+			{
+				m_SecondLevelBitmaps[firstLevel] &= ~(1u << secondLevel);
+				if (m_SecondLevelBitmaps[firstLevel] == 0)
+				{
+					m_FirstLevelBitmap &= ~(1ull << firstLevel);
+				}
+			}
+		}
+
+		node.IsFree		= false;
+		node.PrevFree	= INVALID_NODE;
+		node.NextFree	= INVALID_NODE;
+
+		m_FreeBytes -= node.SizeInBytes;
+		m_FreeBlockCount--;
+	}
+
+	uint32 OffsetAllocator::AcquireNode()
+	{
+		if (!m_UnusedNodes.IsEmpty())
+		{
+			const uint32 nodeIndex = m_UnusedNodes.GetBack();
+			m_UnusedNodes.PopBack();
+			return nodeIndex;
+		}
+
+		m_Nodes.EmplaceBack();
+		return m_Nodes.GetSize() - 1;
+	}
+
+	void OffsetAllocator::ReleaseNode(uint32 nodeIndex)
+	{
+		m_Nodes[nodeIndex] = { };
+		m_UnusedNodes.PushBack(nodeIndex);
+	}
+
+	bool OffsetAllocator::SharesGranularityPage(uint64 endOffset, uint64 startOffset) const
+	{
+		VALIDATE(endOffset > 0);
+		return AlignDown(endOffset - 1, m_Granularity) == AlignDown(startOffset, m_Granularity);
+	}
+}
@@ -0,0 +1,130 @@
+#include "Memory/API/RingAllocator.h"
+
+#include "Math/MathUtilities.h"
+
+namespace LambdaEngine
+{
+	/*
+	* RingAllocator
+	*/
+
+	void RingAllocator::Init(uint64 sizeInBytes)
+	{
+		VALIDATE(sizeInBytes > 0);
+
+		m_Frames.Clear();
+		m_FirstFrame		= 0;
+		m_SizeInBytes		= sizeInBytes;
+		m_Head				= 0;
+		m_Tail				= 0;
+		m_UsedBytes			= 0;
+		m_FrameUsedBytes	= 0;
+	}
+
+	void RingAllocator::Reset()
+	{
+		Init(m_SizeInBytes);
+	}
+
+	bool RingAllocator::Allocate(uint64 sizeInBytes, uint64 alignment, uint64& offset)
+	{
+		VALIDATE(sizeInBytes > 0);
+
+		alignment = alignment > 0 ? alignment : 1;
+		VALIDATE((alignment & (alignment - 1)) == 0);
+
+		if (sizeInBytes > m_SizeInBytes || m_UsedBytes == m_SizeInBytes)
+		{
+			return false;
+		}
+
+		// Start over from the beginning when nothing is alive, this keeps large allocations from failing on a wrap
+		if (m_UsedBytes == 0)
+		{
+			m_Head = 0;
+			m_Tail = 0;
+		}
+
+		const uint64 alignedHead = AlignUp(m_Head, alignment);
+		uint64 usedBytes = 0;
+		if (m_Head >= m_Tail)
+		{
+			// Free space is [Head, Size) followed by [0, Tail)
+			if (alignedHead + sizeInBytes <= m_SizeInBytes)
+			{
+				offset		= alignedHead;
+				usedBytes	= (alignedHead - m_Head) + sizeInBytes;
+			}
+			else if (sizeInBytes <= m_Tail)
+			{
+				// The space at the end is skipped and reclaimed with the frame
+				offset		= 0;
+				usedBytes	= (m_SizeInBytes - m_Head) + sizeInBytes;
+			}
+			else
+			{
+				return false;
+			}
+		}
+		else
+		{
+			// Free space is [Head, Tail)
+			if (alignedHead + sizeInBytes <= m_Tail)
+			{
+				offset		= alignedHead;
+				usedBytes	= (alignedHead - m_Head) + sizeInBytes;
+			}
+			else
+			{
+				return false;
+			}
+		}
+
+		m_Head				= offset + sizeInBytes;
+		m_UsedBytes			+= usedBytes;
+		m_FrameUsedBytes	+= usedBytes;
+
+		VALIDATE(m_UsedBytes <= m_SizeInBytes);
+		return true;
+	}
+
+	void RingAllocator::EndFrame(uint64 fenceValue)
+	{
+		VALIDATE(GetInFlightFrameCount() == 0 || m_Frames.GetBack().FenceValue < fenceValue);
+
+		if (m_FrameUsedBytes > 0)
+		{
+			FrameMarker marker = { };
+			marker.FenceValue	= fenceValue;
+			marker.EndOffset	= m_Head;
+			marker.UsedBytes	= m_FrameUsedBytes;
+			m_Frames.PushBack(marker);
+
+			m_FrameUsedBytes = 0;
+		}
+	}
+
+	void RingAllocator::Reclaim(uint64 completedFenceValue)
+	{
+		while (m_FirstFrame < m_Frames.GetSize() && m_Frames[m_FirstFrame].FenceValue <= completedFenceValue)
+		{
+			const FrameMarker& marker = m_Frames[m_FirstFrame];
+			m_Tail		= marker.EndOffset;
+			m_UsedBytes	-= marker.UsedBytes;
+			m_FirstFrame++;
+		}
+
+		// Compact the markers once at least half of them are reclaimed, keeps the cost amortized constant
+		const uint32 inFlightFrameCount = GetInFlightFrameCount();
+		if (m_FirstFrame > 0 && m_FirstFrame >= inFlightFrameCount)
+		{
+			for (uint32 f = 0; f < inFlightFrameCount; f++)
+			{
+				m_Frames[f] = m_Frames[m_FirstFrame + f];
+			}
+
+			m_Frames.Resize(inFlightFrameCount);
+			m_FirstFrame = 0;
+		}
+	}
+}
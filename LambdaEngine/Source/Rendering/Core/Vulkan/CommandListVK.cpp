@@ -750,40 +750,7 @@ namespace LambdaEngine
 		VALIDATE(pTextureBarriers		!= nullptr);
 		VALIDATE(textureBarrierCount	<= MAX_IMAGE_BARRIERS);
 
-		TextureVK*		pVkTexture	= nullptr;
-		VkImageLayout	oldLayout	= VK_IMAGE_LAYOUT_UNDEFINED;
-		VkImageLayout	newLayout	= VK_IMAGE_LAYOUT_UNDEFINED;
-		for (uint32 i = 0; i < textureBarrierCount; i++)
-		{
-			const PipelineTextureBarrierDesc& barrier = pTextureBarriers[i];
-
-			pVkTexture	= reinterpret_cast<TextureVK*>(barrier.pTexture);
-			oldLayout	= ConvertTextureState(barrier.StateBefore);
-			newLayout	= ConvertTextureState(barrier.StateAfter);
-
-			m_ImageBarriers[i].sType							= VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-			m_ImageBarriers[i].pNext							= nullptr;
-			m_ImageBarriers[i].image							= pVkTexture->GetImage();
-			m_ImageBarriers[i].srcQueueFamilyIndex				= m_pDevice->GetQueueFamilyIndexFromQueueType(barrier.QueueBefore);
-			m_ImageBarriers[i].dstQueueFamilyIndex				= m_pDevice->GetQueueFamilyIndexFromQueueType(barrier.QueueAfter);
-			m_ImageBarriers[i].oldLayout						= oldLayout;
-			m_ImageBarriers[i].newLayout						= newLayout;
-			m_ImageBarriers[i].subresourceRange.baseMipLevel	= barrier.Miplevel;
-			m_ImageBarriers[i].subresourceRange.levelCount		= barrier.MiplevelCount;
-			m_ImageBarriers[i].subresourceRange.baseArrayLayer	= barrier.ArrayIndex;
-			m_ImageBarriers[i].subresourceRange.layerCount		= barrier.ArrayCount;
-			m_ImageBarriers[i].srcAccessMask					= ConvertMemoryAccessFlags(barrier.SrcMemoryAccessFlags);
-			m_ImageBarriers[i].dstAccessMask					= ConvertMemoryAccessFlags(barrier.DstMemoryAccessFlags);
-
-			if ((barrier.TextureFlags & FTextureFlag::TEXTURE_FLAG_DEPTH_STENCIL) > 0)
-			{
-				m_ImageBarriers[i].subresourceRange.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
-			}
-			else
-			{
-				m_ImageBarriers[i].subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-			}
-		}
+		ConvertTextureBarriers(pTextureBarriers, textureBarrierCount);
 
 		VkPipelineStageFlags sourceStage		= ConvertPipelineStageMask(srcStage);
 		VkPipelineStageFlags destinationStage	= ConvertPipelineStageMask(dstStage);
@@ -795,22 +762,7 @@ namespace LambdaEngine
 		VALIDATE(pBufferBarriers		!= nullptr);
 		VALIDATE(bufferBarrierCount	<= MAX_BUFFER_BARRIERS);
 
-		BufferVK* pVkBuffer = nullptr;
-		for (uint32 i = 0; i < bufferBarrierCount; i++)
-		{
-			const PipelineBufferBarrierDesc& barrier = pBufferBarriers[i];
-			pVkBuffer = reinterpret_cast<BufferVK*>(barrier.pBuffer);
-
-			m_BufferBarriers[i].sType				= VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
-			m_BufferBarriers[i].pNext				= nullptr;
-			m_BufferBarriers[i].buffer				= pVkBuffer->GetBuffer();
-			m_BufferBarriers[i].srcQueueFamilyIndex = m_pDevice->GetQueueFamilyIndexFromQueueType(barrier.QueueBefore);
-			m_BufferBarriers[i].dstQueueFamilyIndex = m_pDevice->GetQueueFamilyIndexFromQueueType(barrier.QueueAfter);
-			m_BufferBarriers[i].srcAccessMask		= ConvertMemoryAccessFlags(barrier.SrcMemoryAccessFlags);
-			m_BufferBarriers[i].dstAccessMask		= ConvertMemoryAccessFlags(barrier.DstMemoryAccessFlags);
-			m_BufferBarriers[i].offset				= barrier.Offset;
-			m_BufferBarriers[i].size				= barrier.SizeInBytes;
-		}
+		ConvertBufferBarriers(pBufferBarriers, bufferBarrierCount);
 
 		VkPipelineStageFlags sourceStage		= ConvertPipelineStageMask(srcStage);
 		VkPipelineStageFlags destinationStage	= ConvertPipelineStageMask(dstStage);
@@ -837,6 +789,39 @@ namespace LambdaEngine
 		vkCmdPipelineBarrier(m_CmdBuffer, sourceStage, destinationStage, 0, bufferMemoryCount, m_MemoryBarriers, 0, nullptr, 0, nullptr);
 	}
 
+	void CommandListVK::PipelineBarriers(
+		FPipelineStageFlags srcStage,
+		FPipelineStageFlags dstStage,
+		const PipelineTextureBarrierDesc* pTextureBarriers,
+		uint32 textureBarrierCount,
+		const PipelineBufferBarrierDesc* pBufferBarriers,
+		uint32 bufferBarrierCount)
+	{
+		VALIDATE(textureBarrierCount	<= MAX_IMAGE_BARRIERS);
+		VALIDATE(bufferBarrierCount		<= MAX_BUFFER_BARRIERS);
+
+		if (textureBarrierCount == 0 && bufferBarrierCount == 0)
+		{
+			return;
+		}
+
+		if (textureBarrierCount > 0)
+		{
+			VALIDATE(pTextureBarriers != nullptr);
+			ConvertTextureBarriers(pTextureBarriers, textureBarrierCount);
+		}
+
+		if (bufferBarrierCount > 0)
+		{
+			VALIDATE(pBufferBarriers != nullptr);
+			ConvertBufferBarriers(pBufferBarriers, bufferBarrierCount);
+		}
+
+		VkPipelineStageFlags sourceStage		= ConvertPipelineStageMask(srcStage);
+		VkPipelineStageFlags destinationStage	= ConvertPipelineStageMask(dstStage);
+		vkCmdPipelineBarrier(m_CmdBuffer, sourceStage, destinationStage, 0, 0, nullptr, bufferBarrierCount, m_BufferBarriers, textureBarrierCount, m_ImageBarriers);
+	}
+
 	void CommandListVK::GenerateMips(Texture* pTexture, ETextureState stateBefore, ETextureState stateAfter, bool linearFiltering)
 	{
 		VALIDATE(pTexture != nullptr);
@@ -1242,4 +1227,62 @@ namespace LambdaEngine
 		VkDescriptorSet descriptorSet = pVkDescriptorSet->GetDescriptorSet();
 		vkCmdBindDescriptorSets(m_CmdBuffer, bindPoint, pVkPipelineLayout->GetPipelineLayout(), setIndex, 1, &descriptorSet, 0, nullptr);
 	}
+
+	void CommandListVK::ConvertTextureBarriers(const PipelineTextureBarrierDesc* pTextureBarriers, uint32 textureBarrierCount)
+	{
+		TextureVK*		pVkTexture	= nullptr;
+		VkImageLayout	oldLayout	= VK_IMAGE_LAYOUT_UNDEFINED;
+		VkImageLayout	newLayout	= VK_IMAGE_LAYOUT_UNDEFINED;
+		for (uint32 i = 0; i < textureBarrierCount; i++)
+		{
+			const PipelineTextureBarrierDesc& barrier = pTextureBarriers[i];
+
+			pVkTexture	= reinterpret_cast<TextureVK*>(barrier.pTexture);
+			oldLayout	= ConvertTextureState(barrier.StateBefore);
+			newLayout	= ConvertTextureState(barrier.StateAfter);
+
+			m_ImageBarriers[i].sType							= VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+			m_ImageBarriers[i].pNext							= nullptr;
+			m_ImageBarriers[i].image							= pVkTexture->GetImage();
+			m_ImageBarriers[i].srcQueueFamilyIndex				= m_pDevice->GetQueueFamilyIndexFromQueueType(barrier.QueueBefore);
+			m_ImageBarriers[i].dstQueueFamilyIndex				= m_pDevice->GetQueueFamilyIndexFromQueueType(barrier.QueueAfter);
+			m_ImageBarriers[i].oldLayout						= oldLayout;
+			m_ImageBarriers[i].newLayout						= newLayout;
+			m_ImageBarriers[i].subresourceRange.baseMipLevel	= barrier.Miplevel;
+			m_ImageBarriers[i].subresourceRange.levelCount		= barrier.MiplevelCount;
+			m_ImageBarriers[i].subresourceRange.baseArrayLayer	= barrier.ArrayIndex;
+			m_ImageBarriers[i].subresourceRange.layerCount		= barrier.ArrayCount;
+			m_ImageBarriers[i].srcAccessMask					= ConvertMemoryAccessFlags(barrier.SrcMemoryAccessFlags);
+			m_ImageBarriers[i].dstAccessMask					= ConvertMemoryAccessFlags(barrier.DstMemoryAccessFlags);
+
+			if ((barrier.TextureFlags & FTextureFlag::TEXTURE_FLAG_DEPTH_STENCIL) > 0)
+			{
+				m_ImageBarriers[i].subresourceRange.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+			}
+			else
+			{
+				m_ImageBarriers[i].subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+			}
+		}
+	}
+
+	void CommandListVK::ConvertBufferBarriers(const PipelineBufferBarrierDesc* pBufferBarriers, uint32 bufferBarrierCount)
+	{
+		BufferVK* pVkBuffer = nullptr;
+		for (uint32 i = 0; i < bufferBarrierCount; i++)
+		{
+			const PipelineBufferBarrierDesc& barrier = pBufferBarriers[i];
+			pVkBuffer = reinterpret_cast<BufferVK*>(barrier.pBuffer);
+
+			m_BufferBarriers[i].sType				= VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+			m_BufferBarriers[i].pNext				= nullptr;
+			m_BufferBarriers[i].buffer				= pVkBuffer->GetBuffer();
+			m_BufferBarriers[i].srcQueueFamilyIndex = m_pDevice->GetQueueFamilyIndexFromQueueType(barrier.QueueBefore);
+			m_BufferBarriers[i].dstQueueFamilyIndex = m_pDevice->GetQueueFamilyIndexFromQueueType(barrier.QueueAfter);
+			m_BufferBarriers[i].srcAccessMask		= ConvertMemoryAccessFlags(barrier.SrcMemoryAccessFlags);
+			m_BufferBarriers[i].dstAccessMask		= ConvertMemoryAccessFlags(barrier.DstMemoryAccessFlags);
+			m_BufferBarriers[i].offset				= barrier.Offset;
+			m_BufferBarriers[i].size				= barrier.SizeInBytes;
+		}
+	}
 }
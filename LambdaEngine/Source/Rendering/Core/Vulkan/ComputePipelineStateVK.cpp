@@ -78,7 +78,7 @@ namespace LambdaEngine
 		pipelineInfo.basePipelineIndex		= -1;
 		pipelineInfo.stage					= shaderCreateInfo;
 
-		VkResult result = vkCreateComputePipelines(m_pDevice->Device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &m_Pipeline);
+		VkResult result = vkCreateComputePipelines(m_pDevice->Device, m_pDevice->PipelineCache, 1, &pipelineInfo, nullptr, &m_Pipeline);
 		if (result != VK_SUCCESS)
 		{
 			if (!pDesc->DebugName.empty())
@@ -11,28 +11,6 @@
 
 namespace LambdaEngine
 {
-	/*
-	 * DeviceMemoryBlockVK
-	 */
-	struct DeviceMemoryBlockVK
-	{
-		DeviceMemoryPageVK* pPage = nullptr;
-
-		// Linked list of blocks
-		DeviceMemoryBlockVK* pNext = nullptr;
-		DeviceMemoryBlockVK* pPrevious = nullptr;
-
-		// Size of the allocation
-		uint64 SizeInBytes = 0;
-
-		// Totoal size of the block (TotalSizeInBytes - SizeInBytes = AlignmentOffset)
-		uint64 TotalSizeInBytes = 0;
-
-		// Offset of the DeviceMemory
-		uint64	Offset = 0;
-		bool	IsFree = true;
-	};
-
 	/*
 	 * DeviceMemoryPageVK
 	 */
@@ -51,33 +29,18 @@ namespace LambdaEngine
 
 		~DeviceMemoryPageVK()
 		{
-			VALIDATE(ValidateBlock(m_pHead));
-			VALIDATE(ValidateNoOverlap());
+			VALIDATE_OFFSET_ALLOCATOR(m_Allocator);
 
 #ifdef LAMBDA_DEVELOPMENT
-			if (m_pHead->pNext != nullptr)
+			if (!m_Allocator.IsEmpty())
 			{
-				LOG_WARNING("Memoryleak detected, m_pHead->pNext is not nullptr");
-			}
-
-			if (m_pHead->pPrevious != nullptr)
-			{
-				LOG_WARNING("Memoryleak detected, m_pHead->pPrevious is not nullptr");
+				LOG_WARNING("Memoryleak detected, page still has %u allocations", m_Allocator.GetStatistics().AllocationCount);
 			}
 #endif
-			DeviceMemoryBlockVK* pIterator = m_pHead;
-			while (pIterator != nullptr)
-			{
-				DeviceMemoryBlockVK* pBlock = pIterator;
-				pIterator = pBlock->pNext;
-
-				SAFEDELETE(pBlock);
-			}
 
 			if (m_MappingCount > 0)
 			{
 				vkUnmapMemory(m_pDevice->Device, m_DeviceMemory);
-				m_DeviceMemory = VK_NULL_HANDLE;
 
 				m_pHostMemory = nullptr;
 				m_MappingCount = 0;
@@ -87,7 +50,7 @@ namespace LambdaEngine
 			m_DeviceMemory = VK_NULL_HANDLE;
 		}
 
-		bool Init(uint64 sizeInBytes)
+		bool Init(uint64 sizeInBytes, VkDeviceSize pageGranularity)
 		{
 			std::scoped_lock<SpinLock> lock(m_Lock);
 
@@ -99,186 +62,51 @@ namespace LambdaEngine
 			}
 			else
 			{
-				m_pHead = DBG_NEW DeviceMemoryBlockVK();
-				m_pHead->pPage = this;
-				m_pHead->TotalSizeInBytes = sizeInBytes;
-				m_pHead->SizeInBytes = sizeInBytes;
-
-				m_SizeInBytes = sizeInBytes;
-
-#ifdef LAMBDA_DEBUG
-				AllBlocks.EmplaceBack(m_pHead);
-#endif
+				m_Allocator.Init(sizeInBytes, glm::max<VkDeviceSize>(pageGranularity, 1));
 				return true;
 			}
 		}
 
-		bool Allocate(AllocationVK* pAllocation, VkDeviceSize sizeInBytes, VkDeviceSize alignment, VkDeviceSize pageGranularity)
+		bool Allocate(AllocationVK* pAllocation, VkDeviceSize sizeInBytes, VkDeviceSize alignment, bool optimalTiling)
 		{
 			std::scoped_lock<SpinLock> lock(m_Lock);
 
 			VALIDATE(pAllocation != nullptr);
 
-			uint64 paddedOffset = 0;
-			uint64 padding = 0;
-
-			// Find a suitable block
-			DeviceMemoryBlockVK* pBestFit = nullptr;
-			VALIDATE(ValidateBlock(m_pHead));
-
-			for (DeviceMemoryBlockVK* pIterator = m_pHead; pIterator != nullptr; pIterator = pIterator->pNext)
-			{
-				if (!pIterator->IsFree)
-				{
-					continue;
-				}
-
-				if (pIterator->SizeInBytes < sizeInBytes)
-				{
-					continue;
-				}
-
-				paddedOffset = AlignUp(pIterator->Offset, alignment);
-				if (pageGranularity > 1)
-				{
-					DeviceMemoryBlockVK* pNext = pIterator->pNext;
-					DeviceMemoryBlockVK* pPrevious = pIterator->pPrevious;
-
-					if (pPrevious)
-					{
-						if (IsAliasing(pPrevious->Offset, pPrevious->TotalSizeInBytes, paddedOffset, pageGranularity))
-						{
-							paddedOffset = AlignUp(paddedOffset, pageGranularity);
-						}
-					}
-
-					if (pNext)
-					{
-						if (IsAliasing(paddedOffset, sizeInBytes, pNext->Offset, pageGranularity))
-						{
-							continue;
-						}
-					}
-				}
-
-				padding = paddedOffset - pIterator->Offset;
-				if (pIterator->SizeInBytes >= (sizeInBytes + padding))
-				{
-					pBestFit = pIterator;
-					break;
-				}
-			}
-
-			if (pBestFit == nullptr)
+			// Linear and optimal resources use different granularity classes so they never share a bufferImageGranularity page
+			const uint32 granularityClass = optimalTiling ? 1 : 0;
+			if (!m_Allocator.Allocate(sizeInBytes, alignment, pAllocation->SubAllocation, granularityClass))
 			{
-				pAllocation->pBlock = nullptr;
+				pAllocation->pPage = nullptr;
 				pAllocation->pAllocator = nullptr;
 				pAllocation->Offset = 0;
 				pAllocation->Memory = 0;
 				return false;
 			}
 
-			// Divide block
-			const uint64 paddedSizeInBytes = (padding + sizeInBytes);
-			if (pBestFit->SizeInBytes > paddedSizeInBytes)
-			{
-				DeviceMemoryBlockVK* pNewBlock = DBG_NEW DeviceMemoryBlockVK();
-				pNewBlock->Offset = pBestFit->Offset + paddedSizeInBytes;
-				pNewBlock->pPage = this;
-				pNewBlock->pNext = pBestFit->pNext;
-				pNewBlock->pPrevious = pBestFit;
-				pNewBlock->SizeInBytes = pBestFit->SizeInBytes - paddedSizeInBytes;
-				pNewBlock->TotalSizeInBytes = pNewBlock->SizeInBytes;
-				pNewBlock->IsFree = true;
-
-				if (pBestFit->pNext)
-				{
-					pBestFit->pNext->pPrevious = pNewBlock;
-				}
-
-				pBestFit->pNext = pNewBlock;
-				VALIDATE(ValidateChain());
-				VALIDATE(ValidateBlock(pNewBlock));
-
-#ifdef LAMBDA_DEBUG
-				AllBlocks.EmplaceBack(pNewBlock);
-#endif
-			}
-
-			// Set new attributes of block
-			pBestFit->SizeInBytes = sizeInBytes;
-			pBestFit->TotalSizeInBytes = paddedSizeInBytes;
-			pBestFit->IsFree = false;
-
-			VALIDATE(ValidateChain());
-			VALIDATE(ValidateBlock(pBestFit));
+			VALIDATE_OFFSET_ALLOCATOR(m_Allocator);
 
 			// Setup allocation
 			pAllocation->Memory = m_DeviceMemory;
-			pAllocation->Offset = paddedOffset;
-			pAllocation->pBlock = pBestFit;
+			pAllocation->Offset = pAllocation->SubAllocation.Offset;
+			pAllocation->pPage = this;
 			pAllocation->pAllocator = m_pOwningAllocator;
-
-			VALIDATE(ValidateNoOverlap());
 			return true;
 		}
 
 		bool Free(AllocationVK* pAllocation)
 		{
 			std::scoped_lock<SpinLock> lock(m_Lock);
-			VALIDATE(pAllocation != nullptr);
-
-			DeviceMemoryBlockVK* pBlock = pAllocation->pBlock;
-			VALIDATE(pBlock != nullptr);
-			VALIDATE(ValidateChain());
-			VALIDATE(ValidateBlock(pBlock));
 
-			pBlock->IsFree = true;
-			DeviceMemoryBlockVK* pPrevious = pBlock->pPrevious;
-			if (pPrevious)
-			{
-				if (pPrevious->IsFree)
-				{
-					pPrevious->pNext = pBlock->pNext;
-					if (pBlock->pNext)
-					{
-						pBlock->pNext->pPrevious = pPrevious;
-					}
-
-					pPrevious->SizeInBytes += pBlock->TotalSizeInBytes;
-					pPrevious->TotalSizeInBytes += pBlock->TotalSizeInBytes;
-
-					SAFEDELETE(pBlock);
-					pBlock = pPrevious;
-				}
-			}
-
-			VALIDATE(ValidateChain());
-
-			DeviceMemoryBlockVK* pNext = pBlock->pNext;
-			if (pNext)
-			{
-				if (pNext->IsFree)
-				{
-					if (pNext->pNext)
-					{
-						pNext->pNext->pPrevious = pBlock;
-					}
-					pBlock->pNext = pNext->pNext;
-
-					pBlock->SizeInBytes += pNext->TotalSizeInBytes;
-					pBlock->TotalSizeInBytes += pNext->TotalSizeInBytes;
-
-					SAFEDELETE(pNext);
-				}
-			}
+			VALIDATE(pAllocation != nullptr);
+			VALIDATE(pAllocation->pPage == this);
 
-			VALIDATE(ValidateChain());
-			VALIDATE(ValidateNoOverlap());
+			m_Allocator.Free(pAllocation->SubAllocation);
+			VALIDATE_OFFSET_ALLOCATOR(m_Allocator);
 
 			pAllocation->Memory = VK_NULL_HANDLE;
 			pAllocation->Offset = 0;
-			pAllocation->pBlock = nullptr;
+			pAllocation->pPage = nullptr;
 			pAllocation->pAllocator = nullptr;
 
 			return true;
@@ -289,8 +117,7 @@ namespace LambdaEngine
 			std::scoped_lock<SpinLock> lock(m_Lock);
 
 			VALIDATE(pAllocation != nullptr);
-			VALIDATE(pAllocation->pBlock != nullptr);
-			VALIDATE(ValidateBlock(pAllocation->pBlock));
+			VALIDATE(pAllocation->pPage == this);
 
 			if (m_MappingCount == 0)
 			{
@@ -308,8 +135,7 @@ namespace LambdaEngine
 			std::scoped_lock<SpinLock> lock(m_Lock);
 
 			VALIDATE(pAllocation != nullptr);
-			VALIDATE(pAllocation->pBlock != nullptr);
-			VALIDATE(ValidateBlock(pAllocation->pBlock));
+			VALIDATE(pAllocation->pPage == this);
 
 			UNREFERENCED_VARIABLE(pAllocation);
 
@@ -317,7 +143,7 @@ namespace LambdaEngine
 			if (m_MappingCount == 0)
 			{
 				vkUnmapMemory(m_pDevice->Device, m_DeviceMemory);
-				m_MappingCount = 0;
+				m_pHostMemory = nullptr;
 			}
 		}
 
@@ -327,14 +153,15 @@ namespace LambdaEngine
 			m_pDevice->SetVulkanObjectName(debugName, reinterpret_cast<uint64>(m_DeviceMemory), VK_OBJECT_TYPE_DEVICE_MEMORY);
 		}
 
-		FORCEINLINE bool IsEmpty() const
+		FORCEINLINE OffsetAllocatorStatistics GetStatistics()
 		{
-			if (m_pHead)
-			{
-				return m_pHead->IsFree && (m_pHead->TotalSizeInBytes == m_SizeInBytes);
-			}
+			std::scoped_lock<SpinLock> lock(m_Lock);
+			return m_Allocator.GetStatistics();
+		}
 
-			return true;
+		FORCEINLINE bool IsEmpty() const
+		{
+			return m_Allocator.IsEmpty();
 		}
 
 		FORCEINLINE uint32 GetMemoryIndex() const
@@ -347,114 +174,18 @@ namespace LambdaEngine
 			return m_ID;
 		}
 
-	private:
-		bool IsAliasing(VkDeviceSize aOffset, VkDeviceSize aSize, VkDeviceSize bOffset, VkDeviceSize pageGranularity)
-		{
-			VALIDATE(aSize > 0);
-			VALIDATE(pageGranularity > 0);
-
-			VkDeviceSize aEnd = aOffset + (aSize - 1);
-			VkDeviceSize aEndPage = aEnd & ~(pageGranularity - 1);
-			VkDeviceSize bStart = bOffset;
-			VkDeviceSize bStartPage = bStart & ~(pageGranularity - 1);
-			return aEndPage >= bStartPage;
-		}
-
-		/*
-		 * Debug tools
-		 */
-		bool ValidateBlock(DeviceMemoryBlockVK* pBlock) const
-		{
-			DeviceMemoryBlockVK* pIterator = m_pHead;
-			while (pIterator != nullptr)
-			{
-				if (pIterator == pBlock)
-				{
-					return true;
-				}
-				pIterator = pIterator->pNext;
-			}
-
-#ifdef LAMBDA_DEBUG
-			for (DeviceMemoryBlockVK* pBlockIt : AllBlocks)
-			{
-				if (pBlock == pBlockIt)
-				{
-					DEBUGBREAK();
-				}
-			}
-#endif
-
-			return false;
-		}
-
-		bool ValidateNoOverlap() const
-		{
-			DeviceMemoryBlockVK* pIterator = m_pHead;
-			while (pIterator != nullptr)
-			{
-				if (pIterator->pNext)
-				{
-					if ((pIterator->Offset + pIterator->TotalSizeInBytes) > (pIterator->pNext->Offset))
-					{
-						LOG_DEBUG("Overlap found");
-						return false;
-					}
-				}
-
-				pIterator = pIterator->pNext;
-			}
-
-			return true;
-		}
-
-		bool ValidateChain() const
-		{
-			TArray<DeviceMemoryBlockVK*> traversedBlocks;
-
-			// Traverse all the blocks and put them into an array in order
-			DeviceMemoryBlockVK* pIterator = m_pHead;
-			DeviceMemoryBlockVK* pTail = nullptr;
-			while (pIterator != nullptr)
-			{
-				traversedBlocks.EmplaceBack(pIterator);
-				pTail = pIterator;
-				pIterator = pIterator->pNext;
-			}
-
-			/* When we have reached the tail we start going backwards and check so
-			that the order in the array is the same as when we traversed forward*/
-			while (pTail != nullptr)
-			{
-				// In case this fails our chain is not valid
-				if (pTail != traversedBlocks.GetBack())
-				{
-					return false;
-				}
-
-				traversedBlocks.PopBack();
-				pTail = pTail->pPrevious;
-			}
-
-			return true;
-		}
-
 	private:
 		const GraphicsDeviceVK* const m_pDevice;
 		DeviceAllocatorVK* const m_pOwningAllocator;
 		const uint32 m_MemoryIndex;
 		const uint32 m_ID;
-		uint64 m_SizeInBytes = 0;
 
-		DeviceMemoryBlockVK* m_pHead = nullptr;
+		OffsetAllocator m_Allocator;
 		byte* m_pHostMemory = nullptr;
 		VkDeviceMemory m_DeviceMemory = VK_NULL_HANDLE;
 		uint32 m_MappingCount = 0;
 
 		SpinLock m_Lock;
-#ifdef LAMBDA_DEBUG
-		TArray<DeviceMemoryBlockVK*> AllBlocks;
-#endif
 	};
 
 	/*
@@ -491,7 +222,7 @@ namespace LambdaEngine
 		return true;
 	}
 
-	bool DeviceAllocatorVK::Allocate(AllocationVK* pAllocation, uint64 sizeInBytes, uint64 alignment, uint32 memoryIndex)
+	bool DeviceAllocatorVK::Allocate(AllocationVK* pAllocation, uint64 sizeInBytes, uint64 alignment, uint32 memoryIndex, bool optimalTiling)
 	{
 		VALIDATE(pAllocation != nullptr);
 		VALIDATE(sizeInBytes > 0);
@@ -502,7 +233,7 @@ namespace LambdaEngine
 		VkDeviceSize alignedSize = AlignUp(sizeInBytes, alignment);
 		if (alignedSize >= m_PageSize)
 		{
-			pAllocation->pBlock = nullptr;
+			pAllocation->pPage = nullptr;
 			pAllocation->pAllocator = nullptr;
 			pAllocation->Offset = 0;
 			pAllocation->Memory = 0;
@@ -518,7 +249,7 @@ namespace LambdaEngine
 				if (pMemoryPage->GetMemoryIndex() == memoryIndex)
 				{
 					// Try and allocate otherwise we continue the search
-					if (pMemoryPage->Allocate(pAllocation, sizeInBytes, alignment, m_DeviceProperties.limits.bufferImageGranularity))
+					if (pMemoryPage->Allocate(pAllocation, sizeInBytes, alignment, optimalTiling))
 					{
 						return true;
 					}
@@ -527,9 +258,9 @@ namespace LambdaEngine
 		}
 
 		DeviceMemoryPageVK* pNewMemoryPage = DBG_NEW DeviceMemoryPageVK(m_pDevice, this, uint32(m_Pages.GetSize()), memoryIndex);
-		if (!pNewMemoryPage->Init(m_PageSize))
+		if (!pNewMemoryPage->Init(m_PageSize, m_DeviceProperties.limits.bufferImageGranularity))
 		{
-			pAllocation->pBlock = nullptr;
+			pAllocation->pPage = nullptr;
 			pAllocation->pAllocator = nullptr;
 			pAllocation->Offset = 0;
 			pAllocation->Memory = 0;
@@ -542,7 +273,7 @@ namespace LambdaEngine
 		}
 
 		m_Pages.EmplaceBack(pNewMemoryPage);
-		return pNewMemoryPage->Allocate(pAllocation, sizeInBytes, alignment, m_DeviceProperties.limits.bufferImageGranularity);
+		return pNewMemoryPage->Allocate(pAllocation, sizeInBytes, alignment, optimalTiling);
 	}
 
 	bool DeviceAllocatorVK::Free(AllocationVK* pAllocation)
@@ -550,10 +281,7 @@ namespace LambdaEngine
 		std::scoped_lock<SpinLock> lock(m_Lock);
 
 		VALIDATE(pAllocation != nullptr);
-		DeviceMemoryBlockVK* pBlock = pAllocation->pBlock;
-
-		VALIDATE(pBlock != nullptr);
-		DeviceMemoryPageVK* pPage = pBlock->pPage;
+		DeviceMemoryPageVK* pPage = pAllocation->pPage;
 
 		VALIDATE(pPage != nullptr);
 		
@@ -581,10 +309,7 @@ namespace LambdaEngine
 		std::scoped_lock<SpinLock> lock(m_Lock);
 
 		VALIDATE(pAllocation != nullptr);
-		DeviceMemoryBlockVK* pBlock = pAllocation->pBlock;
-
-		VALIDATE(pBlock != nullptr);
-		DeviceMemoryPageVK* pPage = pBlock->pPage;
+		DeviceMemoryPageVK* pPage = pAllocation->pPage;
 
 		VALIDATE(pPage != nullptr);
 		return pPage->Map(pAllocation);
@@ -595,15 +320,24 @@ namespace LambdaEngine
 		std::scoped_lock<SpinLock> lock(m_Lock);
 
 		VALIDATE(pAllocation != nullptr);
-		DeviceMemoryBlockVK* pBlock = pAllocation->pBlock;
-
-		VALIDATE(pBlock != nullptr);
-		DeviceMemoryPageVK* pPage = pBlock->pPage;
+		DeviceMemoryPageVK* pPage = pAllocation->pPage;
 
 		VALIDATE(pPage != nullptr);
 		return pPage->Unmap(pAllocation);
 	}
 
+	void DeviceAllocatorVK::GetPageStatistics(TArray<OffsetAllocatorStatistics>& statistics)
+	{
+		std::scoped_lock<SpinLock> lock(m_Lock);
+
+		statistics.Clear();
+		statistics.Reserve(m_Pages.GetSize());
+		for (DeviceMemoryPageVK* pMemoryPage : m_Pages)
+		{
+			statistics.EmplaceBack(pMemoryPage->GetStatistics());
+		}
+	}
+
 	void DeviceAllocatorVK::SetPageName(DeviceMemoryPageVK* pMemoryPage)
 	{
 		VALIDATE(pMemoryPage != nullptr);
@@ -26,8 +26,13 @@
 #include "Rendering/Core/Vulkan/DescriptorSetVK.h"
 #include "Rendering/Core/Vulkan/FrameBufferCacheVK.h"
 #include "Rendering/Core/Vulkan/QueryHeapVK.h"
+#include "Rendering/Core/Vulkan/MemoryHeapVK.h"
 #include "Rendering/Core/Vulkan/ShaderVK.h"
 #include "Rendering/Core/Vulkan/VulkanHelpers.h"
+
+#include "Rendering/PipelineCacheFile.h"
+
+#include "Resources/ResourcePaths.h"
 #include "Rendering/Core/Vulkan/SBTVK.h"
 
 namespace LambdaEngine
@@ -108,6 +113,14 @@ namespace LambdaEngine
 		SAFERELEASE(m_pUAAllocator);
 		SAFERELEASE(m_pBufferAllocator);
 
+		if (PipelineCache != VK_NULL_HANDLE)
+		{
+			SavePipelineCache();
+
+			vkDestroyPipelineCache(Device, PipelineCache, nullptr);
+			PipelineCache = VK_NULL_HANDLE;
+		}
+
 		if (Device != VK_NULL_HANDLE)
 		{
 			vkDestroyDevice(Device, nullptr);
@@ -167,6 +180,12 @@ namespace LambdaEngine
 			LOG_MESSAGE("Created vulkan allocators!");
 		}
 
+		// A missing pipeline cache only makes pipeline creation slower
+		if (!InitPipelineCache())
+		{
+			LOG_WARNING("Could not create pipeline cache!");
+		}
+
 		// Setup desc
 		VkPhysicalDeviceProperties properties = GetPhysicalDeviceProperties();
 		m_Desc				= *pDesc;
@@ -224,7 +243,7 @@ namespace LambdaEngine
 		{
 			pAllocation->Offset = 0;
 			pAllocation->pAllocator = nullptr;
-			pAllocation->pBlock = nullptr;
+			pAllocation->pPage = nullptr;
 			return (AllocateMemory(&pAllocation->Memory, sizeInBytes, memoryIndex) == VK_SUCCESS);
 		}
 	}
@@ -239,7 +258,7 @@ namespace LambdaEngine
 		{
 			pAllocation->Offset = 0;
 			pAllocation->pAllocator = nullptr;
-			pAllocation->pBlock = nullptr;
+			pAllocation->pPage = nullptr;
 			return (AllocateMemory(&pAllocation->Memory, sizeInBytes, memoryIndex) == VK_SUCCESS);
 		}
 		else
@@ -258,12 +277,12 @@ namespace LambdaEngine
 		{
 			pAllocation->Offset = 0;
 			pAllocation->pAllocator = nullptr;
-			pAllocation->pBlock = nullptr;
+			pAllocation->pPage = nullptr;
 			return (AllocateMemory(&pAllocation->Memory, sizeInBytes, memoryIndex) == VK_SUCCESS);
 		}
 		else
 		{
-			return m_pTextureAllocator->Allocate(pAllocation, sizeInBytes, alignment, memoryIndex);
+			return m_pTextureAllocator->Allocate(pAllocation, sizeInBytes, alignment, memoryIndex, true);
 		}
 	}
 
@@ -271,8 +290,8 @@ namespace LambdaEngine
 	{
 		VALIDATE(pAllocation != nullptr);
 
-		// If the memory block is nullptr assume that the allocation is dedicated
-		if (pAllocation->pBlock != nullptr)
+		// If the memory page is nullptr assume that the allocation is dedicated
+		if (pAllocation->pPage != nullptr)
 		{
 			DeviceAllocatorVK* pAllocator = pAllocation->pAllocator;
 			VALIDATE(pAllocator != nullptr);
@@ -289,7 +308,7 @@ namespace LambdaEngine
 	{
 		VALIDATE(pAllocation != nullptr);
 
-		if (pAllocation->pBlock != nullptr)
+		if (pAllocation->pPage != nullptr)
 		{
 			DeviceAllocatorVK* pAllocator = pAllocation->pAllocator;
 
@@ -310,7 +329,7 @@ namespace LambdaEngine
 	{
 		VALIDATE(pAllocation != nullptr);
 
-		if (pAllocation->pBlock != nullptr)
+		if (pAllocation->pPage != nullptr)
 		{
 			DeviceAllocatorVK* pAllocator = pAllocation->pAllocator;
 
@@ -495,6 +514,32 @@ namespace LambdaEngine
 		}
 	}
 
+	bool GraphicsDeviceVK::QueryTextureMemoryRequirements(const TextureDesc* pDesc, ResourceMemoryRequirements* pRequirements) const
+	{
+		VALIDATE(pDesc != nullptr);
+		VALIDATE(pRequirements != nullptr);
+
+		// The requirements depend on the driver, so create the image without any memory and ask for them
+		VkImageCreateInfo info = TextureVK::CreateImageInfo(pDesc);
+
+		VkImage image = VK_NULL_HANDLE;
+		VkResult result = vkCreateImage(Device, &info, nullptr, &image);
+		if (result != VK_SUCCESS)
+		{
+			LOG_VULKAN_ERROR(result, "Failed to create image for memory requirements");
+			return false;
+		}
+
+		VkMemoryRequirements memoryRequirements = { };
+		vkGetImageMemoryRequirements(Device, image, &memoryRequirements);
+		vkDestroyImage(Device, image, nullptr);
+
+		pRequirements->SizeInBytes		= memoryRequirements.size;
+		pRequirements->Alignment		= memoryRequirements.alignment;
+		pRequirements->MemoryTypeBits	= memoryRequirements.memoryTypeBits;
+		return true;
+	}
+
 	QueryHeap* GraphicsDeviceVK::CreateQueryHeap(const QueryHeapDesc* pDesc) const
 	{
 		VALIDATE(pDesc != nullptr);
@@ -810,6 +855,22 @@ namespace LambdaEngine
 		}
 	}
 
+	MemoryHeap* GraphicsDeviceVK::CreateMemoryHeap(const MemoryHeapDesc* pDesc) const
+	{
+		VALIDATE(pDesc != nullptr);
+
+		MemoryHeapVK* pMemoryHeap = DBG_NEW MemoryHeapVK(this);
+		if (!pMemoryHeap->Init(pDesc))
+		{
+			pMemoryHeap->Release();
+			return nullptr;
+		}
+		else
+		{
+			return pMemoryHeap;
+		}
+	}
+
 	TextureView* GraphicsDeviceVK::CreateTextureView(const TextureViewDesc* pDesc) const
 	{
 		VALIDATE(pDesc != nullptr);
@@ -1311,6 +1372,67 @@ namespace LambdaEngine
 		}
 	}
 
+	static PipelineCacheIdentity GetPipelineCacheIdentity(const VkPhysicalDeviceProperties& properties)
+	{
+		PipelineCacheIdentity identity = {};
+		identity.VendorID		= properties.vendorID;
+		identity.DeviceID		= properties.deviceID;
+		identity.DriverVersion	= properties.driverVersion;
+		static_assert(sizeof(identity.CacheUUID) == VK_UUID_SIZE);
+		memcpy(identity.CacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE);
+		return identity;
+	}
+
+	bool GraphicsDeviceVK::InitPipelineCache()
+	{
+		TArray<byte> initialData;
+		PipelineCacheFile::Read(PIPELINE_CACHE_FILE, GetPipelineCacheIdentity(GetPhysicalDeviceProperties()), initialData);
+
+		VkPipelineCacheCreateInfo createInfo = {};
+		createInfo.sType			= VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+		createInfo.pNext			= nullptr;
+		createInfo.flags			= 0;
+		createInfo.initialDataSize	= initialData.GetSize();
+		createInfo.pInitialData		= initialData.GetData();
+
+		VkResult result = vkCreatePipelineCache(Device, &createInfo, nullptr, &PipelineCache);
+		if (result != VK_SUCCESS && !initialData.IsEmpty())
+		{
+			// The driver may still reject the blob, retry with an empty cache
+			createInfo.initialDataSize	= 0;
+			createInfo.pInitialData		= nullptr;
+			result = vkCreatePipelineCache(Device, &createInfo, nullptr, &PipelineCache);
+		}
+
+		if (result != VK_SUCCESS)
+		{
+			LOG_VULKAN_ERROR(result, "vkCreatePipelineCache failed");
+			PipelineCache = VK_NULL_HANDLE;
+			return false;
+		}
+
+		LOG_MESSAGE("Created vulkan pipeline cache with %u bytes of initial data", initialData.GetSize());
+		return true;
+	}
+
+	void GraphicsDeviceVK::SavePipelineCache()
+	{
+		size_t dataSize = 0;
+		if (vkGetPipelineCacheData(Device, PipelineCache, &dataSize, nullptr) != VK_SUCCESS || dataSize == 0)
+		{
+			return;
+		}
+
+		TArray<byte> data(uint32(dataSize));
+		if (vkGetPipelineCacheData(Device, PipelineCache, &dataSize, data.GetData()) != VK_SUCCESS)
+		{
+			return;
+		}
+
+		data.Resize(uint32(dataSize));
+		PipelineCacheFile::Write(PIPELINE_CACHE_FILE, GetPipelineCacheIdentity(GetPhysicalDeviceProperties()), data);
+	}
+
 	bool GraphicsDeviceVK::InitAllocators()
 	{
 		m_pTextureAllocator = DBG_NEW DeviceAllocatorVK(this);
@@ -274,7 +274,7 @@ namespace LambdaEngine
 		pipelineInfo.basePipelineHandle		= VK_NULL_HANDLE;
 		pipelineInfo.basePipelineIndex		= -1;
 
-		VkResult result = vkCreateGraphicsPipelines(m_pDevice->Device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &m_Pipeline);
+		VkResult result = vkCreateGraphicsPipelines(m_pDevice->Device, m_pDevice->PipelineCache, 1, &pipelineInfo, nullptr, &m_Pipeline);
 		if (result != VK_SUCCESS)
 		{
 			if (!pDesc->DebugName.empty())
@@ -0,0 +1,65 @@
+#include "Log/Log.h"
+
+#include "Rendering/Core/Vulkan/MemoryHeapVK.h"
+#include "Rendering/Core/Vulkan/GraphicsDeviceVK.h"
+#include "Rendering/Core/Vulkan/VulkanHelpers.h"
+
+namespace LambdaEngine
+{
+	MemoryHeapVK::MemoryHeapVK(const GraphicsDeviceVK* pDevice)
+		: TDeviceChild(pDevice)
+	{
+	}
+
+	MemoryHeapVK::~MemoryHeapVK()
+	{
+		if (m_Memory != VK_NULL_HANDLE)
+		{
+			m_pDevice->FreeMemory(m_Memory);
+			m_Memory = VK_NULL_HANDLE;
+		}
+	}
+
+	bool MemoryHeapVK::Init(const MemoryHeapDesc* pDesc)
+	{
+		VALIDATE(pDesc->SizeInBytes > 0);
+
+		VkMemoryPropertyFlags memoryProperties = 0;
+		if (pDesc->MemoryType == EMemoryType::MEMORY_TYPE_CPU_VISIBLE)
+		{
+			memoryProperties = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+		}
+		else if (pDesc->MemoryType == EMemoryType::MEMORY_TYPE_GPU)
+		{
+			memoryProperties = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+		}
+
+		m_MemoryTypeIndex = FindMemoryType(m_pDevice->PhysicalDevice, pDesc->MemoryTypeBits, memoryProperties);
+		if (m_MemoryTypeIndex == UINT32_MAX)
+		{
+			LOG_ERROR("Failed to find a memory type for MemoryHeap \"%s\"", pDesc->DebugName.c_str());
+			return false;
+		}
+
+		VkResult result = m_pDevice->AllocateMemory(&m_Memory, pDesc->SizeInBytes, int32(m_MemoryTypeIndex));
+		if (result != VK_SUCCESS)
+		{
+			LOG_VULKAN_ERROR(result, "Failed to allocate MemoryHeap");
+			return false;
+		}
+		else
+		{
+			m_Desc = *pDesc;
+			SetName(pDesc->DebugName);
+
+			LOG_VULKAN_INFO("Created MemoryHeap of %llu bytes", pDesc->SizeInBytes);
+			return true;
+		}
+	}
+
+	void MemoryHeapVK::SetName(const String& debugName)
+	{
+		m_pDevice->SetVulkanObjectName(debugName, reinterpret_cast<uint64>(m_Memory), VK_OBJECT_TYPE_DEVICE_MEMORY);
+		m_Desc.DebugName = debugName;
+	}
+}
@@ -139,7 +139,7 @@ namespace LambdaEngine
 		rayTracingPipelineInfo.layout			 = pPipelineLayoutVk->GetPipelineLayout();
 		rayTracingPipelineInfo.libraries		 = rayTracingPipelineLibrariesInfo;
 
-		VkResult result = m_pDevice->vkCreateRayTracingPipelinesKHR(m_pDevice->Device, VK_NULL_HANDLE, 1, &rayTracingPipelineInfo, nullptr, &m_Pipeline);
+		VkResult result = m_pDevice->vkCreateRayTracingPipelinesKHR(m_pDevice->Device, m_pDevice->PipelineCache, 1, &rayTracingPipelineInfo, nullptr, &m_Pipeline);
 		if (result != VK_SUCCESS)
 		{
 			if (!pDesc->DebugName.empty())
@@ -19,7 +19,7 @@ namespace LambdaEngine
 		InternalRelease();
 	}
 
-	bool TextureVK::Init(const TextureDesc* pDesc)
+	VkImageCreateInfo TextureVK::CreateImageInfo(const TextureDesc* pDesc)
 	{
 		VkFormat format = ConvertFormat(pDesc->Format);
 		VALIDATE(format != VK_FORMAT_UNDEFINED);
@@ -83,6 +83,13 @@ namespace LambdaEngine
 			info.imageType = VK_IMAGE_TYPE_3D;
 		}
 
+		return info;
+	}
+
+	bool TextureVK::Init(const TextureDesc* pDesc)
+	{
+		VkImageCreateInfo info = CreateImageInfo(pDesc);
+
 		VkResult result = vkCreateImage(m_pDevice->Device, &info, nullptr, &m_Image);
 		if (result != VK_SUCCESS)
 		{
@@ -106,6 +113,11 @@ namespace LambdaEngine
 		VkMemoryRequirements memoryRequirements = { };
 		vkGetImageMemoryRequirements(m_pDevice->Device, m_Image, &memoryRequirements);
 
+		if (pDesc->pMemoryHeap != nullptr)
+		{
+			return BindToMemoryHeap(memoryRequirements, pDesc->pMemoryHeap, pDesc->MemoryHeapOffset);
+		}
+
 		VkMemoryPropertyFlags memoryProperties = 0;
 		if (m_Desc.MemoryType == EMemoryType::MEMORY_TYPE_CPU_VISIBLE)
 		{
@@ -133,6 +145,42 @@ namespace LambdaEngine
 		return true;
 	}
 
+	bool TextureVK::BindToMemoryHeap(const VkMemoryRequirements& memoryRequirements, MemoryHeap* pMemoryHeap, uint64 offset)
+	{
+		// Hold a reference so the memory stays alive as long as the image
+		MemoryHeapVK* pMemoryHeapVk = reinterpret_cast<MemoryHeapVK*>(pMemoryHeap);
+		m_MemoryHeap = pMemoryHeapVk;
+		m_MemoryHeap->AddRef();
+
+		const uint32 memoryTypeIndex = pMemoryHeapVk->GetMemoryTypeIndex();
+		if ((memoryRequirements.memoryTypeBits & (1u << memoryTypeIndex)) == 0)
+		{
+			LOG_ERROR("Texture \"%s\" can not be placed in MemoryHeap \"%s\", the memory type is not supported", m_Desc.DebugName.c_str(), pMemoryHeap->GetDesc().DebugName.c_str());
+			return false;
+		}
+
+		if (offset % memoryRequirements.alignment != 0 || offset + memoryRequirements.size > pMemoryHeap->GetDesc().SizeInBytes)
+		{
+			LOG_ERROR("Texture \"%s\" can not be placed at offset %llu in MemoryHeap \"%s\" of %llu bytes, requires %llu bytes with alignment %llu",
+				m_Desc.DebugName.c_str(),
+				offset,
+				pMemoryHeap->GetDesc().DebugName.c_str(),
+				pMemoryHeap->GetDesc().SizeInBytes,
+				memoryRequirements.size,
+				memoryRequirements.alignment);
+			return false;
+		}
+
+		VkResult result = vkBindImageMemory(m_pDevice->Device, m_Image, pMemoryHeapVk->GetDeviceMemory(), offset);
+		if (result != VK_SUCCESS)
+		{
+			LOG_VULKAN_ERROR(result, "Failed to bind memory");
+			return false;
+		}
+
+		return true;
+	}
+
 	void TextureVK::InitWithImage(VkImage image, const TextureDesc* pDesc)
 	{
 		VALIDATE(image != VK_NULL_HANDLE);
@@ -150,7 +198,18 @@ namespace LambdaEngine
 
 	void TextureVK::InternalRelease()
 	{
-		if (m_Allocation.Memory != VK_NULL_HANDLE)
+		// Placed textures only own the image, the memory belongs to the heap
+		if (m_MemoryHeap)
+		{
+			if (m_Image != VK_NULL_HANDLE)
+			{
+				vkDestroyImage(m_pDevice->Device, m_Image, nullptr);
+				m_Image = VK_NULL_HANDLE;
+			}
+
+			m_MemoryHeap.Reset();
+		}
+		else if (m_Allocation.Memory != VK_NULL_HANDLE)
 		{
 			if (m_Image != VK_NULL_HANDLE)
 			{
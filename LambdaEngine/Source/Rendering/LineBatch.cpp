@@ -0,0 +1,226 @@
+#include "Rendering/LineBatch.h"
+
+namespace LambdaEngine
+{
+	// Compacting small streams does not pay off, holes below this are left alone
+	constexpr const uint32 MIN_UNUSED_VERTICES_TO_COMPACT = 1024;
+
+	void LineBatch::Clear()
+	{
+		m_Vertices.Clear();
+		m_Groups.clear();
+		m_TimedRanges.Clear();
+		m_UnusedVertexCount = 0;
+		ClearDirtyRange();
+	}
+
+	void LineBatch::Tick(float64 time)
+	{
+		m_Time = time;
+
+		for (uint32 r = 0; r < m_TimedRanges.GetSize();)
+		{
+			if (m_TimedRanges[r].ExpireTime <= time)
+			{
+				FreeRange(m_TimedRanges[r].Range);
+
+				m_TimedRanges[r] = m_TimedRanges.GetBack();
+				m_TimedRanges.PopBack();
+				continue;
+			}
+
+			r++;
+		}
+
+		if (m_UnusedVertexCount >= MIN_UNUSED_VERTICES_TO_COMPACT && m_UnusedVertexCount * 2 > m_Vertices.GetSize())
+		{
+			Compact();
+		}
+	}
+
+	uint32 LineBatch::AddGroup(const glm::vec3* pPoints, uint32 pointCount, const glm::vec3& color)
+	{
+		// If points did not contain an equal amount of points, don't use the last point to avoid wrong drawings
+		if (pointCount % 2 != 0)
+		{
+			pointCount--;
+			LOG_INFO("[LineBatch]: AddGroup recived an uneven amount of points. When adding points the number of points should be divideable by two.");
+		}
+
+		const uint32 ID = m_NextGroupID++;
+		const LineRange range = AllocateRange(pointCount);
+		WriteGroup(range, pPoints, color);
+
+		m_Groups[ID] = range;
+		return ID;
+	}
+
+	uint32 LineBatch::UpdateGroup(uint32 ID, const glm::vec3* pPoints, uint32 pointCount, const glm::vec3& color)
+	{
+		auto groupIt = m_Groups.find(ID);
+		if (groupIt == m_Groups.end())
+		{
+			return AddGroup(pPoints, pointCount, color);
+		}
+
+		pointCount -= pointCount % 2;
+
+		LineRange& range = groupIt->second;
+		if (range.VertexCount != pointCount)
+		{
+			FreeRange(range);
+			range = AllocateRange(pointCount);
+		}
+
+		WriteGroup(range, pPoints, color);
+		return ID;
+	}
+
+	void LineBatch::RemoveGroup(uint32 ID)
+	{
+		auto groupIt = m_Groups.find(ID);
+		if (groupIt != m_Groups.end())
+		{
+			FreeRange(groupIt->second);
+			m_Groups.erase(groupIt);
+		}
+	}
+
+	void LineBatch::AddLines(const VertexData* pVertices, uint32 vertexCount, float32 lifetime)
+	{
+		if (vertexCount == 0)
+		{
+			return;
+		}
+
+		const float64 expireTime = lifetime == LINE_LIFETIME_INFINITE ? DBL_MAX : m_Time + float64(lifetime);
+
+		// Extend the last range if it ends the stream and expires at the same time, so a frame of lines is one range
+		TimedRange* pTimedRange = nullptr;
+		if (!m_TimedRanges.IsEmpty())
+		{
+			TimedRange& lastRange = m_TimedRanges.GetBack();
+			if (lastRange.ExpireTime == expireTime && lastRange.Range.Offset + lastRange.Range.VertexCount == m_Vertices.GetSize())
+			{
+				pTimedRange = &lastRange;
+			}
+		}
+
+		const LineRange range = AllocateRange(vertexCount);
+		memcpy(&m_Vertices[range.Offset], pVertices, vertexCount * sizeof(VertexData));
+
+		if (pTimedRange != nullptr)
+		{
+			pTimedRange->Range.VertexCount += vertexCount;
+		}
+		else
+		{
+			m_TimedRanges.PushBack({ range, expireTime });
+		}
+	}
+
+	bool LineBatch::GetDirtyRange(uint32& offset, uint32& count) const
+	{
+		const uint32 dirtyEnd = glm::min(m_DirtyEnd, m_Vertices.GetSize());
+		if (m_DirtyBegin >= dirtyEnd)
+		{
+			return false;
+		}
+
+		offset	= m_DirtyBegin;
+		count	= dirtyEnd - m_DirtyBegin;
+		return true;
+	}
+
+	void LineBatch::ClearDirtyRange()
+	{
+		m_DirtyBegin	= UINT32_MAX;
+		m_DirtyEnd		= 0;
+	}
+
+	LineBatch::LineRange LineBatch::AllocateRange(uint32 vertexCount)
+	{
+		LineRange range = {};
+		range.Offset		= m_Vertices.GetSize();
+		range.VertexCount	= vertexCount;
+
+		m_Vertices.Resize(range.Offset + vertexCount);
+		MarkDirty(range.Offset, vertexCount);
+		return range;
+	}
+
+	void LineBatch::FreeRange(const LineRange& range)
+	{
+		if (range.VertexCount == 0)
+		{
+			return;
+		}
+
+		// Ranges at the end of the stream are dropped, others become lines with zero length and alpha
+		if (range.Offset + range.VertexCount == m_Vertices.GetSize())
+		{
+			m_Vertices.Resize(range.Offset);
+		}
+		else
+		{
+			memset(&m_Vertices[range.Offset], 0, range.VertexCount * sizeof(VertexData));
+			m_UnusedVertexCount += range.VertexCount;
+			MarkDirty(range.Offset, range.VertexCount);
+		}
+	}
+
+	void LineBatch::WriteGroup(const LineRange& range, const glm::vec3* pPoints, const glm::vec3& color)
+	{
+		const glm::vec4 vertexColor = glm::vec4(color, 1.0f);
+		for (uint32 p = 0; p < range.VertexCount; p++)
+		{
+			VertexData& vertex = m_Vertices[range.Offset + p];
+			vertex.Position	= glm::vec4(pPoints[p], 1.0f);
+			vertex.Color	= vertexColor;
+		}
+
+		MarkDirty(range.Offset, range.VertexCount);
+	}
+
+	void LineBatch::Compact()
+	{
+		TArray<VertexData> vertices;
+		vertices.Reserve(m_Vertices.GetSize() - m_UnusedVertexCount);
+
+		auto moveRange = [&](LineRange& range)
+		{
+			const uint32 offset = vertices.GetSize();
+			vertices.Resize(offset + range.VertexCount);
+			if (range.VertexCount > 0)
+			{
+				memcpy(&vertices[offset], &m_Vertices[range.Offset], range.VertexCount * sizeof(VertexData));
+			}
+			range.Offset = offset;
+		};
+
+		for (auto& group : m_Groups)
+		{
+			moveRange(group.second);
+		}
+
+		for (TimedRange& timedRange : m_TimedRanges)
+		{
+			moveRange(timedRange.Range);
+		}
+
+		m_Vertices = std::move(vertices);
+		m_UnusedVertexCount = 0;
+
+		ClearDirtyRange();
+		MarkDirty(0, m_Vertices.GetSize());
+	}
+
+	void LineBatch::MarkDirty(uint32 offset, uint32 count)
+	{
+		if (count > 0)
+		{
+			m_DirtyBegin	= glm::min(m_DirtyBegin, offset);
+			m_DirtyEnd		= glm::max(m_DirtyEnd, offset + count);
+		}
+	}
+}
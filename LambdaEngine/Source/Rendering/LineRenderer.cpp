@@ -20,6 +20,8 @@
 #include "Rendering/Core/API/Shader.h"
 #include "Rendering/Core/API/Buffer.h"
 
+#include "Engine/EngineLoop.h"
+
 #include "Application/API/Window.h"
 #include "Application/API/CommonApplication.h"
 
@@ -29,10 +31,9 @@
 
 namespace LambdaEngine
 {
-	LineRenderer*							LineRenderer::s_pInstance = nullptr;
-	TArray<VertexData>						LineRenderer::s_Verticies;
-	THashTable<uint32, TArray<VertexData>>	LineRenderer::s_LineGroups;
-	float32									LineRenderer::s_LineWidth = 1.0f;
+	LineRenderer*	LineRenderer::s_pInstance = nullptr;
+	LineBatch		LineRenderer::s_LineBatch;
+	float32			LineRenderer::s_LineWidth = 1.0f;
 
 	LineRenderer::LineRenderer(const GraphicsDevice* pGraphicsDevice, uint32 verticiesBufferSize, uint32 backBufferCount)
 	{
@@ -61,12 +62,7 @@ namespace LambdaEngine
 		SAFEDELETE_ARRAY(m_ppRenderCommandLists);
 		SAFEDELETE_ARRAY(m_ppRenderCommandAllocators);
 
-		s_Verticies.Clear();
-		for (auto& lineGroup : s_LineGroups)
-		{
-			lineGroup.second.Clear();
-		}
-		s_LineGroups.clear();
+		s_LineBatch.Clear();
 	}
 
 	bool LineRenderer::Init()
@@ -131,68 +127,17 @@ namespace LambdaEngine
 
 	uint32 LineRenderer::AddLineGroup(const TArray<glm::vec3>& points, const glm::vec3& color)
 	{
-		uint32 ID = (uint32)s_LineGroups.size();
-		TArray<VertexData>& vertexPoints = s_LineGroups[ID];
-		uint32 size = points.GetSize();
-
-		// If points did not contain an equal amount of points, don't use the last point to avoid wrong drawings
-		if (size % 2 != 0)
-		{
-			size--;
-			LOG_INFO("[Physics Renderer]: AddLineGroup recived an uneven amount of points. When adding points the number of points should be divideable by two.");
-		}
-
-		vertexPoints.Resize(size);
-		for (uint32 p = 0; p < size; p++)
-		{
-			vertexPoints[p].Position 	= glm::vec4(points[p], 1.0f);
-			vertexPoints[p].Color		= glm::vec4(color, 1.0f);
-		}
-
-		return ID;
+		return s_LineBatch.AddGroup(points.GetData(), points.GetSize(), color);
 	}
 
 	uint32 LineRenderer::UpdateLineGroup(uint32 ID, const TArray<glm::vec3>& points, const glm::vec3& color)
 	{
-		if (s_LineGroups.contains(ID))
-		{
-			TArray<VertexData>& vertexPoints = s_LineGroups[ID];
-			if (points.GetSize() > vertexPoints.GetSize())
-			{
-				vertexPoints.Resize(points.GetSize());
-			}
-			else if (points.GetSize() < vertexPoints.GetSize())
-			{
-				vertexPoints.Resize(points.GetSize());
-			}
-			else
-			{
-				for (uint32 p = 0; p < vertexPoints.GetSize(); p++)
-				{
-					vertexPoints[p].Position 	= glm::vec4(points[p], 1.0f);
-					vertexPoints[p].Color		= glm::vec4(color, 1.0f);
-				}
-			}
-			return ID;
-		}
-		else
-		{
-			return AddLineGroup(points, color);
-		}
+		return s_LineBatch.UpdateGroup(ID, points.GetData(), points.GetSize(), color);
 	}
 
 	void LineRenderer::RemoveLineGroup(uint32 ID)
 	{
-		if (s_LineGroups.contains(ID))
-		{
-			auto& arr = s_LineGroups[ID];
-			arr.Clear();
-			s_LineGroups.erase(ID);
-		}
-		else
-		{
-			return;
-		}
+		s_LineBatch.RemoveGroup(ID);
 	}
 
 	void LineRenderer::SetLineWidth(float32 lineWidth)
@@ -204,31 +149,24 @@ namespace LambdaEngine
 	}
 
 
-	void LineRenderer::DrawLine(const glm::vec3& from, const glm::vec3& to, const glm::vec3& color)
+	void LineRenderer::DrawLine(const glm::vec3& from, const glm::vec3& to, const glm::vec3& color, float32 lifetime)
 	{
-		// if (m_DebugMode > 0)
-		VertexData fromData = {};
-		fromData.Position 	= { from.x, from.y, from.z, 1.0f };
-		fromData.Color		= { color.x, color.y, color.z, 1.0f };
-		s_Verticies.PushBack(fromData);
-
-		VertexData toData	= {};
-		toData.Position		= { to.x, to.y, to.z, 1.0f };
-		toData.Color		= { color.x, color.y, color.z, 1.0f };
-		s_Verticies.PushBack(toData);
+		DrawLine(from, to, color, color, lifetime);
 	}
 
-	void LineRenderer::DrawLine(const glm::vec3& from, const glm::vec3& to, const glm::vec3& fromColor, const glm::vec3& toColor)
+	void LineRenderer::DrawLine(const glm::vec3& from, const glm::vec3& to, const glm::vec3& fromColor, const glm::vec3& toColor, float32 lifetime)
 	{
-		VertexData fromData = {};
-		fromData.Position 	= { from.x, from.y, from.z, 1.0f };
-		fromData.Color		= { fromColor.x, fromColor.y, fromColor.z, 1.0f };
-		s_Verticies.PushBack(fromData);
-
-		VertexData toData	= {};
-		toData.Position		= { to.x, to.y, to.z, 1.0f };
-		toData.Color		= { toColor.x, toColor.y, toColor.z, 1.0f };
-		s_Verticies.PushBack(toData);
+		VertexData vertices[2] = {};
+		vertices[0].Position	= { from.x, from.y, from.z, 1.0f };
+		vertices[0].Color		= { fromColor.x, fromColor.y, fromColor.z, 1.0f };
+		vertices[1].Position	= { to.x, to.y, to.z, 1.0f };
+		vertices[1].Color		= { toColor.x, toColor.y, toColor.z, 1.0f };
+		s_LineBatch.AddLines(vertices, 2, lifetime);
+	}
+
+	void LineRenderer::DrawLines(const VertexData* pVertices, uint32 vertexCount, float32 lifetime)
+	{
+		s_LineBatch.AddLines(pVertices, vertexCount, lifetime);
 	}
 
 	bool LineRenderer::RenderGraphInit(const CustomRendererRenderGraphInitDesc* pPreInitDesc)
@@ -390,8 +328,10 @@ namespace LambdaEngine
 
 		CommandList* pCommandList = m_ppRenderCommandLists[modFrameIndex];
 
-		if (s_LineGroups.size() == 0 && s_Verticies.GetSize() == 0)
+		if (s_LineBatch.GetVertexCount() == 0)
 		{
+			s_LineBatch.Tick(EngineLoop::GetTimeSinceStart().AsSeconds());
+
 			m_ppRenderCommandAllocators[modFrameIndex]->Reset();
 			pCommandList->Begin(nullptr);
 			//Begin and End RenderPass to transition Texture State (Lazy)
@@ -409,32 +349,32 @@ namespace LambdaEngine
 
 		pCommandList->SetLineWidth(s_LineWidth);
 
-		// Transfer data to copy buffers then the GPU buffers
-		uint32 drawCount = 0;
+		// The vertex buffer keeps its content between frames, only the vertices that changed are copied
+		const uint32 maxVertexCount = m_verticiesBufferSize / sizeof(VertexData);
+		const uint32 drawCount = glm::min(s_LineBatch.GetVertexCount(), maxVertexCount);
+		if (drawCount < s_LineBatch.GetVertexCount() && !m_ExceededBufferSize)
 		{
-			TSharedRef<Buffer> uniformCopyBuffer = m_UniformCopyBuffers[modFrameIndex];
+			LOG_WARNING("[LineRenderer]: %u vertices do not fit in the vertex buffer, only the first %u are drawn", s_LineBatch.GetVertexCount(), maxVertexCount);
+			m_ExceededBufferSize = true;
+		}
 
-			uint32 totalBufferSize 	= 0;
-			byte* pUniformMapping	= reinterpret_cast<byte*>(uniformCopyBuffer->Map());
+		uint32 dirtyOffset	= 0;
+		uint32 dirtyCount	= 0;
+		if (s_LineBatch.GetDirtyRange(dirtyOffset, dirtyCount) && dirtyOffset < drawCount)
+		{
+			dirtyCount = glm::min(dirtyCount, drawCount - dirtyOffset);
 
-			for (auto& lineGroup : s_LineGroups)
-			{
-				const uint32 currentBufferSize = lineGroup.second.GetSize() * sizeof(VertexData);
-				memcpy(pUniformMapping + totalBufferSize, lineGroup.second.GetData(), currentBufferSize);
-				totalBufferSize += currentBufferSize;
-				drawCount += lineGroup.second.GetSize();
-			}
-
-			if (s_Verticies.GetSize() > 0)
-			{
-				memcpy(pUniformMapping + totalBufferSize, s_Verticies.GetData(), s_Verticies.GetSize() * sizeof(VertexData));
-				totalBufferSize += s_Verticies.GetSize() * sizeof(VertexData);
-				drawCount += s_Verticies.GetSize();
-			}
+			const uint64 offsetInBytes	= uint64(dirtyOffset) * sizeof(VertexData);
+			const uint64 sizeInBytes	= uint64(dirtyCount) * sizeof(VertexData);
 
+			TSharedRef<Buffer> uniformCopyBuffer = m_UniformCopyBuffers[modFrameIndex];
+			byte* pUniformMapping = reinterpret_cast<byte*>(uniformCopyBuffer->Map());
+			memcpy(pUniformMapping + offsetInBytes, &s_LineBatch.GetVertices()[dirtyOffset], sizeInBytes);
 			uniformCopyBuffer->Unmap();
-			pCommandList->CopyBuffer(uniformCopyBuffer.Get(), 0, m_UniformBuffer.Get(), 0, totalBufferSize);
+
+			pCommandList->CopyBuffer(uniformCopyBuffer.Get(), offsetInBytes, m_UniformBuffer.Get(), offsetInBytes, sizeInBytes);
 		}
+		s_LineBatch.ClearDirtyRange();
 
 		pCommandList->BeginRenderPass(&beginRenderPassDesc);
 
@@ -462,11 +402,14 @@ namespace LambdaEngine
 
 		pCommandList->BindDescriptorSetGraphics(m_DescriptorSet.Get(), m_PipelineLayout.Get(), 1);
 
-		pCommandList->DrawInstanced(drawCount, drawCount, 0, 0);
+		pCommandList->DrawInstanced(drawCount, 1, 0, 0);
 
 		pCommandList->EndRenderPass();
 		pCommandList->End();
 
+		// Lines that expire are removed after being drawn, so lines with no lifetime are drawn once
+		s_LineBatch.Tick(EngineLoop::GetTimeSinceStart().AsSeconds());
+
 		(*ppFirstExecutionStage) = pCommandList;
 	}
 
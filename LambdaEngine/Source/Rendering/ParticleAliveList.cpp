@@ -0,0 +1,97 @@
+#include "Rendering/ParticleAliveList.h"
+
+#include "Math/MathUtilities.h"
+
+namespace LambdaEngine
+{
+	void ParticleAliveList::Init(uint32 maxParticleCount)
+	{
+		m_Indices.Clear();
+		m_Indices.Reserve(maxParticleCount);
+		m_Positions.Clear();
+		m_Positions.Resize(maxParticleCount, INVALID_POSITION);
+		ClearDirtyRange();
+	}
+
+	void ParticleAliveList::Clear()
+	{
+		for (uint32 particleIndex : m_Indices)
+		{
+			m_Positions[particleIndex] = INVALID_POSITION;
+		}
+
+		m_Indices.Clear();
+		ClearDirtyRange();
+	}
+
+	void ParticleAliveList::AddRange(uint32 firstParticle, uint32 particleCount)
+	{
+		VALIDATE(firstParticle + particleCount <= m_Positions.GetSize());
+
+		const uint32 firstPosition = m_Indices.GetSize();
+		for (uint32 particleIndex = firstParticle; particleIndex < firstParticle + particleCount; particleIndex++)
+		{
+			VALIDATE(m_Positions[particleIndex] == INVALID_POSITION);
+
+			m_Positions[particleIndex] = m_Indices.GetSize();
+			m_Indices.PushBack(particleIndex);
+		}
+
+		if (particleCount > 0)
+		{
+			MarkDirty(firstPosition);
+			MarkDirty(m_Indices.GetSize() - 1);
+		}
+	}
+
+	void ParticleAliveList::RemoveRange(uint32 firstParticle, uint32 particleCount)
+	{
+		VALIDATE(firstParticle + particleCount <= m_Positions.GetSize());
+
+		for (uint32 particleIndex = firstParticle; particleIndex < firstParticle + particleCount; particleIndex++)
+		{
+			const uint32 position = m_Positions[particleIndex];
+			if (position == INVALID_POSITION)
+			{
+				continue;
+			}
+
+			// Move the last entry into the hole, entries at the end are dropped by the size and need no upload
+			const uint32 lastParticleIndex = m_Indices.GetBack();
+			m_Indices[position]				= lastParticleIndex;
+			m_Positions[lastParticleIndex]	= position;
+			m_Positions[particleIndex]		= INVALID_POSITION;
+			m_Indices.PopBack();
+
+			if (position < m_Indices.GetSize())
+			{
+				MarkDirty(position);
+			}
+		}
+	}
+
+	bool ParticleAliveList::GetDirtyRange(uint32& offset, uint32& count) const
+	{
+		const uint32 dirtyEnd = glm::min(m_DirtyEnd, m_Indices.GetSize());
+		if (m_DirtyBegin >= dirtyEnd)
+		{
+			return false;
+		}
+
+		offset	= m_DirtyBegin;
+		count	= dirtyEnd - m_DirtyBegin;
+		return true;
+	}
+
+	void ParticleAliveList::ClearDirtyRange()
+	{
+		m_DirtyBegin	= UINT32_MAX;
+		m_DirtyEnd		= 0;
+	}
+
+	void ParticleAliveList::MarkDirty(uint32 position)
+	{
+		m_DirtyBegin	= glm::min(m_DirtyBegin, position);
+		m_DirtyEnd		= glm::max(m_DirtyEnd, position + 1);
+	}
+}
@@ -11,34 +11,38 @@
 #include "Rendering/RenderGraph.h"
 #include "Rendering/RenderAPI.h"
 
+#include "Game/ECS/Systems/Rendering/RenderSystem.h"
+
 #include "Math/Random.h"
 
 namespace LambdaEngine
 {
-	void ParticleManager::Init(uint32 maxParticleCapacity, ASBuilder* pASBuilder)
+	void ParticleManager::Init(uint32 maxParticleCapacity, ASBuilder* pASBuilder, bool simulateOnCPU)
 	{
 		if (!m_Initialized)
 		{
 			m_MaxParticleCount = maxParticleCapacity;
+			m_SimulateOnCPU = simulateOnCPU;
 			m_Particles.Reserve(m_MaxParticleCount);
-			m_AliveIndices.Reserve(m_MaxParticleCount);
 			m_ParticleIndexData.Reserve(m_MaxParticleCount);
+			m_AliveParticles.Init(m_MaxParticleCount);
+
+			// Particle chunks are sub-allocated from the whole particle array, one unit per particle
+			m_ParticleChunkAllocator.Init(m_MaxParticleCount);
 
-			constexpr uint32 chunkReservationSize = 10;
-			m_FreeParticleChunks.Reserve(chunkReservationSize);
+			if (m_SimulateOnCPU)
+			{
+				m_CPUSimulator.Init(m_MaxParticleCount);
+
+				// The collision pass only runs with inline ray tracing, without it there is nothing to read back
+				m_ReadBackCollisions = RenderSystem::GetInstance().IsInlineRayTracingEnabled();
+			}
 
 			// Initilize Default Particle Texture
 			m_DefaultAtlasTextureGUID = ResourceManager::LoadTextureFromFile("Particles/ParticleAtlas.png", EFormat::FORMAT_R8G8B8A8_UNORM, true, true);
 			constexpr uint32 DEFAULT_ATLAS_TILE_SIZE = 64U;
 			CreateAtlasTextureInstance(m_DefaultAtlasTextureGUID, DEFAULT_ATLAS_TILE_SIZE);
 
-			// Create one particle chunk spanning the whole particle array
-			ParticleChunk chunk = {};
-			chunk.Offset = 0;
-			chunk.Size = m_MaxParticleCount;
-
-			m_FreeParticleChunks.PushBack(chunk);
-
 			BufferDesc bufferDesc = {};
 			bufferDesc.MemoryType	= EMemoryType::MEMORY_TYPE_GPU;
 			bufferDesc.Flags		= FBufferFlag::BUFFER_FLAG_COPY_DST | FBufferFlag::BUFFER_FLAG_UNORDERED_ACCESS_BUFFER;
@@ -128,6 +132,7 @@ namespace LambdaEngine
 			SAFERELEASE(m_ppTransformStagingBuffer[b]);
 			SAFERELEASE(m_ppIndirectStagingBuffer[b]);
 			SAFERELEASE(m_ppAtlasDataStagingBuffer[b]);
+			SAFERELEASE(m_ppParticleReadBackBuffers[b]);
 		}
 
 		SAFERELEASE(m_pIndirectBuffer);
@@ -147,6 +152,13 @@ namespace LambdaEngine
 	void ParticleManager::Tick(Timestamp deltaTime, uint64 modFrameIndex)
 	{
 		m_ModFrameIndex = modFrameIndex;
+		m_DeltaTime = float32(deltaTime.AsSeconds());
+
+		// The output of the compared frame was read back into this slot BACK_BUFFER_COUNT frames ago, so both copies have completed
+		if (m_CPUComparison.State == ECPUComparisonState::WAITING && m_CPUComparison.OutputSlot == m_ModFrameIndex)
+		{
+			CompareCPUSimulation();
+		}
 
 		constexpr float EPSILON = 0.01f;
 
@@ -168,6 +180,16 @@ namespace LambdaEngine
 			}
 			i++;
 		}
+
+		if (m_SimulateOnCPU)
+		{
+			SimulateOnCPU(float32(deltaTime.AsSeconds()));
+		}
+		else if (m_AliveParticles.GetSize() > 0)
+		{
+			// ParticleUpdater writes the particle instances directly in the instance buffer
+			m_pASBuilder->MarkInstancesWrittenOnGPU();
+		}
 	}
 
 	void ParticleManager::UpdateParticleEmitter(Entity entity, const PositionComponent& positionComp, const RotationComponent& rotationComp, const ParticleEmitterComponent& emitterComp)
@@ -355,21 +377,6 @@ namespace LambdaEngine
 
 	}
 
-	void ParticleManager::UpdateAliveParticles()
-	{
-		m_AliveIndices.Clear();
-		for (const auto& indirect : m_IndirectData)
-		{
-			uint32 offset = indirect.FirstInstance;
-			uint32 size = indirect.InstanceCount;
-			for (uint32 particleIndex = offset; particleIndex < offset+size; particleIndex++)
-			{
-				m_AliveIndices.PushBack(particleIndex);
-			}
-		}
-		m_DirtyAliveBuffer = true;
-	}
-
 	bool ParticleManager::CreateConeParticleEmitter(EmitterID emitterID)
 	{
 		auto& emitterInstance = m_Emitters[emitterID];
@@ -799,12 +806,20 @@ namespace LambdaEngine
 
 		if (emitterInstance.ParticleChunk.Size > 0)
 		{
-			if (!AllocateParticleChunk(emitterInstance.ParticleChunk))
+			if (!AllocateParticleChunk(emitterInstance))
 			{
-				LOG_ERROR("[ParticleManager]: Failed to allocate Emitter Particles. Max particle capacity of %u exceeded!", m_Particles.GetSize());
+				LOG_ERROR("[ParticleManager]: Failed to allocate Emitter Particles. Max particle capacity of %u exceeded!", m_MaxParticleCount);
 				return false;
 			}
 
+			// Chunks can be placed anywhere in the particle array, so it has to cover the whole chunk before particles are written
+			const uint32 chunkEnd = emitterInstance.ParticleChunk.Offset + emitterInstance.ParticleChunk.Size;
+			if (m_Particles.GetSize() < chunkEnd)
+			{
+				m_Particles.Resize(chunkEnd);
+				m_ParticleIndexData.Resize(chunkEnd);
+			}
+
 			if (emitterComp.EmitterShape == EEmitterShape::CONE)
 			{
 				CreateConeParticleEmitter(emitterID);
@@ -822,6 +837,12 @@ namespace LambdaEngine
 				CreatePlaneParticleEmitter(emitterID);
 			}
 
+			if (m_SimulateOnCPU)
+			{
+				const ParticleChunk& particleChunk = emitterInstance.ParticleChunk;
+				m_CPUSimulator.LoadParticles(&m_Particles[particleChunk.Offset], particleChunk.Offset, particleChunk.Size);
+			}
+
 			// Add particle chunk to dirty list
 			m_DirtyParticleChunks.PushBack(emitterInstance.ParticleChunk);
 
@@ -835,7 +856,7 @@ namespace LambdaEngine
 			m_IndirectData.PushBack(indirectData);
 
 			// Update alive particles buffer
-			UpdateAliveParticles();
+			m_AliveParticles.AddRange(indirectData.FirstInstance, indirectData.InstanceCount);
 
 			// Create EmitterData
 			SEmitter emitterData = {};
@@ -894,6 +915,9 @@ namespace LambdaEngine
 					m_ParticleIndexData[offset + i].ASInstanceIndirectIndex = UINT32_MAX;
 					m_pASBuilder->RemoveInstance(instanceIndirectIndex);
 				}
+
+				// Update alive particles buffer
+				m_AliveParticles.RemoveRange(offset, size);
 			}
 
 			// Replace the removed emitters data with the last emitters data
@@ -913,7 +937,7 @@ namespace LambdaEngine
 				// Add particle chunk to dirty list
 				m_DirtyParticleChunks.PushBack(ParticleChunk{.Offset = offset, .Size = size});
 			}
-			FreeParticleChunk(emitterInstance.ParticleChunk);
+			FreeParticleChunk(emitterInstance);
 
 			// Replace removed emitter with last emitter
 			ReplaceRemovedEmitterWithLast(removeIndex);
@@ -922,9 +946,6 @@ namespace LambdaEngine
 			m_EmitterData.PopBack();
 			m_EmitterTransformData.PopBack();
 
-			// Update alive particles buffer
-			UpdateAliveParticles();
-			
 			m_DirtyTransformBuffer = true;
 			m_DirtyEmitterBuffer = true;
 			m_DirtyIndirectBuffer = true;
@@ -939,114 +960,277 @@ namespace LambdaEngine
 		return true;
 	}
 
-	bool ParticleManager::AllocateParticleChunk(ParticleChunk& chunk)
+	bool ParticleManager::AllocateParticleChunk(ParticleEmitterInstance& emitterInstance)
 	{
+		ParticleChunk& chunk = emitterInstance.ParticleChunk;
+
 		// TODO: Handle override max capacity particle request
-		if (m_FreeParticleChunks.IsEmpty())
+		OffsetAllocation& allocation = emitterInstance.ParticleAllocation;
+		if (!m_ParticleChunkAllocator.Allocate(chunk.Size, 1, allocation))
 			return false;
 
-		// Assign fitting chunk to emitter
-		bool foundChunk = false;
+		chunk.Offset = uint32(allocation.Offset);
 
-		for (uint32 i = 0; i < m_FreeParticleChunks.GetSize(); i++)
-		{
-			ParticleChunk& freeChunk = m_FreeParticleChunks[i];
-			ParticleChunk& emitterChunk = chunk;
+#if DEBUG_PARTICLE
+		LOG_INFO("[ParticleManager]: Allocated Chunk[offset: %u, size: %u]", chunk.Offset, chunk.Size);
+#endif
 
-			if (emitterChunk.Size <= freeChunk.Size)
-			{
-				emitterChunk.Offset = freeChunk.Offset;
+		return true;
+	}
 
-				uint32 diff = freeChunk.Size - emitterChunk.Size;
-				if (diff == 0)
-				{
-					m_FreeParticleChunks.Erase(m_FreeParticleChunks.Begin() + i);
-				}
-				else
-				{
-					freeChunk.Offset += emitterChunk.Size;
-					freeChunk.Size -= emitterChunk.Size;
-				}
+	void ParticleManager::FreeParticleChunk(ParticleEmitterInstance& emitterInstance)
+	{
+		OffsetAllocation& allocation = emitterInstance.ParticleAllocation;
+		if (!allocation.IsValid())
+			return;
 
-				foundChunk = true;
-				break;
-			}
-		}
+#if DEBUG_PARTICLE
+		LOG_INFO("[ParticleManager]: Freed Chunk: [offset: %llu, size : %llu]", allocation.Offset, allocation.SizeInBytes);
+#endif
 
-		// TODO: Handle override max capacity particle request
-		if (!foundChunk)
-			return false;
+		m_ParticleChunkAllocator.Free(allocation);
 
 #if DEBUG_PARTICLE
-		LOG_INFO("[ParticleManager]: Allocated Chunk[offset: %u, size: %u]", chunk.Offset, chunk.Size);
+		const OffsetAllocatorStatistics statistics = m_ParticleChunkAllocator.GetStatistics();
+		LOG_INFO("[ParticleManager]: Free particles: %llu, Free chunks: %u, Largest free chunk: %llu", statistics.FreeBytes, statistics.FreeBlockCount, statistics.LargestFreeBlock);
 #endif
+	}
 
-		return true;
+	void ParticleManager::SimulateOnCPU(float32 deltaTime)
+	{
+		const uint32 emitterCount = m_IndirectData.GetSize();
+		if (emitterCount == 0)
+		{
+			return;
+		}
+
+		if (m_ReadBackCollisions)
+		{
+			ApplyCollisionReadBack();
+		}
+
+		m_CPUSimulator.Simulate(deltaTime, m_IndirectData.GetData(), m_EmitterData.GetData(), m_EmitterTransformData.GetData(), emitterCount);
+
+		// The particle buffer is only written from here when simulating on the CPU, so every chunk is uploaded each frame
+		for (uint32 e = 0; e < emitterCount; e++)
+		{
+			const IndirectData& indirectData = m_IndirectData[e];
+			const SEmitter& emitterData = m_EmitterData[e];
+			m_CPUSimulator.StoreParticles(&m_Particles[indirectData.FirstInstance], indirectData.FirstInstance, indirectData.InstanceCount);
+			m_DirtyParticleChunks.PushBack(ParticleChunk{ .Offset = indirectData.FirstInstance, .Size = indirectData.InstanceCount });
+
+			// Same instance transform as UpdateParticleTransform in ParticleUpdate.comp
+			for (uint32 p = indirectData.FirstInstance; p < indirectData.FirstInstance + indirectData.InstanceCount; p++)
+			{
+				const SParticle& particle = m_Particles[p];
+				const float32 scale = glm::mix(particle.EndRadius, particle.BeginRadius, glm::max(particle.CurrentLife / emitterData.LifeTime, 0.0f));
+				const glm::mat4 transform =
+					glm::translate(glm::vec3(particle.Transform[3])) *
+					glm::rotate(glm::half_pi<float32>() * float32(p % 2), g_DefaultUp) *
+					glm::scale(glm::vec3(scale));
+
+				m_pASBuilder->UpdateInstanceTransform(m_ParticleIndexData[p].ASInstanceIndirectIndex, transform);
+			}
+		}
+
+		m_DirtyParticleBuffer = true;
 	}
 
-	bool ParticleManager::FreeParticleChunk(ParticleChunk chunk)
+	void ParticleManager::ReadBackParticleBuffer(CommandList* pCommandList, uint32 particleCount)
 	{
-		// Find if freed particle chunk can be merged with existing one
-		bool inserted = false;
+		particleCount = glm::min<uint32>(particleCount, uint32(m_pParticleBuffer->GetDesc().SizeInBytes / sizeof(SParticle)));
+		m_ReadBackParticleCounts[m_ModFrameIndex] = particleCount;
+		if (particleCount == 0)
+		{
+			return;
+		}
+
+		const uint64 sizeInBytes = uint64(particleCount) * sizeof(SParticle);
 
-		inserted = MergeParticleChunk(chunk);
+		Buffer*& pReadBackBuffer = m_ppParticleReadBackBuffers[m_ModFrameIndex];
+		if (pReadBackBuffer == nullptr || pReadBackBuffer->GetDesc().SizeInBytes < sizeInBytes)
+		{
+			if (pReadBackBuffer != nullptr) m_ResourcesToRemove[m_ModFrameIndex].PushBack(pReadBackBuffer);
+
+			BufferDesc bufferDesc = {};
+			bufferDesc.DebugName	= "Particle Instances Read Back Buffer";
+			bufferDesc.MemoryType	= EMemoryType::MEMORY_TYPE_CPU_VISIBLE;
+			bufferDesc.Flags		= FBufferFlag::BUFFER_FLAG_COPY_DST;
+			bufferDesc.SizeInBytes	= sizeInBytes;
+
+			pReadBackBuffer = RenderAPI::GetDevice()->CreateBuffer(&bufferDesc);
+		}
+
+		// Recorded before the uploads of this frame, so the copy holds the particles as the previous frame left them
+		pCommandList->CopyBuffer(m_pParticleBuffer, 0, pReadBackBuffer, 0, sizeInBytes);
+
+		PipelineMemoryBarrierDesc memoryBarrier = {};
+		memoryBarrier.SrcMemoryAccessFlags = FMemoryAccessFlag::MEMORY_ACCESS_FLAG_TRANSFER_WRITE;
+		memoryBarrier.DstMemoryAccessFlags = FMemoryAccessFlag::MEMORY_ACCESS_FLAG_TRANSFER_WRITE | FMemoryAccessFlag::MEMORY_ACCESS_FLAG_HOST_READ;
+		pCommandList->PipelineMemoryBarriers(
+			FPipelineStageFlag::PIPELINE_STAGE_FLAG_COPY,
+			FPipelineStageFlag::PIPELINE_STAGE_FLAG_COPY | FPipelineStageFlag::PIPELINE_STAGE_FLAG_HOST,
+			&memoryBarrier,
+			1);
+	}
+
+	void ParticleManager::ApplyCollisionReadBack()
+	{
+		const uint32 readBackCount = m_ReadBackParticleCounts[m_ModFrameIndex];
+		if (readBackCount == 0)
+		{
+			return;
+		}
 
-		// If merge was not possible insert at proper offset location
-		for (auto chunkIt = m_FreeParticleChunks.begin(); chunkIt != m_FreeParticleChunks.end() && !inserted; chunkIt++)
+		// Chunks that were freed or reallocated since the copy are rejected by the particle generations
+		Buffer* pReadBackBuffer = m_ppParticleReadBackBuffers[m_ModFrameIndex];
+		const SParticle* pReadBackParticles = reinterpret_cast<const SParticle*>(pReadBackBuffer->Map());
+		for (const IndirectData& indirectData : m_IndirectData)
 		{
-			if (chunk.Offset > chunkIt->Offset)
+			if (indirectData.FirstInstance < readBackCount)
 			{
-				m_FreeParticleChunks.Insert(chunkIt, chunk);
-				inserted = true;
+				const uint32 particleCount = glm::min(indirectData.InstanceCount, readBackCount - indirectData.FirstInstance);
+				m_CPUSimulator.ApplyCollisions(&pReadBackParticles[indirectData.FirstInstance], indirectData.FirstInstance, particleCount);
 			}
 		}
 
-		// If free chunk has not been inserted yet beginning should be the proper insertion
-		if (!inserted) {
-			m_FreeParticleChunks.Insert(m_FreeParticleChunks.begin(), chunk);
-			inserted = true;
+		pReadBackBuffer->Unmap();
+		m_ReadBackParticleCounts[m_ModFrameIndex] = 0;
+	}
+
+	void ParticleManager::RequestCPUComparison()
+	{
+		const bool isComparing = m_CPUComparison.State != ECPUComparisonState::IDLE && m_CPUComparison.State != ECPUComparisonState::DONE;
+		if (!m_SimulateOnCPU && !isComparing)
+		{
+			m_CPUComparison.State = ECPUComparisonState::REQUESTED;
 		}
+	}
 
-#if DEBUG_PARTICLE
-		LOG_INFO("[ParticleManager]: Freed Chunk: [offset: %u, size : %u]", chunk.Offset, chunk.Size);
-		LOG_INFO("[ParticleManager]: Current Free Chunks:");
-		for (uint32 i = 0; i < m_FreeParticleChunks.GetSize(); i++)
+	void ParticleManager::CaptureCPUComparison(CommandList* pCommandList)
+	{
+		CPUComparison& comparison = m_CPUComparison;
+		if (comparison.State == ECPUComparisonState::REQUESTED)
 		{
-			LOG_INFO("\tFree chunk%u - [offset: %u, size : %u] ", i, m_FreeParticleChunks[i].Offset, m_FreeParticleChunks[i].Size);
+			// Newly uploaded particles would not be part of the input, so the first frame without uploads is compared
+			if (m_AliveParticles.GetSize() == 0 || !m_DirtyParticleChunks.IsEmpty())
+			{
+				return;
+			}
+
+			uint32 particleCount = 0;
+			for (const IndirectData& indirectData : m_IndirectData)
+			{
+				particleCount = glm::max(particleCount, indirectData.FirstInstance + indirectData.InstanceCount);
+			}
+
+			ReadBackParticleBuffer(pCommandList, particleCount);
+			if (m_ReadBackParticleCounts[m_ModFrameIndex] != particleCount)
+			{
+				m_ReadBackParticleCounts[m_ModFrameIndex] = 0;
+				return;
+			}
+
+			// The emitter buffers are uploaded from the same data later this frame
+			comparison.State		= ECPUComparisonState::CAPTURE_OUTPUT;
+			comparison.InputSlot	= m_ModFrameIndex;
+			comparison.DeltaTime	= m_DeltaTime;
+			comparison.Chunks		= m_IndirectData;
+			comparison.Emitters		= m_EmitterData;
+			comparison.Transforms	= m_EmitterTransformData;
+		}
+		else if (comparison.State == ECPUComparisonState::CAPTURE_OUTPUT)
+		{
+			const uint32 particleCount = m_ReadBackParticleCounts[comparison.InputSlot];
+			ReadBackParticleBuffer(pCommandList, particleCount);
+
+			comparison.State		= ECPUComparisonState::WAITING;
+			comparison.OutputSlot	= m_ModFrameIndex;
 		}
-#endif
-		return inserted;
 	}
 
-	bool ParticleManager::MergeParticleChunk(const ParticleChunk& chunk)
+	void ParticleManager::CompareCPUSimulation()
 	{
-		bool inserted = false;
-		for (auto chunkIt = m_FreeParticleChunks.begin(); chunkIt != m_FreeParticleChunks.end() && !inserted; chunkIt++)
+		CPUComparison& comparison = m_CPUComparison;
+		comparison.State			= ECPUComparisonState::DONE;
+		comparison.MismatchCount	= 0;
+
+		if (!m_CPUSimulator.IsInitialized())
 		{
-			if (chunk.Offset + chunk.Size == chunkIt->Offset)
+			m_CPUSimulator.Init(m_MaxParticleCount);
+		}
+
+		m_ReadBackParticleCounts[comparison.InputSlot]	= 0;
+		m_ReadBackParticleCounts[comparison.OutputSlot]	= 0;
+
+		Buffer* pInputBuffer	= m_ppParticleReadBackBuffers[comparison.InputSlot];
+		Buffer* pOutputBuffer	= m_ppParticleReadBackBuffers[comparison.OutputSlot];
+		const SParticle* pInputParticles	= reinterpret_cast<const SParticle*>(pInputBuffer->Map());
+		const SParticle* pOutputParticles	= reinterpret_cast<const SParticle*>(pOutputBuffer->Map());
+
+		uint32 comparedCount = 0;
+		for (const IndirectData& chunk : comparison.Chunks)
+		{
+			m_CPUSimulator.LoadParticles(&pInputParticles[chunk.FirstInstance], chunk.FirstInstance, chunk.InstanceCount);
+		}
+
+		m_CPUSimulator.Simulate(comparison.DeltaTime, comparison.Chunks.GetData(), comparison.Emitters.GetData(), comparison.Transforms.GetData(), comparison.Chunks.GetSize());
+
+		auto isNear = [](float32 cpuValue, float32 gpuValue)
+		{
+			return glm::abs(cpuValue - gpuValue) <= 1.0e-3f * glm::max(1.0f, glm::abs(gpuValue));
+		};
+
+		using Simulator = ParticleSimulatorCPU;
+		for (const IndirectData& chunk : comparison.Chunks)
+		{
+			for (uint32 p = chunk.FirstInstance; p < chunk.FirstInstance + chunk.InstanceCount; p++)
 			{
-				chunkIt->Offset -= chunk.Size;
-				chunkIt->Size += chunk.Size;
-				// If merge successful remove from chunk
-				if (MergeParticleChunk(*chunkIt))
+				const SParticle& gpuParticle = pOutputParticles[p];
+
+				bool matches =
+					isNear(m_CPUSimulator.GetStreamValue(Simulator::STREAM_CURRENT_LIFE, p), gpuParticle.CurrentLife) &&
+					(m_CPUSimulator.GetStreamValue(Simulator::STREAM_WAS_CREATED, p) > 0.5f) == gpuParticle.WasCreated &&
+					m_CPUSimulator.GetTileIndex(p) == gpuParticle.TileIndex;
+
+				// The collision pass owns the position and velocity of stopped particles, it runs after the update pass on the GPU only
+				if (gpuParticle.ShouldStop < 0.5f)
 				{
-					m_FreeParticleChunks.Erase(chunkIt);
+					matches = matches &&
+						m_CPUSimulator.GetStreamValue(Simulator::STREAM_SHOULD_STOP, p) < 0.5f &&
+						isNear(m_CPUSimulator.GetStreamValue(Simulator::STREAM_POSITION_X, p), gpuParticle.Transform[3].x) &&
+						isNear(m_CPUSimulator.GetStreamValue(Simulator::STREAM_POSITION_Y, p), gpuParticle.Transform[3].y) &&
+						isNear(m_CPUSimulator.GetStreamValue(Simulator::STREAM_POSITION_Z, p), gpuParticle.Transform[3].z) &&
+						isNear(m_CPUSimulator.GetStreamValue(Simulator::STREAM_VELOCITY_X, p), gpuParticle.Velocity.x) &&
+						isNear(m_CPUSimulator.GetStreamValue(Simulator::STREAM_VELOCITY_Y, p), gpuParticle.Velocity.y) &&
+						isNear(m_CPUSimulator.GetStreamValue(Simulator::STREAM_VELOCITY_Z, p), gpuParticle.Velocity.z);
 				}
-				inserted = true;
-			}
-			else if (chunkIt->Offset + chunkIt->Size == chunk.Offset)
-			{
-				chunkIt->Size += chunk.Size;
-				// If merge successful remove from chunk
-				if (MergeParticleChunk(*chunkIt))
+
+				if (!matches)
 				{
-					m_FreeParticleChunks.Erase(chunkIt);
+					comparison.MismatchCount++;
 				}
-				inserted = true;
+
+				comparedCount++;
 			}
 		}
 
-		return inserted;
+		pInputBuffer->Unmap();
+		pOutputBuffer->Unmap();
+
+		// The simulator only holds the compared frame, particles are loaded again the next time it is used
+		comparison.Chunks.Clear();
+		comparison.Emitters.Clear();
+		comparison.Transforms.Clear();
+
+		if (comparison.MismatchCount > 0)
+		{
+			LOG_WARNING("[ParticleManager]: CPU simulation differs from the GPU in %u of %u particles", comparison.MismatchCount, comparedCount);
+		}
+		else
+		{
+			LOG_INFO("[ParticleManager]: CPU simulation matches the GPU in all %u particles", comparedCount);
+		}
 	}
 
 	void ParticleManager::CleanBuffers()
@@ -1064,6 +1248,19 @@ namespace LambdaEngine
 	{
 		CleanBuffers();
 
+		// Read back before anything is uploaded, the particle buffer still holds the result of the previous frame
+		if (m_CreatedDummyBuffer)
+		{
+			if (m_ReadBackCollisions)
+			{
+				ReadBackParticleBuffer(pCommandList, m_Particles.GetSize());
+			}
+			else
+			{
+				CaptureCPUComparison(pCommandList);
+			}
+		}
+
 		// Update Vertex Buffer
 		if (m_DirtyVertexBuffer)
 		{
@@ -1179,22 +1376,24 @@ namespace LambdaEngine
 			}
 		}
 
-		// Update Emitter Instance Buffer
-		if (m_DirtyAliveBuffer && m_CreatedDummyBuffer)
+		// Update Alive Buffer, only the part of the list that changed is uploaded
+		uint32 aliveOffset = 0;
+		uint32 aliveElementCount = 0;
+		if (m_CreatedDummyBuffer && m_AliveParticles.GetDirtyRange(aliveOffset, aliveElementCount))
 		{
-			uint32 offset = 0;
-			uint32 elementCount = m_AliveIndices.GetSize();
 			m_DirtyAliveBuffer = CopyDataToBuffer(
 				pCommandList,
-				m_AliveIndices.GetData(),
-				&offset,
-				&elementCount,
+				(void*)m_AliveParticles.GetIndices().GetData(),
+				&aliveOffset,
+				&aliveElementCount,
 				1U,
 				sizeof(uint32),
 				m_ppAliveStagingBuffer,
 				&m_pAliveBuffer,
 				FBufferFlag::BUFFER_FLAG_UNORDERED_ACCESS_BUFFER,
 				"Alive indices");
+
+			m_AliveParticles.ClearDirtyRange();
 		}
 
 		// Update Emitter Instance Buffer
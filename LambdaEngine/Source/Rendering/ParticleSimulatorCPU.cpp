@@ -0,0 +1,355 @@
+#include "Rendering/ParticleSimulatorCPU.h"
+#include "Rendering/ParticleManager.h"
+
+#include "Threading/API/ThreadPool.h"
+
+#include <immintrin.h>
+
+namespace LambdaEngine
+{
+	/*
+	* Thin wrappers so the kernel is written once for both SSE and AVX
+	*/
+#if defined(__AVX__)
+	using SIMDFloat = __m256;
+	constexpr const uint32 SIMD_WIDTH = 8;
+
+	FORCEINLINE SIMDFloat SIMDLoad(const float32* pSrc)						{ return _mm256_loadu_ps(pSrc); }
+	FORCEINLINE void SIMDStore(float32* pDst, SIMDFloat value)				{ _mm256_storeu_ps(pDst, value); }
+	FORCEINLINE SIMDFloat SIMDSet(float32 value)							{ return _mm256_set1_ps(value); }
+	FORCEINLINE SIMDFloat SIMDAdd(SIMDFloat lhs, SIMDFloat rhs)				{ return _mm256_add_ps(lhs, rhs); }
+	FORCEINLINE SIMDFloat SIMDSub(SIMDFloat lhs, SIMDFloat rhs)				{ return _mm256_sub_ps(lhs, rhs); }
+	FORCEINLINE SIMDFloat SIMDMul(SIMDFloat lhs, SIMDFloat rhs)				{ return _mm256_mul_ps(lhs, rhs); }
+	FORCEINLINE SIMDFloat SIMDDiv(SIMDFloat lhs, SIMDFloat rhs)				{ return _mm256_div_ps(lhs, rhs); }
+	FORCEINLINE SIMDFloat SIMDGreater(SIMDFloat lhs, SIMDFloat rhs)			{ return _mm256_cmp_ps(lhs, rhs, _CMP_GT_OQ); }
+	FORCEINLINE SIMDFloat SIMDLess(SIMDFloat lhs, SIMDFloat rhs)			{ return _mm256_cmp_ps(lhs, rhs, _CMP_LT_OQ); }
+	FORCEINLINE SIMDFloat SIMDAnd(SIMDFloat lhs, SIMDFloat rhs)				{ return _mm256_and_ps(lhs, rhs); }
+	FORCEINLINE SIMDFloat SIMDSelect(SIMDFloat mask, SIMDFloat a, SIMDFloat b)	{ return _mm256_blendv_ps(b, a, mask); }
+	FORCEINLINE SIMDFloat SIMDTruncate(SIMDFloat value)						{ return _mm256_round_ps(value, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC); }
+	FORCEINLINE SIMDFloat SIMDAbs(SIMDFloat value)							{ return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), value); }
+	FORCEINLINE uint32 SIMDMoveMask(SIMDFloat mask)							{ return uint32(_mm256_movemask_ps(mask)); }
+#else
+	using SIMDFloat = __m128;
+	constexpr const uint32 SIMD_WIDTH = 4;
+
+	FORCEINLINE SIMDFloat SIMDLoad(const float32* pSrc)						{ return _mm_loadu_ps(pSrc); }
+	FORCEINLINE void SIMDStore(float32* pDst, SIMDFloat value)				{ _mm_storeu_ps(pDst, value); }
+	FORCEINLINE SIMDFloat SIMDSet(float32 value)							{ return _mm_set1_ps(value); }
+	FORCEINLINE SIMDFloat SIMDAdd(SIMDFloat lhs, SIMDFloat rhs)				{ return _mm_add_ps(lhs, rhs); }
+	FORCEINLINE SIMDFloat SIMDSub(SIMDFloat lhs, SIMDFloat rhs)				{ return _mm_sub_ps(lhs, rhs); }
+	FORCEINLINE SIMDFloat SIMDMul(SIMDFloat lhs, SIMDFloat rhs)				{ return _mm_mul_ps(lhs, rhs); }
+	FORCEINLINE SIMDFloat SIMDDiv(SIMDFloat lhs, SIMDFloat rhs)				{ return _mm_div_ps(lhs, rhs); }
+	FORCEINLINE SIMDFloat SIMDGreater(SIMDFloat lhs, SIMDFloat rhs)			{ return _mm_cmpgt_ps(lhs, rhs); }
+	FORCEINLINE SIMDFloat SIMDLess(SIMDFloat lhs, SIMDFloat rhs)			{ return _mm_cmplt_ps(lhs, rhs); }
+	FORCEINLINE SIMDFloat SIMDAnd(SIMDFloat lhs, SIMDFloat rhs)				{ return _mm_and_ps(lhs, rhs); }
+	FORCEINLINE SIMDFloat SIMDSelect(SIMDFloat mask, SIMDFloat a, SIMDFloat b)	{ return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+	FORCEINLINE SIMDFloat SIMDTruncate(SIMDFloat value)						{ return _mm_cvtepi32_ps(_mm_cvttps_epi32(value)); }
+	FORCEINLINE SIMDFloat SIMDAbs(SIMDFloat value)							{ return _mm_andnot_ps(_mm_set1_ps(-0.0f), value); }
+	FORCEINLINE uint32 SIMDMoveMask(SIMDFloat mask)							{ return uint32(_mm_movemask_ps(mask)); }
+#endif
+
+	struct SIMDVec3
+	{
+		SIMDFloat X;
+		SIMDFloat Y;
+		SIMDFloat Z;
+	};
+
+	FORCEINLINE SIMDVec3 SIMDLoadVec3(float32* const* ppStreams, uint32 firstStream, uint32 index)
+	{
+		return { SIMDLoad(ppStreams[firstStream] + index), SIMDLoad(ppStreams[firstStream + 1] + index), SIMDLoad(ppStreams[firstStream + 2] + index) };
+	}
+
+	FORCEINLINE void SIMDStoreVec3(float32* const* ppStreams, uint32 firstStream, uint32 index, const SIMDVec3& value)
+	{
+		SIMDStore(ppStreams[firstStream] + index, value.X);
+		SIMDStore(ppStreams[firstStream + 1] + index, value.Y);
+		SIMDStore(ppStreams[firstStream + 2] + index, value.Z);
+	}
+
+	FORCEINLINE SIMDVec3 SIMDSelectVec3(SIMDFloat mask, const SIMDVec3& a, const SIMDVec3& b)
+	{
+		return { SIMDSelect(mask, a.X, b.X), SIMDSelect(mask, a.Y, b.Y), SIMDSelect(mask, a.Z, b.Z) };
+	}
+
+	// Same as (transform * vec4(v, 0.0f)).xyz
+	FORCEINLINE SIMDVec3 SIMDRotate(const glm::mat4& transform, const SIMDVec3& v)
+	{
+		SIMDVec3 result;
+		result.X = SIMDAdd(SIMDAdd(SIMDMul(SIMDSet(transform[0].x), v.X), SIMDMul(SIMDSet(transform[1].x), v.Y)), SIMDMul(SIMDSet(transform[2].x), v.Z));
+		result.Y = SIMDAdd(SIMDAdd(SIMDMul(SIMDSet(transform[0].y), v.X), SIMDMul(SIMDSet(transform[1].y), v.Y)), SIMDMul(SIMDSet(transform[2].y), v.Z));
+		result.Z = SIMDAdd(SIMDAdd(SIMDMul(SIMDSet(transform[0].z), v.X), SIMDMul(SIMDSet(transform[1].z), v.Y)), SIMDMul(SIMDSet(transform[2].z), v.Z));
+		return result;
+	}
+
+	/*
+	* Simulates SIMD_WIDTH particles starting at index, mirrors main() in ParticleUpdate.comp
+	*/
+	static uint32 SimulateParticles(float32* const* ppStreams, uint32 index, const ParticleSimulatorCPU::EmitterConstants& emitter, float32 deltaTime)
+	{
+		using Simulator = ParticleSimulatorCPU;
+
+		const SIMDFloat zero		= SIMDSet(0.0f);
+		const SIMDFloat one			= SIMDSet(1.0f);
+		const SIMDFloat dt			= SIMDSet(deltaTime);
+		const SIMDFloat lifeTime	= SIMDSet(emitter.LifeTime);
+		const SIMDVec3 emitterPosition = { SIMDSet(emitter.Transform[3].x), SIMDSet(emitter.Transform[3].y), SIMDSet(emitter.Transform[3].z) };
+
+		SIMDVec3 position			= SIMDLoadVec3(ppStreams, Simulator::STREAM_POSITION_X, index);
+		SIMDVec3 velocity			= SIMDLoadVec3(ppStreams, Simulator::STREAM_VELOCITY_X, index);
+		SIMDVec3 acceleration		= SIMDLoadVec3(ppStreams, Simulator::STREAM_ACCELERATION_X, index);
+		const SIMDVec3 startPosition		= SIMDLoadVec3(ppStreams, Simulator::STREAM_START_POSITION_X, index);
+		const SIMDVec3 startVelocity		= SIMDLoadVec3(ppStreams, Simulator::STREAM_START_VELOCITY_X, index);
+		const SIMDVec3 startAcceleration	= SIMDLoadVec3(ppStreams, Simulator::STREAM_START_ACCELERATION_X, index);
+		SIMDFloat currentLife		= SIMDLoad(ppStreams[Simulator::STREAM_CURRENT_LIFE] + index);
+		SIMDFloat shouldStop		= SIMDLoad(ppStreams[Simulator::STREAM_SHOULD_STOP] + index);
+		SIMDFloat wasCreated		= SIMDLoad(ppStreams[Simulator::STREAM_WAS_CREATED] + index);
+
+		// The start state is given in emitter space
+		const SIMDVec3 spawnPosition		= { SIMDAdd(emitterPosition.X, startPosition.X), SIMDAdd(emitterPosition.Y, startPosition.Y), SIMDAdd(emitterPosition.Z, startPosition.Z) };
+		const SIMDVec3 spawnVelocity		= SIMDRotate(emitter.Transform, startVelocity);
+		const SIMDVec3 spawnAcceleration	= SIMDRotate(emitter.Transform, startAcceleration);
+
+		const SIMDFloat createdMask = SIMDGreater(wasCreated, SIMDSet(0.5f));
+		position		= SIMDSelectVec3(createdMask, spawnPosition, position);
+		velocity		= SIMDSelectVec3(createdMask, spawnVelocity, velocity);
+		acceleration	= SIMDSelectVec3(createdMask, spawnAcceleration, acceleration);
+		wasCreated		= zero;
+
+		// Gravity is applied along GLOBAL_DOWN, (0, 1, 0) in the shader
+		velocity.X = SIMDAdd(velocity.X, SIMDMul(acceleration.X, dt));
+		velocity.Y = SIMDAdd(velocity.Y, SIMDMul(SIMDAdd(acceleration.Y, SIMDSet(emitter.Gravity)), dt));
+		velocity.Z = SIMDAdd(velocity.Z, SIMDMul(acceleration.Z, dt));
+
+		const SIMDFloat stoppedMask = SIMDGreater(shouldStop, SIMDSet(0.5f));
+		velocity = SIMDSelectVec3(stoppedMask, { zero, zero, zero }, velocity);
+
+		position.X = SIMDAdd(position.X, SIMDMul(velocity.X, dt));
+		position.Y = SIMDAdd(position.Y, SIMDMul(velocity.Y, dt));
+		position.Z = SIMDAdd(position.Z, SIMDMul(velocity.Z, dt));
+		currentLife = SIMDSub(currentLife, dt);
+
+		// Particles waiting to be spawned are moved out of view
+		const SIMDFloat hiddenMask = SIMDGreater(currentLife, lifeTime);
+		const SIMDFloat outOfReach = SIMDSet(Simulator::OUT_OF_REACH);
+		position	= SIMDSelectVec3(hiddenMask, { outOfReach, outOfReach, outOfReach }, position);
+		wasCreated	= SIMDSelect(hiddenMask, emitter.OneTime ? zero : one, wasCreated);
+
+		// Repeating emitters restart particles that died
+		uint32 respawnMask = 0;
+		if (!emitter.OneTime)
+		{
+			const SIMDFloat deadMask = SIMDLess(currentLife, zero);
+			respawnMask = SIMDMoveMask(deadMask);
+			if (respawnMask != 0)
+			{
+				// GLSL mod(x, y) = x - y * floor(x / y), x is never negative here so truncation equals floor
+				const SIMDFloat age			= SIMDAbs(currentLife);
+				const SIMDFloat extraLife	= SIMDSub(age, SIMDMul(lifeTime, SIMDTruncate(SIMDDiv(age, lifeTime))));
+				currentLife		= SIMDSelect(deadMask, SIMDSub(lifeTime, extraLife), currentLife);
+				position		= SIMDSelectVec3(deadMask, spawnPosition, position);
+				velocity		= SIMDSelectVec3(deadMask, spawnVelocity, velocity);
+				acceleration	= SIMDSelectVec3(deadMask, spawnAcceleration, acceleration);
+				shouldStop		= SIMDSelect(deadMask, zero, shouldStop);
+			}
+		}
+
+		SIMDStoreVec3(ppStreams, Simulator::STREAM_POSITION_X, index, position);
+		SIMDStoreVec3(ppStreams, Simulator::STREAM_VELOCITY_X, index, velocity);
+		SIMDStoreVec3(ppStreams, Simulator::STREAM_ACCELERATION_X, index, acceleration);
+		SIMDStore(ppStreams[Simulator::STREAM_CURRENT_LIFE] + index, currentLife);
+		SIMDStore(ppStreams[Simulator::STREAM_SHOULD_STOP] + index, shouldStop);
+		SIMDStore(ppStreams[Simulator::STREAM_WAS_CREATED] + index, wasCreated);
+
+		return respawnMask;
+	}
+
+	void ParticleSimulatorCPU::Init(uint32 maxParticleCount)
+	{
+		for (TArray<float32>& stream : m_Streams)
+		{
+			stream.Clear();
+			stream.Resize(maxParticleCount, 0.0f);
+		}
+
+		m_TileIndices.Clear();
+		m_TileIndices.Resize(maxParticleCount, 0);
+
+		m_Generations.Clear();
+		m_Generations.Resize(maxParticleCount, 0);
+	}
+
+	void ParticleSimulatorCPU::LoadParticles(const SParticle* pParticles, uint32 firstParticle, uint32 particleCount)
+	{
+		VALIDATE(firstParticle + particleCount <= m_TileIndices.GetSize());
+
+		for (uint32 i = 0; i < particleCount; i++)
+		{
+			const SParticle& particle	= pParticles[i];
+			const uint32 particleIndex	= firstParticle + i;
+
+			m_Streams[STREAM_POSITION_X][particleIndex]				= particle.Transform[3].x;
+			m_Streams[STREAM_POSITION_Y][particleIndex]				= particle.Transform[3].y;
+			m_Streams[STREAM_POSITION_Z][particleIndex]				= particle.Transform[3].z;
+			m_Streams[STREAM_VELOCITY_X][particleIndex]				= particle.Velocity.x;
+			m_Streams[STREAM_VELOCITY_Y][particleIndex]				= particle.Velocity.y;
+			m_Streams[STREAM_VELOCITY_Z][particleIndex]				= particle.Velocity.z;
+			m_Streams[STREAM_ACCELERATION_X][particleIndex]			= particle.Acceleration.x;
+			m_Streams[STREAM_ACCELERATION_Y][particleIndex]			= particle.Acceleration.y;
+			m_Streams[STREAM_ACCELERATION_Z][particleIndex]			= particle.Acceleration.z;
+			m_Streams[STREAM_START_POSITION_X][particleIndex]		= particle.StartPosition.x;
+			m_Streams[STREAM_START_POSITION_Y][particleIndex]		= particle.StartPosition.y;
+			m_Streams[STREAM_START_POSITION_Z][particleIndex]		= particle.StartPosition.z;
+			m_Streams[STREAM_START_VELOCITY_X][particleIndex]		= particle.StartVelocity.x;
+			m_Streams[STREAM_START_VELOCITY_Y][particleIndex]		= particle.StartVelocity.y;
+			m_Streams[STREAM_START_VELOCITY_Z][particleIndex]		= particle.StartVelocity.z;
+			m_Streams[STREAM_START_ACCELERATION_X][particleIndex]	= particle.StartAcceleration.x;
+			m_Streams[STREAM_START_ACCELERATION_Y][particleIndex]	= particle.StartAcceleration.y;
+			m_Streams[STREAM_START_ACCELERATION_Z][particleIndex]	= particle.StartAcceleration.z;
+			m_Streams[STREAM_CURRENT_LIFE][particleIndex]			= particle.CurrentLife;
+			m_Streams[STREAM_SHOULD_STOP][particleIndex]			= particle.ShouldStop;
+			m_Streams[STREAM_WAS_CREATED][particleIndex]			= particle.WasCreated ? 1.0f : 0.0f;
+			m_TileIndices[particleIndex]							= particle.TileIndex;
+			m_Generations[particleIndex]++;
+		}
+	}
+
+	void ParticleSimulatorCPU::StoreParticles(SParticle* pParticles, uint32 firstParticle, uint32 particleCount) const
+	{
+		VALIDATE(firstParticle + particleCount <= m_TileIndices.GetSize());
+
+		for (uint32 i = 0; i < particleCount; i++)
+		{
+			SParticle& particle			= pParticles[i];
+			const uint32 particleIndex	= firstParticle + i;
+
+			particle.Transform[3].x	= m_Streams[STREAM_POSITION_X][particleIndex];
+			particle.Transform[3].y	= m_Streams[STREAM_POSITION_Y][particleIndex];
+			particle.Transform[3].z	= m_Streams[STREAM_POSITION_Z][particleIndex];
+			particle.Velocity		= glm::vec3(m_Streams[STREAM_VELOCITY_X][particleIndex], m_Streams[STREAM_VELOCITY_Y][particleIndex], m_Streams[STREAM_VELOCITY_Z][particleIndex]);
+			particle.Acceleration	= glm::vec3(m_Streams[STREAM_ACCELERATION_X][particleIndex], m_Streams[STREAM_ACCELERATION_Y][particleIndex], m_Streams[STREAM_ACCELERATION_Z][particleIndex]);
+			particle.CurrentLife	= m_Streams[STREAM_CURRENT_LIFE][particleIndex];
+			particle.ShouldStop		= m_Streams[STREAM_SHOULD_STOP][particleIndex];
+			particle.WasCreated		= m_Streams[STREAM_WAS_CREATED][particleIndex] > 0.5f;
+			particle.TileIndex		= m_TileIndices[particleIndex];
+			particle.Generation		= m_Generations[particleIndex];
+		}
+	}
+
+	uint32 ParticleSimulatorCPU::ApplyCollisions(const SParticle* pParticles, uint32 firstParticle, uint32 particleCount)
+	{
+		VALIDATE(firstParticle + particleCount <= m_TileIndices.GetSize());
+
+		uint32 stoppedCount = 0;
+		for (uint32 i = 0; i < particleCount; i++)
+		{
+			const SParticle& particle	= pParticles[i];
+			const uint32 particleIndex	= firstParticle + i;
+
+			// Only particles that are still in the life that was collided and have not been stopped since
+			if (particle.Generation != m_Generations[particleIndex] || particle.ShouldStop < 0.5f || m_Streams[STREAM_SHOULD_STOP][particleIndex] > 0.5f)
+			{
+				continue;
+			}
+
+			// A stopped particle never moves again, so the collided position is still where it belongs
+			m_Streams[STREAM_POSITION_X][particleIndex]	= particle.Transform[3].x;
+			m_Streams[STREAM_POSITION_Y][particleIndex]	= particle.Transform[3].y;
+			m_Streams[STREAM_POSITION_Z][particleIndex]	= particle.Transform[3].z;
+			m_Streams[STREAM_VELOCITY_X][particleIndex]	= 0.0f;
+			m_Streams[STREAM_VELOCITY_Y][particleIndex]	= 0.0f;
+			m_Streams[STREAM_VELOCITY_Z][particleIndex]	= 0.0f;
+			m_Streams[STREAM_SHOULD_STOP][particleIndex]	= 1.0f;
+			stoppedCount++;
+		}
+
+		return stoppedCount;
+	}
+
+	void ParticleSimulatorCPU::Simulate(float32 deltaTime, const IndirectData* pChunks, const SEmitter* pEmitters, const glm::mat4* pTransforms, uint32 emitterCount)
+	{
+		// Split every emitter chunk into jobs, jobs never share particles so they need no synchronization
+		m_Jobs.Clear();
+		m_EmitterConstants.Resize(emitterCount);
+		for (uint32 e = 0; e < emitterCount; e++)
+		{
+			EmitterConstants& constants = m_EmitterConstants[e];
+			constants.Transform				= pTransforms[e];
+			constants.LifeTime				= pEmitters[e].LifeTime;
+			constants.Gravity				= pEmitters[e].Gravity;
+			constants.FirstAnimationIndex	= pEmitters[e].FirstAnimationIndex;
+			constants.OneTime				= pEmitters[e].OneTime;
+
+			const IndirectData& chunk = pChunks[e];
+			for (uint32 offset = 0; offset < chunk.InstanceCount; offset += PARTICLES_PER_JOB)
+			{
+				m_Jobs.PushBack(
+					{
+						.EmitterIndex	= e,
+						.FirstParticle	= chunk.FirstInstance + offset,
+						.ParticleCount	= glm::min(chunk.InstanceCount - offset, PARTICLES_PER_JOB)
+					});
+			}
+		}
+
+		ThreadPool::ParallelFor(m_Jobs.GetSize(), [this, deltaTime](uint32 jobIndex)
+			{
+				const Job& job = m_Jobs[jobIndex];
+				SimulateRange(m_EmitterConstants[job.EmitterIndex], deltaTime, job.FirstParticle, job.ParticleCount);
+			});
+	}
+
+	void ParticleSimulatorCPU::SimulateRange(const EmitterConstants& emitter, float32 deltaTime, uint32 firstParticle, uint32 particleCount)
+	{
+		float32* ppStreams[STREAM_COUNT];
+		for (uint32 s = 0; s < STREAM_COUNT; s++)
+		{
+			ppStreams[s] = m_Streams[s].GetData();
+		}
+
+		const uint32 endParticle = firstParticle + particleCount;
+
+		uint32 index = firstParticle;
+		for (; index + SIMD_WIDTH <= endParticle; index += SIMD_WIDTH)
+		{
+			uint32 respawnMask = SimulateParticles(ppStreams, index, emitter, deltaTime);
+			for (uint32 lane = 0; respawnMask != 0; lane++, respawnMask >>= 1)
+			{
+				if (respawnMask & 1)
+				{
+					m_TileIndices[index + lane] = emitter.FirstAnimationIndex;
+					m_Generations[index + lane]++;
+				}
+			}
+		}
+
+		// The tail is copied to a full vector so the neighbouring chunk is never touched
+		const uint32 remaining = endParticle - index;
+		if (remaining > 0)
+		{
+			float32 tail[STREAM_COUNT][SIMD_WIDTH] = {};
+			float32* ppTailStreams[STREAM_COUNT];
+			for (uint32 s = 0; s < STREAM_COUNT; s++)
+			{
+				memcpy(tail[s], ppStreams[s] + index, remaining * sizeof(float32));
+				ppTailStreams[s] = tail[s];
+			}
+
+			uint32 respawnMask = SimulateParticles(ppTailStreams, 0, emitter, deltaTime);
+
+			for (uint32 s = 0; s < STREAM_COUNT; s++)
+			{
+				memcpy(ppStreams[s] + index, tail[s], remaining * sizeof(float32));
+			}
+
+			for (uint32 lane = 0; lane < remaining; lane++, respawnMask >>= 1)
+			{
+				if (respawnMask & 1)
+				{
+					m_TileIndices[index + lane] = emitter.FirstAnimationIndex;
+					m_Generations[index + lane]++;
+				}
+			}
+		}
+	}
+}
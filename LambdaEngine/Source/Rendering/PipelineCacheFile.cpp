@@ -0,0 +1,121 @@
+#include "Rendering/PipelineCacheFile.h"
+
+#include "Utilities/HashUtilities.h"
+
+#include "Log/Log.h"
+
+#include <fstream>
+#include <filesystem>
+
+namespace LambdaEngine
+{
+	constexpr const uint32 PIPELINE_CACHE_MAGIC		= 0x4F53504C; // 'LPSO'
+	constexpr const uint32 PIPELINE_CACHE_VERSION	= 1;
+
+	struct PipelineCacheHeader
+	{
+		uint32					Magic;
+		uint32					Version;
+		PipelineCacheIdentity	Identity;
+		uint64					DataSize;
+		uint64					DataHash;
+	};
+
+	static bool IsSameIdentity(const PipelineCacheIdentity& lhs, const PipelineCacheIdentity& rhs)
+	{
+		return
+			lhs.VendorID		== rhs.VendorID &&
+			lhs.DeviceID		== rhs.DeviceID &&
+			lhs.DriverVersion	== rhs.DriverVersion &&
+			memcmp(lhs.CacheUUID, rhs.CacheUUID, sizeof(lhs.CacheUUID)) == 0;
+	}
+
+	bool PipelineCacheFile::Read(const String& filepath, const PipelineCacheIdentity& identity, TArray<byte>& data)
+	{
+		data.Clear();
+
+		std::ifstream file(filepath, std::ifstream::in | std::ifstream::binary);
+		if (!file)
+		{
+			return false;
+		}
+
+		PipelineCacheHeader header = {};
+		file.read((char*)&header, sizeof(PipelineCacheHeader));
+		if (!file || header.Magic != PIPELINE_CACHE_MAGIC || header.Version != PIPELINE_CACHE_VERSION || header.DataSize == 0)
+		{
+			LOG_WARNING("[PipelineCacheFile]: \"%s\" is invalid, starting with an empty pipeline cache", filepath.c_str());
+			return false;
+		}
+
+		if (!IsSameIdentity(header.Identity, identity))
+		{
+			LOG_INFO("[PipelineCacheFile]: \"%s\" was created by another device or driver, starting with an empty pipeline cache", filepath.c_str());
+			return false;
+		}
+
+		// The size comes from the file, it has to match the rest of the file before anything is allocated
+		const std::streamoff headerEnd = file.tellg();
+		file.seekg(0, std::ifstream::end);
+		const std::streamoff fileEnd = file.tellg();
+		file.seekg(headerEnd, std::ifstream::beg);
+		if (!file || fileEnd < headerEnd || header.DataSize != uint64(fileEnd - headerEnd) || header.DataSize > uint64(UINT32_MAX))
+		{
+			LOG_WARNING("[PipelineCacheFile]: \"%s\" is truncated or has an invalid size, starting with an empty pipeline cache", filepath.c_str());
+			return false;
+		}
+
+		data.Resize(uint32(header.DataSize));
+		file.read((char*)data.GetData(), header.DataSize);
+		if (!file || HashMemory(data.GetData(), data.GetSize()) != header.DataHash)
+		{
+			LOG_WARNING("[PipelineCacheFile]: \"%s\" is corrupt, starting with an empty pipeline cache", filepath.c_str());
+			data.Clear();
+			return false;
+		}
+
+		return true;
+	}
+
+	bool PipelineCacheFile::Write(const String& filepath, const PipelineCacheIdentity& identity, const TArray<byte>& data)
+	{
+		if (data.IsEmpty())
+		{
+			return false;
+		}
+
+		std::error_code error;
+		std::filesystem::create_directories(std::filesystem::path(filepath).parent_path(), error);
+
+		const String temporaryPath = filepath + ".tmp";
+		{
+			std::ofstream file(temporaryPath, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+			if (!file)
+			{
+				LOG_WARNING("[PipelineCacheFile]: Failed to write \"%s\"", filepath.c_str());
+				return false;
+			}
+
+			const PipelineCacheHeader header =
+			{
+				.Magic		= PIPELINE_CACHE_MAGIC,
+				.Version	= PIPELINE_CACHE_VERSION,
+				.Identity	= identity,
+				.DataSize	= data.GetSize(),
+				.DataHash	= HashMemory(data.GetData(), data.GetSize())
+			};
+
+			file.write((const char*)&header, sizeof(PipelineCacheHeader));
+			file.write((const char*)data.GetData(), data.GetSize());
+		}
+
+		std::filesystem::rename(temporaryPath, filepath, error);
+		if (error)
+		{
+			std::filesystem::remove(temporaryPath, error);
+			return false;
+		}
+
+		return true;
+	}
+}
@@ -5,6 +5,8 @@
 #include "Rendering/Core/API/GraphicsDevice.h"
 #include "Rendering/Core/API/PipelineState.h"
 
+#include "Utilities/HashUtilities.h"
+
 #include "Log/Log.h"
 
 #include "Application/API/Events/EventQueue.h"
@@ -16,6 +18,35 @@ namespace LambdaEngine
 	THashTable<uint64, ManagedGraphicsPipelineStateDesc>	PipelineStateManager::s_GraphicsPipelineStateDescriptions;
 	THashTable<uint64, ManagedComputePipelineStateDesc>		PipelineStateManager::s_ComputePipelineStateDescriptions;
 	THashTable<uint64, ManagedRayTracingPipelineStateDesc>	PipelineStateManager::s_RayTracingPipelineStateDescriptions;
+	THashTable<uint64, uint64>								PipelineStateManager::s_PipelineStateHashes;
+	THashTable<uint64, PipelineStateManager::SharedPipelineState>	PipelineStateManager::s_SharedPipelineStates;
+
+	/*
+	* Hashing, every member is hashed on its own since the descriptions contain padding and containers
+	*/
+	static uint64 HashShaderModule(const ManagedShaderModule& shaderModule, uint64 hash)
+	{
+		hash = HashValue<GUID_Lambda>(shaderModule.ShaderGUID, hash);
+		hash = HashValue<uint32>(shaderModule.ShaderConstants.GetSize(), hash);
+		for (const ShaderConstant& shaderConstant : shaderModule.ShaderConstants)
+		{
+			hash = HashMemory(shaderConstant.Data, sizeof(shaderConstant.Data), hash);
+		}
+
+		return hash;
+	}
+
+	static uint64 HashStencilOpState(const StencilOpStateDesc& stencilOpState, uint64 hash)
+	{
+		hash = HashValue(stencilOpState.FailOp, hash);
+		hash = HashValue(stencilOpState.PassOp, hash);
+		hash = HashValue(stencilOpState.DepthFailOp, hash);
+		hash = HashValue(stencilOpState.CompareOp, hash);
+		hash = HashValue(stencilOpState.CompareMask, hash);
+		hash = HashValue(stencilOpState.WriteMask, hash);
+		hash = HashValue(stencilOpState.Reference, hash);
+		return hash;
+	}
 
 	/*
 	* Managed Shader Module
@@ -109,6 +140,146 @@ namespace LambdaEngine
 	/*
 	* PipelineStateManager
 	*/
+	uint64 PipelineStateManager::HashGraphicsPipelineStateDesc(const ManagedGraphicsPipelineStateDesc& desc)
+	{
+		uint64 hash = HashValue(EPipelineStateType::PIPELINE_STATE_TYPE_GRAPHICS);
+		hash = HashValue<const void*>(desc.RenderPass.Get(), hash);
+		hash = HashValue<const void*>(desc.PipelineLayout.Get(), hash);
+
+		hash = HashValue<uint32>(desc.InputLayout.GetSize(), hash);
+		for (const InputElementDesc& inputElement : desc.InputLayout)
+		{
+			hash = HashMemory(inputElement.Semantic.data(), inputElement.Semantic.size(), hash);
+			hash = HashValue(inputElement.Binding, hash);
+			hash = HashValue(inputElement.Stride, hash);
+			hash = HashValue(inputElement.InputRate, hash);
+			hash = HashValue(inputElement.Location, hash);
+			hash = HashValue(inputElement.Offset, hash);
+			hash = HashValue(inputElement.Format, hash);
+		}
+
+		hash = HashValue(desc.InputAssembly.PrimitiveTopology, hash);
+		hash = HashValue(desc.InputAssembly.PrimitiveRestartEnable, hash);
+
+		const DepthStencilStateDesc& depthStencilState = desc.DepthStencilState;
+		hash = HashValue(depthStencilState.CompareOp, hash);
+		hash = HashStencilOpState(depthStencilState.FrontFace, hash);
+		hash = HashStencilOpState(depthStencilState.BackFace, hash);
+		hash = HashValue(depthStencilState.MinDepthBounds, hash);
+		hash = HashValue(depthStencilState.MaxDepthBounds, hash);
+		hash = HashValue(depthStencilState.DepthTestEnable, hash);
+		hash = HashValue(depthStencilState.DepthWriteEnable, hash);
+		hash = HashValue(depthStencilState.DepthBoundsTestEnable, hash);
+		hash = HashValue(depthStencilState.StencilTestEnable, hash);
+
+		const BlendStateDesc& blendState = desc.BlendState;
+		hash = HashValue<uint32>(blendState.BlendAttachmentStates.GetSize(), hash);
+		for (const BlendAttachmentStateDesc& blendAttachmentState : blendState.BlendAttachmentStates)
+		{
+			hash = HashValue(blendAttachmentState.BlendOp, hash);
+			hash = HashValue(blendAttachmentState.SrcBlend, hash);
+			hash = HashValue(blendAttachmentState.DstBlend, hash);
+			hash = HashValue(blendAttachmentState.BlendOpAlpha, hash);
+			hash = HashValue(blendAttachmentState.SrcBlendAlpha, hash);
+			hash = HashValue(blendAttachmentState.DstBlendAlpha, hash);
+			hash = HashValue(blendAttachmentState.RenderTargetComponentMask, hash);
+			hash = HashValue(blendAttachmentState.BlendEnabled, hash);
+		}
+
+		hash = HashMemory(blendState.BlendConstants, sizeof(blendState.BlendConstants), hash);
+		hash = HashValue(blendState.LogicOp, hash);
+		hash = HashValue(blendState.AlphaToCoverageEnable, hash);
+		hash = HashValue(blendState.AlphaToOneEnable, hash);
+		hash = HashValue(blendState.LogicOpEnable, hash);
+
+		const RasterizerStateDesc& rasterizerState = desc.RasterizerState;
+		hash = HashValue(rasterizerState.PolygonMode, hash);
+		hash = HashValue(rasterizerState.CullMode, hash);
+		hash = HashValue(rasterizerState.LineWidth, hash);
+		hash = HashValue(rasterizerState.DepthBiasClamp, hash);
+		hash = HashValue(rasterizerState.DepthBiasConstantFactor, hash);
+		hash = HashValue(rasterizerState.DepthBiasSlopeFactor, hash);
+		hash = HashValue(rasterizerState.FrontFaceCounterClockWise, hash);
+		hash = HashValue(rasterizerState.RasterizerDiscardEnable, hash);
+		hash = HashValue(rasterizerState.DepthBiasEnable, hash);
+		hash = HashValue(rasterizerState.DepthClampEnable, hash);
+		hash = HashValue(rasterizerState.MultisampleEnable, hash);
+
+		hash = HashValue(desc.SampleMask, hash);
+		hash = HashValue(desc.SampleCount, hash);
+		hash = HashValue(desc.Subpass, hash);
+		hash = HashValue(desc.ExtraDynamicState, hash);
+
+		hash = HashShaderModule(desc.MeshShader, hash);
+		hash = HashShaderModule(desc.TaskShader, hash);
+		hash = HashShaderModule(desc.VertexShader, hash);
+		hash = HashShaderModule(desc.HullShader, hash);
+		hash = HashShaderModule(desc.DomainShader, hash);
+		hash = HashShaderModule(desc.GeometryShader, hash);
+		hash = HashShaderModule(desc.PixelShader, hash);
+		return hash;
+	}
+
+	uint64 PipelineStateManager::HashComputePipelineStateDesc(const ManagedComputePipelineStateDesc& desc)
+	{
+		uint64 hash = HashValue(EPipelineStateType::PIPELINE_STATE_TYPE_COMPUTE);
+		hash = HashValue<const void*>(desc.PipelineLayout.Get(), hash);
+		hash = HashShaderModule(desc.Shader, hash);
+		return hash;
+	}
+
+	uint64 PipelineStateManager::HashRayTracingPipelineStateDesc(const ManagedRayTracingPipelineStateDesc& desc)
+	{
+		uint64 hash = HashValue(EPipelineStateType::PIPELINE_STATE_TYPE_RAY_TRACING);
+		hash = HashValue<const void*>(desc.PipelineLayout.Get(), hash);
+		hash = HashValue(desc.MaxRecursionDepth, hash);
+		hash = HashShaderModule(desc.RaygenShader, hash);
+
+		hash = HashValue<uint32>(desc.MissShaders.GetSize(), hash);
+		for (const ManagedShaderModule& missShader : desc.MissShaders)
+		{
+			hash = HashShaderModule(missShader, hash);
+		}
+
+		hash = HashValue<uint32>(desc.HitGroupShaders.GetSize(), hash);
+		for (const HitGroupShaderModules& hitGroup : desc.HitGroupShaders)
+		{
+			hash = HashShaderModule(hitGroup.ClosestHitShader, hash);
+			hash = HashShaderModule(hitGroup.AnyHitShader, hash);
+			hash = HashShaderModule(hitGroup.IntersectionShader, hash);
+		}
+
+		return hash;
+	}
+
+	uint64 PipelineStateManager::RegisterPipelineState(uint64 hash, PipelineState* pPipelineState)
+	{
+		const uint64 pipelineIndex = s_CurrentPipelineIndex++;
+
+		SharedPipelineState& sharedPipelineState = s_SharedPipelineStates[hash];
+		sharedPipelineState.PipelineState	= pPipelineState;
+		sharedPipelineState.RefCount++;
+
+		s_PipelineStates[pipelineIndex]			= sharedPipelineState.PipelineState;
+		s_PipelineStateHashes[pipelineIndex]	= hash;
+		return pipelineIndex;
+	}
+
+	uint64 PipelineStateManager::FindSharedPipelineState(uint64 hash)
+	{
+		auto sharedIt = s_SharedPipelineStates.find(hash);
+		if (sharedIt == s_SharedPipelineStates.end() || sharedIt->second.PipelineState == nullptr)
+		{
+			return 0;
+		}
+
+		const uint64 pipelineIndex = s_CurrentPipelineIndex++;
+		sharedIt->second.RefCount++;
+
+		s_PipelineStates[pipelineIndex]			= sharedIt->second.PipelineState;
+		s_PipelineStateHashes[pipelineIndex]	= hash;
+		return pipelineIndex;
+	}
 
 	bool PipelineStateManager::Init()
 	{
@@ -124,6 +295,8 @@ namespace LambdaEngine
 		s_GraphicsPipelineStateDescriptions.clear();
 		s_ComputePipelineStateDescriptions.clear();
 		s_RayTracingPipelineStateDescriptions.clear();
+		s_PipelineStateHashes.clear();
+		s_SharedPipelineStates.clear();
 		s_PipelineStates.clear();
 		return true;
 	}
@@ -132,56 +305,69 @@ namespace LambdaEngine
 	{
 		VALIDATE(pDesc != nullptr);
 
-		GraphicsPipelineStateDesc pipelineDesc = pDesc->GetDesc();
-		PipelineState* pPipelineState = RenderAPI::GetDevice()->CreateGraphicsPipelineState(&pipelineDesc);
-		if (pPipelineState)
-		{
-			const uint64 pipelineIndex = s_CurrentPipelineIndex++;
-			s_GraphicsPipelineStateDescriptions[pipelineIndex]	= *pDesc;
-			s_PipelineStates[pipelineIndex] 					= pPipelineState;
-			return pipelineIndex;
-		}
-		else
+		const uint64 hash = HashGraphicsPipelineStateDesc(*pDesc);
+		uint64 pipelineIndex = FindSharedPipelineState(hash);
+		if (pipelineIndex == 0)
 		{
-			LOG_DEBUG("PipelineState is nullptr");
-			return 0;
+			GraphicsPipelineStateDesc pipelineDesc = pDesc->GetDesc();
+			PipelineState* pPipelineState = RenderAPI::GetDevice()->CreateGraphicsPipelineState(&pipelineDesc);
+			if (!pPipelineState)
+			{
+				LOG_DEBUG("PipelineState is nullptr");
+				return 0;
+			}
+
+			pipelineIndex = RegisterPipelineState(hash, pPipelineState);
 		}
+
+		s_GraphicsPipelineStateDescriptions[pipelineIndex] = *pDesc;
+		return pipelineIndex;
 	}
 
 	uint64 PipelineStateManager::CreateComputePipelineState(const ManagedComputePipelineStateDesc* pDesc)
 	{
-		ComputePipelineStateDesc pipelineDesc = pDesc->GetDesc();
-		PipelineState* pPipelineState = RenderAPI::GetDevice()->CreateComputePipelineState(&pipelineDesc);
-		if (pPipelineState)
-		{
-			const uint64 pipelineIndex = s_CurrentPipelineIndex++;
-			s_ComputePipelineStateDescriptions[pipelineIndex]	= *pDesc;
-			s_PipelineStates[pipelineIndex] 					= pPipelineState;
-			return pipelineIndex;
-		}
-		else
+		VALIDATE(pDesc != nullptr);
+
+		const uint64 hash = HashComputePipelineStateDesc(*pDesc);
+		uint64 pipelineIndex = FindSharedPipelineState(hash);
+		if (pipelineIndex == 0)
 		{
-			LOG_DEBUG("PipelineState is nullptr");
-			return 0;
+			ComputePipelineStateDesc pipelineDesc = pDesc->GetDesc();
+			PipelineState* pPipelineState = RenderAPI::GetDevice()->CreateComputePipelineState(&pipelineDesc);
+			if (!pPipelineState)
+			{
+				LOG_DEBUG("PipelineState is nullptr");
+				return 0;
+			}
+
+			pipelineIndex = RegisterPipelineState(hash, pPipelineState);
 		}
+
+		s_ComputePipelineStateDescriptions[pipelineIndex] = *pDesc;
+		return pipelineIndex;
 	}
 
 	uint64 PipelineStateManager::CreateRayTracingPipelineState(const ManagedRayTracingPipelineStateDesc* pDesc)
 	{
-		RayTracingPipelineStateDesc pipelineDesc = pDesc->GetDesc();
-		PipelineState*	pPipelineState	= RenderAPI::GetDevice()->CreateRayTracingPipelineState(&pipelineDesc);
-		if (pPipelineState)
-		{
-			const uint64 pipelineIndex = s_CurrentPipelineIndex++;
-			s_RayTracingPipelineStateDescriptions[pipelineIndex]	= *pDesc;
-			s_PipelineStates[pipelineIndex] 						= pPipelineState;
-			return pipelineIndex;
-		}
-		else
+		VALIDATE(pDesc != nullptr);
+
+		const uint64 hash = HashRayTracingPipelineStateDesc(*pDesc);
+		uint64 pipelineIndex = FindSharedPipelineState(hash);
+		if (pipelineIndex == 0)
 		{
-			LOG_DEBUG("PipelineState is nullptr");
-			return 0;
+			RayTracingPipelineStateDesc pipelineDesc = pDesc->GetDesc();
+			PipelineState* pPipelineState = RenderAPI::GetDevice()->CreateRayTracingPipelineState(&pipelineDesc);
+			if (!pPipelineState)
+			{
+				LOG_DEBUG("PipelineState is nullptr");
+				return 0;
+			}
+
+			pipelineIndex = RegisterPipelineState(hash, pPipelineState);
 		}
+
+		s_RayTracingPipelineStateDescriptions[pipelineIndex] = *pDesc;
+		return pipelineIndex;
 	}
 
 	THashTable<uint64, ManagedGraphicsPipelineStateDesc>& PipelineStateManager::GetGraphicsPipelineStateDescriptions()
@@ -204,6 +390,18 @@ namespace LambdaEngine
 			}
 
 			s_PipelineStates.erase(id);
+
+			auto hashIt = s_PipelineStateHashes.find(id);
+			if (hashIt != s_PipelineStateHashes.end())
+			{
+				auto sharedIt = s_SharedPipelineStates.find(hashIt->second);
+				if (sharedIt != s_SharedPipelineStates.end() && --sharedIt->second.RefCount == 0)
+				{
+					s_SharedPipelineStates.erase(sharedIt);
+				}
+
+				s_PipelineStateHashes.erase(hashIt);
+			}
 		}
 	}
 
@@ -226,42 +424,65 @@ namespace LambdaEngine
 		RenderAPI::GetComputeQueue()->Flush();
 		RenderAPI::GetCopyQueue()->Flush();
 
+		// Descriptions may have been modified since they were created, so the hashes are recalculated
+		// and pipeline states that share a description are only recreated once
+		THashTable<uint64, SharedPipelineState> sharedPipelineStates;
 		for (auto it = s_PipelineStates.begin(); it != s_PipelineStates.end(); it++)
 		{
-			PipelineState* pNewPipelineState = nullptr;
-			VALIDATE(it->second != nullptr);
+			const uint64 pipelineIndex = it->first;
 
-			switch (it->second->GetType())
+			uint64 hash = 0;
+			auto graphicsIt		= s_GraphicsPipelineStateDescriptions.find(pipelineIndex);
+			auto computeIt		= s_ComputePipelineStateDescriptions.find(pipelineIndex);
+			auto rayTracingIt	= s_RayTracingPipelineStateDescriptions.find(pipelineIndex);
+			if (graphicsIt != s_GraphicsPipelineStateDescriptions.end())
 			{
-				case EPipelineStateType::PIPELINE_STATE_TYPE_GRAPHICS:
-				{
-					const ManagedGraphicsPipelineStateDesc* pPipelineDesc = &s_GraphicsPipelineStateDescriptions[it->first];
-					GraphicsPipelineStateDesc pipelineDesc = pPipelineDesc->GetDesc();
+				hash = HashGraphicsPipelineStateDesc(graphicsIt->second);
+			}
+			else if (computeIt != s_ComputePipelineStateDescriptions.end())
+			{
+				hash = HashComputePipelineStateDesc(computeIt->second);
+			}
+			else if (rayTracingIt != s_RayTracingPipelineStateDescriptions.end())
+			{
+				hash = HashRayTracingPipelineStateDesc(rayTracingIt->second);
+			}
 
-					pNewPipelineState = RenderAPI::GetDevice()->CreateGraphicsPipelineState(&pipelineDesc);
-					break;
-				}
-				case EPipelineStateType::PIPELINE_STATE_TYPE_COMPUTE:
-				{
-					const ManagedComputePipelineStateDesc* pPipelineDesc = &s_ComputePipelineStateDescriptions[it->first];
-					ComputePipelineStateDesc pipelineDesc = pPipelineDesc->GetDesc();
+			s_PipelineStateHashes[pipelineIndex] = hash;
 
-					pNewPipelineState = RenderAPI::GetDevice()->CreateComputePipelineState(&pipelineDesc);
-					break;
-				}
-				case EPipelineStateType::PIPELINE_STATE_TYPE_RAY_TRACING:
-				{
-					const ManagedRayTracingPipelineStateDesc* pPipelineDesc = &s_RayTracingPipelineStateDescriptions[it->first];
-					RayTracingPipelineStateDesc pipelineDesc = pPipelineDesc->GetDesc();
+			auto sharedIt = sharedPipelineStates.find(hash);
+			if (sharedIt != sharedPipelineStates.end())
+			{
+				sharedIt->second.RefCount++;
+				it->second = sharedIt->second.PipelineState;
+				continue;
+			}
 
-					pNewPipelineState = RenderAPI::GetDevice()->CreateRayTracingPipelineState(&pipelineDesc);
-					break;
-				}
+			PipelineState* pNewPipelineState = nullptr;
+			if (graphicsIt != s_GraphicsPipelineStateDescriptions.end())
+			{
+				GraphicsPipelineStateDesc pipelineDesc = graphicsIt->second.GetDesc();
+				pNewPipelineState = RenderAPI::GetDevice()->CreateGraphicsPipelineState(&pipelineDesc);
+			}
+			else if (computeIt != s_ComputePipelineStateDescriptions.end())
+			{
+				ComputePipelineStateDesc pipelineDesc = computeIt->second.GetDesc();
+				pNewPipelineState = RenderAPI::GetDevice()->CreateComputePipelineState(&pipelineDesc);
+			}
+			else if (rayTracingIt != s_RayTracingPipelineStateDescriptions.end())
+			{
+				RayTracingPipelineStateDesc pipelineDesc = rayTracingIt->second.GetDesc();
+				pNewPipelineState = RenderAPI::GetDevice()->CreateRayTracingPipelineState(&pipelineDesc);
 			}
 
-			it->second = pNewPipelineState;
+			SharedPipelineState& sharedPipelineState = sharedPipelineStates[hash];
+			sharedPipelineState.PipelineState	= pNewPipelineState;
+			sharedPipelineState.RefCount		= 1;
+			it->second							= sharedPipelineState.PipelineState;
 		}
 
+		s_SharedPipelineStates = std::move(sharedPipelineStates);
+
 		PipelineStatesRecompiledEvent recompiledEvent = {};
 		EventQueue::SendEventImmediate(recompiledEvent);
 
@@ -275,6 +275,7 @@ namespace LambdaEngine
 		asInstance.AccelerationStructureAddress	= blasData.pBLAS->GetDeviceAddress();
 
 		m_InstanceIndicesChanged = true;
+		m_TLASUpdateTracker.MarkDirty(instanceIndex);
 		m_Instances.PushBack(asInstance);
 
 		uint32 externalIndex;
@@ -323,6 +324,7 @@ namespace LambdaEngine
 		//Move the Last Instance to the Removed Instance Index
 		m_Instances[trueInstanceIndex] = m_Instances.GetBack();
 		m_Instances.PopBack();
+		m_TLASUpdateTracker.MarkDirty(trueInstanceIndex);
 
 		//Remap the previous Last Instance True (Indirect) Instance Index to point to the removed Index
 		(*lastInstanceIndexIt) = trueInstanceIndex;
@@ -350,6 +352,7 @@ namespace LambdaEngine
 
 		AccelerationStructureInstance& asInstance = m_Instances[trueInstanceIndex];
 		asInstance.Transform = glm::transpose(transform);
+		m_TLASUpdateTracker.MarkDirty(trueInstanceIndex);
 	}
 
 	void ASBuilder::UpdateInstance(uint32 instanceIndex, std::function<void(AccelerationStructureInstance&)> updateFunc)
@@ -365,6 +368,7 @@ namespace LambdaEngine
 
 		AccelerationStructureInstance& asInstance = m_Instances[trueInstanceIndex];
 		updateFunc(asInstance);
+		m_TLASUpdateTracker.MarkDirty(trueInstanceIndex);
 	}
 
 	void ASBuilder::UpdateInstances(std::function<void(AccelerationStructureInstance&)> updateFunc)
@@ -376,6 +380,14 @@ namespace LambdaEngine
 			AccelerationStructureInstance& asInstance = m_Instances[instanceIndex];
 			updateFunc(asInstance);
 		}
+
+		m_TLASUpdateTracker.MarkAllDirty();
+	}
+
+	void ASBuilder::MarkInstancesWrittenOnGPU()
+	{
+		std::scoped_lock<SpinLock> lock(m_Lock);
+		m_TLASUpdateTracker.MarkGPUWritten();
 	}
 
 	void ASBuilder::Update(
@@ -414,6 +426,7 @@ namespace LambdaEngine
 			}
 
 			//Build BLASes
+			bool blasesChanged = false;
 			{
 				//This is required to sync up any Vertex Updates with BLAS building
 				static constexpr const PipelineMemoryBarrierDesc BLAS_PRE_MEMORY_BARRIER
@@ -446,10 +459,13 @@ namespace LambdaEngine
 					&BLAS_POST_MEMORY_BARRIER,
 					1);
 
+				//The TLAS has to be refitted to rebuilt BLASes even if no instance changed
+				blasesChanged = !m_DirtyBLASes.IsEmpty();
 				m_DirtyBLASes.Clear();
 			}
 
-			//Update TLAS, assume always dirty
+			//Update TLAS
+			std::scoped_lock<SpinLock> lock(m_Lock);
 			if (!m_Instances.IsEmpty())
 			{
 				Buffer* pInstanceStagingBuffer = m_ppInstanceStagingBuffers[m_ModFrameIndex];
@@ -503,7 +519,7 @@ namespace LambdaEngine
 					pCopyCommandList->CopyBuffer(pInstanceIndicesStagingBuffer, 0, m_pInstanceIndicesBuffer, 0, requiredInstanceIndicesBufferSize);
 				}
 
-				//Update Instance Buffer
+				//Update Instance Buffer, the buffer keeps its content between frames so only changed instances are copied
 				{
 					uint64 requiredInstanceBufferSize = uint64(instanceCount) * sizeof(AccelerationStructureInstance);
 
@@ -521,10 +537,6 @@ namespace LambdaEngine
 						m_ppInstanceStagingBuffers[m_ModFrameIndex] = pInstanceStagingBuffer;
 					}
 
-					void* pMapped = pInstanceStagingBuffer->Map();
-					memcpy(pMapped, m_Instances.GetData(), requiredInstanceBufferSize);
-					pInstanceStagingBuffer->Unmap();
-
 					if (m_pInstanceBuffer == nullptr || m_pInstanceBuffer->GetDesc().SizeInBytes < requiredInstanceBufferSize)
 					{
 						if (m_pInstanceBuffer != nullptr) deviceResourcesToRemove.PushBack(m_pInstanceBuffer);
@@ -543,24 +555,39 @@ namespace LambdaEngine
 						resourceUpdateDesc.ExternalBufferUpdate.ppBuffer	= &m_pInstanceBuffer;
 
 						m_pRenderGraph->UpdateResource(&resourceUpdateDesc);
-					}
 
-					pCopyCommandList->CopyBuffer(pInstanceStagingBuffer, 0, m_pInstanceBuffer, 0, requiredInstanceBufferSize);
-				}
-
-				static constexpr const PipelineMemoryBarrierDesc INSTANCE_BUFFER_MEMORY_BARRIER
-				{
-					.SrcMemoryAccessFlags = FMemoryAccessFlag::MEMORY_ACCESS_FLAG_MEMORY_WRITE,
-					.DstMemoryAccessFlags = FMemoryAccessFlag::MEMORY_ACCESS_FLAG_MEMORY_READ,
-				};
+						//New buffers are empty
+						m_TLASUpdateTracker.MarkAllDirty();
+					}
 
-				pCopyCommandList->PipelineMemoryBarriers(
-					FPipelineStageFlag::PIPELINE_STAGE_FLAG_COPY,
-					FPipelineStageFlag::PIPELINE_STAGE_FLAG_ACCELERATION_STRUCTURE_BUILD,
-					&INSTANCE_BUFFER_MEMORY_BARRIER,
-					1);
+					m_TLASUpdateTracker.GetDirtyRanges(instanceCount, m_DirtyInstanceRanges);
 
-				bool update = true;
+					if (!m_DirtyInstanceRanges.IsEmpty())
+					{
+						byte* pMapped = reinterpret_cast<byte*>(pInstanceStagingBuffer->Map());
+						for (const TLASInstanceRange& instanceRange : m_DirtyInstanceRanges)
+						{
+							const uint64 offset	= uint64(instanceRange.FirstInstance) * sizeof(AccelerationStructureInstance);
+							const uint64 size	= uint64(instanceRange.InstanceCount) * sizeof(AccelerationStructureInstance);
+
+							memcpy(pMapped + offset, &m_Instances[instanceRange.FirstInstance], size);
+							pCopyCommandList->CopyBuffer(pInstanceStagingBuffer, offset, m_pInstanceBuffer, offset, size);
+						}
+						pInstanceStagingBuffer->Unmap();
+
+						static constexpr const PipelineMemoryBarrierDesc INSTANCE_BUFFER_MEMORY_BARRIER
+						{
+							.SrcMemoryAccessFlags = FMemoryAccessFlag::MEMORY_ACCESS_FLAG_MEMORY_WRITE,
+							.DstMemoryAccessFlags = FMemoryAccessFlag::MEMORY_ACCESS_FLAG_MEMORY_READ,
+						};
+
+						pCopyCommandList->PipelineMemoryBarriers(
+							FPipelineStageFlag::PIPELINE_STAGE_FLAG_COPY,
+							FPipelineStageFlag::PIPELINE_STAGE_FLAG_ACCELERATION_STRUCTURE_BUILD,
+							&INSTANCE_BUFFER_MEMORY_BARRIER,
+							1);
+					}
+				}
 
 				//Recreate TLAS completely if m_MaxSupportedTLASInstances < newInstanceCount
 				if (m_MaxSupportedTLASInstances < instanceCount)
@@ -568,7 +595,7 @@ namespace LambdaEngine
 					if (m_pTLAS != nullptr) deviceResourcesToRemove.PushBack(m_pTLAS);
 
 					m_MaxSupportedTLASInstances = instanceCount;
-					m_BuiltTLASInstanceCount = instanceCount;
+					m_BuiltTLASInstanceCount = 0;
 
 					AccelerationStructureDesc createTLASDesc = {};
 					createTLASDesc.DebugName		= "TLAS";
@@ -578,28 +605,30 @@ namespace LambdaEngine
 
 					m_pTLAS = RenderAPI::GetDevice()->CreateAccelerationStructure(&createTLASDesc);
 
-					update = false;
-
 					ResourceUpdateDesc resourceUpdateDesc = {};
 					resourceUpdateDesc.ResourceName							= SCENE_TLAS;
 					resourceUpdateDesc.ExternalAccelerationStructure.pTLAS	= m_pTLAS;
 
 					m_pRenderGraph->UpdateResource(&resourceUpdateDesc);
 				}
-				else if (m_BuiltTLASInstanceCount != instanceCount)
+
+				//A new TLAS has no built instances, so it is always rebuilt
+				const ETLASBuildMode buildMode = m_TLASUpdateTracker.SelectBuildMode(instanceCount, m_BuiltTLASInstanceCount, blasesChanged);
+				m_TLASUpdateTracker.Reset(buildMode);
+
+				if (buildMode != ETLASBuildMode::NONE)
 				{
 					m_BuiltTLASInstanceCount = instanceCount;
-					update = false;
-				}
 
-				BuildTopLevelAccelerationStructureDesc buildTLASDesc = {};
-				buildTLASDesc.pAccelerationStructure	= m_pTLAS;
-				buildTLASDesc.Flags						= FAccelerationStructureFlag::ACCELERATION_STRUCTURE_FLAG_ALLOW_UPDATE | FAccelerationStructureFlag::ACCELERATION_STRUCTURE_FLAG_FAST_BUILD;
-				buildTLASDesc.Update					= update;
-				buildTLASDesc.pInstanceBuffer			= m_pInstanceBuffer;
-				buildTLASDesc.InstanceCount				= instanceCount;
+					BuildTopLevelAccelerationStructureDesc buildTLASDesc = {};
+					buildTLASDesc.pAccelerationStructure	= m_pTLAS;
+					buildTLASDesc.Flags						= FAccelerationStructureFlag::ACCELERATION_STRUCTURE_FLAG_ALLOW_UPDATE | FAccelerationStructureFlag::ACCELERATION_STRUCTURE_FLAG_FAST_BUILD;
+					buildTLASDesc.Update					= buildMode == ETLASBuildMode::UPDATE;
+					buildTLASDesc.pInstanceBuffer			= m_pInstanceBuffer;
+					buildTLASDesc.InstanceCount				= instanceCount;
 
-				pMainCommandList->BuildTopLevelAccelerationStructure(&buildTLASDesc);
+					pMainCommandList->BuildTopLevelAccelerationStructure(&buildTLASDesc);
+				}
 
 				static constexpr const PipelineMemoryBarrierDesc TLAS_MEMORY_BARRIER
 				{
@@ -762,8 +791,12 @@ namespace LambdaEngine
 			m_pRenderGraph->UpdateResource(&resourceUpdateDesc);
 		}
 
-		//Create Dummy TLAS
+		//Create Dummy TLAS, the real TLAS is recreated and rebuilt with every instance next frame
 		{
+			m_MaxSupportedTLASInstances	= 0;
+			m_BuiltTLASInstanceCount	= 0;
+			m_TLASUpdateTracker.MarkAllDirty();
+
 			AccelerationStructureDesc createTLASDesc = {};
 			createTLASDesc.DebugName		= "Dummy TLAS";
 			createTLASDesc.Type				= EAccelerationStructureType::ACCELERATION_STRUCTURE_TYPE_TOP;
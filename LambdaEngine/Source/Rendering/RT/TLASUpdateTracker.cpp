@@ -0,0 +1,127 @@
+#include "Rendering/RT/TLASUpdateTracker.h"
+
+#include <algorithm>
+
+namespace LambdaEngine
+{
+	void TLASUpdateTracker::MarkDirty(uint32 instanceIndex)
+	{
+		if (m_AllDirty)
+		{
+			return;
+		}
+
+		if (instanceIndex >= m_DirtyFlags.GetSize())
+		{
+			m_DirtyFlags.Resize(instanceIndex + 1, false);
+		}
+
+		if (!m_DirtyFlags[instanceIndex])
+		{
+			m_DirtyFlags[instanceIndex] = true;
+			m_DirtyInstances.PushBack(instanceIndex);
+		}
+	}
+
+	void TLASUpdateTracker::MarkAllDirty()
+	{
+		m_AllDirty = true;
+	}
+
+	void TLASUpdateTracker::MarkGPUWritten()
+	{
+		m_GPUWritten = true;
+	}
+
+	void TLASUpdateTracker::GetDirtyRanges(uint32 instanceCount, TArray<TLASInstanceRange>& ranges)
+	{
+		ranges.Clear();
+
+		if (instanceCount == 0)
+		{
+			return;
+		}
+
+		if (m_AllDirty)
+		{
+			ranges.PushBack({ 0, instanceCount });
+			return;
+		}
+
+		std::sort(m_DirtyInstances.Begin(), m_DirtyInstances.End());
+
+		for (uint32 instanceIndex : m_DirtyInstances)
+		{
+			// Sorted, so the rest are removed instances as well
+			if (instanceIndex >= instanceCount)
+			{
+				break;
+			}
+
+			// Uploading a few clean instances is cheaper than an extra copy region
+			if (!ranges.IsEmpty())
+			{
+				TLASInstanceRange& lastRange = ranges.GetBack();
+				const uint32 lastRangeEnd = lastRange.FirstInstance + lastRange.InstanceCount;
+				if (instanceIndex <= lastRangeEnd + MAX_RANGE_GAP)
+				{
+					lastRange.InstanceCount = instanceIndex + 1 - lastRange.FirstInstance;
+					continue;
+				}
+			}
+
+			ranges.PushBack({ instanceIndex, 1 });
+		}
+	}
+
+	ETLASBuildMode TLASUpdateTracker::SelectBuildMode(uint32 instanceCount, uint32 builtInstanceCount, bool blasesChanged) const
+	{
+		// Updates require the same instances as the last build
+		if (instanceCount != builtInstanceCount || m_AllDirty)
+		{
+			return ETLASBuildMode::REBUILD;
+		}
+
+		uint32 dirtyInstanceCount = 0;
+		for (uint32 instanceIndex : m_DirtyInstances)
+		{
+			if (instanceIndex < instanceCount)
+			{
+				dirtyInstanceCount++;
+			}
+		}
+
+		if (dirtyInstanceCount == 0 && !blasesChanged && !m_GPUWritten)
+		{
+			return ETLASBuildMode::NONE;
+		}
+
+		if (m_UpdatesSinceRebuild >= MAX_UPDATES_BEFORE_REBUILD || float32(dirtyInstanceCount) > float32(instanceCount) * REBUILD_DIRTY_FRACTION)
+		{
+			return ETLASBuildMode::REBUILD;
+		}
+
+		return ETLASBuildMode::UPDATE;
+	}
+
+	void TLASUpdateTracker::Reset(ETLASBuildMode buildMode)
+	{
+		for (uint32 instanceIndex : m_DirtyInstances)
+		{
+			m_DirtyFlags[instanceIndex] = false;
+		}
+
+		m_DirtyInstances.Clear();
+		m_AllDirty		= false;
+		m_GPUWritten	= false;
+
+		if (buildMode == ETLASBuildMode::REBUILD)
+		{
+			m_UpdatesSinceRebuild = 0;
+		}
+		else if (buildMode == ETLASBuildMode::UPDATE)
+		{
+			m_UpdatesSinceRebuild++;
+		}
+	}
+}
@@ -17,6 +17,7 @@
 #include "Rendering/Core/API/Sampler.h"
 #include "Rendering/Core/API/Texture.h"
 #include "Rendering/Core/API/TextureView.h"
+#include "Rendering/Core/API/MemoryHeap.h"
 #include "Rendering/Core/API/CommandQueue.h"
 #include "Rendering/Core/API/Fence.h"
 #include "Rendering/Core/API/Shader.h"
@@ -35,6 +36,8 @@
 #include "Debug/Profiler.h"
 #include "Time/API/Clock.h"
 
+#include "Threading/API/ThreadPool.h"
+
 namespace LambdaEngine
 {
 	constexpr const uint32 SAME_QUEUE_BACK_BUFFER_BOUND_SYNCHRONIZATION_INDEX	= 0;
@@ -69,6 +72,7 @@ namespace LambdaEngine
 		SAFERELEASE(s_pMaterialFence);
 
 		SAFERELEASE(m_pDescriptorHeap);
+		SAFERELEASE(m_pTransientHeap);
 
 		for (uint32 b = 0; b < m_BackBufferCount; b++)
 		{
@@ -170,6 +174,9 @@ namespace LambdaEngine
 			return false;
 		}
 
+		PlanBarriers(pDesc);
+		PlanResourceAliasing(pDesc);
+
 		if (!CreateRenderStages(
 			pDesc->pRenderGraphStructureDesc->RenderStageDescriptions,
 			pDesc->pRenderGraphStructureDesc->ShaderConstants,
@@ -269,6 +276,9 @@ namespace LambdaEngine
 			return false;
 		}
 
+		PlanBarriers(pDesc);
+		PlanResourceAliasing(pDesc);
+
 		if (!CreateRenderStages(
 			pDesc->pRenderGraphStructureDesc->RenderStageDescriptions,
 			pDesc->pRenderGraphStructureDesc->ShaderConstants,
@@ -593,12 +603,19 @@ namespace LambdaEngine
 
 		if (m_DirtyInternalResources.size() > 0)
 		{
+			const bool transientResourcesPlaced = PlaceTransientResources();
+
 			for (const String& dirtyInternalResourceDescName : m_DirtyInternalResources)
 			{
 				UpdateInternalResource(m_InternalResourceUpdateDescriptions[dirtyInternalResourceDescName]);
 			}
 
 			m_DirtyInternalResources.clear();
+
+			if (transientResourcesPlaced)
+			{
+				UpdateAliasingBarriers();
+			}
 		}
 
 		if (!m_DirtyBoundBufferResources.empty())
@@ -831,8 +848,6 @@ namespace LambdaEngine
 
 		ZERO_MEMORY(m_ppExecutionStages, m_ExecutionStageCount * sizeof(CommandList*));
 
-		uint32 currentExecutionStage = 0;
-
 		s_pMaterialFence->Wait(m_SignalValue - 1, UINT64_MAX);
 
 		TArray<DeviceChild*>& currentFrameDeviceResourcesToDestroy = m_pDeviceResourcesToDestroy[m_ModFrameIndex];
@@ -848,78 +863,15 @@ namespace LambdaEngine
 		}
 
 		BEGIN_PROFILING_SEGMENT("Record Pipeline Stages");
-		for (uint32 p = 0; p < m_PipelineStageCount; p++)
+		if (m_ParallelRecording && ThreadPool::GetThreadCount() > 0)
 		{
-			//Seperate Thread
+			RecordPipelineStagesParallel();
+		}
+		else
+		{
+			for (uint32 p = 0; p < m_PipelineStageCount; p++)
 			{
-				PipelineStage* pPipelineStage = &m_pPipelineStages[p];
-
-				if (pPipelineStage->Type == ERenderGraphPipelineStageType::RENDER)
-				{
-					RenderStage* pRenderStage = &m_pRenderStages[pPipelineStage->StageIndex];
-					BEGIN_PROFILING_SEGMENT("Render: " + pRenderStage->Name);
-
-					if (pRenderStage->UsesCustomRenderer)
-					{
-						if ((pRenderStage->FrameCounter != pRenderStage->FrameOffset) && pRenderStage->pDisabledRenderPass == nullptr)
-						{
-							END_PROFILING_SEGMENT("Render: " + pRenderStage->Name);
-							continue;
-						}
-
-						CustomRenderer* pCustomRenderer = pRenderStage->pCustomRenderer;
-						pCustomRenderer->Render(
-							uint32(m_ModFrameIndex),
-							m_BackBufferIndex,
-							&m_ppExecutionStages[currentExecutionStage],
-							&m_ppExecutionStages[currentExecutionStage + 1],
-							pRenderStage->Sleeping);
-
-						currentExecutionStage += 2;
-					}
-					else
-					{
-						switch (pRenderStage->pPipelineState->GetType())
-						{
-						case EPipelineStateType::PIPELINE_STATE_TYPE_GRAPHICS:		ExecuteGraphicsRenderStage(pRenderStage,	pPipelineStage->ppGraphicsCommandAllocators[m_ModFrameIndex],	pPipelineStage->ppGraphicsCommandLists[m_ModFrameIndex],	&m_ppExecutionStages[currentExecutionStage]);	break;
-						case EPipelineStateType::PIPELINE_STATE_TYPE_COMPUTE:		ExecuteComputeRenderStage(pRenderStage,		pPipelineStage->ppComputeCommandAllocators[m_ModFrameIndex],	pPipelineStage->ppComputeCommandLists[m_ModFrameIndex],		&m_ppExecutionStages[currentExecutionStage]);	break;
-						case EPipelineStateType::PIPELINE_STATE_TYPE_RAY_TRACING:	ExecuteRayTracingRenderStage(pRenderStage,	pPipelineStage->ppComputeCommandAllocators[m_ModFrameIndex],	pPipelineStage->ppComputeCommandLists[m_ModFrameIndex],		&m_ppExecutionStages[currentExecutionStage]);	break;
-						}
-						currentExecutionStage++;
-					}
-
-					if (pRenderStage->TriggerType == ERenderStageExecutionTrigger::EVERY)
-					{
-						pRenderStage->FrameCounter++;
-
-						if (pRenderStage->FrameCounter > pRenderStage->FrameDelay)
-						{
-							pRenderStage->FrameCounter = 0;
-						}
-					}
-					else
-					{
-						//We set this to one, DISABLED and TRIGGERED wont trigger unless FrameCounter == 0
-						pRenderStage->FrameCounter = 1;
-					}
-
-					END_PROFILING_SEGMENT("Render: " + pRenderStage->Name);
-				}
-				else if (pPipelineStage->Type == ERenderGraphPipelineStageType::SYNCHRONIZATION)
-				{
-					SynchronizationStage* pSynchronizationStage = &m_pSynchronizationStages[pPipelineStage->StageIndex];
-
-					ExecuteSynchronizationStage(
-						pSynchronizationStage,
-						pPipelineStage->ppGraphicsCommandAllocators[m_ModFrameIndex],
-						pPipelineStage->ppGraphicsCommandLists[m_ModFrameIndex],
-						pPipelineStage->ppComputeCommandAllocators[m_ModFrameIndex],
-						pPipelineStage->ppComputeCommandLists[m_ModFrameIndex],
-						&m_ppExecutionStages[currentExecutionStage],
-						&m_ppExecutionStages[currentExecutionStage + 1]);
-
-					currentExecutionStage += 2;
-				}
+				RecordPipelineStage(p, true);
 			}
 		}
 		END_PROFILING_SEGMENT("Record Pipeline Stages");
@@ -947,8 +899,6 @@ namespace LambdaEngine
 		}
 		END_PROFILING_SEGMENT("Execute General Purpose Command Lists");
 
-		//Wait Threads
-
 		//Execute the recorded Command Lists, we do this in a Batched mode where we batch as many "same queue" command lists that execute in succession together. This reduced the overhead caused by QueueSubmit
 		BEGIN_PROFILING_SEGMENT("Execute Other Command Lists");
 		{
@@ -1213,11 +1163,24 @@ namespace LambdaEngine
 	void RenderGraph::ReleasePipelineStages()
 	{
 		SAFEDELETE_ARRAY(m_ppExecutionStages);
+		m_CustomRendererPipelineStages.Clear();
 
 		for (uint32 i = 0; i < m_PipelineStageCount; i++)
 		{
 			PipelineStage* pPipelineStage = &m_pPipelineStages[i];
 
+			if (pPipelineStage->ppAliasingCommandAllocators != nullptr)
+			{
+				for (uint32 b = 0; b < 2 * m_BackBufferCount; b++)
+				{
+					SAFERELEASE(pPipelineStage->ppAliasingCommandAllocators[b]);
+					SAFERELEASE(pPipelineStage->ppAliasingCommandLists[b]);
+				}
+
+				SAFEDELETE_ARRAY(pPipelineStage->ppAliasingCommandAllocators);
+				SAFEDELETE_ARRAY(pPipelineStage->ppAliasingCommandLists);
+			}
+
 			if (pPipelineStage->ppComputeCommandAllocators != nullptr)
 			{
 				for (uint32 b = 0; b < m_BackBufferCount; b++)
@@ -1388,11 +1351,39 @@ namespace LambdaEngine
 	{
 		Profiler::GetGPUProfiler()->Init(GPUProfiler::TimeUnit::MICRO);
 		Profiler::GetGPUProfiler()->CreateTimestamps(pipelineStageCount * m_BackBufferCount * 2);
-		Profiler::GetGPUProfiler()->CreateGraphicsPipelineStats();
+		Profiler::GetGPUProfiler()->CreateGraphicsPipelineStats(pipelineStageCount * m_BackBufferCount * 2);
 
 		return true;
 	}
 
+	void RenderGraph::PlanBarriers(const RenderGraphDesc* pDesc)
+	{
+		RenderGraphBarrierPlanner::Plan(*pDesc->pRenderGraphStructureDesc, m_BarrierPlan);
+
+		LOG_INFO("Render Graph \"%s\": %u redundant transitions dropped, %u pipeline barrier calls merged into %u",
+			pDesc->Name.c_str(),
+			m_BarrierPlan.DroppedTransitions,
+			m_BarrierPlan.BarrierCallsUnmerged,
+			m_BarrierPlan.BarrierCallsMerged);
+	}
+
+	void RenderGraph::PlanResourceAliasing(const RenderGraphDesc* pDesc)
+	{
+		// Sizes depend on the device and the window, the transient textures are placed when they are created
+		RenderGraphAliasingPlanner::AnalyzeLifetimes(*pDesc->pRenderGraphStructureDesc, m_AliasingPlan);
+
+		uint32 transientCount = 0;
+		for (const RenderGraphResourcePlacement& placement : m_AliasingPlan.Placements)
+		{
+			if (placement.Transient)
+			{
+				transientCount++;
+			}
+		}
+
+		LOG_INFO("Render Graph \"%s\": %u transient textures can share memory", pDesc->Name.c_str(), transientCount);
+	}
+
 	bool RenderGraph::CreateResources(const TArray<RenderGraphResourceDesc>& resourceDescriptions)
 	{
 		m_ResourceMap.reserve(resourceDescriptions.GetSize());
@@ -1777,6 +1768,65 @@ namespace LambdaEngine
 		return true;
 	}
 
+	void RenderGraph::LoadRenderStageShaders(const TArray<RenderStageDesc>& renderStages)
+	{
+		// The shaders of all render stages are compiled together, the per stage loads in CreateRenderStages then find them already loaded
+		TArray<ShaderFileLoadDesc> loadDescs;
+		auto addShader = [&loadDescs](const String& name, FShaderStageFlag stage)
+		{
+			if (!name.empty())
+			{
+				ShaderFileLoadDesc loadDesc = {};
+				loadDesc.Filepath	= name;
+				loadDesc.Stage		= stage;
+				loadDesc.Lang		= EShaderLang::SHADER_LANG_GLSL;
+				loadDescs.PushBack(loadDesc);
+			}
+		};
+
+		for (const RenderStageDesc& renderStageDesc : renderStages)
+		{
+			if (renderStageDesc.CustomRenderer)
+			{
+				continue;
+			}
+
+			if (renderStageDesc.Type == EPipelineStateType::PIPELINE_STATE_TYPE_GRAPHICS)
+			{
+				addShader(renderStageDesc.Graphics.Shaders.TaskShaderName,		FShaderStageFlag::SHADER_STAGE_FLAG_TASK_SHADER);
+				addShader(renderStageDesc.Graphics.Shaders.MeshShaderName,		FShaderStageFlag::SHADER_STAGE_FLAG_MESH_SHADER);
+				addShader(renderStageDesc.Graphics.Shaders.VertexShaderName,	FShaderStageFlag::SHADER_STAGE_FLAG_VERTEX_SHADER);
+				addShader(renderStageDesc.Graphics.Shaders.GeometryShaderName,	FShaderStageFlag::SHADER_STAGE_FLAG_GEOMETRY_SHADER);
+				addShader(renderStageDesc.Graphics.Shaders.HullShaderName,		FShaderStageFlag::SHADER_STAGE_FLAG_HULL_SHADER);
+				addShader(renderStageDesc.Graphics.Shaders.DomainShaderName,	FShaderStageFlag::SHADER_STAGE_FLAG_DOMAIN_SHADER);
+				addShader(renderStageDesc.Graphics.Shaders.PixelShaderName,		FShaderStageFlag::SHADER_STAGE_FLAG_PIXEL_SHADER);
+			}
+			else if (renderStageDesc.Type == EPipelineStateType::PIPELINE_STATE_TYPE_COMPUTE)
+			{
+				addShader(renderStageDesc.Compute.ShaderName, FShaderStageFlag::SHADER_STAGE_FLAG_COMPUTE_SHADER);
+			}
+			else if (renderStageDesc.Type == EPipelineStateType::PIPELINE_STATE_TYPE_RAY_TRACING)
+			{
+				addShader(renderStageDesc.RayTracing.Shaders.RaygenShaderName, FShaderStageFlag::SHADER_STAGE_FLAG_RAYGEN_SHADER);
+
+				for (uint32 h = 0; h < renderStageDesc.RayTracing.Shaders.HitGroupShaderCount; h++)
+				{
+					addShader(renderStageDesc.RayTracing.Shaders.pHitGroupShaderNames[h].ClosestHitShaderName,		FShaderStageFlag::SHADER_STAGE_FLAG_CLOSEST_HIT_SHADER);
+					addShader(renderStageDesc.RayTracing.Shaders.pHitGroupShaderNames[h].AnyHitShaderName,			FShaderStageFlag::SHADER_STAGE_FLAG_ANY_HIT_SHADER);
+					addShader(renderStageDesc.RayTracing.Shaders.pHitGroupShaderNames[h].IntersectionShaderName,	FShaderStageFlag::SHADER_STAGE_FLAG_INTERSECT_SHADER);
+				}
+
+				for (uint32 m = 0; m < renderStageDesc.RayTracing.Shaders.MissShaderCount; m++)
+				{
+					addShader(renderStageDesc.RayTracing.Shaders.pMissShaderNames[m], FShaderStageFlag::SHADER_STAGE_FLAG_MISS_SHADER);
+				}
+			}
+		}
+
+		TArray<GUID_Lambda> shaderGUIDs(loadDescs.GetSize());
+		ResourceManager::LoadShadersFromFile(loadDescs.GetData(), loadDescs.GetSize(), shaderGUIDs.GetData());
+	}
+
 	bool RenderGraph::CreateRenderStages(
 		const TArray<RenderStageDesc>& renderStages,
 		const THashTable<String, RenderGraphShaderConstants>& shaderConstants,
@@ -1787,6 +1837,8 @@ namespace LambdaEngine
 		m_RenderStageMap.reserve(m_RenderStageCount);
 		m_pRenderStages = DBG_NEW RenderStage[m_RenderStageCount];
 
+		LoadRenderStageShaders(renderStages);
+
 		for (uint32 renderStageIndex = 0; renderStageIndex < m_RenderStageCount; renderStageIndex++)
 		{
 			const RenderStageDesc* pRenderStageDesc = &renderStages[renderStageIndex];
@@ -2806,6 +2858,7 @@ namespace LambdaEngine
 		for (uint32 s = 0; s < synchronizationStageDescriptions.GetSize(); s++)
 		{
 			const SynchronizationStageDesc* pSynchronizationStageDesc = &synchronizationStageDescriptions[s];
+			const RenderGraphSynchronizationStagePlan* pSynchronizationStagePlan = s < m_BarrierPlan.Stages.GetSize() ? &m_BarrierPlan.Stages[s] : nullptr;
 
 			SynchronizationStage* pSynchronizationStage = &m_pSynchronizationStages[s];
 			ECommandQueueType otherQueue = ECommandQueueType::COMMAND_QUEUE_TYPE_NONE;
@@ -2814,6 +2867,18 @@ namespace LambdaEngine
 			{
 				const RenderGraphResourceSynchronizationDesc* pResourceSynchronizationDesc = &(*synchronizationIt);
 
+				// Duplicated transitions never get a barrier, reads after reads are checked against the previous barrier below
+				ERenderGraphBarrierDropReason dropReason = ERenderGraphBarrierDropReason::NONE;
+				if (pSynchronizationStagePlan != nullptr)
+				{
+					const uint32 synchronizationIndex = uint32(pResourceSynchronizationDesc - pSynchronizationStageDesc->Synchronizations.GetData());
+					dropReason = pSynchronizationStagePlan->Barriers[synchronizationIndex].DropReason;
+					if (dropReason == ERenderGraphBarrierDropReason::DUPLICATE)
+					{
+						continue;
+					}
+				}
+
 				//En massa skit kommer nog beh�va g�ras om h�r, nu n�r Parsern tar hand om Back Buffer States korrekt.
 
 				auto it = m_ResourceMap.find(pResourceSynchronizationDesc->ResourceName);
@@ -2865,6 +2930,11 @@ namespace LambdaEngine
 				uint32 srcMemoryAccessFlags		= CalculateResourceAccessFlags(pResourceSynchronizationDesc->PrevBindingType);
 				uint32 dstMemoryAccessFlags		= CalculateResourceAccessFlags(pResourceSynchronizationDesc->NextBindingType);
 
+				if (dropReason == ERenderGraphBarrierDropReason::READ_AFTER_READ && CoverReadAfterRead(pResource, nextQueue, dstMemoryAccessFlags, pNextRenderStage->FirstPipelineStage))
+				{
+					continue;
+				}
+
 				if (pSynchronizationStage->ExecutionQueue == ECommandQueueType::COMMAND_QUEUE_TYPE_NONE)
 				{
 					pSynchronizationStage->ExecutionQueue = prevQueue;
@@ -3145,11 +3215,91 @@ namespace LambdaEngine
 		return true;
 	}
 
+	bool RenderGraph::CoverReadAfterRead(Resource* pResource, ECommandQueueType queue, uint32 dstMemoryAccessFlags, FPipelineStageFlags firstPipelineStage)
+	{
+		/*
+		* A read after a read needs no barrier of its own when the barrier that made the resource readable also covers the
+		* new reader. That barrier is the last one recorded for the resource, since synchronization stages are created in
+		* execution order. When it waits for a later pipeline stage or for other accesses it is widened to cover the reader.
+		*/
+		if (pResource->BarriersPerSynchronizationStage.IsEmpty() || (pResource->Type != ERenderGraphResourceType::TEXTURE && pResource->Type != ERenderGraphResourceType::BUFFER))
+		{
+			return false;
+		}
+
+		const ResourceBarrierInfo lastBarrierInfo = pResource->BarriersPerSynchronizationStage.GetBack();
+		SynchronizationStage* pPrevSynchronizationStage = &m_pSynchronizationStages[lastBarrierInfo.SynchronizationStageIndex];
+
+		// Gather the barriers of the last synchronization, there is one per sub resource
+		TArray<uint32*> dstMemoryAccessFlagsToWiden;
+		ECommandQueueType queueBefore	= ECommandQueueType::COMMAND_QUEUE_TYPE_NONE;
+		ECommandQueueType queueAfter	= ECommandQueueType::COMMAND_QUEUE_TYPE_NONE;
+		for (int32 b = int32(pResource->BarriersPerSynchronizationStage.GetSize()) - 1; b >= 0; b--)
+		{
+			const ResourceBarrierInfo& barrierInfo = pResource->BarriersPerSynchronizationStage[b];
+			if (barrierInfo.SynchronizationStageIndex != lastBarrierInfo.SynchronizationStageIndex || barrierInfo.SynchronizationTypeIndex != lastBarrierInfo.SynchronizationTypeIndex)
+			{
+				break;
+			}
+
+			if (pResource->Type == ERenderGraphResourceType::BUFFER)
+			{
+				PipelineBufferBarrierDesc& bufferBarrier = pPrevSynchronizationStage->BufferBarriers[barrierInfo.SynchronizationTypeIndex][barrierInfo.BarrierIndex];
+				dstMemoryAccessFlagsToWiden.PushBack(&bufferBarrier.DstMemoryAccessFlags);
+				queueBefore	= bufferBarrier.QueueBefore;
+				queueAfter	= bufferBarrier.QueueAfter;
+			}
+			else if (pResource->Texture.UnboundedArray)
+			{
+				for (PipelineTextureBarrierDesc& textureBarrier : pPrevSynchronizationStage->UnboundedTextureBarriers[barrierInfo.SynchronizationTypeIndex][barrierInfo.BarrierIndex])
+				{
+					dstMemoryAccessFlagsToWiden.PushBack(&textureBarrier.DstMemoryAccessFlags);
+					queueBefore	= textureBarrier.QueueBefore;
+					queueAfter	= textureBarrier.QueueAfter;
+				}
+			}
+			else
+			{
+				PipelineTextureBarrierDesc& textureBarrier = pPrevSynchronizationStage->TextureBarriers[barrierInfo.SynchronizationTypeIndex][barrierInfo.BarrierIndex];
+				dstMemoryAccessFlagsToWiden.PushBack(&textureBarrier.DstMemoryAccessFlags);
+				queueBefore	= textureBarrier.QueueBefore;
+				queueAfter	= textureBarrier.QueueAfter;
+			}
+		}
+
+		// The previous barrier has to make the resource available on the queue of the reader
+		if (dstMemoryAccessFlagsToWiden.IsEmpty() || queueAfter != queue)
+		{
+			return false;
+		}
+
+		FPipelineStageFlags& dstPipelineStage = queueBefore == queueAfter ? pPrevSynchronizationStage->SameQueueDstPipelineStage : pPrevSynchronizationStage->OtherQueueDstPipelineStage;
+		const FPipelineStageFlags widenedDstPipelineStage = FindEarliestCompatiblePipelineStage(dstPipelineStage | firstPipelineStage, queue);
+
+		dstPipelineStage = widenedDstPipelineStage;
+		for (uint32* pDstMemoryAccessFlags : dstMemoryAccessFlagsToWiden)
+		{
+			(*pDstMemoryAccessFlags) |= dstMemoryAccessFlags;
+		}
+
+		return true;
+	}
+
 	bool RenderGraph::CreatePipelineStages(const TArray<PipelineStageDesc>& pipelineStageDescriptions)
 	{
 		m_PipelineStageCount = (uint32)pipelineStageDescriptions.GetSize();
 		m_pPipelineStages = DBG_NEW PipelineStage[m_PipelineStageCount];
 
+		// Stages that start the lifetime of a transient texture may have to discard the content of the texture it aliases
+		TArray<bool> startsTransientLifetime(m_PipelineStageCount, false);
+		for (const RenderGraphResourcePlacement& placement : m_AliasingPlan.Placements)
+		{
+			if (placement.Transient && placement.FirstPipelineStage < m_PipelineStageCount)
+			{
+				startsTransientLifetime[placement.FirstPipelineStage] = true;
+			}
+		}
+
 		String pipelineStageName = "";
 
 		for (uint32 i = 0; i < m_PipelineStageCount; i++)
@@ -3160,12 +3310,47 @@ namespace LambdaEngine
 
 			bool createCommandLists = true;
 
+			if (startsTransientLifetime[i])
+			{
+				pPipelineStage->AliasingExecutionStageIndex = m_ExecutionStageCount;
+				m_ExecutionStageCount += 2;
+
+				pPipelineStage->ppAliasingCommandAllocators	= DBG_NEW CommandAllocator*[2 * m_BackBufferCount];
+				pPipelineStage->ppAliasingCommandLists		= DBG_NEW CommandList*[2 * m_BackBufferCount];
+
+				for (uint32 q = 0; q < 2; q++)
+				{
+					const ECommandQueueType queueType = q == 0 ? ECommandQueueType::COMMAND_QUEUE_TYPE_GRAPHICS : ECommandQueueType::COMMAND_QUEUE_TYPE_COMPUTE;
+
+					for (uint32 f = 0; f < m_BackBufferCount; f++)
+					{
+						CommandAllocator*& pCommandAllocator = pPipelineStage->ppAliasingCommandAllocators[q * m_BackBufferCount + f];
+						pCommandAllocator = m_pGraphicsDevice->CreateCommandAllocator("Render Graph Aliasing Command Allocator", queueType);
+
+						CommandListDesc aliasingCommandListDesc = {};
+						aliasingCommandListDesc.DebugName		= "Render Graph Aliasing Command List";
+						aliasingCommandListDesc.CommandListType	= ECommandListType::COMMAND_LIST_TYPE_PRIMARY;
+						aliasingCommandListDesc.Flags			= FCommandListFlag::COMMAND_LIST_FLAG_ONE_TIME_SUBMIT;
+
+						pPipelineStage->ppAliasingCommandLists[q * m_BackBufferCount + f] = m_pGraphicsDevice->CreateCommandList(pCommandAllocator, &aliasingCommandListDesc);
+					}
+				}
+			}
+
+			pPipelineStage->ExecutionStageIndex = m_ExecutionStageCount;
+
 			if (pPipelineStageDesc->Type == ERenderGraphPipelineStageType::RENDER)
 			{
 				bool usesCustomRenderer = m_pRenderStages[pPipelineStageDesc->StageIndex].UsesCustomRenderer;
 				createCommandLists = !usesCustomRenderer;
 				m_ExecutionStageCount += usesCustomRenderer ? 2 : 1;
 				pipelineStageName = m_pRenderStages[pPipelineStageDesc->StageIndex].Name;
+
+				pPipelineStage->UsesCustomRenderer = usesCustomRenderer;
+				if (usesCustomRenderer)
+				{
+					m_CustomRendererPipelineStages.PushBack(i);
+				}
 			}
 			else if (pPipelineStageDesc->Type == ERenderGraphPipelineStageType::SYNCHRONIZATION)
 			{
@@ -3388,6 +3573,151 @@ namespace LambdaEngine
 		}
 	}
 
+	bool RenderGraph::PlaceTransientResources()
+	{
+		// Transient textures depend on the offsets of each other, so all of them are placed again when one changes
+		bool placementDirty = false;
+		for (const RenderGraphResourcePlacement& placement : m_AliasingPlan.Placements)
+		{
+			if (placement.Transient && m_DirtyInternalResources.count(placement.ResourceName) > 0)
+			{
+				placementDirty = true;
+				break;
+			}
+		}
+
+		if (!placementDirty)
+		{
+			return false;
+		}
+
+		for (RenderGraphResourcePlacement& placement : m_AliasingPlan.Placements)
+		{
+			if (placement.Transient)
+			{
+				// The description still points at the old heap, the requirements do not depend on it
+				const TextureDesc& textureDesc = m_InternalResourceUpdateDescriptions[placement.ResourceName].TextureUpdate.TextureDesc;
+
+				ResourceMemoryRequirements memoryRequirements = {};
+				if (m_pGraphicsDevice->QueryTextureMemoryRequirements(&textureDesc, &memoryRequirements))
+				{
+					placement.SizeInBytes		= memoryRequirements.SizeInBytes;
+					placement.Alignment			= memoryRequirements.Alignment;
+					placement.MemoryTypeBits	= memoryRequirements.MemoryTypeBits;
+				}
+				else
+				{
+					placement.SizeInBytes = 0;
+				}
+			}
+		}
+
+		RenderGraphAliasingPlanner::PlaceResources(m_AliasingPlan);
+
+		const bool heapTooSmall			= m_pTransientHeap != nullptr && m_pTransientHeap->GetDesc().SizeInBytes < m_AliasingPlan.HeapSizeInBytes;
+		const bool heapTypeUnsupported	= m_pTransientHeap != nullptr && (m_pTransientHeap->GetDesc().MemoryTypeBits & m_AliasingPlan.HeapMemoryTypeBits) != m_pTransientHeap->GetDesc().MemoryTypeBits;
+		if ((m_pTransientHeap == nullptr || heapTooSmall || heapTypeUnsupported) && m_AliasingPlan.HeapSizeInBytes > 0)
+		{
+			MemoryHeapDesc memoryHeapDesc = {};
+			memoryHeapDesc.DebugName		= "Render Graph Transient Heap";
+			memoryHeapDesc.MemoryType		= EMemoryType::MEMORY_TYPE_GPU;
+			memoryHeapDesc.SizeInBytes		= m_AliasingPlan.HeapSizeInBytes;
+			memoryHeapDesc.MemoryTypeBits	= m_AliasingPlan.HeapMemoryTypeBits;
+
+			// Textures that are still placed in the old heap keep it alive until they are recreated below
+			SAFERELEASE(m_pTransientHeap);
+			m_pTransientHeap = m_pGraphicsDevice->CreateMemoryHeap(&memoryHeapDesc);
+
+			if (m_pTransientHeap == nullptr)
+			{
+				LOG_WARNING("Render Graph failed to create the Transient Heap, transient textures get their own allocations");
+			}
+		}
+
+		uint32 placedCount = 0;
+		for (const RenderGraphResourcePlacement& placement : m_AliasingPlan.Placements)
+		{
+			auto resourceUpdateDescIt = m_InternalResourceUpdateDescriptions.find(placement.ResourceName);
+			if (resourceUpdateDescIt == m_InternalResourceUpdateDescriptions.end() || resourceUpdateDescIt->second.Type != ERenderGraphResourceType::TEXTURE)
+			{
+				continue;
+			}
+
+			TextureDesc& textureDesc = resourceUpdateDescIt->second.TextureUpdate.TextureDesc;
+			const bool placed = placement.Transient && m_pTransientHeap != nullptr;
+			if (placed || textureDesc.pMemoryHeap != nullptr)
+			{
+				textureDesc.pMemoryHeap			= placed ? m_pTransientHeap : nullptr;
+				textureDesc.MemoryHeapOffset	= placed ? placement.Offset : 0;
+				m_DirtyInternalResources.insert(placement.ResourceName);
+			}
+
+			if (placed)
+			{
+				placedCount++;
+			}
+		}
+
+		constexpr const float64 BYTES_TO_MB = 1.0 / (1024.0 * 1024.0);
+		LOG_INFO("Render Graph: %u transient textures placed, %.2f MB without aliasing, %.2f MB with aliasing",
+			placedCount,
+			float64(m_AliasingPlan.TransientSizeWithoutAliasing) * BYTES_TO_MB,
+			float64(m_AliasingPlan.HeapSizeInBytes) * BYTES_TO_MB);
+
+		return true;
+	}
+
+	void RenderGraph::UpdateAliasingBarriers()
+	{
+		for (uint32 p = 0; p < m_PipelineStageCount; p++)
+		{
+			m_pPipelineStages[p].AliasingTextureBarriers[0].Clear();
+			m_pPipelineStages[p].AliasingTextureBarriers[1].Clear();
+		}
+
+		for (const RenderGraphAliasingBarrier& aliasingBarrier : m_AliasingPlan.AliasingBarriers)
+		{
+			const RenderGraphResourcePlacement& placement = m_AliasingPlan.Placements[aliasingBarrier.PlacementIndex];
+
+			auto resourceIt = m_ResourceMap.find(placement.ResourceName);
+			if (resourceIt == m_ResourceMap.end() || resourceIt->second.Texture.Textures.IsEmpty())
+			{
+				continue;
+			}
+
+			const Resource* pResource = &resourceIt->second;
+			Texture* pTexture = pResource->Texture.Textures[0];
+			if (pTexture == nullptr || pTexture->GetDesc().pMemoryHeap == nullptr)
+			{
+				continue;
+			}
+
+			// The previous content belongs to another texture, discard it and move to the state the first reference expects
+			PipelineTextureBarrierDesc textureBarrier = {};
+			textureBarrier.pTexture				= pTexture;
+			textureBarrier.StateBefore			= ETextureState::TEXTURE_STATE_UNKNOWN;
+			textureBarrier.StateAfter			= CalculateResourceTextureState(pResource->Type, placement.FrameStartBindingType, pResource->Texture.Format);
+			textureBarrier.QueueBefore			= placement.FrameStartQueue;
+			textureBarrier.QueueAfter			= placement.FrameStartQueue;
+			textureBarrier.SrcMemoryAccessFlags	= FMemoryAccessFlag::MEMORY_ACCESS_FLAG_MEMORY_WRITE;
+			textureBarrier.DstMemoryAccessFlags	= FMemoryAccessFlag::MEMORY_ACCESS_FLAG_MEMORY_READ | FMemoryAccessFlag::MEMORY_ACCESS_FLAG_MEMORY_WRITE;
+			textureBarrier.TextureFlags			= pResource->Texture.Format == EFormat::FORMAT_D24_UNORM_S8_UINT ? FTextureFlag::TEXTURE_FLAG_DEPTH_STENCIL : 0;
+			textureBarrier.Miplevel				= 0;
+			textureBarrier.MiplevelCount		= pTexture->GetDesc().Miplevels;
+			textureBarrier.ArrayIndex			= 0;
+			textureBarrier.ArrayCount			= pTexture->GetDesc().ArrayCount;
+
+			// Render passes start from an undefined layout on their own
+			if (textureBarrier.StateAfter == ETextureState::TEXTURE_STATE_UNKNOWN)
+			{
+				continue;
+			}
+
+			const uint32 queueIndex = placement.FrameStartQueue == ECommandQueueType::COMMAND_QUEUE_TYPE_GRAPHICS ? 0 : 1;
+			m_pPipelineStages[aliasingBarrier.PipelineStage].AliasingTextureBarriers[queueIndex].PushBack(textureBarrier);
+		}
+	}
+
 	void RenderGraph::UpdateResourceTexture(Resource* pResource, const ResourceUpdateDesc* pDesc)
 	{
 		uint32 actualSubResourceCount = 0;
@@ -3458,6 +3788,16 @@ namespace LambdaEngine
 				SAFERELEASE(*ppTextureView);
 
 				pTexture = m_pGraphicsDevice->CreateTexture(pTextureDesc);
+				if (pTexture == nullptr && pTextureDesc->pMemoryHeap != nullptr)
+				{
+					// Aliasing only saves memory, a texture that can not be placed gets its own allocation
+					LOG_WARNING("Resource \"%s\" could not be placed in the Transient Heap", pResource->Name.c_str());
+
+					TextureDesc dedicatedTextureDesc = *pTextureDesc;
+					dedicatedTextureDesc.pMemoryHeap		= nullptr;
+					dedicatedTextureDesc.MemoryHeapOffset	= 0;
+					pTexture = m_pGraphicsDevice->CreateTexture(&dedicatedTextureDesc);
+				}
 
 				textureViewDesc.pTexture = pTexture;
 				pTextureView = m_pGraphicsDevice->CreateTextureView(&textureViewDesc);
@@ -4167,6 +4507,144 @@ namespace LambdaEngine
 		}
 	}
 
+	void RenderGraph::RecordPipelineStage(uint32 pipelineStageIndex, bool profileCPU)
+	{
+		PipelineStage* pPipelineStage = &m_pPipelineStages[pipelineStageIndex];
+		CommandList** ppExecutionStages = &m_ppExecutionStages[pPipelineStage->ExecutionStageIndex];
+
+		if (pPipelineStage->ppAliasingCommandLists != nullptr)
+		{
+			RecordAliasingBarriers(pPipelineStage);
+		}
+
+		if (pPipelineStage->Type == ERenderGraphPipelineStageType::RENDER)
+		{
+			RenderStage* pRenderStage = &m_pRenderStages[pPipelineStage->StageIndex];
+			if (profileCPU)
+			{
+				BEGIN_PROFILING_SEGMENT("Render: " + pRenderStage->Name);
+			}
+
+			if (pRenderStage->UsesCustomRenderer)
+			{
+				if ((pRenderStage->FrameCounter != pRenderStage->FrameOffset) && pRenderStage->pDisabledRenderPass == nullptr)
+				{
+					if (profileCPU)
+					{
+						END_PROFILING_SEGMENT("Render: " + pRenderStage->Name);
+					}
+					return;
+				}
+
+				CustomRenderer* pCustomRenderer = pRenderStage->pCustomRenderer;
+				pCustomRenderer->Render(
+					uint32(m_ModFrameIndex),
+					m_BackBufferIndex,
+					&ppExecutionStages[0],
+					&ppExecutionStages[1],
+					pRenderStage->Sleeping);
+			}
+			else
+			{
+				switch (pRenderStage->pPipelineState->GetType())
+				{
+				case EPipelineStateType::PIPELINE_STATE_TYPE_GRAPHICS:		ExecuteGraphicsRenderStage(pRenderStage,	pPipelineStage->ppGraphicsCommandAllocators[m_ModFrameIndex],	pPipelineStage->ppGraphicsCommandLists[m_ModFrameIndex],	&ppExecutionStages[0]);	break;
+				case EPipelineStateType::PIPELINE_STATE_TYPE_COMPUTE:		ExecuteComputeRenderStage(pRenderStage,		pPipelineStage->ppComputeCommandAllocators[m_ModFrameIndex],	pPipelineStage->ppComputeCommandLists[m_ModFrameIndex],		&ppExecutionStages[0]);	break;
+				case EPipelineStateType::PIPELINE_STATE_TYPE_RAY_TRACING:	ExecuteRayTracingRenderStage(pRenderStage,	pPipelineStage->ppComputeCommandAllocators[m_ModFrameIndex],	pPipelineStage->ppComputeCommandLists[m_ModFrameIndex],		&ppExecutionStages[0]);	break;
+				}
+			}
+
+			if (pRenderStage->TriggerType == ERenderStageExecutionTrigger::EVERY)
+			{
+				pRenderStage->FrameCounter++;
+
+				if (pRenderStage->FrameCounter > pRenderStage->FrameDelay)
+				{
+					pRenderStage->FrameCounter = 0;
+				}
+			}
+			else
+			{
+				//We set this to one, DISABLED and TRIGGERED wont trigger unless FrameCounter == 0
+				pRenderStage->FrameCounter = 1;
+			}
+
+			if (profileCPU)
+			{
+				END_PROFILING_SEGMENT("Render: " + pRenderStage->Name);
+			}
+		}
+		else if (pPipelineStage->Type == ERenderGraphPipelineStageType::SYNCHRONIZATION)
+		{
+			SynchronizationStage* pSynchronizationStage = &m_pSynchronizationStages[pPipelineStage->StageIndex];
+
+			ExecuteSynchronizationStage(
+				pSynchronizationStage,
+				pPipelineStage->ppGraphicsCommandAllocators[m_ModFrameIndex],
+				pPipelineStage->ppGraphicsCommandLists[m_ModFrameIndex],
+				pPipelineStage->ppComputeCommandAllocators[m_ModFrameIndex],
+				pPipelineStage->ppComputeCommandLists[m_ModFrameIndex],
+				&ppExecutionStages[0],
+				&ppExecutionStages[1]);
+		}
+	}
+
+	void RenderGraph::RecordAliasingBarriers(PipelineStage* pPipelineStage)
+	{
+		for (uint32 q = 0; q < 2; q++)
+		{
+			const TArray<PipelineTextureBarrierDesc>& textureBarriers = pPipelineStage->AliasingTextureBarriers[q];
+			if (textureBarriers.IsEmpty())
+			{
+				continue;
+			}
+
+			CommandAllocator* pCommandAllocator	= pPipelineStage->ppAliasingCommandAllocators[q * m_BackBufferCount + m_ModFrameIndex];
+			CommandList* pCommandList			= pPipelineStage->ppAliasingCommandLists[q * m_BackBufferCount + m_ModFrameIndex];
+
+			pCommandAllocator->Reset();
+			pCommandList->Begin(nullptr);
+
+			// Earlier work in the frame may still use the memory through the aliased texture
+			for (uint32 b = 0; b < textureBarriers.GetSize(); b += MAX_IMAGE_BARRIERS)
+			{
+				pCommandList->PipelineTextureBarriers(
+					FPipelineStageFlag::PIPELINE_STAGE_FLAG_ALL_STAGES,
+					FPipelineStageFlag::PIPELINE_STAGE_FLAG_ALL_STAGES,
+					&textureBarriers[b],
+					glm::min(textureBarriers.GetSize() - b, MAX_IMAGE_BARRIERS));
+			}
+
+			pCommandList->End();
+
+			m_ppExecutionStages[pPipelineStage->AliasingExecutionStageIndex + q] = pCommandList;
+		}
+	}
+
+	void RenderGraph::RecordPipelineStagesParallel()
+	{
+		// Every pipeline stage owns its allocators, command lists and execution slots so stages can be recorded in any order.
+		// The CPU profiler keeps a single segment stack, so only the calling thread profiles its stages
+		auto recordStage = [this](uint32 p)
+		{
+			if (!m_pPipelineStages[p].UsesCustomRenderer)
+			{
+				RecordPipelineStage(p, false);
+			}
+		};
+
+		// Custom renderers can acquire the general purpose command lists, which are not thread safe
+		auto recordCustomRendererStages = [this]()
+		{
+			for (uint32 p : m_CustomRendererPipelineStages)
+			{
+				RecordPipelineStage(p, true);
+			}
+		};
+
+		ThreadPool::ParallelFor(m_PipelineStageCount, recordStage, recordCustomRendererStages);
+	}
+
 	void RenderGraph::ExecuteSynchronizationStage(
 		SynchronizationStage*	pSynchronizationStage,
 		CommandAllocator*		pGraphicsCommandAllocator,
@@ -4204,62 +4682,61 @@ namespace LambdaEngine
 			pSecondExecutionCommandList = pGraphicsCommandList;
 		}
 
+		// Gather every barrier of the stage per queue, so each destination becomes a single pipeline barrier
+		TArray<PipelineTextureBarrierDesc>& sameQueueTextureBarriers	= pSynchronizationStage->MergedTextureBarriers[0];
+		TArray<PipelineTextureBarrierDesc>& otherQueueTextureBarriers	= pSynchronizationStage->MergedTextureBarriers[1];
+		TArray<PipelineBufferBarrierDesc>& sameQueueBufferBarriers		= pSynchronizationStage->MergedBufferBarriers[0];
+		TArray<PipelineBufferBarrierDesc>& otherQueueBufferBarriers		= pSynchronizationStage->MergedBufferBarriers[1];
+		sameQueueTextureBarriers.Clear();
+		otherQueueTextureBarriers.Clear();
+		sameQueueBufferBarriers.Clear();
+		otherQueueBufferBarriers.Clear();
+
 		//Texture Synchronizations
 		{
 			const TArray<PipelineTextureBarrierDesc>& sameQueueBackBufferBarriers	= pSynchronizationStage->TextureBarriers[SAME_QUEUE_BACK_BUFFER_BOUND_SYNCHRONIZATION_INDEX];
-			const TArray<PipelineTextureBarrierDesc>& sameQueueTextureBarriers		= pSynchronizationStage->TextureBarriers[SAME_QUEUE_TEXTURE_SYNCHRONIZATION_INDEX];
 			const TArray<PipelineTextureBarrierDesc>& otherQueueBackBufferBarriers	= pSynchronizationStage->TextureBarriers[OTHER_QUEUE_BACK_BUFFER_BOUND_SYNCHRONIZATION_INDEX];
-			const TArray<PipelineTextureBarrierDesc>& otherQueueTextureBarriers		= pSynchronizationStage->TextureBarriers[OTHER_QUEUE_TEXTURE_SYNCHRONIZATION_INDEX];
 
 			if (sameQueueBackBufferBarriers.GetSize() > 0)
 			{
-				pFirstExecutionCommandList->PipelineTextureBarriers(pSynchronizationStage->SrcPipelineStage, pSynchronizationStage->SameQueueDstPipelineStage, &otherQueueBackBufferBarriers[m_BackBufferIndex], 1);
+				sameQueueTextureBarriers.PushBack(sameQueueBackBufferBarriers[m_BackBufferIndex]);
 			}
 
-			if (sameQueueTextureBarriers.GetSize() > 0)
+			if (otherQueueBackBufferBarriers.GetSize() > 0)
 			{
-				pFirstExecutionCommandList->PipelineTextureBarriers(pSynchronizationStage->SrcPipelineStage, pSynchronizationStage->SameQueueDstPipelineStage, sameQueueTextureBarriers.GetData(), sameQueueTextureBarriers.GetSize());
+				otherQueueTextureBarriers.PushBack(otherQueueBackBufferBarriers[m_BackBufferIndex]);
 			}
 
-			if (otherQueueBackBufferBarriers.GetSize() > 0)
+			for (const PipelineTextureBarrierDesc& textureBarrier : pSynchronizationStage->TextureBarriers[SAME_QUEUE_TEXTURE_SYNCHRONIZATION_INDEX])
 			{
-				const PipelineTextureBarrierDesc* pTextureBarrier = &otherQueueBackBufferBarriers[m_BackBufferIndex];
-				pFirstExecutionCommandList->PipelineTextureBarriers(pSynchronizationStage->SrcPipelineStage, pSynchronizationStage->OtherQueueDstPipelineStage, pTextureBarrier, 1);
-				pSecondExecutionCommandList->PipelineTextureBarriers(pSynchronizationStage->SrcPipelineStage, pSynchronizationStage->OtherQueueDstPipelineStage, pTextureBarrier, 1);
-				(*ppSecondExecutionStage) = pSecondExecutionCommandList;
+				sameQueueTextureBarriers.PushBack(textureBarrier);
 			}
 
-			if (otherQueueTextureBarriers.GetSize() > 0)
+			for (const PipelineTextureBarrierDesc& textureBarrier : pSynchronizationStage->TextureBarriers[OTHER_QUEUE_TEXTURE_SYNCHRONIZATION_INDEX])
 			{
-				pFirstExecutionCommandList->PipelineTextureBarriers(pSynchronizationStage->SrcPipelineStage, pSynchronizationStage->OtherQueueDstPipelineStage, otherQueueTextureBarriers.GetData(), otherQueueTextureBarriers.GetSize());
-				pSecondExecutionCommandList->PipelineTextureBarriers(pSynchronizationStage->SrcPipelineStage, pSynchronizationStage->OtherQueueDstPipelineStage, otherQueueTextureBarriers.GetData(), otherQueueTextureBarriers.GetSize());
-				(*ppSecondExecutionStage) = pSecondExecutionCommandList;
+				otherQueueTextureBarriers.PushBack(textureBarrier);
 			}
 
-			const TArray<TArray<PipelineTextureBarrierDesc>>& sameQueueUnboundedTextureBarrierArrays	= pSynchronizationStage->UnboundedTextureBarriers[SAME_QUEUE_UNBOUNDED_TEXTURE_SYNCHRONIZATION_INDEX];
-			const TArray<TArray<PipelineTextureBarrierDesc>>& otherQueueUnboundedTextureBarrierArrays	= pSynchronizationStage->UnboundedTextureBarriers[OTHER_QUEUE_UNBOUNDED_TEXTURE_SYNCHRONIZATION_INDEX];
-
-			for (const TArray<PipelineTextureBarrierDesc>& sameQueueUnboundedTextureBarriers : sameQueueUnboundedTextureBarrierArrays)
+			for (const TArray<PipelineTextureBarrierDesc>& unboundedTextureBarriers : pSynchronizationStage->UnboundedTextureBarriers[SAME_QUEUE_UNBOUNDED_TEXTURE_SYNCHRONIZATION_INDEX])
 			{
-				UNREFERENCED_VARIABLE(sameQueueUnboundedTextureBarriers);
-
-				if (sameQueueTextureBarriers.GetSize() > 0)
+				if (unboundedTextureBarriers.GetSize() > 0 && unboundedTextureBarriers[0].pTexture != nullptr)
 				{
-					pFirstExecutionCommandList->PipelineTextureBarriers(pSynchronizationStage->SrcPipelineStage, pSynchronizationStage->SameQueueDstPipelineStage, sameQueueTextureBarriers.GetData(), sameQueueTextureBarriers.GetSize());
+					for (const PipelineTextureBarrierDesc& textureBarrier : unboundedTextureBarriers)
+					{
+						sameQueueTextureBarriers.PushBack(textureBarrier);
+					}
 				}
 			}
 
-			for (const TArray<PipelineTextureBarrierDesc>& otherQueueUnboundedTextureBarriers : otherQueueUnboundedTextureBarrierArrays)
+			for (const TArray<PipelineTextureBarrierDesc>& unboundedTextureBarriers : pSynchronizationStage->UnboundedTextureBarriers[OTHER_QUEUE_UNBOUNDED_TEXTURE_SYNCHRONIZATION_INDEX])
 			{
-				UNREFERENCED_VARIABLE(otherQueueUnboundedTextureBarriers);
-
-				if (otherQueueTextureBarriers.GetSize() > 0)
+				if (unboundedTextureBarriers.GetSize() > 0 && unboundedTextureBarriers[0].pTexture != nullptr)
 				{
-					pFirstExecutionCommandList->PipelineTextureBarriers(pSynchronizationStage->SrcPipelineStage, pSynchronizationStage->SameQueueDstPipelineStage, otherQueueTextureBarriers.GetData(), otherQueueTextureBarriers.GetSize());
-					pSecondExecutionCommandList->PipelineTextureBarriers(pSynchronizationStage->SrcPipelineStage, pSynchronizationStage->OtherQueueDstPipelineStage, otherQueueTextureBarriers.GetData(), otherQueueTextureBarriers.GetSize());
+					for (const PipelineTextureBarrierDesc& textureBarrier : unboundedTextureBarriers)
+					{
+						otherQueueTextureBarriers.PushBack(textureBarrier);
+					}
 				}
-
-				(*ppSecondExecutionStage) = pSecondExecutionCommandList;
 			}
 		}
 
@@ -4270,14 +4747,18 @@ namespace LambdaEngine
 
 			if (sameQueueDrawTextureBarriers.GetSize() > 0 && sameQueueDrawTextureBarriers[0].pTexture != nullptr)
 			{
-				PipelineTextureBarriers(pFirstExecutionCommandList, sameQueueDrawTextureBarriers, pSynchronizationStage->SrcPipelineStage, pSynchronizationStage->SameQueueDstPipelineStage);
+				for (const PipelineTextureBarrierDesc& textureBarrier : sameQueueDrawTextureBarriers)
+				{
+					sameQueueTextureBarriers.PushBack(textureBarrier);
+				}
 			}
 
 			if (otherQueueDrawTextureBarriers.GetSize() > 0 && otherQueueDrawTextureBarriers[0].pTexture != nullptr)
 			{
-				PipelineTextureBarriers(pFirstExecutionCommandList, otherQueueDrawTextureBarriers, pSynchronizationStage->SrcPipelineStage, pSynchronizationStage->OtherQueueDstPipelineStage);
-				PipelineTextureBarriers(pSecondExecutionCommandList, otherQueueDrawTextureBarriers, pSynchronizationStage->SrcPipelineStage, pSynchronizationStage->OtherQueueDstPipelineStage);
-				(*ppSecondExecutionStage) = pSecondExecutionCommandList; // Can I do this like normal textures?
+				for (const PipelineTextureBarrierDesc& textureBarrier : otherQueueDrawTextureBarriers)
+				{
+					otherQueueTextureBarriers.PushBack(textureBarrier);
+				}
 			}
 		}
 
@@ -4288,31 +4769,67 @@ namespace LambdaEngine
 
 			if (sameQueueDrawBufferBarriers.GetSize() > 0 && sameQueueDrawBufferBarriers[0].pBuffer != nullptr)
 			{
-				PipelineBufferBarriers(pFirstExecutionCommandList, sameQueueDrawBufferBarriers, pSynchronizationStage->SrcPipelineStage, pSynchronizationStage->SameQueueDstPipelineStage);
+				for (const PipelineBufferBarrierDesc& bufferBarrier : sameQueueDrawBufferBarriers)
+				{
+					sameQueueBufferBarriers.PushBack(bufferBarrier);
+				}
 			}
 
 			if (otherQueueDrawBufferBarriers.GetSize() > 0 && otherQueueDrawBufferBarriers[0].pBuffer != nullptr)
 			{
-				PipelineBufferBarriers(pFirstExecutionCommandList, otherQueueDrawBufferBarriers, pSynchronizationStage->SrcPipelineStage, pSynchronizationStage->OtherQueueDstPipelineStage);
-				PipelineBufferBarriers(pSecondExecutionCommandList, otherQueueDrawBufferBarriers, pSynchronizationStage->SrcPipelineStage, pSynchronizationStage->OtherQueueDstPipelineStage);
-				(*ppSecondExecutionStage) = pSecondExecutionCommandList;
+				for (const PipelineBufferBarrierDesc& bufferBarrier : otherQueueDrawBufferBarriers)
+				{
+					otherQueueBufferBarriers.PushBack(bufferBarrier);
+				}
 			}
 		}
 
 		//Buffer Synchronization
 		{
-			const TArray<PipelineBufferBarrierDesc>& sameQueueBufferBarriers		= pSynchronizationStage->BufferBarriers[SAME_QUEUE_BUFFER_SYNCHRONIZATION_INDEX];
-			const TArray<PipelineBufferBarrierDesc>& otherQueueBufferBarriers		= pSynchronizationStage->BufferBarriers[OTHER_QUEUE_BUFFER_SYNCHRONIZATION_INDEX];
+			for (const PipelineBufferBarrierDesc& bufferBarrier : pSynchronizationStage->BufferBarriers[SAME_QUEUE_BUFFER_SYNCHRONIZATION_INDEX])
+			{
+				sameQueueBufferBarriers.PushBack(bufferBarrier);
+			}
 
-			if (sameQueueBufferBarriers.GetSize() > 0)
+			for (const PipelineBufferBarrierDesc& bufferBarrier : pSynchronizationStage->BufferBarriers[OTHER_QUEUE_BUFFER_SYNCHRONIZATION_INDEX])
 			{
-				PipelineBufferBarriers(pFirstExecutionCommandList, sameQueueBufferBarriers, pSynchronizationStage->SrcPipelineStage, pSynchronizationStage->SameQueueDstPipelineStage);
+				otherQueueBufferBarriers.PushBack(bufferBarrier);
 			}
+		}
+
+		const bool hasSameQueueBarriers		= !sameQueueTextureBarriers.IsEmpty() || !sameQueueBufferBarriers.IsEmpty();
+		const bool hasOtherQueueBarriers	= !otherQueueTextureBarriers.IsEmpty() || !otherQueueBufferBarriers.IsEmpty();
 
-			if (otherQueueBufferBarriers.GetSize() > 0)
+		if (pFirstExecutionCommandList != nullptr)
+		{
+			// Releases to the other queue can share the call with the same queue barriers when they wait for the same stage
+			const bool mergeOtherQueue = hasOtherQueueBarriers && pSynchronizationStage->SameQueueDstPipelineStage == pSynchronizationStage->OtherQueueDstPipelineStage;
+			if (mergeOtherQueue)
+			{
+				for (const PipelineTextureBarrierDesc& textureBarrier : otherQueueTextureBarriers)
+				{
+					sameQueueTextureBarriers.PushBack(textureBarrier);
+				}
+
+				for (const PipelineBufferBarrierDesc& bufferBarrier : otherQueueBufferBarriers)
+				{
+					sameQueueBufferBarriers.PushBack(bufferBarrier);
+				}
+			}
+
+			if (hasSameQueueBarriers || mergeOtherQueue)
+			{
+				PipelineBarriers(pFirstExecutionCommandList, sameQueueTextureBarriers, sameQueueBufferBarriers, pSynchronizationStage->SrcPipelineStage, pSynchronizationStage->SameQueueDstPipelineStage);
+			}
+
+			if (hasOtherQueueBarriers)
 			{
-				PipelineBufferBarriers(pFirstExecutionCommandList, otherQueueBufferBarriers, pSynchronizationStage->SrcPipelineStage, pSynchronizationStage->OtherQueueDstPipelineStage);
-				PipelineBufferBarriers(pSecondExecutionCommandList, otherQueueBufferBarriers, pSynchronizationStage->SrcPipelineStage, pSynchronizationStage->OtherQueueDstPipelineStage);
+				if (!mergeOtherQueue)
+				{
+					PipelineBarriers(pFirstExecutionCommandList, otherQueueTextureBarriers, otherQueueBufferBarriers, pSynchronizationStage->SrcPipelineStage, pSynchronizationStage->OtherQueueDstPipelineStage);
+				}
+
+				PipelineBarriers(pSecondExecutionCommandList, otherQueueTextureBarriers, otherQueueBufferBarriers, pSynchronizationStage->SrcPipelineStage, pSynchronizationStage->OtherQueueDstPipelineStage);
 				(*ppSecondExecutionStage) = pSecondExecutionCommandList;
 			}
 		}
@@ -4641,6 +5158,29 @@ namespace LambdaEngine
 			pCommandList->PipelineTextureBarriers(srcPipelineStage, dstPipelineStage, &textureBarriers[i * MAX_IMAGE_BARRIERS], remaining);
 	}
 
+	void RenderGraph::PipelineBarriers(CommandList* pCommandList, const TArray<PipelineTextureBarrierDesc>& textureBarriers, const TArray<PipelineBufferBarrierDesc>& bufferBarriers, FPipelineStageFlags srcPipelineStage, FPipelineStageFlags dstPipelineStage)
+	{
+		// Each call takes up to MAX_IMAGE_BARRIERS texture barriers and MAX_BUFFER_BARRIERS buffer barriers
+		uint32 textureOffset	= 0;
+		uint32 bufferOffset		= 0;
+		while (textureOffset < textureBarriers.GetSize() || bufferOffset < bufferBarriers.GetSize())
+		{
+			const uint32 textureCount	= glm::min<uint32>(textureBarriers.GetSize() - textureOffset, MAX_IMAGE_BARRIERS);
+			const uint32 bufferCount	= glm::min<uint32>(bufferBarriers.GetSize() - bufferOffset, MAX_BUFFER_BARRIERS);
+
+			pCommandList->PipelineBarriers(
+				srcPipelineStage,
+				dstPipelineStage,
+				textureCount > 0 ? &textureBarriers[textureOffset] : nullptr,
+				textureCount,
+				bufferCount > 0 ? &bufferBarriers[bufferOffset] : nullptr,
+				bufferCount);
+
+			textureOffset	+= textureCount;
+			bufferOffset	+= bufferCount;
+		}
+	}
+
 	void RenderGraph::PipelineBufferBarriers(CommandList* pCommandList, const TArray<PipelineBufferBarrierDesc>& bufferBarriers, FPipelineStageFlags srcPipelineStage, FPipelineStageFlags dstPipelineStage)
 	{
 		uint32 remaining = bufferBarriers.GetSize() % MAX_BUFFER_BARRIERS;
@@ -0,0 +1,250 @@
+#include "Rendering/RenderGraphAliasingPlanner.h"
+
+#include "Rendering/Core/API/GraphicsHelpers.h"
+
+#include "Containers/THashTable.h"
+
+#include "Math/MathUtilities.h"
+
+#include <algorithm>
+
+namespace LambdaEngine
+{
+	struct ResourceUsage
+	{
+		uint32	FirstRenderStage		= UINT32_MAX;
+		bool	FirstUseIsWrite			= false;
+		bool	OnlyEveryFrame			= true;
+		bool	UsedByCustomRenderer	= false;
+	};
+
+	static bool IsWriteOnlyBinding(ERenderGraphResourceBindingType bindingType)
+	{
+		return bindingType == ERenderGraphResourceBindingType::ATTACHMENT || bindingType == ERenderGraphResourceBindingType::UNORDERED_ACCESS_WRITE;
+	}
+
+	static bool IsSingleTexture(const RenderGraphResourceDesc& resourceDesc)
+	{
+		return
+			resourceDesc.Type == ERenderGraphResourceType::TEXTURE &&
+			!resourceDesc.TextureParams.UnboundedArray &&
+			(resourceDesc.TextureParams.IsOfArrayType || resourceDesc.SubResourceCount == 1);
+	}
+
+	void RenderGraphAliasingPlanner::AnalyzeLifetimes(const RenderGraphStructureDesc& structure, RenderGraphAliasingPlan& plan)
+	{
+		plan = {};
+
+		const TArray<RenderGraphResourceDesc>& resourceDescs = structure.ResourceDescriptions;
+
+		THashTable<String, uint32> resourceIndices;
+		plan.Placements.Resize(resourceDescs.GetSize());
+		TArray<ResourceUsage> usages(resourceDescs.GetSize());
+		for (uint32 r = 0; r < resourceDescs.GetSize(); r++)
+		{
+			plan.Placements[r].ResourceName = resourceDescs[r].Name;
+			resourceIndices[resourceDescs[r].Name] = r;
+		}
+
+		// Lifetime analysis, pipeline stages are stored in execution order
+		for (uint32 p = 0; p < structure.PipelineStageDescriptions.GetSize(); p++)
+		{
+			const PipelineStageDesc& pipelineStageDesc = structure.PipelineStageDescriptions[p];
+			if (pipelineStageDesc.Type == ERenderGraphPipelineStageType::RENDER)
+			{
+				const RenderStageDesc& renderStageDesc = structure.RenderStageDescriptions[pipelineStageDesc.StageIndex];
+				const bool everyFrame = renderStageDesc.TriggerType == ERenderStageExecutionTrigger::EVERY && renderStageDesc.FrameDelay == 0;
+
+				for (const RenderGraphResourceState& resourceState : renderStageDesc.ResourceStates)
+				{
+					auto resourceIndexIt = resourceIndices.find(resourceState.ResourceName);
+					if (resourceIndexIt == resourceIndices.end())
+					{
+						continue;
+					}
+
+					RenderGraphResourcePlacement& placement = plan.Placements[resourceIndexIt->second];
+					ResourceUsage& usage = usages[resourceIndexIt->second];
+
+					if (placement.FirstPipelineStage == UINT32_MAX)
+					{
+						// Without a synchronization in front the resource already is in the state of the binding, except
+						// for attachments that are transitioned by the render pass
+						const bool isAttachment = resourceState.BindingType == ERenderGraphResourceBindingType::ATTACHMENT;
+						placement.FirstPipelineStage	= p;
+						placement.FrameStartBindingType	= isAttachment ? resourceState.AttachmentSynchronizations.PrevBindingType : resourceState.BindingType;
+						placement.FrameStartQueue		= ConvertPipelineStateTypeToQueue(renderStageDesc.Type);
+					}
+
+					if (usage.FirstRenderStage == UINT32_MAX)
+					{
+						usage.FirstRenderStage	= p;
+						usage.FirstUseIsWrite	= IsWriteOnlyBinding(resourceState.BindingType);
+					}
+					else if (usage.FirstRenderStage == p)
+					{
+						// Several states in the first stage, all of them have to write
+						usage.FirstUseIsWrite = usage.FirstUseIsWrite && IsWriteOnlyBinding(resourceState.BindingType);
+					}
+
+					placement.LastPipelineStage = glm::max(placement.LastPipelineStage, p);
+
+					usage.OnlyEveryFrame		= usage.OnlyEveryFrame && everyFrame;
+					usage.UsedByCustomRenderer	= usage.UsedByCustomRenderer || renderStageDesc.CustomRenderer;
+				}
+			}
+			else if (pipelineStageDesc.Type == ERenderGraphPipelineStageType::SYNCHRONIZATION)
+			{
+				// The first synchronization of a frame transitions from the last state of the previous frame and executes on its queue
+				const SynchronizationStageDesc& synchronizationStageDesc = structure.SynchronizationStageDescriptions[pipelineStageDesc.StageIndex];
+				for (const RenderGraphResourceSynchronizationDesc& synchronizationDesc : synchronizationStageDesc.Synchronizations)
+				{
+					auto resourceIndexIt = resourceIndices.find(synchronizationDesc.ResourceName);
+					if (resourceIndexIt == resourceIndices.end())
+					{
+						continue;
+					}
+
+					RenderGraphResourcePlacement& placement = plan.Placements[resourceIndexIt->second];
+					if (placement.FirstPipelineStage == UINT32_MAX)
+					{
+						placement.FirstPipelineStage	= p;
+						placement.FrameStartBindingType	= synchronizationDesc.PrevBindingType;
+						placement.FrameStartQueue		= synchronizationDesc.PrevQueue;
+					}
+
+					placement.LastPipelineStage = glm::max(placement.LastPipelineStage, p);
+				}
+			}
+		}
+
+		// Classify resources
+		for (uint32 r = 0; r < resourceDescs.GetSize(); r++)
+		{
+			const RenderGraphResourceDesc& resourceDesc = resourceDescs[r];
+			RenderGraphResourcePlacement& placement = plan.Placements[r];
+			const ResourceUsage& usage = usages[r];
+
+			placement.Transient =
+				IsSingleTexture(resourceDesc) &&
+				!resourceDesc.External &&
+				!resourceDesc.BackBufferBound &&
+				resourceDesc.Name != RENDER_GRAPH_BACK_BUFFER_ATTACHMENT &&
+				resourceDesc.MemoryType == EMemoryType::MEMORY_TYPE_GPU &&
+				resourceDesc.ShouldSynchronize &&
+				usage.FirstRenderStage != UINT32_MAX &&
+				usage.FirstUseIsWrite &&
+				usage.OnlyEveryFrame &&
+				!usage.UsedByCustomRenderer &&
+				placement.FrameStartQueue != ECommandQueueType::COMMAND_QUEUE_TYPE_NONE;
+		}
+	}
+
+	void RenderGraphAliasingPlanner::PlaceResources(RenderGraphAliasingPlan& plan)
+	{
+		plan.AliasingBarriers.Clear();
+		plan.HeapSizeInBytes				= 0;
+		plan.HeapMemoryTypeBits				= UINT32_MAX;
+		plan.TransientSizeWithoutAliasing	= 0;
+
+		TArray<uint32> transientIndices;
+		for (uint32 r = 0; r < plan.Placements.GetSize(); r++)
+		{
+			RenderGraphResourcePlacement& placement = plan.Placements[r];
+			placement.Aliased	= false;
+			placement.Offset	= 0;
+
+			if (placement.Transient)
+			{
+				transientIndices.PushBack(r);
+			}
+		}
+
+		// Place the largest resources first, each one at the lowest offset that is free during its whole lifetime
+		std::sort(transientIndices.Begin(), transientIndices.End(), [&plan](uint32 lhs, uint32 rhs)
+			{
+				return plan.Placements[lhs].SizeInBytes > plan.Placements[rhs].SizeInBytes;
+			});
+
+		TArray<uint32> placedIndices;
+		TArray<const RenderGraphResourcePlacement*> overlapping;
+		for (uint32 r : transientIndices)
+		{
+			RenderGraphResourcePlacement& placement = plan.Placements[r];
+
+			// The heap has a single memory type, resources that can not live in it keep their own allocation
+			const uint32 memoryTypeBits = plan.HeapMemoryTypeBits & placement.MemoryTypeBits;
+			if (memoryTypeBits == 0 || placement.SizeInBytes == 0)
+			{
+				placement.Transient = false;
+				continue;
+			}
+
+			plan.HeapMemoryTypeBits = memoryTypeBits;
+
+			overlapping.Clear();
+			for (uint32 placedIndex : placedIndices)
+			{
+				const RenderGraphResourcePlacement& placed = plan.Placements[placedIndex];
+				if (LifetimesOverlap(placed, placement))
+				{
+					overlapping.PushBack(&placed);
+				}
+			}
+
+			std::sort(overlapping.Begin(), overlapping.End(), [](const RenderGraphResourcePlacement* pLhs, const RenderGraphResourcePlacement* pRhs)
+				{
+					return pLhs->Offset < pRhs->Offset;
+				});
+
+			uint64 offset = 0;
+			for (const RenderGraphResourcePlacement* pPlaced : overlapping)
+			{
+				if (offset + placement.SizeInBytes <= pPlaced->Offset)
+				{
+					break;
+				}
+
+				offset = glm::max(offset, AlignUp(pPlaced->Offset + pPlaced->SizeInBytes, placement.Alignment));
+			}
+
+			placement.Offset				= offset;
+			plan.HeapSizeInBytes			= glm::max(plan.HeapSizeInBytes, offset + placement.SizeInBytes);
+			plan.TransientSizeWithoutAliasing += placement.SizeInBytes;
+
+			placedIndices.PushBack(r);
+		}
+
+		// Every resource that shares memory with another one has to discard the previous content before its first use
+		for (uint32 i = 0; i < placedIndices.GetSize(); i++)
+		{
+			RenderGraphResourcePlacement& lhs = plan.Placements[placedIndices[i]];
+			for (uint32 j = i + 1; j < placedIndices.GetSize(); j++)
+			{
+				RenderGraphResourcePlacement& rhs = plan.Placements[placedIndices[j]];
+				if (MemoryOverlaps(lhs, rhs))
+				{
+					lhs.Aliased = true;
+					rhs.Aliased = true;
+				}
+			}
+		}
+
+		for (uint32 r = 0; r < plan.Placements.GetSize(); r++)
+		{
+			const RenderGraphResourcePlacement& placement = plan.Placements[r];
+			if (placement.Transient && placement.Aliased)
+			{
+				RenderGraphAliasingBarrier aliasingBarrier = {};
+				aliasingBarrier.PlacementIndex	= r;
+				aliasingBarrier.PipelineStage	= placement.FirstPipelineStage;
+				plan.AliasingBarriers.PushBack(aliasingBarrier);
+			}
+		}
+
+		std::sort(plan.AliasingBarriers.Begin(), plan.AliasingBarriers.End(), [](const RenderGraphAliasingBarrier& lhs, const RenderGraphAliasingBarrier& rhs)
+			{
+				return lhs.PipelineStage < rhs.PipelineStage;
+			});
+	}
+}
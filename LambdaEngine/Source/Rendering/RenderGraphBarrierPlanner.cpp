@@ -0,0 +1,173 @@
+#include "Rendering/RenderGraphBarrierPlanner.h"
+
+#include "Containers/THashTable.h"
+
+#include "Math/MathUtilities.h"
+
+namespace LambdaEngine
+{
+	struct BarrierGroupCounts
+	{
+		uint32 TextureBarriers	= 0;
+		uint32 BufferBarriers	= 0;
+	};
+
+	void RenderGraphBarrierPlanner::Plan(const RenderGraphStructureDesc& structure, RenderGraphBarrierPlan& plan)
+	{
+		plan = {};
+
+		THashTable<String, uint32> resourceIndices;
+		for (uint32 r = 0; r < structure.ResourceDescriptions.GetSize(); r++)
+		{
+			resourceIndices[structure.ResourceDescriptions[r].Name] = r;
+		}
+
+		plan.Stages.Resize(structure.SynchronizationStageDescriptions.GetSize());
+		for (uint32 s = 0; s < structure.SynchronizationStageDescriptions.GetSize(); s++)
+		{
+			const SynchronizationStageDesc& synchronizationStageDesc = structure.SynchronizationStageDescriptions[s];
+			RenderGraphSynchronizationStagePlan& stagePlan = plan.Stages[s];
+			stagePlan.Barriers.Resize(synchronizationStageDesc.Synchronizations.GetSize());
+
+			// Index 0 is same queue, index 1 is other queue
+			BarrierGroupCounts groupCounts[2];
+
+			for (uint32 i = 0; i < synchronizationStageDesc.Synchronizations.GetSize(); i++)
+			{
+				const RenderGraphResourceSynchronizationDesc& synchronizationDesc = synchronizationStageDesc.Synchronizations[i];
+				RenderGraphPlannedBarrier& barrier = stagePlan.Barriers[i];
+
+				barrier.ResourceName			= synchronizationDesc.ResourceName;
+				barrier.Type					= synchronizationDesc.ResourceType;
+				barrier.PrevQueue				= synchronizationDesc.PrevQueue;
+				barrier.NextQueue				= synchronizationDesc.NextQueue;
+				barrier.SrcMemoryAccessFlags	= CalculateResourceAccessFlags(synchronizationDesc.PrevBindingType);
+				barrier.DstMemoryAccessFlags	= CalculateResourceAccessFlags(synchronizationDesc.NextBindingType);
+
+				auto resourceIndexIt = resourceIndices.find(synchronizationDesc.ResourceName);
+				const RenderGraphResourceDesc* pResourceDesc = resourceIndexIt != resourceIndices.end() ? &structure.ResourceDescriptions[resourceIndexIt->second] : nullptr;
+
+				// Acceleration structures are built with their own barriers and are never part of a synchronization stage
+				if (pResourceDesc == nullptr || !pResourceDesc->ShouldSynchronize || pResourceDesc->Type == ERenderGraphResourceType::ACCELERATION_STRUCTURE)
+				{
+					barrier.DropReason = ERenderGraphBarrierDropReason::NOT_SYNCHRONIZED;
+					continue;
+				}
+
+				const EFormat format = pResourceDesc->TextureParams.TextureFormat;
+				barrier.StateBefore		= CalculateResourceTextureState(pResourceDesc->Type, synchronizationDesc.PrevBindingType, format);
+				barrier.StateAfter		= CalculateResourceTextureState(pResourceDesc->Type, synchronizationDesc.NextBindingType, format);
+				barrier.BarrierCount	= CalculateBarrierCount(*pResourceDesc);
+
+				// Everything that was recorded before merging counts as unmerged, also the transitions dropped below
+				const uint32 queueIndex	= synchronizationDesc.PrevQueue == synchronizationDesc.NextQueue ? 0 : 1;
+				const bool isDrawArgs	= pResourceDesc->Type == ERenderGraphResourceType::SCENE_DRAW_ARGS;
+				const bool hasTexture	= pResourceDesc->Type == ERenderGraphResourceType::TEXTURE || isDrawArgs;
+				const bool hasBuffer	= pResourceDesc->Type == ERenderGraphResourceType::BUFFER || isDrawArgs;
+
+				const uint32 callsPerGroup = queueIndex == 0 ? 1 : 2;
+				stagePlan.BarrierCallsUnmerged += (hasTexture ? callsPerGroup : 0) + (hasBuffer ? callsPerGroup : 0);
+
+				// Draw args carry include and exclude masks that the parser merges on its own
+				if (!isDrawArgs)
+				{
+					const bool readAfterRead =
+						synchronizationDesc.PrevQueue == synchronizationDesc.NextQueue &&
+						synchronizationDesc.PrevRenderStage != "PRESENT" &&
+						IsReadOnlyBinding(synchronizationDesc.PrevBindingType) &&
+						IsReadOnlyBinding(synchronizationDesc.NextBindingType) &&
+						barrier.StateBefore == barrier.StateAfter;
+
+					if (readAfterRead)
+					{
+						barrier.DropReason = ERenderGraphBarrierDropReason::READ_AFTER_READ;
+						plan.DroppedTransitions++;
+						continue;
+					}
+
+					bool isDuplicate = false;
+					for (uint32 p = 0; p < i && !isDuplicate; p++)
+					{
+						const RenderGraphResourceSynchronizationDesc& prevSynchronizationDesc = synchronizationStageDesc.Synchronizations[p];
+						isDuplicate =
+							!stagePlan.Barriers[p].IsDropped() &&
+							prevSynchronizationDesc.ResourceName	== synchronizationDesc.ResourceName &&
+							prevSynchronizationDesc.PrevQueue		== synchronizationDesc.PrevQueue &&
+							prevSynchronizationDesc.NextQueue		== synchronizationDesc.NextQueue &&
+							prevSynchronizationDesc.PrevBindingType	== synchronizationDesc.PrevBindingType &&
+							prevSynchronizationDesc.NextBindingType	== synchronizationDesc.NextBindingType;
+					}
+
+					if (isDuplicate)
+					{
+						barrier.DropReason = ERenderGraphBarrierDropReason::DUPLICATE;
+						plan.DroppedTransitions++;
+						continue;
+					}
+				}
+
+				BarrierGroupCounts& counts = groupCounts[queueIndex];
+				if (hasTexture)
+				{
+					counts.TextureBarriers += barrier.BarrierCount;
+				}
+
+				if (hasBuffer)
+				{
+					counts.BufferBarriers += isDrawArgs ? 1 : barrier.BarrierCount;
+				}
+			}
+
+			// Same queue barriers are recorded once, other queue barriers on both the releasing and the acquiring queue
+			stagePlan.BarrierCallsMerged =
+				CalculateBarrierCalls(groupCounts[0].TextureBarriers, groupCounts[0].BufferBarriers) +
+				CalculateBarrierCalls(groupCounts[1].TextureBarriers, groupCounts[1].BufferBarriers) * 2;
+
+			plan.BarrierCallsUnmerged	+= stagePlan.BarrierCallsUnmerged;
+			plan.BarrierCallsMerged		+= stagePlan.BarrierCallsMerged;
+		}
+	}
+
+	bool RenderGraphBarrierPlanner::IsReadOnlyBinding(ERenderGraphResourceBindingType bindingType)
+	{
+		switch (bindingType)
+		{
+		case ERenderGraphResourceBindingType::ACCELERATION_STRUCTURE:
+		case ERenderGraphResourceBindingType::CONSTANT_BUFFER:
+		case ERenderGraphResourceBindingType::COMBINED_SAMPLER:
+		case ERenderGraphResourceBindingType::UNORDERED_ACCESS_READ:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	uint32 RenderGraphBarrierPlanner::CalculateBarrierCount(const RenderGraphResourceDesc& resourceDesc)
+	{
+		const uint32 subResourceCount = uint32(glm::max(resourceDesc.SubResourceCount, 1));
+
+		if (resourceDesc.Type == ERenderGraphResourceType::TEXTURE || resourceDesc.Type == ERenderGraphResourceType::SCENE_DRAW_ARGS)
+		{
+			// Back buffer bound textures only transition the texture of the current back buffer, unbounded arrays are sized at runtime
+			if (resourceDesc.BackBufferBound || resourceDesc.TextureParams.IsOfArrayType || resourceDesc.TextureParams.UnboundedArray)
+			{
+				return 1;
+			}
+
+			return subResourceCount;
+		}
+		else if (resourceDesc.Type == ERenderGraphResourceType::BUFFER)
+		{
+			return resourceDesc.BackBufferBound ? BACK_BUFFER_COUNT : subResourceCount;
+		}
+
+		return 0;
+	}
+
+	uint32 RenderGraphBarrierPlanner::CalculateBarrierCalls(uint32 textureBarrierCount, uint32 bufferBarrierCount)
+	{
+		const uint32 textureCalls	= (textureBarrierCount + MAX_IMAGE_BARRIERS - 1) / MAX_IMAGE_BARRIERS;
+		const uint32 bufferCalls	= (bufferBarrierCount + MAX_BUFFER_BARRIERS - 1) / MAX_BUFFER_BARRIERS;
+		return glm::max(textureCalls, bufferCalls);
+	}
+}
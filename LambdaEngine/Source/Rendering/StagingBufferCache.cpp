@@ -4,93 +4,287 @@
 
 #include "Rendering/Core/API/GraphicsDevice.h"
 #include "Rendering/Core/API/Buffer.h"
+#include "Rendering/Core/API/Fence.h"
+
+#include "Log/Log.h"
+
+#include <mutex>
 
 namespace LambdaEngine
 {
-	std::multimap<uint64, Buffer*, StagingBufferCache::SizeCompare> StagingBufferCache::s_AvailableBuffers[BACK_BUFFER_COUNT];
-	TArray<Buffer*> StagingBufferCache::s_StagedBuffers[BACK_BUFFER_COUNT];
-	uint32 StagingBufferCache::s_ModFrameIndex = 0;
-	uint32 StagingBufferCache::s_BufferIndex = 0;
+	Buffer*											StagingBufferCache::s_pRingBuffer			= nullptr;
+	byte*											StagingBufferCache::s_pRingHostMemory		= nullptr;
+	RingAllocator									StagingBufferCache::s_Ring;
+	Buffer*											StagingBufferCache::s_pOverflowBuffer		= nullptr;
+	byte*											StagingBufferCache::s_pOverflowHostMemory	= nullptr;
+	OffsetAllocator									StagingBufferCache::s_OverflowAllocator;
+	TArray<StagingBufferCache::OverflowAllocation>	StagingBufferCache::s_OverflowAllocations;
+	uint64											StagingBufferCache::s_OverflowLastUsedFrameIndex	= 0;
+	TArray<StagingBufferCache::DedicatedBuffer>		StagingBufferCache::s_DedicatedBuffers;
+	TArray<StagingBufferCache::FrameFence>			StagingBufferCache::s_FrameFences;
+	uint64											StagingBufferCache::s_FrameIndex			= 0;
+	uint32											StagingBufferCache::s_BufferIndex			= 0;
+	SpinLock										StagingBufferCache::s_Lock;
+
+	bool StagingBufferCache::Init()
+	{
+		BufferDesc bufferDesc = {};
+		bufferDesc.DebugName	= "Staging Buffer Cache Ring";
+		bufferDesc.MemoryType	= EMemoryType::MEMORY_TYPE_CPU_VISIBLE;
+		bufferDesc.Flags		= FBufferFlag::BUFFER_FLAG_COPY_SRC;
+		bufferDesc.SizeInBytes	= RING_SIZE_IN_BYTES;
+
+		s_pRingBuffer = RenderAPI::GetDevice()->CreateBuffer(&bufferDesc);
+		if (s_pRingBuffer == nullptr)
+		{
+			LOG_ERROR("[StagingBufferCache]: Failed to create ring buffer");
+			return false;
+		}
+
+		s_pRingHostMemory = reinterpret_cast<byte*>(s_pRingBuffer->Map());
+		s_Ring.Init(RING_SIZE_IN_BYTES);
+
+		s_FrameIndex = 0;
+		return true;
+	}
 
 	bool StagingBufferCache::Release()
 	{
-		for (uint32 b = 0; b < BACK_BUFFER_COUNT; b++)
+		for (DedicatedBuffer& dedicatedBuffer : s_DedicatedBuffers)
+		{
+			dedicatedBuffer.pBuffer->Unmap();
+			SAFERELEASE(dedicatedBuffer.pBuffer);
+		}
+
+		s_DedicatedBuffers.Clear();
+		s_OverflowAllocations.Clear();
+		s_FrameFences.Clear();
+
+		ReleaseOverflowBuffer();
+
+		if (s_pRingBuffer != nullptr)
+		{
+			s_pRingBuffer->Unmap();
+			s_pRingHostMemory = nullptr;
+		}
+
+		SAFERELEASE(s_pRingBuffer);
+		return true;
+	}
+
+	void StagingBufferCache::Tick(const Fence* pFence, uint64 submittedFenceValue)
+	{
+		VALIDATE(pFence != nullptr);
+
+		std::scoped_lock<SpinLock> lock(s_Lock);
+
+		/*
+		* Allocations made since the last call belong to the frame that ends now. Uploads made between two frames are
+		* recorded into the next frame, so the allocations of the frame before have all been submitted by now and are
+		* covered by the last submitted fence value
+		*/
+		s_Ring.EndFrame(s_FrameIndex);
+		if (s_FrameIndex > 0)
 		{
-			TArray<Buffer*>& frameStagedBuffers = s_StagedBuffers[b];
+			s_FrameFences.PushBack({ s_FrameIndex - 1, submittedFenceValue });
+		}
+
+		// Reclaim the frames whose submits have completed on the GPU
+		const uint64 completedFenceValue = pFence->GetValue();
 
-			for (Buffer* pBuffer : frameStagedBuffers)
+		uint32 completedFrameCount = 0;
+		while (completedFrameCount < s_FrameFences.GetSize() && s_FrameFences[completedFrameCount].FenceValue <= completedFenceValue)
+		{
+			completedFrameCount++;
+		}
+
+		if (completedFrameCount > 0)
+		{
+			const uint64 completedFrameIndex = s_FrameFences[completedFrameCount - 1].FrameIndex;
+			s_FrameFences.Erase(s_FrameFences.Begin(), s_FrameFences.Begin() + completedFrameCount);
+
+			s_Ring.Reclaim(completedFrameIndex);
+
+			for (uint32 a = 0; a < s_OverflowAllocations.GetSize();)
 			{
-				SAFERELEASE(pBuffer);
+				if (s_OverflowAllocations[a].FrameIndex <= completedFrameIndex)
+				{
+					s_OverflowAllocator.Free(s_OverflowAllocations[a].Allocation);
+					s_OverflowAllocations[a] = s_OverflowAllocations.GetBack();
+					s_OverflowAllocations.PopBack();
+				}
+				else
+				{
+					a++;
+				}
 			}
 
-			frameStagedBuffers.Clear();
-
-			std::multimap<uint64, Buffer*, SizeCompare>& frameAvailableBuffers = s_AvailableBuffers[b];
+			VALIDATE_OFFSET_ALLOCATOR(s_OverflowAllocator);
 
-			for (auto bufferIt = frameAvailableBuffers.begin(); bufferIt != frameAvailableBuffers.end(); bufferIt++)
+			for (uint32 b = 0; b < s_DedicatedBuffers.GetSize();)
 			{
-				SAFERELEASE(bufferIt->second);
+				if (s_DedicatedBuffers[b].FrameIndex <= completedFrameIndex)
+				{
+					s_DedicatedBuffers[b].pBuffer->Unmap();
+					SAFERELEASE(s_DedicatedBuffers[b].pBuffer);
+					s_DedicatedBuffers[b] = s_DedicatedBuffers.GetBack();
+					s_DedicatedBuffers.PopBack();
+				}
+				else
+				{
+					b++;
+				}
 			}
+		}
 
-			frameAvailableBuffers.clear();
+		// Every frame that used the overflow buffer has completed once it holds no allocations
+		if (s_pOverflowBuffer != nullptr && s_OverflowAllocations.IsEmpty() && s_FrameIndex - s_OverflowLastUsedFrameIndex >= OVERFLOW_RELEASE_FRAME_COUNT)
+		{
+			ReleaseOverflowBuffer();
 		}
 
-		return true;
+		s_FrameIndex++;
 	}
 
-	void StagingBufferCache::Tick()
+	StagingBufferAllocation StagingBufferCache::Allocate(uint64 sizeInBytes, uint64 alignment)
 	{
-		TArray<Buffer*>& frameStagedBuffers = s_StagedBuffers[s_ModFrameIndex];
+		VALIDATE(sizeInBytes > 0);
+		VALIDATE(s_pRingBuffer != nullptr);
+
+		std::scoped_lock<SpinLock> lock(s_Lock);
 
-		//Reinsert all previously used staging buffers into available buffers
-		if (!frameStagedBuffers.IsEmpty())
+		// Large uploads would starve the ring, they are placed in the overflow buffer together with what the ring cannot fit
+		StagingBufferAllocation allocation = {};
+
+		uint64 offset = 0;
+		if (sizeInBytes <= (RING_SIZE_IN_BYTES / 4) && s_Ring.Allocate(sizeInBytes, alignment, offset))
 		{
-			std::multimap<uint64, Buffer*, SizeCompare>& frameAvailableBuffers = s_AvailableBuffers[s_ModFrameIndex];
+			allocation.pBuffer		= s_pRingBuffer;
+			allocation.Offset		= offset;
+			allocation.SizeInBytes	= sizeInBytes;
+			allocation.pHostMemory	= s_pRingHostMemory + offset;
+			return allocation;
+		}
 
-			for (uint32 b = 0; b < frameStagedBuffers.GetSize(); b++)
-			{
-				Buffer* pFinishedStagingBuffer = frameStagedBuffers[b];
-				frameAvailableBuffers.insert({ pFinishedStagingBuffer->GetDesc().SizeInBytes, pFinishedStagingBuffer });
-			}
+		if (AllocateOverflow(sizeInBytes, alignment, allocation))
+		{
+			return allocation;
+		}
+
+		return AllocateDedicated(sizeInBytes);
+	}
+
+	bool StagingBufferCache::CreateOverflowBuffer()
+	{
+		BufferDesc bufferDesc = {};
+		bufferDesc.DebugName	= "Staging Buffer Cache Overflow";
+		bufferDesc.MemoryType	= EMemoryType::MEMORY_TYPE_CPU_VISIBLE;
+		bufferDesc.Flags		= FBufferFlag::BUFFER_FLAG_COPY_SRC;
+		bufferDesc.SizeInBytes	= OVERFLOW_SIZE_IN_BYTES;
 
-			frameStagedBuffers.Clear();
+		s_pOverflowBuffer = RenderAPI::GetDevice()->CreateBuffer(&bufferDesc);
+		if (s_pOverflowBuffer == nullptr)
+		{
+			LOG_WARNING("[StagingBufferCache]: Failed to create overflow buffer, using dedicated buffers instead");
+			return false;
 		}
 
-		s_ModFrameIndex++;
-		if (s_ModFrameIndex >= BACK_BUFFER_COUNT) s_ModFrameIndex = 0;
+		s_pOverflowHostMemory = reinterpret_cast<byte*>(s_pOverflowBuffer->Map());
+		if (s_pOverflowHostMemory == nullptr)
+		{
+			LOG_WARNING("[StagingBufferCache]: Failed to map overflow buffer, using dedicated buffers instead");
+			SAFERELEASE(s_pOverflowBuffer);
+			return false;
+		}
+
+		s_OverflowAllocator.Init(OVERFLOW_SIZE_IN_BYTES);
+		return true;
 	}
 
-	Buffer* StagingBufferCache::RequestBuffer(uint64 size)
+	void StagingBufferCache::ReleaseOverflowBuffer()
 	{
-		Buffer* pReturnBuffer;
+		VALIDATE(s_OverflowAllocations.IsEmpty());
 
-		std::multimap<uint64, Buffer*, SizeCompare>& frameAvailableBuffers = s_AvailableBuffers[s_ModFrameIndex];
+		if (s_pOverflowBuffer != nullptr)
+		{
+			s_pOverflowBuffer->Unmap();
+			s_pOverflowHostMemory = nullptr;
+		}
+
+		SAFERELEASE(s_pOverflowBuffer);
+	}
 
-		auto availableBufferIt = frameAvailableBuffers.find(size);
-		if (availableBufferIt == frameAvailableBuffers.end())
+	bool StagingBufferCache::AllocateOverflow(uint64 sizeInBytes, uint64 alignment, StagingBufferAllocation& allocation)
+	{
+		if (sizeInBytes > OVERFLOW_SIZE_IN_BYTES)
 		{
-			//If we don't find one, create a new 
-			BufferDesc bufferDesc = {};
-			bufferDesc.DebugName	= "Staging Buffer Cache"
+			return false;
+		}
+
+		if (s_pOverflowBuffer == nullptr && !CreateOverflowBuffer())
+		{
+			return false;
+		}
+
+		s_OverflowLastUsedFrameIndex = s_FrameIndex;
+
+		OverflowAllocation overflowAllocation = {};
+		overflowAllocation.FrameIndex = s_FrameIndex;
+		if (!s_OverflowAllocator.Allocate(sizeInBytes, alignment, overflowAllocation.Allocation))
+		{
+			return false;
+		}
+
+		VALIDATE_OFFSET_ALLOCATOR(s_OverflowAllocator);
+		s_OverflowAllocations.PushBack(overflowAllocation);
+
+		allocation.pBuffer		= s_pOverflowBuffer;
+		allocation.Offset		= overflowAllocation.Allocation.Offset;
+		allocation.SizeInBytes	= sizeInBytes;
+		allocation.pHostMemory	= s_pOverflowHostMemory + overflowAllocation.Allocation.Offset;
+		return true;
+	}
+
+	StagingBufferAllocation StagingBufferCache::AllocateDedicated(uint64 sizeInBytes)
+	{
+		BufferDesc bufferDesc = {};
+		bufferDesc.DebugName	= "Staging Buffer Cache"
 #ifdef LAMBDA_DEVELOPMENT
-			+ std::to_string(s_BufferIndex++)
+		+ std::to_string(s_BufferIndex++)
 #endif
-			;
-			bufferDesc.MemoryType	= EMemoryType::MEMORY_TYPE_CPU_VISIBLE;
-			bufferDesc.Flags		= FBufferFlag::BUFFER_FLAG_COPY_SRC;
-			bufferDesc.SizeInBytes	= size;
+		;
+		bufferDesc.MemoryType	= EMemoryType::MEMORY_TYPE_CPU_VISIBLE;
+		bufferDesc.Flags		= FBufferFlag::BUFFER_FLAG_COPY_SRC;
+		bufferDesc.SizeInBytes	= sizeInBytes;
 
-			pReturnBuffer = RenderAPI::GetDevice()->CreateBuffer(&bufferDesc);
-			s_StagedBuffers[s_ModFrameIndex].PushBack(pReturnBuffer);
+		Buffer* pBuffer = RenderAPI::GetDevice()->CreateBuffer(&bufferDesc);
+		if (pBuffer == nullptr)
+		{
+			LOG_ERROR("[StagingBufferCache]: Failed to create dedicated staging buffer of %llu bytes", sizeInBytes);
+			VALIDATE_MSG(false, "Failed to create dedicated staging buffer of %llu bytes", sizeInBytes);
+			return StagingBufferAllocation();
 		}
-		else
+
+		void* pHostMemory = pBuffer->Map();
+		if (pHostMemory == nullptr)
 		{
-			//If we find one, move it to m_StagedBuffers
-			pReturnBuffer = availableBufferIt->second;
-			s_StagedBuffers[s_ModFrameIndex].PushBack(pReturnBuffer);
-			frameAvailableBuffers.erase(availableBufferIt);
+			LOG_ERROR("[StagingBufferCache]: Failed to map dedicated staging buffer of %llu bytes", sizeInBytes);
+			VALIDATE_MSG(false, "Failed to map dedicated staging buffer of %llu bytes", sizeInBytes);
+			SAFERELEASE(pBuffer);
+			return StagingBufferAllocation();
 		}
 
-		return pReturnBuffer;
+		// Dedicated buffers are released together with the ring memory of the current frame
+		DedicatedBuffer dedicatedBuffer = {};
+		dedicatedBuffer.pBuffer		= pBuffer;
+		dedicatedBuffer.FrameIndex	= s_FrameIndex;
+		s_DedicatedBuffers.PushBack(dedicatedBuffer);
+
+		StagingBufferAllocation allocation = {};
+		allocation.pBuffer		= pBuffer;
+		allocation.Offset		= 0;
+		allocation.SizeInBytes	= sizeInBytes;
+		allocation.pHostMemory	= pHostMemory;
+		return allocation;
 	}
-}
\ No newline at end of file
+}
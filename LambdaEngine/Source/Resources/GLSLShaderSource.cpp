@@ -1,5 +1,6 @@
 #include "Resources/GLSLShaderSource.h"
 #include "Resources/GLSLang.h"
+#include "Resources/ShaderCache.h"
 
 #include "Rendering/Core/API/GraphicsDevice.h"
 #include "Rendering/Core/API/Shader.h"
@@ -53,13 +54,54 @@ namespace LambdaEngine
 			return nullptr;
 		}
 
+		TArray<uint32> sourceSPIRV;
+
+		const uint64 cacheKey = ShaderCache::CalculateKey(preprocessedGLSL, m_Desc.ShaderStage, defines, m_Desc.EntryPoint);
+		if (!ShaderCache::Load(cacheKey, sourceSPIRV))
+		{
+			if (!CompileToSPIRV(preprocessedGLSL, defines, sourceSPIRV))
+			{
+				return nullptr;
+			}
+
+			ShaderCache::Store(cacheKey, sourceSPIRV);
+		}
+
+		const uint32 sourceSize = static_cast<uint32>(sourceSPIRV.GetSize()) * sizeof(uint32);
+
+		ShaderDesc shaderDesc = { };
+		shaderDesc.DebugName	= name;
+		shaderDesc.Source		= TArray<byte>(reinterpret_cast<byte*>(sourceSPIRV.GetData()), reinterpret_cast<byte*>(sourceSPIRV.GetData()) + sourceSize);
+		shaderDesc.EntryPoint	= m_Desc.EntryPoint;
+		shaderDesc.Stage		= m_Desc.ShaderStage;
+		shaderDesc.Lang			= EShaderLang::SHADER_LANG_SPIRV;
+
+		return RenderAPI::GetDevice()->CreateShader(&shaderDesc);
+	}
+
+	bool GLSLShaderSource::CompileToSPIRV(const String& preprocessedGLSL, const String& defines, TArray<uint32>& sourceSPIRV)
+	{
+		EShLanguage shaderType = ConvertShaderStageToEShLanguage(m_Desc.ShaderStage);
+		glslang::TShader shader(shaderType);
+
+		int32 clientInputSemanticsVersion					= GetDefaultClientInputSemanticsVersion();
+		glslang::EShTargetClientVersion vulkanClientVersion	= GetDefaultVulkanClientVersion();
+		glslang::EShTargetLanguageVersion targetVersion		= GetDefaultSPIRVTargetVersion();
+		const TBuiltInResource* pResources					= GetDefaultBuiltInResources();
+		EShMessages messages								= GetDefaultMessages();
+		int32 defaultVersion								= GetDefaultVersion();
+
+		shader.setEnvInput(glslang::EShSourceGlsl, shaderType, glslang::EShClientVulkan, clientInputSemanticsVersion);
+		shader.setEnvClient(glslang::EShClientVulkan, vulkanClientVersion);
+		shader.setEnvTarget(glslang::EShTargetSpv, targetVersion);
+
 		const char* pPreprocessedGLSL = preprocessedGLSL.c_str();
 		shader.setStrings(&pPreprocessedGLSL, 1);
 
 		if (!shader.parse(pResources, defaultVersion, false, messages))
 		{
 			LOG_ERROR("[GLSLShaderSource]: GLSL Parsing failed: \"%s\"\nDefines:\n%s\n%s\n%s", m_Desc.Name.c_str(), defines.c_str(), shader.getInfoLog(), shader.getInfoDebugLog());
-			return nullptr;
+			return false;
 		}
 
 		glslang::TProgram program;
@@ -68,28 +110,17 @@ namespace LambdaEngine
 		if (!program.link(messages))
 		{
 			LOG_ERROR("[GLSLShaderSource]: GLSL Linking failed: \"%s\"\nDefines:\n%s\n%s\n%s", m_Desc.Name.c_str(), defines.c_str(), shader.getInfoLog(), shader.getInfoDebugLog());
-			return nullptr;
+			return false;
 		}
 
 		glslang::TIntermediate* pIntermediate = program.getIntermediate(shaderType);
 
-		TArray<uint32> sourceSPIRV;
-
 		spv::SpvBuildLogger logger;
 		glslang::SpvOptions spvOptions;
 		std::vector<uint32> std_sourceSPIRV;
 		glslang::GlslangToSpv(*pIntermediate, std_sourceSPIRV, &logger, &spvOptions);
 		sourceSPIRV.Assign(std_sourceSPIRV.data(), std_sourceSPIRV.data() + std_sourceSPIRV.size());
 
-		const uint32 sourceSize = static_cast<uint32>(sourceSPIRV.GetSize()) * sizeof(uint32);
-
-		ShaderDesc shaderDesc = { };
-		shaderDesc.DebugName	= name;
-		shaderDesc.Source		= TArray<byte>(reinterpret_cast<byte*>(sourceSPIRV.GetData()), reinterpret_cast<byte*>(sourceSPIRV.GetData()) + sourceSize);
-		shaderDesc.EntryPoint	= m_Desc.EntryPoint;
-		shaderDesc.Stage		= m_Desc.ShaderStage;
-		shaderDesc.Lang			= EShaderLang::SHADER_LANG_SPIRV;
-
-		return RenderAPI::GetDevice()->CreateShader(&shaderDesc);
+		return true;
 	}
 }
\ No newline at end of file
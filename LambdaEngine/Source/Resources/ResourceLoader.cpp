@@ -18,6 +18,8 @@
 
 #include "Resources/STB.h"
 #include "Resources/GLSLShaderSource.h"
+#include "Resources/ShaderCache.h"
+#include "Resources/TextureDecoder.h"
 
 #include "Log/Log.h"
 
@@ -30,7 +32,17 @@
 
 #include "Resources/MeshTessellator.h"
 
+#include "Threading/API/ThreadPool.h"
+
+#include "Utilities/HashUtilities.h"
+
+#include "Game/GameConsole.h"
+
+#include "Time/API/Clock.h"
+
 #include <cstdio>
+#include <atomic>
+#include <filesystem>
 
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
@@ -116,6 +128,38 @@ namespace LambdaEngine
 		return result;
 	}
 
+	static bool ValidateDecodedImageSizes(const String& name, const DecodedImageBatch& batch)
+	{
+		for (const DecodedImage& image : batch.Images)
+		{
+			if (image.Width != batch.Images[0].Width || image.Height != batch.Images[0].Height)
+			{
+				LOG_ERROR("All images in \"%s\" must have the same size, \"%s\" differs", name.c_str(), image.Filepath.c_str());
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	static FShaderStageFlag GetShaderStageFromExtension(const String& extension)
+	{
+		if (extension == ".vert")	return FShaderStageFlag::SHADER_STAGE_FLAG_VERTEX_SHADER;
+		if (extension == ".frag")	return FShaderStageFlag::SHADER_STAGE_FLAG_PIXEL_SHADER;
+		if (extension == ".comp")	return FShaderStageFlag::SHADER_STAGE_FLAG_COMPUTE_SHADER;
+		if (extension == ".geom")	return FShaderStageFlag::SHADER_STAGE_FLAG_GEOMETRY_SHADER;
+		if (extension == ".tesc")	return FShaderStageFlag::SHADER_STAGE_FLAG_HULL_SHADER;
+		if (extension == ".tese")	return FShaderStageFlag::SHADER_STAGE_FLAG_DOMAIN_SHADER;
+		if (extension == ".mesh")	return FShaderStageFlag::SHADER_STAGE_FLAG_MESH_SHADER;
+		if (extension == ".task")	return FShaderStageFlag::SHADER_STAGE_FLAG_TASK_SHADER;
+		if (extension == ".rgen")	return FShaderStageFlag::SHADER_STAGE_FLAG_RAYGEN_SHADER;
+		if (extension == ".rint")	return FShaderStageFlag::SHADER_STAGE_FLAG_INTERSECT_SHADER;
+		if (extension == ".rahit")	return FShaderStageFlag::SHADER_STAGE_FLAG_ANY_HIT_SHADER;
+		if (extension == ".rchit")	return FShaderStageFlag::SHADER_STAGE_FLAG_CLOSEST_HIT_SHADER;
+		if (extension == ".rmiss")	return FShaderStageFlag::SHADER_STAGE_FLAG_MISS_SHADER;
+		return FShaderStageFlag::SHADER_STAGE_FLAG_NONE;
+	}
+
 	// Removes extra data after the fileending (Some materials has extra data after file ending)
 	static void RemoveExtraData(String& string)
 	{
@@ -219,6 +263,113 @@ namespace LambdaEngine
 			return false;
 		}
 
+		// Console Commands
+		{
+			ConsoleCommand cmdBakeMeshlets;
+			cmdBakeMeshlets.Init("bake_meshlets", true);
+			cmdBakeMeshlets.AddFlag("s", Arg::EType::STRING);
+			cmdBakeMeshlets.AddDescription("Generates the meshlet cache for all meshes in the mesh and scene directories.\n\t'bake_meshlets -s ../Assets/World/LevelModules/'", { { "s", "Additional directory of scenes" } });
+			GameConsole::Get().BindCommand(cmdBakeMeshlets, [](GameConsole::CallbackInput& input)->void
+				{
+
+					// Bake every way the files are loaded at runtime, meshes are loaded with and without their materials
+					uint32 bakedMeshCount = 0;
+					bakedMeshCount += BakeMeshletCache(MESH_DIR, GetMeshAssimpFlags(false), false);
+					bakedMeshCount += BakeMeshletCache(MESH_DIR, GetMeshAssimpFlags(true), false);
+					bakedMeshCount += BakeMeshletCache(SCENE_DIR, GetSceneAssimpFlags(), true);
+
+					auto sceneDirectoryIt = input.Flags.find("s");
+					if (sceneDirectoryIt != input.Flags.end())
+					{
+						bakedMeshCount += BakeMeshletCache(sceneDirectoryIt->second.Arg.Value.String, GetSceneAssimpFlags(), true);
+					}
+
+					GameConsole::Get().PushInfo("Baked meshlet cache for " + std::to_string(bakedMeshCount) + " meshes");
+				});
+
+			ConsoleCommand cmdBenchShaders;
+			cmdBenchShaders.Init("bench_shaders", true);
+			cmdBenchShaders.AddDescription("Compiles all shaders in the shader directory with an empty (cold) and a filled (warm) shader cache.\n\t'bench_shaders'");
+			GameConsole::Get().BindCommand(cmdBenchShaders, [](GameConsole::CallbackInput& input)->void
+				{
+					UNREFERENCED_VARIABLE(input);
+
+					ShaderCache::Clear();
+
+					Clock clock;
+					clock.Reset();
+
+					ShaderCache::ResetStatistics();
+					const uint32 coldShaderCount = CompileShaderDirectory(SHADER_DIR);
+					clock.Tick();
+					const float64 coldTime = clock.GetDeltaTime().AsMilliSeconds();
+					const uint32 coldMissCount = ShaderCache::GetMissCount();
+
+					ShaderCache::ResetStatistics();
+					const uint32 warmShaderCount = CompileShaderDirectory(SHADER_DIR);
+					clock.Tick();
+					const float64 warmTime = clock.GetDeltaTime().AsMilliSeconds();
+					const uint32 warmHitCount = ShaderCache::GetHitCount();
+
+					GameConsole::Get().PushInfo("Cold: " + std::to_string(coldShaderCount) + " shaders in " + std::to_string(coldTime) + " ms (" + std::to_string(coldMissCount) + " cache misses)");
+					GameConsole::Get().PushInfo("Warm: " + std::to_string(warmShaderCount) + " shaders in " + std::to_string(warmTime) + " ms (" + std::to_string(warmHitCount) + " cache hits)");
+				});
+
+			ConsoleCommand cmdBenchTextures;
+			cmdBenchTextures.Init("bench_textures", true);
+			cmdBenchTextures.AddDescription("Decodes all textures in the texture directory, with mips, one at a time and in parallel. Nothing is uploaded to the GPU.\n\t'bench_textures'");
+			GameConsole::Get().BindCommand(cmdBenchTextures, [](GameConsole::CallbackInput& input)->void
+				{
+					UNREFERENCED_VARIABLE(input);
+
+					TArray<String> filepaths;
+
+					std::error_code error;
+					for (const std::filesystem::directory_entry& entry : std::filesystem::recursive_directory_iterator(TEXTURE_DIR, error))
+					{
+						const String extension = entry.path().extension().string();
+						if (entry.is_regular_file() && (extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".tga" || extension == ".bmp"))
+						{
+							filepaths.PushBack(entry.path().string());
+						}
+					}
+
+					Clock clock;
+					clock.Reset();
+
+					for (const String& filepath : filepaths)
+					{
+						DecodedImageBatch batch;
+						TextureDecoder::DecodeFiles(&filepath, 1, EFormat::FORMAT_R8G8B8A8_UNORM, true, true, batch);
+						TextureDecoder::ReleaseBatch(batch);
+					}
+
+					clock.Tick();
+					const float64 serialTime = clock.GetDeltaTime().AsMilliSeconds();
+
+					DecodedImageBatch batch;
+					TextureDecoder::DecodeFiles(filepaths.GetData(), filepaths.GetSize(), EFormat::FORMAT_R8G8B8A8_UNORM, true, true, batch);
+
+					clock.Tick();
+					const float64 parallelTime = clock.GetDeltaTime().AsMilliSeconds();
+
+					uint64 decodedBytes = 0;
+					for (const DecodedImage& image : batch.Images)
+					{
+						if (image.Succeeded)
+						{
+							decodedBytes += TextureDecoder::CalculateMipChainSize(image.Width, image.Height, image.Miplevels, EFormat::FORMAT_R8G8B8A8_UNORM);
+						}
+					}
+
+					TextureDecoder::ReleaseBatch(batch);
+
+					const float64 decodedMegaBytes = float64(decodedBytes) / (1024.0 * 1024.0);
+					GameConsole::Get().PushInfo("Decoded " + std::to_string(filepaths.GetSize()) + " textures (" + std::to_string(decodedMegaBytes) + " MB with mips)");
+					GameConsole::Get().PushInfo("One at a time: " + std::to_string(serialTime) + " ms, parallel: " + std::to_string(parallelTime) + " ms");
+				});
+		}
+
 		return true;
 	}
 
@@ -236,6 +387,8 @@ namespace LambdaEngine
 		SAFERELEASE(s_pComputeCommandList);
 		SAFERELEASE(s_pComputeFence);
 
+		TextureDecoder::ReleaseArenaPool();
+
 		glslang::FinalizeProcess();
 
 		return true;
@@ -362,7 +515,28 @@ namespace LambdaEngine
 				if (loadedTexture == context.LoadedTextures.end())
 				{
 					LoadedTexture* pLoadedTexture = DBG_NEW LoadedTexture();
-					pLoadedTexture->pTexture = ResourceLoader::LoadTextureArrayFromFile(name, context.DirectoryPath, &name, 1, EFormat::FORMAT_R8G8B8A8_UNORM, true, true);
+
+					auto prefetchedImage = context.PrefetchedImages.find(name);
+					if (prefetchedImage != context.PrefetchedImages.end())
+					{
+						const DecodedImage* pImage = prefetchedImage->second;
+						pLoadedTexture->pTexture = ResourceLoader::UploadTextureArray(
+							name,
+							&pImage->pPixels,
+							1,
+							pImage->Width,
+							pImage->Height,
+							EFormat::FORMAT_R8G8B8A8_UNORM,
+							FTextureFlag::TEXTURE_FLAG_SHADER_RESOURCE,
+							pImage->Miplevels,
+							false,
+							true);
+					}
+					else
+					{
+						pLoadedTexture->pTexture = ResourceLoader::LoadTextureArrayFromFile(name, context.DirectoryPath, &name, 1, EFormat::FORMAT_R8G8B8A8_UNORM, true, true);
+					}
+
 					pLoadedTexture->Flags = AssimpTextureFlagToLambdaTextureFlag(type);
 
 					context.LoadedTextures[name] = pLoadedTexture;
@@ -391,23 +565,7 @@ namespace LambdaEngine
 		TArray<LoadedMaterial*>& materials,
 		TArray<LoadedTexture*>& textures)
 	{
-		const int32 assimpFlags =
-			aiProcess_FlipWindingOrder			|
-			aiProcess_FlipUVs					|
-			aiProcess_CalcTangentSpace			|
-			aiProcess_FindInstances				|
-			aiProcess_GenSmoothNormals			|
-			aiProcess_JoinIdenticalVertices		|
-			aiProcess_ImproveCacheLocality		|
-			aiProcess_LimitBoneWeights			|
-			aiProcess_SplitLargeMeshes			|
-			aiProcess_RemoveRedundantMaterials	|
-			aiProcess_SortByPType				|
-			aiProcess_Triangulate				|
-			aiProcess_GenUVCoords				|
-			aiProcess_FindDegenerates			|
-			aiProcess_OptimizeMeshes			|
-			aiProcess_FindInvalidData;
+		const int32 assimpFlags = GetSceneAssimpFlags();
 
 		SceneLoadRequest loadRequest =
 		{
@@ -571,7 +729,7 @@ namespace LambdaEngine
 
 		if (useMeshletCache)
 		{
-			LoadMeshletsFromCache(name, pMesh);
+			LoadMeshletsFromCache(pMesh);
 		}
 		else
 		{
@@ -590,67 +748,70 @@ namespace LambdaEngine
 		bool generateMips,
 		bool linearFilteringMips)
 	{
-		int32 texWidth	= 0;
-		int32 texHeight	= 0;
-		int32 bpp		= 0;
+		if (format != EFormat::FORMAT_R8G8B8A8_UNORM && format != EFormat::FORMAT_R16_UNORM)
+		{
+			LOG_ERROR("Texture format not supported for \"%s\"", name.c_str());
+			return nullptr;
+		}
 
-		TArray<void*> stbi_pixels(count);
+		TArray<String> filepaths(count);
 		for (uint32 i = 0; i < count; i++)
 		{
-			String filepath = dir + ConvertSlashes(pFilenames[i]);
-
-			void* pPixels = nullptr;
-
-			if (format == EFormat::FORMAT_R8G8B8A8_UNORM)
-			{
-				pPixels = (void*)stbi_load(filepath.c_str(), &texWidth, &texHeight, &bpp, STBI_rgb_alpha);
-			}
-			else if (format == EFormat::FORMAT_R16_UNORM)
-			{
-				pPixels = (void*)stbi_load_16(filepath.c_str(), &texWidth, &texHeight, &bpp, STBI_rgb_alpha);
-			}
-			else
-			{
-				LOG_ERROR("Texture format not supported for \"%s\"", filepath.c_str());
-				return nullptr;
-			}
+			filepaths[i] = dir + ConvertSlashes(pFilenames[i]);
+		}
 
-			if (pPixels == nullptr)
-			{
-				LOG_ERROR("Failed to load texture file: \"%s\"", filepath.c_str());
-				return nullptr;
-			}
+		// 16-bit images are split into one layer per channel below, so their mips are generated after the split
+		const bool decodeMips = generateMips && format == EFormat::FORMAT_R8G8B8A8_UNORM;
+		const EFormat decodeFormat = format == EFormat::FORMAT_R16_UNORM ? EFormat::FORMAT_R16G16B16A16_UNORM : format;
 
-			stbi_pixels[i] = pPixels;
+		DecodedImageBatch batch;
+		if (!TextureDecoder::DecodeFiles(filepaths.GetData(), count, decodeFormat, decodeMips, linearFilteringMips, batch) || !ValidateDecodedImageSizes(name, batch))
+		{
+			TextureDecoder::ReleaseBatch(batch);
+			return nullptr;
 		}
 
+		const uint32 texWidth	= batch.Images[0].Width;
+		const uint32 texHeight	= batch.Images[0].Height;
+
 		Texture* pTexture = nullptr;
 
 		if (format == EFormat::FORMAT_R8G8B8A8_UNORM)
 		{
-			pTexture = LoadTextureArrayFromMemory(
+			TArray<const void*> mipChains(count);
+			for (uint32 i = 0; i < count; i++)
+			{
+				mipChains[i] = batch.Images[i].pPixels;
+			}
+
+			pTexture = UploadTextureArray(
 				name,
-				stbi_pixels.GetData(),
-				stbi_pixels.GetSize(),
+				mipChains.GetData(),
+				count,
 				texWidth,
 				texHeight,
 				format,
 				FTextureFlag::TEXTURE_FLAG_SHADER_RESOURCE,
-				generateMips,
+				batch.Images[0].Miplevels,
+				generateMips && !decodeMips,
 				linearFilteringMips);
 		}
 		else if (format == EFormat::FORMAT_R16_UNORM)
 		{
+			const uint32 numPixels = texWidth * texHeight;
+
+			ImageArena* pArena = TextureDecoder::AcquireArena();
+			uint16* pChannels = reinterpret_cast<uint16*>(pArena->Allocate(uint64(count) * 4 * numPixels * sizeof(uint16)));
+
 			TArray<void*> pixels(count * 4);
 			for (uint32 i = 0; i < count; i++)
 			{
-				uint32 numPixels = texWidth * texHeight;
-				uint16* pPixelsR = DBG_NEW uint16[numPixels];
-				uint16* pPixelsG = DBG_NEW uint16[numPixels];
-				uint16* pPixelsB = DBG_NEW uint16[numPixels];
-				uint16* pPixelsA = DBG_NEW uint16[numPixels];
+				uint16* pPixelsR = pChannels + uint64(4 * i + 0) * numPixels;
+				uint16* pPixelsG = pChannels + uint64(4 * i + 1) * numPixels;
+				uint16* pPixelsB = pChannels + uint64(4 * i + 2) * numPixels;
+				uint16* pPixelsA = pChannels + uint64(4 * i + 3) * numPixels;
 
-				uint16* pSTBIPixels = reinterpret_cast<uint16*>(stbi_pixels[i]);
+				const uint16* pSTBIPixels = reinterpret_cast<const uint16*>(batch.Images[i].pPixels);
 
 				for (uint32 p = 0; p < numPixels; p++)
 				{
@@ -677,17 +838,10 @@ namespace LambdaEngine
 				generateMips,
 				linearFilteringMips);
 
-			for (uint32 i = 0; i < pixels.GetSize(); i++)
-			{
-				uint16* pPixels = reinterpret_cast<uint16*>(pixels[i]);
-				SAFEDELETE_ARRAY(pPixels);
-			}
+			TextureDecoder::ReleaseArena(pArena);
 		}
 
-		for (uint32 i = 0; i < count; i++)
-		{
-			stbi_image_free(stbi_pixels[i]);
-		}
+		TextureDecoder::ReleaseBatch(batch);
 
 		return pTexture;
 	}
@@ -984,62 +1138,54 @@ namespace LambdaEngine
 		bool generateMips,
 		bool linearFilteringMips)
 	{
-		int texWidth	= 0;
-		int texHeight	= 0;
-		int bpp			= 0;
+		if (format != EFormat::FORMAT_R8G8B8A8_UNORM)
+		{
+			LOG_ERROR("Texture format not supported for \"%s\"", name.c_str());
+			return nullptr;
+		}
 
 		const uint32 textureCount = count;
-		TArray<void*> stbi_pixels(textureCount);
-
+		TArray<String> filepaths(textureCount);
 		for (uint32 i = 0; i < textureCount; i++)
 		{
-			const String filepath = dir + ConvertSlashes(pFilenames[i]);
-
-			void* pPixels = nullptr;
-			if (format == EFormat::FORMAT_R8G8B8A8_UNORM)
-			{
-				pPixels = (void*)stbi_load(filepath.c_str(), &texWidth, &texHeight, &bpp, STBI_rgb_alpha);
-			}
-			else
-			{
-				LOG_ERROR("Texture format not supported for \"%s\"", filepath.c_str());
-				return nullptr;
-			}
-
-			if (pPixels == nullptr)
-			{
-				LOG_ERROR("Failed to load texture file: \"%s\"", filepath.c_str());
-				return nullptr;
-			}
-
-			stbi_pixels[i] = pPixels;
+			filepaths[i] = dir + ConvertSlashes(pFilenames[i]);
+		}
 
-#ifdef RESOURCE_LOADER_LOGS_ENABLED
-			LOG_DEBUG("Loaded Texture \"%s\"", filepath.c_str());
-#endif
+		DecodedImageBatch batch;
+		if (!TextureDecoder::DecodeFiles(filepaths.GetData(), textureCount, format, generateMips, linearFilteringMips, batch) || !ValidateDecodedImageSizes(name, batch))
+		{
+			TextureDecoder::ReleaseBatch(batch);
+			return nullptr;
 		}
 
-		Texture* pTexture = nullptr;
-		if (format == EFormat::FORMAT_R8G8B8A8_UNORM)
+#ifdef RESOURCE_LOADER_LOGS_ENABLED
+		for (uint32 i = 0; i < textureCount; i++)
 		{
-			const uint32 flags = FTextureFlag::TEXTURE_FLAG_CUBE_COMPATIBLE | FTextureFlag::TEXTURE_FLAG_SHADER_RESOURCE;
-			pTexture = LoadTextureArrayFromMemory(
-				name,
-				stbi_pixels.GetData(),
-				stbi_pixels.GetSize(),
-				texWidth,
-				texHeight,
-				format,
-				flags,
-				generateMips,
-				linearFilteringMips);
+			LOG_DEBUG("Loaded Texture \"%s\"", filepaths[i].c_str());
 		}
+#endif
 
+		TArray<const void*> mipChains(textureCount);
 		for (uint32 i = 0; i < textureCount; i++)
 		{
-			stbi_image_free(stbi_pixels[i]);
+			mipChains[i] = batch.Images[i].pPixels;
 		}
 
+		const uint32 flags = FTextureFlag::TEXTURE_FLAG_CUBE_COMPATIBLE | FTextureFlag::TEXTURE_FLAG_SHADER_RESOURCE;
+		Texture* pTexture = UploadTextureArray(
+			name,
+			mipChains.GetData(),
+			textureCount,
+			batch.Images[0].Width,
+			batch.Images[0].Height,
+			format,
+			flags,
+			batch.Images[0].Miplevels,
+			false,
+			linearFilteringMips);
+
+		TextureDecoder::ReleaseBatch(batch);
+
 		return pTexture;
 	}
 
@@ -1054,12 +1200,51 @@ namespace LambdaEngine
 		bool generateMips,
 		bool linearFilteringMips)
 	{
-		uint32_t miplevels = 1u;
-		if (generateMips)
+		if (!generateMips)
+		{
+			return UploadTextureArray(name, ppData, arrayCount, width, height, format, usageFlags, 1, false, linearFilteringMips);
+		}
+
+		const uint32 miplevels = TextureDecoder::CalculateMiplevels(width, height);
+		if (!TextureDecoder::SupportsCPUMips(format))
 		{
-			miplevels = uint32(glm::floor(glm::log2((float)glm::max(width, height)))) + 1u;
+			return UploadTextureArray(name, ppData, arrayCount, width, height, format, usageFlags, miplevels, true, linearFilteringMips);
 		}
 
+		// Build the mip chains on the CPU so that the whole texture is uploaded with one copy
+		const uint64 level0Size	= uint64(width) * height * TextureFormatStride(format);
+		const uint64 chainSize	= TextureDecoder::CalculateMipChainSize(width, height, miplevels, format);
+
+		ImageArena* pArena = TextureDecoder::AcquireArena();
+
+		TArray<const void*> mipChains(arrayCount);
+		for (uint32 i = 0; i < arrayCount; i++)
+		{
+			void* pMipChain = pArena->Allocate(chainSize);
+			memcpy(pMipChain, ppData[i], level0Size);
+			TextureDecoder::GenerateMipChain(pMipChain, width, height, miplevels, format, linearFilteringMips);
+			mipChains[i] = pMipChain;
+		}
+
+		Texture* pTexture = UploadTextureArray(name, mipChains.GetData(), arrayCount, width, height, format, usageFlags, miplevels, false, linearFilteringMips);
+
+		TextureDecoder::ReleaseArena(pArena);
+
+		return pTexture;
+	}
+
+	Texture* ResourceLoader::UploadTextureArray(
+		const String& name,
+		const void* const * ppMipChains,
+		uint32 arrayCount,
+		uint32 width,
+		uint32 height,
+		EFormat format,
+		uint32 usageFlags,
+		uint32 miplevels,
+		bool generateMipsOnGPU,
+		bool linearFilteringMips)
+	{
 		TextureDesc textureDesc = {};
 		textureDesc.DebugName	= name;
 		textureDesc.MemoryType	= EMemoryType::MEMORY_TYPE_GPU;
@@ -1080,13 +1265,27 @@ namespace LambdaEngine
 			return nullptr;
 		}
 
-		const uint32 pixelDataSize = width * height * TextureFormatStride(format);
+		// Miplevels that are generated on the GPU are not part of the uploaded data
+		const uint32 uploadedMiplevels	= generateMipsOnGPU ? 1 : miplevels;
+		const uint64 bytesPerTexel		= TextureFormatStride(format);
+
+		// Buffer offsets of copies must be multiples of four, which the tightly packed mips of odd sized one and two byte
+		// formats are not. The mips are therefore placed at aligned offsets in the copy buffer
+		constexpr const uint64 COPY_OFFSET_ALIGNMENT = 4;
+
+		uint64 alignedMipChainSize = 0;
+		for (uint32 m = 0; m < uploadedMiplevels; m++)
+		{
+			alignedMipChainSize = AlignUp(alignedMipChainSize, COPY_OFFSET_ALIGNMENT);
+			alignedMipChainSize += uint64(glm::max(width >> m, 1u)) * glm::max(height >> m, 1u) * bytesPerTexel;
+		}
+		alignedMipChainSize = AlignUp(alignedMipChainSize, COPY_OFFSET_ALIGNMENT);
 
 		BufferDesc bufferDesc	= { };
 		bufferDesc.DebugName	= "Texture Copy Buffer";
 		bufferDesc.MemoryType	= EMemoryType::MEMORY_TYPE_CPU_VISIBLE;
 		bufferDesc.Flags		= FBufferFlag::BUFFER_FLAG_COPY_SRC;
-		bufferDesc.SizeInBytes	= uint64(arrayCount * pixelDataSize);
+		bufferDesc.SizeInBytes	= uint64(arrayCount) * alignedMipChainSize;
 
 		Buffer* pTextureData = RenderAPI::GetDevice()->CreateBuffer(&bufferDesc);
 		if (pTextureData == nullptr)
@@ -1120,31 +1319,43 @@ namespace LambdaEngine
 			FPipelineStageFlag::PIPELINE_STAGE_FLAG_COPY,
 			&transitionToCopyDstBarrier, 1);
 
+		byte* pTextureDataDst = reinterpret_cast<byte*>(pTextureData->Map());
 		for (uint32 i = 0; i < arrayCount; i++)
 		{
-			uint64 bufferOffset = uint64(i) * pixelDataSize;
+			const uint64 arrayOffset = uint64(i) * alignedMipChainSize;
+			const byte* pSrcMip = reinterpret_cast<const byte*>(ppMipChains[i]);
 
-			void* pTextureDataDst = pTextureData->Map();
-			const void* pTextureDataSrc = ppData[i];
-			memcpy((void*)(uint64(pTextureDataDst) + bufferOffset), pTextureDataSrc, pixelDataSize);
-			pTextureData->Unmap();
+			uint64 mipOffset = 0;
+			for (uint32 m = 0; m < uploadedMiplevels; m++)
+			{
+				const uint32 mipWidth	= glm::max(width >> m, 1u);
+				const uint32 mipHeight	= glm::max(height >> m, 1u);
+				const uint64 mipSize	= uint64(mipWidth) * mipHeight * bytesPerTexel;
 
-			CopyTextureBufferDesc copyDesc = {};
-			copyDesc.BufferOffset	= bufferOffset;
-			copyDesc.BufferRowPitch	= 0;
-			copyDesc.BufferHeight	= 0;
-			copyDesc.Width			= width;
-			copyDesc.Height			= height;
-			copyDesc.Depth			= 1;
-			copyDesc.Miplevel		= 0;
-			copyDesc.MiplevelCount  = miplevels;
-			copyDesc.ArrayIndex		= i;
-			copyDesc.ArrayCount		= 1;
+				mipOffset = AlignUp(mipOffset, COPY_OFFSET_ALIGNMENT);
+				memcpy(pTextureDataDst + arrayOffset + mipOffset, pSrcMip, mipSize);
+				pSrcMip += mipSize;
 
-			s_pCopyCommandList->CopyTextureFromBuffer(pTextureData, pTexture, copyDesc);
+				CopyTextureBufferDesc copyDesc = {};
+				copyDesc.BufferOffset	= arrayOffset + mipOffset;
+				copyDesc.BufferRowPitch	= 0;
+				copyDesc.BufferHeight	= 0;
+				copyDesc.Width			= mipWidth;
+				copyDesc.Height			= mipHeight;
+				copyDesc.Depth			= 1;
+				copyDesc.Miplevel		= m;
+				copyDesc.MiplevelCount	= 1;
+				copyDesc.ArrayIndex		= i;
+				copyDesc.ArrayCount		= 1;
+
+				s_pCopyCommandList->CopyTextureFromBuffer(pTextureData, pTexture, copyDesc);
+
+				mipOffset += mipSize;
+			}
 		}
+		pTextureData->Unmap();
 
-		if (generateMips)
+		if (generateMipsOnGPU)
 		{
 			s_pCopyCommandList->GenerateMips(
 				pTexture,
@@ -1204,49 +1415,72 @@ namespace LambdaEngine
 	{
 		const String file = ConvertSlashes(filepath);
 
-		byte* pShaderRawSource = nullptr;
-		uint32 shaderRawSourceSize = 0;
-
 		TArray<uint32> sourceSPIRV;
-		if (lang == EShaderLang::SHADER_LANG_GLSL)
+		if (!CompileShaderFileToSPIRV(file, stage, lang, entryPoint, sourceSPIRV))
 		{
-			if (!ReadDataFromFile(file, "r", &pShaderRawSource, &shaderRawSourceSize))
+			return nullptr;
+		}
+
+		return CreateShaderFromSPIRV(file, sourceSPIRV, stage, lang, entryPoint);
+	}
+
+	void ResourceLoader::LoadShadersFromFile(const ShaderFileLoadDesc* pLoadDescs, uint32 shaderCount, Shader** ppShaders)
+	{
+		TArray<TArray<uint32>> sourcesSPIRV(shaderCount);
+		CompileShaderFilesParallel(pLoadDescs, shaderCount, sourcesSPIRV.GetData());
+
+		// Shader objects are created on the calling thread, only the compilation is done in parallel
+		for (uint32 s = 0; s < shaderCount; s++)
+		{
+			const ShaderFileLoadDesc& loadDesc = pLoadDescs[s];
+			if (!sourcesSPIRV[s].IsEmpty())
 			{
-				LOG_ERROR("Failed to open shader file \"%s\"", file.c_str());
-				return nullptr;
+				ppShaders[s] = CreateShaderFromSPIRV(ConvertSlashes(loadDesc.Filepath), sourcesSPIRV[s], loadDesc.Stage, loadDesc.Lang, loadDesc.EntryPoint);
 			}
-
-			if (!CompileGLSLToSPIRV(file, reinterpret_cast<char*>(pShaderRawSource), stage, &sourceSPIRV, nullptr))
+			else
 			{
-				LOG_ERROR("Failed to compile GLSL to SPIRV for \"%s\"", file.c_str());
-				return nullptr;
+				ppShaders[s] = nullptr;
 			}
 		}
-		else if (lang == EShaderLang::SHADER_LANG_SPIRV)
+	}
+
+	uint32 ResourceLoader::CompileShaderDirectory(const String& directory)
+	{
+		TArray<ShaderFileLoadDesc> loadDescs;
+
+		std::error_code error;
+		for (const std::filesystem::directory_entry& entry : std::filesystem::recursive_directory_iterator(directory, error))
 		{
-			if (!ReadDataFromFile(file, "rb", &pShaderRawSource, &shaderRawSourceSize))
+			if (!entry.is_regular_file())
 			{
-				LOG_ERROR("Failed to open shader file \"%s\"", file.c_str());
-				return nullptr;
+				continue;
 			}
 
-			sourceSPIRV.Resize(static_cast<uint32>(glm::ceil(static_cast<float32>(shaderRawSourceSize) / sizeof(uint32))));
-			memcpy(sourceSPIRV.GetData(), pShaderRawSource, shaderRawSourceSize);
+			// Files without a known stage are includes, they are compiled as part of the shaders that include them
+			const FShaderStageFlag stage = GetShaderStageFromExtension(entry.path().extension().string());
+			if (stage != FShaderStageFlag::SHADER_STAGE_FLAG_NONE)
+			{
+				ShaderFileLoadDesc loadDesc = {};
+				loadDesc.Filepath	= entry.path().string();
+				loadDesc.Stage		= stage;
+				loadDesc.Lang		= EShaderLang::SHADER_LANG_GLSL;
+				loadDescs.PushBack(loadDesc);
+			}
 		}
 
-		const uint32 sourceSize = static_cast<uint32>(sourceSPIRV.GetSize()) * sizeof(uint32);
+		TArray<TArray<uint32>> sourcesSPIRV(loadDescs.GetSize());
+		CompileShaderFilesParallel(loadDescs.GetData(), loadDescs.GetSize(), sourcesSPIRV.GetData());
 
-		ShaderDesc shaderDesc = { };
-		shaderDesc.DebugName	= file;
-		shaderDesc.Source		= TArray<byte>(reinterpret_cast<byte*>(sourceSPIRV.GetData()), reinterpret_cast<byte*>(sourceSPIRV.GetData()) + sourceSize);
-		shaderDesc.EntryPoint	= entryPoint;
-		shaderDesc.Stage		= stage;
-		shaderDesc.Lang			= lang;
-
-		Shader* pShader = RenderAPI::GetDevice()->CreateShader(&shaderDesc);
-		Malloc::Free(pShaderRawSource);
+		uint32 compiledShaderCount = 0;
+		for (const TArray<uint32>& sourceSPIRV : sourcesSPIRV)
+		{
+			if (!sourceSPIRV.IsEmpty())
+			{
+				compiledShaderCount++;
+			}
+		}
 
-		return pShader;
+		return compiledShaderCount;
 	}
 
 	Shader* ResourceLoader::LoadShaderFromMemory(
@@ -1259,7 +1493,7 @@ namespace LambdaEngine
 		TArray<uint32> sourceSPIRV;
 		if (lang == EShaderLang::SHADER_LANG_GLSL)
 		{
-			if (!CompileGLSLToSPIRV("", source.c_str(), stage, &sourceSPIRV, nullptr))
+			if (!CompileGLSLToSPIRV("", source.c_str(), stage, entryPoint, "", &sourceSPIRV, nullptr))
 			{
 				LOG_ERROR("Failed to compile GLSL to SPIRV");
 				return nullptr;
@@ -1338,7 +1572,7 @@ namespace LambdaEngine
 				return false;
 			}
 
-			if (!CompileGLSLToSPIRV(path, reinterpret_cast<char*>(pShaderRawSource), stage, nullptr, pReflection))
+			if (!CompileGLSLToSPIRV(path, reinterpret_cast<char*>(pShaderRawSource), stage, "main", "", nullptr, pReflection))
 			{
 				LOG_ERROR("Failed to compile GLSL to SPIRV for \"%s\"", path.c_str());
 				return false;
@@ -2271,8 +2505,22 @@ namespace LambdaEngine
 		// Load all meshes
 		if (!sceneLoadRequest.AnimationsOnly)
 		{
+			const uint32 firstMeshIndex = context.Meshes.GetSize();
+
+			// Textures are only loaded together with materials
+			if (context.pMaterials)
+			{
+				PrefetchSceneTextures(context, pScene);
+			}
+
 			aiMatrix4x4 identity;
 			ProcessAssimpNode(context, pScene->mRootNode, pScene, &identity);
+
+			context.PrefetchedImages.clear();
+			TextureDecoder::ReleaseBatch(context.PrefetchedImageBatch);
+			TextureDecoder::ReleaseArenaPool();
+
+			LoadMeshletsFromCacheParallel(context.Meshes.GetData() + firstMeshIndex, context.Meshes.GetSize() - firstMeshIndex);
 		}
 
 		// Load all animations
@@ -2293,6 +2541,82 @@ namespace LambdaEngine
 		return true;
 	}
 
+	void ResourceLoader::PrefetchSceneTextures(SceneLoadingContext& context, const aiScene* pScene)
+	{
+		// Same texture types that LoadMaterial looks for, GLTF textures are stored as DIFFUSE and UNKNOWN
+		constexpr const aiTextureType MATERIAL_TEXTURE_TYPES[] =
+		{
+			aiTextureType_BASE_COLOR,
+			aiTextureType_DIFFUSE,
+			aiTextureType_NORMAL_CAMERA,
+			aiTextureType_NORMALS,
+			aiTextureType_HEIGHT,
+			aiTextureType_AMBIENT_OCCLUSION,
+			aiTextureType_AMBIENT,
+			aiTextureType_METALNESS,
+			aiTextureType_REFLECTION,
+			aiTextureType_DIFFUSE_ROUGHNESS,
+			aiTextureType_SHININESS,
+			aiTextureType_UNKNOWN
+		};
+
+		TArray<bool> usedMaterials(pScene->mNumMaterials, false);
+		for (uint32 m = 0; m < pScene->mNumMeshes; m++)
+		{
+			usedMaterials[pScene->mMeshes[m]->mMaterialIndex] = true;
+		}
+
+		TArray<String> names;
+		TArray<String> filepaths;
+		THashTable<String, uint32> uniqueNames;
+		for (uint32 materialIndex = 0; materialIndex < pScene->mNumMaterials; materialIndex++)
+		{
+			if (!usedMaterials[materialIndex])
+			{
+				continue;
+			}
+
+			const aiMaterial* pMaterialAI = pScene->mMaterials[materialIndex];
+			for (aiTextureType type : MATERIAL_TEXTURE_TYPES)
+			{
+				const uint32 textureCount = pMaterialAI->GetTextureCount(type);
+				for (uint32 t = 0; t < textureCount; t++)
+				{
+					aiString str;
+					pMaterialAI->GetTexture(type, t, &str);
+
+					// Embedded textures are decoded from memory when the material is loaded
+					String name = str.C_Str();
+					if (name.empty() || name[0] == '*')
+					{
+						continue;
+					}
+
+					ConvertSlashes(name);
+					RemoveExtraData(name);
+
+					if (context.LoadedTextures.count(name) == 0 && uniqueNames.count(name) == 0)
+					{
+						uniqueNames[name] = names.GetSize();
+						names.PushBack(name);
+						filepaths.PushBack(context.DirectoryPath + name);
+					}
+				}
+			}
+		}
+
+		// Failed images are skipped here and reported again by the regular path when the material is loaded
+		TextureDecoder::DecodeFiles(filepaths.GetData(), filepaths.GetSize(), EFormat::FORMAT_R8G8B8A8_UNORM, true, true, context.PrefetchedImageBatch);
+		for (uint32 i = 0; i < names.GetSize(); i++)
+		{
+			const DecodedImage& image = context.PrefetchedImageBatch.Images[i];
+			if (image.Succeeded)
+			{
+				context.PrefetchedImages[names[i]] = &image;
+			}
+		}
+	}
+
 	void ResourceLoader::ProcessAssimpNode(SceneLoadingContext& context, const aiNode* pNode, const aiScene* pScene, const void* pParentTransform)
 	{
 		String nodeName = pNode->mName.C_Str();
@@ -2403,7 +2727,7 @@ namespace LambdaEngine
 						}
 					}
 
-					MeshFactory::GenerateMeshlets(pMesh, MAX_VERTS, MAX_PRIMS);
+					// Meshlets are generated for all meshes at once when the scene has been processed
 					context.Meshes.EmplaceBack(pMesh);
 
 					MeshComponent newMeshComponent;
@@ -2447,10 +2771,79 @@ namespace LambdaEngine
 		}
 	}
 
+	bool ResourceLoader::CompileShaderFileToSPIRV(const String& filepath, FShaderStageFlag stage, EShaderLang lang, const String& entryPoint, TArray<uint32>& sourceSPIRV)
+	{
+		byte* pShaderRawSource = nullptr;
+		uint32 shaderRawSourceSize = 0;
+
+		if (lang == EShaderLang::SHADER_LANG_GLSL)
+		{
+			if (!ReadDataFromFile(filepath, "r", &pShaderRawSource, &shaderRawSourceSize))
+			{
+				LOG_ERROR("Failed to open shader file \"%s\"", filepath.c_str());
+				return false;
+			}
+
+			if (!CompileGLSLToSPIRV(filepath, reinterpret_cast<char*>(pShaderRawSource), stage, entryPoint, "", &sourceSPIRV, nullptr))
+			{
+				LOG_ERROR("Failed to compile GLSL to SPIRV for \"%s\"", filepath.c_str());
+				Malloc::Free(pShaderRawSource);
+				return false;
+			}
+		}
+		else if (lang == EShaderLang::SHADER_LANG_SPIRV)
+		{
+			if (!ReadDataFromFile(filepath, "rb", &pShaderRawSource, &shaderRawSourceSize))
+			{
+				LOG_ERROR("Failed to open shader file \"%s\"", filepath.c_str());
+				return false;
+			}
+
+			sourceSPIRV.Resize(static_cast<uint32>(glm::ceil(static_cast<float32>(shaderRawSourceSize) / sizeof(uint32))));
+			memcpy(sourceSPIRV.GetData(), pShaderRawSource, shaderRawSourceSize);
+		}
+
+		Malloc::Free(pShaderRawSource);
+		return true;
+	}
+
+	void ResourceLoader::CompileShaderFilesParallel(const ShaderFileLoadDesc* pLoadDescs, uint32 shaderCount, TArray<uint32>* pSourcesSPIRV)
+	{
+		ThreadPool::ParallelFor(shaderCount, [pLoadDescs, pSourcesSPIRV](uint32 shaderIndex)
+			{
+				const ShaderFileLoadDesc& loadDesc = pLoadDescs[shaderIndex];
+				if (!CompileShaderFileToSPIRV(ConvertSlashes(loadDesc.Filepath), loadDesc.Stage, loadDesc.Lang, loadDesc.EntryPoint, pSourcesSPIRV[shaderIndex]))
+				{
+					pSourcesSPIRV[shaderIndex].Clear();
+				}
+			});
+	}
+
+	Shader* ResourceLoader::CreateShaderFromSPIRV(
+		const String& name,
+		const TArray<uint32>& sourceSPIRV,
+		FShaderStageFlag stage,
+		EShaderLang lang,
+		const String& entryPoint)
+	{
+		const uint32 sourceSize = static_cast<uint32>(sourceSPIRV.GetSize()) * sizeof(uint32);
+
+		ShaderDesc shaderDesc = { };
+		shaderDesc.DebugName	= name;
+		shaderDesc.Source		= TArray<byte>(reinterpret_cast<const byte*>(sourceSPIRV.GetData()), reinterpret_cast<const byte*>(sourceSPIRV.GetData()) + sourceSize);
+		shaderDesc.EntryPoint	= entryPoint;
+		shaderDesc.Stage		= stage;
+		shaderDesc.Lang			= lang;
+
+		return RenderAPI::GetDevice()->CreateShader(&shaderDesc);
+	}
+
 	bool ResourceLoader::CompileGLSLToSPIRV(
 		const String& filepath,
 		const char* pSource,
 		FShaderStageFlags stage,
+		const String& entryPoint,
+		const String& defines,
 		TArray<uint32>* pSourceSPIRV,
 		ShaderReflection* pReflection)
 	{
@@ -2461,8 +2854,6 @@ namespace LambdaEngine
 		EShLanguage shaderType = ConvertShaderStageToEShLanguage(stage);
 		glslang::TShader shader(shaderType);
 
-		shader.setStringsWithLengths(&pFinalSource, &size, 1);
-
 		//Todo: Fetch this
 		int32 clientInputSemanticsVersion					= GetDefaultClientInputSemanticsVersion();
 		glslang::EShTargetClientVersion vulkanClientVersion	= GetDefaultVulkanClientVersion();
@@ -2483,17 +2874,39 @@ namespace LambdaEngine
 
 		includer.pushExternalLocalDirectory(directoryPath);
 
-		//std::string preprocessedGLSL;
-		//if (!shader.preprocess(pResources, defaultVersion, ENoProfile, false, false, messages, &preprocessedGLSL, includer))
-		//{
-		//	LOG_ERROR("GLSL Preprocessing failed for: \"%s\"\n%s\n%s", filepath.c_str(), shader.getInfoLog(), shader.getInfoDebugLog());
-		//	return false;
-		//}
+		// The source is preprocessed once, the output is both parsed and used as the cache key so that the key covers included files as well
+		glslang::TShader preprocessShader(shaderType);
+		preprocessShader.setPreamble(defines.c_str());
+		preprocessShader.setStringsWithLengths(&pFinalSource, &size, 1);
+		preprocessShader.setEnvInput(glslang::EShSourceGlsl, shaderType, glslang::EShClientVulkan, clientInputSemanticsVersion);
+		preprocessShader.setEnvClient(glslang::EShClientVulkan, vulkanClientVersion);
+		preprocessShader.setEnvTarget(glslang::EShTargetSpv, targetVersion);
 
-		//const char* pPreprocessedGLSL = preprocessedGLSL.c_str();
-		//shader.setStrings(&pPreprocessedGLSL, 1);
+		std::string preprocessedGLSL;
+		if (!preprocessShader.preprocess(pResources, defaultVersion, ENoProfile, false, false, messages, &preprocessedGLSL, includer))
+		{
+			LOG_ERROR("GLSL Preprocessing failed for: \"%s\"\n%s\n%s", filepath.c_str(), preprocessShader.getInfoLog(), preprocessShader.getInfoDebugLog());
+			return false;
+		}
+
+		// Only the SPIR-V is cached, reflection still requires a full compile
+		const bool useCache = pSourceSPIRV != nullptr && pReflection == nullptr && ShaderCache::IsEnabled();
 
-		if (!shader.parse(pResources, defaultVersion, false, messages, includer))
+		uint64 cacheKey = 0;
+		if (useCache)
+		{
+			cacheKey = ShaderCache::CalculateKey(preprocessedGLSL, stage, defines, entryPoint);
+			if (ShaderCache::Load(cacheKey, *pSourceSPIRV))
+			{
+				return true;
+			}
+		}
+
+		const char* pPreprocessedGLSL = preprocessedGLSL.c_str();
+		shader.setStrings(&pPreprocessedGLSL, 1);
+		shader.setEntryPoint(entryPoint.c_str());
+
+		if (!shader.parse(pResources, defaultVersion, false, messages))
 		{
 			const char* pShaderInfoLog = shader.getInfoLog();
 			const char* pShaderDebugInfo = shader.getInfoDebugLog();
@@ -2521,6 +2934,11 @@ namespace LambdaEngine
 			std::vector<uint32> std_sourceSPIRV;
 			glslang::GlslangToSpv(*pIntermediate, std_sourceSPIRV, &logger, &spvOptions);
 			pSourceSPIRV->Assign(std_sourceSPIRV.data(), std_sourceSPIRV.data() + std_sourceSPIRV.size());
+
+			if (useCache)
+			{
+				ShaderCache::Store(cacheKey, *pSourceSPIRV);
+			}
 		}
 
 		if (pReflection != nullptr)
@@ -2552,54 +2970,207 @@ namespace LambdaEngine
 		return true;
 	}
 
-	void ResourceLoader::LoadMeshletsFromCache(const String& name, Mesh* pMesh)
+	void ResourceLoader::LoadMeshletsFromCache(Mesh* pMesh)
 	{
+		constexpr const uint32 MESHLET_CACHE_MAGIC		= 0x4C53454D; // 'MESL'
+		constexpr const uint32 MESHLET_CACHE_VERSION	= 2;
+
 		struct MeshletCacheHeader
 		{
+			uint32 Magic;
+			uint32 Version;
+			uint64 SourceHash;
 			uint32 MeshletCount;
 			uint32 PrimitiveIndexCount;
 			uint32 UniqueIndexCount;
+			uint32 Padding;
 		};
 
-		const String meshletCachePath = MESHLET_CACHE_DIR + name;
+		// Key the entry on everything that affects the generated meshlets
+		uint64 sourceHash = HashMemory(pMesh->Vertices.GetData(), pMesh->Vertices.GetSize() * sizeof(Vertex));
+		sourceHash = HashMemory(pMesh->Indices.GetData(), pMesh->Indices.GetSize() * sizeof(MeshIndexType), sourceHash);
+		sourceHash = HashValue<uint32>(MAX_VERTS, sourceHash);
+		sourceHash = HashValue<uint32>(MAX_PRIMS, sourceHash);
 
-		std::fstream file;
-		file.open(meshletCachePath, std::fstream::in | std::fstream::binary);
+		char hashString[17];
+		snprintf(hashString, sizeof(hashString), "%016llx", sourceHash);
+		const String meshletCachePath = String(MESHLET_CACHE_DIR) + hashString + ".meshlets";
 
-		// If file doesn't exist, create it. Otherwise, load meshlets from file to memory.
-		if (!file)
+		// Try to load a valid entry
 		{
-			file.open(meshletCachePath, std::fstream::out | std::fstream::binary);
+			std::ifstream file(meshletCachePath, std::ifstream::in | std::ifstream::binary);
+			if (file)
+			{
+				MeshletCacheHeader header = {};
+				file.read((char*)&header, sizeof(MeshletCacheHeader));
 
-			MeshFactory::GenerateMeshlets(pMesh, MAX_VERTS, MAX_PRIMS);
+				if (file && header.Magic == MESHLET_CACHE_MAGIC && header.Version == MESHLET_CACHE_VERSION && header.SourceHash == sourceHash)
+				{
+					pMesh->Meshlets.Resize(header.MeshletCount);
+					pMesh->PrimitiveIndices.Resize(header.PrimitiveIndexCount);
+					pMesh->UniqueIndices.Resize(header.UniqueIndexCount);
+
+					file.read((char*)pMesh->Meshlets.GetData(), header.MeshletCount * sizeof(Meshlet));
+					file.read((char*)pMesh->PrimitiveIndices.GetData(), header.PrimitiveIndexCount * sizeof(PackedTriangle));
+					file.read((char*)pMesh->UniqueIndices.GetData(), header.UniqueIndexCount * sizeof(MeshIndexType));
+
+					if (file)
+					{
+						return;
+					}
+				}
+
+				LOG_WARNING("Meshlet cache entry \"%s\" is invalid or outdated, regenerating", meshletCachePath.c_str());
+			}
+		}
+
+		pMesh->Meshlets.Clear();
+		pMesh->PrimitiveIndices.Clear();
+		pMesh->UniqueIndices.Clear();
+
+		MeshFactory::GenerateMeshlets(pMesh, MAX_VERTS, MAX_PRIMS);
+
+		// Write to a temporary file first, identical meshes may be written from several threads at once
+		std::error_code error;
+		std::filesystem::create_directories(MESHLET_CACHE_DIR, error);
+
+		const String temporaryPath = meshletCachePath + "." + std::to_string(reinterpret_cast<uintptr_t>(pMesh)) + ".tmp";
+		{
+			std::ofstream file(temporaryPath, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+			if (!file)
+			{
+				LOG_WARNING("Failed to write meshlet cache entry \"%s\"", meshletCachePath.c_str());
+				return;
+			}
 
 			const MeshletCacheHeader header =
 			{
-				.MeshletCount = pMesh->Meshlets.GetSize(),
-				.PrimitiveIndexCount = pMesh->PrimitiveIndices.GetSize(),
-				.UniqueIndexCount = pMesh->UniqueIndices.GetSize()
+				.Magic					= MESHLET_CACHE_MAGIC,
+				.Version				= MESHLET_CACHE_VERSION,
+				.SourceHash				= sourceHash,
+				.MeshletCount			= pMesh->Meshlets.GetSize(),
+				.PrimitiveIndexCount	= pMesh->PrimitiveIndices.GetSize(),
+				.UniqueIndexCount		= pMesh->UniqueIndices.GetSize(),
+				.Padding				= 0
 			};
 
 			file.write((const char*)&header, sizeof(MeshletCacheHeader));
-
 			file.write((const char*)pMesh->Meshlets.GetData(), header.MeshletCount * sizeof(Meshlet));
 			file.write((const char*)pMesh->PrimitiveIndices.GetData(), header.PrimitiveIndexCount * sizeof(PackedTriangle));
-			file.write((const char*)pMesh->UniqueIndices.GetData(), header.UniqueIndexCount * sizeof(uint32));
+			file.write((const char*)pMesh->UniqueIndices.GetData(), header.UniqueIndexCount * sizeof(MeshIndexType));
 		}
-		else
+
+		std::filesystem::rename(temporaryPath, meshletCachePath, error);
+		if (error)
 		{
-			MeshletCacheHeader header;
-			file.read((char*)&header, sizeof(MeshletCacheHeader));
+			std::filesystem::remove(temporaryPath, error);
+		}
+	}
+
+	void ResourceLoader::LoadMeshletsFromCacheParallel(Mesh* const* ppMeshes, uint32 meshCount)
+	{
+		ThreadPool::ParallelFor(meshCount, [ppMeshes](uint32 meshIndex) { LoadMeshletsFromCache(ppMeshes[meshIndex]); });
+	}
+
+	uint32 ResourceLoader::BakeMeshletCache(const String& directory, int32 assimpFlags, bool shouldTessellate)
+	{
+		Assimp::Importer importer;
+
+		uint32 bakedMeshCount = 0;
+		std::error_code error;
+		for (const std::filesystem::directory_entry& entry : std::filesystem::recursive_directory_iterator(directory, error))
+		{
+			if (entry.is_directory() || !importer.IsExtensionSupported(entry.path().extension().string()))
+			{
+				continue;
+			}
+
+			TArray<Mesh*>			meshes;
+			TArray<MeshComponent>	meshComponents;
 
-			pMesh->Meshlets.Resize(header.MeshletCount);
-			pMesh->PrimitiveIndices.Resize(header.PrimitiveIndexCount);
-			pMesh->UniqueIndices.Resize(header.UniqueIndexCount);
+			const TArray<LevelObjectOnLoadDesc>	levelObjectDescriptions;
+			TArray<LoadedDirectionalLight>		directionalLights;
+			TArray<LoadedPointLight>			pointLights;
+			TArray<LevelObjectOnLoad>			levelObjects;
 
-			file.read((char*)pMesh->Meshlets.GetData(), header.MeshletCount * sizeof(Meshlet));
-			file.read((char*)pMesh->PrimitiveIndices.GetData(), header.PrimitiveIndexCount * sizeof(PackedTriangle));
-			file.read((char*)pMesh->UniqueIndices.GetData(), header.UniqueIndexCount * sizeof(uint32));
+			SceneLoadRequest loadRequest =
+			{
+				.Filepath					= ConvertSlashes(entry.path().string()),
+				.AssimpFlags				= assimpFlags,
+				.LevelObjectDescriptions	= levelObjectDescriptions,
+				.DirectionalLights			= directionalLights,
+				.PointLights				= pointLights,
+				.LevelObjects				= levelObjects,
+				.Meshes						= meshes,
+				.pAnimations				= nullptr,
+				.MeshComponents				= meshComponents,
+				.pMaterials					= nullptr,
+				.pTextures					= nullptr,
+				.AnimationsOnly				= false,
+				.ShouldTessellate			= shouldTessellate
+			};
+
+			// LoadSceneWithAssimp writes cache entries for every mesh it loads
+			if (LoadSceneWithAssimp(loadRequest))
+			{
+				bakedMeshCount += meshes.GetSize();
+			}
+
+			for (Mesh* pMesh : meshes)
+			{
+				SAFEDELETE(pMesh);
+			}
+		}
+
+		LOG_INFO("Baked meshlet cache for %u meshes in \"%s\"", bakedMeshCount, directory.c_str());
+		return bakedMeshCount;
+	}
+
+	int32 ResourceLoader::GetSceneAssimpFlags()
+	{
+		return
+			aiProcess_FlipWindingOrder			|
+			aiProcess_FlipUVs					|
+			aiProcess_CalcTangentSpace			|
+			aiProcess_FindInstances				|
+			aiProcess_GenSmoothNormals			|
+			aiProcess_JoinIdenticalVertices		|
+			aiProcess_ImproveCacheLocality		|
+			aiProcess_LimitBoneWeights			|
+			aiProcess_SplitLargeMeshes			|
+			aiProcess_RemoveRedundantMaterials	|
+			aiProcess_SortByPType				|
+			aiProcess_Triangulate				|
+			aiProcess_GenUVCoords				|
+			aiProcess_FindDegenerates			|
+			aiProcess_OptimizeMeshes			|
+			aiProcess_FindInvalidData;
+	}
+
+	int32 ResourceLoader::GetMeshAssimpFlags(bool fixInfacingNormals)
+	{
+		int32 assimpFlags =
+			aiProcess_FlipWindingOrder			|
+			aiProcess_FlipUVs					|
+			aiProcess_CalcTangentSpace			|
+			aiProcess_FindInstances				|
+			aiProcess_GenSmoothNormals			|
+			aiProcess_JoinIdenticalVertices		|
+			aiProcess_ImproveCacheLocality		|
+			aiProcess_LimitBoneWeights			|
+			aiProcess_RemoveRedundantMaterials	|
+			aiProcess_Triangulate				|
+			aiProcess_GenUVCoords				|
+			aiProcess_FindDegenerates			|
+			aiProcess_OptimizeMeshes			|
+			aiProcess_OptimizeGraph				|
+			aiProcess_FindInvalidData;
+
+		if (fixInfacingNormals)
+		{
+			assimpFlags |= aiProcess_FixInfacingNormals;
 		}
 
-		file.close();
+		return assimpFlags;
 	}
 }
@@ -300,22 +300,7 @@ namespace LambdaEngine
 			return;
 		}
 
-		int32 assimpFlags =
-			aiProcess_FlipWindingOrder |
-			aiProcess_FlipUVs |
-			aiProcess_CalcTangentSpace |
-			aiProcess_FindInstances |
-			aiProcess_GenSmoothNormals |
-			aiProcess_JoinIdenticalVertices |
-			aiProcess_ImproveCacheLocality |
-			aiProcess_LimitBoneWeights |
-			aiProcess_RemoveRedundantMaterials |
-			aiProcess_Triangulate |
-			aiProcess_GenUVCoords |
-			aiProcess_FindDegenerates |
-			aiProcess_OptimizeMeshes |
-			aiProcess_OptimizeGraph |
-			aiProcess_FindInvalidData;
+		const int32 assimpFlags = ResourceLoader::GetMeshAssimpFlags(false);
 
 		Mesh* pMesh = ResourceLoader::LoadMeshFromFile(MESH_DIR + filename, nullptr, nullptr, nullptr, assimpFlags, shouldTessellate);
 
@@ -342,22 +327,7 @@ namespace LambdaEngine
 			return;
 		}
 
-		int32 assimpFlags =
-			aiProcess_FlipWindingOrder |
-			aiProcess_FlipUVs |
-			aiProcess_CalcTangentSpace |
-			aiProcess_FindInstances |
-			aiProcess_GenSmoothNormals |
-			aiProcess_JoinIdenticalVertices |
-			aiProcess_ImproveCacheLocality |
-			aiProcess_LimitBoneWeights |
-			aiProcess_RemoveRedundantMaterials |
-			aiProcess_Triangulate |
-			aiProcess_GenUVCoords |
-			aiProcess_FindDegenerates |
-			aiProcess_OptimizeMeshes |
-			aiProcess_OptimizeGraph |
-			aiProcess_FindInvalidData;
+		const int32 assimpFlags = ResourceLoader::GetMeshAssimpFlags(false);
 
 		TArray<Animation*> rawAnimations;
 		Mesh* pMesh = ResourceLoader::LoadMeshFromFile(MESH_DIR + filename, nullptr, nullptr, &rawAnimations, assimpFlags, shouldTessellate);
@@ -400,23 +370,7 @@ namespace LambdaEngine
 		TArray<LoadedTexture*> textures;
 		TArray<TextureView*> textureViewsToDelete;
 
-		int32 assimpFlags =
-			aiProcess_FlipWindingOrder |
-			aiProcess_FlipUVs |
-			aiProcess_CalcTangentSpace |
-			aiProcess_FindInstances |
-			aiProcess_FixInfacingNormals |
-			aiProcess_GenSmoothNormals |
-			aiProcess_JoinIdenticalVertices |
-			aiProcess_ImproveCacheLocality |
-			aiProcess_LimitBoneWeights |
-			aiProcess_RemoveRedundantMaterials |
-			aiProcess_Triangulate |
-			aiProcess_GenUVCoords |
-			aiProcess_FindDegenerates |
-			aiProcess_OptimizeMeshes |
-			aiProcess_OptimizeGraph |
-			aiProcess_FindInvalidData;
+		const int32 assimpFlags = ResourceLoader::GetMeshAssimpFlags(true);
 
 			// Prevent crashes in assimp when using this flag
 			//String path = ConvertSlashes(filepath);
@@ -511,22 +465,7 @@ namespace LambdaEngine
 			return;
 		}
 
-		int32 assimpFlags =
-			aiProcess_FlipWindingOrder |
-			aiProcess_FlipUVs |
-			aiProcess_CalcTangentSpace |
-			aiProcess_FindInstances |
-			aiProcess_GenSmoothNormals |
-			aiProcess_JoinIdenticalVertices |
-			aiProcess_ImproveCacheLocality |
-			aiProcess_LimitBoneWeights |
-			aiProcess_RemoveRedundantMaterials |
-			aiProcess_Triangulate |
-			aiProcess_GenUVCoords |
-			aiProcess_FindDegenerates |
-			aiProcess_OptimizeMeshes |
-			aiProcess_OptimizeGraph |
-			aiProcess_FindInvalidData;
+		const int32 assimpFlags = ResourceLoader::GetMeshAssimpFlags(false);
 
 		TArray<Animation*> rawAnimations;
 		TArray<LoadedMaterial*> materials;
@@ -1019,7 +958,7 @@ namespace LambdaEngine
 		loadDesc.Filepath		= filepath;
 		loadDesc.Stage			= stage;
 		loadDesc.Lang			= lang;
-		loadDesc.pEntryPoint	= pEntryPoint;
+		loadDesc.EntryPoint		= pEntryPoint;
 
 		s_ShaderLoadConfigurations[guid] = loadDesc;
 
@@ -1028,6 +967,52 @@ namespace LambdaEngine
 		return guid;
 	}
 
+	void ResourceManager::LoadShadersFromFile(const ShaderFileLoadDesc* pLoadDescs, uint32 shaderCount, GUID_Lambda* pGUIDs)
+	{
+		TArray<GUID_Lambda> shaderGUIDs;
+		TArray<ShaderFileLoadDesc> loadDescs;
+		for (uint32 s = 0; s < shaderCount; s++)
+		{
+			const ShaderFileLoadDesc& loadDesc = pLoadDescs[s];
+
+			// Registering the name before compiling makes duplicates within the batch resolve to the same GUID
+			auto loadedShaderGUID = s_ShaderNamesToGUIDs.find(loadDesc.Filepath);
+			if (loadedShaderGUID != s_ShaderNamesToGUIDs.end())
+			{
+				pGUIDs[s] = loadedShaderGUID->second;
+				continue;
+			}
+
+			const GUID_Lambda guid = s_NextFreeGUID++;
+			s_Shaders[guid]							= nullptr;
+			s_ShaderGUIDsToNames[guid]				= loadDesc.Filepath;
+			s_ShaderNamesToGUIDs[loadDesc.Filepath]	= guid;
+
+			ShaderLoadDesc shaderLoadDesc = {};
+			shaderLoadDesc.Filepath		= SHADER_DIR + loadDesc.Filepath;
+			shaderLoadDesc.Stage		= loadDesc.Stage;
+			shaderLoadDesc.Lang			= loadDesc.Lang;
+			shaderLoadDesc.EntryPoint	= loadDesc.EntryPoint;
+
+			s_ShaderLoadConfigurations[guid] = shaderLoadDesc;
+
+			ShaderFileLoadDesc fileLoadDesc = loadDesc;
+			fileLoadDesc.Filepath = shaderLoadDesc.Filepath;
+
+			pGUIDs[s] = guid;
+			shaderGUIDs.PushBack(guid);
+			loadDescs.PushBack(fileLoadDesc);
+		}
+
+		TArray<Shader*> shaders(loadDescs.GetSize());
+		ResourceLoader::LoadShadersFromFile(loadDescs.GetData(), loadDescs.GetSize(), shaders.GetData());
+
+		for (uint32 s = 0; s < shaders.GetSize(); s++)
+		{
+			s_Shaders[shaderGUIDs[s]] = shaders[s];
+		}
+	}
+
 	GUID_Lambda ResourceManager::RegisterShader(const String& name, Shader* pShader)
 	{
 		auto loadedShaderGUID = s_ShaderNamesToGUIDs.find(name);
@@ -2057,6 +2042,8 @@ namespace LambdaEngine
 	{
 		UNREFERENCED_VARIABLE(event);
 
+		TArray<GUID_Lambda> shaderGUIDs;
+		TArray<ShaderFileLoadDesc> loadDescs;
 		for (auto it = s_Shaders.begin(); it != s_Shaders.end(); it++)
 		{
 			if (it->second != nullptr)
@@ -2065,16 +2052,32 @@ namespace LambdaEngine
 
 				if (loadConfigIt != s_ShaderLoadConfigurations.end())
 				{
-					Shader* pShader = ResourceLoader::LoadShaderFromFile(loadConfigIt->second.Filepath, loadConfigIt->second.Stage, loadConfigIt->second.Lang, loadConfigIt->second.pEntryPoint);
-					if (pShader != nullptr)
-					{
-						SAFERELEASE(it->second);
-						it->second = pShader;
-					}
+					ShaderFileLoadDesc loadDesc = {};
+					loadDesc.Filepath	= loadConfigIt->second.Filepath;
+					loadDesc.Stage		= loadConfigIt->second.Stage;
+					loadDesc.Lang		= loadConfigIt->second.Lang;
+					loadDesc.EntryPoint	= loadConfigIt->second.EntryPoint;
+
+					shaderGUIDs.PushBack(it->first);
+					loadDescs.PushBack(loadDesc);
 				}
 			}
 		}
 
+		TArray<Shader*> shaders(loadDescs.GetSize());
+		ResourceLoader::LoadShadersFromFile(loadDescs.GetData(), loadDescs.GetSize(), shaders.GetData());
+
+		for (uint32 s = 0; s < shaders.GetSize(); s++)
+		{
+			Shader* pShader = shaders[s];
+			if (pShader != nullptr)
+			{
+				Shader*& pOldShader = s_Shaders[shaderGUIDs[s]];
+				SAFERELEASE(pOldShader);
+				pOldShader = pShader;
+			}
+		}
+
 		return true;
 	}
 
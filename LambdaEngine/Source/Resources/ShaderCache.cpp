@@ -0,0 +1,170 @@
+#include "Resources/ShaderCache.h"
+#include "Resources/ResourcePaths.h"
+#include "Resources/GLSLang.h"
+
+#include "Utilities/HashUtilities.h"
+
+#include "Log/Log.h"
+
+#include <fstream>
+#include <filesystem>
+#include <thread>
+
+namespace LambdaEngine
+{
+	constexpr const uint32 SHADER_CACHE_MAGIC	= 0x56525053; // 'SPRV'
+	constexpr const uint32 SHADER_CACHE_VERSION	= 1;
+
+	struct ShaderCacheHeader
+	{
+		uint32 Magic;
+		uint32 Version;
+		uint64 Key;
+		uint64 PayloadHash;
+		uint32 WordCount;
+		uint32 Padding;
+	};
+
+	std::atomic_bool		ShaderCache::s_Enabled		= true;
+	std::atomic_uint32_t	ShaderCache::s_HitCount		= 0;
+	std::atomic_uint32_t	ShaderCache::s_MissCount	= 0;
+
+	uint64 ShaderCache::CalculateKey(const String& preprocessedSource, FShaderStageFlags stage, const String& defines, const String& entryPoint)
+	{
+		uint64 key = HashMemory(preprocessedSource.data(), preprocessedSource.size());
+		key = HashMemory(defines.data(), defines.size(), key);
+		key = HashMemory(entryPoint.data(), entryPoint.size(), key);
+		key = HashValue<uint32>(uint32(stage), key);
+
+		// Target environment, the same settings CompileGLSLToSPIRV passes to glslang
+		key = HashValue<uint32>(uint32(glslang::EShSourceGlsl), key);
+		key = HashValue<uint32>(uint32(glslang::EShClientVulkan), key);
+		key = HashValue<uint32>(uint32(glslang::EShTargetSpv), key);
+		key = HashValue<int32>(GetDefaultClientInputSemanticsVersion(), key);
+		key = HashValue<uint32>(uint32(GetDefaultVulkanClientVersion()), key);
+		key = HashValue<uint32>(uint32(GetDefaultSPIRVTargetVersion()), key);
+		key = HashValue<uint32>(uint32(GetDefaultMessages()), key);
+		key = HashValue<int32>(GetDefaultVersion(), key);
+		key = HashMemory(GetDefaultBuiltInResources(), sizeof(TBuiltInResource), key);
+
+		// Compiler version, SPIR-V from an older glslang is not reused after an upgrade
+		key = HashMemory(GetCompilerVersion().data(), GetCompilerVersion().size(), key);
+
+		key = HashValue<uint32>(SHADER_CACHE_VERSION, key);
+		return key;
+	}
+
+	const String& ShaderCache::GetCompilerVersion()
+	{
+		static const String compilerVersion = []()
+		{
+			std::string spirvVersion;
+			glslang::GetSpirvVersion(spirvVersion);
+			return String(glslang::GetGlslVersionString()) + " " + spirvVersion;
+		}();
+
+		return compilerVersion;
+	}
+
+	bool ShaderCache::Load(uint64 key, TArray<uint32>& sourceSPIRV)
+	{
+		if (!s_Enabled)
+		{
+			return false;
+		}
+
+		const String entryPath = GetEntryPath(key);
+
+		std::ifstream file(entryPath, std::ifstream::in | std::ifstream::binary);
+		if (file)
+		{
+			ShaderCacheHeader header = {};
+			file.read((char*)&header, sizeof(ShaderCacheHeader));
+
+			if (file && header.Magic == SHADER_CACHE_MAGIC && header.Version == SHADER_CACHE_VERSION && header.Key == key && header.WordCount > 0)
+			{
+				sourceSPIRV.Resize(header.WordCount);
+				file.read((char*)sourceSPIRV.GetData(), header.WordCount * sizeof(uint32));
+
+				if (file && HashMemory(sourceSPIRV.GetData(), header.WordCount * sizeof(uint32)) == header.PayloadHash)
+				{
+					s_HitCount++;
+					return true;
+				}
+			}
+
+			LOG_WARNING("[ShaderCache]: Entry \"%s\" is invalid, recompiling", entryPath.c_str());
+			sourceSPIRV.Clear();
+		}
+
+		s_MissCount++;
+		return false;
+	}
+
+	void ShaderCache::Store(uint64 key, const TArray<uint32>& sourceSPIRV)
+	{
+		if (!s_Enabled || sourceSPIRV.IsEmpty())
+		{
+			return;
+		}
+
+		std::error_code error;
+		std::filesystem::create_directories(SHADER_CACHE_DIR, error);
+
+		// Write to a temporary file first, the same shader may be compiled from several threads at once
+		const String entryPath		= GetEntryPath(key);
+		const String temporaryPath	= entryPath + "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+		{
+			std::ofstream file(temporaryPath, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+			if (!file)
+			{
+				LOG_WARNING("[ShaderCache]: Failed to write entry \"%s\"", entryPath.c_str());
+				return;
+			}
+
+			const ShaderCacheHeader header =
+			{
+				.Magic			= SHADER_CACHE_MAGIC,
+				.Version		= SHADER_CACHE_VERSION,
+				.Key			= key,
+				.PayloadHash	= HashMemory(sourceSPIRV.GetData(), sourceSPIRV.GetSize() * sizeof(uint32)),
+				.WordCount		= sourceSPIRV.GetSize(),
+				.Padding		= 0
+			};
+
+			file.write((const char*)&header, sizeof(ShaderCacheHeader));
+			file.write((const char*)sourceSPIRV.GetData(), header.WordCount * sizeof(uint32));
+		}
+
+		std::filesystem::rename(temporaryPath, entryPath, error);
+		if (error)
+		{
+			std::filesystem::remove(temporaryPath, error);
+		}
+	}
+
+	void ShaderCache::Clear()
+	{
+		std::error_code error;
+		for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(SHADER_CACHE_DIR, error))
+		{
+			if (entry.is_regular_file() && entry.path().extension() == ".spv")
+			{
+				std::filesystem::remove(entry.path(), error);
+			}
+		}
+	}
+
+	void ShaderCache::ResetStatistics()
+	{
+		s_HitCount	= 0;
+		s_MissCount	= 0;
+	}
+
+	String ShaderCache::GetEntryPath(uint64 key)
+	{
+		char keyString[17];
+		snprintf(keyString, sizeof(keyString), "%016llx", key);
+		return String(SHADER_CACHE_DIR) + keyString + ".spv";
+	}
+}
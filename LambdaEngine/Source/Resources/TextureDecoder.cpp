@@ -0,0 +1,512 @@
+#include "Resources/TextureDecoder.h"
+
+#include "Rendering/Core/API/GraphicsHelpers.h"
+
+#include "Threading/API/ThreadPool.h"
+
+#include "Math/MathUtilities.h"
+
+#include "Log/Log.h"
+
+#include "stb_image.h"
+
+#include <atomic>
+#include <emmintrin.h>
+
+namespace LambdaEngine
+{
+	// Blocks are sized from the images that are decoded into them, small images share blocks of the minimum size
+	constexpr const uint64 IMAGE_ARENA_MIN_BLOCK_SIZE	= MEGA_BYTE(4);
+	constexpr const uint64 IMAGE_ARENA_ALIGNMENT		= 16;
+	constexpr const uint32 MAX_POOLED_IMAGE_ARENAS		= 2;
+	// Largest block a pooled arena keeps, the pool holds at most MAX_POOLED_IMAGE_ARENAS times this
+	constexpr const uint64 MAX_POOLED_IMAGE_ARENA_BLOCK_SIZE	= MEGA_BYTE(16);
+
+	// The arena that stb_image allocations on this thread are redirected to
+	static thread_local ImageArena* t_pBoundArena = nullptr;
+
+	TArray<ImageArena*>	TextureDecoder::s_FreeArenas;
+	std::mutex			TextureDecoder::s_ArenaLock;
+
+	/*
+	* ImageArena
+	*/
+	ImageArena::~ImageArena()
+	{
+		for (Block& block : m_Blocks)
+		{
+			Malloc::Free(block.pMemory);
+		}
+
+		m_Blocks.Clear();
+	}
+
+	void* ImageArena::Allocate(uint64 size)
+	{
+		const uint64 alignedSize = AlignUp(size, IMAGE_ARENA_ALIGNMENT);
+		Reserve(alignedSize);
+
+		void* pMemory = m_Blocks[m_CurrentBlock].pMemory + m_BlockOffset;
+		m_BlockOffset		+= alignedSize;
+		m_pLastAllocation	= pMemory;
+		return pMemory;
+	}
+
+	void ImageArena::Reserve(uint64 size)
+	{
+		const uint64 alignedSize = AlignUp(size, IMAGE_ARENA_ALIGNMENT);
+		while (m_CurrentBlock < m_Blocks.GetSize())
+		{
+			if (m_BlockOffset + alignedSize <= m_Blocks[m_CurrentBlock].Size)
+			{
+				return;
+			}
+
+			m_CurrentBlock++;
+			m_BlockOffset		= 0;
+			m_pLastAllocation	= nullptr;
+		}
+
+		Block block = {};
+		block.Size		= glm::max(IMAGE_ARENA_MIN_BLOCK_SIZE, alignedSize);
+		block.pMemory	= reinterpret_cast<byte*>(Malloc::Allocate(block.Size, IMAGE_ARENA_ALIGNMENT));
+		m_Blocks.PushBack(block);
+		m_ReservedSize += block.Size;
+
+		m_CurrentBlock		= m_Blocks.GetSize() - 1;
+		m_BlockOffset		= 0;
+		m_pLastAllocation	= nullptr;
+	}
+
+	void* ImageArena::Reallocate(void* pMemory, uint64 oldSize, uint64 newSize)
+	{
+		if (pMemory == nullptr)
+		{
+			return Allocate(newSize);
+		}
+
+		// The latest allocation can grow in place as long as the block has room for it
+		if (pMemory == m_pLastAllocation)
+		{
+			const Block& block = m_Blocks[m_CurrentBlock];
+			const uint64 allocationOffset = uint64(reinterpret_cast<byte*>(pMemory) - block.pMemory);
+			const uint64 alignedSize = AlignUp(newSize, IMAGE_ARENA_ALIGNMENT);
+			if (allocationOffset + alignedSize <= block.Size)
+			{
+				m_BlockOffset = allocationOffset + alignedSize;
+				return pMemory;
+			}
+		}
+
+		void* pNewMemory = Allocate(newSize);
+		memcpy(pNewMemory, pMemory, glm::min(oldSize, newSize));
+		return pNewMemory;
+	}
+
+	bool ImageArena::Owns(const void* pMemory) const
+	{
+		const byte* pBytes = reinterpret_cast<const byte*>(pMemory);
+		for (const Block& block : m_Blocks)
+		{
+			if (pBytes >= block.pMemory && pBytes < block.pMemory + block.Size)
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void ImageArena::Reset()
+	{
+		m_CurrentBlock		= 0;
+		m_BlockOffset		= 0;
+		m_pLastAllocation	= nullptr;
+	}
+
+	void ImageArena::Trim()
+	{
+		Reset();
+
+		const uint32 keptBlockCount = (!m_Blocks.IsEmpty() && m_Blocks[0].Size <= MAX_POOLED_IMAGE_ARENA_BLOCK_SIZE) ? 1 : 0;
+		for (uint32 b = keptBlockCount; b < m_Blocks.GetSize(); b++)
+		{
+			Malloc::Free(m_Blocks[b].pMemory);
+			m_ReservedSize -= m_Blocks[b].Size;
+		}
+
+		m_Blocks.Resize(keptBlockCount);
+	}
+
+	/*
+	* Mip generation
+	*/
+	static bool GetChannelLayout(EFormat format, uint32& channelCount, uint32& bytesPerChannel)
+	{
+		switch (format)
+		{
+		case EFormat::FORMAT_R8_UNORM:				channelCount = 1; bytesPerChannel = 1; return true;
+		case EFormat::FORMAT_R8G8B8A8_UNORM:		channelCount = 4; bytesPerChannel = 1; return true;
+		case EFormat::FORMAT_B8G8R8A8_UNORM:		channelCount = 4; bytesPerChannel = 1; return true;
+		case EFormat::FORMAT_R16_UNORM:				channelCount = 1; bytesPerChannel = 2; return true;
+		case EFormat::FORMAT_R16G16B16A16_UNORM:	channelCount = 4; bytesPerChannel = 2; return true;
+		default: return false;
+		}
+	}
+
+	template<typename TChannel>
+	static void DownsampleScalar(
+		const TChannel* pSrc,
+		uint32 srcWidth,
+		uint32 srcHeight,
+		TChannel* pDst,
+		uint32 dstWidth,
+		uint32 dstHeight,
+		uint32 channelCount,
+		bool linearFiltering)
+	{
+		// Odd sizes clamp to the last row and column, matching the rounding of the GPU path
+		for (uint32 y = 0; y < dstHeight; y++)
+		{
+			const uint32 y0 = glm::min(2 * y, srcHeight - 1);
+			const uint32 y1 = glm::min(2 * y + 1, srcHeight - 1);
+
+			for (uint32 x = 0; x < dstWidth; x++)
+			{
+				const uint32 x0 = glm::min(2 * x, srcWidth - 1);
+				const uint32 x1 = glm::min(2 * x + 1, srcWidth - 1);
+
+				const TChannel* pTexel00 = pSrc + (y0 * srcWidth + x0) * channelCount;
+				const TChannel* pTexel01 = pSrc + (y0 * srcWidth + x1) * channelCount;
+				const TChannel* pTexel10 = pSrc + (y1 * srcWidth + x0) * channelCount;
+				const TChannel* pTexel11 = pSrc + (y1 * srcWidth + x1) * channelCount;
+
+				TChannel* pTexelDst = pDst + (y * dstWidth + x) * channelCount;
+				for (uint32 c = 0; c < channelCount; c++)
+				{
+					if (linearFiltering)
+					{
+						const uint32 sum = uint32(pTexel00[c]) + uint32(pTexel01[c]) + uint32(pTexel10[c]) + uint32(pTexel11[c]);
+						pTexelDst[c] = TChannel((sum + 2) >> 2);
+					}
+					else
+					{
+						pTexelDst[c] = pTexel00[c];
+					}
+				}
+			}
+		}
+	}
+
+	/*
+	* 2x2 box filter for four channel 8-bit images with even dimensions, four destination texels per iteration
+	*/
+	static void DownsampleBoxRGBA8(const byte* pSrc, uint32 srcWidth, byte* pDst, uint32 dstWidth, uint32 dstHeight)
+	{
+		const __m128i zero	= _mm_setzero_si128();
+		const __m128i round	= _mm_set1_epi16(2);
+
+		for (uint32 y = 0; y < dstHeight; y++)
+		{
+			const byte* pRow0	= pSrc + uint64(2 * y) * srcWidth * 4;
+			const byte* pRow1	= pRow0 + uint64(srcWidth) * 4;
+			byte* pRowDst		= pDst + uint64(y) * dstWidth * 4;
+
+			uint32 x = 0;
+			for (; x + 4 <= dstWidth; x += 4)
+			{
+				const __m128i row0Lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pRow0 + x * 8));
+				const __m128i row0Hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pRow0 + x * 8 + 16));
+				const __m128i row1Lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pRow1 + x * 8));
+				const __m128i row1Hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pRow1 + x * 8 + 16));
+
+				// Vertical sums in 16-bit, each register holds two source texels
+				const __m128i sum01 = _mm_add_epi16(_mm_unpacklo_epi8(row0Lo, zero), _mm_unpacklo_epi8(row1Lo, zero));
+				const __m128i sum23 = _mm_add_epi16(_mm_unpackhi_epi8(row0Lo, zero), _mm_unpackhi_epi8(row1Lo, zero));
+				const __m128i sum45 = _mm_add_epi16(_mm_unpacklo_epi8(row0Hi, zero), _mm_unpacklo_epi8(row1Hi, zero));
+				const __m128i sum67 = _mm_add_epi16(_mm_unpackhi_epi8(row0Hi, zero), _mm_unpackhi_epi8(row1Hi, zero));
+
+				// Horizontal sums, the low half of each register now holds one destination texel
+				const __m128i texel0 = _mm_add_epi16(sum01, _mm_srli_si128(sum01, 8));
+				const __m128i texel1 = _mm_add_epi16(sum23, _mm_srli_si128(sum23, 8));
+				const __m128i texel2 = _mm_add_epi16(sum45, _mm_srli_si128(sum45, 8));
+				const __m128i texel3 = _mm_add_epi16(sum67, _mm_srli_si128(sum67, 8));
+
+				const __m128i texels01 = _mm_srli_epi16(_mm_add_epi16(_mm_unpacklo_epi64(texel0, texel1), round), 2);
+				const __m128i texels23 = _mm_srli_epi16(_mm_add_epi16(_mm_unpacklo_epi64(texel2, texel3), round), 2);
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(pRowDst + x * 4), _mm_packus_epi16(texels01, texels23));
+			}
+
+			for (; x < dstWidth; x++)
+			{
+				for (uint32 c = 0; c < 4; c++)
+				{
+					const uint32 sum = uint32(pRow0[x * 8 + c]) + uint32(pRow0[x * 8 + 4 + c]) + uint32(pRow1[x * 8 + c]) + uint32(pRow1[x * 8 + 4 + c]);
+					pRowDst[x * 4 + c] = byte((sum + 2) >> 2);
+				}
+			}
+		}
+	}
+
+	/*
+	* TextureDecoder
+	*/
+	bool TextureDecoder::DecodeFiles(
+		const String* pFilepaths,
+		uint32 count,
+		EFormat format,
+		bool generateMips,
+		bool linearFilteringMips,
+		DecodedImageBatch& batch)
+	{
+		if (format != EFormat::FORMAT_R8G8B8A8_UNORM && format != EFormat::FORMAT_R16G16B16A16_UNORM)
+		{
+			LOG_ERROR("[TextureDecoder]: Format not supported for decoding");
+			return false;
+		}
+
+		batch.Images.Resize(count);
+		if (count == 0)
+		{
+			return true;
+		}
+
+		// One arena per worker, each worker pulls images from a shared counter into its own arena
+		const uint32 workerCount = glm::min<uint32>(count, ThreadPool::GetThreadCount() + 1);
+
+		const uint32 firstArena = batch.Arenas.GetSize();
+		for (uint32 w = 0; w < workerCount; w++)
+		{
+			batch.Arenas.PushBack(AcquireArena());
+		}
+
+		std::atomic_uint32_t nextImageIndex = 0;
+		auto decodeImages = [&nextImageIndex, &batch, pFilepaths, count, format, generateMips, linearFilteringMips](ImageArena* pArena)
+		{
+			t_pBoundArena = pArena;
+
+			const uint32 bytesPerTexel = TextureFormatStride(format);
+			for (uint32 i = nextImageIndex++; i < count; i = nextImageIndex++)
+			{
+				DecodedImage& image = batch.Images[i];
+				image.Filepath = pFilepaths[i];
+
+				int32 width		= 0;
+				int32 height	= 0;
+				int32 bpp		= 0;
+
+				// Reserve room for the decoded image, the temporary buffers of stb_image and the mip chain, so the arena
+				// only grows by what is decoded and the chain can usually grow in place
+				if (stbi_info(image.Filepath.c_str(), &width, &height, &bpp))
+				{
+					const uint32 miplevels	= generateMips ? CalculateMiplevels(uint32(width), uint32(height)) : 1;
+					const uint64 level0Size	= uint64(width) * uint64(height) * bytesPerTexel;
+					pArena->Reserve(CalculateMipChainSize(uint32(width), uint32(height), miplevels, format) + 2 * level0Size);
+				}
+
+				if (format == EFormat::FORMAT_R8G8B8A8_UNORM)
+				{
+					image.pPixels = stbi_load(image.Filepath.c_str(), &width, &height, &bpp, STBI_rgb_alpha);
+				}
+				else
+				{
+					image.pPixels = stbi_load_16(image.Filepath.c_str(), &width, &height, &bpp, STBI_rgb_alpha);
+				}
+
+				if (image.pPixels == nullptr)
+				{
+					LOG_ERROR("Failed to load texture file: \"%s\"", image.Filepath.c_str());
+					continue;
+				}
+
+				image.Width		= uint32(width);
+				image.Height	= uint32(height);
+				image.Miplevels	= generateMips ? CalculateMiplevels(image.Width, image.Height) : 1;
+
+				if (image.Miplevels > 1)
+				{
+					// The decoded image is the latest allocation in the arena, so the chain usually grows in place
+					const uint64 level0Size	= uint64(image.Width) * image.Height * bytesPerTexel;
+					const uint64 chainSize	= CalculateMipChainSize(image.Width, image.Height, image.Miplevels, format);
+					image.pPixels = pArena->Reallocate(image.pPixels, level0Size, chainSize);
+
+					GenerateMipChain(image.pPixels, image.Width, image.Height, image.Miplevels, format, linearFilteringMips);
+				}
+
+				image.Succeeded = true;
+			}
+
+			t_pBoundArena = nullptr;
+		};
+
+		ThreadPool::ParallelFor(workerCount, [&decodeImages, &batch, firstArena](uint32 worker) { decodeImages(batch.Arenas[firstArena + worker]); });
+
+		for (const DecodedImage& image : batch.Images)
+		{
+			if (!image.Succeeded)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	void TextureDecoder::ReleaseBatch(DecodedImageBatch& batch)
+	{
+		for (ImageArena* pArena : batch.Arenas)
+		{
+			ReleaseArena(pArena);
+		}
+
+		batch.Arenas.Clear();
+		batch.Images.Clear();
+	}
+
+	ImageArena* TextureDecoder::AcquireArena()
+	{
+		std::scoped_lock<std::mutex> lock(s_ArenaLock);
+		if (!s_FreeArenas.IsEmpty())
+		{
+			ImageArena* pArena = s_FreeArenas.GetBack();
+			s_FreeArenas.PopBack();
+			return pArena;
+		}
+
+		return DBG_NEW ImageArena();
+	}
+
+	void TextureDecoder::ReleaseArena(ImageArena* pArena)
+	{
+		pArena->Trim();
+
+		{
+			std::scoped_lock<std::mutex> lock(s_ArenaLock);
+			if (s_FreeArenas.GetSize() < MAX_POOLED_IMAGE_ARENAS)
+			{
+				s_FreeArenas.PushBack(pArena);
+				return;
+			}
+		}
+
+		SAFEDELETE(pArena);
+	}
+
+	void TextureDecoder::ReleaseArenaPool()
+	{
+		std::scoped_lock<std::mutex> lock(s_ArenaLock);
+		for (ImageArena* pArena : s_FreeArenas)
+		{
+			SAFEDELETE(pArena);
+		}
+
+		s_FreeArenas.Clear();
+	}
+
+	bool TextureDecoder::SupportsCPUMips(EFormat format)
+	{
+		uint32 channelCount		= 0;
+		uint32 bytesPerChannel	= 0;
+		return GetChannelLayout(format, channelCount, bytesPerChannel);
+	}
+
+	uint32 TextureDecoder::CalculateMiplevels(uint32 width, uint32 height)
+	{
+		return uint32(glm::floor(glm::log2((float)glm::max(width, height)))) + 1u;
+	}
+
+	uint64 TextureDecoder::CalculateMipChainSize(uint32 width, uint32 height, uint32 miplevels, EFormat format)
+	{
+		const uint64 bytesPerTexel = TextureFormatStride(format);
+
+		uint64 size = 0;
+		for (uint32 m = 0; m < miplevels; m++)
+		{
+			size += uint64(glm::max(width >> m, 1u)) * glm::max(height >> m, 1u) * bytesPerTexel;
+		}
+
+		return size;
+	}
+
+	void TextureDecoder::GenerateMipChain(void* pMipChain, uint32 width, uint32 height, uint32 miplevels, EFormat format, bool linearFilteringMips)
+	{
+		uint32 channelCount		= 0;
+		uint32 bytesPerChannel	= 0;
+		if (!GetChannelLayout(format, channelCount, bytesPerChannel))
+		{
+			LOG_ERROR("[TextureDecoder]: Format not supported for CPU mip generation");
+			return;
+		}
+
+		const uint64 bytesPerTexel = uint64(channelCount) * bytesPerChannel;
+
+		byte* pSrc = reinterpret_cast<byte*>(pMipChain);
+		uint32 srcWidth		= width;
+		uint32 srcHeight	= height;
+
+		for (uint32 m = 1; m < miplevels; m++)
+		{
+			const uint32 dstWidth	= glm::max(srcWidth >> 1, 1u);
+			const uint32 dstHeight	= glm::max(srcHeight >> 1, 1u);
+			byte* pDst = pSrc + uint64(srcWidth) * srcHeight * bytesPerTexel;
+
+			const bool evenSize = (srcWidth % 2 == 0) && (srcHeight % 2 == 0);
+			if (linearFilteringMips && evenSize && channelCount == 4 && bytesPerChannel == 1)
+			{
+				DownsampleBoxRGBA8(pSrc, srcWidth, pDst, dstWidth, dstHeight);
+			}
+			else if (bytesPerChannel == 1)
+			{
+				DownsampleScalar<uint8>(pSrc, srcWidth, srcHeight, pDst, dstWidth, dstHeight, channelCount, linearFilteringMips);
+			}
+			else
+			{
+				DownsampleScalar<uint16>(
+					reinterpret_cast<const uint16*>(pSrc),
+					srcWidth,
+					srcHeight,
+					reinterpret_cast<uint16*>(pDst),
+					dstWidth,
+					dstHeight,
+					channelCount,
+					linearFilteringMips);
+			}
+
+			pSrc		= pDst;
+			srcWidth	= dstWidth;
+			srcHeight	= dstHeight;
+		}
+	}
+
+	void* TextureDecoder::Allocate(size_t size)
+	{
+		if (t_pBoundArena != nullptr)
+		{
+			return t_pBoundArena->Allocate(size);
+		}
+
+		return malloc(size);
+	}
+
+	void* TextureDecoder::Reallocate(void* pMemory, size_t oldSize, size_t newSize)
+	{
+		if (t_pBoundArena != nullptr)
+		{
+			return t_pBoundArena->Reallocate(pMemory, oldSize, newSize);
+		}
+
+		return realloc(pMemory, newSize);
+	}
+
+	void TextureDecoder::Free(void* pMemory)
+	{
+		// Arena memory is reclaimed when the arena is reset
+		if (t_pBoundArena != nullptr && t_pBoundArena->Owns(pMemory))
+		{
+			return;
+		}
+
+		free(pMemory);
+	}
+}
@@ -3,6 +3,10 @@
 
 #include "Log/Log.h"
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
 // In case hardware_concurrency() returns 0, this is the default amount of threads the thread pool will start
 #define MIN_THREADS 4u
 
@@ -118,6 +122,65 @@ namespace LambdaEngine
 		s_JobsExist.wait(uLock, []{ return s_Jobs.empty() && s_FreeJoinResourcesIndices.GetSize() == s_JoinResources.GetSize(); });
 	}
 
+	void ThreadPool::ParallelFor(uint32 count, const std::function<void(uint32)>& func, const std::function<void()>& callerFunc)
+	{
+		// Pool jobs that start after every index was claimed only touch the shared state, which they own
+		struct ParallelForExecution
+		{
+			std::function<void(uint32)>	Func;
+			std::atomic_uint32_t		NextIndex		= 0;
+			std::atomic_uint32_t		FinishedCount	= 0;
+			uint32						Count			= 0;
+		};
+
+		if (count <= 1)
+		{
+			if (callerFunc)
+			{
+				callerFunc();
+			}
+
+			if (count == 1)
+			{
+				func(0);
+			}
+
+			return;
+		}
+
+		std::shared_ptr<ParallelForExecution> execution = std::make_shared<ParallelForExecution>();
+		execution->Func		= func;
+		execution->Count	= count;
+
+		auto claimIndices = [](ParallelForExecution& execution)
+		{
+			for (uint32 index = execution.NextIndex.fetch_add(1); index < execution.Count; index = execution.NextIndex.fetch_add(1))
+			{
+				execution.Func(index);
+				execution.FinishedCount.fetch_add(1, std::memory_order_release);
+			}
+		};
+
+		const uint32 helperCount = std::min(count - 1, GetThreadCount());
+		for (uint32 helper = 0; helper < helperCount; helper++)
+		{
+			ExecuteDetached([execution, claimIndices]() { claimIndices(*execution); });
+		}
+
+		if (callerFunc)
+		{
+			callerFunc();
+		}
+
+		claimIndices(*execution);
+
+		// Only indices already claimed by other threads remain, so this never waits on unscheduled work
+		while (execution->FinishedCount.load(std::memory_order_acquire) < count)
+		{
+			std::this_thread::yield();
+		}
+	}
+
 	void ThreadPool::WaitForJob()
 	{
 		std::unique_lock<std::mutex> uLock(s_ScheduleLock);